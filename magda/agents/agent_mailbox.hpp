@@ -0,0 +1,112 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+
+/**
+ * @brief Bounded lock-free mailbox: any number of senders, one reader at a time
+ *
+ * A ring of slots, each stamped with a sequence number that says whether it is free for
+ * the sender claiming that position or holds an item for the reader. Senders claim a
+ * position with a single compare-and-swap and never wait on each other or the reader;
+ * when the ring is full push() fails immediately, which is how back-pressure reaches the
+ * sender.
+ *
+ * Capacity is rounded up to a power of two.
+ */
+template <typename T>
+class AgentMailbox {
+  public:
+    explicit AgentMailbox(size_t capacity) {
+        size_t size = 2;
+        while (size < capacity) {
+            size <<= 1;
+        }
+        mask_ = size - 1;
+        slots_ = std::make_unique<Slot[]>(size);
+        for (size_t i = 0; i < size; ++i) {
+            slots_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * @brief Add an item (any thread)
+     * @return false, leaving item untouched, if the mailbox is full
+     */
+    bool push(T& item) {
+        size_t position = tail_.load(std::memory_order_relaxed);
+        for (;;) {
+            Slot& slot = slots_[position & mask_];
+            size_t sequence = slot.sequence.load(std::memory_order_acquire);
+            auto diff = static_cast<std::ptrdiff_t>(sequence - position);
+
+            if (diff == 0) {
+                if (tail_.compare_exchange_weak(position, position + 1,
+                                                std::memory_order_relaxed)) {
+                    slot.item = std::move(item);
+                    slot.sequence.store(position + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false;  // Slot still holds an unread item: full
+            } else {
+                position = tail_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /**
+     * @brief Take the oldest item (reader only)
+     * @return false if the mailbox is empty
+     */
+    bool pop(T& item) {
+        size_t position = head_.load(std::memory_order_relaxed);
+        Slot& slot = slots_[position & mask_];
+        size_t sequence = slot.sequence.load(std::memory_order_acquire);
+        if (static_cast<std::ptrdiff_t>(sequence - (position + 1)) < 0) {
+            return false;
+        }
+
+        item = std::move(slot.item);
+        slot.item = T();
+        head_.store(position + 1, std::memory_order_relaxed);
+        slot.sequence.store(position + mask_ + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Whether the next item is ready to pop (reader only)
+     */
+    bool isEmpty() const {
+        size_t position = head_.load(std::memory_order_relaxed);
+        size_t sequence = slots_[position & mask_].sequence.load(std::memory_order_acquire);
+        return static_cast<std::ptrdiff_t>(sequence - (position + 1)) < 0;
+    }
+
+    /**
+     * @brief Approximate number of queued items (any thread)
+     */
+    size_t size() const {
+        size_t head = head_.load(std::memory_order_relaxed);
+        size_t tail = tail_.load(std::memory_order_relaxed);
+        return tail > head ? tail - head : 0;
+    }
+
+    size_t capacity() const {
+        return mask_ + 1;
+    }
+
+  private:
+    struct Slot {
+        std::atomic<size_t> sequence{0};
+        T item{};
+    };
+
+    std::unique_ptr<Slot[]> slots_;
+    size_t mask_ = 0;
+
+    // Kept on separate cache lines so senders and the reader don't contend
+    alignas(64) std::atomic<size_t> tail_{0};
+    alignas(64) std::atomic<size_t> head_{0};
+};
@@ -2,10 +2,35 @@
 
 #include <algorithm>
 
-AgentManager::AgentManager() {}
+namespace {
+
+// Weight of the newest sample in the moving averages
+constexpr double kAverageWeight = 0.1;
+
+double ticksToMs(juce::int64 ticks) {
+    return juce::Time::highResolutionTicksToSeconds(ticks) * 1000.0;
+}
+
+void updateAverage(std::atomic<double>& average, double sample, bool first) {
+    // Only the agent's current worker writes, so load/store is enough
+    double current = average.load(std::memory_order_relaxed);
+    average.store(first ? sample : current + (sample - current) * kAverageWeight,
+                  std::memory_order_relaxed);
+}
+
+}  // namespace
+
+AgentManager::AgentManager(int numWorkerThreads, size_t mailboxCapacity)
+    : mailboxCapacity_(std::max<size_t>(mailboxCapacity, 1)),
+      pool_(std::max(numWorkerThreads, 1)) {}
 
 AgentManager::~AgentManager() {
     stopAllAgents();
+
+    std::lock_guard<std::mutex> lock(agentsMutex_);
+    for (const auto& pair : agents_) {
+        pair.second->closed.store(true);
+    }
 }
 
 bool AgentManager::registerAgent(std::shared_ptr<AgentInterface> agent) {
@@ -26,41 +51,41 @@ bool AgentManager::registerAgent(std::shared_ptr<AgentInterface> agent) {
         handleAgentMessage(fromAgent, message);
     });
 
-    agents_[agentId] = agent;
-
     // Start the agent
     if (!agent->start()) {
-        agents_.erase(agentId);
         return false;
     }
 
+    agents_[agentId] = std::make_shared<AgentSlot>(agent, mailboxCapacity_);
     return true;
 }
 
 bool AgentManager::unregisterAgent(const std::string& agentId) {
-    std::lock_guard<std::mutex> lock(agentsMutex_);
+    std::shared_ptr<AgentSlot> slot;
+    {
+        std::lock_guard<std::mutex> lock(agentsMutex_);
 
-    auto it = agents_.find(agentId);
-    if (it == agents_.end()) {
-        return false;
+        auto it = agents_.find(agentId);
+        if (it == agents_.end()) {
+            return false;
+        }
+
+        slot = it->second;
+        agents_.erase(it);
     }
 
-    // Stop the agent
-    it->second->stop();
-    agents_.erase(it);
+    // Waiting messages are cancelled by the slot's job; make sure one runs to do it
+    slot->closed.store(true);
+    schedule(slot);
 
+    // Stop the agent
+    slot->agent->stop();
     return true;
 }
 
 std::shared_ptr<AgentInterface> AgentManager::getAgent(const std::string& agentId) {
-    std::lock_guard<std::mutex> lock(agentsMutex_);
-
-    auto it = agents_.find(agentId);
-    if (it != agents_.end()) {
-        return it->second;
-    }
-
-    return nullptr;
+    auto slot = findSlot(agentId);
+    return slot ? slot->agent : nullptr;
 }
 
 std::vector<std::shared_ptr<AgentInterface>> AgentManager::getAllAgents() const {
@@ -70,29 +95,68 @@ std::vector<std::shared_ptr<AgentInterface>> AgentManager::getAllAgents() const
     result.reserve(agents_.size());
 
     for (const auto& pair : agents_) {
-        result.push_back(pair.second);
+        result.push_back(pair.second->agent);
     }
 
     return result;
 }
 
+AgentRequest AgentManager::postToAgent(const std::string& agentId, const std::string& message) {
+    auto slot = findSlot(agentId);
+    if (!slot) {
+        return {};
+    }
+    return post(slot, message);
+}
+
 std::string AgentManager::sendToAgent(const std::string& agentId, const std::string& message) {
-    auto agent = getAgent(agentId);
-    if (agent && agent->isRunning()) {
-        return agent->processMessage(message);
+    auto request = postToAgent(agentId, message);
+    if (!request.isAccepted()) {
+        return "";
     }
 
-    return "";
+    try {
+        return request.reply.get();
+    } catch (const std::future_error&) {
+        // Manager shut down before the message was delivered
+        return "";
+    }
 }
 
-void AgentManager::broadcastMessage(const std::string& message) {
-    std::lock_guard<std::mutex> lock(agentsMutex_);
+size_t AgentManager::broadcastMessage(const std::string& message) {
+    std::vector<std::shared_ptr<AgentSlot>> slots;
+    {
+        std::lock_guard<std::mutex> lock(agentsMutex_);
+        for (const auto& pair : agents_) {
+            slots.push_back(pair.second);
+        }
+    }
 
-    for (const auto& pair : agents_) {
-        if (pair.second->isRunning()) {
-            pair.second->processMessage(message);
+    size_t accepted = 0;
+    for (const auto& slot : slots) {
+        if (slot->agent->isRunning() && post(slot, message).isAccepted()) {
+            ++accepted;
         }
     }
+    return accepted;
+}
+
+AgentMetrics AgentManager::getAgentMetrics(const std::string& agentId) const {
+    AgentMetrics metrics;
+    auto slot = findSlot(agentId);
+    if (!slot) {
+        return metrics;
+    }
+
+    metrics.queueDepth = slot->mailbox.size();
+    metrics.mailboxCapacity = slot->mailbox.capacity();
+    metrics.processed = slot->processed.load();
+    metrics.rejected = slot->rejected.load();
+    metrics.cancelled = slot->cancelled.load();
+    metrics.averageWaitMs = slot->averageWaitMs.load();
+    metrics.averageProcessMs = slot->averageProcessMs.load();
+    metrics.maxProcessMs = slot->maxProcessMs.load();
+    return metrics;
 }
 
 size_t AgentManager::getAgentCount() const {
@@ -104,8 +168,8 @@ void AgentManager::startAllAgents() {
     std::lock_guard<std::mutex> lock(agentsMutex_);
 
     for (const auto& pair : agents_) {
-        if (!pair.second->isRunning()) {
-            pair.second->start();
+        if (!pair.second->agent->isRunning()) {
+            pair.second->agent->start();
         }
     }
 }
@@ -114,12 +178,115 @@ void AgentManager::stopAllAgents() {
     std::lock_guard<std::mutex> lock(agentsMutex_);
 
     for (const auto& pair : agents_) {
-        if (pair.second->isRunning()) {
-            pair.second->stop();
+        if (pair.second->agent->isRunning()) {
+            pair.second->agent->stop();
         }
     }
 }
 
+// =============================================================================
+// Mailboxes
+// =============================================================================
+
+std::shared_ptr<AgentManager::AgentSlot> AgentManager::findSlot(const std::string& agentId) const {
+    std::lock_guard<std::mutex> lock(agentsMutex_);
+
+    auto it = agents_.find(agentId);
+    return it != agents_.end() ? it->second : nullptr;
+}
+
+AgentRequest AgentManager::post(const std::shared_ptr<AgentSlot>& slot,
+                                const std::string& message) {
+    AgentRequest request;
+    if (slot->closed.load() || !slot->agent->isRunning()) {
+        request.status = AgentRequest::Status::NotRunning;
+        return request;
+    }
+
+    Envelope envelope;
+    envelope.message = message;
+    envelope.cancelled = std::make_shared<std::atomic<bool>>(false);
+    envelope.postedTicks = juce::Time::getHighResolutionTicks();
+
+    auto reply = envelope.reply.get_future();
+    auto cancelled = envelope.cancelled;
+
+    if (!slot->mailbox.push(envelope)) {
+        slot->rejected.fetch_add(1);
+        request.status = AgentRequest::Status::MailboxFull;
+        return request;
+    }
+
+    request.status = AgentRequest::Status::Accepted;
+    request.reply = std::move(reply);
+    request.cancelled_ = std::move(cancelled);
+    schedule(slot);
+    return request;
+}
+
+void AgentManager::schedule(const std::shared_ptr<AgentSlot>& slot) {
+    // At most one job per agent, so an agent never runs on two workers at once
+    if (slot->scheduled.exchange(true)) {
+        return;
+    }
+
+    pool_.addJob([slot] { return runSlot(*slot); });
+}
+
+juce::ThreadPoolJob::JobStatus AgentManager::runSlot(AgentSlot& slot) {
+    Envelope envelope;
+    for (int i = 0; i < kMessagesPerTurn && slot.mailbox.pop(envelope); ++i) {
+        deliver(slot, envelope);
+    }
+
+    // More waiting: go to the back of the pool's queue so other agents get a turn
+    if (!slot.mailbox.isEmpty()) {
+        return juce::ThreadPoolJob::jobNeedsRunningAgain;
+    }
+
+    slot.scheduled.store(false);
+
+    // A post that landed after the check above saw scheduled == true and didn't add a job
+    if (!slot.mailbox.isEmpty() && !slot.scheduled.exchange(true)) {
+        return juce::ThreadPoolJob::jobNeedsRunningAgain;
+    }
+    return juce::ThreadPoolJob::jobHasFinished;
+}
+
+void AgentManager::deliver(AgentSlot& slot, Envelope& envelope) {
+    if (envelope.cancelled->load() || slot.closed.load() || !slot.agent->isRunning()) {
+        slot.cancelled.fetch_add(1);
+        envelope.reply.set_value("");
+        return;
+    }
+
+    auto start = juce::Time::getHighResolutionTicks();
+    bool first = slot.processed.load(std::memory_order_relaxed) == 0;
+    updateAverage(slot.averageWaitMs, ticksToMs(start - envelope.postedTicks), first);
+
+    std::string response;
+    std::exception_ptr error;
+    try {
+        response = slot.agent->processMessage(envelope.message);
+    } catch (...) {
+        error = std::current_exception();
+    }
+
+    double processMs = ticksToMs(juce::Time::getHighResolutionTicks() - start);
+    updateAverage(slot.averageProcessMs, processMs, first);
+    if (processMs > slot.maxProcessMs.load(std::memory_order_relaxed)) {
+        slot.maxProcessMs.store(processMs, std::memory_order_relaxed);
+    }
+    slot.processed.fetch_add(1);
+
+    // Metrics first, so a caller woken by the reply sees them updated
+    if (error) {
+        envelope.reply.set_exception(error);
+    } else {
+        envelope.reply.set_value(std::move(response));
+    }
+}
+
 void AgentManager::handleAgentMessage(const std::string& fromAgent, const std::string& message) {
     // For now, just log the message
     // In the future, this could route messages between agents or to the DAW
@@ -2,21 +2,83 @@
 
 #include <juce_core/juce_core.h>
 
+#include <atomic>
+#include <future>
 #include <memory>
 #include <mutex>
 #include <vector>
 
 #include "agent_interface.hpp"
+#include "agent_mailbox.hpp"
+
+/**
+ * @brief Snapshot of one agent's mailbox and timing
+ */
+struct AgentMetrics {
+    size_t queueDepth = 0;     // Messages waiting in the mailbox
+    size_t mailboxCapacity = 0;
+    uint64_t processed = 0;    // Messages handed to processMessage()
+    uint64_t rejected = 0;     // Posts refused because the mailbox was full
+    uint64_t cancelled = 0;    // Messages dropped before they were processed
+    double averageWaitMs = 0.0;     // Time spent queued (moving average)
+    double averageProcessMs = 0.0;  // Time spent in processMessage() (moving average)
+    double maxProcessMs = 0.0;
+};
+
+/**
+ * @brief Handle to a message posted to an agent
+ *
+ * If the message was accepted, reply becomes ready with the agent's response once the
+ * agent has processed it, or with an empty string if it was cancelled (or the agent
+ * stopped) first.
+ */
+struct AgentRequest {
+    enum class Status {
+        Accepted,
+        UnknownAgent,
+        NotRunning,
+        MailboxFull  // Back-pressure: the agent is behind, try again later
+    };
+
+    Status status = Status::UnknownAgent;
+    std::future<std::string> reply;
+
+    bool isAccepted() const {
+        return status == Status::Accepted;
+    }
+
+    /**
+     * @brief Drop the message if the agent hasn't started on it yet
+     */
+    void cancel() {
+        if (cancelled_) {
+            cancelled_->store(true);
+        }
+    }
+
+  private:
+    friend class AgentManager;
+    std::shared_ptr<std::atomic<bool>> cancelled_;
+};
 
 /**
  * @brief Manages all AI agents in the MAGDA
  *
  * The AgentManager coordinates communication between agents and the DAW,
  * handles agent lifecycle, and provides a simple message routing system.
+ *
+ * Each agent has a bounded mailbox and is run on a shared worker pool, so posting a
+ * message never waits for an agent and a slow agent only delays its own messages. An
+ * agent processes one message at a time, in the order they were posted; different
+ * agents run concurrently.
  */
 class AgentManager {
   public:
-    AgentManager();
+    /**
+     * @param numWorkerThreads Threads shared by all agents
+     * @param mailboxCapacity Messages each agent can have waiting before posts are refused
+     */
+    explicit AgentManager(int numWorkerThreads = 2, size_t mailboxCapacity = 64);
     ~AgentManager();
 
     /**
@@ -28,6 +90,10 @@ class AgentManager {
 
     /**
      * @brief Unregister an agent
+     *
+     * Messages still waiting in its mailbox are cancelled. A message the agent is
+     * already processing runs to completion on its worker.
+     *
      * @param agentId The ID of the agent to unregister
      * @return true if successful, false otherwise
      */
@@ -47,18 +113,36 @@ class AgentManager {
     std::vector<std::shared_ptr<AgentInterface>> getAllAgents() const;
 
     /**
-     * @brief Send a message to a specific agent
+     * @brief Queue a message for an agent without waiting for it
      * @param agentId The ID of the target agent
      * @param message The message to send
-     * @return The agent's response (empty if no response)
+     * @return Whether the message was accepted, and the future reply if it was
+     */
+    AgentRequest postToAgent(const std::string& agentId, const std::string& message);
+
+    /**
+     * @brief Send a message to a specific agent and wait for the response
+     *
+     * Blocks the calling thread (never call it from the message thread); other agents
+     * keep running meanwhile.
+     *
+     * @param agentId The ID of the target agent
+     * @param message The message to send
+     * @return The agent's response (empty if no response, or the message wasn't accepted)
      */
     std::string sendToAgent(const std::string& agentId, const std::string& message);
 
     /**
      * @brief Broadcast a message to all agents
      * @param message The message to broadcast
+     * @return Number of agents whose mailbox accepted the message
      */
-    void broadcastMessage(const std::string& message);
+    size_t broadcastMessage(const std::string& message);
+
+    /**
+     * @brief Mailbox and timing figures for an agent (all zero if it isn't registered)
+     */
+    AgentMetrics getAgentMetrics(const std::string& agentId) const;
 
     /**
      * @brief Get the number of registered agents
@@ -76,6 +160,42 @@ class AgentManager {
     void stopAllAgents();
 
   private:
+    struct Envelope {
+        std::string message;
+        std::promise<std::string> reply;
+        std::shared_ptr<std::atomic<bool>> cancelled;
+        juce::int64 postedTicks = 0;
+    };
+
+    /**
+     * @brief Per-agent mailbox and worker state, shared with its pool jobs
+     */
+    struct AgentSlot {
+        AgentSlot(std::shared_ptr<AgentInterface> a, size_t mailboxCapacity)
+            : agent(std::move(a)), mailbox(mailboxCapacity) {}
+
+        std::shared_ptr<AgentInterface> agent;
+        AgentMailbox<Envelope> mailbox;
+        std::atomic<bool> scheduled{false};  // A pool job owns the mailbox's reading end
+        std::atomic<bool> closed{false};     // Unregistered: drain without processing
+
+        std::atomic<uint64_t> processed{0};
+        std::atomic<uint64_t> rejected{0};
+        std::atomic<uint64_t> cancelled{0};
+        std::atomic<double> averageWaitMs{0.0};
+        std::atomic<double> averageProcessMs{0.0};
+        std::atomic<double> maxProcessMs{0.0};
+    };
+
+    // Messages one agent handles before its job yields the worker to other agents
+    static constexpr int kMessagesPerTurn = 8;
+
+    std::shared_ptr<AgentSlot> findSlot(const std::string& agentId) const;
+    AgentRequest post(const std::shared_ptr<AgentSlot>& slot, const std::string& message);
+    void schedule(const std::shared_ptr<AgentSlot>& slot);
+    static juce::ThreadPoolJob::JobStatus runSlot(AgentSlot& slot);
+    static void deliver(AgentSlot& slot, Envelope& envelope);
+
     /**
      * @brief Handle messages from agents
      * @param fromAgent The ID of the agent sending the message
@@ -83,6 +203,11 @@ class AgentManager {
      */
     void handleAgentMessage(const std::string& fromAgent, const std::string& message);
 
+    const size_t mailboxCapacity_;
+
     mutable std::mutex agentsMutex_;
-    std::map<std::string, std::shared_ptr<AgentInterface>> agents_;
+    std::map<std::string, std::shared_ptr<AgentSlot>> agents_;
+
+    // Declared last so it is destroyed (and its jobs finished) before the agents
+    juce::ThreadPool pool_;
 };
@@ -15,6 +15,18 @@ AudioBridge::AudioBridge(te::Engine& engine, te::Edit& edit) : engine_(engine),
     // Register as ClipManager listener
     ClipManager::getInstance().addListener(this);
 
+    // The launch clock times the playhead from the audio device. It is not installed as
+    // ClipManager's launch handler yet: the edit doesn't play session clips, so a launch
+    // would come due with nothing to start
+    // TODO: start session clips at the launch sample (Tracktion clip slots), then call
+    // ClipManager::getInstance().setLaunchHandler(this)
+    engine_.getDeviceManager().deviceManager.addAudioCallback(&launchClock_);
+
+    // External plugin binaries are prefetched in the background; each plugin is then
+    // instantiated on the message thread in its own message
+    pluginPrefetchQueue_ = std::make_unique<PluginPrefetchQueue>(
+        [this](const PluginPrefetchQueue::Request& request) { handlePluginPrefetched(request); });
+
     // Master metering will be registered when playback context is available
     // (done in timerCallback when context exists)
 
@@ -33,6 +45,12 @@ AudioBridge::~AudioBridge() {
     // Stop timer immediately
     stopTimer();
 
+    // Stop the launch clock before the engine it drives goes away
+    engine_.getDeviceManager().deviceManager.removeAudioCallback(&launchClock_);
+
+    // Cancel queued plugin loads and wait for prefetch jobs to finish
+    pluginPrefetchQueue_.reset();
+
     // Remove listeners to stop receiving notifications
     TrackManager::getInstance().removeListener(this);
     ClipManager::getInstance().removeListener(this);
@@ -113,6 +131,28 @@ void AudioBridge::masterChannelChanged() {
     // TODO: Handle master mute (may need different approach than track mute)
 }
 
+void AudioBridge::trackChangesCommitted(const ModelChangeSet& changes) {
+    // A batch of edits - one engine sync covers them all. syncAll() already resyncs every
+    // track's plugins and the master channel.
+    if (changes.trackListChanged) {
+        syncAll();
+    } else {
+        for (auto trackId : changes.trackDevices) {
+            syncTrackPlugins(trackId);
+        }
+        if (changes.masterChannelChanged) {
+            masterChannelChanged();
+        }
+    }
+
+    for (auto trackId : changes.tracks.modified) {
+        trackPropertyChanged(trackId);
+    }
+    for (auto deviceId : changes.devices) {
+        devicePropertyChanged(deviceId);
+    }
+}
+
 void AudioBridge::deviceParameterChanged(DeviceId deviceId, int paramIndex, float newValue) {
     // A single device parameter changed - sync only that parameter to processor
     auto* processor = getDeviceProcessor(deviceId);
@@ -136,21 +176,11 @@ void AudioBridge::devicePropertyChanged(DeviceId deviceId) {
         return;
     }
 
-    // Find the DeviceInfo to get updated values
-    // We need to search through all tracks to find this device
-    auto& tm = TrackManager::getInstance();
-    for (const auto& track : tm.getTracks()) {
-        for (const auto& element : track.chainElements) {
-            if (std::holds_alternative<DeviceInfo>(element)) {
-                const auto& device = std::get<DeviceInfo>(element);
-                if (device.id == deviceId) {
-                    DBG("  Found device in track " << track.id << ", syncing...");
-                    // Sync processor from the updated DeviceInfo
-                    processor->syncFromDeviceInfo(device);
-                    return;
-                }
-            }
-        }
+    // Find the DeviceInfo to get updated values (at any depth)
+    if (const auto* device = TrackManager::getInstance().getDeviceById(deviceId)) {
+        // Sync processor from the updated DeviceInfo
+        processor->syncFromDeviceInfo(*device);
+        return;
     }
     DBG("  Device not found in any track!");
 }
@@ -202,6 +232,17 @@ void AudioBridge::clipPropertyChanged(ClipId clipId) {
     syncClipToEngine(clipId);
 }
 
+void AudioBridge::clipChangesCommitted(const ModelChangeSet& changes) {
+    // clipsChanged() syncs every clip, so the individual changes only matter without it
+    if (changes.clipListChanged) {
+        clipsChanged();
+        return;
+    }
+    for (auto clipId : changes.clips.modified) {
+        syncClipToEngine(clipId);
+    }
+}
+
 void AudioBridge::clipSelectionChanged(ClipId clipId) {
     // Selection changed - we don't need to do anything here
     // The UI will handle this
@@ -588,7 +629,8 @@ te::Plugin::Ptr AudioBridge::loadBuiltInPlugin(const TrackId TRACK_ID, const juc
 }
 
 PluginLoadResult AudioBridge::loadExternalPlugin(TrackId trackId,
-                                                 const juce::PluginDescription& description) {
+                                                 const juce::PluginDescription& description,
+                                                 int insertIndex) {
     MAGDA_MONITOR_SCOPE("PluginLoad");
 
     auto* track = getAudioTrack(trackId);
@@ -647,7 +689,7 @@ PluginLoadResult AudioBridge::loadExternalPlugin(TrackId trackId,
                 }
             }
 
-            track->pluginList.insertPlugin(plugin, -1, nullptr);
+            track->pluginList.insertPlugin(plugin, insertIndex, nullptr);
             std::cout << "Loaded external plugin: " << description.name << " on track " << trackId
                       << std::endl;
             return PluginLoadResult::Success(plugin);
@@ -768,6 +810,66 @@ DeviceProcessor* AudioBridge::getDeviceProcessor(DeviceId deviceId) const {
     return it != deviceProcessors_.end() ? it->second.get() : nullptr;
 }
 
+std::map<DeviceId, juce::MemoryBlock> AudioBridge::getPluginStates() const {
+    std::map<DeviceId, te::Plugin::Ptr> plugins;
+    {
+        juce::ScopedLock lock(mappingLock_);
+        plugins = deviceToPlugin_;
+    }
+
+    std::map<DeviceId, juce::MemoryBlock> states;
+    for (const auto& [deviceId, plugin] : plugins) {
+        if (!plugin) {
+            continue;
+        }
+        plugin->flushPluginStateToValueTree();
+        juce::MemoryOutputStream out;
+        plugin->state.writeToStream(out);
+        states[deviceId] = out.getMemoryBlock();
+    }
+
+    // Devices still loading keep the state they were opened with
+    for (const auto& [deviceId, state] : pendingPluginStates_) {
+        states.emplace(deviceId, state);
+    }
+    return states;
+}
+
+void AudioBridge::setPendingPluginState(DeviceId deviceId, juce::MemoryBlock state) {
+    pendingPluginStates_[deviceId] = std::move(state);
+}
+
+void AudioBridge::clearEngineState() {
+    if (pluginPrefetchQueue_) {
+        pluginPrefetchQueue_->cancelAll();
+    }
+    if (windowManager_) {
+        windowManager_->closeAllWindows();
+    }
+
+    std::vector<TrackId> trackIds;
+    {
+        juce::ScopedLock lock(mappingLock_);
+        for (const auto& [trackId, track] : trackMapping_) {
+            trackIds.push_back(trackId);
+        }
+        // Processors wrap the plugins, so they go before the plugins do
+        deviceProcessors_.clear();
+        deviceToPlugin_.clear();
+        pluginToDevice_.clear();
+        trackIdToEngineId_.clear();
+        clipIdToEngineId_.clear();
+        engineIdToClipId_.clear();
+    }
+
+    // Deleting a track deletes its plugins and clips with it
+    for (auto trackId : trackIds) {
+        removeAudioTrack(trackId);
+    }
+    pendingPluginStates_.clear();
+    pendingMidiRoutes_.clear();
+}
+
 te::AudioTrack* AudioBridge::createAudioTrack(TrackId trackId, const juce::String& name) {
     // Check if track already exists
     {
@@ -803,6 +905,10 @@ te::AudioTrack* AudioBridge::createAudioTrack(TrackId trackId, const juce::Strin
 void AudioBridge::removeAudioTrack(TrackId trackId) {
     te::AudioTrack* track = nullptr;
 
+    if (pluginPrefetchQueue_) {
+        pluginPrefetchQueue_->cancelTrack(trackId);
+    }
+
     {
         juce::ScopedLock lock(mappingLock_);
         auto it = trackMapping_.find(trackId);
@@ -857,6 +963,15 @@ void AudioBridge::syncAll() {
         syncTrackPlugins(track.id);
     }
 
+    // Free the launch slots of deleted tracks; a full queue keeps the track for next time
+    for (auto it = launchTracks_.begin(); it != launchTracks_.end();) {
+        if (tm.getTrack(*it) == nullptr && clipLaunchEngine_.releaseTrack(*it)) {
+            it = launchTracks_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
     // Sync master channel volume/pan to Tracktion Engine
     masterChannelChanged();
 }
@@ -924,11 +1039,25 @@ void AudioBridge::syncTrackPlugins(TrackId trackId) {
         }
     }
 
+    // Cancel background loads for devices removed before their plugin arrived
+    for (auto deviceId : pluginPrefetchQueue_->getPendingDevices(trackId)) {
+        if (std::find(magdaDevices.begin(), magdaDevices.end(), deviceId) == magdaDevices.end()) {
+            pluginPrefetchQueue_->cancel(deviceId);
+        }
+    }
+
     // Add new plugins for MAGDA devices that don't have TE counterparts
     for (const auto& element : trackInfo->chainElements) {
         if (std::holds_alternative<DeviceInfo>(element)) {
             const auto& device = std::get<DeviceInfo>(element);
 
+            // Placeholders are swapped in when their plugin finishes loading. Failed loads
+            // are not retried on every sync - re-adding the device tries again.
+            if (pluginPrefetchQueue_->isPending(device.id) ||
+                device.loadState == DeviceLoadState::Failed) {
+                continue;
+            }
+
             juce::ScopedLock lock(mappingLock_);
             if (deviceToPlugin_.find(device.id) == deviceToPlugin_.end()) {
                 // Load this device as a plugin
@@ -991,6 +1120,11 @@ void AudioBridge::updateTransportState(bool isPlaying, bool justStarted, bool ju
     justStartedFlag_.store(justStarted, std::memory_order_release);
     justLoopedFlag_.store(justLooped, std::memory_order_release);
 
+    // Realign the launch clock with the transport whenever it starts or jumps back
+    if (justStarted || justLooped) {
+        syncTransportPosition(edit_.getTransport().position.get().inSeconds());
+    }
+
     // Enable/disable tone generators based on transport state
     juce::ScopedLock lock(mappingLock_);
 
@@ -1006,6 +1140,129 @@ void AudioBridge::updateTransportState(bool isPlaying, bool justStarted, bool ju
     }
 }
 
+// =============================================================================
+// Session Clip Launching
+// =============================================================================
+
+void AudioBridge::launchClip(ClipId clipId, TrackId trackId, LaunchQuantization quantization) {
+    updateClipLaunchTempoMap();
+    if (!clipLaunchEngine_.launch(clipId, trackId, quantization)) {
+        ClipManager::getInstance().markClipLaunchCancelled(clipId);
+        return;
+    }
+    launchTracks_.insert(trackId);
+}
+
+void AudioBridge::stopClip(ClipId clipId, TrackId trackId, LaunchQuantization quantization) {
+    clipLaunchEngine_.stop(clipId, trackId, quantization);
+}
+
+void AudioBridge::stopAllClips(LaunchQuantization quantization) {
+    clipLaunchEngine_.stopAll(quantization);
+}
+
+void AudioBridge::syncTransportPosition(double positionSeconds) {
+    auto sampleRate = launchClock_.getSampleRate();
+    if (sampleRate > 0.0) {
+        clipLaunchEngine_.locate(static_cast<juce::int64>(positionSeconds * sampleRate + 0.5));
+    }
+}
+
+void AudioBridge::updateClipLaunchTempoMap() {
+    auto sampleRate = launchClock_.getSampleRate();
+    if (sampleRate <= 0.0) {
+        return;
+    }
+
+    // Same single tempo and meter the rest of the app reads from the start of the edit
+    auto start = te::TimePosition::fromSeconds(0.0);
+    ClipLaunchEngine::TempoSegment segment;
+    segment.bpm = edit_.tempoSequence.getTempoAt(start).getBpm();
+    segment.beatsPerBar = edit_.tempoSequence.getTimeSigAt(start).numerator;
+
+    auto tempoMap = std::make_unique<ClipLaunchEngine::TempoMap>(
+        sampleRate, std::vector<ClipLaunchEngine::TempoSegment>{segment});
+    if (publishedTempoMap_ && *publishedTempoMap_ == *tempoMap) {
+        return;
+    }
+
+    auto published = std::make_unique<ClipLaunchEngine::TempoMap>(*tempoMap);
+    if (clipLaunchEngine_.setTempoMap(std::move(tempoMap))) {
+        publishedTempoMap_ = std::move(published);
+    }
+}
+
+void AudioBridge::dispatchClipLaunchEvents() {
+    auto& clipManager = ClipManager::getInstance();
+    bool complete = clipLaunchEngine_.dispatchEvents([&clipManager](const auto& event) {
+        switch (event.type) {
+            case ClipLaunchEngine::Event::Type::Started:
+                clipManager.markClipLaunched(event.clipId);
+                break;
+            case ClipLaunchEngine::Event::Type::Stopped:
+                clipManager.markClipStopped(event.clipId);
+                break;
+            case ClipLaunchEngine::Event::Type::Cancelled:
+                clipManager.markClipLaunchCancelled(event.clipId);
+                break;
+        }
+    });
+    if (complete) {
+        return;
+    }
+
+    // Reports were lost, so the slots may show the wrong state: stop everything and cancel
+    // every launch so the model and the engine agree again
+    clipLaunchEngine_.stopAll(LaunchQuantization::None);
+    std::vector<ClipId> active;
+    for (const auto& clip : clipManager.getClips()) {
+        if (clip.isPlaying || clip.isQueued) {
+            active.push_back(clip.id);
+        }
+    }
+    for (auto clipId : active) {
+        clipManager.markClipStopped(clipId);
+    }
+}
+
+void AudioBridge::LaunchClock::audioDeviceIOCallbackWithContext(
+    const float* const* inputChannelData, int numInputChannels, float* const* outputChannelData,
+    int numOutputChannels, int numSamples, const juce::AudioIODeviceCallbackContext& context) {
+    juce::ignoreUnused(inputChannelData, numInputChannels, context);
+
+    // The device manager mixes every callback's output, so contribute silence
+    for (int channel = 0; channel < numOutputChannels; ++channel) {
+        if (outputChannelData[channel] != nullptr) {
+            juce::FloatVectorOperations::clear(outputChannelData[channel], numSamples);
+        }
+    }
+
+    auto ticks = juce::Time::getHighResolutionTicks();
+    bool playing = owner_.isTransportPlaying();
+    auto& engine = owner_.clipLaunchEngine_;
+    engine.process(numSamples, playing);
+
+    // What is heard now was processed one output latency ago
+    PlayheadClock::Snapshot snapshot;
+    snapshot.sample = engine.getPosition() - (playing ? numSamples : 0) -
+                      outputLatency_.load(std::memory_order_relaxed);
+    snapshot.ticks = ticks;
+    snapshot.sampleRate = sampleRate_.load(std::memory_order_relaxed);
+    snapshot.playing = playing;
+    owner_.playheadClock_.publish(snapshot);
+}
+
+void AudioBridge::LaunchClock::audioDeviceAboutToStart(juce::AudioIODevice* device) {
+    if (device == nullptr) {
+        sampleRate_.store(0.0, std::memory_order_release);
+        return;
+    }
+    outputLatency_.store(device->getOutputLatencyInSamples() +
+                             device->getCurrentBufferSizeSamples(),
+                         std::memory_order_relaxed);
+    sampleRate_.store(device->getCurrentSampleRate(), std::memory_order_release);
+}
+
 // =============================================================================
 // MIDI Activity Monitoring
 // =============================================================================
@@ -1078,10 +1335,15 @@ void AudioBridge::timerCallback() {
     // Apply any pending MIDI routes now that playback context may be available
     applyPendingMidiRoutes();
 
+    // Keep launch boundaries on the current tempo and report launches that happened
+    updateClipLaunchTempoMap();
+    dispatchClipLaunchEvents();
+
     // NOTE: Window state sync is now handled by PluginWindowManager's timer
 
     // Update metering from level measurers (runs at 30 FPS on message thread)
     juce::ScopedLock lock(mappingLock_);
+    bool metersActive = false;
 
     // Update track metering
     for (const auto& [trackId, track] : trackMapping_) {
@@ -1113,6 +1375,7 @@ void AudioBridge::timerCallback() {
         data.rmsR = data.peakR * 0.7f;
 
         meteringBuffer_.pushLevels(trackId, data);
+        metersActive = metersActive || data.peakL > 0.0f || data.peakR > 0.0f;
     }
 
     // Register master meter client with playback context if not done yet
@@ -1134,6 +1397,11 @@ void AudioBridge::timerCallback() {
 
         masterPeakL_.store(peakL, std::memory_order_relaxed);
         masterPeakR_.store(peakR, std::memory_order_relaxed);
+        metersActive = metersActive || peakL > 0.0f || peakR > 0.0f;
+    }
+
+    if (metersActive) {
+        meterActivity_.sendChangeMessage();
     }
 }
 
@@ -1248,91 +1516,14 @@ te::Plugin::Ptr AudioBridge::loadDeviceAsPlugin(TrackId trackId, const DeviceInf
     } else {
         // External plugin - find matching description from KnownPluginList
         if (device.uniqueId.isNotEmpty() || device.fileOrIdentifier.isNotEmpty()) {
-            // Build PluginDescription from DeviceInfo
-            juce::PluginDescription desc;
-            desc.name = device.name;
-            desc.manufacturerName = device.manufacturer;
-            desc.fileOrIdentifier = device.fileOrIdentifier;
-            desc.isInstrument = device.isInstrument;
-
-            // Set format
-            switch (device.format) {
-                case PluginFormat::VST3:
-                    desc.pluginFormatName = "VST3";
-                    break;
-                case PluginFormat::AU:
-                    desc.pluginFormatName = "AudioUnit";
-                    break;
-                case PluginFormat::VST:
-                    desc.pluginFormatName = "VST";
-                    break;
-                default:
-                    break;
-            }
-
-            // Try to find a matching plugin in KnownPluginList
-            DBG("Plugin lookup: searching for name='"
-                << device.name << "' manufacturer='" << device.manufacturer
-                << "' isInstrument=" << (device.isInstrument ? "true" : "false") << " fileOrId='"
-                << device.fileOrIdentifier << "'");
-
-            auto& knownPlugins = engine_.getPluginManager().knownPluginList;
-
-            // Debug: dump all plugins that match the name (case insensitive)
-            DBG("  All matching plugins in KnownPluginList:");
-            for (const auto& kd : knownPlugins.getTypes()) {
-                if (kd.name.containsIgnoreCase(device.name) ||
-                    device.name.containsIgnoreCase(kd.name.toStdString())) {
-                    DBG("    - name='"
-                        << kd.name << "' isInstrument=" << (kd.isInstrument ? "true" : "false")
-                        << " fileOrId='" << kd.fileOrIdentifier << "'"
-                        << " uniqueId='" << kd.uniqueId << "'"
-                        << " identifierString='" << kd.createIdentifierString() << "'");
-                }
-            }
-            bool found = false;
-            for (const auto& knownDesc : knownPlugins.getTypes()) {
-                // Match by fileOrIdentifier (most specific) BUT also check isInstrument
-                // to avoid loading FX when instrument is requested
-                if (knownDesc.fileOrIdentifier == device.fileOrIdentifier &&
-                    knownDesc.isInstrument == device.isInstrument) {
-                    DBG("  -> MATCHED by fileOrIdentifier + isInstrument: " << knownDesc.name);
-                    desc = knownDesc;
-                    found = true;
-                    break;
-                }
-            }
-
-            // Second pass: match by name, manufacturer, AND isInstrument flag
-            if (!found) {
-                for (const auto& knownDesc : knownPlugins.getTypes()) {
-                    if (knownDesc.name == device.name &&
-                        knownDesc.manufacturerName == device.manufacturer &&
-                        knownDesc.isInstrument == device.isInstrument) {
-                        DBG("  -> MATCHED by name+manufacturer+isInstrument: " << knownDesc.name);
-                        desc = knownDesc;
-                        found = true;
-                        break;
-                    }
-                }
-            }
-
-            // Third pass: match by fileOrIdentifier only (fallback)
-            if (!found) {
-                for (const auto& knownDesc : knownPlugins.getTypes()) {
-                    if (knownDesc.fileOrIdentifier == device.fileOrIdentifier) {
-                        DBG("  -> MATCHED by fileOrIdentifier only (fallback): "
-                            << knownDesc.name
-                            << " isInstrument=" << (knownDesc.isInstrument ? "true" : "false"));
-                        desc = knownDesc;
-                        found = true;
-                        break;
-                    }
-                }
-            }
-
-            if (!found) {
-                DBG("  -> NO MATCH FOUND in KnownPluginList!");
+            auto desc = resolveExternalDescription(device);
+
+            if (deferPluginLoading_) {
+                // Leave a placeholder; handlePluginPrefetched() swaps the plugin in
+                pluginPrefetchQueue_->enqueue({device.id, trackId, desc});
+                TrackManager::getInstance().setDeviceLoadState(trackId, device.id,
+                                                               DeviceLoadState::Loading);
+                return nullptr;
             }
 
             auto result = loadExternalPlugin(trackId, desc);
@@ -1358,50 +1549,249 @@ te::Plugin::Ptr AudioBridge::loadDeviceAsPlugin(TrackId trackId, const DeviceInf
     }
 
     if (plugin) {
-        // Store the processor if we created one
-        if (processor) {
-            // Initialize defaults first if DeviceInfo has no parameters
-            // This ensures the plugin starts with sensible values
-            if (device.parameters.empty()) {
-                if (auto* toneProc = dynamic_cast<ToneGeneratorProcessor*>(processor.get())) {
-                    toneProc->initializeDefaults();
-                }
+        finishDeviceLoad(trackId, device, plugin, std::move(processor));
+    }
+
+    return plugin;
+}
+
+juce::PluginDescription AudioBridge::resolveExternalDescription(const DeviceInfo& device) const {
+    // Build PluginDescription from DeviceInfo
+    juce::PluginDescription desc;
+    desc.name = device.name;
+    desc.manufacturerName = device.manufacturer;
+    desc.fileOrIdentifier = device.fileOrIdentifier;
+    desc.isInstrument = device.isInstrument;
+
+    // Set format
+    switch (device.format) {
+        case PluginFormat::VST3:
+            desc.pluginFormatName = "VST3";
+            break;
+        case PluginFormat::AU:
+            desc.pluginFormatName = "AudioUnit";
+            break;
+        case PluginFormat::VST:
+            desc.pluginFormatName = "VST";
+            break;
+        default:
+            break;
+    }
+
+    // Try to find a matching plugin in KnownPluginList
+    DBG("Plugin lookup: searching for name='"
+        << device.name << "' manufacturer='" << device.manufacturer
+        << "' isInstrument=" << (device.isInstrument ? "true" : "false") << " fileOrId='"
+        << device.fileOrIdentifier << "'");
+
+    auto& knownPlugins = engine_.getPluginManager().knownPluginList;
+
+    // Debug: dump all plugins that match the name (case insensitive)
+    DBG("  All matching plugins in KnownPluginList:");
+    for (const auto& kd : knownPlugins.getTypes()) {
+        if (kd.name.containsIgnoreCase(device.name) ||
+            device.name.containsIgnoreCase(kd.name.toStdString())) {
+            DBG("    - name='"
+                << kd.name << "' isInstrument=" << (kd.isInstrument ? "true" : "false")
+                << " fileOrId='" << kd.fileOrIdentifier << "'"
+                << " uniqueId='" << kd.uniqueId << "'"
+                << " identifierString='" << kd.createIdentifierString() << "'");
+        }
+    }
+    bool found = false;
+    for (const auto& knownDesc : knownPlugins.getTypes()) {
+        // Match by fileOrIdentifier (most specific) BUT also check isInstrument
+        // to avoid loading FX when instrument is requested
+        if (knownDesc.fileOrIdentifier == device.fileOrIdentifier &&
+            knownDesc.isInstrument == device.isInstrument) {
+            DBG("  -> MATCHED by fileOrIdentifier + isInstrument: " << knownDesc.name);
+            desc = knownDesc;
+            found = true;
+            break;
+        }
+    }
+
+    // Second pass: match by name, manufacturer, AND isInstrument flag
+    if (!found) {
+        for (const auto& knownDesc : knownPlugins.getTypes()) {
+            if (knownDesc.name == device.name &&
+                knownDesc.manufacturerName == device.manufacturer &&
+                knownDesc.isInstrument == device.isInstrument) {
+                DBG("  -> MATCHED by name+manufacturer+isInstrument: " << knownDesc.name);
+                desc = knownDesc;
+                found = true;
+                break;
             }
+        }
+    }
 
-            // Sync state from DeviceInfo (only applies if it has values)
-            processor->syncFromDeviceInfo(device);
+    // Third pass: match by fileOrIdentifier only (fallback)
+    if (!found) {
+        for (const auto& knownDesc : knownPlugins.getTypes()) {
+            if (knownDesc.fileOrIdentifier == device.fileOrIdentifier) {
+                DBG("  -> MATCHED by fileOrIdentifier only (fallback): "
+                    << knownDesc.name
+                    << " isInstrument=" << (knownDesc.isInstrument ? "true" : "false"));
+                desc = knownDesc;
+                found = true;
+                break;
+            }
+        }
+    }
+
+    if (!found) {
+        DBG("  -> NO MATCH FOUND in KnownPluginList!");
+    }
 
-            // Populate parameters back to TrackManager
-            DeviceInfo tempInfo;
-            processor->populateParameters(tempInfo);
-            TrackManager::getInstance().updateDeviceParameters(device.id, tempInfo.parameters);
+    return desc;
+}
+
+void AudioBridge::finishDeviceLoad(TrackId trackId, const DeviceInfo& device,
+                                   const te::Plugin::Ptr& plugin,
+                                   std::unique_ptr<DeviceProcessor> processor) {
+    // Ownership moves into deviceProcessors_ below
+    auto* processorPtr = processor.get();
+
+    // Restore the plugin's own state saved with the project
+    auto pendingState = pendingPluginStates_.find(device.id);
+    if (pendingState != pendingPluginStates_.end()) {
+        auto tree = juce::ValueTree::readFromData(pendingState->second.getData(),
+                                                  pendingState->second.getSize());
+        if (tree.isValid()) {
+            plugin->restorePluginStateFromValueTree(tree);
+        }
+        pendingPluginStates_.erase(pendingState);
+    }
 
-            deviceProcessors_[device.id] = std::move(processor);
+    // Store the processor if we created one
+    if (processor) {
+        // Initialize defaults first if DeviceInfo has no parameters
+        // This ensures the plugin starts with sensible values
+        if (device.parameters.empty()) {
+            if (auto* toneProc = dynamic_cast<ToneGeneratorProcessor*>(processor.get())) {
+                toneProc->initializeDefaults();
+            }
         }
 
-        // Apply device state
-        plugin->setEnabled(!device.bypassed);
+        // Sync state from DeviceInfo (only applies if it has values)
+        processor->syncFromDeviceInfo(device);
 
-        // For tone generators (always transport-synced), sync initial state with transport
-        if (auto* toneProc = dynamic_cast<ToneGeneratorProcessor*>(processor.get())) {
-            // Get current transport state
-            bool isPlaying = transportPlaying_.load(std::memory_order_acquire);
-            // Bypass if transport is not playing
-            toneProc->setBypassed(!isPlaying);
+        // Populate parameters back to TrackManager
+        DeviceInfo tempInfo;
+        processor->populateParameters(tempInfo);
+        TrackManager::getInstance().updateDeviceParameters(device.id, tempInfo.parameters);
+
+        deviceProcessors_[device.id] = std::move(processor);
+    }
+
+    // Apply device state
+    plugin->setEnabled(!device.bypassed);
+
+    // For tone generators (always transport-synced), sync initial state with transport
+    if (auto* toneProc = dynamic_cast<ToneGeneratorProcessor*>(processorPtr)) {
+        // Get current transport state
+        bool isPlaying = transportPlaying_.load(std::memory_order_acquire);
+        // Bypass if transport is not playing
+        toneProc->setBypassed(!isPlaying);
+    }
+
+    // If this is an instrument, automatically route all MIDI inputs to this track
+    if (device.isInstrument) {
+        setTrackMidiInput(trackId, "all");
+        std::cout << "Auto-routed MIDI input to track " << trackId
+                  << " for instrument: " << device.name << std::endl;
+    }
+
+    std::cout << "Loaded device " << device.id << " (" << device.name << ") as plugin"
+              << std::endl;
+}
+
+void AudioBridge::handlePluginPrefetched(const PluginPrefetchQueue::Request& request) {
+    if (isShuttingDown_.load(std::memory_order_acquire))
+        return;
+
+    auto& tm = TrackManager::getInstance();
+
+    // The device or its track may have gone while the plugin was prefetching
+    auto* device = tm.getDevice(request.trackId, request.deviceId);
+    if (!device || !getAudioTrack(request.trackId))
+        return;
+
+    {
+        juce::ScopedLock lock(mappingLock_);
+        if (deviceToPlugin_.find(request.deviceId) != deviceToPlugin_.end())
+            return;
+    }
+
+    // Copy - loading updates TrackManager, which must not invalidate what we read
+    DeviceInfo deviceCopy = *device;
+
+    // TODO: Instantiation still blocks the message thread for the plugin's full creation
+    // time. te::ExternalPlugin creates its instance synchronously inside the plugin cache;
+    // moving this off the message thread needs createPluginInstanceAsync() and a way to
+    // hand the instance to the ExternalPlugin.
+    auto result = loadExternalPlugin(request.trackId, request.description,
+                                     getPluginInsertIndex(request.trackId, request.deviceId));
+    if (!result.success || !result.plugin) {
+        if (onPluginLoadFailed) {
+            onPluginLoadFailed(request.deviceId, result.errorMessage);
         }
+        std::cerr << "Plugin load failed for device " << request.deviceId << ": "
+                  << result.errorMessage << std::endl;
+        tm.setDeviceLoadState(request.trackId, request.deviceId, DeviceLoadState::Failed);
+        return;
+    }
+
+    auto extProcessor = std::make_unique<ExternalPluginProcessor>(request.deviceId, result.plugin);
+    // Start listening for parameter changes from the plugin's native UI
+    extProcessor->startParameterListening();
+
+    {
+        juce::ScopedLock lock(mappingLock_);
+        deviceToPlugin_[request.deviceId] = result.plugin;
+        pluginToDevice_[result.plugin.get()] = request.deviceId;
+        finishDeviceLoad(request.trackId, deviceCopy, result.plugin, std::move(extProcessor));
+    }
 
-        // If this is an instrument, automatically route all MIDI inputs to this track
-        if (device.isInstrument) {
-            setTrackMidiInput(trackId, "all");
-            std::cout << "Auto-routed MIDI input to track " << trackId
-                      << " for instrument: " << device.name << std::endl;
+    // Placeholder is now a real device - notifies listeners so the UI shows its parameters
+    tm.setDeviceLoadState(request.trackId, request.deviceId, DeviceLoadState::Ready);
+}
+
+int AudioBridge::getPluginInsertIndex(TrackId trackId, DeviceId deviceId) const {
+    auto* teTrack = getAudioTrack(trackId);
+    auto* trackInfo = TrackManager::getInstance().getTrack(trackId);
+    if (!teTrack || !trackInfo)
+        return -1;
+
+    auto& plugins = teTrack->pluginList;
+
+    // Insert before the first already-loaded device that follows this one in the chain,
+    // so plugins finishing out of order still end up in chain order
+    bool pastDevice = false;
+    for (const auto& element : trackInfo->chainElements) {
+        if (!isDevice(element))
+            continue;
+
+        auto id = magda::getDevice(element).id;
+        if (id == deviceId) {
+            pastDevice = true;
+        } else if (pastDevice) {
+            if (auto plugin = getPlugin(id)) {
+                int index = plugins.indexOf(plugin.get());
+                if (index >= 0)
+                    return index;
+            }
         }
+    }
 
-        std::cout << "Loaded device " << device.id << " (" << device.name << ") as plugin"
-                  << std::endl;
+    // Otherwise ahead of the track's fader and meter
+    for (int i = 0; i < plugins.size(); ++i) {
+        if (dynamic_cast<te::VolumeAndPanPlugin*>(plugins[i]) ||
+            dynamic_cast<te::LevelMeterPlugin*>(plugins[i]))
+            return i;
     }
 
-    return plugin;
+    return -1;
 }
 
 // =============================================================================
@@ -5,14 +5,18 @@
 #include <functional>
 #include <map>
 #include <memory>
+#include <set>
 
 #include "../core/ClipManager.hpp"
 #include "../core/DeviceInfo.hpp"
 #include "../core/TrackManager.hpp"
 #include "../core/TypeIds.hpp"
+#include "ClipLaunchEngine.hpp"
 #include "DeviceProcessor.hpp"
 #include "MeteringBuffer.hpp"
 #include "ParameterQueue.hpp"
+#include "PlayheadClock.hpp"
+#include "PluginPrefetchQueue.hpp"
 
 namespace magda {
 
@@ -46,14 +50,21 @@ struct PluginLoadResult {
  * - Maps DeviceId to tracktion::Plugin instances
  * - Maps TrackId to tracktion::AudioTrack instances
  * - Maps ClipId to tracktion::Clip instances
- * - Loads built-in and external plugins
+ * - Loads built-in and external plugins (external ones deferred behind a binary prefetch,
+ *   see PluginPrefetchQueue)
  * - Manages metering and parameter communication
+ * - Can schedule session clip launches on the audio clock (see ClipLaunchEngine). The
+ *   edit doesn't play session clips yet, so the bridge is not installed as ClipManager's
+ *   launch handler; the launch clock only drives the playhead clock for now
  *
  * Thread Safety:
  * - UI thread: Receives TrackManager/ClipManager notifications, updates mappings
  * - Audio thread: Reads mappings, processes parameter changes, pushes metering
  */
-class AudioBridge : public TrackManagerListener, public ClipManagerListener, public juce::Timer {
+class AudioBridge : public TrackManagerListener,
+                    public ClipManagerListener,
+                    public ClipLaunchHandler,
+                    public juce::Timer {
   public:
     /**
      * @brief Construct AudioBridge with Tracktion Engine references
@@ -73,6 +84,7 @@ class AudioBridge : public TrackManagerListener, public ClipManagerListener, pub
     void devicePropertyChanged(DeviceId deviceId) override;
     void deviceParameterChanged(DeviceId deviceId, int paramIndex, float newValue) override;
     void masterChannelChanged() override;
+    void trackChangesCommitted(const ModelChangeSet& changes) override;
 
     // =========================================================================
     // ClipManagerListener implementation
@@ -81,6 +93,15 @@ class AudioBridge : public TrackManagerListener, public ClipManagerListener, pub
     void clipsChanged() override;
     void clipPropertyChanged(ClipId clipId) override;
     void clipSelectionChanged(ClipId clipId) override;
+    void clipChangesCommitted(const ModelChangeSet& changes) override;
+
+    // =========================================================================
+    // ClipLaunchHandler implementation
+    // =========================================================================
+
+    void launchClip(ClipId clipId, TrackId trackId, LaunchQuantization quantization) override;
+    void stopClip(ClipId clipId, TrackId trackId, LaunchQuantization quantization) override;
+    void stopAllClips(LaunchQuantization quantization) override;
 
     // =========================================================================
     // Clip Synchronization
@@ -111,13 +132,34 @@ class AudioBridge : public TrackManagerListener, public ClipManagerListener, pub
     te::Plugin::Ptr loadBuiltInPlugin(TrackId trackId, const juce::String& type);
 
     /**
-     * @brief Load an external plugin (VST3, AU)
+     * @brief Load an external plugin (VST3, AU) synchronously
      * @param trackId The MAGDA track ID
      * @param description Plugin description from plugin scan
+     * @param insertIndex Position in the track's plugin list (-1 = end)
      * @return PluginLoadResult with success status, error message, and plugin pointer
      */
-    PluginLoadResult loadExternalPlugin(TrackId trackId,
-                                        const juce::PluginDescription& description);
+    PluginLoadResult loadExternalPlugin(TrackId trackId, const juce::PluginDescription& description,
+                                        int insertIndex = -1);
+
+    /**
+     * @brief Defer external plugin devices until their binaries are prefetched
+     * (default: true)
+     *
+     * When enabled, syncing a track leaves external devices as Loading placeholders and
+     * swaps the plugins into the graph once they are instantiated. Instantiation still
+     * runs on the message thread, one plugin per message. Disable for callers that need
+     * the plugin to exist as soon as the sync returns.
+     */
+    void setDeferPluginLoading(bool defer) {
+        deferPluginLoading_ = defer;
+    }
+
+    /**
+     * @brief Check if a device's plugin is still queued for loading
+     */
+    bool isPluginLoadPending(DeviceId deviceId) const {
+        return pluginPrefetchQueue_ && pluginPrefetchQueue_->isPending(deviceId);
+    }
 
     /**
      * @brief Callback invoked when a plugin fails to load
@@ -163,6 +205,25 @@ class AudioBridge : public TrackManagerListener, public ClipManagerListener, pub
      */
     DeviceProcessor* getDeviceProcessor(DeviceId deviceId) const;
 
+    /**
+     * @brief Serialised plugin state of every loaded device (for project save)
+     */
+    std::map<DeviceId, juce::MemoryBlock> getPluginStates() const;
+
+    /**
+     * @brief Plugin state to restore once the device's plugin is loaded (project open)
+     */
+    void setPendingPluginState(DeviceId deviceId, juce::MemoryBlock state);
+
+    /**
+     * @brief Delete every engine track, plugin and clip the bridge created (project open)
+     *
+     * A loaded project reuses track, device and clip IDs from 1, so nothing from the
+     * previous session may stay mapped under them. Pending plugin loads and states are
+     * dropped too; the next sync rebuilds everything from the model.
+     */
+    void clearEngineState();
+
     /**
      * @brief Create a Tracktion AudioTrack for a MAGDA track
      * @param trackId MAGDA track ID
@@ -191,6 +252,16 @@ class AudioBridge : public TrackManagerListener, public ClipManagerListener, pub
         return meteringBuffer_;
     }
 
+    /**
+     * @brief Sends a change message whenever a meter reading above silence is published
+     *
+     * Lets meter views stop animating while everything is silent and wake up on the next
+     * sound. Messages arrive on the message thread.
+     */
+    juce::ChangeBroadcaster& getMeterActivity() {
+        return meterActivity_;
+    }
+
     // =========================================================================
     // Parameter Queue
     // =========================================================================
@@ -248,6 +319,18 @@ class AudioBridge : public TrackManagerListener, public ClipManagerListener, pub
      */
     void updateTransportState(bool isPlaying, bool justStarted, bool justLooped);
 
+    /**
+     * @brief Realign the audio clock with a transport position (seek, start or loop)
+     */
+    void syncTransportPosition(double positionSeconds);
+
+    /**
+     * @brief Audible transport position published by the audio thread (any thread may read)
+     */
+    const PlayheadClock& getPlayheadClock() const {
+        return playheadClock_;
+    }
+
     /**
      * @brief Get current transport playing state (audio thread safe)
      */
@@ -492,15 +575,28 @@ class AudioBridge : public TrackManagerListener, public ClipManagerListener, pub
     // Create track mapping
     void ensureTrackMapping(TrackId trackId);
 
+    // Session clip launching: publish tempo changes, report launches to ClipManager
+    void updateClipLaunchTempoMap();
+    void dispatchClipLaunchEvents();
+
     // Plugin creation helpers
     te::Plugin::Ptr createToneGenerator(te::AudioTrack* track);
     // Note: createVolumeAndPan removed - track volume is separate infrastructure
     te::Plugin::Ptr createLevelMeter(te::AudioTrack* track);
     te::Plugin::Ptr createFourOscSynth(te::AudioTrack* track);
 
-    // Convert DeviceInfo to plugin
+    // Convert DeviceInfo to plugin (nullptr while an external plugin waits for its prefetch)
     te::Plugin::Ptr loadDeviceAsPlugin(TrackId trackId, const DeviceInfo& device);
 
+    // External plugin helpers
+    juce::PluginDescription resolveExternalDescription(const DeviceInfo& device) const;
+    void handlePluginPrefetched(const PluginPrefetchQueue::Request& request);
+    int getPluginInsertIndex(TrackId trackId, DeviceId deviceId) const;
+
+    // Register processor, apply device state and MIDI routing for a newly loaded plugin
+    void finishDeviceLoad(TrackId trackId, const DeviceInfo& device, const te::Plugin::Ptr& plugin,
+                          std::unique_ptr<DeviceProcessor> processor);
+
     // References to Tracktion Engine (not owned)
     te::Engine& engine_;
     te::Edit& edit_;
@@ -524,12 +620,47 @@ class AudioBridge : public TrackManagerListener, public ClipManagerListener, pub
     // Lock-free communication buffers
     MeteringBuffer meteringBuffer_;
     ParameterQueue parameterQueue_;
+    juce::ChangeBroadcaster meterActivity_;
 
     // Transport state (UI thread writes, audio thread reads - lock-free)
     std::atomic<bool> transportPlaying_{false};
     std::atomic<bool> justStartedFlag_{false};
     std::atomic<bool> justLoopedFlag_{false};
 
+    /**
+     * @brief Runs the clip launch engine once per audio device block
+     *
+     * Registered with the device manager alongside the engine's own callback so that
+     * launches are counted in device samples. It advances the launch clock, publishes
+     * the audible position to the playhead clock and leaves the output buffers silent.
+     */
+    class LaunchClock : public juce::AudioIODeviceCallback {
+      public:
+        explicit LaunchClock(AudioBridge& owner) : owner_(owner) {}
+
+        void audioDeviceIOCallbackWithContext(
+            const float* const* inputChannelData, int numInputChannels,
+            float* const* outputChannelData, int numOutputChannels, int numSamples,
+            const juce::AudioIODeviceCallbackContext& context) override;
+        void audioDeviceAboutToStart(juce::AudioIODevice* device) override;
+        void audioDeviceStopped() override {}
+
+        double getSampleRate() const {
+            return sampleRate_.load(std::memory_order_acquire);
+        }
+
+      private:
+        AudioBridge& owner_;
+        std::atomic<double> sampleRate_{0.0};
+        std::atomic<int> outputLatency_{0};  // Samples between processing and hearing
+    };
+
+    ClipLaunchEngine clipLaunchEngine_;
+    LaunchClock launchClock_{*this};
+    PlayheadClock playheadClock_;
+    std::unique_ptr<ClipLaunchEngine::TempoMap> publishedTempoMap_;  // Copy of the last map sent
+    std::set<TrackId> launchTracks_;  // Tracks that may hold a launch engine slot
+
     // MIDI activity flags (audio thread writes, UI thread reads/clears - lock-free)
     static constexpr int kMaxTracks = 128;
     std::array<std::atomic<bool>, kMaxTracks> midiActivityFlags_;
@@ -548,6 +679,13 @@ class AudioBridge : public TrackManagerListener, public ClipManagerListener, pub
     std::vector<std::pair<TrackId, juce::String>> pendingMidiRoutes_;
     void applyPendingMidiRoutes();
 
+    // Deferred external plugin loading
+    std::unique_ptr<PluginPrefetchQueue> pluginPrefetchQueue_;
+    bool deferPluginLoading_ = true;
+
+    // Saved plugin states waiting for their plugin to be instantiated
+    std::map<DeviceId, juce::MemoryBlock> pendingPluginStates_;
+
     // Plugin window manager (owned by TracktionEngineWrapper, destroyed before us)
     PluginWindowManager* windowManager_ = nullptr;
 
@@ -1,14 +1,38 @@
 #include "AudioThumbnailManager.hpp"
 
+#include <cmath>
+
+#include "../profiling/PerformanceProfiler.hpp"
+
 namespace magda {
 
+namespace {
+
+// One column of a min/max or RMS band
+void addColumn(juce::RectangleList<float>& rects, float x, float centreY, float halfHeight,
+               float low, float high) {
+    auto top = centreY - juce::jlimit(-1.0f, 1.0f, high) * halfHeight;
+    auto bottom = centreY - juce::jlimit(-1.0f, 1.0f, low) * halfHeight;
+    rects.addWithoutMerging({x, top, 1.0f, juce::jmax(1.0f, bottom - top)});
+}
+
+void fillBands(juce::Graphics& g, const juce::RectangleList<float>& peakRects,
+               const juce::RectangleList<float>& rmsRects, const juce::Colour& colour) {
+    g.setColour(colour);
+    g.fillRectList(peakRects);
+    g.setColour(colour.brighter(0.3f));
+    g.fillRectList(rmsRects);
+}
+
+}  // namespace
+
 AudioThumbnailManager::AudioThumbnailManager() {
     // Register standard audio formats
     formatManager_.registerBasicFormats();
+}
 
-    // Create thumbnail cache with max 100 thumbnails in memory
-    // Thumbnails are also cached to disk in a temp directory
-    thumbnailCache_ = std::make_unique<juce::AudioThumbnailCache>(100);
+AudioThumbnailManager::~AudioThumbnailManager() {
+    shutdown();
 }
 
 AudioThumbnailManager& AudioThumbnailManager::getInstance() {
@@ -16,55 +40,193 @@ AudioThumbnailManager& AudioThumbnailManager::getInstance() {
     return instance;
 }
 
-juce::AudioThumbnail* AudioThumbnailManager::getThumbnail(const juce::String& audioFilePath) {
-    // Check if thumbnail already exists in cache
-    auto it = thumbnails_.find(audioFilePath);
-    if (it != thumbnails_.end()) {
-        return it->second.get();
+// ============================================================================
+// Lookup
+// ============================================================================
+
+std::shared_ptr<const PeakFile> AudioThumbnailManager::getPeaks(
+    const juce::String& audioFilePath) {
+    auto& entry = touch(audioFilePath);
+    if (entry.peaks != nullptr) {
+        return entry.peaks;
+    }
+    if (entry.failed || entry.cancelled != nullptr) {
+        return nullptr;
+    }
+
+    if (openStoredPeaks(audioFilePath, entry)) {
+        enforceMemoryBudget(entry);
+        return entry.peaks;
+    }
+
+    startBuild(audioFilePath, entry);
+    return nullptr;
+}
+
+double AudioThumbnailManager::getFileDuration(const juce::String& audioFilePath) {
+    if (auto peaks = getPeaks(audioFilePath)) {
+        return peaks->getLengthInSeconds();
+    }
+
+    std::unique_ptr<juce::AudioFormatReader> reader(
+        formatManager_.createReaderFor(juce::File(audioFilePath)));
+    if (reader == nullptr || reader->sampleRate <= 0.0) {
+        return 0.0;
     }
+    return static_cast<double>(reader->lengthInSamples) / reader->sampleRate;
+}
 
-    // Create new thumbnail
-    return createThumbnail(audioFilePath);
+AudioThumbnailManager::Entry& AudioThumbnailManager::touch(const juce::String& audioFilePath) {
+    auto& entry = entries_[audioFilePath];
+    entry.lastUsed = ++useCounter_;
+    return entry;
 }
 
-juce::AudioThumbnail* AudioThumbnailManager::createThumbnail(const juce::String& audioFilePath) {
-    // Validate file exists
+bool AudioThumbnailManager::openStoredPeaks(const juce::String& audioFilePath, Entry& entry) {
     juce::File audioFile(audioFilePath);
     if (!audioFile.existsAsFile()) {
         DBG("AudioThumbnailManager: File not found: " << audioFilePath);
-        return nullptr;
+        entry.failed = true;
+        return false;
     }
 
-    // Create new AudioThumbnail
-    // 512 samples per thumbnail point is a good balance for performance and quality
-    auto thumbnail =
-        std::make_unique<juce::AudioThumbnail>(512,              // samples per thumbnail point
-                                               formatManager_,   // format manager for reading files
-                                               *thumbnailCache_  // cache for storing thumbnail data
-        );
+    // Files built before the project was saved stay in the default directory
+    auto fileName = getPeakFileName(audioFile);
+    for (const auto& directory : {getPeakDirectory(), getDefaultPeakDirectory()}) {
+        auto peakFile = directory.getChildFile(fileName);
+        if (auto peaks = PeakFile::open(peakFile)) {
+            entry.peaks = std::move(peaks);
+            return true;
+        }
+    }
+    return false;
+}
 
-    // Load the audio file into the thumbnail
-    auto* reader = formatManager_.createReaderFor(audioFile);
-    if (reader == nullptr) {
-        DBG("AudioThumbnailManager: Could not create reader for: " << audioFilePath);
-        return nullptr;
+// ============================================================================
+// Building
+// ============================================================================
+
+void AudioThumbnailManager::startBuild(const juce::String& audioFilePath, Entry& entry) {
+    if (pool_ == nullptr) {
+        pool_ = std::make_unique<juce::ThreadPool>(
+            juce::jlimit(1, MAX_BUILD_THREADS, juce::SystemStats::getNumCpus() - 1));
+    }
+
+    auto cancelled = std::make_shared<std::atomic<bool>>(false);
+    entry.cancelled = cancelled;
+    auto peakFile = getPeakDirectory().getChildFile(getPeakFileName(juce::File(audioFilePath)));
+    auto validFlag = validFlag_;
+
+    pool_->addJob([this, audioFilePath, peakFile, cancelled, validFlag]() {
+        HighResTimer timer;
+
+        // Readers are created per job; the manager's format manager belongs to the UI
+        juce::AudioFormatManager formats;
+        formats.registerBasicFormats();
+        std::unique_ptr<juce::AudioFormatReader> reader(
+            formats.createReaderFor(juce::File(audioFilePath)));
+        bool built = reader != nullptr && PeakFile::build(*reader, peakFile, *cancelled);
+
+        if (built) {
+            PerformanceMonitor::getInstance().addSample("PeakBuild", timer.elapsedMilliseconds());
+        }
+
+        juce::MessageManager::callAsync([this, audioFilePath, peakFile, built, cancelled,
+                                         validFlag]() {
+            if (!validFlag->load() || cancelled->load()) {
+                return;
+            }
+            handleBuilt(audioFilePath, peakFile, built);
+        });
+    });
+}
+
+void AudioThumbnailManager::handleBuilt(const juce::String& audioFilePath,
+                                        const juce::File& peakFile, bool built) {
+    auto it = entries_.find(audioFilePath);
+    if (it == entries_.end()) {
+        return;
     }
 
-    // Set the reader with hash code for caching
-    // Thumbnail loads asynchronously - drawWaveform handles the not-yet-loaded case
-    thumbnail->setReader(reader, audioFile.hashCode64());
+    auto& entry = it->second;
+    entry.cancelled.reset();
+    entry.peaks = built ? PeakFile::open(peakFile) : nullptr;
+    if (entry.peaks == nullptr) {
+        DBG("AudioThumbnailManager: Could not build peaks for: " << audioFilePath);
+        entry.failed = true;
+        return;
+    }
+
+    DBG("AudioThumbnailManager: Built peaks for "
+        << audioFilePath << " (channels: " << entry.peaks->getNumChannels()
+        << ", length: " << entry.peaks->getLengthInSeconds() << "s)");
+
+    enforceMemoryBudget(entry);
+    sendChangeMessage();
+}
+
+void AudioThumbnailManager::cancelBuilds() {
+    for (auto& [path, entry] : entries_) {
+        if (entry.cancelled != nullptr) {
+            entry.cancelled->store(true);
+        }
+    }
+}
+
+// ============================================================================
+// Memory budget
+// ============================================================================
+
+void AudioThumbnailManager::setMemoryBudget(size_t bytes) {
+    memoryBudget_ = bytes;
+
+    // The most recently drawn file is always kept
+    const Entry* newest = nullptr;
+    for (const auto& [path, entry] : entries_) {
+        if (entry.peaks != nullptr && (newest == nullptr || entry.lastUsed > newest->lastUsed)) {
+            newest = &entry;
+        }
+    }
+    if (newest != nullptr) {
+        enforceMemoryBudget(*newest);
+    }
+}
 
-    // Store in cache
-    auto* thumbnailPtr = thumbnail.get();
-    thumbnails_[audioFilePath] = std::move(thumbnail);
+size_t AudioThumbnailManager::getMemoryUsage() const {
+    size_t bytes = 0;
+    for (const auto& [path, entry] : entries_) {
+        if (entry.peaks != nullptr) {
+            bytes += entry.peaks->getSizeInBytes();
+        }
+    }
+    return bytes;
+}
 
-    DBG("AudioThumbnailManager: Created thumbnail for "
-        << audioFilePath << " (channels: " << thumbnailPtr->getNumChannels()
-        << ", length: " << thumbnailPtr->getTotalLength() << "s)");
+void AudioThumbnailManager::enforceMemoryBudget(const Entry& keep) {
+    auto usage = getMemoryUsage();
+    while (usage > memoryBudget_) {
+        Entry* oldest = nullptr;
+        for (auto& [path, entry] : entries_) {
+            if (&entry != &keep && entry.peaks != nullptr &&
+                (oldest == nullptr || entry.lastUsed < oldest->lastUsed)) {
+                oldest = &entry;
+            }
+        }
+        if (oldest == nullptr) {
+            break;
+        }
 
-    return thumbnailPtr;
+        // Unmapped entries re-map from disk on their next draw
+        usage -= oldest->peaks->getSizeInBytes();
+        oldest->peaks.reset();
+        oldest->reader.reset();
+    }
 }
 
+// ============================================================================
+// Drawing
+// ============================================================================
+
 void AudioThumbnailManager::drawWaveform(juce::Graphics& g, const juce::Rectangle<int>& bounds,
                                          const juce::String& audioFilePath, double startTime,
                                          double endTime, const juce::Colour& colour,
@@ -72,35 +234,177 @@ void AudioThumbnailManager::drawWaveform(juce::Graphics& g, const juce::Rectangl
     if (bounds.getWidth() <= 0 || bounds.getHeight() <= 0)
         return;
 
-    auto* thumbnail = getThumbnail(audioFilePath);
-    if (thumbnail == nullptr || !thumbnail->isFullyLoaded()) {
-        // Draw placeholder if thumbnail not ready
+    auto peaks = getPeaks(audioFilePath);
+    if (peaks == nullptr) {
+        // Draw placeholder until the peaks are built
         g.setColour(colour.withAlpha(0.3f));
         g.drawText("Loading...", bounds, juce::Justification::centred);
         return;
     }
 
     // Clamp times to valid range
-    double totalLength = thumbnail->getTotalLength();
+    double totalLength = peaks->getLengthInSeconds();
     startTime = juce::jlimit(0.0, totalLength, startTime);
     endTime = juce::jlimit(startTime, totalLength, endTime);
+    if (endTime <= startTime)
+        return;
 
-    // Draw the waveform
-    g.setColour(colour);
+    double samplesPerPixel = (endTime - startTime) * peaks->getSampleRate() / bounds.getWidth();
+    if (peaks->chooseLevel(samplesPerPixel) >= 0) {
+        drawPeaks(g, bounds, *peaks, startTime, endTime, colour, verticalZoom);
+    } else {
+        drawFromSamples(g, bounds, entries_[audioFilePath], audioFilePath, startTime, endTime,
+                        colour, verticalZoom);
+    }
+}
+
+void AudioThumbnailManager::drawPeaks(juce::Graphics& g, const juce::Rectangle<int>& bounds,
+                                      const PeakFile& peaks, double startTime, double endTime,
+                                      const juce::Colour& colour, float verticalZoom) {
+    // Only columns inside the clip region are summarised
+    auto visible = g.getClipBounds().getIntersection(bounds);
+    if (visible.isEmpty())
+        return;
+
+    double samplesPerPixel = (endTime - startTime) * peaks.getSampleRate() / bounds.getWidth();
+    int level = juce::jmax(0, peaks.chooseLevel(samplesPerPixel));
+    double peaksPerPixel = samplesPerPixel / peaks.getSamplesPerPeak(level);
+    double firstPeakOfBounds =
+        startTime * peaks.getSampleRate() / peaks.getSamplesPerPeak(level);
+
+    int numChannels = peaks.getNumChannels();
+    float channelHeight = static_cast<float>(bounds.getHeight()) / numChannels;
+    float halfHeight = channelHeight * 0.5f * verticalZoom;
+
+    juce::RectangleList<float> peakRects;
+    juce::RectangleList<float> rmsRects;
+    for (int x = visible.getX(); x < visible.getRight(); ++x) {
+        double column = firstPeakOfBounds + (x - bounds.getX()) * peaksPerPixel;
+        auto firstPeak = static_cast<juce::int64>(std::floor(column));
+        auto endPeak = static_cast<juce::int64>(std::ceil(column + peaksPerPixel));
+        if (firstPeak < 0 || firstPeak >= peaks.getNumPeaks(level))
+            continue;  // Outside the file (e.g. the end of the last tile)
+
+        for (int channel = 0; channel < numChannels; ++channel) {
+            auto value = peaks.getPeak(level, channel, firstPeak, endPeak);
+            float centreY = bounds.getY() + channelHeight * (channel + 0.5f);
+            addColumn(peakRects, static_cast<float>(x), centreY, halfHeight, value.min,
+                      value.max);
+            addColumn(rmsRects, static_cast<float>(x), centreY, halfHeight, -value.rms,
+                      value.rms);
+        }
+    }
 
-    // Draw all channels (stereo files will show both channels mixed)
-    thumbnail->drawChannels(g, bounds, startTime, endTime, verticalZoom);
+    fillBands(g, peakRects, rmsRects, colour);
+}
+
+void AudioThumbnailManager::drawFromSamples(juce::Graphics& g, const juce::Rectangle<int>& bounds,
+                                            Entry& entry, const juce::String& audioFilePath,
+                                            double startTime, double endTime,
+                                            const juce::Colour& colour, float verticalZoom) {
+    auto visible = g.getClipBounds().getIntersection(bounds);
+    if (visible.isEmpty())
+        return;
+
+    if (entry.reader == nullptr) {
+        entry.reader.reset(formatManager_.createReaderFor(juce::File(audioFilePath)));
+        if (entry.reader == nullptr)
+            return;
+    }
+
+    // Finer than level 0, so the visible span is at most a few hundred thousand samples
+    auto& reader = *entry.reader;
+    double samplesPerPixel = (endTime - startTime) * reader.sampleRate / bounds.getWidth();
+    double startSample = startTime * reader.sampleRate;
+    double visibleStart = startSample + (visible.getX() - bounds.getX()) * samplesPerPixel;
+    auto firstSample = static_cast<juce::int64>(std::floor(visibleStart));
+    auto numSamples = static_cast<int>(
+        std::ceil(visibleStart + visible.getWidth() * samplesPerPixel) - firstSample + 1);
+    numSamples = static_cast<int>(
+        juce::jmin<juce::int64>(numSamples, reader.lengthInSamples - firstSample));
+    if (numSamples <= 0)
+        return;
+
+    int numChannels = static_cast<int>(reader.numChannels);
+    juce::AudioBuffer<float> samples(numChannels, numSamples);
+    if (!reader.read(&samples, 0, numSamples, firstSample, true, true))
+        return;
+
+    float channelHeight = static_cast<float>(bounds.getHeight()) / numChannels;
+    float halfHeight = channelHeight * 0.5f * verticalZoom;
+
+    juce::RectangleList<float> peakRects;
+    juce::RectangleList<float> rmsRects;
+    for (int x = visible.getX(); x < visible.getRight(); ++x) {
+        double column = startSample + (x - bounds.getX()) * samplesPerPixel - firstSample;
+        int first = juce::jlimit(0, numSamples - 1, static_cast<int>(std::floor(column)));
+        int end = juce::jlimit(first + 1, numSamples,
+                               static_cast<int>(std::ceil(column + samplesPerPixel)));
+
+        for (int channel = 0; channel < numChannels; ++channel) {
+            auto range = samples.findMinMax(channel, first, end - first);
+            float rms = samples.getRMSLevel(channel, first, end - first);
+            float centreY = bounds.getY() + channelHeight * (channel + 0.5f);
+            addColumn(peakRects, static_cast<float>(x), centreY, halfHeight, range.getStart(),
+                      range.getEnd());
+            addColumn(rmsRects, static_cast<float>(x), centreY, halfHeight, -rms, rms);
+        }
+    }
+
+    fillBands(g, peakRects, rmsRects, colour);
+}
+
+// ============================================================================
+// Peak storage
+// ============================================================================
+
+void AudioThumbnailManager::setPeakDirectory(const juce::File& directory) {
+    if (directory == peakDirectory_)
+        return;
+
+    // Entries opened from the old directory stay valid; failed lookups get another try
+    peakDirectory_ = directory;
+    for (auto& [path, entry] : entries_) {
+        entry.failed = false;
+    }
+}
+
+juce::File AudioThumbnailManager::getPeakDirectory() const {
+    return peakDirectory_ != juce::File() ? peakDirectory_ : getDefaultPeakDirectory();
+}
+
+juce::File AudioThumbnailManager::getDefaultPeakDirectory() {
+    return juce::File::getSpecialLocation(juce::File::userApplicationDataDirectory)
+        .getChildFile("MAGDA")
+        .getChildFile("Peaks");
+}
+
+juce::File AudioThumbnailManager::getProjectPeakDirectory(const juce::File& projectFile) {
+    return projectFile.getParentDirectory().getChildFile("Peaks");
+}
+
+juce::String AudioThumbnailManager::getPeakFileName(const juce::File& audioFile) {
+    auto key = audioFile.getFullPathName() + ":" + juce::String(audioFile.getSize()) + ":" +
+               juce::String(audioFile.getLastModificationTime().toMilliseconds());
+    return audioFile.getFileNameWithoutExtension() + "_" +
+           juce::String::toHexString(key.hashCode64()) + ".peaks";
 }
 
 void AudioThumbnailManager::clearCache() {
-    thumbnails_.clear();
-    thumbnailCache_->clear();
+    cancelBuilds();
+    entries_.clear();
     DBG("AudioThumbnailManager: Cache cleared");
 }
 
 void AudioThumbnailManager::shutdown() {
-    thumbnails_.clear();
-    thumbnailCache_.reset();
+    validFlag_->store(false);
+    cancelBuilds();
+    if (pool_ != nullptr) {
+        pool_->removeAllJobs(true, 5000);
+        pool_.reset();
+    }
+    entries_.clear();
+    validFlag_ = std::make_shared<std::atomic<bool>>(true);
 }
 
 }  // namespace magda
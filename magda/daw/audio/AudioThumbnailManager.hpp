@@ -1,31 +1,47 @@
 #pragma once
 
 #include <juce_audio_formats/juce_audio_formats.h>
-#include <juce_audio_utils/juce_audio_utils.h>
+#include <juce_events/juce_events.h>
 #include <juce_gui_basics/juce_gui_basics.h>
 
+#include <atomic>
 #include <map>
 #include <memory>
-#include <string>
+
+#include "PeakFile.hpp"
 
 namespace magda {
 
 /**
- * @brief Manages audio waveform thumbnails for visualization
+ * @brief Manages audio waveform peaks for visualization
+ *
+ * Each audio file gets a multi-resolution PeakFile, built once on a background thread
+ * pool and stored in the peak directory (the project's "Peaks" folder, or the user's
+ * application data when no project is saved). Reopening a project maps the stored
+ * files instead of reading the audio again.
  *
- * Provides caching and rendering of audio waveforms using JUCE's AudioThumbnail.
- * Thumbnails are cached by file path for efficient reuse across clips using the same audio file.
+ * Mapped peaks are kept under a memory budget; the least recently drawn files are
+ * unmapped first and re-mapped on demand. A change message is broadcast (on the
+ * message thread) whenever a file's peaks become ready, so views can repaint.
  */
-class AudioThumbnailManager {
+class AudioThumbnailManager : public juce::ChangeBroadcaster {
   public:
     static AudioThumbnailManager& getInstance();
 
     /**
-     * @brief Get or create a thumbnail for an audio file
+     * @brief Peaks for an audio file, building them in the background if needed
      * @param audioFilePath Absolute path to the audio file
-     * @return Pointer to the AudioThumbnail, or nullptr if file couldn't be loaded
+     * @return The peaks, or nullptr while they are being built (or the file is unreadable).
+     *         Holding the pointer keeps the file mapped even if the cache evicts it.
+     */
+    std::shared_ptr<const PeakFile> getPeaks(const juce::String& audioFilePath);
+
+    /**
+     * @brief Length of an audio file in seconds (0 if it can't be read)
+     *
+     * Uses the peaks when available, otherwise reads the file header.
      */
-    juce::AudioThumbnail* getThumbnail(const juce::String& audioFilePath);
+    double getFileDuration(const juce::String& audioFilePath);
 
     /**
      * @brief Draw the waveform for an audio file
@@ -41,7 +57,50 @@ class AudioThumbnailManager {
                       const juce::Colour& colour, float verticalZoom = 1.0f);
 
     /**
-     * @brief Clear the thumbnail cache (useful for freeing memory)
+     * @brief Draw min/max and RMS bands of [startTime, endTime) from a peak level
+     *
+     * Only columns inside the graphics clip region are drawn, and columns past the end of
+     * the file are skipped. Safe on any thread when drawing into a software image.
+     * The span must be coarse enough for level 0 (see PeakFile::chooseLevel).
+     */
+    static void drawPeaks(juce::Graphics& g, const juce::Rectangle<int>& bounds,
+                          const PeakFile& peaks, double startTime, double endTime,
+                          const juce::Colour& colour, float verticalZoom);
+
+    // ========================================================================
+    // Peak storage
+    // ========================================================================
+
+    /**
+     * @brief Directory new peak files are written to (and looked up in first)
+     *
+     * Pass an invalid File to fall back to the default directory.
+     */
+    void setPeakDirectory(const juce::File& directory);
+    juce::File getPeakDirectory() const;
+    static juce::File getDefaultPeakDirectory();
+
+    /**
+     * @brief Peak directory for a project: a "Peaks" folder beside the project file
+     */
+    static juce::File getProjectPeakDirectory(const juce::File& projectFile);
+
+    /**
+     * @brief Peak file name for an audio file, keyed by its path, size and modification time
+     */
+    static juce::String getPeakFileName(const juce::File& audioFile);
+
+    /**
+     * @brief Bytes of mapped peaks to keep before unmapping the least recently used
+     */
+    void setMemoryBudget(size_t bytes);
+    size_t getMemoryBudget() const {
+        return memoryBudget_;
+    }
+    size_t getMemoryUsage() const;
+
+    /**
+     * @brief Clear the in-memory cache (peak files on disk are kept)
      */
     void clearCache();
 
@@ -53,19 +112,42 @@ class AudioThumbnailManager {
 
   private:
     AudioThumbnailManager();
-    ~AudioThumbnailManager() = default;
+    ~AudioThumbnailManager() override;
+
+    struct Entry {
+        std::shared_ptr<PeakFile> peaks;
+        std::unique_ptr<juce::AudioFormatReader> reader;  // For zoom beyond level 0
+        // Non-null while a build is running
+        std::shared_ptr<std::atomic<bool>> cancelled;
+        bool failed = false;
+        juce::uint64 lastUsed = 0;
+    };
+
+    Entry& touch(const juce::String& audioFilePath);
+    bool openStoredPeaks(const juce::String& audioFilePath, Entry& entry);
+    void startBuild(const juce::String& audioFilePath, Entry& entry);
+    void handleBuilt(const juce::String& audioFilePath, const juce::File& peakFile, bool built);
+    void enforceMemoryBudget(const Entry& keep);
+    void cancelBuilds();
+
+    void drawFromSamples(juce::Graphics& g, const juce::Rectangle<int>& bounds, Entry& entry,
+                         const juce::String& audioFilePath, double startTime, double endTime,
+                         const juce::Colour& colour, float verticalZoom);
 
-    // Audio format manager for reading audio files
+    // Audio format manager for reading audio files (message thread)
     juce::AudioFormatManager formatManager_;
 
-    // Thumbnail cache (stores thumbnail data on disk)
-    std::unique_ptr<juce::AudioThumbnailCache> thumbnailCache_;
+    std::unique_ptr<juce::ThreadPool> pool_;
+    std::map<juce::String, Entry> entries_;
+    juce::File peakDirectory_;
+    size_t memoryBudget_ = DEFAULT_MEMORY_BUDGET;
+    juce::uint64 useCounter_ = 0;
 
-    // Map of file paths to thumbnails
-    std::map<juce::String, std::unique_ptr<juce::AudioThumbnail>> thumbnails_;
+    // Prevents callbacks after shutdown
+    std::shared_ptr<std::atomic<bool>> validFlag_ = std::make_shared<std::atomic<bool>>(true);
 
-    // Create a new thumbnail for a file
-    juce::AudioThumbnail* createThumbnail(const juce::String& audioFilePath);
+    static constexpr size_t DEFAULT_MEMORY_BUDGET = 256 * 1024 * 1024;
+    static constexpr int MAX_BUILD_THREADS = 2;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(AudioThumbnailManager)
 };
@@ -0,0 +1,417 @@
+#include "ClipLaunchEngine.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace magda {
+
+namespace {
+
+// Positions computed from a boundary can land a hair either side of it
+constexpr double kBeatEpsilon = 1.0e-9;
+constexpr double kSampleEpsilon = 1.0e-6;
+
+}  // namespace
+
+// ============================================================================
+// TempoMap
+// ============================================================================
+
+ClipLaunchEngine::TempoMap::TempoMap(double sampleRate, std::vector<TempoSegment> segments)
+    : sampleRate_(sampleRate) {
+    if (segments.empty()) {
+        segments.push_back({});
+    }
+    std::sort(segments.begin(), segments.end(), [](const TempoSegment& a, const TempoSegment& b) {
+        return a.startBeat < b.startBeat;
+    });
+    segments.front().startBeat = 0.0;
+
+    double startSample = 0.0;
+    for (size_t i = 0; i < segments.size(); ++i) {
+        Segment segment;
+        segment.startBeat = segments[i].startBeat;
+        segment.samplesPerBeat = sampleRate * 60.0 / std::max(1.0, segments[i].bpm);
+        segment.beatsPerBar = std::max(1, segments[i].beatsPerBar);
+
+        if (i > 0) {
+            const auto& previous = segments_.back();
+            startSample += (segment.startBeat - previous.startBeat) * previous.samplesPerBeat;
+        }
+        segment.startSample = startSample;
+        segments_.push_back(segment);
+    }
+}
+
+double ClipLaunchEngine::TempoMap::beatAtSample(double sample) const {
+    const auto& segment = segmentAtSample(sample);
+    return segment.startBeat + (sample - segment.startSample) / segment.samplesPerBeat;
+}
+
+double ClipLaunchEngine::TempoMap::sampleAtBeat(double beat) const {
+    const auto& segment = segmentAtBeat(beat);
+    return segment.startSample + (beat - segment.startBeat) * segment.samplesPerBeat;
+}
+
+double ClipLaunchEngine::TempoMap::getNextBoundary(double beat,
+                                                   LaunchQuantization quantization) const {
+    if (quantization == LaunchQuantization::None) {
+        return beat;
+    }
+
+    const auto& segment = segmentAtBeat(beat);
+    double unit = quantization == LaunchQuantization::Bar ? segment.beatsPerBar : 1.0;
+    double count = std::ceil((beat - segment.startBeat) / unit - kBeatEpsilon);
+    double boundary = segment.startBeat + count * unit;
+
+    // Every tempo or meter change starts a bar, which may come before the boundary
+    auto next = static_cast<size_t>(&segment - segments_.data()) + 1;
+    if (next < segments_.size()) {
+        boundary = std::min(boundary, segments_[next].startBeat);
+    }
+    return boundary;
+}
+
+bool ClipLaunchEngine::TempoMap::operator==(const TempoMap& other) const {
+    if (sampleRate_ != other.sampleRate_ || segments_.size() != other.segments_.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < segments_.size(); ++i) {
+        const auto& a = segments_[i];
+        const auto& b = other.segments_[i];
+        if (a.startBeat != b.startBeat || a.samplesPerBeat != b.samplesPerBeat ||
+            a.beatsPerBar != b.beatsPerBar) {
+            return false;
+        }
+    }
+    return true;
+}
+
+const ClipLaunchEngine::TempoMap::Segment& ClipLaunchEngine::TempoMap::segmentAtBeat(
+    double beat) const {
+    auto it = std::upper_bound(segments_.begin() + 1, segments_.end(), beat,
+                               [](double b, const Segment& s) { return b < s.startBeat; });
+    return *(it - 1);
+}
+
+const ClipLaunchEngine::TempoMap::Segment& ClipLaunchEngine::TempoMap::segmentAtSample(
+    double sample) const {
+    auto it = std::upper_bound(segments_.begin() + 1, segments_.end(), sample,
+                               [](double s, const Segment& seg) { return s < seg.startSample; });
+    return *(it - 1);
+}
+
+// ============================================================================
+// ClipLaunchEngine - Message thread
+// ============================================================================
+
+ClipLaunchEngine::ClipLaunchEngine() = default;
+
+ClipLaunchEngine::~ClipLaunchEngine() {
+    // The audio thread is gone by now; free every map still in flight
+    Command command;
+    while (commands_.pop(command)) {
+        delete command.tempoMap;
+    }
+    TempoMap* retired = nullptr;
+    while (retiredMaps_.pop(retired)) {
+        delete retired;
+    }
+    delete unretiredMap_;
+    delete tempoMap_;
+}
+
+bool ClipLaunchEngine::launch(ClipId clipId, TrackId trackId, LaunchQuantization quantization) {
+    Command command;
+    command.type = Command::Type::Launch;
+    command.clipId = clipId;
+    command.trackId = trackId;
+    command.quantization = quantization;
+    return commands_.push(command);
+}
+
+bool ClipLaunchEngine::stop(ClipId clipId, TrackId trackId, LaunchQuantization quantization) {
+    Command command;
+    command.type = Command::Type::Stop;
+    command.clipId = clipId;
+    command.trackId = trackId;
+    command.quantization = quantization;
+    return commands_.push(command);
+}
+
+bool ClipLaunchEngine::stopAll(LaunchQuantization quantization) {
+    Command command;
+    command.type = Command::Type::StopAll;
+    command.quantization = quantization;
+    return commands_.push(command);
+}
+
+bool ClipLaunchEngine::releaseTrack(TrackId trackId) {
+    Command command;
+    command.type = Command::Type::ReleaseTrack;
+    command.trackId = trackId;
+    return commands_.push(command);
+}
+
+bool ClipLaunchEngine::setTempoMap(std::unique_ptr<TempoMap> tempoMap) {
+    TempoMap* retired = nullptr;
+    while (retiredMaps_.pop(retired)) {
+        delete retired;
+    }
+
+    Command command;
+    command.type = Command::Type::SetTempoMap;
+    command.tempoMap = tempoMap.get();
+    if (!commands_.push(command)) {
+        return false;
+    }
+    tempoMap.release();
+    return true;
+}
+
+bool ClipLaunchEngine::locate(juce::int64 sample) {
+    Command command;
+    command.type = Command::Type::Locate;
+    command.sample = std::max<juce::int64>(0, sample);
+    return commands_.push(command);
+}
+
+bool ClipLaunchEngine::dispatchEvents(const std::function<void(const Event&)>& handler) {
+    TempoMap* retired = nullptr;
+    while (retiredMaps_.pop(retired)) {
+        delete retired;
+    }
+
+    Event event;
+    while (events_.pop(event)) {
+        handler(event);
+    }
+    return !eventsDropped_.exchange(false, std::memory_order_acq_rel);
+}
+
+// ============================================================================
+// ClipLaunchEngine - Audio thread
+// ============================================================================
+
+void ClipLaunchEngine::process(int numSamples, bool transportPlaying) {
+    // Requests made since the last block are scheduled from this block's start
+    Command command;
+    while (commands_.pop(command)) {
+        handleCommand(command);
+    }
+
+    if (unretiredMap_ != nullptr && retiredMaps_.push(unretiredMap_)) {
+        unretiredMap_ = nullptr;
+    }
+
+    if (numSamples <= 0) {
+        return;
+    }
+
+    if (!transportPlaying) {
+        // The clock stands still, so no boundary would ever come: take effect right here
+        for (auto& slot : tracks_) {
+            if (slot.pending.type != Pending::Type::None) {
+                slot.pending.sample = position_;
+                fire(slot);
+            }
+        }
+        return;
+    }
+
+    auto blockEnd = position_ + numSamples;
+    for (auto& slot : tracks_) {
+        if (slot.pending.type != Pending::Type::None && slot.pending.sample < blockEnd) {
+            fire(slot);
+        }
+    }
+    position_ = blockEnd;
+}
+
+ClipId ClipLaunchEngine::getPlayingClip(TrackId trackId, juce::int64* startSample) const {
+    const auto* slot = findSlot(trackId);
+    if (slot == nullptr) {
+        return INVALID_CLIP_ID;
+    }
+    if (startSample != nullptr) {
+        *startSample = slot->startSample;
+    }
+    return slot->playingClip;
+}
+
+void ClipLaunchEngine::handleCommand(const Command& command) {
+    switch (command.type) {
+        case Command::Type::Launch:
+            if (auto* slot = findSlot(command.trackId, true)) {
+                schedule(*slot, Pending::Type::Launch, command.clipId, command.quantization);
+            } else {
+                // Out of track slots: refuse rather than leave the clip looking queued
+                report(Event::Type::Cancelled, command.clipId, command.trackId, position_);
+            }
+            break;
+
+        case Command::Type::Stop:
+            if (auto* slot = findSlot(command.trackId, false)) {
+                if (slot->pending.type == Pending::Type::Launch &&
+                    slot->pending.clipId == command.clipId) {
+                    cancelPending(*slot);
+                }
+                if (slot->playingClip == command.clipId) {
+                    schedule(*slot, Pending::Type::Stop, command.clipId, command.quantization);
+                }
+            }
+            break;
+
+        case Command::Type::StopAll:
+            for (auto& slot : tracks_) {
+                if (slot.trackId == INVALID_TRACK_ID) {
+                    continue;
+                }
+                cancelPending(slot);
+                if (slot.playingClip != INVALID_CLIP_ID) {
+                    schedule(slot, Pending::Type::Stop, slot.playingClip, command.quantization);
+                }
+            }
+            break;
+
+        case Command::Type::ReleaseTrack:
+            if (auto* slot = findSlot(command.trackId, false)) {
+                cancelPending(*slot);
+                if (slot->playingClip != INVALID_CLIP_ID) {
+                    report(Event::Type::Stopped, slot->playingClip, slot->trackId, position_);
+                }
+                *slot = {};
+            }
+            break;
+
+        case Command::Type::SetTempoMap:
+            retire(tempoMap_);
+            tempoMap_ = command.tempoMap;
+            break;
+
+        case Command::Type::Locate:
+            position_ = command.sample;
+            break;
+    }
+
+    // Waiting launches keep their quantization but not their old position
+    if (command.type == Command::Type::SetTempoMap || command.type == Command::Type::Locate) {
+        for (auto& slot : tracks_) {
+            if (slot.pending.type != Pending::Type::None) {
+                slot.pending.sample = getBoundarySample(slot.pending.quantization);
+            }
+        }
+    }
+}
+
+void ClipLaunchEngine::schedule(TrackSlot& slot, Pending::Type type, ClipId clipId,
+                                LaunchQuantization quantization) {
+    // Re-launching the clip already waiting just moves it; anything else replaces it
+    bool sameLaunch = slot.pending.type == Pending::Type::Launch && type == Pending::Type::Launch &&
+                      slot.pending.clipId == clipId;
+    if (!sameLaunch) {
+        cancelPending(slot);
+    }
+
+    slot.pending.type = type;
+    slot.pending.clipId = clipId;
+    slot.pending.quantization = quantization;
+    slot.pending.sample = getBoundarySample(quantization);
+}
+
+juce::int64 ClipLaunchEngine::getBoundarySample(LaunchQuantization quantization) const {
+    if (tempoMap_ == nullptr || quantization == LaunchQuantization::None) {
+        return position_;
+    }
+
+    double beat = tempoMap_->beatAtSample(static_cast<double>(position_));
+    double boundary = tempoMap_->getNextBoundary(beat, quantization);
+    auto sample =
+        static_cast<juce::int64>(std::ceil(tempoMap_->sampleAtBeat(boundary) - kSampleEpsilon));
+    return std::max(sample, position_);
+}
+
+void ClipLaunchEngine::fire(TrackSlot& slot) {
+    auto pending = slot.pending;
+    slot.pending = {};
+    auto sample = std::max(pending.sample, position_);
+
+    if (pending.type == Pending::Type::Launch) {
+        if (slot.playingClip != INVALID_CLIP_ID && slot.playingClip != pending.clipId) {
+            report(Event::Type::Stopped, slot.playingClip, slot.trackId, sample);
+        }
+        slot.playingClip = pending.clipId;
+        slot.startSample = sample;
+        report(Event::Type::Started, pending.clipId, slot.trackId, sample);
+    } else if (pending.type == Pending::Type::Stop && slot.playingClip == pending.clipId) {
+        slot.playingClip = INVALID_CLIP_ID;
+        report(Event::Type::Stopped, pending.clipId, slot.trackId, sample);
+    }
+}
+
+void ClipLaunchEngine::cancelPending(TrackSlot& slot) {
+    if (slot.pending.type == Pending::Type::Launch) {
+        report(Event::Type::Cancelled, slot.pending.clipId, slot.trackId, position_);
+    }
+    slot.pending = {};
+}
+
+void ClipLaunchEngine::report(Event::Type type, ClipId clipId, TrackId trackId,
+                              juce::int64 sample) {
+    Event event;
+    event.type = type;
+    event.clipId = clipId;
+    event.trackId = trackId;
+    event.sample = sample;
+    event.beat = tempoMap_ != nullptr ? tempoMap_->beatAtSample(static_cast<double>(sample)) : 0.0;
+
+    // The message thread drains events many times a second; if it has stalled long enough
+    // to fill the queue, dropping the report is better than blocking the audio thread.
+    // dispatchEvents() owns up to the loss so the message thread can resync
+    if (!events_.push(event)) {
+        eventsDropped_.store(true, std::memory_order_release);
+    }
+}
+
+void ClipLaunchEngine::retire(TempoMap* tempoMap) {
+    if (tempoMap == nullptr) {
+        return;
+    }
+    if (retiredMaps_.push(tempoMap)) {
+        return;
+    }
+
+    // setTempoMap() empties the queue before sending each map, so this only happens if
+    // maps arrive faster than they can be handed back; retry next block
+    jassert(unretiredMap_ == nullptr);
+    unretiredMap_ = tempoMap;
+}
+
+ClipLaunchEngine::TrackSlot* ClipLaunchEngine::findSlot(TrackId trackId, bool create) {
+    TrackSlot* freeSlot = nullptr;
+    for (auto& slot : tracks_) {
+        if (slot.trackId == trackId) {
+            return &slot;
+        }
+        if (freeSlot == nullptr && slot.trackId == INVALID_TRACK_ID) {
+            freeSlot = &slot;
+        }
+    }
+
+    if (!create || freeSlot == nullptr) {
+        return nullptr;
+    }
+    freeSlot->trackId = trackId;
+    return freeSlot;
+}
+
+const ClipLaunchEngine::TrackSlot* ClipLaunchEngine::findSlot(TrackId trackId) const {
+    for (const auto& slot : tracks_) {
+        if (slot.trackId == trackId) {
+            return &slot;
+        }
+    }
+    return nullptr;
+}
+
+}  // namespace magda
@@ -0,0 +1,222 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+
+#include <array>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "../core/ClipTypes.hpp"
+#include "../core/TypeIds.hpp"
+#include "ParameterQueue.hpp"
+
+namespace magda {
+
+/**
+ * @brief Sample-accurate scheduler for session clip launches
+ *
+ * The message thread queues launch and stop requests; the audio thread picks them up at
+ * the start of its next block, works out the sample they take effect at (the next beat
+ * or bar line from the tempo map, or straight away) and fires them when a block reaches
+ * that sample. Every launch or stop that fires is reported back with the exact sample
+ * and beat it happened at.
+ *
+ * Positions are transport samples: the launch clock advances only while the transport
+ * plays, and locate() moves it when the transport starts or jumps. Because boundaries are
+ * computed in samples rather than rounded to blocks, launches land on the same sample at
+ * any buffer size. With the transport stopped there is nothing to wait for, so requests
+ * take effect at the current position in the next block.
+ *
+ * One clip plays per track. Launching a clip stops the one playing on its track at the
+ * same sample, and replaces any launch still waiting on that track.
+ *
+ * All communication goes through lock-free queues; the audio thread never locks or
+ * allocates. Tempo maps are created and destroyed on the message thread.
+ */
+class ClipLaunchEngine {
+  public:
+    static constexpr int kMaxTracks = 128;
+
+    /**
+     * @brief A stretch of constant tempo and meter, starting on a bar line
+     */
+    struct TempoSegment {
+        double startBeat = 0.0;
+        double bpm = 120.0;
+        int beatsPerBar = 4;
+    };
+
+    /**
+     * @brief Immutable beat <-> sample mapping used to find launch boundaries
+     */
+    class TempoMap {
+      public:
+        /**
+         * @param segments Tempo changes in any order; the first is moved to beat 0
+         *        (an empty list means 120 BPM, 4/4)
+         */
+        TempoMap(double sampleRate, std::vector<TempoSegment> segments);
+
+        double getSampleRate() const {
+            return sampleRate_;
+        }
+
+        double beatAtSample(double sample) const;
+        double sampleAtBeat(double beat) const;
+
+        /**
+         * @brief First beat or bar line at or after the given beat (beat itself for None)
+         */
+        double getNextBoundary(double beat, LaunchQuantization quantization) const;
+
+        bool operator==(const TempoMap& other) const;
+
+      private:
+        struct Segment {
+            double startBeat = 0.0;
+            double startSample = 0.0;
+            double samplesPerBeat = 0.0;
+            int beatsPerBar = 4;
+        };
+
+        double sampleRate_;
+        std::vector<Segment> segments_;
+
+        const Segment& segmentAtBeat(double beat) const;
+        const Segment& segmentAtSample(double sample) const;
+    };
+
+    /**
+     * @brief A launch or stop that took effect (or was dropped), as reported back
+     */
+    struct Event {
+        enum class Type {
+            Started,   // Clip began playing at sample
+            Stopped,   // Clip stopped playing at sample
+            Cancelled  // A queued launch was replaced or stopped before it started
+        };
+
+        Type type = Type::Started;
+        ClipId clipId = INVALID_CLIP_ID;
+        TrackId trackId = INVALID_TRACK_ID;
+        juce::int64 sample = 0;
+        double beat = 0.0;
+    };
+
+    ClipLaunchEngine();
+    ~ClipLaunchEngine();
+
+    // =========================================================================
+    // Message thread
+    // =========================================================================
+
+    /**
+     * @brief Queue a clip launch. Returns false if the request queue is full.
+     */
+    bool launch(ClipId clipId, TrackId trackId, LaunchQuantization quantization);
+
+    /**
+     * @brief Queue a stop for a clip (playing or waiting to launch)
+     */
+    bool stop(ClipId clipId, TrackId trackId, LaunchQuantization quantization);
+
+    bool stopAll(LaunchQuantization quantization);
+
+    /**
+     * @brief Free a deleted track's slot, cancelling whatever was waiting on it
+     */
+    bool releaseTrack(TrackId trackId);
+
+    /**
+     * @brief Replace the tempo map. Until one is set, launches take effect immediately.
+     */
+    bool setTempoMap(std::unique_ptr<TempoMap> tempoMap);
+
+    /**
+     * @brief Move the launch clock (transport started or jumped); waiting launches are
+     *        rescheduled from the new position
+     */
+    bool locate(juce::int64 sample);
+
+    /**
+     * @brief Deliver the events reported since the last call, oldest first
+     * @return false if reports were dropped because the event queue was full; the caller
+     *         no longer knows what is playing and should stop everything
+     */
+    bool dispatchEvents(const std::function<void(const Event&)>& handler);
+
+    // =========================================================================
+    // Audio thread
+    // =========================================================================
+
+    /**
+     * @brief Advance by one audio block, firing every launch and stop that falls in it
+     */
+    void process(int numSamples, bool transportPlaying);
+
+    /**
+     * @brief Clip playing on a track and the sample it started at
+     */
+    ClipId getPlayingClip(TrackId trackId, juce::int64* startSample = nullptr) const;
+
+    juce::int64 getPosition() const {
+        return position_;
+    }
+
+  private:
+    struct Command {
+        enum class Type { Launch, Stop, StopAll, ReleaseTrack, SetTempoMap, Locate };
+
+        Type type = Type::Launch;
+        ClipId clipId = INVALID_CLIP_ID;
+        TrackId trackId = INVALID_TRACK_ID;
+        LaunchQuantization quantization = LaunchQuantization::Bar;
+        juce::int64 sample = 0;
+        TempoMap* tempoMap = nullptr;  // Ownership travels with the command
+    };
+
+    struct Pending {
+        enum class Type { None, Launch, Stop };
+
+        Type type = Type::None;
+        ClipId clipId = INVALID_CLIP_ID;
+        LaunchQuantization quantization = LaunchQuantization::Bar;
+        juce::int64 sample = 0;
+    };
+
+    struct TrackSlot {
+        TrackId trackId = INVALID_TRACK_ID;
+        ClipId playingClip = INVALID_CLIP_ID;
+        juce::int64 startSample = 0;
+        Pending pending;
+    };
+
+    LockFreeQueue<Command, 256> commands_;
+    LockFreeQueue<Event, 512> events_;
+    LockFreeQueue<TempoMap*, 16> retiredMaps_;  // Audio -> message thread, for deletion
+    std::atomic<bool> eventsDropped_{false};
+
+    // Audio thread state
+    TempoMap* tempoMap_ = nullptr;
+    TempoMap* unretiredMap_ = nullptr;  // Waiting for room in retiredMaps_
+    juce::int64 position_ = 0;
+    std::array<TrackSlot, kMaxTracks> tracks_;
+
+    void handleCommand(const Command& command);
+    void schedule(TrackSlot& slot, Pending::Type type, ClipId clipId,
+                  LaunchQuantization quantization);
+    juce::int64 getBoundarySample(LaunchQuantization quantization) const;
+    void fire(TrackSlot& slot);
+    void cancelPending(TrackSlot& slot);
+    void report(Event::Type type, ClipId clipId, TrackId trackId, juce::int64 sample);
+    void retire(TempoMap* tempoMap);
+
+    TrackSlot* findSlot(TrackId trackId, bool create);
+    const TrackSlot* findSlot(TrackId trackId) const;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ClipLaunchEngine)
+};
+
+}  // namespace magda
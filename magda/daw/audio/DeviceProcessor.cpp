@@ -4,6 +4,7 @@
 #include <utility>
 
 #include "../core/TrackManager.hpp"
+#include "ParameterDescriptorCache.hpp"
 
 namespace magda {
 
@@ -73,13 +74,10 @@ void DeviceProcessor::syncFromDeviceInfo(const DeviceInfo& info) {
 
     // Sync parameter values (ParameterInfo stores actual values in real units)
     auto names = getParameterNames();
-    for (size_t i = 0; i < info.parameters.size(); ++i) {
-        const auto& param = info.parameters[i];
-        if (i < names.size()) {
-            DBG("  Syncing param " << i << " (" << names[i] << ") = " << param.currentValue << " "
-                                   << param.unit);
-            setParameter(names[i], param.currentValue);
-        }
+    for (size_t i = 0; i < info.parameters.size() && i < names.size(); ++i) {
+        float value = info.parameters.getCurrentValue(i);
+        DBG("  Syncing param " << i << " (" << names[i] << ") = " << value);
+        setParameter(names[i], value);
     }
 }
 
@@ -369,17 +367,43 @@ te::ExternalPlugin* ExternalPluginProcessor::getExternalPlugin() const {
     return dynamic_cast<te::ExternalPlugin*>(plugin_.get());
 }
 
+std::shared_ptr<const ParameterList::DescriptorTable> ExternalPluginProcessor::getDescriptors()
+    const {
+    auto* ext = getExternalPlugin();
+    if (!ext)
+        return nullptr;
+
+    auto params = ext->getAutomatableParameters();
+    const auto numParams = static_cast<size_t>(params.size());
+    if (descriptors_ && descriptors_->size() == numParams)
+        return descriptors_;
+
+    auto& cache = ParameterDescriptorCache::getInstance();
+    auto key = ParameterDescriptorCache::makeKey(ext->desc);
+
+    descriptors_ = cache.find(key, numParams);
+    if (!descriptors_) {
+        // First load of this plugin version - enumerate once and persist
+        ParameterList::DescriptorTable table;
+        table.reserve(numParams);
+        for (size_t i = 0; i < numParams; ++i) {
+            table.push_back(describeParameter(static_cast<int>(i), params[i]));
+        }
+        descriptors_ = cache.store(key, std::move(table));
+    }
+
+    return descriptors_;
+}
+
 void ExternalPluginProcessor::cacheParameterNames() const {
     if (parametersCached_)
         return;
 
     parameterNames_.clear();
-    if (auto* ext = getExternalPlugin()) {
-        auto params = ext->getAutomatableParameters();
-        for (auto* param : params) {
-            if (param) {
-                parameterNames_.push_back(param->getParameterName());
-            }
+    if (auto descriptors = getDescriptors()) {
+        parameterNames_.reserve(descriptors->size());
+        for (const auto& descriptor : *descriptors) {
+            parameterNames_.push_back(descriptor.name);
         }
     }
     parametersCached_ = true;
@@ -421,38 +445,46 @@ int ExternalPluginProcessor::getParameterCount() const {
 }
 
 ParameterInfo ExternalPluginProcessor::getParameterInfo(int index) const {
-    ParameterInfo info;
-    info.paramIndex = index;
-
     if (auto* ext = getExternalPlugin()) {
         auto params = ext->getAutomatableParameters();
         if (index >= 0 && index < static_cast<int>(params.size())) {
-            auto* param = params[static_cast<size_t>(index)];
-            if (param) {
-                info.name = param->getParameterName();
-                info.unit = param->getLabel();
-
-                // Get range from parameter
-                auto range = param->getValueRange();
-                info.minValue = range.getStart();
-                info.maxValue = range.getEnd();
-
-                // getDefaultValue returns optional<float>
-                auto defaultVal = param->getDefaultValue();
-                info.defaultValue = defaultVal.has_value() ? *defaultVal : info.minValue;
-                info.currentValue = param->getCurrentValue();
-
-                // Determine scale type
-                // Default to linear scale (could be enhanced to detect logarithmic ranges)
-                info.scale = ParameterScale::Linear;
-
-                // Check if parameter has discrete states
-                int numStates = param->getNumberOfStates();
-                if (numStates > 0 && numStates <= 10) {
-                    info.scale = ParameterScale::Discrete;
-                    // Could populate choices from parameter if available
-                }
-            }
+            return describeParameter(index, params[static_cast<size_t>(index)]);
+        }
+    }
+
+    ParameterInfo info;
+    info.paramIndex = index;
+    return info;
+}
+
+ParameterInfo ExternalPluginProcessor::describeParameter(int index,
+                                                         te::AutomatableParameter* param) {
+    ParameterInfo info;
+    info.paramIndex = index;
+
+    if (param) {
+        info.name = param->getParameterName();
+        info.unit = param->getLabel();
+
+        // Get range from parameter
+        auto range = param->getValueRange();
+        info.minValue = range.getStart();
+        info.maxValue = range.getEnd();
+
+        // getDefaultValue returns optional<float>
+        auto defaultVal = param->getDefaultValue();
+        info.defaultValue = defaultVal.has_value() ? *defaultVal : info.minValue;
+        info.currentValue = param->getCurrentValue();
+
+        // Determine scale type
+        // Default to linear scale (could be enhanced to detect logarithmic ranges)
+        info.scale = ParameterScale::Linear;
+
+        // Check if parameter has discrete states
+        int numStates = param->getNumberOfStates();
+        if (numStates > 0 && numStates <= 10) {
+            info.scale = ParameterScale::Discrete;
+            // Could populate choices from parameter if available
         }
     }
 
@@ -462,15 +494,21 @@ ParameterInfo ExternalPluginProcessor::getParameterInfo(int index) const {
 void ExternalPluginProcessor::populateParameters(DeviceInfo& info) const {
     info.parameters.clear();
 
-    if (auto* ext = getExternalPlugin()) {
-        auto params = ext->getAutomatableParameters();
-        // Load all parameters - UI uses user-selectable visibility and pagination
-        int maxParams = static_cast<int>(params.size());
+    auto* ext = getExternalPlugin();
+    auto descriptors = getDescriptors();
+    if (!ext || !descriptors)
+        return;
 
-        for (int i = 0; i < maxParams; ++i) {
-            info.parameters.push_back(getParameterInfo(i));
-        }
+    // Only current values are read per device - metadata is shared and pages of
+    // ParameterInfo are materialised when the UI shows them
+    auto params = ext->getAutomatableParameters();
+    std::vector<float> values;
+    values.reserve(static_cast<size_t>(params.size()));
+    for (auto* param : params) {
+        values.push_back(param ? param->getCurrentValue() : 0.0f);
     }
+
+    info.parameters = ParameterList(std::move(descriptors), std::move(values));
 }
 
 void ExternalPluginProcessor::syncFromDeviceInfo(const DeviceInfo& info) {
@@ -486,7 +524,8 @@ void ExternalPluginProcessor::syncFromDeviceInfo(const DeviceInfo& info) {
         for (size_t i = 0; i < info.parameters.size() && i < static_cast<size_t>(params.size());
              ++i) {
             if (params[i]) {
-                params[i]->setParameter(info.parameters[i].currentValue,
+                // getCurrentValue() avoids materialising every parameter page
+                params[i]->setParameter(info.parameters.getCurrentValue(i),
                                         juce::dontSendNotification);
             }
         }
@@ -584,28 +623,10 @@ void ExternalPluginProcessor::parameterChanged(te::AutomatableParameter& param,
         // Find this device in TrackManager and update its parameter
         // Use a special method that doesn't trigger AudioBridge notification
         auto& tm = TrackManager::getInstance();
-
-        // Search through all tracks to find this device
-        for (const auto& track : tm.getTracks()) {
-            for (const auto& element : track.chainElements) {
-                if (std::holds_alternative<DeviceInfo>(element)) {
-                    const auto& device = std::get<DeviceInfo>(element);
-                    if (device.id == deviceId_) {
-                        // Build a path to this device
-                        ChainNodePath path;
-                        path.trackId = track.id;
-                        path.topLevelDeviceId = deviceId_;
-                        // Note: For top-level devices, no steps needed
-
-                        // Update parameter without triggering audio bridge notification
-                        tm.setDeviceParameterValueFromPlugin(path, parameterIndex, newValue);
-                        return;
-                    }
-                }
-            }
-
-            // Also search in racks/chains (nested devices)
-            // TODO: Implement nested device search if needed
+        auto path = tm.getDevicePath(deviceId_);
+        if (path.isValid()) {
+            // Update parameter without triggering audio bridge notification
+            tm.setDeviceParameterValueFromPlugin(path, parameterIndex, newValue);
         }
     });
 }
@@ -212,7 +212,9 @@ class VolumeProcessor : public DeviceProcessor {
  * @brief Processor for external VST3/AU plugins
  *
  * Maps plugin parameters to DeviceInfo.parameters and handles
- * bidirectional sync between the UI and the plugin.
+ * bidirectional sync between the UI and the plugin. Parameter metadata comes from
+ * ParameterDescriptorCache, so it is only enumerated the first time a plugin version
+ * is loaded.
  *
  * Also listens for parameter changes from the plugin's native UI
  * and propagates them to TrackManager.
@@ -264,6 +266,12 @@ class ExternalPluginProcessor : public DeviceProcessor, public te::AutomatablePa
   private:
     te::ExternalPlugin* getExternalPlugin() const;
 
+    static ParameterInfo describeParameter(int index, te::AutomatableParameter* param);
+
+    // Shared descriptor table for this plugin (from ParameterDescriptorCache)
+    std::shared_ptr<const ParameterList::DescriptorTable> getDescriptors() const;
+    mutable std::shared_ptr<const ParameterList::DescriptorTable> descriptors_;
+
     // Cache parameter names for fast lookup
     mutable std::vector<juce::String> parameterNames_;
     mutable bool parametersCached_ = false;
@@ -0,0 +1,143 @@
+#include "ParameterDescriptorCache.hpp"
+
+#include <iostream>
+
+namespace magda {
+
+ParameterDescriptorCache& ParameterDescriptorCache::getInstance() {
+    static ParameterDescriptorCache instance;
+    return instance;
+}
+
+ParameterDescriptorCache::ParameterDescriptorCache()
+    : directory_(juce::File::getSpecialLocation(juce::File::userApplicationDataDirectory)
+                     .getChildFile("MAGDA")
+                     .getChildFile("ParameterCache")) {}
+
+juce::String ParameterDescriptorCache::makeKey(const juce::PluginDescription& description) {
+    return description.createIdentifierString() + ":" + description.version;
+}
+
+std::shared_ptr<const ParameterDescriptorCache::DescriptorTable> ParameterDescriptorCache::find(
+    const juce::String& key, size_t expectedCount) {
+    const juce::ScopedLock sl(lock_);
+
+    auto it = tables_.find(key);
+    if (it == tables_.end()) {
+        auto file = getFileForKey(key);
+        if (!file.existsAsFile()) {
+            return nullptr;
+        }
+
+        auto xml = juce::XmlDocument::parse(file);
+        auto table = xml ? fromXml(*xml, key) : nullptr;
+        if (!table) {
+            return nullptr;
+        }
+        it = tables_.emplace(key, std::move(table)).first;
+    }
+
+    if (it->second->size() != expectedCount) {
+        return nullptr;  // Plugin's parameter layout changed
+    }
+    return it->second;
+}
+
+std::shared_ptr<const ParameterDescriptorCache::DescriptorTable> ParameterDescriptorCache::store(
+    const juce::String& key, DescriptorTable descriptors) {
+    auto table = std::make_shared<const DescriptorTable>(std::move(descriptors));
+
+    const juce::ScopedLock sl(lock_);
+    tables_[key] = table;
+
+    auto file = getFileForKey(key);
+    (void)file.getParentDirectory().createDirectory();
+    if (!toXml(key, *table)->writeTo(file)) {
+        std::cerr << "Failed to write parameter cache: " << file.getFullPathName() << std::endl;
+    }
+
+    return table;
+}
+
+void ParameterDescriptorCache::clear() {
+    const juce::ScopedLock sl(lock_);
+    tables_.clear();
+    (void)directory_.deleteRecursively();
+}
+
+void ParameterDescriptorCache::setDirectory(const juce::File& directory) {
+    const juce::ScopedLock sl(lock_);
+    directory_ = directory;
+    tables_.clear();
+}
+
+juce::File ParameterDescriptorCache::getDirectory() const {
+    const juce::ScopedLock sl(lock_);
+    return directory_;
+}
+
+juce::File ParameterDescriptorCache::getFileForKey(const juce::String& key) const {
+    return directory_.getChildFile(juce::String::toHexString(key.hashCode64()) + ".xml");
+}
+
+std::unique_ptr<juce::XmlElement> ParameterDescriptorCache::toXml(
+    const juce::String& key, const DescriptorTable& descriptors) {
+    auto root = std::make_unique<juce::XmlElement>("PARAMETER_CACHE");
+    root->setAttribute("version", FORMAT_VERSION);
+    root->setAttribute("key", key);
+
+    for (const auto& param : descriptors) {
+        auto* p = root->createNewChildElement("PARAM");
+        p->setAttribute("name", param.name);
+        p->setAttribute("unit", param.unit);
+        p->setAttribute("min", param.minValue);
+        p->setAttribute("max", param.maxValue);
+        p->setAttribute("default", param.defaultValue);
+        p->setAttribute("scale", static_cast<int>(param.scale));
+        p->setAttribute("skew", param.skewFactor);
+        p->setAttribute("modulatable", param.modulatable);
+        p->setAttribute("bipolar", param.bipolarModulation);
+
+        for (const auto& choice : param.choices) {
+            p->createNewChildElement("CHOICE")->setAttribute("name", choice);
+        }
+    }
+
+    return root;
+}
+
+std::shared_ptr<const ParameterDescriptorCache::DescriptorTable> ParameterDescriptorCache::fromXml(
+    const juce::XmlElement& xml, const juce::String& key) {
+    // The file name is a hash, so check the full key to rule out collisions
+    if (!xml.hasTagName("PARAMETER_CACHE") || xml.getIntAttribute("version") != FORMAT_VERSION ||
+        xml.getStringAttribute("key") != key) {
+        return nullptr;
+    }
+
+    DescriptorTable table;
+    table.reserve(static_cast<size_t>(xml.getNumChildElements()));
+
+    for (auto* p : xml.getChildWithTagNameIterator("PARAM")) {
+        ParameterInfo param;
+        param.paramIndex = static_cast<int>(table.size());
+        param.name = p->getStringAttribute("name");
+        param.unit = p->getStringAttribute("unit");
+        param.minValue = static_cast<float>(p->getDoubleAttribute("min", 0.0));
+        param.maxValue = static_cast<float>(p->getDoubleAttribute("max", 1.0));
+        param.defaultValue = static_cast<float>(p->getDoubleAttribute("default", 0.0));
+        param.scale = static_cast<ParameterScale>(p->getIntAttribute("scale", 0));
+        param.skewFactor = static_cast<float>(p->getDoubleAttribute("skew", 1.0));
+        param.modulatable = p->getBoolAttribute("modulatable", true);
+        param.bipolarModulation = p->getBoolAttribute("bipolar", true);
+
+        for (auto* choice : p->getChildWithTagNameIterator("CHOICE")) {
+            param.choices.push_back(choice->getStringAttribute("name"));
+        }
+
+        table.push_back(std::move(param));
+    }
+
+    return std::make_shared<const DescriptorTable>(std::move(table));
+}
+
+}  // namespace magda
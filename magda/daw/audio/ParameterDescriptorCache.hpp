@@ -0,0 +1,77 @@
+#pragma once
+
+#include <juce_audio_processors/juce_audio_processors.h>
+#include <juce_core/juce_core.h>
+
+#include <memory>
+#include <unordered_map>
+
+#include "../core/ParameterList.hpp"
+
+namespace magda {
+
+/**
+ * @brief Persistent cache of plugin parameter descriptors
+ *
+ * Enumerating names, labels and ranges of every parameter is slow for plugins with
+ * thousands of parameters. Descriptor tables are built once per plugin version, shared
+ * in memory by every instance of that plugin, and written to disk so later sessions
+ * skip the enumeration entirely.
+ *
+ * Keyed by plugin identifier + version; a table whose parameter count no longer
+ * matches the plugin is treated as stale.
+ */
+class ParameterDescriptorCache {
+  public:
+    using DescriptorTable = ParameterList::DescriptorTable;
+
+    static ParameterDescriptorCache& getInstance();
+
+    /**
+     * @brief Cache key for a plugin (identifier string + version)
+     */
+    static juce::String makeKey(const juce::PluginDescription& description);
+
+    /**
+     * @brief Look up descriptors in memory, then on disk
+     * @param expectedCount The plugin's current parameter count
+     * @return The shared table, or nullptr if missing or stale
+     */
+    std::shared_ptr<const DescriptorTable> find(const juce::String& key, size_t expectedCount);
+
+    /**
+     * @brief Store a freshly built table (kept in memory and written to disk)
+     * @return The shared table to hand to ParameterList
+     */
+    std::shared_ptr<const DescriptorTable> store(const juce::String& key,
+                                                 DescriptorTable descriptors);
+
+    /**
+     * @brief Drop all cached descriptors from memory and disk
+     */
+    void clear();
+
+    void setDirectory(const juce::File& directory);
+    juce::File getDirectory() const;
+
+    // Serialization (one file per plugin)
+    static std::unique_ptr<juce::XmlElement> toXml(const juce::String& key,
+                                                   const DescriptorTable& descriptors);
+    static std::shared_ptr<const DescriptorTable> fromXml(const juce::XmlElement& xml,
+                                                          const juce::String& key);
+
+  private:
+    ParameterDescriptorCache();
+
+    juce::File getFileForKey(const juce::String& key) const;
+
+    std::unordered_map<juce::String, std::shared_ptr<const DescriptorTable>> tables_;
+    juce::File directory_;
+    mutable juce::CriticalSection lock_;
+
+    static constexpr int FORMAT_VERSION = 1;
+
+    JUCE_DECLARE_NON_COPYABLE(ParameterDescriptorCache)
+};
+
+}  // namespace magda
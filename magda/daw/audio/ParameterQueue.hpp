@@ -28,26 +28,29 @@ struct ParameterChange {
 };
 
 /**
- * @brief Lock-free SPSC queue for UI-to-audio parameter changes
+ * @brief Lock-free SPSC ring buffer
  *
- * UI thread pushes parameter changes, audio thread pops and applies them.
+ * One thread pushes, one other thread pops; neither ever blocks or allocates.
  * Uses a fixed-size ring buffer for predictable memory behavior.
  */
-class ParameterQueue {
+template <typename T, int QueueSize>
+class LockFreeQueue {
+    static_assert((QueueSize & (QueueSize - 1)) == 0, "QueueSize must be a power of 2");
+
   public:
-    static constexpr int kQueueSize = 1024;  // Power of 2 for fast modulo
+    static constexpr int kQueueSize = QueueSize;
 
-    ParameterQueue() {
+    LockFreeQueue() {
         writeIndex_.store(0, std::memory_order_relaxed);
         readIndex_.store(0, std::memory_order_relaxed);
     }
 
     /**
-     * @brief Push a parameter change (called from UI thread)
-     * @param change The parameter change to queue
+     * @brief Push an item (called from the producer thread)
+     * @param item The item to queue
      * @return true if successfully queued, false if queue full
      */
-    bool push(const ParameterChange& change) {
+    bool push(const T& item) {
         int writeIdx = writeIndex_.load(std::memory_order_relaxed);
         int readIdx = readIndex_.load(std::memory_order_acquire);
 
@@ -57,17 +60,17 @@ class ParameterQueue {
             return false;
         }
 
-        buffer_[writeIdx] = change;
+        buffer_[writeIdx] = item;
         writeIndex_.store(nextWrite, std::memory_order_release);
         return true;
     }
 
     /**
-     * @brief Pop a parameter change (called from audio thread)
-     * @param change Output parameter for the change
-     * @return true if change was available, false if queue empty
+     * @brief Pop an item (called from the consumer thread)
+     * @param item Output parameter for the item
+     * @return true if an item was available, false if queue empty
      */
-    bool pop(ParameterChange& change) {
+    bool pop(T& item) {
         int writeIdx = writeIndex_.load(std::memory_order_acquire);
         int readIdx = readIndex_.load(std::memory_order_relaxed);
 
@@ -76,13 +79,13 @@ class ParameterQueue {
             return false;
         }
 
-        change = buffer_[readIdx];
+        item = buffer_[readIdx];
         readIndex_.store((readIdx + 1) & (kQueueSize - 1), std::memory_order_release);
         return true;
     }
 
     /**
-     * @brief Check if queue has pending changes
+     * @brief Check if queue has pending items
      */
     bool hasPending() const {
         return writeIndex_.load(std::memory_order_acquire) !=
@@ -90,7 +93,7 @@ class ParameterQueue {
     }
 
     /**
-     * @brief Get approximate number of pending changes
+     * @brief Get approximate number of pending items
      */
     int pendingCount() const {
         int writeIdx = writeIndex_.load(std::memory_order_acquire);
@@ -99,7 +102,7 @@ class ParameterQueue {
     }
 
     /**
-     * @brief Clear all pending changes (call only when audio is stopped)
+     * @brief Clear all pending items (call only when neither thread is using the queue)
      */
     void clear() {
         writeIndex_.store(0, std::memory_order_relaxed);
@@ -107,11 +110,18 @@ class ParameterQueue {
     }
 
   private:
-    std::array<ParameterChange, kQueueSize> buffer_;
+    std::array<T, kQueueSize> buffer_{};
     std::atomic<int> writeIndex_{0};
     std::atomic<int> readIndex_{0};
 };
 
+/**
+ * @brief Lock-free SPSC queue for UI-to-audio parameter changes
+ *
+ * UI thread pushes parameter changes, audio thread pops and applies them.
+ */
+using ParameterQueue = LockFreeQueue<ParameterChange, 1024>;
+
 /**
  * @brief Batched parameter changes for efficiency
  *
@@ -0,0 +1,278 @@
+#include "PeakFile.hpp"
+
+#include <cmath>
+#include <cstring>
+
+namespace magda {
+
+namespace {
+
+constexpr char MAGIC[4] = {'M', 'G', 'P', 'K'};  // Distinct from the project file's "MGDP"
+constexpr size_t HEADER_SIZE = 32;
+constexpr size_t LEVEL_ENTRY_SIZE = 20;
+constexpr size_t RECORD_SIZE = 6;
+constexpr int MAX_CHANNELS = 64;
+
+// Samples read per block while building (a whole number of level-0 peaks)
+constexpr int READ_BLOCK_SIZE = PeakFile::BASE_SAMPLES_PER_PEAK * 1024;
+
+struct Record {
+    juce::int16 min = 0;
+    juce::int16 max = 0;
+    juce::uint16 rms = 0;
+};
+
+juce::int16 quantiseSample(float value) {
+    return static_cast<juce::int16>(juce::roundToInt(juce::jlimit(-1.0f, 1.0f, value) * 32767.0f));
+}
+
+juce::uint16 quantiseLevel(float value) {
+    return static_cast<juce::uint16>(juce::roundToInt(juce::jlimit(0.0f, 1.0f, value) * 65535.0f));
+}
+
+// Record of one channel over a run of samples
+Record summarise(const float* samples, int numSamples) {
+    float low = samples[0];
+    float high = samples[0];
+    double sumSquares = 0.0;
+    for (int i = 0; i < numSamples; ++i) {
+        low = juce::jmin(low, samples[i]);
+        high = juce::jmax(high, samples[i]);
+        sumSquares += static_cast<double>(samples[i]) * samples[i];
+    }
+
+    Record record;
+    record.min = quantiseSample(low);
+    record.max = quantiseSample(high);
+    record.rms = quantiseLevel(static_cast<float>(std::sqrt(sumSquares / numSamples)));
+    return record;
+}
+
+// Next level up: each peak covers LEVEL_FACTOR peaks of the level below
+std::vector<Record> reduceLevel(const std::vector<Record>& below, int numChannels) {
+    auto belowPeaks = below.size() / static_cast<size_t>(numChannels);
+    auto numPeaks = (belowPeaks + PeakFile::LEVEL_FACTOR - 1) / PeakFile::LEVEL_FACTOR;
+
+    std::vector<Record> level(numPeaks * static_cast<size_t>(numChannels));
+    for (size_t peak = 0; peak < numPeaks; ++peak) {
+        auto first = peak * PeakFile::LEVEL_FACTOR;
+        auto end = juce::jmin(first + PeakFile::LEVEL_FACTOR, belowPeaks);
+
+        for (int channel = 0; channel < numChannels; ++channel) {
+            const auto& start = below[first * static_cast<size_t>(numChannels) + channel];
+            Record combined = start;
+            double sumSquares = 0.0;
+            for (auto i = first; i < end; ++i) {
+                const auto& record = below[i * static_cast<size_t>(numChannels) + channel];
+                combined.min = juce::jmin(combined.min, record.min);
+                combined.max = juce::jmax(combined.max, record.max);
+                auto rms = record.rms / 65535.0;
+                sumSquares += rms * rms;
+            }
+            combined.rms = quantiseLevel(
+                static_cast<float>(std::sqrt(sumSquares / static_cast<double>(end - first))));
+            level[peak * static_cast<size_t>(numChannels) + channel] = combined;
+        }
+    }
+    return level;
+}
+
+}  // namespace
+
+// ============================================================================
+// Building
+// ============================================================================
+
+bool PeakFile::build(juce::AudioFormatReader& reader, const juce::File& destination,
+                     const std::atomic<bool>& cancelled) {
+    auto numChannels = static_cast<int>(reader.numChannels);
+    auto lengthInSamples = reader.lengthInSamples;
+    if (numChannels <= 0 || numChannels > MAX_CHANNELS || lengthInSamples <= 0 ||
+        reader.sampleRate <= 0.0) {
+        return false;
+    }
+
+    // Level 0 straight from the audio
+    std::vector<std::vector<Record>> levels(1);
+    auto numBasePeaks = (lengthInSamples + BASE_SAMPLES_PER_PEAK - 1) / BASE_SAMPLES_PER_PEAK;
+    levels[0].reserve(static_cast<size_t>(numBasePeaks * numChannels));
+
+    juce::AudioBuffer<float> buffer(numChannels, READ_BLOCK_SIZE);
+    for (juce::int64 position = 0; position < lengthInSamples; position += READ_BLOCK_SIZE) {
+        if (cancelled.load()) {
+            return false;
+        }
+
+        auto numSamples =
+            static_cast<int>(juce::jmin<juce::int64>(READ_BLOCK_SIZE, lengthInSamples - position));
+        if (!reader.read(&buffer, 0, numSamples, position, true, true)) {
+            return false;
+        }
+
+        for (int offset = 0; offset < numSamples; offset += BASE_SAMPLES_PER_PEAK) {
+            auto count = juce::jmin(BASE_SAMPLES_PER_PEAK, numSamples - offset);
+            for (int channel = 0; channel < numChannels; ++channel) {
+                levels[0].push_back(summarise(buffer.getReadPointer(channel, offset), count));
+            }
+        }
+    }
+
+    while (static_cast<int>(levels.size()) < MAX_LEVELS &&
+           levels.back().size() > static_cast<size_t>(numChannels)) {
+        levels.push_back(reduceLevel(levels.back(), numChannels));
+    }
+
+    // Write beside the destination and move into place, so readers never map a partial file
+    if (destination.getParentDirectory().createDirectory().failed()) {
+        return false;
+    }
+    auto temp = destination.getSiblingFile(destination.getFileName() + ".tmp");
+    temp.deleteFile();
+
+    auto dataOffset = HEADER_SIZE + LEVEL_ENTRY_SIZE * levels.size();
+    auto totalSize = dataOffset;
+    for (const auto& level : levels) {
+        totalSize += level.size() * RECORD_SIZE;
+    }
+
+    bool written = false;
+    {
+        juce::FileOutputStream out(temp);
+        if (!out.openedOk()) {
+            return false;
+        }
+
+        out.write(MAGIC, sizeof(MAGIC));
+        out.writeInt(static_cast<int>(FORMAT_VERSION));
+        out.writeDouble(reader.sampleRate);
+        out.writeInt(numChannels);
+        out.writeInt64(lengthInSamples);
+        out.writeInt(static_cast<int>(levels.size()));
+
+        auto offset = static_cast<juce::int64>(dataOffset);
+        int samplesPerPeak = BASE_SAMPLES_PER_PEAK;
+        for (const auto& level : levels) {
+            out.writeInt(samplesPerPeak);
+            out.writeInt64(static_cast<juce::int64>(level.size()) / numChannels);
+            out.writeInt64(offset);
+            offset += static_cast<juce::int64>(level.size() * RECORD_SIZE);
+            samplesPerPeak *= LEVEL_FACTOR;
+        }
+
+        for (const auto& level : levels) {
+            for (const auto& record : level) {
+                out.writeShort(record.min);
+                out.writeShort(record.max);
+                out.writeShort(static_cast<short>(record.rms));
+            }
+        }
+
+        out.flush();
+        written = !out.getStatus().failed() && !cancelled.load();
+    }
+
+    if (!written || temp.getSize() != static_cast<juce::int64>(totalSize)) {
+        temp.deleteFile();
+        return false;
+    }
+    return temp.moveFileTo(destination);
+}
+
+// ============================================================================
+// Reading
+// ============================================================================
+
+std::unique_ptr<PeakFile> PeakFile::open(const juce::File& file) {
+    if (!file.existsAsFile()) {
+        return nullptr;
+    }
+
+    auto map = std::make_unique<juce::MemoryMappedFile>(file, juce::MemoryMappedFile::readOnly);
+    auto size = map->getSize();
+    if (map->getData() == nullptr || size < HEADER_SIZE) {
+        return nullptr;
+    }
+
+    const auto* bytes = static_cast<const juce::uint8*>(map->getData());
+    juce::MemoryInputStream in(bytes, size, false);
+
+    char magic[4];
+    in.read(magic, sizeof(magic));
+    if (std::memcmp(magic, MAGIC, sizeof(MAGIC)) != 0 ||
+        static_cast<juce::uint32>(in.readInt()) != FORMAT_VERSION) {
+        return nullptr;
+    }
+
+    std::unique_ptr<PeakFile> peaks(new PeakFile());
+    peaks->sampleRate_ = in.readDouble();
+    peaks->numChannels_ = in.readInt();
+    peaks->lengthInSamples_ = in.readInt64();
+    auto numLevels = in.readInt();
+
+    if (peaks->sampleRate_ <= 0.0 || peaks->numChannels_ <= 0 ||
+        peaks->numChannels_ > MAX_CHANNELS || numLevels <= 0 || numLevels > MAX_LEVELS ||
+        size < HEADER_SIZE + LEVEL_ENTRY_SIZE * static_cast<size_t>(numLevels)) {
+        return nullptr;
+    }
+
+    for (int i = 0; i < numLevels; ++i) {
+        Level level;
+        level.samplesPerPeak = in.readInt();
+        level.numPeaks = in.readInt64();
+        auto offset = in.readInt64();
+
+        auto levelBytes = static_cast<juce::uint64>(level.numPeaks) *
+                          static_cast<juce::uint64>(peaks->numChannels_) * RECORD_SIZE;
+        if (level.samplesPerPeak <= 0 || level.numPeaks <= 0 || offset < 0 ||
+            static_cast<juce::uint64>(offset) + levelBytes > size) {
+            return nullptr;
+        }
+        level.data = bytes + offset;
+        peaks->levels_.push_back(level);
+    }
+
+    peaks->map_ = std::move(map);
+    return peaks;
+}
+
+size_t PeakFile::getSizeInBytes() const {
+    return map_ != nullptr ? map_->getSize() : 0;
+}
+
+int PeakFile::chooseLevel(double samplesPerPixel) const {
+    for (int level = getNumLevels() - 1; level >= 0; --level) {
+        if (getSamplesPerPeak(level) <= samplesPerPixel) {
+            return level;
+        }
+    }
+    return -1;
+}
+
+PeakValue PeakFile::getPeak(int level, int channel, juce::int64 firstPeak,
+                            juce::int64 endPeak) const {
+    const auto& info = levels_[static_cast<size_t>(level)];
+    firstPeak = juce::jlimit<juce::int64>(0, info.numPeaks - 1, firstPeak);
+    endPeak = juce::jlimit<juce::int64>(firstPeak + 1, info.numPeaks, endPeak);
+
+    int low = 32767;
+    int high = -32767;
+    double sumSquares = 0.0;
+    for (auto peak = firstPeak; peak < endPeak; ++peak) {
+        const auto* record = info.data + (peak * numChannels_ + channel) * RECORD_SIZE;
+        low = juce::jmin(low, static_cast<int>(static_cast<juce::int16>(
+                                  juce::ByteOrder::littleEndianShort(record))));
+        high = juce::jmax(high, static_cast<int>(static_cast<juce::int16>(
+                                    juce::ByteOrder::littleEndianShort(record + 2))));
+        auto rms = juce::ByteOrder::littleEndianShort(record + 4) / 65535.0;
+        sumSquares += rms * rms;
+    }
+
+    PeakValue value;
+    value.min = static_cast<float>(low) / 32767.0f;
+    value.max = static_cast<float>(high) / 32767.0f;
+    value.rms =
+        static_cast<float>(std::sqrt(sumSquares / static_cast<double>(endPeak - firstPeak)));
+    return value;
+}
+
+}  // namespace magda
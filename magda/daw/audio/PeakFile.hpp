@@ -0,0 +1,112 @@
+#pragma once
+
+#include <juce_audio_formats/juce_audio_formats.h>
+#include <juce_core/juce_core.h>
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+namespace magda {
+
+/**
+ * @brief Summary of one channel over a run of samples
+ */
+struct PeakValue {
+    float min = 0.0f;
+    float max = 0.0f;
+    float rms = 0.0f;
+};
+
+/**
+ * @brief Memory-mapped, multi-resolution peak summary of an audio file
+ *
+ * Level 0 holds one min/max/RMS triple per BASE_SAMPLES_PER_PEAK samples and channel;
+ * every further level summarises LEVEL_FACTOR peaks of the one below, so any zoom is
+ * drawn from a level with roughly one peak per pixel. Views zoomed in past level 0
+ * read samples from the audio file instead (see AudioThumbnailManager).
+ *
+ * File layout (little-endian): magic "MGPK", format version, sample rate, channel
+ * count, length in samples, level count, then per level { samples per peak, peak
+ * count, data offset }, then the level data as interleaved per-channel records of
+ * { int16 min, int16 max, uint16 rms }. Files are written to a temporary sibling and
+ * moved into place, so a mapped file is always complete.
+ */
+class PeakFile {
+  public:
+    static constexpr juce::uint32 FORMAT_VERSION = 1;
+    static constexpr int BASE_SAMPLES_PER_PEAK = 64;
+    static constexpr int LEVEL_FACTOR = 4;
+    static constexpr int MAX_LEVELS = 10;
+
+    /**
+     * @brief Summarise a reader's audio into a peak file
+     * @return false if reading or writing failed, or cancelled became true
+     */
+    static bool build(juce::AudioFormatReader& reader, const juce::File& destination,
+                      const std::atomic<bool>& cancelled);
+
+    /**
+     * @brief Map an existing peak file
+     * @return nullptr if the file is missing, truncated or of another format version
+     */
+    static std::unique_ptr<PeakFile> open(const juce::File& file);
+
+    double getSampleRate() const {
+        return sampleRate_;
+    }
+    int getNumChannels() const {
+        return numChannels_;
+    }
+    juce::int64 getLengthInSamples() const {
+        return lengthInSamples_;
+    }
+    double getLengthInSeconds() const {
+        return sampleRate_ > 0.0 ? static_cast<double>(lengthInSamples_) / sampleRate_ : 0.0;
+    }
+
+    int getNumLevels() const {
+        return static_cast<int>(levels_.size());
+    }
+    int getSamplesPerPeak(int level) const {
+        return levels_[static_cast<size_t>(level)].samplesPerPeak;
+    }
+    juce::int64 getNumPeaks(int level) const {
+        return levels_[static_cast<size_t>(level)].numPeaks;
+    }
+
+    /**
+     * @brief Bytes mapped for this file
+     */
+    size_t getSizeInBytes() const;
+
+    /**
+     * @brief Coarsest level with at most samplesPerPixel samples per peak
+     * @return -1 if even level 0 is too coarse (read samples instead)
+     */
+    int chooseLevel(double samplesPerPixel) const;
+
+    /**
+     * @brief Combined summary of peaks [firstPeak, endPeak) of one level and channel
+     */
+    PeakValue getPeak(int level, int channel, juce::int64 firstPeak, juce::int64 endPeak) const;
+
+  private:
+    struct Level {
+        int samplesPerPeak = 0;
+        juce::int64 numPeaks = 0;
+        const juce::uint8* data = nullptr;
+    };
+
+    PeakFile() = default;
+
+    std::unique_ptr<juce::MemoryMappedFile> map_;
+    double sampleRate_ = 0.0;
+    int numChannels_ = 0;
+    juce::int64 lengthInSamples_ = 0;
+    std::vector<Level> levels_;
+
+    JUCE_DECLARE_NON_COPYABLE(PeakFile)
+};
+
+}  // namespace magda
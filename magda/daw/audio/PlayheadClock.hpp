@@ -0,0 +1,101 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+
+namespace magda {
+
+/**
+ * @brief Transport position stamped with the time it was audible, published by the audio thread
+ *
+ * Once per block the audio thread publishes the transport sample being heard at that moment
+ * together with a high-resolution timestamp. The UI reads the latest pair whenever it draws
+ * and extrapolates the playhead to the present, so it moves smoothly at display rate instead
+ * of jumping every time a poll happens to catch a new position.
+ *
+ * Publication is a sequence lock: the single writer never waits, readers retry in the
+ * (rare) case they overlap a write and give up after a few attempts.
+ */
+class PlayheadClock {
+  public:
+    struct Snapshot {
+        juce::int64 sample = 0;  // Transport sample audible at `ticks` (can be < 0 at start)
+        juce::int64 ticks = 0;   // juce::Time::getHighResolutionTicks() when published
+        double sampleRate = 0.0;
+        bool playing = false;
+
+        /**
+         * @brief Transport position in seconds at the given time
+         *
+         * A playing snapshot is advanced by the time elapsed since it was published, but by
+         * no more than maxAheadSeconds, so a stalled audio device freezes the playhead
+         * instead of letting it run on.
+         */
+        double getPositionAt(juce::int64 nowTicks, double maxAheadSeconds) const {
+            if (sampleRate <= 0.0) {
+                return 0.0;
+            }
+            double position = static_cast<double>(sample) / sampleRate;
+            if (playing) {
+                double elapsed = static_cast<double>(nowTicks - ticks) /
+                                 static_cast<double>(juce::Time::getHighResolutionTicksPerSecond());
+                position += std::clamp(elapsed, 0.0, maxAheadSeconds);
+            }
+            return std::max(0.0, position);
+        }
+    };
+
+    /**
+     * @brief Publish a new snapshot (audio thread only)
+     */
+    void publish(const Snapshot& snapshot) noexcept {
+        auto sequence = sequence_.load(std::memory_order_relaxed);
+        sequence_.store(sequence + 1, std::memory_order_relaxed);  // Odd: write in progress
+        std::atomic_thread_fence(std::memory_order_release);
+
+        sample_.store(snapshot.sample, std::memory_order_relaxed);
+        ticks_.store(snapshot.ticks, std::memory_order_relaxed);
+        sampleRate_.store(snapshot.sampleRate, std::memory_order_relaxed);
+        playing_.store(snapshot.playing, std::memory_order_relaxed);
+
+        sequence_.store(sequence + 2, std::memory_order_release);
+    }
+
+    /**
+     * @brief Read the latest snapshot (any thread)
+     * @return false if nothing has been published yet or every attempt overlapped a write
+     */
+    bool read(Snapshot& snapshot) const noexcept {
+        for (int attempt = 0; attempt < kMaxReadAttempts; ++attempt) {
+            auto before = sequence_.load(std::memory_order_acquire);
+            if ((before & 1u) != 0) {
+                continue;
+            }
+
+            snapshot.sample = sample_.load(std::memory_order_relaxed);
+            snapshot.ticks = ticks_.load(std::memory_order_relaxed);
+            snapshot.sampleRate = sampleRate_.load(std::memory_order_relaxed);
+            snapshot.playing = playing_.load(std::memory_order_relaxed);
+
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (sequence_.load(std::memory_order_relaxed) == before) {
+                return before != 0;
+            }
+        }
+        return false;
+    }
+
+  private:
+    static constexpr int kMaxReadAttempts = 8;
+
+    std::atomic<uint32_t> sequence_{0};
+    std::atomic<juce::int64> sample_{0};
+    std::atomic<juce::int64> ticks_{0};
+    std::atomic<double> sampleRate_{0.0};
+    std::atomic<bool> playing_{false};
+};
+
+}  // namespace magda
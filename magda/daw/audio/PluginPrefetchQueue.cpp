@@ -0,0 +1,175 @@
+#include "PluginPrefetchQueue.hpp"
+
+#include <iostream>
+
+#include "../profiling/PerformanceProfiler.hpp"
+
+namespace magda {
+
+namespace {
+
+int defaultThreadCount(int requested, int maxThreads) {
+    if (requested > 0) {
+        return requested;
+    }
+    return juce::jlimit(1, maxThreads, juce::SystemStats::getNumCpus());
+}
+
+}  // namespace
+
+PluginPrefetchQueue::PluginPrefetchQueue(ReadyCallback onReady, int numThreads)
+    : onReady_(std::move(onReady)), pool_(defaultThreadCount(numThreads, MAX_PREFETCH_THREADS)) {}
+
+PluginPrefetchQueue::~PluginPrefetchQueue() {
+    // Invalidate any pending async callbacks
+    validFlag_->store(false);
+
+    cancelAll();
+    pool_.removeAllJobs(true, 5000);
+}
+
+void PluginPrefetchQueue::enqueue(const Request& request) {
+    cancel(request.deviceId);
+
+    auto ticket = std::make_shared<Ticket>();
+    ticket->request = request;
+    pending_[request.deviceId] = ticket;
+
+    auto validFlag = validFlag_;
+    pool_.addJob([this, ticket, validFlag]() {
+        HighResTimer timer;
+        auto bytes = prefetchFiles(findModuleFiles(ticket->request.description), ticket->cancelled);
+
+        if (!ticket->cancelled.load()) {
+            PerformanceMonitor::getInstance().addSample("PluginPrefetch",
+                                                        timer.elapsedMilliseconds());
+            DBG("PluginPrefetchQueue: prefetched " << bytes << " bytes for "
+                                                   << ticket->request.description.name);
+        }
+
+        juce::MessageManager::callAsync([this, ticket, validFlag]() {
+            if (!validFlag->load()) {
+                return;
+            }
+            handlePrefetched(ticket);
+        });
+    });
+}
+
+void PluginPrefetchQueue::handlePrefetched(const std::shared_ptr<Ticket>& ticket) {
+    if (ticket->cancelled.load()) {
+        return;
+    }
+
+    // A newer request for the same device replaces this one
+    auto it = pending_.find(ticket->request.deviceId);
+    if (it == pending_.end() || it->second != ticket) {
+        return;
+    }
+    pending_.erase(it);
+
+    if (onReady_) {
+        onReady_(ticket->request);
+    }
+}
+
+void PluginPrefetchQueue::cancel(DeviceId deviceId) {
+    auto it = pending_.find(deviceId);
+    if (it != pending_.end()) {
+        it->second->cancelled.store(true);
+        pending_.erase(it);
+    }
+}
+
+void PluginPrefetchQueue::cancelTrack(TrackId trackId) {
+    for (auto it = pending_.begin(); it != pending_.end();) {
+        if (it->second->request.trackId == trackId) {
+            it->second->cancelled.store(true);
+            it = pending_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+void PluginPrefetchQueue::cancelAll() {
+    for (auto& [deviceId, ticket] : pending_) {
+        ticket->cancelled.store(true);
+    }
+    pending_.clear();
+}
+
+bool PluginPrefetchQueue::isPending(DeviceId deviceId) const {
+    return pending_.find(deviceId) != pending_.end();
+}
+
+std::vector<DeviceId> PluginPrefetchQueue::getPendingDevices(TrackId trackId) const {
+    std::vector<DeviceId> devices;
+    for (const auto& [deviceId, ticket] : pending_) {
+        if (ticket->request.trackId == trackId) {
+            devices.push_back(deviceId);
+        }
+    }
+    return devices;
+}
+
+juce::Array<juce::File> PluginPrefetchQueue::findModuleFiles(
+    const juce::PluginDescription& description) {
+    juce::Array<juce::File> files;
+
+    // AudioUnit component IDs etc. are not paths - nothing to prefetch
+    if (!juce::File::isAbsolutePath(description.fileOrIdentifier)) {
+        return files;
+    }
+
+    juce::File module(description.fileOrIdentifier);
+    if (module.existsAsFile()) {
+        files.add(module);
+        return files;
+    }
+
+    if (!module.isDirectory()) {
+        return files;
+    }
+
+    // Bundle layout: Contents/MacOS, Contents/x86_64-win, Contents/aarch64-linux, ...
+    auto contents = module.getChildFile("Contents");
+    for (const auto& dir : contents.findChildFiles(juce::File::findDirectories, false)) {
+        auto name = dir.getFileName();
+        if (name == "MacOS" || name.endsWith("-win") || name.endsWith("-linux")) {
+            files.addArray(dir.findChildFiles(juce::File::findFiles, false));
+        }
+    }
+
+    return files;
+}
+
+juce::int64 PluginPrefetchQueue::prefetchFiles(const juce::Array<juce::File>& files,
+                                               const std::atomic<bool>& cancelled) {
+    constexpr int chunkSize = 1024 * 1024;
+    juce::HeapBlock<char> buffer(chunkSize);
+    juce::int64 totalRead = 0;
+
+    for (const auto& file : files) {
+        juce::FileInputStream stream(file);
+        if (!stream.openedOk()) {
+            continue;
+        }
+
+        while (!stream.isExhausted() && totalRead < MAX_PREFETCH_BYTES) {
+            if (cancelled.load()) {
+                return totalRead;
+            }
+
+            auto bytesRead = stream.read(buffer, chunkSize);
+            if (bytesRead <= 0) {
+                break;
+            }
+            totalRead += bytesRead;
+        }
+    }
+
+    return totalRead;
+}
+
+}  // namespace magda
@@ -0,0 +1,108 @@
+#pragma once
+
+#include <juce_audio_processors/juce_audio_processors.h>
+#include <juce_core/juce_core.h>
+#include <juce_events/juce_events.h>
+
+#include <atomic>
+#include <functional>
+#include <map>
+#include <memory>
+#include <vector>
+
+#include "../core/TypeIds.hpp"
+
+namespace magda {
+
+/**
+ * @brief Prefetches external plugin binaries before they are instantiated
+ *
+ * Only the file reads happen in the background: the plugin's module binaries are read
+ * on a thread pool so the OS has them in the page cache, and independent plugins
+ * prefetch in parallel. Instantiation itself is not made asynchronous. The ready
+ * callback runs on the message thread and blocks it for as long as the plugin takes to
+ * create; the queue only spreads those calls over separate messages, so the UI handles
+ * events between plugins rather than during one.
+ *
+ * Requests are keyed by DeviceId and can be cancelled at any point; a cancelled request
+ * never reaches the ready callback.
+ */
+class PluginPrefetchQueue {
+  public:
+    struct Request {
+        DeviceId deviceId = INVALID_DEVICE_ID;
+        TrackId trackId = INVALID_TRACK_ID;
+        juce::PluginDescription description;
+    };
+
+    /**
+     * @brief Called on the message thread once a request's binaries are prefetched
+     *
+     * The callback instantiates the plugin synchronously, so the message thread is
+     * blocked for that plugin's whole creation time.
+     */
+    using ReadyCallback = std::function<void(const Request& request)>;
+
+    /**
+     * @param onReady Callback that instantiates the plugin
+     * @param numThreads Prefetch threads (0 = one per CPU core, up to 4)
+     */
+    explicit PluginPrefetchQueue(ReadyCallback onReady, int numThreads = 0);
+    ~PluginPrefetchQueue();
+
+    /**
+     * @brief Queue a plugin for prefetching (message thread)
+     *
+     * Replaces any pending request for the device.
+     */
+    void enqueue(const Request& request);
+
+    void cancel(DeviceId deviceId);
+    void cancelTrack(TrackId trackId);
+    void cancelAll();
+
+    bool isPending(DeviceId deviceId) const;
+    std::vector<DeviceId> getPendingDevices(TrackId trackId) const;
+    int getNumPending() const {
+        return static_cast<int>(pending_.size());
+    }
+
+    /**
+     * @brief Binaries to prefetch for a plugin (empty for non-file identifiers like AU)
+     *
+     * Single-file modules are returned as-is. For bundles, the platform binary folders
+     * inside Contents/ (MacOS, *-win, *-linux) are returned.
+     */
+    static juce::Array<juce::File> findModuleFiles(const juce::PluginDescription& description);
+
+    /**
+     * @brief Read files through so they are resident in the page cache
+     * @return Number of bytes read (stops early when cancelled becomes true)
+     */
+    static juce::int64 prefetchFiles(const juce::Array<juce::File>& files,
+                                     const std::atomic<bool>& cancelled);
+
+  private:
+    struct Ticket {
+        Request request;
+        std::atomic<bool> cancelled{false};
+    };
+
+    void handlePrefetched(const std::shared_ptr<Ticket>& ticket);
+
+    ReadyCallback onReady_;
+    juce::ThreadPool pool_;
+
+    // Pending requests by device (message thread only)
+    std::map<DeviceId, std::shared_ptr<Ticket>> pending_;
+
+    // Prevents callbacks after destruction
+    std::shared_ptr<std::atomic<bool>> validFlag_ = std::make_shared<std::atomic<bool>>(true);
+
+    static constexpr int MAX_PREFETCH_THREADS = 4;
+    static constexpr juce::int64 MAX_PREFETCH_BYTES = 512 * 1024 * 1024;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(PluginPrefetchQueue)
+};
+
+}  // namespace magda
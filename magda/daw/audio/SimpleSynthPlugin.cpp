@@ -6,77 +6,6 @@ namespace te = tracktion::engine;
 
 const char* SimpleSynthPlugin::xmlTypeName = "simplesynth";
 
-//==============================================================================
-// SimpleSynthVoice Implementation
-//==============================================================================
-
-SimpleSynthVoice::SimpleSynthVoice() {
-    adsrParams.attack = 0.01f;
-    adsrParams.decay = 0.1f;
-    adsrParams.sustain = 0.8f;
-    adsrParams.release = 0.2f;
-    adsr.setParameters(adsrParams);
-}
-
-void SimpleSynthVoice::setADSR(float attack, float decay, float sustain, float release) {
-    adsrParams.attack = attack;
-    adsrParams.decay = decay;
-    adsrParams.sustain = sustain;
-    adsrParams.release = release;
-    adsr.setParameters(adsrParams);
-}
-
-bool SimpleSynthVoice::canPlaySound(juce::SynthesiserSound* sound) {
-    return dynamic_cast<SimpleSynthSound*>(sound) != nullptr;
-}
-
-void SimpleSynthVoice::startNote(int midiNoteNumber, float velocity, juce::SynthesiserSound*,
-                                 int /*currentPitchWheelPosition*/) {
-    currentAngle = 0.0;
-    level = velocity * 0.15;
-    angleDelta = juce::MathConstants<double>::twoPi *
-                 juce::MidiMessage::getMidiNoteInHertz(midiNoteNumber) / getSampleRate();
-
-    adsr.setSampleRate(getSampleRate());
-    adsr.noteOn();
-}
-
-void SimpleSynthVoice::stopNote(float /*velocity*/, bool allowTailOff) {
-    if (allowTailOff) {
-        adsr.noteOff();
-    } else {
-        adsr.reset();
-        clearCurrentNote();
-    }
-}
-
-void SimpleSynthVoice::renderNextBlock(juce::AudioBuffer<float>& outputBuffer, int startSample,
-                                       int numSamples) {
-    adsr.setSampleRate(getSampleRate());
-
-    for (int i = 0; i < numSamples; ++i) {
-        float env = adsr.getNextSample();
-        float sample = 0.0f;
-
-        if (waveform == Waveform::Sine) {
-            // Sine wave
-            sample = static_cast<float>(std::sin(currentAngle) * level * env);
-            currentAngle += angleDelta;
-        } else {
-            // White noise
-            sample = (random.nextFloat() * 2.0f - 1.0f) * static_cast<float>(level * env);
-        }
-
-        for (int channel = 0; channel < outputBuffer.getNumChannels(); ++channel)
-            outputBuffer.addSample(channel, startSample, sample);
-
-        ++startSample;
-    }
-
-    if (!adsr.isActive())
-        clearCurrentNote();
-}
-
 //==============================================================================
 // SimpleSynthPlugin Implementation
 //==============================================================================
@@ -84,11 +13,31 @@ void SimpleSynthVoice::renderNextBlock(juce::AudioBuffer<float>& outputBuffer, i
 SimpleSynthPlugin::SimpleSynthPlugin(const te::PluginCreationInfo& info) : Plugin(info) {
     auto um = getUndoManager();
 
-    // Waveform: 0 = Sine, 1 = Noise
+    // Waveform: 0 = Sine, 1 = Noise, 2 = Saw, 3 = Square
     waveformValue.referTo(state, te::IDs::waveform, um, 0.0f);
     waveformParam = addParam(
-        "waveform", "Waveform", {0.0f, 1.0f}, [](float v) { return v < 0.5f ? "Sine" : "Noise"; },
-        [](const juce::String& s) { return s.equalsIgnoreCase("Noise") ? 1.0f : 0.0f; });
+        "waveform", "Waveform", {0.0f, 3.0f, 1.0f},
+        [](float v) {
+            switch (juce::roundToInt(v)) {
+                case 1:
+                    return "Noise";
+                case 2:
+                    return "Saw";
+                case 3:
+                    return "Square";
+                default:
+                    return "Sine";
+            }
+        },
+        [](const juce::String& s) {
+            if (s.equalsIgnoreCase("Noise"))
+                return 1.0f;
+            if (s.equalsIgnoreCase("Saw"))
+                return 2.0f;
+            if (s.equalsIgnoreCase("Square"))
+                return 3.0f;
+            return 0.0f;
+        });
 
     // Level (dB)
     levelValue.referTo(state, te::IDs::level, um, -12.0f);
@@ -143,6 +92,12 @@ SimpleSynthPlugin::~SimpleSynthPlugin() {
 void SimpleSynthPlugin::initialise(const te::PluginInitialisationInfo& info) {
     sampleRate = info.sampleRate;
     synthesiser.setCurrentPlaybackSampleRate(sampleRate);
+
+    // Size voice scratch buffers up front so rendering never allocates
+    for (int i = 0; i < synthesiser.getNumVoices(); ++i) {
+        if (auto* voice = dynamic_cast<SimpleSynthVoice*>(synthesiser.getVoice(i)))
+            voice->prepare(info.blockSizeSamples);
+    }
 }
 
 void SimpleSynthPlugin::deinitialise() {
@@ -163,9 +118,8 @@ void SimpleSynthPlugin::updateVoiceParameters() {
     float sustain = juce::jlimit(0.0f, 1.0f, sustainParam->getCurrentValue());
     float release = juce::jlimit(0.001f, 10.0f, releaseParam->getCurrentValue());
 
-    SimpleSynthVoice::Waveform wf = waveformParam->getCurrentValue() < 0.5f
-                                        ? SimpleSynthVoice::Waveform::Sine
-                                        : SimpleSynthVoice::Waveform::Noise;
+    auto wf = static_cast<SimpleSynthVoice::Waveform>(
+        juce::jlimit(0, 3, juce::roundToInt(waveformParam->getCurrentValue())));
 
     // Update all voices
     for (int i = 0; i < synthesiser.getNumVoices(); ++i) {
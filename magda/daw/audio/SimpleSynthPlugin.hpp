@@ -2,69 +2,18 @@
 
 #include <tracktion_engine/tracktion_engine.h>
 
+#include "SimpleSynthVoice.hpp"
+
 namespace magda::daw::audio {
 
 namespace te = tracktion::engine;
 
-//==============================================================================
-/**
- * @brief Simple synth sound - applies to all notes and channels
- */
-struct SimpleSynthSound : public juce::SynthesiserSound {
-    bool appliesToNote(int) override {
-        return true;
-    }
-    bool appliesToChannel(int) override {
-        return true;
-    }
-};
-
-//==============================================================================
-/**
- * @brief Synth voice with sine/noise oscillator and ADSR envelope
- */
-class SimpleSynthVoice : public juce::SynthesiserVoice {
-  public:
-    enum class Waveform { Sine = 0, Noise = 1 };
-
-    SimpleSynthVoice();
-
-    void setWaveform(Waveform wf) {
-        waveform = wf;
-    }
-    void setADSR(float attack, float decay, float sustain, float release);
-
-    bool canPlaySound(juce::SynthesiserSound* sound) override;
-    void startNote(int midiNoteNumber, float velocity, juce::SynthesiserSound*,
-                   int currentPitchWheelPosition) override;
-    void stopNote(float velocity, bool allowTailOff) override;
-    void renderNextBlock(juce::AudioBuffer<float>& outputBuffer, int startSample,
-                         int numSamples) override;
-
-    void pitchWheelMoved(int) override {}
-    void controllerMoved(int, int) override {}
-
-  private:
-    Waveform waveform = Waveform::Sine;
-
-    // Sine oscillator state
-    double currentAngle = 0.0;
-    double angleDelta = 0.0;
-
-    // Noise generator
-    juce::Random random;
-
-    double level = 0.0;
-    juce::ADSR adsr;
-    juce::ADSR::Parameters adsrParams;
-};
-
 //==============================================================================
 /**
  * @brief Simple synthesizer plugin for Tracktion Engine
  *
  * MIDI-triggered synth with:
- * - Sine or noise waveform
+ * - Sine, noise, or polyBLEP saw/square waveform
  * - ADSR envelope
  * - Level control
  * - Transport sync support (via external MIDI triggering)
@@ -129,7 +78,7 @@ class SimpleSynthPlugin : public te::Plugin {
     //==============================================================================
     juce::Synthesiser synthesiser;
     double sampleRate = 44100.0;
-    int numVoices = 8;  // Polyphonic
+    int numVoices = 32;  // Block-rendered voices are cheap enough for high polyphony
 
     void updateVoiceParameters();
 
@@ -0,0 +1,322 @@
+#include "SimpleSynthVoice.hpp"
+
+#include <array>
+#include <cmath>
+#include <limits>
+
+namespace magda::daw::audio {
+
+namespace {
+
+constexpr int kSineTableSize = 2048;
+constexpr int kDefaultBlockSize = 512;
+
+// One sine cycle plus a guard sample so interpolation never wraps
+const std::array<float, kSineTableSize + 1>& getSineTable() {
+    static const auto table = [] {
+        std::array<float, kSineTableSize + 1> t{};
+        for (int i = 0; i <= kSineTableSize; ++i) {
+            t[static_cast<size_t>(i)] = static_cast<float>(
+                std::sin(juce::MathConstants<double>::twoPi * i / kSineTableSize));
+        }
+        return t;
+    }();
+    return table;
+}
+
+// Polynomial band-limited step correction around a discontinuity at phase 0
+inline float polyBlep(double t, double dt) {
+    if (t < dt) {
+        t /= dt;
+        return static_cast<float>(t + t - t * t - 1.0);
+    }
+    if (t > 1.0 - dt) {
+        t = (t - 1.0) / dt;
+        return static_cast<float>(t * t + t + t + 1.0);
+    }
+    return 0.0f;
+}
+
+// Fill dest with a linear ramp continuing from start, returns the last value written
+inline float fillRamp(float* dest, int numSamples, float start, float increment) {
+    for (int i = 0; i < numSamples; ++i) {
+        dest[i] = start + increment * static_cast<float>(i + 1);
+    }
+    return numSamples > 0 ? dest[numSamples - 1] : start;
+}
+
+// Number of samples a ramp needs to cover distance (at least one). The small bias keeps
+// float rounding from adding an extra overshooting sample to an exact-length segment.
+inline int samplesToReach(float distance, float increment) {
+    if (increment <= 0.0f) {
+        return std::numeric_limits<int>::max();
+    }
+    return juce::jmax(1, static_cast<int>(std::ceil(distance / increment - 1.0e-4f)));
+}
+
+}  // namespace
+
+//==============================================================================
+// BlockEnvelope Implementation
+//==============================================================================
+
+void BlockEnvelope::setSampleRate(double newSampleRate) {
+    if (newSampleRate > 0.0 && newSampleRate != sampleRate_) {
+        sampleRate_ = newSampleRate;
+        recalculateRates();
+    }
+}
+
+void BlockEnvelope::setParameters(const Parameters& newParams) {
+    params_ = newParams;
+    recalculateRates();
+}
+
+void BlockEnvelope::recalculateRates() {
+    auto rateFor = [this](float distance, float seconds) {
+        return seconds > 0.0f ? static_cast<float>(distance / (seconds * sampleRate_)) : 0.0f;
+    };
+
+    attackRate_ = rateFor(1.0f, params_.attack);
+    decayRate_ = rateFor(1.0f - params_.sustain, params_.decay);
+    // Release rate depends on the level at note-off, so noteOff() computes it
+}
+
+void BlockEnvelope::noteOn() {
+    if (attackRate_ > 0.0f) {
+        state_ = State::Attack;
+    } else if (decayRate_ > 0.0f) {
+        value_ = 1.0f;
+        state_ = State::Decay;
+    } else {
+        value_ = params_.sustain;
+        state_ = State::Sustain;
+    }
+}
+
+void BlockEnvelope::noteOff() {
+    if (state_ == State::Idle) {
+        return;
+    }
+
+    if (params_.release > 0.0f && value_ > 0.0f) {
+        releaseRate_ = static_cast<float>(value_ / (params_.release * sampleRate_));
+        state_ = State::Release;
+    } else {
+        reset();
+    }
+}
+
+void BlockEnvelope::reset() {
+    value_ = 0.0f;
+    state_ = State::Idle;
+}
+
+void BlockEnvelope::render(float* dest, int numSamples) {
+    int pos = 0;
+
+    while (pos < numSamples) {
+        const int remaining = numSamples - pos;
+        float* out = dest + pos;
+
+        switch (state_) {
+            case State::Idle:
+                juce::FloatVectorOperations::clear(out, remaining);
+                return;
+
+            case State::Sustain:
+                // Track sustain edits while held
+                value_ = params_.sustain;
+                juce::FloatVectorOperations::fill(out, value_, remaining);
+                return;
+
+            case State::Attack: {
+                const int toTarget = samplesToReach(1.0f - value_, attackRate_);
+                const int run = juce::jmin(remaining, toTarget);
+                value_ = fillRamp(out, run, value_, attackRate_);
+                pos += run;
+
+                if (run == toTarget) {
+                    value_ = out[run - 1] = 1.0f;
+                    if (decayRate_ > 0.0f) {
+                        state_ = State::Decay;
+                    } else {
+                        value_ = params_.sustain;
+                        state_ = State::Sustain;
+                    }
+                }
+                break;
+            }
+
+            case State::Decay: {
+                const int toTarget = samplesToReach(value_ - params_.sustain, decayRate_);
+                const int run = juce::jmin(remaining, toTarget);
+                value_ = fillRamp(out, run, value_, -decayRate_);
+                pos += run;
+
+                if (run == toTarget) {
+                    value_ = out[run - 1] = params_.sustain;
+                    state_ = State::Sustain;
+                }
+                break;
+            }
+
+            case State::Release: {
+                const int toTarget = samplesToReach(value_, releaseRate_);
+                const int run = juce::jmin(remaining, toTarget);
+                value_ = fillRamp(out, run, value_, -releaseRate_);
+                pos += run;
+
+                if (run == toTarget) {
+                    out[run - 1] = 0.0f;
+                    reset();
+                }
+                break;
+            }
+        }
+    }
+}
+
+//==============================================================================
+// SimpleSynthVoice Implementation
+//==============================================================================
+
+SimpleSynthVoice::SimpleSynthVoice() {
+    envelope.setParameters(envelopeParams);
+    prepare(kDefaultBlockSize);
+}
+
+void SimpleSynthVoice::prepare(int maxBlockSize) {
+    maxBlockSize = juce::jmax(1, maxBlockSize);
+    if (maxBlockSize == scratchSize) {
+        return;
+    }
+
+    oscBuffer.allocate(static_cast<size_t>(maxBlockSize), true);
+    envBuffer.allocate(static_cast<size_t>(maxBlockSize), true);
+    scratchSize = maxBlockSize;
+}
+
+void SimpleSynthVoice::setADSR(float attack, float decay, float sustain, float release) {
+    envelopeParams.attack = attack;
+    envelopeParams.decay = decay;
+    envelopeParams.sustain = sustain;
+    envelopeParams.release = release;
+    envelope.setParameters(envelopeParams);
+}
+
+bool SimpleSynthVoice::canPlaySound(juce::SynthesiserSound* sound) {
+    return dynamic_cast<SimpleSynthSound*>(sound) != nullptr;
+}
+
+void SimpleSynthVoice::startNote(int midiNoteNumber, float velocity, juce::SynthesiserSound*,
+                                 int /*currentPitchWheelPosition*/) {
+    phase = 0.0;
+    level = velocity * 0.15f;
+    phaseDelta = juce::MidiMessage::getMidiNoteInHertz(midiNoteNumber) / getSampleRate();
+
+    envelope.setSampleRate(getSampleRate());
+    envelope.noteOn();
+}
+
+void SimpleSynthVoice::stopNote(float /*velocity*/, bool allowTailOff) {
+    if (allowTailOff) {
+        envelope.noteOff();
+    } else {
+        envelope.reset();
+        clearCurrentNote();
+    }
+}
+
+void SimpleSynthVoice::renderOscillator(float* dest, int numSamples) {
+    const double dt = phaseDelta;
+    double p = phase;
+
+    // Waveform is fixed for the whole block, so each case is a tight branch-free loop
+    switch (waveform) {
+        case Waveform::Sine: {
+            const float* table = getSineTable().data();
+            for (int i = 0; i < numSamples; ++i) {
+                const double pos = p * kSineTableSize;
+                const int index = static_cast<int>(pos);
+                const float frac = static_cast<float>(pos - index);
+                dest[i] = table[index] + frac * (table[index + 1] - table[index]);
+
+                p += dt;
+                if (p >= 1.0) {
+                    p -= 1.0;
+                }
+            }
+            break;
+        }
+
+        case Waveform::Saw:
+            for (int i = 0; i < numSamples; ++i) {
+                dest[i] = static_cast<float>(2.0 * p - 1.0) - polyBlep(p, dt);
+
+                p += dt;
+                if (p >= 1.0) {
+                    p -= 1.0;
+                }
+            }
+            break;
+
+        case Waveform::Square:
+            for (int i = 0; i < numSamples; ++i) {
+                double halfPhase = p + 0.5;
+                if (halfPhase >= 1.0) {
+                    halfPhase -= 1.0;
+                }
+
+                dest[i] = (p < 0.5 ? 1.0f : -1.0f) + polyBlep(p, dt) - polyBlep(halfPhase, dt);
+
+                p += dt;
+                if (p >= 1.0) {
+                    p -= 1.0;
+                }
+            }
+            break;
+
+        case Waveform::Noise:
+            for (int i = 0; i < numSamples; ++i) {
+                dest[i] = random.nextFloat() * 2.0f - 1.0f;
+            }
+            break;
+    }
+
+    phase = p;
+}
+
+void SimpleSynthVoice::renderNextBlock(juce::AudioBuffer<float>& outputBuffer, int startSample,
+                                       int numSamples) {
+    if (!isVoiceActive()) {
+        return;
+    }
+
+    envelope.setSampleRate(getSampleRate());
+
+    const int numChannels = outputBuffer.getNumChannels();
+
+    while (numSamples > 0) {
+        const int blockSize = juce::jmin(numSamples, scratchSize);
+
+        renderOscillator(oscBuffer, blockSize);
+        envelope.render(envBuffer, blockSize);
+        juce::FloatVectorOperations::multiply(oscBuffer, envBuffer, blockSize);
+
+        for (int channel = 0; channel < numChannels; ++channel) {
+            juce::FloatVectorOperations::addWithMultiply(
+                outputBuffer.getWritePointer(channel, startSample), oscBuffer, level, blockSize);
+        }
+
+        startSample += blockSize;
+        numSamples -= blockSize;
+
+        if (!envelope.isActive()) {
+            clearCurrentNote();
+            break;
+        }
+    }
+}
+
+}  // namespace magda::daw::audio
@@ -0,0 +1,124 @@
+#pragma once
+
+#include <juce_audio_basics/juce_audio_basics.h>
+
+namespace magda::daw::audio {
+
+//==============================================================================
+/**
+ * @brief Simple synth sound - applies to all notes and channels
+ */
+struct SimpleSynthSound : public juce::SynthesiserSound {
+    bool appliesToNote(int) override {
+        return true;
+    }
+    bool appliesToChannel(int) override {
+        return true;
+    }
+};
+
+//==============================================================================
+/**
+ * @brief Linear ADSR that renders whole segments at a time
+ *
+ * Same shape as juce::ADSR (linear attack/decay/release, release from the current
+ * level) but fills a gain buffer one segment run at a time instead of stepping a
+ * state machine per sample. Sustain runs become a single vector fill.
+ */
+class BlockEnvelope {
+  public:
+    struct Parameters {
+        float attack = 0.01f;  // seconds
+        float decay = 0.1f;    // seconds
+        float sustain = 0.8f;  // 0.0 to 1.0
+        float release = 0.2f;  // seconds
+    };
+
+    void setSampleRate(double newSampleRate);
+    void setParameters(const Parameters& newParams);
+
+    void noteOn();
+    void noteOff();
+    void reset();
+
+    bool isActive() const {
+        return state_ != State::Idle;
+    }
+
+    /**
+     * @brief Render the next numSamples envelope gains into dest
+     */
+    void render(float* dest, int numSamples);
+
+  private:
+    enum class State { Idle, Attack, Decay, Sustain, Release };
+
+    void recalculateRates();
+
+    Parameters params_;
+    double sampleRate_ = 44100.0;
+    State state_ = State::Idle;
+    float value_ = 0.0f;
+
+    // Per-sample increments for each segment
+    float attackRate_ = 0.0f;
+    float decayRate_ = 0.0f;
+    float releaseRate_ = 0.0f;
+};
+
+//==============================================================================
+/**
+ * @brief Block-rendered synth voice with sine/noise/saw/square oscillators
+ *
+ * Each block is rendered in three passes over a per-voice scratch buffer:
+ * oscillator (waveform chosen once per block, phase accumulator, sine table and
+ * polyBLEP saw/square), envelope multiply, then a vectorised add into every output
+ * channel. Call prepare() with the host block size before rendering.
+ */
+class SimpleSynthVoice : public juce::SynthesiserVoice {
+  public:
+    // Values match the plugin's "waveform" parameter (Sine/Noise kept at 0/1)
+    enum class Waveform { Sine = 0, Noise = 1, Saw = 2, Square = 3 };
+
+    SimpleSynthVoice();
+
+    void prepare(int maxBlockSize);
+
+    void setWaveform(Waveform wf) {
+        waveform = wf;
+    }
+    void setADSR(float attack, float decay, float sustain, float release);
+
+    bool canPlaySound(juce::SynthesiserSound* sound) override;
+    void startNote(int midiNoteNumber, float velocity, juce::SynthesiserSound*,
+                   int currentPitchWheelPosition) override;
+    void stopNote(float velocity, bool allowTailOff) override;
+    void renderNextBlock(juce::AudioBuffer<float>& outputBuffer, int startSample,
+                         int numSamples) override;
+
+    void pitchWheelMoved(int) override {}
+    void controllerMoved(int, int) override {}
+
+  private:
+    void renderOscillator(float* dest, int numSamples);
+
+    Waveform waveform = Waveform::Sine;
+
+    // Phase accumulator (cycles, 0.0 to 1.0)
+    double phase = 0.0;
+    double phaseDelta = 0.0;
+
+    // Noise generator
+    juce::Random random;
+
+    float level = 0.0f;
+    BlockEnvelope envelope;
+    BlockEnvelope::Parameters envelopeParams;
+
+    // Scratch buffers for oscillator output and envelope gain
+    juce::HeapBlock<float> oscBuffer;
+    juce::HeapBlock<float> envBuffer;
+    int scratchSize = 0;
+};
+
+}  // namespace magda::daw::audio
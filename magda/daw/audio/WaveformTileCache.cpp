@@ -0,0 +1,266 @@
+#include "WaveformTileCache.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "../profiling/PerformanceProfiler.hpp"
+
+namespace magda {
+
+namespace {
+
+size_t getImageBytes(const juce::Image& image) {
+    return static_cast<size_t>(image.getWidth()) * static_cast<size_t>(image.getHeight()) * 4;
+}
+
+}  // namespace
+
+WaveformTileCache::WaveformTileCache() {
+    // Peaks becoming ready means placeholders can be replaced
+    AudioThumbnailManager::getInstance().addChangeListener(this);
+}
+
+WaveformTileCache::~WaveformTileCache() {
+    shutdown();
+    AudioThumbnailManager::getInstance().removeChangeListener(this);
+}
+
+WaveformTileCache& WaveformTileCache::getInstance() {
+    static WaveformTileCache instance;
+    return instance;
+}
+
+int WaveformTileCache::getZoomBucket(double samplesPerPixel) {
+    return juce::roundToInt(std::log2(samplesPerPixel) * BUCKETS_PER_OCTAVE);
+}
+
+double WaveformTileCache::getBucketSamplesPerPixel(int bucket) {
+    return std::exp2(static_cast<double>(bucket) / BUCKETS_PER_OCTAVE);
+}
+
+// ============================================================================
+// Drawing
+// ============================================================================
+
+void WaveformTileCache::drawWaveform(juce::Graphics& g, const juce::Rectangle<int>& bounds,
+                                     const juce::String& audioFilePath, double startTime,
+                                     double endTime, const juce::Colour& colour,
+                                     float verticalZoom) {
+    if (bounds.getWidth() <= 0 || bounds.getHeight() <= 0)
+        return;
+
+    auto& thumbnails = AudioThumbnailManager::getInstance();
+    auto peaks = thumbnails.getPeaks(audioFilePath);
+    if (peaks == nullptr) {
+        // Draws the loading placeholder
+        thumbnails.drawWaveform(g, bounds, audioFilePath, startTime, endTime, colour,
+                                verticalZoom);
+        return;
+    }
+
+    // Clamp times to valid range
+    double totalLength = peaks->getLengthInSeconds();
+    startTime = juce::jlimit(0.0, totalLength, startTime);
+    endTime = juce::jlimit(startTime, totalLength, endTime);
+    if (endTime <= startTime)
+        return;
+
+    double sampleRate = peaks->getSampleRate();
+    double samplesPerPixel = (endTime - startTime) * sampleRate / bounds.getWidth();
+    int bucket = getZoomBucket(samplesPerPixel);
+    double bucketSamplesPerPixel = getBucketSamplesPerPixel(bucket);
+
+    // Sample-level zoom reads the audio file, which stays on the message thread
+    if (peaks->chooseLevel(samplesPerPixel) < 0 || peaks->chooseLevel(bucketSamplesPerPixel) < 0) {
+        thumbnails.drawWaveform(g, bounds, audioFilePath, startTime, endTime, colour,
+                                verticalZoom);
+        return;
+    }
+
+    auto visible = g.getClipBounds().getIntersection(bounds);
+    if (visible.isEmpty())
+        return;
+
+    TileKey key;
+    key.filePath = audioFilePath;
+    key.zoomBucket = bucket;
+    key.scale = g.getInternalContext().getPhysicalPixelScaleFactor();
+    key.height = juce::roundToInt(static_cast<float>(bounds.getHeight()) * key.scale);
+    key.colour = colour.getARGB();
+    key.verticalZoom = verticalZoom;
+
+    // Tiles are positioned in file samples, independent of where the clip is drawn
+    double startSample = startTime * sampleRate;
+    double tileSamples = TILE_WIDTH * bucketSamplesPerPixel;
+    double tilePixels = tileSamples / samplesPerPixel;
+    double firstVisibleSample = startSample + (visible.getX() - bounds.getX()) * samplesPerPixel;
+    double endVisibleSample = startSample + (visible.getRight() - bounds.getX()) * samplesPerPixel;
+    auto firstTile = static_cast<juce::int64>(std::floor(firstVisibleSample / tileSamples));
+    auto endTile = static_cast<juce::int64>(std::ceil(endVisibleSample / tileSamples));
+
+    juce::Graphics::ScopedSaveState state(g);
+    g.reduceClipRegion(bounds);
+    g.setOpacity(1.0f);
+
+    for (auto tile = firstTile; tile < endTile; ++tile) {
+        key.tileIndex = tile;
+        auto x = static_cast<float>(bounds.getX() +
+                                    (static_cast<double>(tile) * tileSamples - startSample) /
+                                        samplesPerPixel);
+        juce::Rectangle<float> area(x, static_cast<float>(bounds.getY()),
+                                    static_cast<float>(tilePixels),
+                                    static_cast<float>(bounds.getHeight()));
+
+        auto it = tiles_.find(key);
+        if (it != tiles_.end() && it->second.image.isValid()) {
+            it->second.lastUsed = ++useCounter_;
+            g.drawImage(it->second.image, area, juce::RectanglePlacement::stretchToFit);
+            continue;
+        }
+
+        if (it == tiles_.end()) {
+            requestTile(key, peaks);
+        }
+
+        // Not rendered yet: draw this tile's span directly for this frame
+        juce::Graphics::ScopedSaveState tileState(g);
+        if (g.reduceClipRegion(area.getSmallestIntegerContainer())) {
+            AudioThumbnailManager::drawPeaks(g, bounds, *peaks, startTime, endTime, colour,
+                                             verticalZoom);
+        }
+    }
+}
+
+// ============================================================================
+// Rendering
+// ============================================================================
+
+void WaveformTileCache::requestTile(const TileKey& key, std::shared_ptr<const PeakFile> peaks) {
+    if (numPending_ >= MAX_PENDING_TILES) {
+        return;  // Requested again on a later paint if still visible
+    }
+    if (pool_ == nullptr) {
+        pool_ = std::make_unique<juce::ThreadPool>(
+            juce::jlimit(1, MAX_RENDER_THREADS, juce::SystemStats::getNumCpus() - 1));
+    }
+
+    // An entry without an image marks the tile as pending
+    tiles_[key];
+    ++numPending_;
+
+    auto validFlag = validFlag_;
+    pool_->addJob([this, key, peaks = std::move(peaks), validFlag]() {
+        if (!validFlag->load()) {
+            return;
+        }
+
+        HighResTimer timer;
+        auto image = renderTile(key, *peaks);
+        PerformanceMonitor::getInstance().addSample("WaveformTile", timer.elapsedMilliseconds());
+
+        juce::MessageManager::callAsync([this, key, image, validFlag]() {
+            if (!validFlag->load()) {
+                return;
+            }
+            handleRendered(key, image);
+        });
+    });
+}
+
+juce::Image WaveformTileCache::renderTile(const TileKey& key, const PeakFile& peaks) {
+    // Software images can be drawn into off the message thread
+    int width = juce::roundToInt(TILE_WIDTH * key.scale);
+    juce::Image image(juce::Image::ARGB, width, juce::jmax(1, key.height), true,
+                      juce::SoftwareImageType());
+
+    double tileSamples = TILE_WIDTH * getBucketSamplesPerPixel(key.zoomBucket);
+    double startTime = static_cast<double>(key.tileIndex) * tileSamples / peaks.getSampleRate();
+    double endTime = startTime + tileSamples / peaks.getSampleRate();
+
+    juce::Graphics g(image);
+    AudioThumbnailManager::drawPeaks(g, image.getBounds(), peaks, startTime, endTime,
+                                     juce::Colour(key.colour), key.verticalZoom);
+    return image;
+}
+
+void WaveformTileCache::handleRendered(const TileKey& key, juce::Image image) {
+    --numPending_;
+
+    auto it = tiles_.find(key);
+    if (it == tiles_.end()) {
+        return;
+    }
+
+    it->second.image = std::move(image);
+    it->second.lastUsed = ++useCounter_;
+    memoryUsage_ += getImageBytes(it->second.image);
+
+    enforceMemoryBudget();
+    sendChangeMessage();
+}
+
+void WaveformTileCache::changeListenerCallback(juce::ChangeBroadcaster* /*source*/) {
+    sendChangeMessage();
+}
+
+// ============================================================================
+// Memory budget
+// ============================================================================
+
+void WaveformTileCache::setMemoryBudget(size_t bytes) {
+    memoryBudget_ = bytes;
+    enforceMemoryBudget();
+}
+
+void WaveformTileCache::enforceMemoryBudget() {
+    if (memoryUsage_ <= memoryBudget_) {
+        return;
+    }
+
+    std::vector<std::map<TileKey, Tile>::iterator> ready;
+    for (auto it = tiles_.begin(); it != tiles_.end(); ++it) {
+        if (it->second.image.isValid()) {
+            ready.push_back(it);
+        }
+    }
+    std::sort(ready.begin(), ready.end(), [](const auto& a, const auto& b) {
+        return a->second.lastUsed < b->second.lastUsed;
+    });
+
+    for (auto it : ready) {
+        if (memoryUsage_ <= memoryBudget_) {
+            break;
+        }
+        memoryUsage_ -= getImageBytes(it->second.image);
+        tiles_.erase(it);
+    }
+}
+
+void WaveformTileCache::clear() {
+    // Renders already running finish, but their results are dropped
+    validFlag_->store(false);
+    validFlag_ = std::make_shared<std::atomic<bool>>(true);
+    if (pool_ != nullptr) {
+        pool_->removeAllJobs(false, 0);
+    }
+
+    tiles_.clear();
+    numPending_ = 0;
+    memoryUsage_ = 0;
+}
+
+void WaveformTileCache::shutdown() {
+    validFlag_->store(false);
+    if (pool_ != nullptr) {
+        pool_->removeAllJobs(true, 5000);
+        pool_.reset();
+    }
+
+    tiles_.clear();
+    numPending_ = 0;
+    memoryUsage_ = 0;
+    validFlag_ = std::make_shared<std::atomic<bool>>(true);
+}
+
+}  // namespace magda
@@ -0,0 +1,126 @@
+#pragma once
+
+#include <juce_events/juce_events.h>
+#include <juce_gui_basics/juce_gui_basics.h>
+
+#include <atomic>
+#include <map>
+#include <memory>
+#include <tuple>
+
+#include "AudioThumbnailManager.hpp"
+
+namespace magda {
+
+/**
+ * @brief Pre-rasterised waveform tiles for the arrangement and waveform editor
+ *
+ * A waveform is cut into fixed-width tiles positioned in file samples, so scrolling only
+ * reveals new tiles instead of invalidating drawn ones. Tiles are keyed by file, zoom
+ * bucket (a quarter-octave of samples per pixel; paint stretches the nearest bucket by at
+ * most ~9%), tile index, height, colour and vertical zoom, rendered from the file's peaks
+ * on a background thread and blitted during paint.
+ *
+ * A tile that isn't ready yet is drawn directly for that frame. Zoom levels finer than
+ * the peak files (sample level) are always drawn directly. Ready tiles are kept under a
+ * memory budget, evicting the least recently painted first.
+ *
+ * A change message is broadcast (on the message thread) when tiles or peaks become ready.
+ */
+class WaveformTileCache : public juce::ChangeBroadcaster, private juce::ChangeListener {
+  public:
+    static WaveformTileCache& getInstance();
+
+    /**
+     * @brief Draw a waveform through the tile cache
+     *
+     * Same arguments as AudioThumbnailManager::drawWaveform.
+     */
+    void drawWaveform(juce::Graphics& g, const juce::Rectangle<int>& bounds,
+                      const juce::String& audioFilePath, double startTime, double endTime,
+                      const juce::Colour& colour, float verticalZoom = 1.0f);
+
+    /**
+     * @brief Bytes of tile images to keep before evicting the least recently painted
+     */
+    void setMemoryBudget(size_t bytes);
+    size_t getMemoryBudget() const {
+        return memoryBudget_;
+    }
+    size_t getMemoryUsage() const {
+        return memoryUsage_;
+    }
+    int getNumTiles() const {
+        return static_cast<int>(tiles_.size());
+    }
+
+    /**
+     * @brief Zoom bucket for a samples-per-pixel value, and the bucket's exact value
+     */
+    static int getZoomBucket(double samplesPerPixel);
+    static double getBucketSamplesPerPixel(int bucket);
+
+    /**
+     * @brief Drop all tiles (pending renders are discarded)
+     */
+    void clear();
+
+    /**
+     * @brief Stop rendering and release all resources (call during app shutdown)
+     */
+    void shutdown();
+
+    static constexpr int TILE_WIDTH = 256;
+    static constexpr int BUCKETS_PER_OCTAVE = 4;
+
+  private:
+    WaveformTileCache();
+    ~WaveformTileCache() override;
+
+    struct TileKey {
+        juce::String filePath;
+        int zoomBucket = 0;
+        juce::int64 tileIndex = 0;
+        int height = 0;  // Physical pixels
+        juce::uint32 colour = 0;
+        float verticalZoom = 1.0f;
+        float scale = 1.0f;  // Physical pixels per logical pixel
+
+        bool operator<(const TileKey& other) const {
+            return std::tie(filePath, zoomBucket, tileIndex, height, colour, verticalZoom,
+                            scale) < std::tie(other.filePath, other.zoomBucket, other.tileIndex,
+                                              other.height, other.colour, other.verticalZoom,
+                                              other.scale);
+        }
+    };
+
+    struct Tile {
+        juce::Image image;  // Invalid while rendering
+        juce::uint64 lastUsed = 0;
+    };
+
+    void requestTile(const TileKey& key, std::shared_ptr<const PeakFile> peaks);
+    void handleRendered(const TileKey& key, juce::Image image);
+    void enforceMemoryBudget();
+    void changeListenerCallback(juce::ChangeBroadcaster* source) override;
+
+    static juce::Image renderTile(const TileKey& key, const PeakFile& peaks);
+
+    std::unique_ptr<juce::ThreadPool> pool_;
+    std::map<TileKey, Tile> tiles_;
+    int numPending_ = 0;
+    size_t memoryUsage_ = 0;
+    size_t memoryBudget_ = DEFAULT_MEMORY_BUDGET;
+    juce::uint64 useCounter_ = 0;
+
+    // Prevents callbacks after clear/shutdown
+    std::shared_ptr<std::atomic<bool>> validFlag_ = std::make_shared<std::atomic<bool>>(true);
+
+    static constexpr size_t DEFAULT_MEMORY_BUDGET = 96 * 1024 * 1024;
+    static constexpr int MAX_PENDING_TILES = 64;
+    static constexpr int MAX_RENDER_THREADS = 2;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(WaveformTileCache)
+};
+
+}  // namespace magda
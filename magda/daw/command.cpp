@@ -47,6 +47,11 @@ bool Command::hasParameter(const std::string& key) const {
     return parameters_.find(key) != parameters_.end();
 }
 
+const Command::ParamValue* Command::findParameter(const std::string& key) const {
+    auto it = parameters_.find(key);
+    return it != parameters_.end() ? &it->second : nullptr;
+}
+
 juce::var Command::toJson() const {
     juce::DynamicObject::Ptr obj = new juce::DynamicObject();
     obj->setProperty("command", juce::String(type_));
@@ -58,6 +58,11 @@ class Command {
      */
     bool hasParameter(const std::string& key) const;
 
+    /**
+     * @brief Raw parameter value, or nullptr if absent
+     */
+    const ParamValue* findParameter(const std::string& key) const;
+
     /**
      * @brief Convert to JSON
      */
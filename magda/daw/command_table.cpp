@@ -0,0 +1,196 @@
+#include "command_table.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+// CommandTable implementation
+std::vector<std::string> CommandTable::getCommandTypes() const {
+    std::vector<std::string> types;
+    types.reserve(entries_.size());
+    for (const auto& [type, parser] : entries_) {
+        types.push_back(type);
+    }
+    std::sort(types.begin(), types.end());
+    return types;
+}
+
+bool CommandTable::prepare(const Command& command, Prepared& prepared, std::string& error) const {
+    auto it = entries_.find(command.getType());
+    if (it == entries_.end()) {
+        error = "Unknown command: " + command.getType();
+        return false;
+    }
+
+    auto run = it->second(command, error);
+    if (!run) {
+        error = command.getType() + ": " + error;
+        return false;
+    }
+
+    prepared.type = command.getType();
+    prepared.run = std::move(run);
+    return true;
+}
+
+bool CommandTable::prepareBatch(const juce::var& commands, std::vector<Prepared>& prepared,
+                                std::string& error) const {
+    const auto* array = commands.getArray();
+    if (array == nullptr) {
+        error = "Batch must be an array of commands";
+        return false;
+    }
+
+    prepared.clear();
+    prepared.reserve(static_cast<size_t>(array->size()));
+
+    for (int i = 0; i < array->size(); ++i) {
+        std::string commandError;
+        try {
+            Command command((*array)[i]);
+            Prepared entry;
+            if (prepare(command, entry, commandError)) {
+                prepared.push_back(std::move(entry));
+                continue;
+            }
+        } catch (const std::exception& e) {
+            commandError = e.what();
+        }
+
+        error = "Command " + std::to_string(i) + ": " + commandError;
+        prepared.clear();
+        return false;
+    }
+    return true;
+}
+
+CommandResponse CommandTable::execute(const Command& command) const {
+    Prepared prepared;
+    std::string error;
+    if (!prepare(command, prepared, error)) {
+        return CommandResponse(CommandResponse::Status::Error, error);
+    }
+    return run(prepared);
+}
+
+CommandResponse CommandTable::runBatch(const std::vector<Prepared>& batch) {
+    juce::Array<juce::var> results;
+    bool failed = false;
+    double batchStart = juce::Time::getMillisecondCounterHiRes();
+
+    for (const auto& prepared : batch) {
+        double start = juce::Time::getMillisecondCounterHiRes();
+        auto response = run(prepared);
+        double elapsed = juce::Time::getMillisecondCounterHiRes() - start;
+
+        auto result = response.toJson();
+        if (auto* obj = result.getDynamicObject()) {
+            obj->setProperty("command", juce::String(prepared.type));
+            obj->setProperty("timeMs", elapsed);
+        }
+        results.add(result);
+
+        // Later commands may depend on this one (e.g. a track it was meant to create)
+        if (response.getStatus() == CommandResponse::Status::Error) {
+            failed = true;
+            break;
+        }
+    }
+
+    juce::DynamicObject::Ptr data = new juce::DynamicObject();
+    data->setProperty("results", results);
+    data->setProperty("totalMs", juce::Time::getMillisecondCounterHiRes() - batchStart);
+
+    auto message = failed ? "Batch stopped after command " + std::to_string(results.size() - 1)
+                          : "Executed " + std::to_string(results.size()) + " commands";
+    CommandResponse response(failed ? CommandResponse::Status::Error
+                                    : CommandResponse::Status::Success,
+                             message);
+    response.setData(juce::var(data.get()));
+    return response;
+}
+
+CommandResponse CommandTable::run(const Prepared& prepared) {
+    try {
+        return prepared.run();
+    } catch (const std::exception& e) {
+        return CommandResponse(CommandResponse::Status::Error,
+                               "Command execution failed: " + std::string(e.what()));
+    }
+}
+
+// Parameter helpers
+namespace command_params {
+
+namespace {
+
+bool missing(const std::string& key, std::string& error, bool required) {
+    if (required) {
+        error = "missing parameter '" + key + "'";
+    }
+    return !required;
+}
+
+bool wrongType(const std::string& key, const char* expected, std::string& error) {
+    error = "parameter '" + key + "' must be " + expected;
+    return false;
+}
+
+}  // namespace
+
+bool readString(const Command& command, const std::string& key, std::string& out,
+                std::string& error, bool required) {
+    const auto* value = command.findParameter(key);
+    if (value == nullptr) {
+        return missing(key, error, required);
+    }
+    if (const auto* s = std::get_if<std::string>(value)) {
+        out = *s;
+        return true;
+    }
+    return wrongType(key, "a string", error);
+}
+
+bool readNumber(const Command& command, const std::string& key, double& out, std::string& error,
+                bool required) {
+    const auto* value = command.findParameter(key);
+    if (value == nullptr) {
+        return missing(key, error, required);
+    }
+    if (const auto* d = std::get_if<double>(value)) {
+        out = *d;
+        return true;
+    }
+    if (const auto* i = std::get_if<int>(value)) {
+        out = *i;
+        return true;
+    }
+    return wrongType(key, "a number", error);
+}
+
+bool readInt(const Command& command, const std::string& key, int& out, std::string& error,
+             bool required) {
+    const auto* value = command.findParameter(key);
+    if (value == nullptr) {
+        return missing(key, error, required);
+    }
+    if (const auto* i = std::get_if<int>(value)) {
+        out = *i;
+        return true;
+    }
+    return wrongType(key, "an integer", error);
+}
+
+bool readBool(const Command& command, const std::string& key, bool& out, std::string& error,
+              bool required) {
+    const auto* value = command.findParameter(key);
+    if (value == nullptr) {
+        return missing(key, error, required);
+    }
+    if (const auto* b = std::get_if<bool>(value)) {
+        out = *b;
+        return true;
+    }
+    return wrongType(key, "true or false", error);
+}
+
+}  // namespace command_params
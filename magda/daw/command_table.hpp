@@ -0,0 +1,105 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "command.hpp"
+
+/**
+ * @brief Dispatch table mapping command types to typed handlers
+ *
+ * Each command type is registered once with a parameter struct and a handler taking that
+ * struct. A command is looked up by type and its parameters are parsed into the struct
+ * before anything runs, so a handler never sees a missing or mistyped parameter.
+ *
+ * A parameter struct default-constructs to its defaults and provides
+ *   bool parse(const Command& command, std::string& error);
+ * returning false (with a message) when the command's parameters don't fit.
+ *
+ * Batches are prepared in full before the first command executes: an unknown type or a
+ * bad parameter anywhere rejects the whole batch with nothing changed.
+ */
+class CommandTable {
+  public:
+    /**
+     * @brief A command that has been looked up and parsed, ready to run
+     */
+    struct Prepared {
+        std::string type;
+        std::function<CommandResponse()> run;
+    };
+
+    template <typename Params>
+    void add(const std::string& type, std::function<CommandResponse(const Params&)> handler) {
+        entries_[type] = [handler = std::move(handler)](const Command& command,
+                                                        std::string& error) {
+            Params params;
+            std::function<CommandResponse()> run;
+            if (params.parse(command, error)) {
+                run = [handler, params] { return handler(params); };
+            }
+            return run;
+        };
+    }
+
+    bool contains(const std::string& type) const {
+        return entries_.find(type) != entries_.end();
+    }
+
+    std::vector<std::string> getCommandTypes() const;
+
+    /**
+     * @brief Look up and parse one command
+     * @return false (with a message) for an unknown type or bad parameters
+     */
+    bool prepare(const Command& command, Prepared& prepared, std::string& error) const;
+
+    /**
+     * @brief Prepare a JSON array of command objects, all or nothing
+     */
+    bool prepareBatch(const juce::var& commands, std::vector<Prepared>& prepared,
+                      std::string& error) const;
+
+    /**
+     * @brief Look up, parse and run one command
+     */
+    CommandResponse execute(const Command& command) const;
+
+    /**
+     * @brief Run prepared commands in order, timing each
+     *
+     * Stops at the first command that fails. The response data holds one result per
+     * command that ran ({command, status, message, data, timeMs}) and the total time.
+     */
+    static CommandResponse runBatch(const std::vector<Prepared>& batch);
+
+  private:
+    using Parser = std::function<std::function<CommandResponse()>(const Command&, std::string&)>;
+
+    std::unordered_map<std::string, Parser> entries_;
+
+    static CommandResponse run(const Prepared& prepared);
+};
+
+/**
+ * @brief Helpers for parameter structs' parse()
+ *
+ * Each reads one parameter into out and returns false with a message if it is missing
+ * (required) or has the wrong type. Numbers accept both JSON integers and decimals.
+ */
+namespace command_params {
+
+bool readString(const Command& command, const std::string& key, std::string& out,
+                std::string& error, bool required = true);
+bool readNumber(const Command& command, const std::string& key, double& out,
+                std::string& error, bool required = true);
+bool readInt(const Command& command, const std::string& key, int& out, std::string& error,
+             bool required = true);
+bool readBool(const Command& command, const std::string& key, bool& out, std::string& error,
+              bool required = true);
+
+}  // namespace command_params
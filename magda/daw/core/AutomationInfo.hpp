@@ -7,6 +7,7 @@
 #include <vector>
 
 #include "AutomationTypes.hpp"
+#include "LazyArray.hpp"
 #include "ParameterInfo.hpp"
 #include "SelectionManager.hpp"
 #include "TypeIds.hpp"
@@ -172,7 +173,7 @@ struct AutomationClipInfo {
     bool looping = false;
     double loopLength = 4.0;  // Loop length in seconds
 
-    std::vector<AutomationPoint> points;
+    LazyArray<AutomationPoint> points;  // Decoded on first access when loaded
 
     // Helpers
     double getEndTime() const {
@@ -234,7 +235,7 @@ struct AutomationLaneInfo {
     int height = 60;     // Lane height in pixels
 
     // For Absolute type: points directly on lane
-    std::vector<AutomationPoint> absolutePoints;
+    LazyArray<AutomationPoint> absolutePoints;  // Decoded on first access when loaded
 
     // For ClipBased type: clip IDs
     std::vector<AutomationClipId> clipIds;
@@ -2,6 +2,7 @@
 
 #include <algorithm>
 #include <cmath>
+#include <unordered_set>
 
 #include "ParameterInfo.hpp"
 #include "ParameterUtils.hpp"
@@ -115,7 +116,11 @@ AutomationLaneId AutomationManager::createLane(const AutomationTarget& target,
         lane.absolutePoints.push_back(point);
     }
 
+    laneIndex_.add(lane.id, lanes_.size());
     lanes_.push_back(lane);
+    if (auto* changes = ModelTransactionManager::getInstance().getPendingChanges()) {
+        changes->lanes.add(lane.id);
+    }
     notifyLanesChanged();
 
     return lane.id;
@@ -136,36 +141,33 @@ void AutomationManager::deleteLane(AutomationLaneId laneId) {
         return;
 
     // Delete associated clips if clip-based
-    if (lane->isClipBased()) {
-        for (auto clipId : lane->clipIds) {
-            clips_.erase(
-                std::remove_if(clips_.begin(), clips_.end(),
-                               [clipId](const AutomationClipInfo& c) { return c.id == clipId; }),
-                clips_.end());
-        }
+    if (lane->isClipBased() && !lane->clipIds.empty()) {
+        std::unordered_set<AutomationClipId> laneClips(lane->clipIds.begin(),
+                                                       lane->clipIds.end());
+        clips_.erase(std::remove_if(clips_.begin(), clips_.end(),
+                                    [&laneClips](const AutomationClipInfo& c) {
+                                        return laneClips.count(c.id) != 0;
+                                    }),
+                     clips_.end());
+        clipIndex_.rebuild(clips_);
     }
 
-    lanes_.erase(std::remove_if(lanes_.begin(), lanes_.end(),
-                                [laneId](const AutomationLaneInfo& l) { return l.id == laneId; }),
-                 lanes_.end());
+    laneIndex_.erase(lanes_, laneId);
+    if (auto* changes = ModelTransactionManager::getInstance().getPendingChanges()) {
+        changes->lanes.remove(laneId);
+        changes->laneClips.erase(laneId);
+        changes->lanePoints.erase(laneId);
+    }
 
     notifyLanesChanged();
 }
 
 AutomationLaneInfo* AutomationManager::getLane(AutomationLaneId laneId) {
-    for (auto& lane : lanes_) {
-        if (lane.id == laneId)
-            return &lane;
-    }
-    return nullptr;
+    return laneIndex_.lookup(lanes_, laneId);
 }
 
 const AutomationLaneInfo* AutomationManager::getLane(AutomationLaneId laneId) const {
-    for (const auto& lane : lanes_) {
-        if (lane.id == laneId)
-            return &lane;
-    }
-    return nullptr;
+    return laneIndex_.lookup(lanes_, laneId);
 }
 
 std::vector<AutomationLaneId> AutomationManager::getLanesForTrack(TrackId trackId) const {
@@ -244,6 +246,7 @@ AutomationClipId AutomationManager::createClip(AutomationLaneId laneId, double s
     clip.colour = AutomationClipInfo::getDefaultColor(static_cast<int>(clips_.size()));
     clip.name = "Automation " + juce::String(clip.id);
 
+    clipIndex_.add(clip.id, clips_.size());
     clips_.push_back(clip);
     lane->clipIds.push_back(clip.id);
 
@@ -265,27 +268,17 @@ void AutomationManager::deleteClip(AutomationClipId clipId) {
     }
 
     // Remove clip
-    clips_.erase(std::remove_if(clips_.begin(), clips_.end(),
-                                [clipId](const AutomationClipInfo& c) { return c.id == clipId; }),
-                 clips_.end());
+    clipIndex_.erase(clips_, clipId);
 
     notifyClipsChanged(laneId);
 }
 
 AutomationClipInfo* AutomationManager::getClip(AutomationClipId clipId) {
-    for (auto& clip : clips_) {
-        if (clip.id == clipId)
-            return &clip;
-    }
-    return nullptr;
+    return clipIndex_.lookup(clips_, clipId);
 }
 
 const AutomationClipInfo* AutomationManager::getClip(AutomationClipId clipId) const {
-    for (const auto& clip : clips_) {
-        if (clip.id == clipId)
-            return &clip;
-    }
-    return nullptr;
+    return clipIndex_.lookup(clips_, clipId);
 }
 
 void AutomationManager::moveClip(AutomationClipId clipId, double newStartTime) {
@@ -328,6 +321,7 @@ AutomationClipId AutomationManager::duplicateClip(AutomationClipId clipId) {
         point.id = nextPointId_++;
     }
 
+    clipIndex_.add(newClip.id, clips_.size());
     clips_.push_back(newClip);
 
     if (auto* lane = getLane(newClip.laneId)) {
@@ -670,22 +664,43 @@ void AutomationManager::removeListener(AutomationManagerListener* listener) {
 }
 
 void AutomationManager::notifyLanesChanged() {
+    if (auto* changes = ModelTransactionManager::getInstance().getPendingChanges()) {
+        changes->laneListChanged = true;
+        return;
+    }
     listeners_.call([](AutomationManagerListener& l) { l.automationLanesChanged(); });
 }
 
 void AutomationManager::notifyLanePropertyChanged(AutomationLaneId laneId) {
+    if (auto* changes = ModelTransactionManager::getInstance().getPendingChanges()) {
+        changes->lanes.modify(laneId);
+        return;
+    }
     listeners_.call(
         [laneId](AutomationManagerListener& l) { l.automationLanePropertyChanged(laneId); });
 }
 
 void AutomationManager::notifyClipsChanged(AutomationLaneId laneId) {
+    if (auto* changes = ModelTransactionManager::getInstance().getPendingChanges()) {
+        changes->laneClips.insert(laneId);
+        return;
+    }
     listeners_.call([laneId](AutomationManagerListener& l) { l.automationClipsChanged(laneId); });
 }
 
 void AutomationManager::notifyPointsChanged(AutomationLaneId laneId) {
+    if (auto* changes = ModelTransactionManager::getInstance().getPendingChanges()) {
+        changes->lanePoints.insert(laneId);
+        return;
+    }
     listeners_.call([laneId](AutomationManagerListener& l) { l.automationPointsChanged(laneId); });
 }
 
+void AutomationManager::notifyChangesCommitted(const ModelChangeSet& changes) {
+    listeners_.call(
+        [&changes](AutomationManagerListener& l) { l.automationChangesCommitted(changes); });
+}
+
 void AutomationManager::notifyPointDragPreview(AutomationLaneId laneId, AutomationPointId pointId,
                                                double previewTime, double previewValue) {
     listeners_.call([laneId, pointId, previewTime, previewValue](AutomationManagerListener& l) {
@@ -700,12 +715,35 @@ void AutomationManager::notifyPointDragPreview(AutomationLaneId laneId, Automati
 void AutomationManager::clearAll() {
     lanes_.clear();
     clips_.clear();
+    laneIndex_.clear();
+    clipIndex_.clear();
     nextLaneId_ = 1;
     nextClipId_ = 1;
     nextPointId_ = 1;
     notifyLanesChanged();
 }
 
+void AutomationManager::loadAutomation(std::vector<AutomationLaneInfo> lanes,
+                                       std::vector<AutomationClipInfo> clips,
+                                       AutomationPointId nextPointId) {
+    lanes_ = std::move(lanes);
+    clips_ = std::move(clips);
+    laneIndex_.rebuild(lanes_);
+    clipIndex_.rebuild(clips_);
+
+    nextLaneId_ = 1;
+    for (const auto& lane : lanes_) {
+        nextLaneId_ = std::max(nextLaneId_, lane.id + 1);
+    }
+    nextClipId_ = 1;
+    for (const auto& clip : clips_) {
+        nextClipId_ = std::max(nextClipId_, clip.id + 1);
+    }
+    nextPointId_ = std::max(1, nextPointId);
+
+    notifyLanesChanged();
+}
+
 // ============================================================================
 // Helpers
 // ============================================================================
@@ -8,6 +8,8 @@
 
 #include "AutomationInfo.hpp"
 #include "AutomationTypes.hpp"
+#include "IdIndex.hpp"
+#include "ModelTransaction.hpp"
 #include "TrackManager.hpp"
 #include "TypeIds.hpp"
 
@@ -43,6 +45,23 @@ class AutomationManagerListener {
                                             double previewTime, double previewValue) {
         juce::ignoreUnused(laneId, pointId, previewTime, previewValue);
     }
+
+    // Called once when a model transaction commits, in place of the lane, clip and point
+    // callbacks it deferred. Replays them by default.
+    virtual void automationChangesCommitted(const ModelChangeSet& changes) {
+        if (changes.laneListChanged) {
+            automationLanesChanged();
+        }
+        for (auto laneId : changes.lanes.modified) {
+            automationLanePropertyChanged(laneId);
+        }
+        for (auto laneId : changes.laneClips) {
+            automationClipsChanged(laneId);
+        }
+        for (auto laneId : changes.lanePoints) {
+            automationPointsChanged(laneId);
+        }
+    }
 };
 
 /**
@@ -269,6 +288,27 @@ class AutomationManager : public TrackManagerListener {
 
     void clearAll();
 
+    /**
+     * @brief Get all automation clips
+     */
+    const std::vector<AutomationClipInfo>& getClips() const {
+        return clips_;
+    }
+
+    /**
+     * @brief Replace all lanes and clips (project load)
+     * @param nextPointId First point ID not used by any point (points may not be decoded yet)
+     */
+    void loadAutomation(std::vector<AutomationLaneInfo> lanes,
+                        std::vector<AutomationClipInfo> clips, AutomationPointId nextPointId);
+
+    /**
+     * @brief First point ID not yet handed out
+     */
+    AutomationPointId getNextPointId() const {
+        return nextPointId_;
+    }
+
     // ========================================================================
     // TrackManagerListener - Updates automation when faders move
     // ========================================================================
@@ -282,6 +322,8 @@ class AutomationManager : public TrackManagerListener {
 
     std::vector<AutomationLaneInfo> lanes_;
     std::vector<AutomationClipInfo> clips_;
+    IdIndex<AutomationLaneId> laneIndex_;  // O(1) getLane()
+    IdIndex<AutomationClipId> clipIndex_;  // O(1) getClip()
     juce::ListenerList<AutomationManagerListener> listeners_;
 
     int nextLaneId_ = 1;
@@ -294,6 +336,9 @@ class AutomationManager : public TrackManagerListener {
     void notifyClipsChanged(AutomationLaneId laneId);
     void notifyPointsChanged(AutomationLaneId laneId);
 
+    friend class ModelTransactionManager;
+    void notifyChangesCommitted(const ModelChangeSet& changes);
+
     // Interpolation helpers
     double interpolateLinear(double t, double v1, double v2) const;
     double interpolateBezier(double t, const AutomationPoint& p1, const AutomationPoint& p2) const;
@@ -0,0 +1,93 @@
+#include "ChainGraph.hpp"
+
+namespace magda {
+
+void ChainGraph::build(const TrackInfo& track) {
+    // clear() keeps the arrays' capacity, so rebuilding after an edit doesn't reallocate
+    clear();
+    trackId = track.id;
+    elements = &track.chainElements.items();
+    addElements(*elements, npos, 0, nullptr, nullptr);
+}
+
+void ChainGraph::clear() {
+    trackId = INVALID_TRACK_ID;
+    elements = nullptr;
+    nodes.clear();
+    mods.clear();
+    macros.clear();
+}
+
+ChainNodePath ChainGraph::getPath(uint32_t index) const {
+    const auto& node = nodes[index];
+    if (node.type == ChainStepType::Device && node.parent == npos) {
+        return ChainNodePath::topLevelDevice(trackId, node.id);
+    }
+
+    ChainNodePath path;
+    path.trackId = trackId;
+    path.steps.resize(node.depth + 1);
+    for (uint32_t i = index; i != npos; i = nodes[i].parent) {
+        path.steps[nodes[i].depth] = {nodes[i].type, nodes[i].id};
+    }
+    return path;
+}
+
+void ChainGraph::addElements(const std::vector<ChainElement>& elements, uint32_t parent,
+                             uint32_t depth, const RackInfo* parentRack,
+                             const ChainInfo* parentChain) {
+    for (const auto& element : elements) {
+        if (isDevice(element)) {
+            const auto& device = getDevice(element);
+            auto index = addNode(ChainStepType::Device, device.id, parent, depth);
+            auto& node = nodes[index];
+            node.rack = parentRack;
+            node.chain = parentChain;
+            node.device = &device;
+            addMods(node, device.mods, device.macros);
+            node.end = index + 1;
+            continue;
+        }
+
+        const auto& rack = getRack(element);
+        auto rackIndex = addNode(ChainStepType::Rack, rack.id, parent, depth);
+        nodes[rackIndex].rack = &rack;
+        addMods(nodes[rackIndex], rack.mods, rack.macros);
+
+        for (const auto& chain : rack.chains) {
+            auto chainIndex = addNode(ChainStepType::Chain, chain.id, rackIndex, depth + 1);
+            nodes[chainIndex].rack = &rack;
+            nodes[chainIndex].chain = &chain;
+
+            addElements(chain.elements, chainIndex, depth + 2, &rack, &chain);
+            nodes[chainIndex].end = static_cast<uint32_t>(nodes.size());
+        }
+        nodes[rackIndex].end = static_cast<uint32_t>(nodes.size());
+    }
+}
+
+uint32_t ChainGraph::addNode(ChainStepType type, int id, uint32_t parent, uint32_t depth) {
+    Node node;
+    node.type = type;
+    node.id = id;
+    node.parent = parent;
+    node.depth = depth;
+    nodes.push_back(node);
+    return static_cast<uint32_t>(nodes.size() - 1);
+}
+
+void ChainGraph::addMods(Node& node, const ModArray& nodeMods, const MacroArray& nodeMacros) {
+    node.modsBegin = static_cast<uint32_t>(mods.size());
+    for (const auto& mod : nodeMods) {
+        mods.push_back(&mod);
+    }
+    node.modsEnd = static_cast<uint32_t>(mods.size());
+
+    node.macrosBegin = static_cast<uint32_t>(macros.size());
+    for (const auto& macro : nodeMacros) {
+        macros.push_back(&macro);
+    }
+    node.macrosEnd = static_cast<uint32_t>(macros.size());
+}
+
+}  // namespace magda
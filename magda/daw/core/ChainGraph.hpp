@@ -0,0 +1,71 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "SelectionManager.hpp"
+#include "TrackInfo.hpp"
+
+namespace magda {
+
+/**
+ * @brief Flat, depth-first view of one track's device chain
+ *
+ * The chain itself stays a tree of ChainElement variants (that's what gets edited, copied
+ * and saved). This is a derived copy of its shape laid out in one contiguous node array:
+ * each node records its parent's index and the end of its subtree, so a whole rack is the
+ * range [i, nodes[i].end) and its children are found by hopping from i + 1 to each
+ * sibling's end. Every mod and macro on the track is gathered into two flat pointer
+ * arrays, each node owning a [begin, end) range of them.
+ *
+ * Built and owned by ChainNodeIndex, and rebuilt (reusing its storage) whenever the track
+ * is invalidated there, so the pointers follow the same rules as the index. They are
+ * read-only because the chain may still be shared with a snapshot; TrackManager writes
+ * through them only after detaching the track's chain.
+ */
+struct ChainGraph {
+    static constexpr uint32_t npos = UINT32_MAX;
+
+    struct Node {
+        ChainStepType type = ChainStepType::Device;
+        int id = 0;
+        uint32_t parent = npos;  // npos for elements at the top of the track chain
+        uint32_t end = 0;        // One past the last node of this subtree
+        uint32_t depth = 0;      // 0 for top-level elements
+
+        // Same meaning as ChainNodeIndex::Node
+        const RackInfo* rack = nullptr;
+        const ChainInfo* chain = nullptr;
+        const DeviceInfo* device = nullptr;
+
+        // Ranges into ChainGraph::mods / ChainGraph::macros (empty for chains)
+        uint32_t modsBegin = 0, modsEnd = 0;
+        uint32_t macrosBegin = 0, macrosEnd = 0;
+    };
+
+    TrackId trackId = INVALID_TRACK_ID;
+    const std::vector<ChainElement>* elements = nullptr;  // Chain buffer the graph was built from
+    std::vector<Node> nodes;  // Depth-first, in chain order
+    std::vector<const ModInfo*> mods;
+    std::vector<const MacroInfo*> macros;
+
+    void build(const TrackInfo& track);
+    void clear();
+
+    bool empty() const {
+        return nodes.empty();
+    }
+
+    /**
+     * @brief Canonical path of a node (top-level devices use topLevelDeviceId)
+     */
+    ChainNodePath getPath(uint32_t index) const;
+
+  private:
+    void addElements(const std::vector<ChainElement>& elements, uint32_t parent, uint32_t depth,
+                     const RackInfo* parentRack, const ChainInfo* parentChain);
+    uint32_t addNode(ChainStepType type, int id, uint32_t parent, uint32_t depth);
+    void addMods(Node& node, const ModArray& nodeMods, const MacroArray& nodeMacros);
+};
+
+}  // namespace magda
@@ -0,0 +1,136 @@
+#include "ChainNodeIndex.hpp"
+
+#include <iterator>
+
+namespace magda {
+
+ChainNodeIndex::Key ChainNodeIndex::makeKey(ChainStepType type, int id) {
+    return (static_cast<Key>(type) << 32) | static_cast<std::uint32_t>(id);
+}
+
+ChainNodeIndex::Key ChainNodeIndex::makeKey(TrackId trackId, ChainStepType type, int id) {
+    return (static_cast<Key>(static_cast<std::uint32_t>(trackId)) << 34) | makeKey(type, id);
+}
+
+void ChainNodeIndex::invalidate(TrackId trackId) {
+    if (!allDirty_) {
+        dirtyTracks_.insert(trackId);
+    }
+}
+
+void ChainNodeIndex::invalidateAll() {
+    allDirty_ = true;
+    dirtyTracks_.clear();
+}
+
+void ChainNodeIndex::update(const std::vector<TrackInfo>& tracks) {
+    if (allDirty_) {
+        nodes_.clear();
+        owners_.clear();
+        for (auto& [trackId, graph] : graphs_) {
+            graph.clear();  // Kept (with its storage) for tracks that are still there
+        }
+        for (const auto& track : tracks) {
+            addTrack(track);
+        }
+        for (auto it = graphs_.begin(); it != graphs_.end();) {
+            it = it->second.trackId == INVALID_TRACK_ID ? graphs_.erase(it) : std::next(it);
+        }
+        allDirty_ = false;
+        return;
+    }
+
+    if (dirtyTracks_.empty()) {
+        return;
+    }
+
+    for (auto trackId : dirtyTracks_) {
+        removeTrack(trackId);
+    }
+    for (const auto& track : tracks) {
+        if (dirtyTracks_.count(track.id) != 0) {
+            addTrack(track);
+        }
+    }
+    for (auto trackId : dirtyTracks_) {
+        auto it = graphs_.find(trackId);
+        if (it != graphs_.end() && it->second.trackId == INVALID_TRACK_ID) {
+            graphs_.erase(it);
+        }
+    }
+    dirtyTracks_.clear();
+}
+
+const ChainNodeIndex::Node* ChainNodeIndex::find(TrackId trackId, ChainStepType type,
+                                                 int id) const {
+    auto it = nodes_.find(makeKey(trackId, type, id));
+    return it != nodes_.end() ? &it->second : nullptr;
+}
+
+const ChainNodeIndex::Node* ChainNodeIndex::find(ChainStepType type, int id) const {
+    auto it = owners_.find(makeKey(type, id));
+    return it != owners_.end() ? find(it->second, type, id) : nullptr;
+}
+
+const ChainNodeIndex::Node* ChainNodeIndex::resolve(const ChainNodePath& path) const {
+    if (path.topLevelDeviceId != INVALID_DEVICE_ID) {
+        const auto* node = find(path.trackId, ChainStepType::Device, path.topLevelDeviceId);
+        return node && node->chain == nullptr ? node : nullptr;
+    }
+    if (path.steps.empty()) {
+        return nullptr;
+    }
+
+    const auto& last = path.steps.back();
+    const auto* node = find(path.trackId, last.type, last.id);
+    if (!node) {
+        return nullptr;
+    }
+
+    // A top-level device can also be addressed as a single Device step
+    if (node->path.topLevelDeviceId != INVALID_DEVICE_ID) {
+        return path.steps.size() == 1 ? node : nullptr;
+    }
+    return node->path.steps == path.steps ? node : nullptr;
+}
+
+const ChainGraph* ChainNodeIndex::getGraph(TrackId trackId) const {
+    auto it = graphs_.find(trackId);
+    return it != graphs_.end() ? &it->second : nullptr;
+}
+
+void ChainNodeIndex::removeTrack(TrackId trackId) {
+    auto it = graphs_.find(trackId);
+    if (it == graphs_.end()) {
+        return;
+    }
+
+    for (const auto& graphNode : it->second.nodes) {
+        nodes_.erase(makeKey(trackId, graphNode.type, graphNode.id));
+
+        // Drop the ID -> track entry only if it pointed here
+        auto owner = owners_.find(makeKey(graphNode.type, graphNode.id));
+        if (owner != owners_.end() && owner->second == trackId) {
+            owners_.erase(owner);
+        }
+    }
+    it->second.clear();
+}
+
+void ChainNodeIndex::addTrack(const TrackInfo& track) {
+    auto& graph = graphs_[track.id];
+    graph.build(track);
+
+    for (uint32_t i = 0; i < graph.nodes.size(); ++i) {
+        const auto& graphNode = graph.nodes[i];
+        Node node;
+        node.path = graph.getPath(i);
+        node.rack = graphNode.rack;
+        node.chain = graphNode.chain;
+        node.device = graphNode.device;
+        nodes_[makeKey(track.id, graphNode.type, graphNode.id)] = std::move(node);
+        owners_.emplace(makeKey(graphNode.type, graphNode.id), track.id);
+    }
+}
+
+}  // namespace magda
@@ -0,0 +1,94 @@
+#pragma once
+
+#include <cstdint>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "ChainGraph.hpp"
+#include "SelectionManager.hpp"
+#include "TrackInfo.hpp"
+
+namespace magda {
+
+/**
+ * @brief Index from device, rack and chain IDs to where they sit in the track chains
+ *
+ * Each entry holds the node's canonical ChainNodePath and pointers to the node and its
+ * parents, so path and ID resolution is a hash lookup instead of a walk down the tree.
+ *
+ * The pointers go stale whenever a chain is restructured, so the owner marks a track
+ * dirty after any add/remove/move in its chain (invalidate()) and everything dirty when
+ * tracks themselves are added, removed or reordered (invalidateAll()). Dirty tracks are
+ * re-walked on the next update(), one track at a time. Message thread only.
+ *
+ * Indexing never detaches a chain, so a chain shared with a snapshot is indexed in place
+ * and the pointers are const. The owner detaches a track's chain, and invalidates it
+ * here, before writing through any of them.
+ *
+ * The walk produces each track's ChainGraph first and the hash entries from that, so the
+ * flat graphs are always in step with the index and can be handed to hot traversals.
+ */
+class ChainNodeIndex {
+  public:
+    struct Node {
+        ChainNodePath path;  // Canonical path (top-level devices use topLevelDeviceId)
+
+        // Same meaning as TrackManager::ResolvedPath: racks carry no chain, chains carry
+        // their parent rack, devices carry their parent chain and its rack (both null at
+        // the top level of a track)
+        const RackInfo* rack = nullptr;
+        const ChainInfo* chain = nullptr;
+        const DeviceInfo* device = nullptr;
+    };
+
+    void invalidate(TrackId trackId);
+    void invalidateAll();
+
+    bool needsUpdate() const {
+        return allDirty_ || !dirtyTracks_.empty();
+    }
+
+    /**
+     * @brief Re-walk whatever was invalidated
+     */
+    void update(const std::vector<TrackInfo>& tracks);
+
+    /**
+     * @brief Look up a node on a specific track
+     */
+    const Node* find(TrackId trackId, ChainStepType type, int id) const;
+
+    /**
+     * @brief Look up a node by ID alone, on whichever track holds it
+     */
+    const Node* find(ChainStepType type, int id) const;
+
+    /**
+     * @brief Find the node a path points at, or nullptr if the path doesn't match the tree
+     */
+    const Node* resolve(const ChainNodePath& path) const;
+
+    /**
+     * @brief Flat view of a track's chain, or nullptr if the track isn't indexed
+     */
+    const ChainGraph* getGraph(TrackId trackId) const;
+
+  private:
+    using Key = std::uint64_t;
+
+    static Key makeKey(ChainStepType type, int id);
+    static Key makeKey(TrackId trackId, ChainStepType type, int id);
+
+    std::unordered_map<Key, Node> nodes_;             // (track, type, id) -> node
+    std::unordered_map<Key, TrackId> owners_;         // (type, id) -> track
+    std::unordered_map<TrackId, ChainGraph> graphs_;  // Also drives per-track removal
+
+    std::unordered_set<TrackId> dirtyTracks_;
+    bool allDirty_ = true;
+
+    void removeTrack(TrackId trackId);
+    void addTrack(const TrackInfo& track);
+};
+
+}  // namespace magda
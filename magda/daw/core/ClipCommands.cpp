@@ -51,7 +51,7 @@ void SplitClipCommand::undo() {
     }
 
     // Force UI refresh after direct property modification
-    clipManager.forceNotifyClipsChanged();
+    clipManager.forceNotifyClipPropertyChanged(originalClipId_);
 
     std::cout << "📝 UNDO: Undid split - deleted clip " << createdClipId_ << ", restored clip "
               << originalClipId_ << std::endl;
@@ -186,7 +186,7 @@ void ResizeClipCommand::undo() {
     }
 
     // Force UI refresh after direct property modification
-    clipManager.forceNotifyClipsChanged();
+    clipManager.forceNotifyClipPropertyChanged(clipId_);
 }
 
 bool ResizeClipCommand::canMergeWith(const UndoableCommand* other) const {
@@ -219,10 +219,9 @@ void DeleteClipCommand::execute() {
         return;
     }
 
-    // Store full clip info for undo (only on first execute)
-    if (!executed_) {
-        storedClip_ = *clip;
-    }
+    // Snapshot the clip being deleted; the copy shares its notes, which the deleted clip
+    // then leaves to us
+    storedClip_ = *clip;
 
     clipManager.deleteClip(clipId_);
     executed_ = true;
@@ -235,11 +234,21 @@ void DeleteClipCommand::undo() {
         return;
     }
 
+    // Hand the snapshot back rather than keeping a second reference to the notes; redo
+    // snapshots again
     ClipManager::getInstance().restoreClip(storedClip_);
+    storedClip_ = ClipInfo();
 
     std::cout << "📝 UNDO: Restored clip " << clipId_ << std::endl;
 }
 
+size_t DeleteClipCommand::getSizeInBytes() const {
+    // Notes still shared with the model are not ours to count
+    size_t notesBytes =
+        storedClip_.midiNotes.isShared() ? 0 : storedClip_.midiNotes.size() * sizeof(MidiNote);
+    return sizeof(*this) + notesBytes;
+}
+
 // ============================================================================
 // CreateClipCommand
 // ============================================================================
@@ -120,6 +120,7 @@ class DeleteClipCommand : public UndoableCommand {
     juce::String getDescription() const override {
         return "Delete Clip";
     }
+    size_t getSizeInBytes() const override;
 
   private:
     ClipId clipId_;
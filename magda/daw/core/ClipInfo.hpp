@@ -6,21 +6,12 @@
 #include <vector>
 
 #include "ClipTypes.hpp"
+#include "MidiNoteList.hpp"
 #include "TrackTypes.hpp"
 #include "TypeIds.hpp"
 
 namespace magda {
 
-/**
- * @brief MIDI note data for MIDI clips
- */
-struct MidiNote {
-    int noteNumber = 60;       // MIDI note number (0-127)
-    int velocity = 100;        // Note velocity (0-127)
-    double startBeat = 0.0;    // Start position in beats within clip
-    double lengthBeats = 1.0;  // Duration in beats
-};
-
 /**
  * @brief Audio source block within an audio clip
  *
@@ -57,8 +48,8 @@ struct ClipInfo {
     // Audio-specific properties
     std::vector<AudioSource> audioSources;
 
-    // MIDI-specific properties
-    std::vector<MidiNote> midiNotes;
+    // MIDI-specific properties (decoded on first access when loaded from a project)
+    MidiNoteList midiNotes;
 
     // Session view properties
     int sceneIndex = -1;     // -1 = not in session view (arrangement only)
@@ -0,0 +1,118 @@
+#include "ClipIntervalIndex.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace magda {
+
+namespace {
+
+bool entryLess(const ClipIntervalIndex::Entry& a, const ClipIntervalIndex::Entry& b) {
+    if (a.startTime != b.startTime) {
+        return a.startTime < b.startTime;
+    }
+    return a.clipId < b.clipId;
+}
+
+}  // namespace
+
+void ClipIntervalIndex::build(std::vector<Entry> entries) {
+    entries_ = std::move(entries);
+    std::sort(entries_.begin(), entries_.end(), entryLess);
+    maxEndDirty_ = true;
+}
+
+void ClipIntervalIndex::insert(const Entry& entry) {
+    // Appending in time order (recording, project load) avoids the move
+    auto pos = entries_.empty() || !entryLess(entry, entries_.back())
+                   ? entries_.end()
+                   : std::lower_bound(entries_.begin(), entries_.end(), entry, entryLess);
+    entries_.insert(pos, entry);
+    maxEndDirty_ = true;
+}
+
+bool ClipIntervalIndex::remove(ClipId clipId, double startTime) {
+    Entry key;
+    key.startTime = startTime;
+    key.clipId = clipId;
+
+    auto it = std::lower_bound(entries_.begin(), entries_.end(), key, entryLess);
+    if (it == entries_.end() || it->clipId != clipId) {
+        return false;
+    }
+
+    entries_.erase(it);
+    maxEndDirty_ = true;
+    return true;
+}
+
+void ClipIntervalIndex::clear() {
+    entries_.clear();
+    maxEnd_.clear();
+    maxEndDirty_ = false;
+}
+
+void ClipIntervalIndex::getOverlapping(double startTime, double endTime,
+                                       std::vector<ClipId>& results) const {
+    results.clear();
+    if (entries_.empty() || endTime <= startTime) {
+        return;
+    }
+
+    updateMaxEnd();
+    collect(0, entries_.size(), startTime, endTime, results);
+}
+
+void ClipIntervalIndex::getAt(double time, std::vector<ClipId>& results) const {
+    // start < nextafter(time) is start <= time
+    getOverlapping(time, std::nextafter(time, std::numeric_limits<double>::infinity()), results);
+}
+
+void ClipIntervalIndex::updateMaxEnd() const {
+    if (!maxEndDirty_) {
+        return;
+    }
+    maxEnd_.resize(entries_.size());
+    buildMaxEnd(0, entries_.size());
+    maxEndDirty_ = false;
+}
+
+double ClipIntervalIndex::buildMaxEnd(size_t lo, size_t hi) const {
+    if (lo >= hi) {
+        return -std::numeric_limits<double>::infinity();
+    }
+    size_t mid = lo + (hi - lo) / 2;
+    double maxEnd =
+        std::max({entries_[mid].endTime, buildMaxEnd(lo, mid), buildMaxEnd(mid + 1, hi)});
+    maxEnd_[mid] = maxEnd;
+    return maxEnd;
+}
+
+void ClipIntervalIndex::collect(size_t lo, size_t hi, double startTime, double endTime,
+                                std::vector<ClipId>& results) const {
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+
+        // Nothing in this subtree reaches the query
+        if (maxEnd_[mid] <= startTime) {
+            return;
+        }
+
+        collect(lo, mid, startTime, endTime, results);
+
+        // Everything from here on starts after the query
+        const auto& entry = entries_[mid];
+        if (entry.startTime >= endTime) {
+            return;
+        }
+        if (entry.endTime > startTime) {
+            results.push_back(entry.clipId);
+        }
+
+        // Right subtree, iteratively
+        lo = mid + 1;
+    }
+}
+
+}  // namespace magda
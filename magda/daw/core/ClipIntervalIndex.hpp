@@ -0,0 +1,82 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "ClipTypes.hpp"
+
+namespace magda {
+
+/**
+ * @brief Time index over the clips of one track
+ *
+ * Entries are kept sorted by start time, so a track's clips can be listed in order
+ * without sorting. Overlap queries treat the sorted array as an implicit balanced tree
+ * where every node also stores the latest end time beneath it, so subtrees that end
+ * before the query are skipped: O(log n + k) for k results, however long the clips are.
+ *
+ * Edits are O(n) moves within the array; the end-time tree is refreshed lazily on the
+ * next query, so a batch of edits pays for it once. Message thread only.
+ */
+class ClipIntervalIndex {
+  public:
+    struct Entry {
+        double startTime = 0.0;
+        double endTime = 0.0;
+        ClipId clipId = INVALID_CLIP_ID;
+    };
+
+    /**
+     * @brief Replace the contents (entries need not be sorted)
+     */
+    void build(std::vector<Entry> entries);
+
+    void insert(const Entry& entry);
+
+    /**
+     * @brief Remove a clip, given the start time it was inserted with
+     * @return false if it wasn't found
+     */
+    bool remove(ClipId clipId, double startTime);
+
+    void clear();
+
+    size_t size() const {
+        return entries_.size();
+    }
+
+    bool empty() const {
+        return entries_.empty();
+    }
+
+    /**
+     * @brief All entries, ordered by start time (ties by clip ID)
+     */
+    const std::vector<Entry>& getEntries() const {
+        return entries_;
+    }
+
+    /**
+     * @brief Clips overlapping [startTime, endTime), in start order
+     */
+    void getOverlapping(double startTime, double endTime, std::vector<ClipId>& results) const;
+
+    /**
+     * @brief Clips containing a time (start <= time < end), in start order
+     */
+    void getAt(double time, std::vector<ClipId>& results) const;
+
+  private:
+    std::vector<Entry> entries_;
+
+    // maxEnd_[mid] is the latest end time in the subtree rooted at mid
+    mutable std::vector<double> maxEnd_;
+    mutable bool maxEndDirty_ = false;
+
+    void updateMaxEnd() const;
+    double buildMaxEnd(size_t lo, size_t hi) const;
+    void collect(size_t lo, size_t hi, double startTime, double endTime,
+                 std::vector<ClipId>& results) const;
+};
+
+}  // namespace magda
@@ -27,7 +27,7 @@ ClipId ClipManager::createAudioClip(TrackId trackId, double startTime, double le
     clip.length = length;
     clip.audioSources.push_back(AudioSource{audioFilePath, 0.0, 0.0, length});
 
-    clips_.push_back(clip);
+    addClip(clip);
     notifyClipsChanged();
 
     DBG("Created audio clip: " << clip.name << " (id=" << clip.id << ", track=" << trackId << ")");
@@ -44,7 +44,7 @@ ClipId ClipManager::createMidiClip(TrackId trackId, double startTime, double len
     clip.startTime = startTime;
     clip.length = length;
 
-    clips_.push_back(clip);
+    addClip(clip);
     notifyClipsChanged();
 
     DBG("Created MIDI clip: " << clip.name << " (id=" << clip.id << ", track=" << trackId << ")");
@@ -52,11 +52,8 @@ ClipId ClipManager::createMidiClip(TrackId trackId, double startTime, double len
 }
 
 void ClipManager::deleteClip(ClipId clipId) {
-    auto it = std::find_if(clips_.begin(), clips_.end(),
-                           [clipId](const ClipInfo& c) { return c.id == clipId; });
-
-    if (it != clips_.end()) {
-        DBG("Deleted clip: " << it->name << " (id=" << clipId << ")");
+    if (auto* clip = getClip(clipId)) {
+        DBG("Deleted clip: " << clip->name << " (id=" << clipId << ")");
 
         // Clear selection if this was selected
         if (selectedClipId_ == clipId) {
@@ -64,22 +61,19 @@ void ClipManager::deleteClip(ClipId clipId) {
             notifyClipSelectionChanged(INVALID_CLIP_ID);
         }
 
-        clips_.erase(it);
+        eraseClip(clipId);
         notifyClipsChanged();
     }
 }
 
 void ClipManager::restoreClip(const ClipInfo& clipInfo) {
     // Check if a clip with this ID already exists
-    auto it = std::find_if(clips_.begin(), clips_.end(),
-                           [&clipInfo](const ClipInfo& c) { return c.id == clipInfo.id; });
-
-    if (it != clips_.end()) {
+    if (getClip(clipInfo.id) != nullptr) {
         DBG("Warning: Clip with id=" << clipInfo.id << " already exists, skipping restore");
         return;
     }
 
-    clips_.push_back(clipInfo);
+    addClip(clipInfo);
 
     // Ensure nextClipId_ is beyond any restored clip IDs
     if (clipInfo.id >= nextClipId_) {
@@ -91,6 +85,8 @@ void ClipManager::restoreClip(const ClipInfo& clipInfo) {
 }
 
 void ClipManager::forceNotifyClipsChanged() {
+    // Callers may have edited any number of clips directly
+    rebuildIndex();
     notifyClipsChanged();
 }
 
@@ -99,20 +95,18 @@ void ClipManager::forceNotifyClipPropertyChanged(ClipId clipId) {
 }
 
 ClipId ClipManager::duplicateClip(ClipId clipId) {
-    auto it = std::find_if(clips_.begin(), clips_.end(),
-                           [clipId](const ClipInfo& c) { return c.id == clipId; });
-
-    if (it == clips_.end()) {
+    const auto* source = getClip(clipId);
+    if (!source) {
         return INVALID_CLIP_ID;
     }
 
-    ClipInfo newClip = *it;
+    ClipInfo newClip = *source;
     newClip.id = nextClipId_++;
-    newClip.name = it->name + " Copy";
+    newClip.name = source->name + " Copy";
     // Offset the duplicate slightly to the right
-    newClip.startTime = it->startTime + it->length;
+    newClip.startTime = source->startTime + source->length;
 
-    clips_.push_back(newClip);
+    addClip(newClip);
     notifyClipsChanged();
 
     DBG("Duplicated clip: " << newClip.name << " (id=" << newClip.id << ")");
@@ -120,16 +114,14 @@ ClipId ClipManager::duplicateClip(ClipId clipId) {
 }
 
 ClipId ClipManager::duplicateClipAt(ClipId clipId, double startTime, TrackId trackId) {
-    auto it = std::find_if(clips_.begin(), clips_.end(),
-                           [clipId](const ClipInfo& c) { return c.id == clipId; });
-
-    if (it == clips_.end()) {
+    const auto* source = getClip(clipId);
+    if (!source) {
         return INVALID_CLIP_ID;
     }
 
-    ClipInfo newClip = *it;
+    ClipInfo newClip = *source;
     newClip.id = nextClipId_++;
-    newClip.name = it->name + " Copy";
+    newClip.name = source->name + " Copy";
     newClip.startTime = startTime;
 
     // Use specified track or keep same track
@@ -137,7 +129,7 @@ ClipId ClipManager::duplicateClipAt(ClipId clipId, double startTime, TrackId tra
         newClip.trackId = trackId;
     }
 
-    clips_.push_back(newClip);
+    addClip(newClip);
     notifyClipsChanged();
 
     DBG("Duplicated clip at " << startTime << ": " << newClip.name << " (id=" << newClip.id << ")");
@@ -161,6 +153,7 @@ void ClipManager::moveClipToTrack(ClipId clipId, TrackId newTrackId) {
     if (auto* clip = getClip(clipId)) {
         if (clip->trackId != newTrackId) {
             clip->trackId = newTrackId;
+            notifyClipPropertyChanged(clipId);
             notifyClipsChanged();  // Track assignment change affects layout
         }
     }
@@ -212,7 +205,8 @@ ClipId ClipManager::splitClip(ClipId clipId, double splitTime) {
         clip->audioSources[0].length = leftLength;
     }
 
-    clips_.push_back(rightClip);
+    addClip(rightClip);
+    notifyClipPropertyChanged(clipId);
     notifyClipsChanged();
 
     DBG("Split clip " << clipId << " at " << splitTime << " -> new clip " << rightClip.id);
@@ -357,20 +351,30 @@ void ClipManager::moveAudioSource(ClipId clipId, int sourceIndex, double newPosi
     }
 }
 
-void ClipManager::addMidiNote(ClipId clipId, const MidiNote& note) {
+MidiNoteId ClipManager::addMidiNote(ClipId clipId, const MidiNote& note) {
     if (auto* clip = getClip(clipId)) {
         if (clip->type == ClipType::MIDI) {
-            clip->midiNotes.push_back(note);
+            auto noteId = clip->midiNotes.add(note);
             notifyClipPropertyChanged(clipId);
+            return noteId;
         }
     }
+    return INVALID_MIDI_NOTE_ID;
 }
 
-void ClipManager::removeMidiNote(ClipId clipId, int noteIndex) {
+bool ClipManager::updateMidiNote(ClipId clipId, const MidiNote& note) {
     if (auto* clip = getClip(clipId)) {
-        if (clip->type == ClipType::MIDI && noteIndex >= 0 &&
-            noteIndex < static_cast<int>(clip->midiNotes.size())) {
-            clip->midiNotes.erase(clip->midiNotes.begin() + noteIndex);
+        if (clip->type == ClipType::MIDI && clip->midiNotes.update(note)) {
+            notifyClipPropertyChanged(clipId);
+            return true;
+        }
+    }
+    return false;
+}
+
+void ClipManager::removeMidiNote(ClipId clipId, MidiNoteId noteId) {
+    if (auto* clip = getClip(clipId)) {
+        if (clip->type == ClipType::MIDI && clip->midiNotes.remove(noteId)) {
             notifyClipPropertyChanged(clipId);
         }
     }
@@ -390,49 +394,53 @@ void ClipManager::clearMidiNotes(ClipId clipId) {
 // ============================================================================
 
 ClipInfo* ClipManager::getClip(ClipId clipId) {
-    auto it = std::find_if(clips_.begin(), clips_.end(),
-                           [clipId](const ClipInfo& c) { return c.id == clipId; });
-    return (it != clips_.end()) ? &(*it) : nullptr;
+    auto it = clipLookup_.find(clipId);
+    return (it != clipLookup_.end()) ? &clips_[it->second.position] : nullptr;
 }
 
 const ClipInfo* ClipManager::getClip(ClipId clipId) const {
-    auto it = std::find_if(clips_.begin(), clips_.end(),
-                           [clipId](const ClipInfo& c) { return c.id == clipId; });
-    return (it != clips_.end()) ? &(*it) : nullptr;
+    auto it = clipLookup_.find(clipId);
+    return (it != clipLookup_.end()) ? &clips_[it->second.position] : nullptr;
 }
 
 std::vector<ClipId> ClipManager::getClipsOnTrack(TrackId trackId) const {
     std::vector<ClipId> result;
-    for (const auto& clip : clips_) {
-        if (clip.trackId == trackId) {
-            result.push_back(clip.id);
+    if (const auto* index = getTrackIndex(trackId)) {
+        result.reserve(index->size());
+        for (const auto& entry : index->getEntries()) {
+            result.push_back(entry.clipId);
         }
     }
-    // Sort by start time
-    std::sort(result.begin(), result.end(), [this](ClipId a, ClipId b) {
-        const auto* clipA = getClip(a);
-        const auto* clipB = getClip(b);
-        return clipA && clipB && clipA->startTime < clipB->startTime;
-    });
     return result;
 }
 
 ClipId ClipManager::getClipAtPosition(TrackId trackId, double time) const {
-    for (const auto& clip : clips_) {
-        if (clip.trackId == trackId && clip.containsTime(time)) {
-            return clip.id;
+    const auto* index = getTrackIndex(trackId);
+    if (!index) {
+        return INVALID_CLIP_ID;
+    }
+
+    std::vector<ClipId> candidates;
+    index->getAt(time, candidates);
+
+    // Overlapping clips resolve to the earliest created, as before
+    ClipId result = INVALID_CLIP_ID;
+    size_t resultPosition = clips_.size();
+    for (auto clipId : candidates) {
+        size_t position = clipLookup_.at(clipId).position;
+        if (position < resultPosition) {
+            result = clipId;
+            resultPosition = position;
         }
     }
-    return INVALID_CLIP_ID;
+    return result;
 }
 
 std::vector<ClipId> ClipManager::getClipsInRange(TrackId trackId, double startTime,
                                                  double endTime) const {
     std::vector<ClipId> result;
-    for (const auto& clip : clips_) {
-        if (clip.trackId == trackId && clip.overlaps(startTime, endTime)) {
-            result.push_back(clip.id);
-        }
+    if (const auto* index = getTrackIndex(trackId)) {
+        index->getOverlapping(startTime, endTime, result);
     }
     return result;
 }
@@ -460,9 +468,15 @@ void ClipManager::clearClipSelection() {
 // ============================================================================
 
 ClipId ClipManager::getClipInSlot(TrackId trackId, int sceneIndex) const {
-    for (const auto& clip : clips_) {
-        if (clip.trackId == trackId && clip.sceneIndex == sceneIndex) {
-            return clip.id;
+    const auto* index = getTrackIndex(trackId);
+    if (!index) {
+        return INVALID_CLIP_ID;
+    }
+
+    for (const auto& entry : index->getEntries()) {
+        const auto* clip = getClip(entry.clipId);
+        if (clip && clip->sceneIndex == sceneIndex) {
+            return clip->id;
         }
     }
     return INVALID_CLIP_ID;
@@ -477,25 +491,49 @@ void ClipManager::setClipSceneIndex(ClipId clipId, int sceneIndex) {
 
 void ClipManager::triggerClip(ClipId clipId) {
     if (auto* clip = getClip(clipId)) {
-        // Stop other clips on same track
-        for (auto& otherClip : clips_) {
-            if (otherClip.trackId == clip->trackId && otherClip.id != clipId) {
-                if (otherClip.isPlaying || otherClip.isQueued) {
-                    otherClip.isPlaying = false;
-                    otherClip.isQueued = false;
-                    notifyClipPlaybackStateChanged(otherClip.id);
+        // With a launch handler, the clip playing on the track keeps playing until the
+        // launch happens; only a competing queued launch is replaced
+        bool queueOnly = launchHandler_ != nullptr;
+
+        // Stop other clips on same track (copied: listeners may edit clips)
+        std::vector<ClipId> trackClips = getClipsOnTrack(clip->trackId);
+        for (auto otherId : trackClips) {
+            auto* otherClip = getClip(otherId);
+            if (!otherClip || otherId == clipId) {
+                continue;
+            }
+            if (queueOnly ? otherClip->isQueued : (otherClip->isPlaying || otherClip->isQueued)) {
+                otherClip->isQueued = false;
+                if (!queueOnly) {
+                    otherClip->isPlaying = false;
                 }
+                notifyClipPlaybackStateChanged(otherId);
             }
         }
 
+        clip = getClip(clipId);
+        if (!clip) {
+            return;
+        }
+
         clip->isQueued = true;
-        clip->isPlaying = true;  // For now, immediate trigger
+        if (!queueOnly) {
+            clip->isPlaying = true;
+        }
         notifyClipPlaybackStateChanged(clipId);
+
+        if (queueOnly) {
+            launchHandler_->launchClip(clipId, clip->trackId, launchQuantization_);
+        }
     }
 }
 
 void ClipManager::stopClip(ClipId clipId) {
     if (auto* clip = getClip(clipId)) {
+        if (launchHandler_ != nullptr) {
+            launchHandler_->stopClip(clipId, clip->trackId, launchQuantization_);
+            return;
+        }
         clip->isPlaying = false;
         clip->isQueued = false;
         notifyClipPlaybackStateChanged(clipId);
@@ -503,6 +541,10 @@ void ClipManager::stopClip(ClipId clipId) {
 }
 
 void ClipManager::stopAllClips() {
+    if (launchHandler_ != nullptr) {
+        launchHandler_->stopAllClips(launchQuantization_);
+        return;
+    }
     for (auto& clip : clips_) {
         if (clip.isPlaying || clip.isQueued) {
             clip.isPlaying = false;
@@ -512,6 +554,30 @@ void ClipManager::stopAllClips() {
     }
 }
 
+void ClipManager::markClipLaunched(ClipId clipId) {
+    if (auto* clip = getClip(clipId)) {
+        clip->isPlaying = true;
+        clip->isQueued = false;
+        notifyClipPlaybackStateChanged(clipId);
+    }
+}
+
+void ClipManager::markClipStopped(ClipId clipId) {
+    if (auto* clip = getClip(clipId)) {
+        clip->isPlaying = false;
+        clip->isQueued = false;
+        notifyClipPlaybackStateChanged(clipId);
+    }
+}
+
+void ClipManager::markClipLaunchCancelled(ClipId clipId) {
+    auto* clip = getClip(clipId);
+    if (clip && clip->isQueued) {
+        clip->isQueued = false;
+        notifyClipPlaybackStateChanged(clipId);
+    }
+}
+
 // ============================================================================
 // Listener Management
 // ============================================================================
@@ -531,12 +597,34 @@ void ClipManager::removeListener(ClipManagerListener* listener) {
 // ============================================================================
 
 void ClipManager::clearAllClips() {
+    // Clip IDs are reused from 1, so nothing launched for the old clips may keep playing
+    if (launchHandler_ != nullptr) {
+        launchHandler_->stopAllClips(LaunchQuantization::None);
+    }
     clips_.clear();
+    rebuildIndex();
     selectedClipId_ = INVALID_CLIP_ID;
     nextClipId_ = 1;
     notifyClipsChanged();
 }
 
+void ClipManager::loadClips(std::vector<ClipInfo> clips) {
+    // Clip IDs are reused from 1, so nothing launched for the old clips may keep playing
+    if (launchHandler_ != nullptr) {
+        launchHandler_->stopAllClips(LaunchQuantization::None);
+    }
+    clips_ = std::move(clips);
+    rebuildIndex();
+    selectedClipId_ = INVALID_CLIP_ID;
+
+    nextClipId_ = 1;
+    for (const auto& clip : clips_) {
+        nextClipId_ = std::max(nextClipId_, clip.id + 1);
+    }
+
+    notifyClipsChanged();
+}
+
 void ClipManager::createTestClips() {
     // Create random test clips on existing tracks for development
     auto& trackManager = TrackManager::getInstance();
@@ -574,7 +662,106 @@ void ClipManager::createTestClips() {
 // Private Helpers
 // ============================================================================
 
+void ClipManager::addClip(ClipInfo clip) {
+    IndexedClip indexed;
+    indexed.position = clips_.size();
+    indexed.trackId = clip.trackId;
+    indexed.startTime = clip.startTime;
+    indexed.endTime = clip.getEndTime();
+
+    trackIndices_[clip.trackId].insert({indexed.startTime, indexed.endTime, clip.id});
+    clipLookup_[clip.id] = indexed;
+    if (auto* changes = ModelTransactionManager::getInstance().getPendingChanges()) {
+        changes->clips.add(clip.id);
+    }
+    clips_.push_back(std::move(clip));
+}
+
+void ClipManager::eraseClip(ClipId clipId) {
+    auto it = clipLookup_.find(clipId);
+    if (it == clipLookup_.end()) {
+        return;
+    }
+
+    auto indexed = it->second;
+    clipLookup_.erase(it);
+    if (auto* changes = ModelTransactionManager::getInstance().getPendingChanges()) {
+        changes->clips.remove(clipId);
+    }
+    auto trackIt = trackIndices_.find(indexed.trackId);
+    if (trackIt != trackIndices_.end()) {
+        trackIt->second.remove(clipId, indexed.startTime);
+        if (trackIt->second.empty()) {
+            trackIndices_.erase(trackIt);
+        }
+    }
+
+    // Later clips shift down one place
+    clips_.erase(clips_.begin() + static_cast<std::ptrdiff_t>(indexed.position));
+    for (size_t i = indexed.position; i < clips_.size(); ++i) {
+        clipLookup_[clips_[i].id].position = i;
+    }
+}
+
+void ClipManager::reindexClip(ClipId clipId) {
+    auto it = clipLookup_.find(clipId);
+    if (it == clipLookup_.end()) {
+        return;
+    }
+
+    auto& indexed = it->second;
+    const auto& clip = clips_[indexed.position];
+    if (clip.trackId == indexed.trackId && clip.startTime == indexed.startTime &&
+        clip.getEndTime() == indexed.endTime) {
+        return;  // Name, colour, content etc. don't affect the index
+    }
+
+    auto trackIt = trackIndices_.find(indexed.trackId);
+    if (trackIt != trackIndices_.end()) {
+        trackIt->second.remove(clipId, indexed.startTime);
+        if (trackIt->second.empty()) {
+            trackIndices_.erase(trackIt);
+        }
+    }
+
+    indexed.trackId = clip.trackId;
+    indexed.startTime = clip.startTime;
+    indexed.endTime = clip.getEndTime();
+    trackIndices_[clip.trackId].insert({indexed.startTime, indexed.endTime, clipId});
+}
+
+void ClipManager::rebuildIndex() {
+    clipLookup_.clear();
+    trackIndices_.clear();
+
+    std::unordered_map<TrackId, std::vector<ClipIntervalIndex::Entry>> entriesByTrack;
+    for (size_t i = 0; i < clips_.size(); ++i) {
+        const auto& clip = clips_[i];
+        IndexedClip indexed;
+        indexed.position = i;
+        indexed.trackId = clip.trackId;
+        indexed.startTime = clip.startTime;
+        indexed.endTime = clip.getEndTime();
+        clipLookup_[clip.id] = indexed;
+        entriesByTrack[clip.trackId].push_back({indexed.startTime, indexed.endTime, clip.id});
+    }
+
+    for (auto& [trackId, entries] : entriesByTrack) {
+        trackIndices_[trackId].build(std::move(entries));
+    }
+}
+
+const ClipIntervalIndex* ClipManager::getTrackIndex(TrackId trackId) const {
+    auto it = trackIndices_.find(trackId);
+    return it != trackIndices_.end() ? &it->second : nullptr;
+}
+
 void ClipManager::notifyClipsChanged() {
+    if (auto* changes = ModelTransactionManager::getInstance().getPendingChanges()) {
+        changes->clipListChanged = true;
+        return;
+    }
+
     // Make a copy because listeners may be removed during iteration
     // (e.g., ClipComponent destroyed when TrackContentPanel rebuilds)
     auto listenersCopy = listeners_;
@@ -586,6 +773,13 @@ void ClipManager::notifyClipsChanged() {
 }
 
 void ClipManager::notifyClipPropertyChanged(ClipId clipId) {
+    // Moves and resizes (including direct edits) reach the index here
+    reindexClip(clipId);
+    if (auto* changes = ModelTransactionManager::getInstance().getPendingChanges()) {
+        changes->clips.modify(clipId);
+        return;
+    }
+
     auto listenersCopy = listeners_;
     for (auto* listener : listenersCopy) {
         if (std::find(listeners_.begin(), listeners_.end(), listener) != listeners_.end()) {
@@ -594,6 +788,15 @@ void ClipManager::notifyClipPropertyChanged(ClipId clipId) {
     }
 }
 
+void ClipManager::notifyChangesCommitted(const ModelChangeSet& changes) {
+    auto listenersCopy = listeners_;
+    for (auto* listener : listenersCopy) {
+        if (std::find(listeners_.begin(), listeners_.end(), listener) != listeners_.end()) {
+            listener->clipChangesCommitted(changes);
+        }
+    }
+}
+
 void ClipManager::notifyClipSelectionChanged(ClipId clipId) {
     auto listenersCopy = listeners_;
     for (auto* listener : listenersCopy) {
@@ -1,11 +1,14 @@
 #pragma once
 
 #include <memory>
+#include <unordered_map>
 #include <vector>
 
 #include "ClipInfo.hpp"
+#include "ClipIntervalIndex.hpp"
 #include "ClipOperations.hpp"
 #include "ClipTypes.hpp"
+#include "ModelTransaction.hpp"
 #include "TrackTypes.hpp"
 
 namespace magda {
@@ -39,12 +42,44 @@ class ClipManagerListener {
     virtual void clipDragPreview(ClipId clipId, double previewStartTime, double previewLength) {
         juce::ignoreUnused(clipId, previewStartTime, previewLength);
     }
+
+    // Called once when a model transaction commits, in place of the clipsChanged() and
+    // clipPropertyChanged() calls it deferred. Replays them by default.
+    virtual void clipChangesCommitted(const ModelChangeSet& changes) {
+        if (changes.clipListChanged) {
+            clipsChanged();
+        }
+        for (auto clipId : changes.clips.modified) {
+            clipPropertyChanged(clipId);
+        }
+    }
+};
+
+/**
+ * @brief Carries out session clip launches in the audio engine
+ *
+ * When set on the ClipManager, triggered clips are only marked as queued; the handler
+ * confirms through markClipLaunched() / markClipStopped() once the launch has happened.
+ */
+class ClipLaunchHandler {
+  public:
+    virtual ~ClipLaunchHandler() = default;
+
+    virtual void launchClip(ClipId clipId, TrackId trackId, LaunchQuantization quantization) = 0;
+    virtual void stopClip(ClipId clipId, TrackId trackId, LaunchQuantization quantization) = 0;
+    virtual void stopAllClips(LaunchQuantization quantization) = 0;
 };
 
 /**
  * @brief Singleton manager for all clips in the project
  *
  * Provides CRUD operations for clips and notifies listeners of changes.
+ *
+ * Clips are looked up by ID in constant time, and each track keeps a time index
+ * (ClipIntervalIndex) so per-track queries don't scan the project. Code that changes a
+ * clip's track, start or length directly through getClip() must call
+ * forceNotifyClipPropertyChanged() (or forceNotifyClipsChanged()) afterwards, which also
+ * brings the index up to date.
  */
 class ClipManager {
   public:
@@ -60,6 +95,7 @@ class ClipManager {
      */
     void shutdown() {
         clips_.clear();  // Clear JUCE objects before JUCE cleanup
+        rebuildIndex();
     }
 
     // ========================================================================
@@ -89,6 +125,10 @@ class ClipManager {
 
     /**
      * @brief Force a clips changed notification (used by undo system)
+     *
+     * Says only that the list changed, not which clips did. Listeners that follow clip
+     * content (the autosave journal) need forceNotifyClipPropertyChanged() for each
+     * clip edited directly.
      */
     void forceNotifyClipsChanged();
 
@@ -220,9 +260,19 @@ class ClipManager {
      */
     void moveAudioSource(ClipId clipId, int sourceIndex, double newPosition);
 
-    // MIDI-specific
-    void addMidiNote(ClipId clipId, const MidiNote& note);
-    void removeMidiNote(ClipId clipId, int noteIndex);
+    // MIDI-specific (notes are addressed by id, see MidiNoteList)
+
+    /**
+     * @brief Add a note at its sorted position
+     * @return The note's id, or INVALID_MIDI_NOTE_ID if the clip is not a MIDI clip
+     */
+    MidiNoteId addMidiNote(ClipId clipId, const MidiNote& note);
+
+    /**
+     * @brief Replace the note with note.id (false if the clip has no such note)
+     */
+    bool updateMidiNote(ClipId clipId, const MidiNote& note);
+    void removeMidiNote(ClipId clipId, MidiNoteId noteId);
     void clearMidiNotes(ClipId clipId);
 
     // ========================================================================
@@ -237,7 +287,7 @@ class ClipManager {
     const ClipInfo* getClip(ClipId clipId) const;
 
     /**
-     * @brief Get all clips on a specific track
+     * @brief Get all clips on a specific track, ordered by start time
      */
     std::vector<ClipId> getClipsOnTrack(TrackId trackId) const;
 
@@ -248,7 +298,7 @@ class ClipManager {
     ClipId getClipAtPosition(TrackId trackId, double time) const;
 
     /**
-     * @brief Get clips that overlap with a time range on a track
+     * @brief Get clips that overlap with a time range on a track, ordered by start time
      */
     std::vector<ClipId> getClipsInRange(TrackId trackId, double startTime, double endTime) const;
 
@@ -283,6 +333,27 @@ class ClipManager {
     void stopClip(ClipId clipId);
     void stopAllClips();
 
+    /**
+     * @brief Route session launches through the audio engine (nullptr: take effect at once)
+     */
+    void setLaunchHandler(ClipLaunchHandler* handler) {
+        launchHandler_ = handler;
+    }
+
+    void setLaunchQuantization(LaunchQuantization quantization) {
+        launchQuantization_ = quantization;
+    }
+    LaunchQuantization getLaunchQuantization() const {
+        return launchQuantization_;
+    }
+
+    /**
+     * @brief Launch handler confirmations; unknown clip IDs are ignored
+     */
+    void markClipLaunched(ClipId clipId);
+    void markClipStopped(ClipId clipId);
+    void markClipLaunchCancelled(ClipId clipId);
+
     // ========================================================================
     // Listener Management
     // ========================================================================
@@ -301,6 +372,11 @@ class ClipManager {
 
     void clearAllClips();
 
+    /**
+     * @brief Replace all clips (project load), notifying listeners once
+     */
+    void loadClips(std::vector<ClipInfo> clips);
+
     /**
      * @brief Create random test clips for development
      */
@@ -314,6 +390,25 @@ class ClipManager {
     std::vector<ClipManagerListener*> listeners_;
     int nextClipId_ = 1;
     ClipId selectedClipId_ = INVALID_CLIP_ID;
+    ClipLaunchHandler* launchHandler_ = nullptr;
+    LaunchQuantization launchQuantization_ = LaunchQuantization::Bar;
+
+    // Where each clip lives in clips_, and the span it was last indexed with
+    struct IndexedClip {
+        size_t position = 0;
+        TrackId trackId = INVALID_TRACK_ID;
+        double startTime = 0.0;
+        double endTime = 0.0;
+    };
+    std::unordered_map<ClipId, IndexedClip> clipLookup_;
+    std::unordered_map<TrackId, ClipIntervalIndex> trackIndices_;
+
+    // Index maintenance
+    void addClip(ClipInfo clip);
+    void eraseClip(ClipId clipId);
+    void reindexClip(ClipId clipId);
+    void rebuildIndex();
+    const ClipIntervalIndex* getTrackIndex(TrackId trackId) const;
 
     // Notification helpers
     void notifyClipsChanged();
@@ -321,6 +416,9 @@ class ClipManager {
     void notifyClipSelectionChanged(ClipId clipId);
     void notifyClipPlaybackStateChanged(ClipId clipId);
 
+    friend class ModelTransactionManager;
+    void notifyChangesCommitted(const ModelChangeSet& changes);
+
     // Helper to generate unique clip name
     juce::String generateClipName(ClipType type) const;
 };
@@ -16,6 +16,15 @@ enum class ClipType {
     MIDI    // MIDI note data
 };
 
+/**
+ * @brief Where a session clip launch or stop takes effect
+ */
+enum class LaunchQuantization {
+    None,  // At once (start of the next audio block)
+    Beat,  // Next beat
+    Bar    // Next bar line
+};
+
 /**
  * @brief Get display name for clip type
  */
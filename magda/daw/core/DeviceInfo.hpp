@@ -5,6 +5,7 @@
 #include "MacroInfo.hpp"
 #include "ModInfo.hpp"
 #include "ParameterInfo.hpp"
+#include "ParameterList.hpp"
 #include "TypeIds.hpp"
 
 namespace magda {
@@ -14,6 +15,14 @@ namespace magda {
  */
 enum class PluginFormat { VST3, AU, VST, Internal };
 
+/**
+ * @brief Engine-side load state of a device
+ *
+ * External plugins are instantiated once their binaries have been prefetched; until
+ * then the device is a placeholder in the track chain.
+ */
+enum class DeviceLoadState { Ready, Loading, Failed };
+
 /**
  * @brief Device/plugin information stored on a track
  */
@@ -30,6 +39,7 @@ struct DeviceInfo {
     juce::String fileOrIdentifier;  // Path to plugin file or AU identifier
 
     bool bypassed = false;  // Device bypass state
+    DeviceLoadState loadState = DeviceLoadState::Ready;  // Runtime only, not saved
     bool expanded = true;   // UI expanded state
 
     // UI panel visibility states
@@ -37,8 +47,8 @@ struct DeviceInfo {
     bool gainPanelOpen = false;   // Gain panel visible
     bool paramPanelOpen = false;  // Parameter panel visible
 
-    // Device parameters (populated by DeviceProcessor)
-    std::vector<ParameterInfo> parameters;
+    // Device parameters (populated by DeviceProcessor, materialised per page)
+    ParameterList parameters;
 
     // User-selected visible parameters (indices into plugin parameter list)
     // If empty, show first N parameters; otherwise show these specific indices
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <cstddef>
+#include <unordered_map>
+#include <vector>
+
+namespace magda {
+
+/**
+ * @brief ID -> position table for a dense std::vector of items with an `id` member
+ *
+ * The managers keep their items in plain vectors (ordered, contiguous, handed out by
+ * const reference) and use this alongside for O(1) lookup by ID. IDs are never reused
+ * while their item exists, so an ID whose item was removed simply isn't found.
+ *
+ * The owner keeps the two in step: add() after appending, erase() to remove, and
+ * rebuild() after anything that reorders or replaces the vector.
+ */
+template <typename Id>
+class IdIndex {
+  public:
+    static constexpr size_t npos = static_cast<size_t>(-1);
+
+    /**
+     * @brief Position of an ID in the vector, or npos if it isn't there
+     */
+    size_t find(Id id) const {
+        auto it = positions_.find(id);
+        return it != positions_.end() ? it->second : npos;
+    }
+
+    bool contains(Id id) const {
+        return positions_.count(id) != 0;
+    }
+
+    template <typename T>
+    T* lookup(std::vector<T>& items, Id id) const {
+        size_t position = find(id);
+        return position != npos ? &items[position] : nullptr;
+    }
+
+    template <typename T>
+    const T* lookup(const std::vector<T>& items, Id id) const {
+        size_t position = find(id);
+        return position != npos ? &items[position] : nullptr;
+    }
+
+    /**
+     * @brief Record an item just appended to the vector
+     */
+    void add(Id id, size_t position) {
+        positions_[id] = position;
+    }
+
+    /**
+     * @brief Remove an item from the vector, keeping the order of the rest
+     * @return false if the ID wasn't present
+     */
+    template <typename T>
+    bool erase(std::vector<T>& items, Id id) {
+        auto it = positions_.find(id);
+        if (it == positions_.end()) {
+            return false;
+        }
+
+        size_t position = it->second;
+        positions_.erase(it);
+        items.erase(items.begin() + static_cast<std::ptrdiff_t>(position));
+        for (size_t i = position; i < items.size(); ++i) {
+            positions_[items[i].id] = i;
+        }
+        return true;
+    }
+
+    template <typename T>
+    void rebuild(const std::vector<T>& items) {
+        positions_.clear();
+        positions_.reserve(items.size());
+        for (size_t i = 0; i < items.size(); ++i) {
+            positions_[items[i].id] = i;
+        }
+    }
+
+    void clear() {
+        positions_.clear();
+    }
+
+    size_t size() const {
+        return positions_.size();
+    }
+
+  private:
+    std::unordered_map<Id, size_t> positions_;
+};
+
+}  // namespace magda
@@ -0,0 +1,232 @@
+#pragma once
+
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace magda {
+
+/**
+ * @brief How a LazyArray duplicates a shared buffer before writing to it
+ *
+ * Specialised for element types that are not copyable (see ChainElement).
+ */
+template <typename T>
+struct LazyArrayTraits {
+    static std::vector<T> copy(const std::vector<T>& items) {
+        return items;
+    }
+};
+
+/**
+ * @brief Copy-on-write std::vector stand-in whose contents can be decoded on first access
+ *
+ * Used for the bulky model arrays (MIDI notes, automation points, track chains).
+ *
+ * Copies share one buffer until either side asks for mutable access, so the snapshots
+ * held by undo commands cost nothing while they match the live model (see UndoManager).
+ * Any non-const access detaches a shared buffer first, which invalidates iterators and
+ * pointers previously taken from it; do not hold on to element pointers across edits.
+ *
+ * Opening a project only decodes the arrays something actually looks at (see
+ * ProjectFile). A deferred array knows its size up front; the first access to its
+ * elements runs the loader once, after which the loader (and whatever it keeps alive)
+ * is released. Arrays built in code (push_back, assignment from a vector) are never
+ * deferred.
+ *
+ * Not thread-safe: const access may run the loader (message thread only).
+ */
+template <typename T>
+class LazyArray {
+  public:
+    using Loader = std::function<std::vector<T>()>;
+    using value_type = T;
+    using iterator = typename std::vector<T>::iterator;
+    using const_iterator = typename std::vector<T>::const_iterator;
+
+    LazyArray() = default;
+
+    LazyArray(std::vector<T> items)
+        : items_(std::make_shared<std::vector<T>>(std::move(items))) {}
+
+    LazyArray(std::initializer_list<T> items) : items_(std::make_shared<std::vector<T>>(items)) {}
+
+    /**
+     * @brief Deferred array of count elements, produced by loader on first access
+     */
+    static LazyArray deferred(size_t count, Loader loader) {
+        LazyArray array;
+        if (count > 0 && loader) {
+            array.pendingCount_ = count;
+            array.loader_ = std::move(loader);
+        }
+        return array;
+    }
+
+    bool isMaterialised() const {
+        return !loader_;
+    }
+
+    // Size queries never run the loader
+    size_t size() const {
+        return loader_ ? pendingCount_ : (items_ ? items_->size() : 0);
+    }
+
+    bool empty() const {
+        return size() == 0;
+    }
+
+    /**
+     * @brief True if another copy currently shares this array's buffer
+     */
+    bool isShared() const {
+        return items_ && items_.use_count() > 1;
+    }
+
+    bool sharesBufferWith(const LazyArray& other) const {
+        return items_ && items_ == other.items_;
+    }
+
+    /**
+     * @brief Give this array a buffer of its own if it shares one
+     *
+     * For copies that join the live model rather than serving as a snapshot. A deferred
+     * array is left deferred: each copy runs the loader into a buffer of its own anyway.
+     */
+    void unshare() {
+        if (!loader_ && isShared()) {
+            detach();
+        }
+    }
+
+    std::vector<T>& items() {
+        materialise();
+        detach();
+        return *items_;
+    }
+
+    const std::vector<T>& items() const {
+        materialise();
+        if (!items_) {
+            static const std::vector<T> empty;
+            return empty;
+        }
+        return *items_;
+    }
+
+    operator std::vector<T>&() {
+        return items();
+    }
+
+    operator const std::vector<T>&() const {
+        return items();
+    }
+
+    // ========================================================================
+    // std::vector interface
+    // ========================================================================
+
+    T& operator[](size_t index) {
+        return items()[index];
+    }
+
+    const T& operator[](size_t index) const {
+        return items()[index];
+    }
+
+    iterator begin() {
+        return items().begin();
+    }
+    iterator end() {
+        return items().end();
+    }
+    const_iterator begin() const {
+        return items().begin();
+    }
+    const_iterator end() const {
+        return items().end();
+    }
+
+    T& front() {
+        return items().front();
+    }
+    T& back() {
+        return items().back();
+    }
+    const T& front() const {
+        return items().front();
+    }
+    const T& back() const {
+        return items().back();
+    }
+
+    void push_back(T item) {
+        items().push_back(std::move(item));
+    }
+
+    // Positions may come from before a detach, so they are rebased onto the written buffer
+
+    iterator insert(const_iterator pos, T item) {
+        auto index = indexOf(pos);
+        auto& written = items();
+        return written.insert(written.begin() + index, std::move(item));
+    }
+
+    iterator erase(const_iterator pos) {
+        auto index = indexOf(pos);
+        auto& written = items();
+        return written.erase(written.begin() + index);
+    }
+
+    iterator erase(const_iterator first, const_iterator last) {
+        auto firstIndex = indexOf(first);
+        auto lastIndex = indexOf(last);
+        auto& written = items();
+        return written.erase(written.begin() + firstIndex, written.begin() + lastIndex);
+    }
+
+    void reserve(size_t capacity) {
+        items().reserve(capacity);
+    }
+
+    void clear() {
+        loader_ = nullptr;
+        pendingCount_ = 0;
+        items_.reset();
+    }
+
+  private:
+    void materialise() const {
+        if (!loader_) {
+            return;
+        }
+
+        // Release the loader before running it so a throwing loader is not retried
+        auto loader = std::move(loader_);
+        loader_ = nullptr;
+        pendingCount_ = 0;
+        items_ = std::make_shared<std::vector<T>>(loader());
+    }
+
+    void detach() {
+        if (!items_) {
+            items_ = std::make_shared<std::vector<T>>();
+        } else if (items_.use_count() > 1) {
+            items_ = std::make_shared<std::vector<T>>(LazyArrayTraits<T>::copy(*items_));
+        }
+    }
+
+    std::ptrdiff_t indexOf(const_iterator pos) const {
+        return std::distance(items().begin(), pos);
+    }
+
+    // Null until something is stored; shared between copies until one of them writes
+    mutable std::shared_ptr<std::vector<T>> items_;
+    mutable Loader loader_;
+    mutable size_t pendingCount_ = 0;
+};
+
+}  // namespace magda
@@ -1,9 +1,16 @@
 #include "MidiNoteCommands.hpp"
 
-#include <algorithm>
-
 namespace magda {
 
+namespace {
+
+const MidiNote* findNote(ClipId clipId, MidiNoteId noteId) {
+    const auto* clip = ClipManager::getInstance().getClip(clipId);
+    return clip && clip->type == ClipType::MIDI ? clip->midiNotes.find(noteId) : nullptr;
+}
+
+}  // namespace
+
 // ============================================================================
 // AddMidiNoteCommand
 // ============================================================================
@@ -25,11 +32,8 @@ void AddMidiNoteCommand::execute() {
         return;
     }
 
-    // Add note via ClipManager API
-    clipManager.addMidiNote(clipId_, note_);
-
-    // The note was added at the end, so its index is size - 1
-    insertedIndex_ = clip->midiNotes.size() - 1;
+    // Keeps the id from the first execution, so later commands still find the note
+    note_.id = clipManager.addMidiNote(clipId_, note_);
     executed_ = true;
 }
 
@@ -39,39 +43,34 @@ void AddMidiNoteCommand::undo() {
     }
 
     auto& clipManager = ClipManager::getInstance();
-    clipManager.removeMidiNote(clipId_, static_cast<int>(insertedIndex_));
+    clipManager.removeMidiNote(clipId_, note_.id);
 }
 
 // ============================================================================
 // MoveMidiNoteCommand
 // ============================================================================
 
-MoveMidiNoteCommand::MoveMidiNoteCommand(ClipId clipId, size_t noteIndex, double newStartBeat,
+MoveMidiNoteCommand::MoveMidiNoteCommand(ClipId clipId, MidiNoteId noteId, double newStartBeat,
                                          int newNoteNumber)
-    : clipId_(clipId),
-      noteIndex_(noteIndex),
-      newStartBeat_(newStartBeat),
-      newNoteNumber_(newNoteNumber) {
+    : clipId_(clipId), noteId_(noteId), newStartBeat_(newStartBeat), newNoteNumber_(newNoteNumber) {
     // Capture old values
-    const auto* clip = ClipManager::getInstance().getClip(clipId_);
-    if (clip && noteIndex_ < clip->midiNotes.size()) {
-        oldStartBeat_ = clip->midiNotes[noteIndex_].startBeat;
-        oldNoteNumber_ = clip->midiNotes[noteIndex_].noteNumber;
+    if (const auto* note = findNote(clipId_, noteId_)) {
+        oldStartBeat_ = note->startBeat;
+        oldNoteNumber_ = note->noteNumber;
     }
 }
 
 void MoveMidiNoteCommand::execute() {
-    auto& clipManager = ClipManager::getInstance();
-    auto* clip = clipManager.getClip(clipId_);
-
-    if (!clip || clip->type != ClipType::MIDI || noteIndex_ >= clip->midiNotes.size()) {
+    const auto* current = findNote(clipId_, noteId_);
+    if (!current) {
         return;
     }
 
-    clip->midiNotes[noteIndex_].startBeat = newStartBeat_;
-    clip->midiNotes[noteIndex_].noteNumber = newNoteNumber_;
-
-    clipManager.forceNotifyClipPropertyChanged(clipId_);
+    // The note moves to its new place in the clip's order but keeps its id
+    auto note = *current;
+    note.startBeat = newStartBeat_;
+    note.noteNumber = newNoteNumber_;
+    ClipManager::getInstance().updateMidiNote(clipId_, note);
     executed_ = true;
 }
 
@@ -80,22 +79,20 @@ void MoveMidiNoteCommand::undo() {
         return;
     }
 
-    auto& clipManager = ClipManager::getInstance();
-    auto* clip = clipManager.getClip(clipId_);
-
-    if (!clip || clip->type != ClipType::MIDI || noteIndex_ >= clip->midiNotes.size()) {
+    const auto* current = findNote(clipId_, noteId_);
+    if (!current) {
         return;
     }
 
-    clip->midiNotes[noteIndex_].startBeat = oldStartBeat_;
-    clip->midiNotes[noteIndex_].noteNumber = oldNoteNumber_;
-
-    clipManager.forceNotifyClipPropertyChanged(clipId_);
+    auto note = *current;
+    note.startBeat = oldStartBeat_;
+    note.noteNumber = oldNoteNumber_;
+    ClipManager::getInstance().updateMidiNote(clipId_, note);
 }
 
 bool MoveMidiNoteCommand::canMergeWith(const UndoableCommand* other) const {
     auto* otherMove = dynamic_cast<const MoveMidiNoteCommand*>(other);
-    return otherMove && otherMove->clipId_ == clipId_ && otherMove->noteIndex_ == noteIndex_;
+    return otherMove && otherMove->clipId_ == clipId_ && otherMove->noteId_ == noteId_;
 }
 
 void MoveMidiNoteCommand::mergeWith(const UndoableCommand* other) {
@@ -110,26 +107,24 @@ void MoveMidiNoteCommand::mergeWith(const UndoableCommand* other) {
 // ResizeMidiNoteCommand
 // ============================================================================
 
-ResizeMidiNoteCommand::ResizeMidiNoteCommand(ClipId clipId, size_t noteIndex, double newLengthBeats)
-    : clipId_(clipId), noteIndex_(noteIndex), newLengthBeats_(newLengthBeats) {
+ResizeMidiNoteCommand::ResizeMidiNoteCommand(ClipId clipId, MidiNoteId noteId,
+                                             double newLengthBeats)
+    : clipId_(clipId), noteId_(noteId), newLengthBeats_(newLengthBeats) {
     // Capture old value
-    const auto* clip = ClipManager::getInstance().getClip(clipId_);
-    if (clip && noteIndex_ < clip->midiNotes.size()) {
-        oldLengthBeats_ = clip->midiNotes[noteIndex_].lengthBeats;
+    if (const auto* note = findNote(clipId_, noteId_)) {
+        oldLengthBeats_ = note->lengthBeats;
     }
 }
 
 void ResizeMidiNoteCommand::execute() {
-    auto& clipManager = ClipManager::getInstance();
-    auto* clip = clipManager.getClip(clipId_);
-
-    if (!clip || clip->type != ClipType::MIDI || noteIndex_ >= clip->midiNotes.size()) {
+    const auto* current = findNote(clipId_, noteId_);
+    if (!current) {
         return;
     }
 
-    clip->midiNotes[noteIndex_].lengthBeats = newLengthBeats_;
-
-    clipManager.forceNotifyClipPropertyChanged(clipId_);
+    auto note = *current;
+    note.lengthBeats = newLengthBeats_;
+    ClipManager::getInstance().updateMidiNote(clipId_, note);
     executed_ = true;
 }
 
@@ -138,21 +133,19 @@ void ResizeMidiNoteCommand::undo() {
         return;
     }
 
-    auto& clipManager = ClipManager::getInstance();
-    auto* clip = clipManager.getClip(clipId_);
-
-    if (!clip || clip->type != ClipType::MIDI || noteIndex_ >= clip->midiNotes.size()) {
+    const auto* current = findNote(clipId_, noteId_);
+    if (!current) {
         return;
     }
 
-    clip->midiNotes[noteIndex_].lengthBeats = oldLengthBeats_;
-
-    clipManager.forceNotifyClipPropertyChanged(clipId_);
+    auto note = *current;
+    note.lengthBeats = oldLengthBeats_;
+    ClipManager::getInstance().updateMidiNote(clipId_, note);
 }
 
 bool ResizeMidiNoteCommand::canMergeWith(const UndoableCommand* other) const {
     auto* otherResize = dynamic_cast<const ResizeMidiNoteCommand*>(other);
-    return otherResize && otherResize->clipId_ == clipId_ && otherResize->noteIndex_ == noteIndex_;
+    return otherResize && otherResize->clipId_ == clipId_ && otherResize->noteId_ == noteId_;
 }
 
 void ResizeMidiNoteCommand::mergeWith(const UndoableCommand* other) {
@@ -166,66 +159,52 @@ void ResizeMidiNoteCommand::mergeWith(const UndoableCommand* other) {
 // DeleteMidiNoteCommand
 // ============================================================================
 
-DeleteMidiNoteCommand::DeleteMidiNoteCommand(ClipId clipId, size_t noteIndex)
-    : clipId_(clipId), noteIndex_(noteIndex) {
-    // Capture note data for undo
-    const auto* clip = ClipManager::getInstance().getClip(clipId_);
-    if (clip && noteIndex_ < clip->midiNotes.size()) {
-        deletedNote_ = clip->midiNotes[noteIndex_];
+DeleteMidiNoteCommand::DeleteMidiNoteCommand(ClipId clipId, MidiNoteId noteId)
+    : clipId_(clipId), noteId_(noteId) {
+    // Capture note data (including its id) for undo
+    if (const auto* note = findNote(clipId_, noteId_)) {
+        deletedNote_ = *note;
     }
 }
 
 void DeleteMidiNoteCommand::execute() {
     auto& clipManager = ClipManager::getInstance();
-    clipManager.removeMidiNote(clipId_, static_cast<int>(noteIndex_));
+    clipManager.removeMidiNote(clipId_, noteId_);
     executed_ = true;
 }
 
 void DeleteMidiNoteCommand::undo() {
-    if (!executed_) {
+    if (!executed_ || deletedNote_.id == INVALID_MIDI_NOTE_ID) {
         return;
     }
 
+    // Comes back in its sorted place under the same id
     auto& clipManager = ClipManager::getInstance();
-    auto* clip = clipManager.getClip(clipId_);
-
-    if (!clip || clip->type != ClipType::MIDI) {
-        return;
-    }
-
-    // Re-insert at original position (or at end if index is now out of range)
-    size_t insertPos = std::min(noteIndex_, clip->midiNotes.size());
-    clip->midiNotes.insert(clip->midiNotes.begin() + static_cast<std::ptrdiff_t>(insertPos),
-                           deletedNote_);
-
-    clipManager.forceNotifyClipPropertyChanged(clipId_);
+    clipManager.addMidiNote(clipId_, deletedNote_);
 }
 
 // ============================================================================
 // SetMidiNoteVelocityCommand
 // ============================================================================
 
-SetMidiNoteVelocityCommand::SetMidiNoteVelocityCommand(ClipId clipId, size_t noteIndex,
+SetMidiNoteVelocityCommand::SetMidiNoteVelocityCommand(ClipId clipId, MidiNoteId noteId,
                                                        int newVelocity)
-    : clipId_(clipId), noteIndex_(noteIndex), newVelocity_(newVelocity) {
+    : clipId_(clipId), noteId_(noteId), newVelocity_(newVelocity) {
     // Capture old value
-    const auto* clip = ClipManager::getInstance().getClip(clipId_);
-    if (clip && noteIndex_ < clip->midiNotes.size()) {
-        oldVelocity_ = clip->midiNotes[noteIndex_].velocity;
+    if (const auto* note = findNote(clipId_, noteId_)) {
+        oldVelocity_ = note->velocity;
     }
 }
 
 void SetMidiNoteVelocityCommand::execute() {
-    auto& clipManager = ClipManager::getInstance();
-    auto* clip = clipManager.getClip(clipId_);
-
-    if (!clip || clip->type != ClipType::MIDI || noteIndex_ >= clip->midiNotes.size()) {
+    const auto* current = findNote(clipId_, noteId_);
+    if (!current) {
         return;
     }
 
-    clip->midiNotes[noteIndex_].velocity = newVelocity_;
-
-    clipManager.forceNotifyClipPropertyChanged(clipId_);
+    auto note = *current;
+    note.velocity = newVelocity_;
+    ClipManager::getInstance().updateMidiNote(clipId_, note);
     executed_ = true;
 }
 
@@ -234,22 +213,19 @@ void SetMidiNoteVelocityCommand::undo() {
         return;
     }
 
-    auto& clipManager = ClipManager::getInstance();
-    auto* clip = clipManager.getClip(clipId_);
-
-    if (!clip || clip->type != ClipType::MIDI || noteIndex_ >= clip->midiNotes.size()) {
+    const auto* current = findNote(clipId_, noteId_);
+    if (!current) {
         return;
     }
 
-    clip->midiNotes[noteIndex_].velocity = oldVelocity_;
-
-    clipManager.forceNotifyClipPropertyChanged(clipId_);
+    auto note = *current;
+    note.velocity = oldVelocity_;
+    ClipManager::getInstance().updateMidiNote(clipId_, note);
 }
 
 bool SetMidiNoteVelocityCommand::canMergeWith(const UndoableCommand* other) const {
     auto* otherVelocity = dynamic_cast<const SetMidiNoteVelocityCommand*>(other);
-    return otherVelocity && otherVelocity->clipId_ == clipId_ &&
-           otherVelocity->noteIndex_ == noteIndex_;
+    return otherVelocity && otherVelocity->clipId_ == clipId_ && otherVelocity->noteId_ == noteId_;
 }
 
 void SetMidiNoteVelocityCommand::mergeWith(const UndoableCommand* other) {
@@ -8,6 +8,8 @@ namespace magda {
 
 /**
  * @brief Command for adding a MIDI note to a clip
+ *
+ * Redo re-adds the note under the id it was first given.
  */
 class AddMidiNoteCommand : public UndoableCommand {
   public:
@@ -20,10 +22,14 @@ class AddMidiNoteCommand : public UndoableCommand {
         return "Add MIDI Note";
     }
 
+    // Id of the added note (INVALID_MIDI_NOTE_ID until executed)
+    MidiNoteId getNoteId() const {
+        return note_.id;
+    }
+
   private:
     ClipId clipId_;
     MidiNote note_;
-    size_t insertedIndex_ = 0;
     bool executed_ = false;
 };
 
@@ -32,7 +38,7 @@ class AddMidiNoteCommand : public UndoableCommand {
  */
 class MoveMidiNoteCommand : public UndoableCommand {
   public:
-    MoveMidiNoteCommand(ClipId clipId, size_t noteIndex, double newStartBeat, int newNoteNumber);
+    MoveMidiNoteCommand(ClipId clipId, MidiNoteId noteId, double newStartBeat, int newNoteNumber);
 
     void execute() override;
     void undo() override;
@@ -45,10 +51,10 @@ class MoveMidiNoteCommand : public UndoableCommand {
 
   private:
     ClipId clipId_;
-    size_t noteIndex_;
-    double oldStartBeat_;
+    MidiNoteId noteId_;
+    double oldStartBeat_ = 0.0;
     double newStartBeat_;
-    int oldNoteNumber_;
+    int oldNoteNumber_ = 60;
     int newNoteNumber_;
     bool executed_ = false;
 };
@@ -58,7 +64,7 @@ class MoveMidiNoteCommand : public UndoableCommand {
  */
 class ResizeMidiNoteCommand : public UndoableCommand {
   public:
-    ResizeMidiNoteCommand(ClipId clipId, size_t noteIndex, double newLengthBeats);
+    ResizeMidiNoteCommand(ClipId clipId, MidiNoteId noteId, double newLengthBeats);
 
     void execute() override;
     void undo() override;
@@ -71,8 +77,8 @@ class ResizeMidiNoteCommand : public UndoableCommand {
 
   private:
     ClipId clipId_;
-    size_t noteIndex_;
-    double oldLengthBeats_;
+    MidiNoteId noteId_;
+    double oldLengthBeats_ = 1.0;
     double newLengthBeats_;
     bool executed_ = false;
 };
@@ -82,7 +88,7 @@ class ResizeMidiNoteCommand : public UndoableCommand {
  */
 class DeleteMidiNoteCommand : public UndoableCommand {
   public:
-    DeleteMidiNoteCommand(ClipId clipId, size_t noteIndex);
+    DeleteMidiNoteCommand(ClipId clipId, MidiNoteId noteId);
 
     void execute() override;
     void undo() override;
@@ -92,7 +98,7 @@ class DeleteMidiNoteCommand : public UndoableCommand {
 
   private:
     ClipId clipId_;
-    size_t noteIndex_;
+    MidiNoteId noteId_;
     MidiNote deletedNote_;
     bool executed_ = false;
 };
@@ -102,7 +108,7 @@ class DeleteMidiNoteCommand : public UndoableCommand {
  */
 class SetMidiNoteVelocityCommand : public UndoableCommand {
   public:
-    SetMidiNoteVelocityCommand(ClipId clipId, size_t noteIndex, int newVelocity);
+    SetMidiNoteVelocityCommand(ClipId clipId, MidiNoteId noteId, int newVelocity);
 
     void execute() override;
     void undo() override;
@@ -115,8 +121,8 @@ class SetMidiNoteVelocityCommand : public UndoableCommand {
 
   private:
     ClipId clipId_;
-    size_t noteIndex_;
-    int oldVelocity_;
+    MidiNoteId noteId_;
+    int oldVelocity_ = 100;
     int newVelocity_;
     bool executed_ = false;
 };
@@ -0,0 +1,230 @@
+#include "MidiNoteList.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <tuple>
+#include <unordered_set>
+
+#include "NoteSpatialIndex.hpp"
+
+namespace magda {
+
+namespace {
+
+bool isBefore(const MidiNote& a, const MidiNote& b) {
+    return std::tie(a.startBeat, a.noteNumber, a.id) < std::tie(b.startBeat, b.noteNumber, b.id);
+}
+
+bool isLong(const MidiNote& note) {
+    return note.lengthBeats > NoteSpatialIndex::LONG_NOTE_BEATS;
+}
+
+bool overlaps(const MidiNote& note, double startBeat, double endBeat) {
+    return note.startBeat < endBeat && note.startBeat + note.lengthBeats > startBeat;
+}
+
+// Gives every note a unique id (keeping valid ones) and sorts; returns the next free id
+MidiNoteId prepare(std::vector<MidiNote>& notes) {
+    MidiNoteId nextId = 1;
+    for (const auto& note : notes) {
+        nextId = std::max(nextId, note.id + 1);
+    }
+
+    std::unordered_set<MidiNoteId> used;
+    for (auto& note : notes) {
+        if (note.id == INVALID_MIDI_NOTE_ID || !used.insert(note.id).second) {
+            note.id = nextId++;
+        }
+    }
+
+    std::sort(notes.begin(), notes.end(), isBefore);
+    return nextId;
+}
+
+}  // namespace
+
+/**
+ * Derived from one version of the notes; replaced, never modified, so copies of the list
+ * can share it.
+ */
+struct MidiNoteList::Index {
+    NoteSpatialIndex spatial;
+    std::vector<std::pair<MidiNoteId, size_t>> byId;  // Sorted by id
+    std::vector<size_t> longNotes;                    // Left out of the start-order search
+    double maxLength = 0.0;                           // Longest of the other notes
+
+    explicit Index(const std::vector<MidiNote>& notes) {
+        spatial.rebuild(notes);
+        byId.reserve(notes.size());
+        for (size_t i = 0; i < notes.size(); ++i) {
+            byId.emplace_back(notes[i].id, i);
+            if (isLong(notes[i])) {
+                longNotes.push_back(i);
+            } else {
+                maxLength = std::max(maxLength, notes[i].lengthBeats);
+            }
+        }
+        std::sort(byId.begin(), byId.end());
+    }
+};
+
+MidiNoteList::MidiNoteList(std::vector<MidiNote> notes) {
+    nextId_ = prepare(notes);
+    notes_ = std::move(notes);
+}
+
+MidiNoteList::MidiNoteList(std::initializer_list<MidiNote> notes)
+    : MidiNoteList(std::vector<MidiNote>(notes)) {}
+
+MidiNoteList MidiNoteList::deferred(size_t count, Loader loader) {
+    MidiNoteList list;
+    if (count > 0 && loader) {
+        // Decoded notes carry no ids, so they get 1..count whenever they are decoded
+        list.notes_ = LazyArray<MidiNote>::deferred(count, [loader = std::move(loader)]() {
+            auto notes = loader();
+            prepare(notes);
+            return notes;
+        });
+        list.nextId_ = static_cast<MidiNoteId>(count) + 1;
+    }
+    return list;
+}
+
+// ============================================================================
+// Editing
+// ============================================================================
+
+std::vector<MidiNote>& MidiNoteList::edit() {
+    index_.reset();
+    return notes_.items();
+}
+
+MidiNoteId MidiNoteList::takeId(MidiNoteId requested) {
+    if (requested == INVALID_MIDI_NOTE_ID || find(requested) != nullptr) {
+        return nextId_++;
+    }
+    nextId_ = std::max(nextId_, requested + 1);
+    return requested;
+}
+
+MidiNoteId MidiNoteList::add(MidiNote note) {
+    note.id = takeId(note.id);
+
+    auto& notes = edit();
+    notes.insert(std::upper_bound(notes.begin(), notes.end(), note, isBefore), note);
+    return note.id;
+}
+
+bool MidiNoteList::update(const MidiNote& note) {
+    int index = indexOf(note.id);
+    if (index < 0) {
+        return false;
+    }
+
+    auto& notes = edit();
+    auto current = notes.begin() + index;
+    auto target = std::upper_bound(notes.begin(), notes.end(), note, isBefore);
+
+    // Shift the notes in between by one instead of erasing and re-inserting
+    if (target > current) {
+        std::rotate(current, current + 1, target);
+        *(target - 1) = note;
+    } else {
+        std::rotate(target, current, current + 1);
+        *target = note;
+    }
+    return true;
+}
+
+bool MidiNoteList::remove(MidiNoteId id) {
+    int index = indexOf(id);
+    if (index < 0) {
+        return false;
+    }
+
+    auto& notes = edit();
+    notes.erase(notes.begin() + index);
+    return true;
+}
+
+void MidiNoteList::clear() {
+    index_.reset();
+    notes_.clear();
+}
+
+// ============================================================================
+// Lookup
+// ============================================================================
+
+const MidiNote* MidiNoteList::find(MidiNoteId id) const {
+    int index = indexOf(id);
+    return index >= 0 ? &items()[static_cast<size_t>(index)] : nullptr;
+}
+
+int MidiNoteList::indexOf(MidiNoteId id) const {
+    if (id == INVALID_MIDI_NOTE_ID) {
+        return -1;
+    }
+
+    // Between edits the index answers in O(log n); right after one a scan is cheaper
+    // than rebuilding it for a single lookup
+    if (index_) {
+        const auto& byId = index_->byId;
+        auto it = std::lower_bound(byId.begin(), byId.end(), std::make_pair(id, size_t{0}));
+        return it != byId.end() && it->first == id ? static_cast<int>(it->second) : -1;
+    }
+
+    const auto& notes = items();
+    auto it = std::find_if(notes.begin(), notes.end(),
+                           [id](const MidiNote& note) { return note.id == id; });
+    return it != notes.end() ? static_cast<int>(it - notes.begin()) : -1;
+}
+
+// ============================================================================
+// Range queries
+// ============================================================================
+
+const MidiNoteList::Index& MidiNoteList::getIndex() const {
+    if (!index_) {
+        index_ = std::make_shared<const Index>(items());
+    }
+    return *index_;
+}
+
+void MidiNoteList::query(double startBeat, double endBeat, int lowNote, int highNote,
+                         std::vector<size_t>& results, double minLengthBeats) const {
+    getIndex().spatial.query(startBeat, endBeat, lowNote, highNote, results, minLengthBeats);
+}
+
+void MidiNoteList::queryTimeRange(double startBeat, double endBeat,
+                                  std::vector<size_t>& results) const {
+    results.clear();
+    const auto& notes = items();
+    const auto& index = getIndex();
+
+    // Nothing starting before this can reach startBeat, long notes aside
+    double earliest = startBeat - index.maxLength;
+    auto startsBefore = [](const MidiNote& note, double beat) { return note.startBeat < beat; };
+    auto it = std::lower_bound(notes.begin(), notes.end(), earliest, startsBefore);
+    for (; it != notes.end() && it->startBeat < endBeat; ++it) {
+        if (!isLong(*it) && overlaps(*it, startBeat, endBeat)) {
+            results.push_back(static_cast<size_t>(it - notes.begin()));
+        }
+    }
+
+    if (!index.longNotes.empty()) {
+        for (auto i : index.longNotes) {
+            if (overlaps(notes[i], startBeat, endBeat)) {
+                results.push_back(i);
+            }
+        }
+        std::sort(results.begin(), results.end());
+    }
+}
+
+void MidiNoteList::queryPitchRange(int lowNote, int highNote, std::vector<size_t>& results) const {
+    constexpr double infinity = std::numeric_limits<double>::infinity();
+    query(-infinity, infinity, lowNote, highNote, results);
+}
+
+}  // namespace magda
@@ -0,0 +1,161 @@
+#pragma once
+
+#include <initializer_list>
+#include <memory>
+#include <vector>
+
+#include "LazyArray.hpp"
+#include "TypeIds.hpp"
+
+namespace magda {
+
+/**
+ * @brief MIDI note data for MIDI clips
+ */
+struct MidiNote {
+    int noteNumber = 60;                   // MIDI note number (0-127)
+    int velocity = 100;                    // Note velocity (0-127)
+    double startBeat = 0.0;                // Start position in beats within clip
+    double lengthBeats = 1.0;              // Duration in beats
+    MidiNoteId id = INVALID_MIDI_NOTE_ID;  // Assigned by the clip's MidiNoteList
+};
+
+/**
+ * @brief A clip's MIDI notes, kept sorted by start beat, with ids that survive edits
+ *
+ * Notes are ordered by start beat, then note number, so index order is playback order.
+ * An index is only good until the next edit; whatever has to outlive one (selection,
+ * undo commands, editor callbacks) holds the note's id instead. Ids are unique within the
+ * list, kept when a note is moved or resized and when the list is copied, and restored
+ * by re-adding a removed note. They are not saved with the project: loading numbers the
+ * notes afresh.
+ *
+ * The notes live in a LazyArray, so copies share them until one side edits and a loaded
+ * project's notes are decoded on first access. Range queries use a time x pitch index
+ * (NoteSpatialIndex) built by the first query after an edit; copies that have not been
+ * edited since share it.
+ *
+ * Not thread-safe (message thread only).
+ */
+class MidiNoteList {
+  public:
+    using Loader = LazyArray<MidiNote>::Loader;
+    using value_type = MidiNote;
+    using const_iterator = std::vector<MidiNote>::const_iterator;
+
+    MidiNoteList() = default;
+
+    // Notes without an id (or repeating one) get a new one
+    MidiNoteList(std::vector<MidiNote> notes);
+    MidiNoteList(std::initializer_list<MidiNote> notes);
+
+    /**
+     * @brief Deferred list of count notes, decoded by loader on first access
+     */
+    static MidiNoteList deferred(size_t count, Loader loader);
+
+    bool isMaterialised() const {
+        return notes_.isMaterialised();
+    }
+
+    // Size queries never run the loader
+    size_t size() const {
+        return notes_.size();
+    }
+
+    bool empty() const {
+        return notes_.empty();
+    }
+
+    bool isShared() const {
+        return notes_.isShared();
+    }
+
+    bool sharesBufferWith(const MidiNoteList& other) const {
+        return notes_.sharesBufferWith(other.notes_);
+    }
+
+    // Read-only: edits go through add/update/remove so the order and ids stay intact
+    const std::vector<MidiNote>& items() const {
+        return notes_.items();
+    }
+
+    operator const std::vector<MidiNote>&() const {
+        return items();
+    }
+
+    const MidiNote& operator[](size_t index) const {
+        return items()[index];
+    }
+
+    const_iterator begin() const {
+        return items().begin();
+    }
+    const_iterator end() const {
+        return items().end();
+    }
+
+    // ========================================================================
+    // Editing
+    // ========================================================================
+
+    /**
+     * @brief Insert a note at its sorted position
+     * @return The note's id: note.id if set and not in use, otherwise a new one
+     */
+    MidiNoteId add(MidiNote note);
+
+    /**
+     * @brief Replace the note with note.id, re-sorting it if its start or pitch changed
+     * @return false if there is no such note
+     */
+    bool update(const MidiNote& note);
+
+    bool remove(MidiNoteId id);
+    void clear();
+
+    // ========================================================================
+    // Lookup
+    // ========================================================================
+
+    const MidiNote* find(MidiNoteId id) const;
+
+    // Current position of a note, or -1
+    int indexOf(MidiNoteId id) const;
+
+    // ========================================================================
+    // Range queries (ascending indices, valid until the next edit)
+    // ========================================================================
+
+    /**
+     * @brief Notes overlapping beats [startBeat, endBeat) and pitches [lowNote, highNote]
+     * @param minLengthBeats Notes shorter than this are treated as this long
+     */
+    void query(double startBeat, double endBeat, int lowNote, int highNote,
+               std::vector<size_t>& results, double minLengthBeats = 0.0) const;
+
+    /**
+     * @brief Notes overlapping beats [startBeat, endBeat), found from the start order
+     */
+    void queryTimeRange(double startBeat, double endBeat, std::vector<size_t>& results) const;
+
+    /**
+     * @brief Notes with pitches in [lowNote, highNote]
+     */
+    void queryPitchRange(int lowNote, int highNote, std::vector<size_t>& results) const;
+
+  private:
+    struct Index;
+
+    const Index& getIndex() const;
+    std::vector<MidiNote>& edit();
+    MidiNoteId takeId(MidiNoteId requested);
+
+    LazyArray<MidiNote> notes_;
+    MidiNoteId nextId_ = 1;
+
+    // Built on demand from notes_ and dropped by every edit
+    mutable std::shared_ptr<const Index> index_;
+};
+
+}  // namespace magda
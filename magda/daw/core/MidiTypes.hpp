@@ -8,7 +8,7 @@ namespace magda {
  * @brief Real-time MIDI note event (note on/off)
  *
  * Used for MIDI monitoring and visualization, not for sequencing.
- * For sequenced notes, see MidiNote in ClipInfo.hpp
+ * For sequenced notes, see MidiNote in MidiNoteList.hpp
  */
 struct MidiNoteEvent {
     int noteNumber = 0;      // 0-127 (middle C = 60)
@@ -3,12 +3,16 @@
 #include <juce_core/juce_core.h>
 
 #include <algorithm>
+#include <cstdint>
+#include <memory>
 #include <vector>
 
 #include "TypeIds.hpp"
 
 namespace magda {
 
+class ModWaveTable;
+
 constexpr int MODS_PER_PAGE = 8;
 constexpr int DEFAULT_MOD_PAGES = 2;
 constexpr int NUM_MODS = MODS_PER_PAGE * DEFAULT_MOD_PAGES;
@@ -154,6 +158,10 @@ struct ModInfo {
     // Custom curve settings (when waveform == Custom)
     CurvePreset curvePreset = CurvePreset::Triangle;
     std::vector<CurvePointData> curvePoints;  // User-defined curve points
+    uint32_t curveVersion = 0;                // Bumped by markCurveChanged()
+
+    // Compiled lookup table for the current shape (see ModulatorEngine::getWaveTable)
+    mutable std::shared_ptr<const ModWaveTable> waveTable;
 
     std::vector<ModLink> links;  // All parameter links for this mod
 
@@ -173,6 +181,11 @@ struct ModInfo {
         return !links.empty() || target.isValid();
     }
 
+    // Call after editing curvePoints in place so the compiled wavetable is rebuilt
+    void markCurveChanged() {
+        ++curveVersion;
+    }
+
     // Add a link to a parameter
     void addLink(const ModTarget& t, float amt = 0.5f) {
         // Check if already linked to this target
@@ -192,6 +205,11 @@ struct ModInfo {
                     links.end());
     }
 
+    // Whether phase and value move on every modulation update (what the UI animates)
+    bool isRunning() const {
+        return enabled && type == ModType::LFO;
+    }
+
     // Get link for a specific target (or nullptr if not linked)
     ModLink* getLink(const ModTarget& t) {
         for (auto& link : links) {
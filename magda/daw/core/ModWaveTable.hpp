@@ -0,0 +1,80 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+
+#include "ModInfo.hpp"
+
+namespace magda {
+
+/**
+ * @brief Precompiled single-cycle lookup table for an LFO waveform
+ *
+ * Compiled once from a ModInfo's waveform / curve preset / curve points and then
+ * read with linear interpolation, so evaluation is constant-time no matter how many
+ * curve points the shape has. Tables are immutable once built and shared between
+ * ModInfo copies; ModulatorEngine::getWaveTable() swaps in a new one when the
+ * source shape changes.
+ */
+class ModWaveTable {
+  public:
+    static constexpr int kSize = 2048;
+
+    /**
+     * @brief Look up the waveform value at the given phase
+     * @param phase Phase in cycles (wrapped into 0.0 to 1.0)
+     * @return Output value (0.0 to 1.0)
+     */
+    float lookup(float phase) const {
+        phase -= static_cast<float>(static_cast<int>(phase));
+        if (phase < 0.0f) {
+            phase += 1.0f;
+        }
+
+        float pos = phase * static_cast<float>(kSize);
+        int index = static_cast<int>(pos);
+        if (index >= kSize) {
+            index = kSize - 1;
+        }
+        float frac = pos - static_cast<float>(index);
+        return samples_[index] + frac * (samples_[index + 1] - samples_[index]);
+    }
+
+    /**
+     * @brief Look up a point on one drawn cycle, including its end
+     *
+     * Unlike lookup(), phase 1.0 is not wrapped to the start: it reads the value at the
+     * end of the cycle, so a curve drawn from 0.0 to 1.0 keeps its right edge.
+     * @param phase Phase within the cycle (clamped to 0.0 to 1.0)
+     * @return Output value (0.0 to 1.0)
+     */
+    float lookupInclusive(float phase) const {
+        float pos = std::clamp(phase, 0.0f, 1.0f) * static_cast<float>(kSize);
+        int index = std::min(static_cast<int>(pos), kSize - 1);
+        float frac = pos - static_cast<float>(index);
+        return samples_[index] + frac * (samples_[index + 1] - samples_[index]);
+    }
+
+    /**
+     * @brief Check whether this table was compiled from the mod's current shape
+     */
+    bool isUpToDate(const ModInfo& mod) const {
+        return waveform_ == mod.waveform && curvePreset_ == mod.curvePreset &&
+               curveVersion_ == mod.curveVersion;
+    }
+
+  private:
+    friend class ModulatorEngine;
+
+    // kSize samples plus a guard sample holding the value at phase 1.0, so lookup
+    // never wraps and lookupInclusive() can read the end of the cycle
+    std::array<float, kSize + 1> samples_{};
+
+    // Source shape this table was compiled from
+    LFOWaveform waveform_ = LFOWaveform::Sine;
+    CurvePreset curvePreset_ = CurvePreset::Triangle;
+    uint32_t curveVersion_ = 0;
+};
+
+}  // namespace magda
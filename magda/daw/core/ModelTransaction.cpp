@@ -0,0 +1,61 @@
+#include "ModelTransaction.hpp"
+
+#include <utility>
+
+#include "AutomationManager.hpp"
+#include "ClipManager.hpp"
+#include "TrackManager.hpp"
+
+namespace magda {
+
+// ============================================================================
+// ModelTransactionManager Implementation
+// ============================================================================
+
+ModelTransactionManager& ModelTransactionManager::getInstance() {
+    static ModelTransactionManager instance;
+    return instance;
+}
+
+void ModelTransactionManager::beginTransaction() {
+    depth_++;
+}
+
+void ModelTransactionManager::commitTransaction() {
+    if (depth_ <= 0 || --depth_ > 0) {
+        return;
+    }
+
+    // Listeners may edit the model in response; those edits notify directly (or start a
+    // transaction of their own), so take the set out before delivering it
+    auto changes = std::move(pending_);
+    pending_ = ModelChangeSet();
+    if (changes.empty()) {
+        return;
+    }
+
+    // Tracks first: engine clip sync needs the tracks the clips sit on
+    if (changes.hasTrackChanges()) {
+        TrackManager::getInstance().notifyChangesCommitted(changes);
+    }
+    if (changes.hasClipChanges()) {
+        ClipManager::getInstance().notifyChangesCommitted(changes);
+    }
+    if (changes.hasAutomationChanges()) {
+        AutomationManager::getInstance().notifyChangesCommitted(changes);
+    }
+}
+
+// ============================================================================
+// ModelTransactionScope Implementation
+// ============================================================================
+
+ModelTransactionScope::ModelTransactionScope() {
+    ModelTransactionManager::getInstance().beginTransaction();
+}
+
+ModelTransactionScope::~ModelTransactionScope() {
+    ModelTransactionManager::getInstance().commitTransaction();
+}
+
+}  // namespace magda
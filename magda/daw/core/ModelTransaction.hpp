@@ -0,0 +1,158 @@
+#pragma once
+
+#include <set>
+
+#include "ClipTypes.hpp"
+#include "TypeIds.hpp"
+
+namespace magda {
+
+/**
+ * @brief Items of one kind added, removed or modified during a transaction
+ *
+ * Tracks the net effect: an item added and removed again in the same transaction does
+ * not appear at all, and a removed item is never also reported as modified.
+ */
+template <typename Id>
+struct IdChanges {
+    std::set<Id> added;
+    std::set<Id> removed;
+    std::set<Id> modified;  // Existed before the transaction and still does
+
+    void add(Id id) {
+        added.insert(id);
+    }
+
+    void remove(Id id) {
+        modified.erase(id);
+        if (added.erase(id) == 0) {
+            removed.insert(id);
+        }
+    }
+
+    void modify(Id id) {
+        if (added.count(id) == 0 && removed.count(id) == 0) {
+            modified.insert(id);
+        }
+    }
+
+    bool empty() const {
+        return added.empty() && removed.empty() && modified.empty();
+    }
+};
+
+/**
+ * @brief Everything a transaction changed in the track, clip and automation models
+ *
+ * The *ListChanged flags correspond to tracksChanged(), clipsChanged() and
+ * automationLanesChanged(): set whenever the list was added to, removed from, reordered
+ * or replaced. Additions and removals are also itemised where the manager knows them;
+ * a list change with no itemised additions or removals (loading a project, clearing)
+ * means the whole list should be treated as new.
+ */
+struct ModelChangeSet {
+    // TrackManager
+    bool trackListChanged = false;
+    bool masterChannelChanged = false;
+    IdChanges<TrackId> tracks;       // modified = trackPropertyChanged
+    std::set<TrackId> trackDevices;  // trackDevicesChanged
+    std::set<DeviceId> devices;      // devicePropertyChanged
+
+    // ClipManager
+    bool clipListChanged = false;
+    IdChanges<ClipId> clips;  // modified = clipPropertyChanged
+
+    // AutomationManager
+    bool laneListChanged = false;
+    IdChanges<AutomationLaneId> lanes;      // modified = automationLanePropertyChanged
+    std::set<AutomationLaneId> laneClips;   // automationClipsChanged
+    std::set<AutomationLaneId> lanePoints;  // automationPointsChanged
+
+    bool hasTrackChanges() const {
+        return trackListChanged || masterChannelChanged || !tracks.empty() ||
+               !trackDevices.empty() || !devices.empty();
+    }
+
+    bool hasClipChanges() const {
+        return clipListChanged || !clips.empty();
+    }
+
+    bool hasAutomationChanges() const {
+        return laneListChanged || !lanes.empty() || !laneClips.empty() || !lanePoints.empty();
+    }
+
+    bool empty() const {
+        return !hasTrackChanges() && !hasClipChanges() && !hasAutomationChanges();
+    }
+};
+
+/**
+ * @brief Defers model change notifications and delivers them as one change set
+ *
+ * While a transaction is open, TrackManager, ClipManager and AutomationManager still
+ * update their own state and indexes immediately, but instead of calling their listeners
+ * they record what changed in the pending ModelChangeSet. Committing the outermost
+ * transaction hands the set to each manager, which passes it to its listeners once
+ * (TrackManagerListener::trackChangesCommitted() and friends; by default those replay
+ * the individual callbacks, one per changed item).
+ *
+ * Selection, playback state, drag previews and live parameter values are not model
+ * edits and are always delivered immediately.
+ *
+ * Transactions nest. Undoable commands and compound operations run inside one (see
+ * UndoManager), so a batch edit reaches listeners as a single change set. Message
+ * thread only.
+ */
+class ModelTransactionManager {
+  public:
+    static ModelTransactionManager& getInstance();
+
+    // Prevent copying
+    ModelTransactionManager(const ModelTransactionManager&) = delete;
+    ModelTransactionManager& operator=(const ModelTransactionManager&) = delete;
+
+    void beginTransaction();
+
+    /**
+     * @brief Close a transaction, delivering the changes if it was the outermost one
+     */
+    void commitTransaction();
+
+    bool isInTransaction() const {
+        return depth_ > 0;
+    }
+
+    /**
+     * @brief Where managers record changes, or nullptr if notifications go out directly
+     */
+    ModelChangeSet* getPendingChanges() {
+        return depth_ > 0 ? &pending_ : nullptr;
+    }
+
+  private:
+    ModelTransactionManager() = default;
+
+    int depth_ = 0;
+    ModelChangeSet pending_;
+};
+
+/**
+ * @brief RAII helper for model transactions
+ *
+ * Usage:
+ *   {
+ *       ModelTransactionScope transaction;
+ *       // Any number of model edits...
+ *   } // Listeners hear about all of them here, once
+ */
+class ModelTransactionScope {
+  public:
+    ModelTransactionScope();
+    ~ModelTransactionScope();
+
+    // Prevent copying/moving
+    ModelTransactionScope(const ModelTransactionScope&) = delete;
+    ModelTransactionScope& operator=(const ModelTransactionScope&) = delete;
+};
+
+}  // namespace magda
@@ -5,6 +5,7 @@
 #include <memory>
 
 #include "ModInfo.hpp"
+#include "ModWaveTable.hpp"
 
 namespace magda {
 
@@ -266,12 +267,15 @@ class ModulatorEngine {
     }
 
     /**
-     * @brief Generate waveform value for a mod (handles Custom waveforms with curve points)
+     * @brief Evaluate a mod's waveform directly from its shape definition
+     *
+     * Reference (uncached) evaluation used to compile wavetables. Hot paths should use
+     * generateWaveformForMod(), which reads the compiled table instead.
      * @param mod The modulator info
      * @param phase Current phase (0.0 to 1.0)
      * @return Output value (0.0 to 1.0)
      */
-    static float generateWaveformForMod(const ModInfo& mod, float phase) {
+    static float evaluateWaveformForMod(const ModInfo& mod, float phase) {
         if (mod.waveform == LFOWaveform::Custom) {
             if (!mod.curvePoints.empty()) {
                 return evaluateCurvePoints(mod.curvePoints, phase);
@@ -282,6 +286,48 @@ class ModulatorEngine {
         return generateWaveform(mod.waveform, phase);
     }
 
+    /**
+     * @brief Compile a mod's current waveform into a lookup table
+     */
+    static std::shared_ptr<const ModWaveTable> compileWaveTable(const ModInfo& mod) {
+        auto table = std::make_shared<ModWaveTable>();
+        for (int i = 0; i < ModWaveTable::kSize; ++i) {
+            float phase = static_cast<float>(i) / static_cast<float>(ModWaveTable::kSize);
+            table->samples_[static_cast<size_t>(i)] = evaluateWaveformForMod(mod, phase);
+        }
+        table->samples_[ModWaveTable::kSize] = evaluateWaveformForMod(mod, 1.0f);
+
+        table->waveform_ = mod.waveform;
+        table->curvePreset_ = mod.curvePreset;
+        table->curveVersion_ = mod.curveVersion;
+        return table;
+    }
+
+    /**
+     * @brief Get the compiled wavetable for a mod, rebuilding it if the shape changed
+     *
+     * Rebuilds only when waveform, curve preset or curve points (via curveVersion)
+     * differ from what the cached table was compiled from.
+     */
+    static const ModWaveTable& getWaveTable(const ModInfo& mod) {
+        if (!mod.waveTable || !mod.waveTable->isUpToDate(mod)) {
+            mod.waveTable = compileWaveTable(mod);
+        }
+        return *mod.waveTable;
+    }
+
+    /**
+     * @brief Generate waveform value for a mod (handles Custom waveforms with curve points)
+     *
+     * Constant-time lookup into the mod's compiled wavetable.
+     * @param mod The modulator info
+     * @param phase Current phase (0.0 to 1.0)
+     * @return Output value (0.0 to 1.0)
+     */
+    static float generateWaveformForMod(const ModInfo& mod, float phase) {
+        return getWaveTable(mod).lookup(phase);
+    }
+
   private:
     ModulatorEngine() = default;
 
@@ -0,0 +1,75 @@
+#include "NoteSpatialIndex.hpp"
+
+#include <algorithm>
+
+namespace magda {
+
+void NoteSpatialIndex::clear() {
+    for (auto& row : rows_) {
+        row.spans.clear();
+        row.longSpans.clear();
+        row.maxLength = 0.0;
+    }
+    size_ = 0;
+}
+
+void NoteSpatialIndex::rebuild(const std::vector<MidiNote>& notes) {
+    clear();
+
+    for (size_t i = 0; i < notes.size(); ++i) {
+        const auto& note = notes[i];
+        if (note.noteNumber < 0 || note.noteNumber >= NUM_PITCHES) {
+            continue;
+        }
+
+        auto& row = rows_[static_cast<size_t>(note.noteNumber)];
+        Span span{note.startBeat, note.startBeat + note.lengthBeats, i};
+        if (note.lengthBeats > LONG_NOTE_BEATS) {
+            row.longSpans.push_back(span);
+        } else {
+            row.spans.push_back(span);
+            row.maxLength = std::max(row.maxLength, note.lengthBeats);
+        }
+    }
+
+    for (auto& row : rows_) {
+        std::stable_sort(row.spans.begin(), row.spans.end(),
+                         [](const Span& a, const Span& b) { return a.start < b.start; });
+    }
+    size_ = notes.size();
+}
+
+void NoteSpatialIndex::query(double startBeat, double endBeat, int lowNote, int highNote,
+                             std::vector<size_t>& results, double minLengthBeats) const {
+    results.clear();
+    lowNote = std::max(lowNote, 0);
+    highNote = std::min(highNote, NUM_PITCHES - 1);
+
+    auto overlaps = [=](const Span& span) {
+        return span.start < endBeat && std::max(span.end, span.start + minLengthBeats) > startBeat;
+    };
+
+    for (int pitch = lowNote; pitch <= highNote; ++pitch) {
+        const auto& row = rows_[static_cast<size_t>(pitch)];
+
+        // Nothing starting before this can reach startBeat
+        double earliest = startBeat - std::max(row.maxLength, minLengthBeats);
+        auto it = std::lower_bound(row.spans.begin(), row.spans.end(), earliest,
+                                   [](const Span& span, double beat) { return span.start < beat; });
+        for (; it != row.spans.end() && it->start < endBeat; ++it) {
+            if (overlaps(*it)) {
+                results.push_back(it->index);
+            }
+        }
+
+        for (const auto& span : row.longSpans) {
+            if (overlaps(span)) {
+                results.push_back(span.index);
+            }
+        }
+    }
+
+    std::sort(results.begin(), results.end());
+}
+
+}  // namespace magda
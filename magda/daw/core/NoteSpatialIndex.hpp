@@ -0,0 +1,58 @@
+#pragma once
+
+#include <array>
+#include <vector>
+
+#include "MidiNoteList.hpp"
+
+namespace magda {
+
+/**
+ * @brief Time x pitch index over a clip's MIDI notes
+ *
+ * Notes are bucketed into one row per pitch and kept sorted by start beat, so a
+ * rectangle query (visible area, marquee, pointer) binary-searches each pitch row it
+ * covers instead of walking every note. Notes longer than LONG_NOTE_BEATS are kept aside
+ * in their row so a few held notes don't widen every search.
+ *
+ * The index stores copies of note positions; rebuild it whenever the notes change.
+ */
+class NoteSpatialIndex {
+  public:
+    static constexpr int NUM_PITCHES = 128;
+    static constexpr double LONG_NOTE_BEATS = 16.0;
+
+    void rebuild(const std::vector<MidiNote>& notes);
+    void clear();
+
+    size_t size() const {
+        return size_;
+    }
+
+    /**
+     * @brief Indices of notes overlapping beats [startBeat, endBeat) and pitches
+     *        [lowNote, highNote], in ascending index order (the order they are drawn)
+     * @param minLengthBeats Notes shorter than this are treated as this long
+     *        (matches the minimum width notes are drawn at)
+     */
+    void query(double startBeat, double endBeat, int lowNote, int highNote,
+               std::vector<size_t>& results, double minLengthBeats = 0.0) const;
+
+  private:
+    struct Span {
+        double start = 0.0;
+        double end = 0.0;
+        size_t index = 0;
+    };
+
+    struct Row {
+        std::vector<Span> spans;  // Sorted by start
+        std::vector<Span> longSpans;
+        double maxLength = 0.0;  // Longest entry in spans
+    };
+
+    std::array<Row, NUM_PITCHES> rows_;
+    size_t size_ = 0;
+};
+
+}  // namespace magda
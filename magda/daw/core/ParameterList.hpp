@@ -0,0 +1,146 @@
+#pragma once
+
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <vector>
+
+#include "ParameterInfo.hpp"
+
+namespace magda {
+
+/**
+ * @brief Device parameter list that materialises ParameterInfo one page at a time
+ *
+ * External plugins can expose thousands of parameters, and the UI only ever shows a
+ * page or a user-selected subset of them. Instead of holding a full ParameterInfo
+ * (name, unit, choices...) per parameter per device, the list holds:
+ * - A descriptor table shared by every instance of the same plugin (see
+ *   ParameterDescriptorCache)
+ * - One float per parameter for the current value
+ * - Full ParameterInfo entries only for pages that have been accessed
+ *
+ * Indexing keeps the std::vector interface the UI already uses. Any access to an index
+ * materialises its page; use getCurrentValue() to read values without doing that.
+ * Lists built with push_back() are fully materialised, like a plain vector.
+ *
+ * Not thread-safe: const access may materialise pages (message thread only).
+ */
+class ParameterList {
+  public:
+    static constexpr size_t PAGE_SIZE = 32;  // Matches the device slot parameter page
+
+    using DescriptorTable = std::vector<ParameterInfo>;
+
+    ParameterList() = default;
+
+    /**
+     * @brief Lazy list over a shared descriptor table
+     * @param descriptors Static metadata for each parameter (currentValue is ignored)
+     * @param values Current value of each parameter
+     */
+    ParameterList(std::shared_ptr<const DescriptorTable> descriptors, std::vector<float> values)
+        : descriptors_(std::move(descriptors)), values_(std::move(values)) {}
+
+    size_t size() const {
+        return values_.size();
+    }
+
+    bool empty() const {
+        return values_.empty();
+    }
+
+    void clear() {
+        descriptors_.reset();
+        values_.clear();
+        pages_.clear();
+    }
+
+    void push_back(const ParameterInfo& param) {
+        auto& page = materialisePage(values_.size() / PAGE_SIZE);
+        page.push_back(param);
+        values_.push_back(param.currentValue);
+    }
+
+    ParameterInfo& operator[](size_t index) {
+        return materialisePage(index / PAGE_SIZE)[index % PAGE_SIZE];
+    }
+
+    const ParameterInfo& operator[](size_t index) const {
+        return materialisePage(index / PAGE_SIZE)[index % PAGE_SIZE];
+    }
+
+    /**
+     * @brief Read a current value without materialising its page
+     */
+    float getCurrentValue(size_t index) const {
+        auto it = pages_.find(index / PAGE_SIZE);
+        if (it != pages_.end()) {
+            return it->second[index % PAGE_SIZE].currentValue;
+        }
+        return values_[index];
+    }
+
+    /**
+     * @brief Name, unit, range and the rest of a parameter's metadata, without
+     * materialising its page
+     *
+     * Unless the page is already materialised, this is the shared descriptor and its
+     * currentValue means nothing; pair it with getCurrentValue().
+     */
+    const ParameterInfo& getDescriptor(size_t index) const {
+        auto it = pages_.find(index / PAGE_SIZE);
+        if (it != pages_.end()) {
+            return it->second[index % PAGE_SIZE];
+        }
+        if (descriptors_ && index < descriptors_->size()) {
+            return (*descriptors_)[index];
+        }
+        static const ParameterInfo none;
+        return none;
+    }
+
+    void setCurrentValue(size_t index, float value) {
+        values_[index] = value;
+
+        auto it = pages_.find(index / PAGE_SIZE);
+        if (it != pages_.end()) {
+            it->second[index % PAGE_SIZE].currentValue = value;
+        }
+    }
+
+    size_t getNumMaterialisedPages() const {
+        return pages_.size();
+    }
+
+  private:
+    std::vector<ParameterInfo>& materialisePage(size_t page) const {
+        auto it = pages_.find(page);
+        if (it != pages_.end()) {
+            return it->second;
+        }
+
+        auto& entries = pages_[page];
+        entries.reserve(PAGE_SIZE);  // Keeps references stable across push_back
+
+        const size_t start = page * PAGE_SIZE;
+        const size_t end = std::min(values_.size(), start + PAGE_SIZE);
+        for (size_t i = start; i < end; ++i) {
+            ParameterInfo param;
+            if (descriptors_ && i < descriptors_->size()) {
+                param = (*descriptors_)[i];
+            }
+            param.paramIndex = static_cast<int>(i);
+            param.currentValue = values_[i];
+            entries.push_back(std::move(param));
+        }
+
+        return entries;
+    }
+
+    std::shared_ptr<const DescriptorTable> descriptors_;
+    std::vector<float> values_;
+    mutable std::map<size_t, std::vector<ParameterInfo>> pages_;
+};
+
+}  // namespace magda
@@ -0,0 +1,233 @@
+#include "PluginSearchIndex.hpp"
+
+#include <algorithm>
+
+namespace magda {
+
+namespace {
+
+// How much a match in each field counts, in Field order
+constexpr float kFieldWeights[] = {1.0f, 0.8f, 0.7f, 0.6f, 0.6f};
+
+constexpr float kRecentBoost = 30.0f;
+constexpr float kMinTrigramSimilarity = 0.5f;
+
+uint32_t packTrigram(juce::juce_wchar a, juce::juce_wchar b, juce::juce_wchar c) {
+    // Collisions only add candidates; scoring checks the real text
+    return (static_cast<uint32_t>(a) * 0x9E3779B1u) ^ (static_cast<uint32_t>(b) * 0x85EBCA77u) ^
+           (static_cast<uint32_t>(c) * 0xC2B2AE3Du);
+}
+
+bool isWordChar(juce::juce_wchar c) {
+    return juce::CharacterFunctions::isLetterOrDigit(c);
+}
+
+}  // namespace
+
+PluginSearchIndex::PluginSearchIndex(const std::vector<Entry>& entries) {
+    entries_.reserve(entries.size());
+
+    for (uint32_t i = 0; i < entries.size(); ++i) {
+        const auto& entry = entries[i];
+        IndexedEntry indexed;
+        indexed.fields[Name] = entry.name.toLowerCase();
+        indexed.fields[Manufacturer] = entry.manufacturer.toLowerCase();
+        indexed.fields[Subcategory] = entry.subcategory.toLowerCase();
+        indexed.fields[Category] = entry.category.toLowerCase();
+        indexed.fields[Format] = entry.format.toLowerCase();
+        indexed.key = entry.key;
+
+        for (const auto& field : indexed.fields) {
+            forEachTrigram(field, [this, i](uint32_t trigram) {
+                auto& posting = postings_[trigram];
+                // Entries are added in order, so a duplicate can only be the last one
+                if (posting.empty() || posting.back() != i) {
+                    posting.push_back(i);
+                }
+            });
+        }
+
+        entries_.push_back(std::move(indexed));
+    }
+}
+
+std::vector<PluginSearchIndex::Match> PluginSearchIndex::search(
+    const juce::String& query, const juce::StringArray& recentKeys) const {
+    std::vector<Match> matches;
+
+    auto words = juce::StringArray::fromTokens(query.toLowerCase(), false);
+    words.removeEmptyStrings();
+    if (words.isEmpty()) {
+        return matches;
+    }
+
+    std::vector<uint32_t> candidates;
+    collectCandidates(words, candidates);
+
+    for (auto index : candidates) {
+        const auto& entry = entries_[index];
+
+        float score = 0.0f;
+        bool allWordsMatch = true;
+        for (const auto& word : words) {
+            float wordScore = scoreWord(word, entry);
+            if (wordScore <= 0.0f) {
+                allWordsMatch = false;
+                break;
+            }
+            score += wordScore;
+        }
+        if (!allWordsMatch) {
+            continue;
+        }
+
+        int recentRank = recentKeys.indexOf(entry.key);
+        if (recentRank >= 0) {
+            score += kRecentBoost * static_cast<float>(recentKeys.size() - recentRank) /
+                     static_cast<float>(recentKeys.size());
+        }
+
+        matches.push_back({index, score});
+    }
+
+    std::sort(matches.begin(), matches.end(), [this](const Match& a, const Match& b) {
+        if (a.score != b.score) {
+            return a.score > b.score;
+        }
+        return entries_[a.entry].fields[Name] < entries_[b.entry].fields[Name];
+    });
+
+    return matches;
+}
+
+void PluginSearchIndex::collectCandidates(const juce::StringArray& words,
+                                          std::vector<uint32_t>& out) const {
+    // Entries still in the running (all of them until a word can use the postings)
+    std::vector<bool> alive(entries_.size(), true);
+    std::vector<uint16_t> counts;
+
+    for (const auto& word : words) {
+        std::vector<uint32_t> trigrams;
+        forEachTrigram(word, [&trigrams](uint32_t trigram) { trigrams.push_back(trigram); });
+        std::sort(trigrams.begin(), trigrams.end());
+        trigrams.erase(std::unique(trigrams.begin(), trigrams.end()), trigrams.end());
+
+        // Words shorter than a trigram are matched by scoring every remaining entry
+        if (trigrams.empty()) {
+            continue;
+        }
+
+        counts.assign(entries_.size(), 0);
+        for (auto trigram : trigrams) {
+            auto it = postings_.find(trigram);
+            if (it == postings_.end()) {
+                continue;
+            }
+            for (auto index : it->second) {
+                counts[index]++;
+            }
+        }
+
+        auto needed = (trigrams.size() + 1) / 2;
+        for (size_t i = 0; i < entries_.size(); ++i) {
+            if (counts[i] < needed) {
+                alive[i] = false;
+            }
+        }
+    }
+
+    for (uint32_t i = 0; i < entries_.size(); ++i) {
+        if (alive[i]) {
+            out.push_back(i);
+        }
+    }
+}
+
+float PluginSearchIndex::scoreWord(const juce::String& word, const IndexedEntry& entry) {
+    float best = 0.0f;
+    for (int field = 0; field < NumFields; ++field) {
+        float score = scoreField(word, entry.fields[field]);
+        best = std::max(best, 100.0f * kFieldWeights[field] * score);
+    }
+    return best;
+}
+
+float PluginSearchIndex::scoreField(const juce::String& word, const juce::String& field) {
+    if (field.isEmpty()) {
+        return 0.0f;
+    }
+    if (field == word) {
+        return 1.0f;
+    }
+
+    int position = field.indexOf(word);
+    if (position == 0) {
+        return 0.9f;
+    }
+    if (position > 0) {
+        return isWordChar(field[position - 1]) ? 0.6f : 0.8f;
+    }
+
+    float similarity = trigramSimilarity(word, field);
+    if (similarity >= kMinTrigramSimilarity) {
+        return 0.5f * similarity;
+    }
+
+    return isSubsequence(word, field) ? 0.2f : 0.0f;
+}
+
+float PluginSearchIndex::trigramSimilarity(const juce::String& word, const juce::String& field) {
+    std::vector<uint32_t> fieldTrigrams;
+    forEachTrigram(field, [&fieldTrigrams](uint32_t t) { fieldTrigrams.push_back(t); });
+
+    int total = 0;
+    int shared = 0;
+    forEachTrigram(word, [&](uint32_t t) {
+        total++;
+        if (std::find(fieldTrigrams.begin(), fieldTrigrams.end(), t) != fieldTrigrams.end()) {
+            shared++;
+        }
+    });
+
+    return total > 0 ? static_cast<float>(shared) / static_cast<float>(total) : 0.0f;
+}
+
+bool PluginSearchIndex::isSubsequence(const juce::String& word, const juce::String& field) {
+    auto w = word.getCharPointer();
+    auto f = field.getCharPointer();
+
+    while (!w.isEmpty()) {
+        while (!f.isEmpty() && *f != *w) {
+            ++f;
+        }
+        if (f.isEmpty()) {
+            return false;
+        }
+        ++f;
+        ++w;
+    }
+    return true;
+}
+
+void PluginSearchIndex::forEachTrigram(const juce::String& text,
+                                       const std::function<void(uint32_t)>& fn) {
+    auto p = text.getCharPointer();
+    if (p.isEmpty()) {
+        return;
+    }
+
+    juce::juce_wchar a = p.getAndAdvance();
+    if (p.isEmpty()) {
+        return;
+    }
+    juce::juce_wchar b = p.getAndAdvance();
+
+    while (!p.isEmpty()) {
+        juce::juce_wchar c = p.getAndAdvance();
+        fn(packTrigram(a, b, c));
+        a = b;
+        b = c;
+    }
+}
+
+}  // namespace magda
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+
+#include <cstdint>
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
+namespace magda {
+
+/**
+ * @brief Prebuilt fuzzy search index over the known plugin list
+ *
+ * Each entry's name, manufacturer, category, subcategory and format are lowercased and
+ * broken into trigrams once, when the list is built (after a scan completes). A query
+ * word of three or more characters looks up its trigrams' posting lists and only
+ * entries sharing at least half of them are considered, so a typo ("fabfiltre") still
+ * finds its plugin without every plugin being scanned. Candidates are then ranked:
+ * - every query word must match some field: exact > prefix > word start > substring >
+ *   trigram overlap > in-order subsequence ("pq" finds "Pro-Q"); name matches weigh most
+ * - recently used plugins get a boost
+ *
+ * The index is immutable once built, so any number of threads may search it at once.
+ */
+class PluginSearchIndex {
+  public:
+    struct Entry {
+        juce::String name;
+        juce::String manufacturer;
+        juce::String category;
+        juce::String subcategory;
+        juce::String format;
+        juce::String key;  // Stable identifier, matched against the recently-used list
+    };
+
+    struct Match {
+        uint32_t entry = 0;  // Index into the entries the index was built from
+        float score = 0.0f;
+    };
+
+    PluginSearchIndex() = default;
+    explicit PluginSearchIndex(const std::vector<Entry>& entries);
+
+    size_t size() const {
+        return entries_.size();
+    }
+
+    /**
+     * @brief All entries matching the query, best first (empty for an empty query)
+     * @param recentKeys Recently used entry keys, most recent first
+     */
+    std::vector<Match> search(const juce::String& query,
+                              const juce::StringArray& recentKeys = {}) const;
+
+  private:
+    enum Field { Name, Manufacturer, Subcategory, Category, Format, NumFields };
+
+    struct IndexedEntry {
+        juce::String fields[NumFields];  // Lowercased
+        juce::String key;
+    };
+
+    std::vector<IndexedEntry> entries_;
+    std::unordered_map<uint32_t, std::vector<uint32_t>> postings_;  // Trigram -> entries
+
+    static void forEachTrigram(const juce::String& text, const std::function<void(uint32_t)>& fn);
+    static float scoreWord(const juce::String& word, const IndexedEntry& entry);
+    static float scoreField(const juce::String& word, const juce::String& field);
+    static float trigramSimilarity(const juce::String& word, const juce::String& field);
+    static bool isSubsequence(const juce::String& word, const juce::String& field);
+
+    void collectCandidates(const juce::StringArray& words, std::vector<uint32_t>& out) const;
+};
+
+}  // namespace magda
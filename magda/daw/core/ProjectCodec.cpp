@@ -0,0 +1,629 @@
+#include "ProjectCodec.hpp"
+
+#include <array>
+
+namespace magda {
+namespace ProjectCodec {
+
+namespace {
+
+constexpr std::array<ViewMode, 4> VIEW_MODES = {ViewMode::Live, ViewMode::Arrange, ViewMode::Mix,
+                                                ViewMode::Master};
+
+constexpr juce::uint8 ELEMENT_DEVICE = 0;
+constexpr juce::uint8 ELEMENT_RACK = 1;
+
+// ============================================================================
+// Writing
+// ============================================================================
+
+void writeColour(juce::OutputStream& out, juce::Colour colour) {
+    out.writeInt(static_cast<int>(colour.getARGB()));
+}
+
+void writeViewSettings(juce::OutputStream& out, const TrackViewSettingsMap& settings) {
+    for (auto mode : VIEW_MODES) {
+        const auto& s = settings.get(mode);
+        out.writeBool(s.visible);
+        out.writeBool(s.locked);
+        out.writeBool(s.collapsed);
+        out.writeInt(s.height);
+    }
+}
+
+void writeMacros(juce::OutputStream& out, const MacroArray& macros) {
+    out.writeInt(static_cast<int>(macros.size()));
+    for (const auto& macro : macros) {
+        out.writeInt(macro.id);
+        out.writeString(macro.name);
+        out.writeFloat(macro.value);
+        out.writeInt(macro.target.deviceId);
+        out.writeInt(macro.target.paramIndex);
+        out.writeInt(static_cast<int>(macro.links.size()));
+        for (const auto& link : macro.links) {
+            out.writeInt(link.target.deviceId);
+            out.writeInt(link.target.paramIndex);
+            out.writeFloat(link.amount);
+        }
+    }
+}
+
+void writeMods(juce::OutputStream& out, const ModArray& mods) {
+    out.writeInt(static_cast<int>(mods.size()));
+    for (const auto& mod : mods) {
+        out.writeInt(mod.id);
+        out.writeString(mod.name);
+        out.writeInt(static_cast<int>(mod.type));
+        out.writeBool(mod.enabled);
+        out.writeFloat(mod.rate);
+        out.writeInt(static_cast<int>(mod.waveform));
+        out.writeFloat(mod.phaseOffset);
+        out.writeBool(mod.tempoSync);
+        out.writeInt(static_cast<int>(mod.syncDivision));
+        out.writeInt(static_cast<int>(mod.triggerMode));
+        out.writeBool(mod.oneShot);
+        out.writeBool(mod.useLoopRegion);
+        out.writeFloat(mod.loopStart);
+        out.writeFloat(mod.loopEnd);
+        out.writeInt(mod.midiChannel);
+        out.writeInt(mod.midiNote);
+        out.writeInt(static_cast<int>(mod.curvePreset));
+
+        out.writeInt(static_cast<int>(mod.curvePoints.size()));
+        for (const auto& point : mod.curvePoints) {
+            out.writeFloat(point.phase);
+            out.writeFloat(point.value);
+            out.writeFloat(point.tension);
+        }
+
+        out.writeInt(static_cast<int>(mod.links.size()));
+        for (const auto& link : mod.links) {
+            out.writeInt(link.target.deviceId);
+            out.writeInt(link.target.paramIndex);
+            out.writeFloat(link.amount);
+        }
+
+        out.writeInt(mod.target.deviceId);
+        out.writeInt(mod.target.paramIndex);
+        out.writeFloat(mod.amount);
+    }
+}
+
+void writeDevice(juce::OutputStream& out, const DeviceInfo& device) {
+    out.writeInt(device.id);
+    out.writeString(device.name);
+    out.writeString(device.pluginId);
+    out.writeString(device.manufacturer);
+    out.writeInt(static_cast<int>(device.format));
+    out.writeBool(device.isInstrument);
+    out.writeString(device.uniqueId);
+    out.writeString(device.fileOrIdentifier);
+    out.writeBool(device.bypassed);
+    out.writeBool(device.expanded);
+    out.writeBool(device.modPanelOpen);
+    out.writeBool(device.gainPanelOpen);
+    out.writeBool(device.paramPanelOpen);
+
+    // Values only - descriptors come from the plugin (or ParameterDescriptorCache)
+    out.writeInt(static_cast<int>(device.parameters.size()));
+    for (size_t i = 0; i < device.parameters.size(); ++i) {
+        out.writeFloat(device.parameters.getCurrentValue(i));
+    }
+
+    out.writeInt(static_cast<int>(device.visibleParameters.size()));
+    for (int index : device.visibleParameters) {
+        out.writeInt(index);
+    }
+
+    out.writeInt(device.gainParameterIndex);
+    out.writeFloat(device.gainValue);
+    out.writeFloat(device.gainDb);
+    writeMacros(out, device.macros);
+    writeMods(out, device.mods);
+    out.writeInt(device.currentParameterPage);
+}
+
+void writeRack(juce::OutputStream& out, const RackInfo& rack) {
+    out.writeInt(rack.id);
+    out.writeString(rack.name);
+    out.writeBool(rack.bypassed);
+    out.writeBool(rack.expanded);
+    out.writeFloat(rack.volume);
+    out.writeFloat(rack.pan);
+    writeMacros(out, rack.macros);
+    writeMods(out, rack.mods);
+
+    out.writeInt(static_cast<int>(rack.chains.size()));
+    for (const auto& chain : rack.chains) {
+        out.writeInt(chain.id);
+        out.writeString(chain.name);
+        out.writeInt(chain.outputIndex);
+        out.writeBool(chain.muted);
+        out.writeBool(chain.solo);
+        out.writeFloat(chain.volume);
+        out.writeFloat(chain.pan);
+        out.writeBool(chain.expanded);
+        writeElements(out, chain.elements);
+    }
+}
+
+void writeTarget(juce::OutputStream& out, const AutomationTarget& target) {
+    out.writeInt(static_cast<int>(target.type));
+    out.writeInt(target.trackId);
+    out.writeInt(target.devicePath.trackId);
+    out.writeInt(target.devicePath.topLevelDeviceId);
+    out.writeInt(static_cast<int>(target.devicePath.steps.size()));
+    for (const auto& step : target.devicePath.steps) {
+        out.writeInt(static_cast<int>(step.type));
+        out.writeInt(step.id);
+    }
+    out.writeInt(target.paramIndex);
+    out.writeInt(target.macroIndex);
+    out.writeInt(target.modId);
+    out.writeInt(target.modParamIndex);
+}
+
+// ============================================================================
+// Reading
+// ============================================================================
+
+void readViewSettings(Reader& in, TrackViewSettingsMap& settings) {
+    for (auto mode : VIEW_MODES) {
+        TrackViewSettings s;
+        s.visible = in.readBool();
+        s.locked = in.readBool();
+        s.collapsed = in.readBool();
+        s.height = in.readInt();
+        settings.set(mode, s);
+    }
+}
+
+MacroArray readMacros(Reader& in) {
+    MacroArray macros;
+    int count = in.readCount();
+    macros.reserve(static_cast<size_t>(count));
+    for (int i = 0; i < count && !in.failed(); ++i) {
+        MacroInfo macro;
+        macro.id = in.readInt();
+        macro.name = in.readString();
+        macro.value = in.readFloat();
+        macro.target.deviceId = in.readInt();
+        macro.target.paramIndex = in.readInt();
+        int numLinks = in.readCount(12);
+        for (int l = 0; l < numLinks && !in.failed(); ++l) {
+            MacroLink link;
+            link.target.deviceId = in.readInt();
+            link.target.paramIndex = in.readInt();
+            link.amount = in.readFloat();
+            macro.links.push_back(link);
+        }
+        macros.push_back(std::move(macro));
+    }
+    return macros;
+}
+
+ModArray readMods(Reader& in) {
+    ModArray mods;
+    int count = in.readCount();
+    mods.reserve(static_cast<size_t>(count));
+    for (int i = 0; i < count && !in.failed(); ++i) {
+        ModInfo mod;
+        mod.id = in.readInt();
+        mod.name = in.readString();
+        mod.type = static_cast<ModType>(in.readInt());
+        mod.enabled = in.readBool();
+        mod.rate = in.readFloat();
+        mod.waveform = static_cast<LFOWaveform>(in.readInt());
+        mod.phaseOffset = in.readFloat();
+        mod.tempoSync = in.readBool();
+        mod.syncDivision = static_cast<SyncDivision>(in.readInt());
+        mod.triggerMode = static_cast<LFOTriggerMode>(in.readInt());
+        mod.oneShot = in.readBool();
+        mod.useLoopRegion = in.readBool();
+        mod.loopStart = in.readFloat();
+        mod.loopEnd = in.readFloat();
+        mod.midiChannel = in.readInt();
+        mod.midiNote = in.readInt();
+        mod.curvePreset = static_cast<CurvePreset>(in.readInt());
+
+        int numPoints = in.readCount(12);
+        for (int p = 0; p < numPoints && !in.failed(); ++p) {
+            CurvePointData point;
+            point.phase = in.readFloat();
+            point.value = in.readFloat();
+            point.tension = in.readFloat();
+            mod.curvePoints.push_back(point);
+        }
+
+        int numLinks = in.readCount(12);
+        for (int l = 0; l < numLinks && !in.failed(); ++l) {
+            ModLink link;
+            link.target.deviceId = in.readInt();
+            link.target.paramIndex = in.readInt();
+            link.amount = in.readFloat();
+            mod.links.push_back(link);
+        }
+
+        mod.target.deviceId = in.readInt();
+        mod.target.paramIndex = in.readInt();
+        mod.amount = in.readFloat();
+        mods.push_back(std::move(mod));
+    }
+    return mods;
+}
+
+std::vector<ChainElement> readElementsAt(Reader& in, int depth);
+
+DeviceInfo readDevice(Reader& in) {
+    DeviceInfo device;
+    device.id = in.readInt();
+    device.name = in.readString();
+    device.pluginId = in.readString();
+    device.manufacturer = in.readString();
+    device.format = static_cast<PluginFormat>(in.readInt());
+    device.isInstrument = in.readBool();
+    device.uniqueId = in.readString();
+    device.fileOrIdentifier = in.readString();
+    device.bypassed = in.readBool();
+    device.expanded = in.readBool();
+    device.modPanelOpen = in.readBool();
+    device.gainPanelOpen = in.readBool();
+    device.paramPanelOpen = in.readBool();
+
+    int numParams = in.readCount(4);
+    std::vector<float> values(static_cast<size_t>(numParams));
+    for (auto& value : values) {
+        value = in.readFloat();
+    }
+    device.parameters = ParameterList(nullptr, std::move(values));
+
+    int numVisible = in.readCount(4);
+    device.visibleParameters.reserve(static_cast<size_t>(numVisible));
+    for (int i = 0; i < numVisible; ++i) {
+        device.visibleParameters.push_back(in.readInt());
+    }
+
+    device.gainParameterIndex = in.readInt();
+    device.gainValue = in.readFloat();
+    device.gainDb = in.readFloat();
+    device.macros = readMacros(in);
+    device.mods = readMods(in);
+    device.currentParameterPage = in.readInt();
+    return device;
+}
+
+RackInfo readRack(Reader& in, int depth) {
+    RackInfo rack;
+    rack.id = in.readInt();
+    rack.name = in.readString();
+    rack.bypassed = in.readBool();
+    rack.expanded = in.readBool();
+    rack.volume = in.readFloat();
+    rack.pan = in.readFloat();
+    rack.macros = readMacros(in);
+    rack.mods = readMods(in);
+
+    int numChains = in.readCount();
+    for (int i = 0; i < numChains && !in.failed(); ++i) {
+        ChainInfo chain;
+        chain.id = in.readInt();
+        chain.name = in.readString();
+        chain.outputIndex = in.readInt();
+        chain.muted = in.readBool();
+        chain.solo = in.readBool();
+        chain.volume = in.readFloat();
+        chain.pan = in.readFloat();
+        chain.expanded = in.readBool();
+        chain.elements = readElementsAt(in, depth + 1);
+        rack.chains.push_back(std::move(chain));
+    }
+    return rack;
+}
+
+std::vector<ChainElement> readElementsAt(Reader& in, int depth) {
+    std::vector<ChainElement> elements;
+
+    // Nesting is user-driven but never this deep; stops a corrupt file recursing forever
+    constexpr int maxDepth = 64;
+    if (depth > maxDepth) {
+        in.fail();
+        return elements;
+    }
+
+    int count = in.readCount();
+    elements.reserve(static_cast<size_t>(count));
+    for (int i = 0; i < count && !in.failed(); ++i) {
+        auto kind = in.readByte();
+        if (kind == ELEMENT_DEVICE) {
+            elements.push_back(makeDeviceElement(readDevice(in)));
+        } else if (kind == ELEMENT_RACK) {
+            elements.push_back(makeRackElement(readRack(in, depth)));
+        } else {
+            in.fail();
+        }
+    }
+    return elements;
+}
+
+AutomationTarget readTarget(Reader& in) {
+    AutomationTarget target;
+    target.type = static_cast<AutomationTargetType>(in.readInt());
+    target.trackId = in.readInt();
+    target.devicePath.trackId = in.readInt();
+    target.devicePath.topLevelDeviceId = in.readInt();
+    int numSteps = in.readCount(8);
+    for (int i = 0; i < numSteps; ++i) {
+        ChainPathStep step;
+        step.type = static_cast<ChainStepType>(in.readInt());
+        step.id = in.readInt();
+        target.devicePath.steps.push_back(step);
+    }
+    target.paramIndex = in.readInt();
+    target.macroIndex = in.readInt();
+    target.modId = in.readInt();
+    target.modParamIndex = in.readInt();
+    return target;
+}
+
+}  // namespace
+
+// ============================================================================
+// Master and tracks
+// ============================================================================
+
+void writeMaster(juce::OutputStream& out, const MasterChannelState& master) {
+    out.writeFloat(master.volume);
+    out.writeFloat(master.pan);
+    out.writeBool(master.muted);
+    out.writeBool(master.soloed);
+    writeViewSettings(out, master.viewSettings);
+}
+
+void readMaster(Reader& in, MasterChannelState& master) {
+    master.volume = in.readFloat();
+    master.pan = in.readFloat();
+    master.muted = in.readBool();
+    master.soloed = in.readBool();
+    readViewSettings(in, master.viewSettings);
+}
+
+void writeTrack(juce::OutputStream& out, const TrackInfo& track) {
+    out.writeInt(track.id);
+    out.writeInt(static_cast<int>(track.type));
+    out.writeString(track.name);
+    writeColour(out, track.colour);
+    out.writeInt(track.parentId);
+    out.writeInt(static_cast<int>(track.childIds.size()));
+    for (auto childId : track.childIds) {
+        out.writeInt(childId);
+    }
+    out.writeFloat(track.volume);
+    out.writeFloat(track.pan);
+    out.writeBool(track.muted);
+    out.writeBool(track.soloed);
+    out.writeBool(track.recordArmed);
+    out.writeString(track.midiInputDevice);
+    out.writeString(track.midiOutputDevice);
+    out.writeString(track.audioInputDevice);
+    out.writeString(track.audioOutputDevice);
+    writeViewSettings(out, track.viewSettings);
+}
+
+TrackInfo readTrack(Reader& in) {
+    TrackInfo track;
+    track.id = in.readInt();
+    track.type = static_cast<TrackType>(in.readInt());
+    track.name = in.readString();
+    track.colour = in.readColour();
+    track.parentId = in.readInt();
+    int numChildren = in.readCount(4);
+    for (int i = 0; i < numChildren; ++i) {
+        track.childIds.push_back(in.readInt());
+    }
+    track.volume = in.readFloat();
+    track.pan = in.readFloat();
+    track.muted = in.readBool();
+    track.soloed = in.readBool();
+    track.recordArmed = in.readBool();
+    track.midiInputDevice = in.readString();
+    track.midiOutputDevice = in.readString();
+    track.audioInputDevice = in.readString();
+    track.audioOutputDevice = in.readString();
+    readViewSettings(in, track.viewSettings);
+    return track;
+}
+
+void writeElements(juce::OutputStream& out, const std::vector<ChainElement>& elements) {
+    out.writeInt(static_cast<int>(elements.size()));
+    for (const auto& element : elements) {
+        if (isDevice(element)) {
+            out.writeByte(static_cast<char>(ELEMENT_DEVICE));
+            writeDevice(out, getDevice(element));
+        } else {
+            out.writeByte(static_cast<char>(ELEMENT_RACK));
+            writeRack(out, getRack(element));
+        }
+    }
+}
+
+std::vector<ChainElement> readElements(Reader& in) {
+    return readElementsAt(in, 0);
+}
+
+// ============================================================================
+// Clips and notes
+// ============================================================================
+
+void writeClip(juce::OutputStream& out, const ClipInfo& clip) {
+    out.writeInt(clip.id);
+    out.writeInt(clip.trackId);
+    out.writeString(clip.name);
+    writeColour(out, clip.colour);
+    out.writeInt(static_cast<int>(clip.type));
+    out.writeDouble(clip.startTime);
+    out.writeDouble(clip.length);
+    out.writeBool(clip.internalLoopEnabled);
+    out.writeDouble(clip.internalLoopLength);
+    out.writeInt(static_cast<int>(clip.audioSources.size()));
+    for (const auto& source : clip.audioSources) {
+        out.writeString(source.filePath);
+        out.writeDouble(source.position);
+        out.writeDouble(source.offset);
+        out.writeDouble(source.length);
+        out.writeDouble(source.stretchFactor);
+    }
+    out.writeInt(clip.sceneIndex);
+}
+
+ClipInfo readClip(Reader& in) {
+    ClipInfo clip;
+    clip.id = in.readInt();
+    clip.trackId = in.readInt();
+    clip.name = in.readString();
+    clip.colour = in.readColour();
+    clip.type = static_cast<ClipType>(in.readInt());
+    clip.startTime = in.readDouble();
+    clip.length = in.readDouble();
+    clip.internalLoopEnabled = in.readBool();
+    clip.internalLoopLength = in.readDouble();
+
+    int numSources = in.readCount();
+    for (int s = 0; s < numSources && !in.failed(); ++s) {
+        AudioSource source;
+        source.filePath = in.readString();
+        source.position = in.readDouble();
+        source.offset = in.readDouble();
+        source.length = in.readDouble();
+        source.stretchFactor = in.readDouble();
+        clip.audioSources.push_back(source);
+    }
+    clip.sceneIndex = in.readInt();
+    return clip;
+}
+
+void writeNotes(juce::OutputStream& out, const std::vector<MidiNote>& notes) {
+    for (const auto& note : notes) {
+        out.writeInt(note.noteNumber);
+        out.writeInt(note.velocity);
+        out.writeDouble(note.startBeat);
+        out.writeDouble(note.lengthBeats);
+    }
+}
+
+std::vector<MidiNote> readNotes(Reader& in, size_t count) {
+    std::vector<MidiNote> notes(count);
+    for (auto& note : notes) {
+        note.noteNumber = in.readInt();
+        note.velocity = in.readInt();
+        note.startBeat = in.readDouble();
+        note.lengthBeats = in.readDouble();
+    }
+    return notes;
+}
+
+// ============================================================================
+// Automation
+// ============================================================================
+
+void writeLane(juce::OutputStream& out, const AutomationLaneInfo& lane) {
+    out.writeInt(lane.id);
+    writeTarget(out, lane.target);
+    out.writeInt(static_cast<int>(lane.type));
+    out.writeString(lane.name);
+    out.writeBool(lane.visible);
+    out.writeBool(lane.expanded);
+    out.writeBool(lane.armed);
+    out.writeInt(lane.height);
+    out.writeInt(static_cast<int>(lane.clipIds.size()));
+    for (auto clipId : lane.clipIds) {
+        out.writeInt(clipId);
+    }
+}
+
+AutomationLaneInfo readLane(Reader& in) {
+    AutomationLaneInfo lane;
+    lane.id = in.readInt();
+    lane.target = readTarget(in);
+    lane.type = static_cast<AutomationLaneType>(in.readInt());
+    lane.name = in.readString();
+    lane.visible = in.readBool();
+    lane.expanded = in.readBool();
+    lane.armed = in.readBool();
+    lane.height = in.readInt();
+    int numClipIds = in.readCount(4);
+    for (int c = 0; c < numClipIds; ++c) {
+        lane.clipIds.push_back(in.readInt());
+    }
+    return lane;
+}
+
+void writeAutomationClip(juce::OutputStream& out, const AutomationClipInfo& clip) {
+    out.writeInt(clip.id);
+    out.writeInt(clip.laneId);
+    out.writeString(clip.name);
+    writeColour(out, clip.colour);
+    out.writeDouble(clip.startTime);
+    out.writeDouble(clip.length);
+    out.writeBool(clip.looping);
+    out.writeDouble(clip.loopLength);
+}
+
+AutomationClipInfo readAutomationClip(Reader& in) {
+    AutomationClipInfo clip;
+    clip.id = in.readInt();
+    clip.laneId = in.readInt();
+    clip.name = in.readString();
+    clip.colour = in.readColour();
+    clip.startTime = in.readDouble();
+    clip.length = in.readDouble();
+    clip.looping = in.readBool();
+    clip.loopLength = in.readDouble();
+    return clip;
+}
+
+void writePoints(juce::OutputStream& out, const std::vector<AutomationPoint>& points) {
+    for (const auto& point : points) {
+        out.writeInt(point.id);
+        out.writeInt(static_cast<int>(point.curveType));
+        out.writeDouble(point.time);
+        out.writeDouble(point.value);
+        out.writeDouble(point.tension);
+        out.writeDouble(point.inHandle.time);
+        out.writeDouble(point.inHandle.value);
+        out.writeBool(point.inHandle.linked);
+        out.writeDouble(point.outHandle.time);
+        out.writeDouble(point.outHandle.value);
+        out.writeBool(point.outHandle.linked);
+    }
+}
+
+std::vector<AutomationPoint> readPoints(Reader& in, size_t count) {
+    std::vector<AutomationPoint> points(count);
+    for (auto& point : points) {
+        point.id = in.readInt();
+        point.curveType = static_cast<AutomationCurveType>(in.readInt());
+        point.time = in.readDouble();
+        point.value = in.readDouble();
+        point.tension = in.readDouble();
+        point.inHandle.time = in.readDouble();
+        point.inHandle.value = in.readDouble();
+        point.inHandle.linked = in.readBool();
+        point.outHandle.time = in.readDouble();
+        point.outHandle.value = in.readDouble();
+        point.outHandle.linked = in.readBool();
+    }
+    return points;
+}
+
+std::vector<MidiNote> decodeNotes(const char* data, size_t count) {
+    Reader in(data, count * NOTE_RECORD_SIZE);
+    return readNotes(in, count);
+}
+
+std::vector<AutomationPoint> decodePoints(const char* data, size_t count) {
+    Reader in(data, count * POINT_RECORD_SIZE);
+    return readPoints(in, count);
+}
+
+}  // namespace ProjectCodec
+}  // namespace magda
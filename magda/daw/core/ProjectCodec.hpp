@@ -0,0 +1,131 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+
+#include <vector>
+
+#include "AutomationInfo.hpp"
+#include "ClipInfo.hpp"
+#include "TrackInfo.hpp"
+#include "TrackManager.hpp"
+
+namespace magda {
+
+/**
+ * @brief Binary encoding of the project model, shared by ProjectFile and ProjectJournal
+ *
+ * All values are little-endian (juce::OutputStream). Each entity is written without
+ * framing; callers are responsible for counts and chunk/record boundaries. Variable-size
+ * arrays that are stored out of line (MIDI notes, automation points) use fixed-size
+ * records so they can be addressed by index.
+ */
+namespace ProjectCodec {
+
+constexpr size_t NOTE_RECORD_SIZE = 24;  // note, velocity, start, length
+constexpr size_t POINT_RECORD_SIZE = 66;
+
+/**
+ * @brief Bounds-checked reader over an encoded block
+ *
+ * Reads past the end (or implausible element counts) mark the reader failed instead of
+ * returning garbage, so truncated or corrupt data is rejected rather than half-loaded.
+ */
+class Reader {
+  public:
+    Reader(const void* data, size_t size) : in_(data, size, false) {}
+
+    bool failed() const {
+        return failed_;
+    }
+
+    void fail() {
+        failed_ = true;
+    }
+
+    int readInt() {
+        return require(4) ? in_.readInt() : 0;
+    }
+    juce::int64 readInt64() {
+        return require(8) ? in_.readInt64() : 0;
+    }
+    float readFloat() {
+        return require(4) ? in_.readFloat() : 0.0f;
+    }
+    double readDouble() {
+        return require(8) ? in_.readDouble() : 0.0;
+    }
+    bool readBool() {
+        return require(1) ? in_.readBool() : false;
+    }
+    juce::uint8 readByte() {
+        return require(1) ? static_cast<juce::uint8>(in_.readByte()) : 0;
+    }
+    juce::String readString() {
+        return require(1) ? in_.readString() : juce::String();
+    }
+    juce::Colour readColour() {
+        return juce::Colour(static_cast<juce::uint32>(readInt()));
+    }
+
+    /**
+     * @brief Element count, rejected if the remaining bytes cannot possibly hold it
+     */
+    int readCount(size_t minElementSize = 1) {
+        auto count = readInt();
+        if (count < 0 ||
+            static_cast<juce::uint64>(count) * minElementSize >
+                static_cast<juce::uint64>(in_.getNumBytesRemaining())) {
+            failed_ = true;
+            return 0;
+        }
+        return count;
+    }
+
+  private:
+    bool require(juce::int64 bytes) {
+        if (failed_ || in_.getNumBytesRemaining() < bytes) {
+            failed_ = true;
+            return false;
+        }
+        return true;
+    }
+
+    juce::MemoryInputStream in_;
+    bool failed_ = false;
+};
+
+// Master channel
+void writeMaster(juce::OutputStream& out, const MasterChannelState& master);
+void readMaster(Reader& in, MasterChannelState& master);
+
+// Track properties (without the chain)
+void writeTrack(juce::OutputStream& out, const TrackInfo& track);
+TrackInfo readTrack(Reader& in);
+
+// Device/rack chain tree
+void writeElements(juce::OutputStream& out, const std::vector<ChainElement>& elements);
+std::vector<ChainElement> readElements(Reader& in);
+
+// Clip properties (without the MIDI notes)
+void writeClip(juce::OutputStream& out, const ClipInfo& clip);
+ClipInfo readClip(Reader& in);
+
+// Fixed-size MIDI note records
+void writeNotes(juce::OutputStream& out, const std::vector<MidiNote>& notes);
+std::vector<MidiNote> readNotes(Reader& in, size_t count);
+std::vector<MidiNote> decodeNotes(const char* data, size_t count);
+
+// Automation lane and clip properties (without their points)
+void writeLane(juce::OutputStream& out, const AutomationLaneInfo& lane);
+AutomationLaneInfo readLane(Reader& in);
+void writeAutomationClip(juce::OutputStream& out, const AutomationClipInfo& clip);
+AutomationClipInfo readAutomationClip(Reader& in);
+
+// Fixed-size automation point records
+void writePoints(juce::OutputStream& out, const std::vector<AutomationPoint>& points);
+std::vector<AutomationPoint> readPoints(Reader& in, size_t count);
+std::vector<AutomationPoint> decodePoints(const char* data, size_t count);
+
+}  // namespace ProjectCodec
+
+}  // namespace magda
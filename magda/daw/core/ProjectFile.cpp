@@ -0,0 +1,513 @@
+#include "ProjectFile.hpp"
+
+#include <iostream>
+#include <mutex>
+#include <optional>
+#include <utility>
+
+#include "AutomationManager.hpp"
+#include "ClipManager.hpp"
+#include "ProjectCodec.hpp"
+
+namespace magda {
+
+namespace {
+
+using ProjectCodec::NOTE_RECORD_SIZE;
+using ProjectCodec::POINT_RECORD_SIZE;
+using ProjectCodec::Reader;
+
+constexpr juce::uint32 MAGIC = ProjectFile::makeTag('M', 'G', 'D', 'P');
+
+constexpr juce::uint32 TAG_META = ProjectFile::makeTag('M', 'E', 'T', 'A');
+constexpr juce::uint32 TAG_TRACKS = ProjectFile::makeTag('T', 'R', 'K', 'S');
+constexpr juce::uint32 TAG_CHAINS = ProjectFile::makeTag('C', 'H', 'N', 'S');
+constexpr juce::uint32 TAG_CLIPS = ProjectFile::makeTag('C', 'L', 'P', 'S');
+constexpr juce::uint32 TAG_NOTES = ProjectFile::makeTag('N', 'O', 'T', 'E');
+constexpr juce::uint32 TAG_AUTOMATION = ProjectFile::makeTag('A', 'U', 'T', 'O');
+constexpr juce::uint32 TAG_POINTS = ProjectFile::makeTag('A', 'P', 'T', 'S');
+constexpr juce::uint32 TAG_PLUGINS = ProjectFile::makeTag('P', 'L', 'U', 'G');
+
+constexpr size_t HEADER_SIZE = 16;       // magic, version, chunk count, reserved
+constexpr size_t CHUNK_ENTRY_SIZE = 24;  // tag, reserved, offset, size
+
+}  // namespace
+
+// ============================================================================
+// Mapping
+// ============================================================================
+
+/**
+ * The file's bytes, mapped until something is about to overwrite the file; release() then
+ * copies them into memory so deferred arrays decoded later still find their data.
+ *
+ * Deferred arrays may be decoded on the journal thread and writes may come from it, so
+ * the bytes are only touched under the lock (see read()).
+ */
+struct ProjectFile::Mapping {
+    explicit Mapping(const juce::File& f)
+        : file(f),
+          mappedFile(std::make_unique<juce::MemoryMappedFile>(f,
+                                                              juce::MemoryMappedFile::readOnly)) {}
+
+    template <typename Fn>
+    auto read(Fn&& fn) const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return fn(data());
+    }
+
+    void release() {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (mappedFile) {
+            copy = juce::MemoryBlock(mappedFile->getData(), mappedFile->getSize());
+            mappedFile.reset();
+        }
+    }
+
+    // Unlocked: for open() and ProjectFile::read(), which hold the lock or run before the
+    // mapping is registered
+    const char* data() const {
+        return mappedFile ? static_cast<const char*>(mappedFile->getData())
+                          : static_cast<const char*>(copy.getData());
+    }
+
+    size_t size() const {
+        return mappedFile ? mappedFile->getSize() : copy.getSize();
+    }
+
+    const juce::File file;
+    std::unique_ptr<juce::MemoryMappedFile> mappedFile;
+    juce::MemoryBlock copy;
+    mutable std::mutex mutex;
+};
+
+namespace {
+
+// Every mapping something may still decode from, so write() can release the one it is
+// about to replace (a mapped file can't be replaced on Windows, or truncated anywhere)
+std::mutex mappingsLock;
+std::vector<std::weak_ptr<ProjectFile::Mapping>> liveMappings;
+
+void registerMapping(const std::shared_ptr<ProjectFile::Mapping>& mapping) {
+    std::lock_guard<std::mutex> lock(mappingsLock);
+    liveMappings.push_back(mapping);
+}
+
+void releaseMappings(const juce::File& file) {
+    std::lock_guard<std::mutex> lock(mappingsLock);
+    for (auto it = liveMappings.begin(); it != liveMappings.end();) {
+        if (auto mapping = it->lock()) {
+            if (mapping->file == file) {
+                mapping->release();
+            }
+            ++it;
+        } else {
+            it = liveMappings.erase(it);
+        }
+    }
+}
+
+}  // namespace
+
+// ============================================================================
+// Writing
+// ============================================================================
+
+bool ProjectFile::write(const juce::File& file, const ProjectData& data) {
+    std::vector<std::pair<juce::uint32, std::unique_ptr<juce::MemoryOutputStream>>> chunks;
+    auto addChunk = [&chunks](juce::uint32 tag) -> juce::MemoryOutputStream& {
+        chunks.emplace_back(tag, std::make_unique<juce::MemoryOutputStream>());
+        return *chunks.back().second;
+    };
+
+    auto& meta = addChunk(TAG_META);
+    ProjectCodec::writeMaster(meta, data.master);
+
+    auto& tracks = addChunk(TAG_TRACKS);
+    auto& chains = addChunk(TAG_CHAINS);
+    tracks.writeInt(static_cast<int>(data.tracks.size()));
+    chains.writeInt(static_cast<int>(data.tracks.size()));
+    for (const auto& track : data.tracks) {
+        ProjectCodec::writeTrack(tracks, track);
+        chains.writeInt(track.id);
+        ProjectCodec::writeElements(chains, track.chainElements);
+    }
+
+    auto& clips = addChunk(TAG_CLIPS);
+    auto& notes = addChunk(TAG_NOTES);
+    juce::int64 numNotes = 0;
+    clips.writeInt(static_cast<int>(data.clips.size()));
+    for (const auto& clip : data.clips) {
+        ProjectCodec::writeClip(clips, clip);
+        clips.writeInt64(numNotes);
+        clips.writeInt(static_cast<int>(clip.midiNotes.size()));
+        ProjectCodec::writeNotes(notes, clip.midiNotes.items());
+        numNotes += static_cast<juce::int64>(clip.midiNotes.size());
+    }
+
+    auto& automation = addChunk(TAG_AUTOMATION);
+    auto& points = addChunk(TAG_POINTS);
+    juce::int64 numPoints = 0;
+    auto writePointRange = [&automation, &points, &numPoints](const LazyArray<AutomationPoint>& p) {
+        automation.writeInt64(numPoints);
+        automation.writeInt(static_cast<int>(p.size()));
+        ProjectCodec::writePoints(points, p.items());
+        numPoints += static_cast<juce::int64>(p.size());
+    };
+
+    automation.writeInt(data.nextAutomationPointId);
+    automation.writeInt(static_cast<int>(data.automationLanes.size()));
+    for (const auto& lane : data.automationLanes) {
+        ProjectCodec::writeLane(automation, lane);
+        writePointRange(lane.absolutePoints);
+    }
+    automation.writeInt(static_cast<int>(data.automationClips.size()));
+    for (const auto& clip : data.automationClips) {
+        ProjectCodec::writeAutomationClip(automation, clip);
+        writePointRange(clip.points);
+    }
+
+    auto& plugins = addChunk(TAG_PLUGINS);
+    plugins.writeInt(static_cast<int>(data.pluginStates.size()));
+    for (const auto& [deviceId, state] : data.pluginStates) {
+        plugins.writeInt(deviceId);
+        plugins.writeInt64(static_cast<juce::int64>(state.getSize()));
+    }
+    for (const auto& [deviceId, state] : data.pluginStates) {
+        plugins.write(state.getData(), state.getSize());
+    }
+
+    // Header + chunk table, then chunks back to back
+    juce::TemporaryFile temp(file);
+    {
+        juce::FileOutputStream out(temp.getFile());
+        if (!out.openedOk()) {
+            std::cerr << "Failed to open project file for writing: " << file.getFullPathName()
+                      << std::endl;
+            return false;
+        }
+
+        out.writeInt(static_cast<int>(MAGIC));
+        out.writeInt(static_cast<int>(FORMAT_VERSION));
+        out.writeInt(static_cast<int>(chunks.size()));
+        out.writeInt(0);
+
+        juce::uint64 offset = HEADER_SIZE + CHUNK_ENTRY_SIZE * chunks.size();
+        for (const auto& [tag, stream] : chunks) {
+            out.writeInt(static_cast<int>(tag));
+            out.writeInt(0);
+            out.writeInt64(static_cast<juce::int64>(offset));
+            out.writeInt64(static_cast<juce::int64>(stream->getDataSize()));
+            offset += stream->getDataSize();
+        }
+
+        for (const auto& [tag, stream] : chunks) {
+            out.write(stream->getData(), stream->getDataSize());
+        }
+
+        out.flush();
+        if (out.getStatus().failed()) {
+            std::cerr << "Failed to write project file: " << out.getStatus().getErrorMessage()
+                      << std::endl;
+            return false;
+        }
+    }
+
+    releaseMappings(file);
+    if (!temp.overwriteTargetFileWithTemporary()) {
+        std::cerr << "Failed to replace project file: " << file.getFullPathName() << std::endl;
+        return false;
+    }
+    return true;
+}
+
+// ============================================================================
+// Reading
+// ============================================================================
+
+std::unique_ptr<ProjectFile> ProjectFile::open(const juce::File& file) {
+    auto mapping = std::make_shared<Mapping>(file);
+    if (mapping->data() == nullptr || mapping->size() < HEADER_SIZE) {
+        return nullptr;
+    }
+
+    Reader header(mapping->data(), mapping->size());
+    if (static_cast<juce::uint32>(header.readInt()) != MAGIC) {
+        return nullptr;
+    }
+
+    std::unique_ptr<ProjectFile> project(new ProjectFile());
+    project->version_ = static_cast<juce::uint32>(header.readInt());
+    if (project->version_ == 0 || project->version_ > FORMAT_VERSION) {
+        std::cerr << "Unsupported project format version " << project->version_ << ": "
+                  << file.getFullPathName() << std::endl;
+        return nullptr;
+    }
+
+    auto numChunks = header.readInt();
+    header.readInt();  // Reserved
+    if (numChunks < 0 ||
+        HEADER_SIZE + CHUNK_ENTRY_SIZE * static_cast<juce::uint64>(numChunks) > mapping->size()) {
+        return nullptr;
+    }
+
+    for (int i = 0; i < numChunks; ++i) {
+        auto tag = static_cast<juce::uint32>(header.readInt());
+        header.readInt();
+        auto offset = static_cast<juce::uint64>(header.readInt64());
+        auto size = static_cast<juce::uint64>(header.readInt64());
+        if (offset > mapping->size() || size > mapping->size() - offset) {
+            return nullptr;
+        }
+        project->chunks_[tag] = {offset, size};
+    }
+    if (header.failed()) {
+        return nullptr;
+    }
+
+    // Index plugin states so they can be copied out individually later
+    if (auto* plug = project->findChunk(TAG_PLUGINS)) {
+        Reader in(mapping->data() + plug->offset, plug->size);
+        int count = in.readCount(12);
+        const auto end = plug->offset + plug->size;
+        auto blobOffset = plug->offset + 4 + 12 * static_cast<juce::uint64>(count);
+        for (int i = 0; i < count; ++i) {
+            auto deviceId = in.readInt();
+            auto size = static_cast<juce::uint64>(in.readInt64());
+            if (size > end - blobOffset) {
+                return nullptr;
+            }
+            project->pluginStates_[deviceId] = {blobOffset, size};
+            blobOffset += size;
+        }
+        if (in.failed()) {
+            return nullptr;
+        }
+    }
+
+    registerMapping(mapping);
+    project->mapping_ = std::move(mapping);
+    return project;
+}
+
+const ProjectFile::Chunk* ProjectFile::findChunk(juce::uint32 tag) const {
+    auto it = chunks_.find(tag);
+    return it != chunks_.end() ? &it->second : nullptr;
+}
+
+bool ProjectFile::read(ProjectData& data) const {
+    data = ProjectData();
+
+    // Chunk readers point straight into the bytes, so they can't be released meanwhile
+    std::lock_guard<std::mutex> lock(mapping_->mutex);
+
+    auto chunkReader = [this](const Chunk& chunk) {
+        return Reader(mapping_->data() + chunk.offset, static_cast<size_t>(chunk.size));
+    };
+
+    if (auto* meta = findChunk(TAG_META)) {
+        auto in = chunkReader(*meta);
+        ProjectCodec::readMaster(in, data.master);
+        if (in.failed()) {
+            return false;
+        }
+    }
+
+    if (auto* tracksChunk = findChunk(TAG_TRACKS)) {
+        auto tracks = chunkReader(*tracksChunk);
+        int count = tracks.readCount();
+        data.tracks.reserve(static_cast<size_t>(count));
+        for (int i = 0; i < count && !tracks.failed(); ++i) {
+            data.tracks.push_back(ProjectCodec::readTrack(tracks));
+        }
+        if (tracks.failed()) {
+            return false;
+        }
+    }
+
+    if (auto* chainsChunk = findChunk(TAG_CHAINS)) {
+        auto chains = chunkReader(*chainsChunk);
+        std::map<TrackId, TrackInfo*> tracksById;
+        for (auto& track : data.tracks) {
+            tracksById[track.id] = &track;
+        }
+
+        int count = chains.readCount();
+        for (int i = 0; i < count && !chains.failed(); ++i) {
+            auto trackId = chains.readInt();
+            auto elements = ProjectCodec::readElements(chains);
+            auto it = tracksById.find(trackId);
+            if (it != tracksById.end()) {
+                it->second->chainElements = std::move(elements);
+            }
+        }
+        if (chains.failed()) {
+            return false;
+        }
+    }
+
+    // Deferred arrays decode straight from the mapping, which they keep alive
+    auto deferredNotes = [this](const Chunk* chunk, juce::int64 first,
+                                int count) -> std::optional<MidiNoteList> {
+        if (count == 0) {
+            return MidiNoteList();
+        }
+        auto available = chunk ? chunk->size / NOTE_RECORD_SIZE : juce::uint64{0};
+        if (count < 0 || first < 0 ||
+            static_cast<juce::uint64>(first) + static_cast<juce::uint64>(count) > available) {
+            return std::nullopt;
+        }
+        auto mapping = mapping_;
+        auto offset = chunk->offset + static_cast<juce::uint64>(first) * NOTE_RECORD_SIZE;
+        auto numNotes = static_cast<size_t>(count);
+        return MidiNoteList::deferred(numNotes, [mapping, offset, numNotes]() {
+            return mapping->read([offset, numNotes](const char* bytes) {
+                return ProjectCodec::decodeNotes(bytes + offset, numNotes);
+            });
+        });
+    };
+
+    auto deferredPoints = [this](const Chunk* chunk, juce::int64 first,
+                                 int count) -> std::optional<LazyArray<AutomationPoint>> {
+        if (count == 0) {
+            return LazyArray<AutomationPoint>();
+        }
+        auto available = chunk ? chunk->size / POINT_RECORD_SIZE : juce::uint64{0};
+        if (count < 0 || first < 0 ||
+            static_cast<juce::uint64>(first) + static_cast<juce::uint64>(count) > available) {
+            return std::nullopt;
+        }
+        auto mapping = mapping_;
+        auto offset = chunk->offset + static_cast<juce::uint64>(first) * POINT_RECORD_SIZE;
+        auto numPoints = static_cast<size_t>(count);
+        return LazyArray<AutomationPoint>::deferred(numPoints, [mapping, offset, numPoints]() {
+            return mapping->read([offset, numPoints](const char* bytes) {
+                return ProjectCodec::decodePoints(bytes + offset, numPoints);
+            });
+        });
+    };
+
+    if (auto* clipsChunk = findChunk(TAG_CLIPS)) {
+        auto clips = chunkReader(*clipsChunk);
+        auto* notesChunk = findChunk(TAG_NOTES);
+
+        int count = clips.readCount();
+        data.clips.reserve(static_cast<size_t>(count));
+        for (int i = 0; i < count && !clips.failed(); ++i) {
+            auto clip = ProjectCodec::readClip(clips);
+            auto firstNote = clips.readInt64();
+            auto numNotes = clips.readInt();
+            auto notes = deferredNotes(notesChunk, firstNote, numNotes);
+            if (!notes) {
+                return false;
+            }
+            clip.midiNotes = std::move(*notes);
+
+            data.clips.push_back(std::move(clip));
+        }
+        if (clips.failed()) {
+            return false;
+        }
+    }
+
+    if (auto* automationChunk = findChunk(TAG_AUTOMATION)) {
+        auto automation = chunkReader(*automationChunk);
+        auto* pointsChunk = findChunk(TAG_POINTS);
+
+        auto readPointRange = [&automation, &deferredPoints,
+                               pointsChunk](LazyArray<AutomationPoint>& target) {
+            auto first = automation.readInt64();
+            auto count = automation.readInt();
+            auto points = deferredPoints(pointsChunk, first, count);
+            if (!points) {
+                return false;
+            }
+            target = std::move(*points);
+            return true;
+        };
+
+        data.nextAutomationPointId = automation.readInt();
+
+        int numLanes = automation.readCount();
+        for (int i = 0; i < numLanes && !automation.failed(); ++i) {
+            auto lane = ProjectCodec::readLane(automation);
+            if (!readPointRange(lane.absolutePoints)) {
+                return false;
+            }
+            data.automationLanes.push_back(std::move(lane));
+        }
+
+        int numClips = automation.readCount();
+        for (int i = 0; i < numClips && !automation.failed(); ++i) {
+            auto clip = ProjectCodec::readAutomationClip(automation);
+            if (!readPointRange(clip.points)) {
+                return false;
+            }
+            data.automationClips.push_back(std::move(clip));
+        }
+        if (automation.failed()) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+std::vector<DeviceId> ProjectFile::getPluginStateDevices() const {
+    std::vector<DeviceId> devices;
+    devices.reserve(pluginStates_.size());
+    for (const auto& [deviceId, entry] : pluginStates_) {
+        devices.push_back(deviceId);
+    }
+    return devices;
+}
+
+juce::MemoryBlock ProjectFile::getPluginState(DeviceId deviceId) const {
+    auto it = pluginStates_.find(deviceId);
+    if (it == pluginStates_.end()) {
+        return {};
+    }
+    const auto& entry = it->second;
+    return mapping_->read([&entry](const char* bytes) {
+        return juce::MemoryBlock(bytes + entry.offset, static_cast<size_t>(entry.size));
+    });
+}
+
+// ============================================================================
+// Model
+// ============================================================================
+
+ProjectData ProjectFile::capture() {
+    ProjectData data;
+
+    const auto& trackManager = TrackManager::getInstance();
+    data.tracks = trackManager.getTracks();
+    data.master = trackManager.getMasterChannel();
+
+    // The journal encodes captures on its own thread, and reading a device materialises
+    // its parameter pages, so the chains get copies of their own instead of sharing
+    for (auto& track : data.tracks) {
+        const auto& elements = std::as_const(track.chainElements).items();
+        track.chainElements = LazyArrayTraits<ChainElement>::copy(elements);
+    }
+
+    data.clips = ClipManager::getInstance().getClips();
+
+    const auto& automationManager = AutomationManager::getInstance();
+    data.automationLanes = automationManager.getLanes();
+    data.automationClips = automationManager.getClips();
+    data.nextAutomationPointId = automationManager.getNextPointId();
+
+    return data;
+}
+
+void ProjectFile::apply(ProjectData data) {
+    // Tracks first: clip and automation listeners resolve their tracks
+    TrackManager::getInstance().loadTracks(std::move(data.tracks), data.master);
+    ClipManager::getInstance().loadClips(std::move(data.clips));
+    AutomationManager::getInstance().loadAutomation(std::move(data.automationLanes),
+                                                    std::move(data.automationClips),
+                                                    data.nextAutomationPointId);
+}
+
+}  // namespace magda
@@ -0,0 +1,137 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+
+#include <map>
+#include <memory>
+#include <vector>
+
+#include "AutomationInfo.hpp"
+#include "ClipInfo.hpp"
+#include "TrackInfo.hpp"
+#include "TrackManager.hpp"
+
+namespace magda {
+
+/**
+ * @brief Everything a project file holds
+ */
+struct ProjectData {
+    std::vector<TrackInfo> tracks;  // Including their chain trees
+    MasterChannelState master;
+    std::vector<ClipInfo> clips;
+    std::vector<AutomationLaneInfo> automationLanes;
+    std::vector<AutomationClipInfo> automationClips;
+    AutomationPointId nextAutomationPointId = 1;
+
+    // Opaque engine state per device (external plugin chunks etc.)
+    std::map<DeviceId, juce::MemoryBlock> pluginStates;
+};
+
+/**
+ * @brief Versioned, chunked binary project format
+ *
+ * Layout (little-endian):
+ * - Header: magic "MGDP", format version, chunk count, reserved
+ * - Chunk table: { tag, reserved, offset, size } per chunk
+ * - Chunks:
+ *   - META: master channel
+ *   - TRKS: track properties
+ *   - CHNS: device/rack chain tree per track
+ *   - CLPS: clip properties, each with a range into NOTE
+ *   - NOTE: fixed-size MIDI note records
+ *   - AUTO: automation lanes and clips, each with a range into APTS
+ *   - APTS: fixed-size automation point records
+ *   - PLUG: plugin state blobs, indexed by device
+ *
+ * Opening a file maps it into memory and only validates the header and chunk table.
+ * read() decodes tracks, chains and clip/lane headers, which the engine and UI need
+ * straight away; note and point arrays come back as deferred LazyArrays that decode
+ * from the mapping the first time they are touched, and plugin states are copied out
+ * per device on request. The mapping stays alive for as long as any deferred array or
+ * the ProjectFile itself needs it. Saving over a file that is still mapped first copies
+ * its bytes into memory and unmaps it, so the save can replace the file and later
+ * decodes read the copy.
+ *
+ * Unknown chunks are skipped, so later versions can add sections; files written by a
+ * newer major format version are rejected.
+ */
+class ProjectFile {
+  public:
+    static constexpr juce::uint32 FORMAT_VERSION = 1;
+    static constexpr const char* FILE_EXTENSION = ".magda";
+
+    /**
+     * @brief Write a project (via a temporary file, so a failed save keeps the old one)
+     * @return false if the file could not be written
+     */
+    static bool write(const juce::File& file, const ProjectData& data);
+
+    /**
+     * @brief Map a project file and validate its header and chunk table
+     * @return nullptr if the file is missing, truncated or not a project file
+     */
+    static std::unique_ptr<ProjectFile> open(const juce::File& file);
+
+    /**
+     * @brief Decode the project (notes and automation points stay deferred)
+     *
+     * pluginStates is left empty; use getPluginState() per device instead.
+     * @return false if a chunk is malformed
+     */
+    bool read(ProjectData& data) const;
+
+    juce::uint32 getVersion() const {
+        return version_;
+    }
+
+    // Plugin states (copied out of the mapping on request)
+    std::vector<DeviceId> getPluginStateDevices() const;
+    juce::MemoryBlock getPluginState(DeviceId deviceId) const;
+
+    /**
+     * @brief Snapshot of TrackManager, ClipManager and AutomationManager
+     */
+    static ProjectData capture();
+
+    /**
+     * @brief Replace the TrackManager, ClipManager and AutomationManager contents
+     */
+    static void apply(ProjectData data);
+
+    /**
+     * @brief Four-character chunk tag as stored in the chunk table
+     */
+    static constexpr juce::uint32 makeTag(char a, char b, char c, char d) {
+        return static_cast<juce::uint32>(static_cast<unsigned char>(a)) |
+               (static_cast<juce::uint32>(static_cast<unsigned char>(b)) << 8) |
+               (static_cast<juce::uint32>(static_cast<unsigned char>(c)) << 16) |
+               (static_cast<juce::uint32>(static_cast<unsigned char>(d)) << 24);
+    }
+
+    struct Mapping;
+
+  private:
+    struct Chunk {
+        juce::uint64 offset = 0;
+        juce::uint64 size = 0;
+    };
+
+    struct PluginStateEntry {
+        juce::uint64 offset = 0;  // Relative to the mapping
+        juce::uint64 size = 0;
+    };
+
+    ProjectFile() = default;
+
+    const Chunk* findChunk(juce::uint32 tag) const;
+
+    std::shared_ptr<const Mapping> mapping_;
+    juce::uint32 version_ = 0;
+    std::map<juce::uint32, Chunk> chunks_;
+    std::map<DeviceId, PluginStateEntry> pluginStates_;
+
+    JUCE_DECLARE_NON_COPYABLE(ProjectFile)
+};
+
+}  // namespace magda
@@ -0,0 +1,821 @@
+#include "ProjectJournal.hpp"
+
+#include <algorithm>
+#include <iostream>
+
+#include "ProjectCodec.hpp"
+
+namespace magda {
+
+namespace {
+
+constexpr juce::uint32 MAGIC = ProjectFile::makeTag('M', 'G', 'D', 'J');
+
+constexpr size_t HEADER_SIZE = 8;         // magic, version
+constexpr size_t RECORD_HEADER_SIZE = 8;  // payload size, checksum
+
+juce::uint64 fnv1a(const void* data, size_t size) {
+    auto* bytes = static_cast<const juce::uint8*>(data);
+    juce::uint64 hash = 14695981039346656037ull;
+    for (size_t i = 0; i < size; ++i) {
+        hash = (hash ^ bytes[i]) * 1099511628211ull;
+    }
+    return hash;
+}
+
+juce::uint32 checksum(const void* data, size_t size) {
+    return static_cast<juce::uint32>(fnv1a(data, size));
+}
+
+juce::MemoryBlock encodeTrack(const TrackInfo& track) {
+    juce::MemoryOutputStream out;
+    ProjectCodec::writeTrack(out, track);
+    return out.getMemoryBlock();
+}
+
+juce::int64 hashTrack(const juce::MemoryBlock& encoded) {
+    return static_cast<juce::int64>(fnv1a(encoded.getData(), encoded.getSize()));
+}
+
+juce::int64 hashClip(const ClipInfo& clip) {
+    // Note edits always report clipPropertyChanged, so the count is enough here
+    juce::MemoryOutputStream out;
+    ProjectCodec::writeClip(out, clip);
+    out.writeInt64(static_cast<juce::int64>(clip.midiNotes.size()));
+    return static_cast<juce::int64>(fnv1a(out.getData(), out.getDataSize()));
+}
+
+std::vector<ChainElement> copyElements(const std::vector<ChainElement>& elements) {
+    std::vector<ChainElement> copy;
+    copy.reserve(elements.size());
+    for (const auto& element : elements) {
+        copy.push_back(deepCopyElement(element));
+    }
+    return copy;
+}
+
+template <typename T, typename Id>
+void upsertById(std::vector<T>& items, const T& item, Id id) {
+    auto it = std::find_if(items.begin(), items.end(), [id](const T& t) { return t.id == id; });
+    if (it != items.end()) {
+        *it = item;
+    } else {
+        items.push_back(item);
+    }
+}
+
+template <typename T, typename Id>
+void eraseById(std::vector<T>& items, Id id) {
+    items.erase(
+        std::remove_if(items.begin(), items.end(), [id](const T& t) { return t.id == id; }),
+        items.end());
+}
+
+void writeIds(juce::OutputStream& out, const std::vector<int>& ids) {
+    out.writeInt(static_cast<int>(ids.size()));
+    for (auto id : ids) {
+        out.writeInt(id);
+    }
+}
+
+std::vector<int> readIds(ProjectCodec::Reader& in) {
+    std::vector<int> ids(static_cast<size_t>(in.readCount(4)));
+    for (auto& id : ids) {
+        id = in.readInt();
+    }
+    return ids;
+}
+
+juce::File resolveProjectFile(const juce::File& projectFile) {
+    return projectFile != juce::File() ? projectFile : ProjectJournal::getUntitledProjectFile();
+}
+
+}  // namespace
+
+// ============================================================================
+// ProjectChangeSet
+// ============================================================================
+
+bool ProjectChangeSet::isEmpty() const {
+    return !trackOrder && tracks.empty() && deletedTracks.empty() && chains.empty() &&
+           !master && clips.empty() && deletedClips.empty() && lanes.empty() &&
+           deletedLanes.empty();
+}
+
+juce::MemoryBlock ProjectChangeSet::encode() const {
+    juce::MemoryOutputStream out;
+    out.writeString(description);
+
+    out.writeBool(trackOrder.has_value());
+    if (trackOrder) {
+        writeIds(out, *trackOrder);
+    }
+    out.writeInt(static_cast<int>(tracks.size()));
+    for (const auto& track : tracks) {
+        ProjectCodec::writeTrack(out, track);
+    }
+    writeIds(out, deletedTracks);
+    out.writeInt(static_cast<int>(chains.size()));
+    for (const auto& [trackId, elements] : chains) {
+        out.writeInt(trackId);
+        ProjectCodec::writeElements(out, elements);
+    }
+    out.writeBool(master.has_value());
+    if (master) {
+        ProjectCodec::writeMaster(out, *master);
+    }
+
+    out.writeInt(static_cast<int>(clips.size()));
+    for (const auto& clip : clips) {
+        ProjectCodec::writeClip(out, clip);
+        out.writeInt(static_cast<int>(clip.midiNotes.size()));
+        ProjectCodec::writeNotes(out, clip.midiNotes.items());
+    }
+    writeIds(out, deletedClips);
+
+    out.writeInt(static_cast<int>(lanes.size()));
+    for (const auto& lane : lanes) {
+        ProjectCodec::writeLane(out, lane);
+        out.writeInt(static_cast<int>(lane.absolutePoints.size()));
+        ProjectCodec::writePoints(out, lane.absolutePoints.items());
+    }
+    out.writeInt(static_cast<int>(automationClips.size()));
+    for (const auto& clip : automationClips) {
+        ProjectCodec::writeAutomationClip(out, clip);
+        out.writeInt(static_cast<int>(clip.points.size()));
+        ProjectCodec::writePoints(out, clip.points.items());
+    }
+    writeIds(out, deletedLanes);
+    out.writeInt(nextAutomationPointId);
+
+    return out.getMemoryBlock();
+}
+
+bool ProjectChangeSet::decode(const void* data, size_t size, ProjectChangeSet& changes) {
+    changes = ProjectChangeSet();
+    ProjectCodec::Reader in(data, size);
+    changes.description = in.readString();
+
+    if (in.readBool()) {
+        changes.trackOrder = readIds(in);
+    }
+    int numTracks = in.readCount();
+    for (int i = 0; i < numTracks && !in.failed(); ++i) {
+        changes.tracks.push_back(ProjectCodec::readTrack(in));
+    }
+    changes.deletedTracks = readIds(in);
+    int numChains = in.readCount(8);
+    for (int i = 0; i < numChains && !in.failed(); ++i) {
+        auto trackId = in.readInt();
+        changes.chains.emplace_back(trackId, ProjectCodec::readElements(in));
+    }
+    if (in.readBool()) {
+        MasterChannelState master;
+        ProjectCodec::readMaster(in, master);
+        changes.master = master;
+    }
+
+    int numClips = in.readCount();
+    for (int i = 0; i < numClips && !in.failed(); ++i) {
+        auto clip = ProjectCodec::readClip(in);
+        auto numNotes = in.readCount(ProjectCodec::NOTE_RECORD_SIZE);
+        clip.midiNotes = ProjectCodec::readNotes(in, static_cast<size_t>(numNotes));
+        changes.clips.push_back(std::move(clip));
+    }
+    changes.deletedClips = readIds(in);
+
+    int numLanes = in.readCount();
+    for (int i = 0; i < numLanes && !in.failed(); ++i) {
+        auto lane = ProjectCodec::readLane(in);
+        auto numPoints = in.readCount(ProjectCodec::POINT_RECORD_SIZE);
+        lane.absolutePoints = ProjectCodec::readPoints(in, static_cast<size_t>(numPoints));
+        changes.lanes.push_back(std::move(lane));
+    }
+    int numAutomationClips = in.readCount();
+    for (int i = 0; i < numAutomationClips && !in.failed(); ++i) {
+        auto clip = ProjectCodec::readAutomationClip(in);
+        auto numPoints = in.readCount(ProjectCodec::POINT_RECORD_SIZE);
+        clip.points = ProjectCodec::readPoints(in, static_cast<size_t>(numPoints));
+        changes.automationClips.push_back(std::move(clip));
+    }
+    changes.deletedLanes = readIds(in);
+    changes.nextAutomationPointId = in.readInt();
+
+    return !in.failed();
+}
+
+void ProjectChangeSet::applyTo(ProjectData& data) const {
+    for (const auto& track : tracks) {
+        auto it = std::find_if(data.tracks.begin(), data.tracks.end(),
+                               [&track](const TrackInfo& t) { return t.id == track.id; });
+        if (it != data.tracks.end()) {
+            auto elements = std::move(it->chainElements);
+            *it = track;
+            it->chainElements = std::move(elements);
+        } else {
+            data.tracks.push_back(track);
+        }
+    }
+    for (auto trackId : deletedTracks) {
+        eraseById(data.tracks, trackId);
+    }
+    if (trackOrder) {
+        // Tracks missing from the order (should not happen) keep their relative place at the end
+        std::vector<TrackInfo> ordered;
+        ordered.reserve(data.tracks.size());
+        for (auto trackId : *trackOrder) {
+            auto it = std::find_if(data.tracks.begin(), data.tracks.end(),
+                                   [trackId](const TrackInfo& t) { return t.id == trackId; });
+            if (it != data.tracks.end()) {
+                ordered.push_back(std::move(*it));
+                data.tracks.erase(it);
+            }
+        }
+        for (auto& track : data.tracks) {
+            ordered.push_back(std::move(track));
+        }
+        data.tracks = std::move(ordered);
+    }
+    for (const auto& [trackId, elements] : chains) {
+        for (auto& track : data.tracks) {
+            if (track.id == trackId) {
+                track.chainElements = copyElements(elements);
+            }
+        }
+    }
+    if (master) {
+        data.master = *master;
+    }
+
+    for (const auto& clip : clips) {
+        upsertById(data.clips, clip, clip.id);
+    }
+    for (auto clipId : deletedClips) {
+        eraseById(data.clips, clipId);
+    }
+
+    auto removeLaneClips = [&data](AutomationLaneId laneId) {
+        data.automationClips.erase(
+            std::remove_if(data.automationClips.begin(), data.automationClips.end(),
+                           [laneId](const AutomationClipInfo& c) { return c.laneId == laneId; }),
+            data.automationClips.end());
+    };
+    for (const auto& lane : lanes) {
+        upsertById(data.automationLanes, lane, lane.id);
+        removeLaneClips(lane.id);
+    }
+    for (const auto& clip : automationClips) {
+        data.automationClips.push_back(clip);
+    }
+    for (auto laneId : deletedLanes) {
+        eraseById(data.automationLanes, laneId);
+        removeLaneClips(laneId);
+    }
+    data.nextAutomationPointId = nextAutomationPointId;
+}
+
+// ============================================================================
+// JournalWriter
+// ============================================================================
+
+JournalWriter::JournalWriter(const juce::File& journalFile, const juce::File& snapshotFile)
+    : juce::Thread("Project Journal"), journalFile_(journalFile), snapshotFile_(snapshotFile) {
+    startThread();
+}
+
+JournalWriter::~JournalWriter() {
+    // Let queued records reach the disk before shutting down
+    waitUntilIdle(5000);
+    stopThread(2000);
+}
+
+void JournalWriter::append(juce::MemoryBlock payload) {
+    Task task;
+    task.payload = std::move(payload);
+    enqueue(std::move(task));
+}
+
+void JournalWriter::writeSnapshot(ProjectData data) {
+    Task task;
+    task.type = Task::Type::Snapshot;
+    task.snapshot = std::make_unique<ProjectData>(std::move(data));
+    enqueue(std::move(task));
+}
+
+void JournalWriter::reset() {
+    Task task;
+    task.type = Task::Type::Reset;
+    enqueue(std::move(task));
+}
+
+bool JournalWriter::waitUntilIdle(int timeoutMs) {
+    return idle_.wait(timeoutMs);
+}
+
+void JournalWriter::enqueue(Task task) {
+    {
+        const juce::ScopedLock sl(lock_);
+        queue_.push_back(std::move(task));
+        idle_.reset();
+    }
+    notify();
+}
+
+void JournalWriter::run() {
+    while (!threadShouldExit()) {
+        std::vector<Task> tasks;
+        {
+            const juce::ScopedLock sl(lock_);
+            tasks.swap(queue_);
+            if (tasks.empty()) {
+                idle_.signal();
+            }
+        }
+
+        if (tasks.empty()) {
+            wait(-1);
+            continue;
+        }
+
+        // Consecutive records go out with a single write and flush
+        std::vector<const juce::MemoryBlock*> batch;
+        for (const auto& task : tasks) {
+            if (task.type == Task::Type::Append) {
+                batch.push_back(&task.payload);
+                continue;
+            }
+
+            appendBatch(batch);
+            batch.clear();
+
+            if (task.type == Task::Type::Snapshot) {
+                // Only drop the journal once the snapshot that replaces it is safely written
+                if (ProjectFile::write(snapshotFile_, *task.snapshot)) {
+                    truncateJournal();
+                }
+            } else {
+                // Snapshot first: an old journal over the saved project is still consistent
+                snapshotFile_.deleteFile();
+                truncateJournal();
+            }
+        }
+        appendBatch(batch);
+    }
+}
+
+void JournalWriter::appendBatch(const std::vector<const juce::MemoryBlock*>& payloads) {
+    if (payloads.empty()) {
+        return;
+    }
+
+    if (!out_) {
+        (void)journalFile_.getParentDirectory().createDirectory();
+        out_ = std::make_unique<juce::FileOutputStream>(journalFile_);
+        if (!out_->openedOk()) {
+            std::cerr << "Failed to open project journal: " << journalFile_.getFullPathName()
+                      << std::endl;
+            out_.reset();
+            return;
+        }
+        if (out_->getPosition() == 0) {
+            out_->writeInt(static_cast<int>(MAGIC));
+            out_->writeInt(static_cast<int>(FORMAT_VERSION));
+        }
+    }
+
+    juce::MemoryOutputStream batch;
+    for (const auto* payload : payloads) {
+        batch.writeInt(static_cast<int>(payload->getSize()));
+        batch.writeInt(static_cast<int>(checksum(payload->getData(), payload->getSize())));
+        batch.write(payload->getData(), payload->getSize());
+    }
+
+    out_->write(batch.getData(), batch.getDataSize());
+    out_->flush();
+    if (out_->getStatus().failed()) {
+        std::cerr << "Failed to write project journal: " << out_->getStatus().getErrorMessage()
+                  << std::endl;
+    }
+}
+
+void JournalWriter::truncateJournal() {
+    out_.reset();
+    journalFile_.deleteFile();
+}
+
+std::vector<juce::MemoryBlock> JournalWriter::readRecords(const juce::File& journalFile) {
+    std::vector<juce::MemoryBlock> records;
+
+    juce::MemoryBlock bytes;
+    if (!journalFile.loadFileAsData(bytes) || bytes.getSize() < HEADER_SIZE) {
+        return records;
+    }
+
+    auto* data = static_cast<const char*>(bytes.getData());
+    const auto size = bytes.getSize();
+    if (juce::ByteOrder::littleEndianInt(data) != MAGIC ||
+        juce::ByteOrder::littleEndianInt(data + 4) != FORMAT_VERSION) {
+        return records;
+    }
+
+    size_t pos = HEADER_SIZE;
+    while (size - pos >= RECORD_HEADER_SIZE) {
+        auto length = static_cast<size_t>(juce::ByteOrder::littleEndianInt(data + pos));
+        auto expected = juce::ByteOrder::littleEndianInt(data + pos + 4);
+        pos += RECORD_HEADER_SIZE;
+        if (length > size - pos || checksum(data + pos, length) != expected) {
+            break;  // Torn write at the tail
+        }
+        records.emplace_back(data + pos, length);
+        pos += length;
+    }
+    return records;
+}
+
+// ============================================================================
+// ProjectJournal
+// ============================================================================
+
+ProjectJournal::ProjectJournal(const juce::File& projectFile, Base base,
+                               std::function<std::map<DeviceId, juce::MemoryBlock>()> pluginStates)
+    : projectFile_(resolveProjectFile(projectFile)),
+      pluginStates_(std::move(pluginStates)),
+      writer_(getJournalFile(projectFile_), getSnapshotFile(projectFile_)) {
+    if (base == Base::ProjectFile && projectFile_.existsAsFile()) {
+        markSaved();
+    } else {
+        compact();
+    }
+
+    TrackManager::getInstance().addListener(this);
+    ClipManager::getInstance().addListener(this);
+    AutomationManager::getInstance().addListener(this);
+    UndoManager::getInstance().addListener(this);
+    startTimer(COMMIT_INTERVAL_MS);
+}
+
+ProjectJournal::~ProjectJournal() {
+    stopTimer();
+    UndoManager::getInstance().removeListener(this);
+    AutomationManager::getInstance().removeListener(this);
+    ClipManager::getInstance().removeListener(this);
+    TrackManager::getInstance().removeListener(this);
+}
+
+void ProjectJournal::commit(const juce::String& description) {
+    if (!hasPendingChanges()) {
+        return;
+    }
+
+    auto changes = collectChanges();
+    if (changes.isEmpty()) {
+        return;  // e.g. modulation updates, which are not part of the document
+    }
+    changes.description = description;
+
+    auto payload = changes.encode();
+    bytesSinceSnapshot_ += payload.getSize();
+    writer_.append(std::move(payload));
+
+    if (bytesSinceSnapshot_ >= COMPACTION_THRESHOLD) {
+        compact();
+    }
+}
+
+void ProjectJournal::compact() {
+    auto data = ProjectFile::capture();
+    if (pluginStates_) {
+        data.pluginStates = pluginStates_();
+    }
+
+    // Anything still marked dirty is part of the snapshot
+    captureBaseline();
+    bytesSinceSnapshot_ = 0;
+    writer_.writeSnapshot(std::move(data));
+}
+
+void ProjectJournal::markSaved() {
+    captureBaseline();
+    bytesSinceSnapshot_ = 0;
+    writer_.reset();
+}
+
+bool ProjectJournal::flush(int timeoutMs) {
+    commit("Edit");
+    return writer_.waitUntilIdle(timeoutMs);
+}
+
+juce::File ProjectJournal::getUntitledProjectFile() {
+    return juce::File::getSpecialLocation(juce::File::userApplicationDataDirectory)
+        .getChildFile("MAGDA")
+        .getChildFile("Autosave")
+        .getChildFile(juce::String("Untitled") + ProjectFile::FILE_EXTENSION);
+}
+
+juce::File ProjectJournal::getJournalFile(const juce::File& projectFile) {
+    auto file = resolveProjectFile(projectFile);
+    return file.getSiblingFile(file.getFileName() + ".journal");
+}
+
+juce::File ProjectJournal::getSnapshotFile(const juce::File& projectFile) {
+    auto file = resolveProjectFile(projectFile);
+    return file.getSiblingFile(file.getFileName() + ".autosave");
+}
+
+bool ProjectJournal::hasRecoveryData(const juce::File& projectFile) {
+    auto journal = getJournalFile(projectFile);
+    return getSnapshotFile(projectFile).existsAsFile() ||
+           (journal.existsAsFile() && journal.getSize() > static_cast<juce::int64>(HEADER_SIZE));
+}
+
+bool ProjectJournal::recover(const juce::File& projectFile, ProjectData& data) {
+    if (!hasRecoveryData(projectFile)) {
+        return false;
+    }
+
+    data = ProjectData();
+
+    auto base = getSnapshotFile(projectFile);
+    if (!base.existsAsFile()) {
+        base = resolveProjectFile(projectFile);
+    }
+    if (base.existsAsFile()) {
+        auto project = ProjectFile::open(base);
+        if (!project || !project->read(data)) {
+            std::cerr << "Cannot recover from unreadable file: " << base.getFullPathName()
+                      << std::endl;
+            return false;
+        }
+        for (auto deviceId : project->getPluginStateDevices()) {
+            data.pluginStates[deviceId] = project->getPluginState(deviceId);
+        }
+
+        // Decode everything now: the snapshot is rewritten (or deleted) right after recovery
+        for (auto& clip : data.clips) {
+            clip.midiNotes.items();
+        }
+        for (auto& lane : data.automationLanes) {
+            lane.absolutePoints.items();
+        }
+        for (auto& clip : data.automationClips) {
+            clip.points.items();
+        }
+    }
+
+    int replayed = 0;
+    for (const auto& record : JournalWriter::readRecords(getJournalFile(projectFile))) {
+        ProjectChangeSet changes;
+        if (!ProjectChangeSet::decode(record.getData(), record.getSize(), changes)) {
+            break;
+        }
+        changes.applyTo(data);
+        ++replayed;
+    }
+
+    std::cout << "Recovered " << base.getFileName() << " + " << replayed << " journal records"
+              << std::endl;
+    return true;
+}
+
+void ProjectJournal::discardRecoveryData(const juce::File& projectFile) {
+    getJournalFile(projectFile).deleteFile();
+    getSnapshotFile(projectFile).deleteFile();
+}
+
+// ============================================================================
+// Change tracking
+// ============================================================================
+
+void ProjectJournal::tracksChanged() {
+    tracksDirty_ = true;
+}
+
+void ProjectJournal::trackPropertyChanged(int trackId) {
+    dirtyTracks_.insert(trackId);
+}
+
+void ProjectJournal::masterChannelChanged() {
+    masterDirty_ = true;
+}
+
+void ProjectJournal::trackDevicesChanged(TrackId trackId) {
+    dirtyChains_.insert(trackId);
+}
+
+void ProjectJournal::devicePropertyChanged(DeviceId deviceId) {
+    dirtyDevices_.insert(deviceId);
+}
+
+void ProjectJournal::deviceParameterChanged(DeviceId deviceId, int /*paramIndex*/,
+                                            float /*newValue*/) {
+    dirtyDevices_.insert(deviceId);
+}
+
+void ProjectJournal::clipsChanged() {
+    clipsDirty_ = true;
+}
+
+void ProjectJournal::clipPropertyChanged(ClipId clipId) {
+    dirtyClips_.insert(clipId);
+}
+
+void ProjectJournal::automationLanesChanged() {
+    lanesDirty_ = true;
+}
+
+void ProjectJournal::automationLanePropertyChanged(AutomationLaneId laneId) {
+    dirtyLanes_.insert(laneId);
+}
+
+void ProjectJournal::automationClipsChanged(AutomationLaneId laneId) {
+    dirtyLanes_.insert(laneId);
+}
+
+void ProjectJournal::automationPointsChanged(AutomationLaneId laneId) {
+    dirtyLanes_.insert(laneId);
+}
+
+void ProjectJournal::commandPerformed(const juce::String& description) {
+    commit(description);
+}
+
+void ProjectJournal::timerCallback() {
+    // Edits made outside the undo system (mixer moves, parameter tweaks, ...)
+    commit("Edit");
+}
+
+bool ProjectJournal::hasPendingChanges() const {
+    return tracksDirty_ || clipsDirty_ || lanesDirty_ || masterDirty_ || !dirtyTracks_.empty() ||
+           !dirtyChains_.empty() || !dirtyDevices_.empty() || !dirtyClips_.empty() ||
+           !dirtyLanes_.empty();
+}
+
+ProjectChangeSet ProjectJournal::collectChanges() {
+    ProjectChangeSet changes;
+
+    const auto& trackManager = TrackManager::getInstance();
+    const auto& tracks = trackManager.getTracks();
+
+    // A list change only moves, adds or removes tracks; edits to a track's own properties
+    // arrive as trackPropertyChanged(), so only new and dirty tracks are encoded
+    if (tracksDirty_) {
+        std::vector<TrackId> order;
+        order.reserve(tracks.size());
+        std::set<TrackId> present;
+        for (const auto& track : tracks) {
+            order.push_back(track.id);
+            present.insert(track.id);
+            if (trackHashes_.find(track.id) == trackHashes_.end()) {
+                dirtyTracks_.insert(track.id);
+            }
+        }
+        for (auto it = trackHashes_.begin(); it != trackHashes_.end();) {
+            if (present.count(it->first) == 0) {
+                changes.deletedTracks.push_back(it->first);
+                dirtyTracks_.erase(it->first);
+                it = trackHashes_.erase(it);
+            } else {
+                ++it;
+            }
+        }
+        if (order != trackOrder_) {
+            changes.trackOrder = order;
+        }
+        trackOrder_ = std::move(order);
+    }
+    for (auto trackId : dirtyTracks_) {
+        const auto* track = trackManager.getTrack(trackId);
+        if (!track) {
+            continue;  // Removed again; the list change that removed it covers it
+        }
+        auto encoded = encodeTrack(*track);
+        auto hash = hashTrack(encoded);
+
+        auto known = trackHashes_.find(trackId);
+        if (known == trackHashes_.end() || known->second != hash) {
+            // Properties only (decoded back from the encoding); chains are journaled apart
+            ProjectCodec::Reader in(encoded.getData(), encoded.getSize());
+            changes.tracks.push_back(ProjectCodec::readTrack(in));
+        }
+        if (known == trackHashes_.end()) {
+            dirtyChains_.insert(trackId);
+        }
+        trackHashes_[trackId] = hash;
+    }
+
+    for (auto deviceId : dirtyDevices_) {
+        auto path = trackManager.getDevicePath(deviceId);
+        if (path.isValid()) {
+            dirtyChains_.insert(path.trackId);
+        }
+    }
+    for (auto trackId : dirtyChains_) {
+        if (const auto* track = trackManager.getTrack(trackId)) {
+            changes.chains.emplace_back(trackId, copyElements(track->chainElements));
+        }
+    }
+
+    if (masterDirty_) {
+        changes.master = trackManager.getMasterChannel();
+    }
+
+    const auto& clipManager = ClipManager::getInstance();
+    // Likewise, only clips added since the last record are picked up from a list change
+    if (clipsDirty_) {
+        std::set<ClipId> present;
+        for (const auto& clip : clipManager.getClips()) {
+            present.insert(clip.id);
+            if (clipHashes_.find(clip.id) == clipHashes_.end()) {
+                dirtyClips_.insert(clip.id);
+            }
+        }
+        for (auto it = clipHashes_.begin(); it != clipHashes_.end();) {
+            if (present.count(it->first) == 0) {
+                changes.deletedClips.push_back(it->first);
+                dirtyClips_.erase(it->first);
+                it = clipHashes_.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+    for (auto clipId : dirtyClips_) {
+        if (const auto* clip = clipManager.getClip(clipId)) {
+            changes.clips.push_back(*clip);
+            clipHashes_[clipId] = hashClip(*clip);
+        } else if (clipHashes_.erase(clipId) > 0) {
+            changes.deletedClips.push_back(clipId);
+        }
+    }
+
+    const auto& automationManager = AutomationManager::getInstance();
+    if (lanesDirty_) {
+        std::set<AutomationLaneId> laneIds;
+        for (const auto& lane : automationManager.getLanes()) {
+            laneIds.insert(lane.id);
+            if (laneIds_.count(lane.id) == 0) {
+                dirtyLanes_.insert(lane.id);
+            }
+        }
+        for (auto laneId : laneIds_) {
+            if (laneIds.count(laneId) == 0) {
+                changes.deletedLanes.push_back(laneId);
+                dirtyLanes_.erase(laneId);
+            }
+        }
+        laneIds_ = std::move(laneIds);
+    }
+    for (auto laneId : dirtyLanes_) {
+        const auto* lane = automationManager.getLane(laneId);
+        if (!lane) {
+            if (laneIds_.erase(laneId) > 0) {
+                changes.deletedLanes.push_back(laneId);
+            }
+            continue;
+        }
+        changes.lanes.push_back(*lane);
+        laneIds_.insert(laneId);
+        for (const auto& clip : automationManager.getClips()) {
+            if (clip.laneId == laneId) {
+                changes.automationClips.push_back(clip);
+            }
+        }
+    }
+    changes.nextAutomationPointId = automationManager.getNextPointId();
+
+    tracksDirty_ = clipsDirty_ = lanesDirty_ = masterDirty_ = false;
+    dirtyTracks_.clear();
+    dirtyChains_.clear();
+    dirtyDevices_.clear();
+    dirtyClips_.clear();
+    dirtyLanes_.clear();
+    return changes;
+}
+
+void ProjectJournal::captureBaseline() {
+    trackOrder_.clear();
+    trackHashes_.clear();
+    for (const auto& track : TrackManager::getInstance().getTracks()) {
+        trackOrder_.push_back(track.id);
+        trackHashes_[track.id] = hashTrack(encodeTrack(track));
+    }
+
+    clipHashes_.clear();
+    for (const auto& clip : ClipManager::getInstance().getClips()) {
+        clipHashes_[clip.id] = hashClip(clip);
+    }
+
+    laneIds_.clear();
+    for (const auto& lane : AutomationManager::getInstance().getLanes()) {
+        laneIds_.insert(lane.id);
+    }
+
+    tracksDirty_ = clipsDirty_ = lanesDirty_ = masterDirty_ = false;
+    dirtyTracks_.clear();
+    dirtyChains_.clear();
+    dirtyDevices_.clear();
+    dirtyClips_.clear();
+    dirtyLanes_.clear();
+}
+
+}  // namespace magda
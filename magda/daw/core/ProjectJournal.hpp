@@ -0,0 +1,256 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include <juce_events/juce_events.h>
+
+#include <functional>
+#include <map>
+#include <memory>
+#include <optional>
+#include <set>
+#include <utility>
+#include <vector>
+
+#include "AutomationManager.hpp"
+#include "ClipManager.hpp"
+#include "ProjectFile.hpp"
+#include "TrackManager.hpp"
+#include "UndoManager.hpp"
+
+namespace magda {
+
+/**
+ * @brief Entity-level delta between two project states
+ *
+ * Every entity that appears holds its complete new state, so applying a change set is
+ * idempotent and a sequence of them can be replayed over any earlier state of the same
+ * session (the last write for each entity wins).
+ */
+struct ProjectChangeSet {
+    juce::String description;
+
+    std::optional<std::vector<TrackId>> trackOrder;
+    std::vector<TrackInfo> tracks;  // Properties only; chains travel separately
+    std::vector<TrackId> deletedTracks;
+    std::vector<std::pair<TrackId, std::vector<ChainElement>>> chains;
+    std::optional<MasterChannelState> master;
+
+    std::vector<ClipInfo> clips;  // Including their notes
+    std::vector<ClipId> deletedClips;
+
+    // Upserted lanes carry all of their clips; clips of those lanes not listed are removed
+    std::vector<AutomationLaneInfo> lanes;
+    std::vector<AutomationClipInfo> automationClips;
+    std::vector<AutomationLaneId> deletedLanes;
+    AutomationPointId nextAutomationPointId = 1;
+
+    bool isEmpty() const;
+
+    juce::MemoryBlock encode() const;
+
+    /**
+     * @brief Decode an encoded change set
+     * @return false if the payload is malformed
+     */
+    static bool decode(const void* data, size_t size, ProjectChangeSet& changes);
+
+    void applyTo(ProjectData& data) const;
+};
+
+/**
+ * @brief Background thread that appends journal records and writes snapshots
+ *
+ * Journal layout: magic "MGDJ" and format version, then records of
+ * { payload size, FNV-1a checksum, payload }. Records queued while the thread is busy
+ * are written with one append and one flush (group commit). Tasks run in the order
+ * they were queued, so a snapshot always covers every record queued before it.
+ */
+class JournalWriter : private juce::Thread {
+  public:
+    static constexpr juce::uint32 FORMAT_VERSION = 1;
+
+    JournalWriter(const juce::File& journalFile, const juce::File& snapshotFile);
+    ~JournalWriter() override;
+
+    void append(juce::MemoryBlock payload);
+
+    /**
+     * @brief Write a full snapshot, then truncate the journal it supersedes
+     */
+    void writeSnapshot(ProjectData data);
+
+    /**
+     * @brief Truncate the journal and delete the snapshot (after a full save)
+     */
+    void reset();
+
+    /**
+     * @brief Block until everything queued so far is on disk
+     * @return false if the timeout expired first
+     */
+    bool waitUntilIdle(int timeoutMs = -1);
+
+    /**
+     * @brief Read back the valid records of a journal
+     *
+     * Stops at the first torn or corrupt record (the tail of a crashed write).
+     */
+    static std::vector<juce::MemoryBlock> readRecords(const juce::File& journalFile);
+
+  private:
+    struct Task {
+        enum class Type { Append, Snapshot, Reset };
+        Type type = Type::Append;
+        juce::MemoryBlock payload;
+        std::unique_ptr<ProjectData> snapshot;
+    };
+
+    void run() override;
+    void enqueue(Task task);
+    void appendBatch(const std::vector<const juce::MemoryBlock*>& payloads);
+    void truncateJournal();
+
+    juce::File journalFile_;
+    juce::File snapshotFile_;
+    std::unique_ptr<juce::FileOutputStream> out_;
+
+    juce::CriticalSection lock_;
+    std::vector<Task> queue_;
+    juce::WaitableEvent idle_{true};
+
+    JUCE_DECLARE_NON_COPYABLE(JournalWriter)
+};
+
+/**
+ * @brief Append-only change journal for crash-safe incremental autosave
+ *
+ * Listens to the model managers and only marks what changed. At every command boundary
+ * (execute/undo/redo of an UndoableCommand or a finished compound operation), and
+ * periodically for edits made outside the undo system, the dirty entities are encoded
+ * into a ProjectChangeSet record and handed to the JournalWriter, so the cost of an
+ * autosave is proportional to the edit rather than to the project size.
+ *
+ * Once enough has been journaled, the current model is captured and written as a full
+ * snapshot on the writer thread, which then truncates the journal. Recovery loads the
+ * snapshot (or the project file if there is none) and replays the journal over it.
+ *
+ * Files live next to the project ("Song.magda.journal", "Song.magda.autosave"); an
+ * untitled session journals under the application data directory.
+ */
+class ProjectJournal : public TrackManagerListener,
+                       public ClipManagerListener,
+                       public AutomationManagerListener,
+                       public UndoManagerListener,
+                       private juce::Timer {
+  public:
+    static constexpr size_t COMPACTION_THRESHOLD = 4 * 1024 * 1024;
+    static constexpr int COMMIT_INTERVAL_MS = 2000;
+
+    enum class Base {
+        ProjectFile,  // The model is what the project file holds
+        Snapshot      // The model exists nowhere on disk yet (recovered or untitled)
+    };
+
+    /**
+     * @brief Start journaling the current model
+     * @param projectFile The project being edited (an empty File for an untitled session)
+     * @param base Where recovery should start from; an untitled session always snapshots
+     * @param pluginStates Opaque plugin states to include in snapshots
+     */
+    ProjectJournal(const juce::File& projectFile, Base base,
+                   std::function<std::map<DeviceId, juce::MemoryBlock>()> pluginStates = {});
+    ~ProjectJournal() override;
+
+    /**
+     * @brief Journal everything changed since the last record
+     */
+    void commit(const juce::String& description);
+
+    /**
+     * @brief Snapshot the current model and truncate the journal
+     */
+    void compact();
+
+    /**
+     * @brief The project was just written in full; drop the journal and snapshot
+     */
+    void markSaved();
+
+    /**
+     * @brief Block until all records so far are on disk
+     */
+    bool flush(int timeoutMs = -1);
+
+    static juce::File getUntitledProjectFile();
+    static juce::File getJournalFile(const juce::File& projectFile);
+    static juce::File getSnapshotFile(const juce::File& projectFile);
+
+    static bool hasRecoveryData(const juce::File& projectFile);
+
+    /**
+     * @brief Rebuild the last journaled state of a session
+     *
+     * Loads the snapshot, or else the project file (or nothing, for an untitled
+     * session), and replays the journal over it. Plugin states come from whichever
+     * file the base was loaded from.
+     * @return false if there is nothing to recover or the base file is unreadable
+     */
+    static bool recover(const juce::File& projectFile, ProjectData& data);
+
+    static void discardRecoveryData(const juce::File& projectFile);
+
+    // TrackManagerListener
+    void tracksChanged() override;
+    void trackPropertyChanged(int trackId) override;
+    void masterChannelChanged() override;
+    void trackDevicesChanged(TrackId trackId) override;
+    void devicePropertyChanged(DeviceId deviceId) override;
+    void deviceParameterChanged(DeviceId deviceId, int paramIndex, float newValue) override;
+
+    // ClipManagerListener
+    void clipsChanged() override;
+    void clipPropertyChanged(ClipId clipId) override;
+
+    // AutomationManagerListener
+    void automationLanesChanged() override;
+    void automationLanePropertyChanged(AutomationLaneId laneId) override;
+    void automationClipsChanged(AutomationLaneId laneId) override;
+    void automationPointsChanged(AutomationLaneId laneId) override;
+
+    // UndoManagerListener
+    void undoStateChanged() override {}
+    void commandPerformed(const juce::String& description) override;
+
+  private:
+    void timerCallback() override;
+
+    bool hasPendingChanges() const;
+    ProjectChangeSet collectChanges();
+    void captureBaseline();
+
+    juce::File projectFile_;
+    std::function<std::map<DeviceId, juce::MemoryBlock>()> pluginStates_;
+    JournalWriter writer_;
+    size_t bytesSinceSnapshot_ = 0;
+
+    // Dirty marks, resolved against the model at commit time
+    bool tracksDirty_ = false;  // The track list changed (membership or order)
+    bool clipsDirty_ = false;   // The clip list changed (membership)
+    bool lanesDirty_ = false;
+    bool masterDirty_ = false;
+    std::set<TrackId> dirtyTracks_;
+    std::set<TrackId> dirtyChains_;
+    std::set<DeviceId> dirtyDevices_;
+    std::set<ClipId> dirtyClips_;
+    std::set<AutomationLaneId> dirtyLanes_;
+
+    // What the journal last recorded, for telling structural changes apart
+    std::vector<TrackId> trackOrder_;
+    std::map<TrackId, juce::int64> trackHashes_;
+    std::map<ClipId, juce::int64> clipHashes_;
+    std::set<AutomationLaneId> laneIds_;
+
+    JUCE_DECLARE_NON_COPYABLE(ProjectJournal)
+};
+
+}  // namespace magda
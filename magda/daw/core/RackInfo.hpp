@@ -7,6 +7,7 @@
 #include <vector>
 
 #include "DeviceInfo.hpp"
+#include "LazyArray.hpp"
 #include "MacroInfo.hpp"
 #include "ModInfo.hpp"
 #include "TypeIds.hpp"
@@ -206,6 +207,19 @@ inline ChainElement deepCopyElement(const ChainElement& element) {
     }
 }
 
+// Shared track chains (LazyArray<ChainElement>) detach through a deep copy
+template <>
+struct LazyArrayTraits<ChainElement> {
+    static std::vector<ChainElement> copy(const std::vector<ChainElement>& elements) {
+        std::vector<ChainElement> copied;
+        copied.reserve(elements.size());
+        for (const auto& element : elements) {
+            copied.push_back(deepCopyElement(element));
+        }
+        return copied;
+    }
+};
+
 // Factory function to create a ChainElement from a RackInfo
 inline ChainElement makeRackElement(RackInfo rack) {
     return std::make_unique<RackInfo>(std::move(rack));
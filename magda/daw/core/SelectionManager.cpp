@@ -270,7 +270,7 @@ void SelectionManager::selectTimeRange(double startTime, double endTime,
 // Note Selection
 // ============================================================================
 
-void SelectionManager::selectNote(ClipId clipId, size_t noteIndex) {
+void SelectionManager::selectNote(ClipId clipId, MidiNoteId noteId) {
     bool typeChanged = selectionType_ != SelectionType::Note;
 
     // Clear other selection types (but keep clip selection for UI purposes)
@@ -281,8 +281,8 @@ void SelectionManager::selectNote(ClipId clipId, size_t noteIndex) {
 
     selectionType_ = SelectionType::Note;
     noteSelection_.clipId = clipId;
-    noteSelection_.noteIndices.clear();
-    noteSelection_.noteIndices.push_back(noteIndex);
+    noteSelection_.noteIds.clear();
+    noteSelection_.noteIds.push_back(noteId);
 
     // Clear track selection but DON'T clear clip selection
     // (the note is still within that clip, and we want the piano roll to stay visible)
@@ -294,14 +294,14 @@ void SelectionManager::selectNote(ClipId clipId, size_t noteIndex) {
     notifyNoteSelectionChanged(noteSelection_);
 }
 
-void SelectionManager::selectNotes(ClipId clipId, const std::vector<size_t>& noteIndices) {
-    if (noteIndices.empty()) {
+void SelectionManager::selectNotes(ClipId clipId, const std::vector<MidiNoteId>& noteIds) {
+    if (noteIds.empty()) {
         clearSelection();
         return;
     }
 
-    if (noteIndices.size() == 1) {
-        selectNote(clipId, noteIndices[0]);
+    if (noteIds.size() == 1) {
+        selectNote(clipId, noteIds[0]);
         return;
     }
 
@@ -315,7 +315,7 @@ void SelectionManager::selectNotes(ClipId clipId, const std::vector<size_t>& not
 
     selectionType_ = SelectionType::Note;
     noteSelection_.clipId = clipId;
-    noteSelection_.noteIndices = noteIndices;
+    noteSelection_.noteIds = noteIds;
 
     // Clear track selection but DON'T clear clip selection
     TrackManager::getInstance().setSelectedTrack(INVALID_TRACK_ID);
@@ -326,37 +326,35 @@ void SelectionManager::selectNotes(ClipId clipId, const std::vector<size_t>& not
     notifyNoteSelectionChanged(noteSelection_);
 }
 
-void SelectionManager::addNoteToSelection(ClipId clipId, size_t noteIndex) {
+void SelectionManager::addNoteToSelection(ClipId clipId, MidiNoteId noteId) {
     // If selecting a note from a different clip, start fresh
     if (noteSelection_.clipId != clipId) {
-        selectNote(clipId, noteIndex);
+        selectNote(clipId, noteId);
         return;
     }
 
     // Check if already selected
-    auto it =
-        std::find(noteSelection_.noteIndices.begin(), noteSelection_.noteIndices.end(), noteIndex);
-    if (it != noteSelection_.noteIndices.end()) {
+    auto it = std::find(noteSelection_.noteIds.begin(), noteSelection_.noteIds.end(), noteId);
+    if (it != noteSelection_.noteIds.end()) {
         return;  // Already selected
     }
 
     // Ensure we're in note selection mode
     if (selectionType_ != SelectionType::Note) {
-        selectNote(clipId, noteIndex);
+        selectNote(clipId, noteId);
         return;
     }
 
-    noteSelection_.noteIndices.push_back(noteIndex);
+    noteSelection_.noteIds.push_back(noteId);
     notifyNoteSelectionChanged(noteSelection_);
 }
 
-void SelectionManager::removeNoteFromSelection(size_t noteIndex) {
-    auto it =
-        std::find(noteSelection_.noteIndices.begin(), noteSelection_.noteIndices.end(), noteIndex);
-    if (it != noteSelection_.noteIndices.end()) {
-        noteSelection_.noteIndices.erase(it);
+void SelectionManager::removeNoteFromSelection(MidiNoteId noteId) {
+    auto it = std::find(noteSelection_.noteIds.begin(), noteSelection_.noteIds.end(), noteId);
+    if (it != noteSelection_.noteIds.end()) {
+        noteSelection_.noteIds.erase(it);
 
-        if (noteSelection_.noteIndices.empty()) {
+        if (noteSelection_.noteIds.empty()) {
             clearSelection();
         } else {
             notifyNoteSelectionChanged(noteSelection_);
@@ -364,20 +362,20 @@ void SelectionManager::removeNoteFromSelection(size_t noteIndex) {
     }
 }
 
-void SelectionManager::toggleNoteSelection(ClipId clipId, size_t noteIndex) {
-    if (isNoteSelected(clipId, noteIndex)) {
-        removeNoteFromSelection(noteIndex);
+void SelectionManager::toggleNoteSelection(ClipId clipId, MidiNoteId noteId) {
+    if (isNoteSelected(clipId, noteId)) {
+        removeNoteFromSelection(noteId);
     } else {
-        addNoteToSelection(clipId, noteIndex);
+        addNoteToSelection(clipId, noteId);
     }
 }
 
-bool SelectionManager::isNoteSelected(ClipId clipId, size_t noteIndex) const {
+bool SelectionManager::isNoteSelected(ClipId clipId, MidiNoteId noteId) const {
     if (selectionType_ != SelectionType::Note || noteSelection_.clipId != clipId) {
         return false;
     }
-    return std::find(noteSelection_.noteIndices.begin(), noteSelection_.noteIndices.end(),
-                     noteIndex) != noteSelection_.noteIndices.end();
+    return std::find(noteSelection_.noteIds.begin(), noteSelection_.noteIds.end(), noteId) !=
+           noteSelection_.noteIds.end();
 }
 
 // ============================================================================
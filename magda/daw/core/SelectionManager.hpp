@@ -293,18 +293,18 @@ struct ChainNodePath {
  */
 struct NoteSelection {
     ClipId clipId = INVALID_CLIP_ID;
-    std::vector<size_t> noteIndices;  // Indices into clip's midiNotes vector
+    std::vector<MidiNoteId> noteIds;  // Ids of notes in the clip's midiNotes
 
     bool isValid() const {
-        return clipId != INVALID_CLIP_ID && !noteIndices.empty();
+        return clipId != INVALID_CLIP_ID && !noteIds.empty();
     }
 
     bool isSingleNote() const {
-        return noteIndices.size() == 1;
+        return noteIds.size() == 1;
     }
 
     size_t getCount() const {
-        return noteIndices.size();
+        return noteIds.size();
     }
 };
 
@@ -690,27 +690,27 @@ class SelectionManager {
     /**
      * @brief Select a single MIDI note (clears other selection types)
      */
-    void selectNote(ClipId clipId, size_t noteIndex);
+    void selectNote(ClipId clipId, MidiNoteId noteId);
 
     /**
      * @brief Select multiple MIDI notes in the same clip
      */
-    void selectNotes(ClipId clipId, const std::vector<size_t>& noteIndices);
+    void selectNotes(ClipId clipId, const std::vector<MidiNoteId>& noteIds);
 
     /**
      * @brief Add a note to the current selection
      */
-    void addNoteToSelection(ClipId clipId, size_t noteIndex);
+    void addNoteToSelection(ClipId clipId, MidiNoteId noteId);
 
     /**
      * @brief Remove a note from the current selection
      */
-    void removeNoteFromSelection(size_t noteIndex);
+    void removeNoteFromSelection(MidiNoteId noteId);
 
     /**
      * @brief Toggle a note's selection state
      */
-    void toggleNoteSelection(ClipId clipId, size_t noteIndex);
+    void toggleNoteSelection(ClipId clipId, MidiNoteId noteId);
 
     /**
      * @brief Get the current note selection
@@ -722,7 +722,7 @@ class SelectionManager {
     /**
      * @brief Check if a specific note is selected
      */
-    bool isNoteSelected(ClipId clipId, size_t noteIndex) const;
+    bool isNoteSelected(ClipId clipId, MidiNoteId noteId) const;
 
     /**
      * @brief Check if there's a valid note selection
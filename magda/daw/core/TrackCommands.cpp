@@ -4,6 +4,27 @@
 
 namespace magda {
 
+namespace {
+
+// Approximate footprint of a chain tree (racks nest whole chains of their own)
+size_t estimateChainBytes(const std::vector<ChainElement>& elements) {
+    size_t total = elements.capacity() * sizeof(ChainElement);
+    for (const auto& element : elements) {
+        if (isDevice(element)) {
+            total += getDevice(element).visibleParameters.capacity() * sizeof(int);
+        } else {
+            const auto& rack = getRack(element);
+            total += sizeof(RackInfo) + rack.chains.capacity() * sizeof(ChainInfo);
+            for (const auto& chain : rack.chains) {
+                total += estimateChainBytes(chain.elements);
+            }
+        }
+    }
+    return total;
+}
+
+}  // namespace
+
 // ============================================================================
 // CreateTrackCommand
 // ============================================================================
@@ -63,10 +84,9 @@ void DeleteTrackCommand::execute() {
         return;
     }
 
-    // Store full track info for undo (only on first execute)
-    if (!executed_) {
-        storedTrack_ = *track;
-    }
+    // Snapshot the track being deleted; the copy shares its chain, which the deleted
+    // track then leaves to us
+    storedTrack_ = *track;
 
     trackManager.deleteTrack(trackId_);
     executed_ = true;
@@ -79,10 +99,21 @@ void DeleteTrackCommand::undo() {
         return;
     }
 
+    // Hand the snapshot back rather than keeping a second reference to the chain: the
+    // model may detach from a shared chain at any time, and redo snapshots again
     TrackManager::getInstance().restoreTrack(storedTrack_);
+    storedTrack_ = TrackInfo();
     std::cout << "📝 UNDO: Restored track " << trackId_ << std::endl;
 }
 
+size_t DeleteTrackCommand::getSizeInBytes() const {
+    // A chain still shared with the model is not ours to count
+    if (storedTrack_.chainElements.isShared()) {
+        return sizeof(*this);
+    }
+    return sizeof(*this) + estimateChainBytes(storedTrack_.chainElements);
+}
+
 // ============================================================================
 // DuplicateTrackCommand
 // ============================================================================
@@ -38,6 +38,7 @@ class DeleteTrackCommand : public UndoableCommand {
     juce::String getDescription() const override {
         return "Delete Track";
     }
+    size_t getSizeInBytes() const override;
 
   private:
     TrackId trackId_;
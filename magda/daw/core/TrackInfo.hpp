@@ -35,71 +35,13 @@ struct TrackInfo {
     juce::String audioInputDevice;   // Audio input device/channel (device ID or empty for none)
     juce::String audioOutputDevice;  // Audio output routing (default: "master")
 
-    // Signal chain - ordered list of nodes (devices or racks) on this track
-    std::vector<ChainElement> chainElements;
+    // Signal chain - ordered list of nodes (devices or racks) on this track.
+    // Copies of a TrackInfo share the chain until one of them modifies it.
+    LazyArray<ChainElement> chainElements;
 
     // View settings per view mode
     TrackViewSettingsMap viewSettings;
 
-    // Default constructor
-    TrackInfo() = default;
-
-    // Move operations (default is fine)
-    TrackInfo(TrackInfo&&) = default;
-    TrackInfo& operator=(TrackInfo&&) = default;
-
-    // Copy constructor - deep copies chainElements
-    TrackInfo(const TrackInfo& other)
-        : id(other.id),
-          type(other.type),
-          name(other.name),
-          colour(other.colour),
-          parentId(other.parentId),
-          childIds(other.childIds),
-          volume(other.volume),
-          pan(other.pan),
-          muted(other.muted),
-          soloed(other.soloed),
-          recordArmed(other.recordArmed),
-          midiInputDevice(other.midiInputDevice),
-          midiOutputDevice(other.midiOutputDevice),
-          audioInputDevice(other.audioInputDevice),
-          audioOutputDevice(other.audioOutputDevice),
-          viewSettings(other.viewSettings) {
-        chainElements.reserve(other.chainElements.size());
-        for (const auto& element : other.chainElements) {
-            chainElements.push_back(deepCopyElement(element));
-        }
-    }
-
-    // Copy assignment - deep copies chainElements
-    TrackInfo& operator=(const TrackInfo& other) {
-        if (this != &other) {
-            id = other.id;
-            type = other.type;
-            name = other.name;
-            colour = other.colour;
-            parentId = other.parentId;
-            childIds = other.childIds;
-            volume = other.volume;
-            pan = other.pan;
-            muted = other.muted;
-            soloed = other.soloed;
-            recordArmed = other.recordArmed;
-            midiInputDevice = other.midiInputDevice;
-            midiOutputDevice = other.midiOutputDevice;
-            audioInputDevice = other.audioInputDevice;
-            audioOutputDevice = other.audioOutputDevice;
-            viewSettings = other.viewSettings;
-            chainElements.clear();
-            chainElements.reserve(other.chainElements.size());
-            for (const auto& element : other.chainElements) {
-                chainElements.push_back(deepCopyElement(element));
-            }
-        }
-        return *this;
-    }
-
     // Default track colors
     static inline const std::array<juce::uint32, 8> defaultColors = {
         0xFF5588AA,  // Blue
@@ -1,6 +1,7 @@
 #include "TrackManager.hpp"
 
 #include <algorithm>
+#include <utility>
 
 #include "../audio/AudioBridge.hpp"
 #include "../audio/MidiBridge.hpp"
@@ -10,6 +11,17 @@
 
 namespace magda {
 
+namespace {
+
+// The chain node index hands out const pointers; the non-const getters make them writable
+// only after getWritableChainNodeIndex() has given the track a chain of its own
+template <typename T>
+T* writable(const T* element) {
+    return const_cast<T*>(element);
+}
+
+}  // namespace
+
 TrackManager& TrackManager::getInstance() {
     static TrackManager instance;
     return instance;
@@ -38,8 +50,9 @@ TrackId TrackManager::createTrack(const juce::String& name, TrackType type) {
     // midiOutputDevice left empty - requires specific device selection
 
     TrackId trackId = track.id;
+    trackIndex_.add(trackId, tracks_.size());
     tracks_.push_back(track);
-    notifyTracksChanged();
+    notifyTrackAdded(trackId);
 
     DBG("Created track: " << track.name << " (id=" << trackId << ", type=" << getTrackTypeName(type)
                           << ")");
@@ -70,6 +83,7 @@ void TrackManager::deleteTrack(TrackId trackId) {
         if (auto* parent = getTrack(track->parentId)) {
             auto& children = parent->childIds;
             children.erase(std::remove(children.begin(), children.end(), trackId), children.end());
+            notifyTrackPropertyChanged(parent->id);
         }
     }
 
@@ -82,29 +96,27 @@ void TrackManager::deleteTrack(TrackId trackId) {
         }
     }
 
-    // Remove the track itself
-    auto it = std::find_if(tracks_.begin(), tracks_.end(),
-                           [trackId](const TrackInfo& t) { return t.id == trackId; });
-
-    if (it != tracks_.end()) {
-        DBG("Deleted track: " << it->name << " (id=" << trackId << ")");
-        tracks_.erase(it);
-        notifyTracksChanged();
+    // Remove the track itself (children were removed above, so look it up again)
+    if (const auto* removed = getTrack(trackId)) {
+        DBG("Deleted track: " << removed->name << " (id=" << trackId << ")");
+        trackIndex_.erase(tracks_, trackId);
+        notifyTrackRemoved(trackId);
     }
 }
 
 void TrackManager::restoreTrack(const TrackInfo& trackInfo) {
     // Check if a track with this ID already exists
-    auto it = std::find_if(tracks_.begin(), tracks_.end(),
-                           [&trackInfo](const TrackInfo& t) { return t.id == trackInfo.id; });
-
-    if (it != tracks_.end()) {
+    if (trackIndex_.contains(trackInfo.id)) {
         DBG("Warning: Track with id=" << trackInfo.id << " already exists, skipping restore");
         return;
     }
 
+    trackIndex_.add(trackInfo.id, tracks_.size());
     tracks_.push_back(trackInfo);
 
+    // The undo snapshot keeps its copy; the live track must not write into it
+    tracks_.back().chainElements.unshare();
+
     // Ensure nextTrackId_ is beyond any restored track IDs
     if (trackInfo.id >= nextTrackId_) {
         nextTrackId_ = trackInfo.id + 1;
@@ -116,27 +128,30 @@ void TrackManager::restoreTrack(const TrackInfo& trackInfo) {
             if (std::find(parent->childIds.begin(), parent->childIds.end(), trackInfo.id) ==
                 parent->childIds.end()) {
                 parent->childIds.push_back(trackInfo.id);
+                notifyTrackPropertyChanged(parent->id);
             }
         }
     }
 
-    notifyTracksChanged();
+    notifyTrackAdded(trackInfo.id);
     DBG("Restored track: " << trackInfo.name << " (id=" << trackInfo.id << ")");
 }
 
 void TrackManager::duplicateTrack(TrackId trackId) {
-    auto it = std::find_if(tracks_.begin(), tracks_.end(),
-                           [trackId](const TrackInfo& t) { return t.id == trackId; });
+    size_t position = trackIndex_.find(trackId);
 
-    if (it != tracks_.end()) {
-        TrackInfo newTrack = *it;
+    if (position != IdIndex<TrackId>::npos) {
+        TrackInfo newTrack = tracks_[position];
         newTrack.id = nextTrackId_++;
-        newTrack.name = it->name + " Copy";
+        newTrack.name = tracks_[position].name + " Copy";
         newTrack.childIds.clear();  // Don't duplicate children references
 
-        // Insert after the original
-        auto insertPos = it + 1;
-        tracks_.insert(insertPos, newTrack);
+        // Insert after the original, with a chain of its own: both tracks are live, and
+        // mod updates and editors write into their chains through element pointers
+        auto inserted =
+            tracks_.insert(tracks_.begin() + static_cast<std::ptrdiff_t>(position) + 1, newTrack);
+        inserted->chainElements.unshare();
+        trackIndex_.rebuild(tracks_);
 
         // If the original had a parent, add the copy to the same parent
         if (newTrack.hasParent()) {
@@ -145,7 +160,7 @@ void TrackManager::duplicateTrack(TrackId trackId) {
             }
         }
 
-        notifyTracksChanged();
+        notifyTrackAdded(newTrack.id);
         DBG("Duplicated track: " << newTrack.name << " (id=" << newTrack.id << ")");
     }
 }
@@ -157,9 +172,10 @@ void TrackManager::moveTrack(TrackId trackId, int newIndex) {
     }
 
     if (currentIndex != newIndex) {
-        TrackInfo track = tracks_[currentIndex];
+        TrackInfo track = std::move(tracks_[currentIndex]);
         tracks_.erase(tracks_.begin() + currentIndex);
-        tracks_.insert(tracks_.begin() + newIndex, track);
+        tracks_.insert(tracks_.begin() + newIndex, std::move(track));
+        trackIndex_.rebuild(tracks_);
         notifyTracksChanged();
     }
 }
@@ -193,6 +209,9 @@ void TrackManager::addTrackToGroup(TrackId trackId, TrackId groupId) {
     track->parentId = groupId;
     group->childIds.push_back(trackId);
 
+    // Both tracks' own properties changed, besides the shape of the list
+    notifyTrackPropertyChanged(trackId);
+    notifyTrackPropertyChanged(groupId);
     notifyTracksChanged();
     DBG("Added track " << track->name << " to group " << group->name);
 }
@@ -205,9 +224,11 @@ void TrackManager::removeTrackFromGroup(TrackId trackId) {
     if (auto* parent = getTrack(track->parentId)) {
         auto& children = parent->childIds;
         children.erase(std::remove(children.begin(), children.end(), trackId), children.end());
+        notifyTrackPropertyChanged(parent->id);
     }
 
     track->parentId = INVALID_TRACK_ID;
+    notifyTrackPropertyChanged(trackId);
     notifyTracksChanged();
 }
 
@@ -268,24 +289,16 @@ std::vector<TrackId> TrackManager::getAllDescendants(TrackId trackId) const {
 // ============================================================================
 
 TrackInfo* TrackManager::getTrack(TrackId trackId) {
-    auto it = std::find_if(tracks_.begin(), tracks_.end(),
-                           [trackId](const TrackInfo& t) { return t.id == trackId; });
-    return (it != tracks_.end()) ? &(*it) : nullptr;
+    return trackIndex_.lookup(tracks_, trackId);
 }
 
 const TrackInfo* TrackManager::getTrack(TrackId trackId) const {
-    auto it = std::find_if(tracks_.begin(), tracks_.end(),
-                           [trackId](const TrackInfo& t) { return t.id == trackId; });
-    return (it != tracks_.end()) ? &(*it) : nullptr;
+    return trackIndex_.lookup(tracks_, trackId);
 }
 
 int TrackManager::getTrackIndex(TrackId trackId) const {
-    for (size_t i = 0; i < tracks_.size(); ++i) {
-        if (tracks_[i].id == trackId) {
-            return static_cast<int>(i);
-        }
-    }
-    return -1;
+    size_t position = trackIndex_.find(trackId);
+    return position != IdIndex<TrackId>::npos ? static_cast<int>(position) : -1;
 }
 
 // ============================================================================
@@ -569,14 +582,15 @@ DeviceId TrackManager::addDeviceToTrack(TrackId trackId, const DeviceInfo& devic
 
 void TrackManager::removeDeviceFromTrack(TrackId trackId, DeviceId deviceId) {
     if (auto* track = getTrack(trackId)) {
-        auto& elements = track->chainElements;
+        // Search read-only: only a removal may detach the chain, and that one notifies
+        const auto& elements = std::as_const(track->chainElements);
         auto it = std::find_if(elements.begin(), elements.end(), [deviceId](const ChainElement& e) {
             return magda::isDevice(e) && magda::getDevice(e).id == deviceId;
         });
         if (it != elements.end()) {
             DBG("Removed device: " << magda::getDevice(*it).name << " (id=" << deviceId
                                    << ") from track " << trackId);
-            elements.erase(it);
+            track->chainElements.erase(it);
             notifyTrackDevicesChanged(trackId);
         }
     }
@@ -590,14 +604,9 @@ void TrackManager::setDeviceBypassed(TrackId trackId, DeviceId deviceId, bool by
 }
 
 DeviceInfo* TrackManager::getDevice(TrackId trackId, DeviceId deviceId) {
-    if (auto* track = getTrack(trackId)) {
-        for (auto& element : track->chainElements) {
-            if (magda::isDevice(element) && magda::getDevice(element).id == deviceId) {
-                return &magda::getDevice(element);
-            }
-        }
-    }
-    return nullptr;
+    const auto* node =
+        getWritableChainNodeIndex(trackId).find(trackId, ChainStepType::Device, deviceId);
+    return node && node->chain == nullptr ? writable(node->device) : nullptr;
 }
 
 // ============================================================================
@@ -627,39 +636,28 @@ RackId TrackManager::addRackToTrack(TrackId trackId, const juce::String& name) {
 
 void TrackManager::removeRackFromTrack(TrackId trackId, RackId rackId) {
     if (auto* track = getTrack(trackId)) {
-        auto& elements = track->chainElements;
+        const auto& elements = std::as_const(track->chainElements);
         auto it = std::find_if(elements.begin(), elements.end(), [rackId](const ChainElement& e) {
             return magda::isRack(e) && magda::getRack(e).id == rackId;
         });
         if (it != elements.end()) {
             DBG("Removed rack: " << magda::getRack(*it).name << " (id=" << rackId << ") from track "
                                  << trackId);
-            elements.erase(it);
+            track->chainElements.erase(it);
             notifyTrackDevicesChanged(trackId);
         }
     }
 }
 
 RackInfo* TrackManager::getRack(TrackId trackId, RackId rackId) {
-    if (auto* track = getTrack(trackId)) {
-        for (auto& element : track->chainElements) {
-            if (magda::isRack(element) && magda::getRack(element).id == rackId) {
-                return &magda::getRack(element);
-            }
-        }
-    }
-    return nullptr;
+    getWritableChainNodeIndex(trackId);
+    return writable(std::as_const(*this).getRack(trackId, rackId));
 }
 
 const RackInfo* TrackManager::getRack(TrackId trackId, RackId rackId) const {
-    if (const auto* track = getTrack(trackId)) {
-        for (const auto& element : track->chainElements) {
-            if (magda::isRack(element) && magda::getRack(element).id == rackId) {
-                return &magda::getRack(element);
-            }
-        }
-    }
-    return nullptr;
+    // Top-level racks only, as before
+    const auto* node = getChainNodeIndex().find(trackId, ChainStepType::Rack, rackId);
+    return node && node->path.depth() == 1 ? node->rack : nullptr;
 }
 
 void TrackManager::setRackBypassed(TrackId trackId, RackId rackId, bool bypassed) {
@@ -681,64 +679,27 @@ void TrackManager::setRackExpanded(TrackId trackId, RackId rackId, bool expanded
 // ============================================================================
 
 RackInfo* TrackManager::getRackByPath(const ChainNodePath& rackPath) {
-    auto* track = getTrack(rackPath.trackId);
-    if (!track) {
-        return nullptr;
-    }
-
-    RackInfo* currentRack = nullptr;
-    ChainInfo* currentChain = nullptr;
+    getWritableChainNodeIndex(rackPath.trackId);
+    return writable(std::as_const(*this).getRackByPath(rackPath));
+}
 
-    for (const auto& step : rackPath.steps) {
-        switch (step.type) {
-            case ChainStepType::Rack: {
-                if (currentChain == nullptr) {
-                    // Top-level rack in track's chainElements
-                    for (auto& element : track->chainElements) {
-                        if (magda::isRack(element)) {
-                            if (magda::getRack(element).id == step.id) {
-                                currentRack = &magda::getRack(element);
-                                break;
-                            }
-                        }
-                    }
-                } else {
-                    // Nested rack within a chain
-                    for (auto& element : currentChain->elements) {
-                        if (magda::isRack(element)) {
-                            if (magda::getRack(element).id == step.id) {
-                                currentRack = &magda::getRack(element);
-                                currentChain = nullptr;  // Reset chain context
-                                break;
-                            }
-                        }
-                    }
-                }
-                break;
-            }
-            case ChainStepType::Chain: {
-                if (currentRack != nullptr) {
-                    for (auto& chain : currentRack->chains) {
-                        if (chain.id == step.id) {
-                            currentChain = &chain;
-                            break;
-                        }
-                    }
-                }
-                break;
-            }
-            case ChainStepType::Device:
-                // Devices don't contain racks, skip
-                break;
-        }
+const RackInfo* TrackManager::getRackByPath(const ChainNodePath& rackPath) const {
+    // Resolve up to the last Rack step (a path into a rack names its rack too)
+    size_t rackSteps = rackPath.steps.size();
+    while (rackSteps > 0 && rackPath.steps[rackSteps - 1].type != ChainStepType::Rack) {
+        --rackSteps;
+    }
+    if (rackSteps == 0) {
+        return nullptr;
     }
 
-    return currentRack;
-}
+    ChainNodePath path;
+    path.trackId = rackPath.trackId;
+    path.steps.assign(rackPath.steps.begin(),
+                      rackPath.steps.begin() + static_cast<std::ptrdiff_t>(rackSteps));
 
-const RackInfo* TrackManager::getRackByPath(const ChainNodePath& rackPath) const {
-    // const version - delegates to non-const via const_cast (safe since we return const*)
-    return const_cast<TrackManager*>(this)->getRackByPath(rackPath);
+    const auto* node = getChainNodeIndex().resolve(path);
+    return node ? node->rack : nullptr;
 }
 
 ChainId TrackManager::addChainToRack(const ChainNodePath& rackPath, const juce::String& name) {
@@ -807,27 +768,14 @@ void TrackManager::removeChainByPath(const ChainNodePath& chainPath) {
 }
 
 ChainInfo* TrackManager::getChain(TrackId trackId, RackId rackId, ChainId chainId) {
-    if (auto* rack = getRack(trackId, rackId)) {
-        auto& chains = rack->chains;
-        auto it = std::find_if(chains.begin(), chains.end(),
-                               [chainId](const ChainInfo& c) { return c.id == chainId; });
-        if (it != chains.end()) {
-            return &(*it);
-        }
-    }
-    return nullptr;
+    getWritableChainNodeIndex(trackId);
+    return writable(std::as_const(*this).getChain(trackId, rackId, chainId));
 }
 
 const ChainInfo* TrackManager::getChain(TrackId trackId, RackId rackId, ChainId chainId) const {
-    if (const auto* rack = getRack(trackId, rackId)) {
-        const auto& chains = rack->chains;
-        auto it = std::find_if(chains.begin(), chains.end(),
-                               [chainId](const ChainInfo& c) { return c.id == chainId; });
-        if (it != chains.end()) {
-            return &(*it);
-        }
-    }
-    return nullptr;
+    // Chains of top-level racks only, as before
+    const auto* node = getChainNodeIndex().resolve(ChainNodePath::chain(trackId, rackId, chainId));
+    return node ? node->chain : nullptr;
 }
 
 void TrackManager::setChainOutput(TrackId trackId, RackId rackId, ChainId chainId,
@@ -1102,14 +1050,9 @@ void TrackManager::moveElementInChainByPath(const ChainNodePath& chainPath, int
 
 DeviceInfo* TrackManager::getDeviceInChain(TrackId trackId, RackId rackId, ChainId chainId,
                                            DeviceId deviceId) {
-    if (auto* chain = getChain(trackId, rackId, chainId)) {
-        for (auto& element : chain->elements) {
-            if (magda::isDevice(element) && magda::getDevice(element).id == deviceId) {
-                return &magda::getDevice(element);
-            }
-        }
-    }
-    return nullptr;
+    const auto* node = getWritableChainNodeIndex(trackId).resolve(
+        ChainNodePath::chainDevice(trackId, rackId, chainId, deviceId));
+    return node ? writable(node->device) : nullptr;
 }
 
 void TrackManager::setDeviceInChainBypassed(TrackId trackId, RackId rackId, ChainId chainId,
@@ -1122,30 +1065,17 @@ void TrackManager::setDeviceInChainBypassed(TrackId trackId, RackId rackId, Chai
 
 // Helper to get chain from a path that ends with Chain step
 static ChainInfo* getChainFromPath(TrackManager& tm, const ChainNodePath& chainPath) {
-    if (chainPath.steps.empty())
-        return nullptr;
-
-    // Extract chainId from the last step (should be Chain type)
-    ChainId chainId = INVALID_CHAIN_ID;
-    if (chainPath.steps.back().type == ChainStepType::Chain) {
-        chainId = chainPath.steps.back().id;
-    } else {
+    if (chainPath.getType() != ChainNodeType::Chain) {
         return nullptr;
     }
-
-    // Build the parent rack path
-    ChainNodePath rackPath;
-    rackPath.trackId = chainPath.trackId;
-    for (size_t i = 0; i < chainPath.steps.size() - 1; ++i) {
-        rackPath.steps.push_back(chainPath.steps[i]);
+    // getRackByPath() stops at the last Rack step and hands the rack out writable
+    auto* rack = tm.getRackByPath(chainPath);
+    if (!rack) {
+        return nullptr;
     }
-
-    // Get the parent rack and find the chain
-    if (auto* rack = tm.getRackByPath(rackPath)) {
-        for (auto& c : rack->chains) {
-            if (c.id == chainId) {
-                return &c;
-            }
+    for (auto& chain : rack->chains) {
+        if (chain.id == chainPath.steps.back().id) {
+            return &chain;
         }
     }
     return nullptr;
@@ -1157,7 +1087,7 @@ void TrackManager::removeDeviceFromChainByPath(const ChainNodePath& devicePath)
         auto* track = getTrack(devicePath.trackId);
         if (!track)
             return;
-        auto& elements = track->chainElements;
+        const auto& elements = std::as_const(track->chainElements);
         auto it =
             std::find_if(elements.begin(), elements.end(), [&devicePath](const ChainElement& e) {
                 return magda::isDevice(e) && magda::getDevice(e).id == devicePath.topLevelDeviceId;
@@ -1165,7 +1095,7 @@ void TrackManager::removeDeviceFromChainByPath(const ChainNodePath& devicePath)
         if (it != elements.end()) {
             DBG("Removed top-level device: " << magda::getDevice(*it).name
                                              << " (id=" << devicePath.topLevelDeviceId << ")");
-            elements.erase(it);
+            track->chainElements.erase(it);
             notifyTrackDevicesChanged(devicePath.trackId);
         }
         return;
@@ -1205,61 +1135,28 @@ void TrackManager::removeDeviceFromChainByPath(const ChainNodePath& devicePath)
 }
 
 DeviceInfo* TrackManager::getDeviceInChainByPath(const ChainNodePath& devicePath) {
-    // Handle top-level device (legacy path format with topLevelDeviceId)
-    if (devicePath.topLevelDeviceId != INVALID_DEVICE_ID) {
-        auto* track = getTrack(devicePath.trackId);
-        if (!track)
-            return nullptr;
-        for (auto& element : track->chainElements) {
-            if (magda::isDevice(element) &&
-                magda::getDevice(element).id == devicePath.topLevelDeviceId) {
-                return &magda::getDevice(element);
-            }
-        }
-        return nullptr;
-    }
-
-    // devicePath ends with a Device step
-    if (devicePath.steps.empty()) {
-        return nullptr;
-    }
+    // Accepts topLevelDeviceId paths as well as paths ending with a Device step
+    const auto* node = getWritableChainNodeIndex(devicePath.trackId).resolve(devicePath);
+    return node ? writable(node->device) : nullptr;
+}
 
-    DeviceId deviceId = INVALID_DEVICE_ID;
-    if (devicePath.steps.back().type == ChainStepType::Device) {
-        deviceId = devicePath.steps.back().id;
-    } else {
+DeviceInfo* TrackManager::getDeviceById(DeviceId deviceId) {
+    const auto* node = getChainNodeIndex().find(ChainStepType::Device, deviceId);
+    if (!node) {
         return nullptr;
     }
+    getWritableChainNodeIndex(node->path.trackId);
+    return writable(std::as_const(*this).getDeviceById(deviceId));
+}
 
-    // Build chain path (all steps except the last Device step)
-    ChainNodePath chainPath;
-    chainPath.trackId = devicePath.trackId;
-    for (size_t i = 0; i < devicePath.steps.size() - 1; ++i) {
-        chainPath.steps.push_back(devicePath.steps[i]);
-    }
-
-    // If chainPath is empty, device is at top-level of track
-    if (chainPath.steps.empty()) {
-        auto* track = getTrack(devicePath.trackId);
-        if (!track)
-            return nullptr;
-        for (auto& element : track->chainElements) {
-            if (magda::isDevice(element) && magda::getDevice(element).id == deviceId) {
-                return &magda::getDevice(element);
-            }
-        }
-        return nullptr;
-    }
+const DeviceInfo* TrackManager::getDeviceById(DeviceId deviceId) const {
+    const auto* node = getChainNodeIndex().find(ChainStepType::Device, deviceId);
+    return node ? node->device : nullptr;
+}
 
-    // Otherwise, device is inside a chain
-    if (auto* chain = getChainFromPath(*this, chainPath)) {
-        for (auto& element : chain->elements) {
-            if (magda::isDevice(element) && magda::getDevice(element).id == deviceId) {
-                return &magda::getDevice(element);
-            }
-        }
-    }
-    return nullptr;
+ChainNodePath TrackManager::getDevicePath(DeviceId deviceId) const {
+    const auto* node = getChainNodeIndex().find(ChainStepType::Device, deviceId);
+    return node ? node->path : ChainNodePath{};
 }
 
 void TrackManager::setDeviceInChainBypassedByPath(const ChainNodePath& devicePath, bool bypassed) {
@@ -1287,37 +1184,32 @@ void TrackManager::setDeviceLevel(const ChainNodePath& devicePath, float level)
     }
 }
 
-void TrackManager::updateDeviceParameters(DeviceId deviceId,
-                                          const std::vector<ParameterInfo>& params) {
-    // Search all tracks for the device and update its parameters
-    for (auto& track : tracks_) {
-        for (auto& element : track.chainElements) {
-            if (std::holds_alternative<DeviceInfo>(element)) {
-                auto& device = std::get<DeviceInfo>(element);
-                if (device.id == deviceId) {
-                    device.parameters = params;
-                    // Don't notify - this is called during device loading, not user interaction
-                    return;
-                }
-            }
-        }
+void TrackManager::updateDeviceParameters(DeviceId deviceId, const ParameterList& params) {
+    if (auto* device = getDeviceById(deviceId)) {
+        device->parameters = params;
+        // Don't notify - this is called during device loading, not user interaction
     }
 }
 
 void TrackManager::setDeviceVisibleParameters(DeviceId deviceId,
                                               const std::vector<int>& visibleParams) {
-    // Search all tracks for the device and update visible parameters
-    for (auto& track : tracks_) {
-        for (auto& element : track.chainElements) {
-            if (std::holds_alternative<DeviceInfo>(element)) {
-                auto& device = std::get<DeviceInfo>(element);
-                if (device.id == deviceId) {
-                    device.visibleParameters = visibleParams;
-                    // Don't notify - this is called during device loading, not user interaction
-                    return;
-                }
-            }
-        }
+    if (auto* device = getDeviceById(deviceId)) {
+        device->visibleParameters = visibleParams;
+        // Don't notify - this is called during device loading, not user interaction
+    }
+}
+
+void TrackManager::setDeviceLoadState(TrackId trackId, DeviceId deviceId, DeviceLoadState state) {
+    auto* device = getDevice(trackId, deviceId);
+    if (!device || device->loadState == state) {
+        return;
+    }
+
+    bool wasLoading = device->loadState == DeviceLoadState::Loading;
+    device->loadState = state;
+
+    if (wasLoading) {
+        notifyTrackDevicesChanged(trackId);
     }
 }
 
@@ -1758,7 +1650,9 @@ void TrackManager::addRackMod(const ChainNodePath& rackPath, int slotIndex, ModT
                 rack->mods[i].id = i;
             }
 
-            // Don't notify - caller handles UI update to avoid panel closing
+            // Don't notify - caller handles UI update to avoid panel closing. The insert
+            // may have moved the mods, so the chain graph still has to be rebuilt
+            chainNodeIndex_.invalidate(rackPath.trackId);
         }
     }
 }
@@ -1990,7 +1884,9 @@ void TrackManager::addDeviceMod(const ChainNodePath& devicePath, int slotIndex,
                 device->mods[i].id = i;
             }
 
-            // Don't notify - caller handles UI update to avoid panel closing
+            // Don't notify - caller handles UI update to avoid panel closing. The insert
+            // may have moved the mods, so the chain graph still has to be rebuilt
+            chainNodeIndex_.invalidate(devicePath.trackId);
         }
     }
 }
@@ -2093,35 +1989,16 @@ void TrackManager::updateAllMods(double deltaTime, double bpm, bool transportJus
         }
     };
 
-    // Recursive lambda to update mods in chain elements
-    std::function<void(ChainElement&)> updateElementMods = [&](ChainElement& element) {
-        if (isDevice(element)) {
-            // Update device mods
-            DeviceInfo& device = magda::getDevice(element);
-            for (auto& mod : device.mods) {
-                updateMod(mod);
-            }
-        } else if (isRack(element)) {
-            // Update rack mods
-            RackInfo& rack = magda::getRack(element);
-            for (auto& mod : rack.mods) {
-                updateMod(mod);
-            }
-            // Recursively update mods in nested chains
-            for (auto& chain : rack.chains) {
-                for (auto& chainElement : chain.elements) {
-                    updateElementMods(chainElement);
-                }
+    // Every mod on a track sits in one flat array of its chain graph. Taking a chain for
+    // writing may detach it from an undo snapshot; the transaction holds that notification
+    // back until the loop is done with tracks_
+    ModelTransactionScope transaction;
+    for (const auto& track : tracks_) {
+        if (const auto* graph = getWritableChainNodeIndex(track.id).getGraph(track.id)) {
+            for (const auto* mod : graph->mods) {
+                updateMod(*writable(mod));
             }
         }
-    };
-
-    // Update mods in all tracks
-    for (auto& track : tracks_) {
-        // Update mods in all chain elements
-        for (auto& element : track.chainElements) {
-            updateElementMods(element);
-        }
     }
 
     // DO NOT call notifyModulationChanged() here - that causes 60 FPS UI rebuilds
@@ -2222,93 +2099,77 @@ void TrackManager::removeDeviceMacroPage(const ChainNodePath& devicePath) {
 
 TrackManager::ResolvedPath TrackManager::resolvePath(const ChainNodePath& path) const {
     ResolvedPath result;
+    if (const auto* node = getChainNodeIndex().resolve(path)) {
+        result.valid = true;
+        result.rack = node->rack;
+        result.chain = node->chain;
+        result.device = node->device;
+    }
+    return result;
+}
 
-    const auto* track = getTrack(path.trackId);
-    if (!track) {
-        return result;
+juce::String TrackManager::getDisplayPath(const ChainNodePath& path) const {
+    if (!resolvePath(path).valid) {
+        return {};
     }
 
-    // Handle top-level device (legacy)
+    const auto& index = getChainNodeIndex();
     if (path.topLevelDeviceId != INVALID_DEVICE_ID) {
-        for (const auto& element : track->chainElements) {
-            if (magda::isDevice(element) && magda::getDevice(element).id == path.topLevelDeviceId) {
-                result.valid = true;
-                result.device = &magda::getDevice(element);
-                result.displayPath = result.device->name;
-                return result;
-            }
-        }
-        return result;
+        return index.find(path.trackId, ChainStepType::Device, path.topLevelDeviceId)
+            ->device->name;
     }
 
-    // Walk through the path steps
+    // Every prefix of a valid path is itself indexed
     juce::StringArray pathNames;
-    const RackInfo* currentRack = nullptr;
-    const ChainInfo* currentChain = nullptr;
-
-    for (size_t i = 0; i < path.steps.size(); ++i) {
-        const auto& step = path.steps[i];
-
+    for (const auto& step : path.steps) {
+        const auto* node = index.find(path.trackId, step.type, step.id);
         switch (step.type) {
-            case ChainStepType::Rack: {
-                if (currentChain == nullptr) {
-                    // Top-level rack in track's chainElements
-                    for (const auto& element : track->chainElements) {
-                        if (magda::isRack(element) && magda::getRack(element).id == step.id) {
-                            currentRack = &magda::getRack(element);
-                            pathNames.add(currentRack->name);
-                            break;
-                        }
-                    }
-                } else {
-                    // Nested rack within a chain
-                    for (const auto& element : currentChain->elements) {
-                        if (magda::isRack(element) && magda::getRack(element).id == step.id) {
-                            currentRack = &magda::getRack(element);
-                            currentChain = nullptr;  // Reset chain context
-                            pathNames.add(currentRack->name);
-                            break;
-                        }
-                    }
-                }
+            case ChainStepType::Rack:
+                pathNames.add(node->rack->name);
                 break;
-            }
-            case ChainStepType::Chain: {
-                if (currentRack != nullptr) {
-                    for (const auto& chain : currentRack->chains) {
-                        if (chain.id == step.id) {
-                            currentChain = &chain;
-                            pathNames.add(chain.name);
-                            break;
-                        }
-                    }
-                }
+            case ChainStepType::Chain:
+                pathNames.add(node->chain->name);
                 break;
-            }
-            case ChainStepType::Device: {
-                if (currentChain != nullptr) {
-                    for (const auto& element : currentChain->elements) {
-                        if (magda::isDevice(element) && magda::getDevice(element).id == step.id) {
-                            result.device = &magda::getDevice(element);
-                            pathNames.add(result.device->name);
-                            break;
-                        }
-                    }
-                }
+            case ChainStepType::Device:
+                pathNames.add(node->device->name);
                 break;
-            }
         }
     }
+    return pathNames.joinIntoString(" > ");
+}
 
-    // Set result based on what we found
-    if (!path.steps.empty()) {
-        result.displayPath = pathNames.joinIntoString(" > ");
-        result.rack = currentRack;
-        result.chain = currentChain;
-        result.valid = !pathNames.isEmpty();
+const ChainGraph* TrackManager::getChainGraph(TrackId trackId) const {
+    return getChainNodeIndex().getGraph(trackId);
+}
+
+const ChainNodeIndex& TrackManager::getChainNodeIndex() const {
+    if (chainNodeIndex_.needsUpdate()) {
+        chainNodeIndex_.update(tracks_);
     }
+    return chainNodeIndex_;
+}
 
-    return result;
+const ChainNodeIndex& TrackManager::getWritableChainNodeIndex(TrackId trackId) {
+    auto* track = getTrack(trackId);
+    if (!track) {
+        return getChainNodeIndex();
+    }
+
+    // Undo snapshots share the chain buffer; taking it for writing detaches it if so.
+    // Element pointers handed out before then (UI editors, live mod pointers) point into
+    // the snapshot's buffer now, so holders are told to fetch them again
+    const bool detaching = track->chainElements.isShared();
+    const auto& elements = track->chainElements.items();
+    if (detaching) {
+        notifyTrackDevicesChanged(trackId);
+    }
+
+    // The index is rebuilt if it was built from any other buffer
+    const auto* graph = getChainNodeIndex().getGraph(trackId);
+    if (graph && graph->elements != &elements) {
+        chainNodeIndex_.invalidate(trackId);
+    }
+    return getChainNodeIndex();
 }
 
 // ============================================================================
@@ -2319,6 +2180,7 @@ void TrackManager::setTrackVisible(TrackId trackId, ViewMode mode, bool visible)
     if (auto* track = getTrack(trackId)) {
         track->viewSettings.setVisible(mode, visible);
         // Use tracksChanged since visibility affects which tracks are displayed
+        notifyTrackPropertyChanged(trackId);
         notifyTracksChanged();
     }
 }
@@ -2334,6 +2196,7 @@ void TrackManager::setTrackCollapsed(TrackId trackId, ViewMode mode, bool collap
     if (auto* track = getTrack(trackId)) {
         track->viewSettings.setCollapsed(mode, collapsed);
         // Use tracksChanged since collapsing affects which child tracks are displayed
+        notifyTrackPropertyChanged(trackId);
         notifyTracksChanged();
     }
 }
@@ -2448,8 +2311,48 @@ void TrackManager::createDefaultTracks(int count) {
 
 void TrackManager::clearAllTracks() {
     tracks_.clear();
+    trackIndex_.clear();
+    nextTrackId_ = 1;
+    notifyTracksChanged();
+}
+
+void TrackManager::loadTracks(std::vector<TrackInfo> tracks, const MasterChannelState& master) {
+    tracks_ = std::move(tracks);
+    for (auto& track : tracks_) {
+        track.chainElements.unshare();
+    }
+    trackIndex_.rebuild(tracks_);
+    masterChannel_ = master;
+    selectedTrackId_ = INVALID_TRACK_ID;
+    clearSelectedChain();
+
     nextTrackId_ = 1;
+    nextDeviceId_ = 1;
+    nextRackId_ = 1;
+    nextChainId_ = 1;
+    for (const auto& track : tracks_) {
+        nextTrackId_ = std::max(nextTrackId_, track.id + 1);
+        reserveChainIds(track.chainElements);
+    }
+
     notifyTracksChanged();
+    notifyMasterChannelChanged();
+}
+
+void TrackManager::reserveChainIds(const std::vector<ChainElement>& elements) {
+    for (const auto& element : elements) {
+        if (isDevice(element)) {
+            nextDeviceId_ = std::max(nextDeviceId_, magda::getDevice(element).id + 1);
+            continue;
+        }
+
+        const auto& rack = magda::getRack(element);
+        nextRackId_ = std::max(nextRackId_, rack.id + 1);
+        for (const auto& chain : rack.chains) {
+            nextChainId_ = std::max(nextChainId_, chain.id + 1);
+            reserveChainIds(chain.elements);
+        }
+    }
 }
 
 // ============================================================================
@@ -2457,18 +2360,53 @@ void TrackManager::clearAllTracks() {
 // ============================================================================
 
 void TrackManager::notifyTracksChanged() {
+    // Tracks may have been added, removed, reordered or replaced
+    chainNodeIndex_.invalidateAll();
+    if (auto* changes = ModelTransactionManager::getInstance().getPendingChanges()) {
+        changes->trackListChanged = true;
+        return;
+    }
     for (auto* listener : listeners_) {
         listener->tracksChanged();
     }
 }
 
+void TrackManager::notifyTrackAdded(TrackId trackId) {
+    if (auto* changes = ModelTransactionManager::getInstance().getPendingChanges()) {
+        changes->tracks.add(trackId);
+    }
+    notifyTracksChanged();
+}
+
+void TrackManager::notifyTrackRemoved(TrackId trackId) {
+    if (auto* changes = ModelTransactionManager::getInstance().getPendingChanges()) {
+        changes->tracks.remove(trackId);
+        changes->trackDevices.erase(trackId);
+    }
+    notifyTracksChanged();
+}
+
+void TrackManager::notifyChangesCommitted(const ModelChangeSet& changes) {
+    for (auto* listener : listeners_) {
+        listener->trackChangesCommitted(changes);
+    }
+}
+
 void TrackManager::notifyTrackPropertyChanged(int trackId) {
+    if (auto* changes = ModelTransactionManager::getInstance().getPendingChanges()) {
+        changes->tracks.modify(trackId);
+        return;
+    }
     for (auto* listener : listeners_) {
         listener->trackPropertyChanged(trackId);
     }
 }
 
 void TrackManager::notifyMasterChannelChanged() {
+    if (auto* changes = ModelTransactionManager::getInstance().getPendingChanges()) {
+        changes->masterChannelChanged = true;
+        return;
+    }
     for (auto* listener : listeners_) {
         listener->masterChannelChanged();
     }
@@ -2481,12 +2419,22 @@ void TrackManager::notifyTrackSelectionChanged(TrackId trackId) {
 }
 
 void TrackManager::notifyTrackDevicesChanged(TrackId trackId) {
+    // Every chain restructure ends here; also cheap enough for property-only changes
+    chainNodeIndex_.invalidate(trackId);
+    if (auto* changes = ModelTransactionManager::getInstance().getPendingChanges()) {
+        changes->trackDevices.insert(trackId);
+        return;
+    }
     for (auto* listener : listeners_) {
         listener->trackDevicesChanged(trackId);
     }
 }
 
 void TrackManager::notifyDevicePropertyChanged(DeviceId deviceId) {
+    if (auto* changes = ModelTransactionManager::getInstance().getPendingChanges()) {
+        changes->devices.insert(deviceId);
+        return;
+    }
     for (auto* listener : listeners_) {
         listener->devicePropertyChanged(deviceId);
     }
@@ -3,6 +3,9 @@
 #include <memory>
 #include <vector>
 
+#include "ChainNodeIndex.hpp"
+#include "IdIndex.hpp"
+#include "ModelTransaction.hpp"
 #include "SelectionManager.hpp"
 #include "TrackInfo.hpp"
 #include "TrackTypes.hpp"
@@ -65,6 +68,27 @@ class TrackManagerListener {
     virtual void deviceParameterChanged(DeviceId deviceId, int paramIndex, float newValue) {
         juce::ignoreUnused(deviceId, paramIndex, newValue);
     }
+
+    // Called once when a model transaction commits, in place of the callbacks above that
+    // it deferred (see ModelTransactionManager). Override to update incrementally; by
+    // default the deferred callbacks are replayed, once per changed item.
+    virtual void trackChangesCommitted(const ModelChangeSet& changes) {
+        if (changes.trackListChanged) {
+            tracksChanged();
+        }
+        if (changes.masterChannelChanged) {
+            masterChannelChanged();
+        }
+        for (auto trackId : changes.tracks.modified) {
+            trackPropertyChanged(trackId);
+        }
+        for (auto trackId : changes.trackDevices) {
+            trackDevicesChanged(trackId);
+        }
+        for (auto deviceId : changes.devices) {
+            devicePropertyChanged(deviceId);
+        }
+    }
 };
 
 /**
@@ -92,6 +116,8 @@ class TrackManager {
      */
     void shutdown() {
         tracks_.clear();  // Clear JUCE::String objects before JUCE cleanup
+        trackIndex_.clear();
+        chainNodeIndex_.invalidateAll();
         listeners_.clear();
         audioEngine_ = nullptr;
     }
@@ -213,6 +239,11 @@ class TrackManager {
     DeviceInfo* getDeviceInChain(TrackId trackId, RackId rackId, ChainId chainId,
                                  DeviceId deviceId);
     DeviceInfo* getDeviceInChainByPath(const ChainNodePath& devicePath);
+
+    // ID-only device lookup, at any depth on any track
+    DeviceInfo* getDeviceById(DeviceId deviceId);
+    const DeviceInfo* getDeviceById(DeviceId deviceId) const;
+    ChainNodePath getDevicePath(DeviceId deviceId) const;  // Invalid path if not found
     void setDeviceInChainBypassed(TrackId trackId, RackId rackId, ChainId chainId,
                                   DeviceId deviceId, bool bypassed);
     void setDeviceInChainBypassedByPath(const ChainNodePath& devicePath, bool bypassed);
@@ -222,9 +253,18 @@ class TrackManager {
     void setDeviceLevel(const ChainNodePath& devicePath, float level);  // 0-1 linear
 
     // Update device parameters (called by AudioBridge when processor is created)
-    void updateDeviceParameters(DeviceId deviceId, const std::vector<ParameterInfo>& params);
+    void updateDeviceParameters(DeviceId deviceId, const ParameterList& params);
     void setDeviceVisibleParameters(DeviceId deviceId, const std::vector<int>& visibleParams);
 
+    /**
+     * @brief Update a device's load state (called by AudioBridge)
+     *
+     * Entering Loading is silent because it happens while AudioBridge is syncing the
+     * track. Leaving Loading notifies trackDevicesChanged so the UI rebuilds the slot
+     * with the loaded plugin's parameters.
+     */
+    void setDeviceLoadState(TrackId trackId, DeviceId deviceId, DeviceLoadState state);
+
     // Set a specific device parameter value
     void setDeviceParameterValue(const ChainNodePath& devicePath, int paramIndex, float value);
 
@@ -325,12 +365,10 @@ class TrackManager {
     /**
      * @brief Result of resolving a ChainNodePath
      *
-     * Contains pointers to the actual data elements along the path,
-     * plus a human-readable path string for display.
+     * Contains pointers to the actual data elements along the path.
      */
     struct ResolvedPath {
         bool valid = false;
-        juce::String displayPath;  // "Rack > Chain > Device" format
 
         // Pointers to actual elements (null if not applicable)
         const RackInfo* rack = nullptr;
@@ -338,17 +376,29 @@ class TrackManager {
         const DeviceInfo* device = nullptr;
 
         // For nested structures, these point to the final element
-        // The path traversal history is in displayPath
     };
 
     /**
      * @brief Resolve a ChainNodePath to actual data elements
      *
-     * Walks the recursive tree structure following the path steps,
-     * returning pointers to the actual elements and a display string.
+     * A hash lookup of the last step in the chain node index, checked against the
+     * node's full path. Valid only if every step of the path exists.
      */
     ResolvedPath resolvePath(const ChainNodePath& path) const;
 
+    /**
+     * @brief "Rack > Chain > Device" display string for a path (empty if invalid)
+     */
+    juce::String getDisplayPath(const ChainNodePath& path) const;
+
+    /**
+     * @brief Flat depth-first view of a track's chain, for walks over a whole chain
+     *
+     * Valid until the chain is next restructured (any notifyTrackDevicesChanged or
+     * tracksChanged); fetch it again rather than holding on to it.
+     */
+    const ChainGraph* getChainGraph(TrackId trackId) const;
+
     // Query tracks by view
     std::vector<TrackId> getVisibleTracks(ViewMode mode) const;
     std::vector<TrackId> getVisibleTopLevelTracks(ViewMode mode) const;
@@ -397,11 +447,28 @@ class TrackManager {
     void createDefaultTracks(int count = 8);
     void clearAllTracks();
 
+    /**
+     * @brief Replace all tracks and the master channel (project load)
+     *
+     * ID counters are moved past every track, device, rack and chain ID in the tree.
+     * Listeners get a single tracksChanged() / masterChannelChanged().
+     */
+    void loadTracks(std::vector<TrackInfo> tracks, const MasterChannelState& master);
+
   private:
     TrackManager();
     ~TrackManager() = default;
 
     std::vector<TrackInfo> tracks_;
+    IdIndex<TrackId> trackIndex_;  // O(1) getTrack() / getTrackIndex()
+
+    // O(1) device/rack/chain lookup; refreshed lazily after notifyTrackDevicesChanged()
+    // and notifyTracksChanged(), which every structural edit already goes through
+    mutable ChainNodeIndex chainNodeIndex_;
+    const ChainNodeIndex& getChainNodeIndex() const;
+
+    // The index with trackId's chain detached from any snapshot, for getters that write
+    const ChainNodeIndex& getWritableChainNodeIndex(TrackId trackId);
     std::vector<TrackManagerListener*> listeners_;
     AudioEngine* audioEngine_ = nullptr;  // Non-owning pointer for routing operations
     int nextTrackId_ = 1;
@@ -415,6 +482,8 @@ class TrackManager {
     ChainId selectedChainId_ = INVALID_CHAIN_ID;
 
     void notifyTracksChanged();
+    void notifyTrackAdded(TrackId trackId);
+    void notifyTrackRemoved(TrackId trackId);
     void notifyTrackPropertyChanged(int trackId);
     void notifyMasterChannelChanged();
     void notifyTrackSelectionChanged(TrackId trackId);
@@ -422,9 +491,16 @@ class TrackManager {
     void notifyDevicePropertyChanged(DeviceId deviceId);
     void notifyDeviceParameterChanged(DeviceId deviceId, int paramIndex, float newValue);
 
+    // Delivers a committed transaction's change set (see ModelTransactionManager)
+    friend class ModelTransactionManager;
+    void notifyChangesCommitted(const ModelChangeSet& changes);
+
     // Helper for recursive mod updates
     void updateRackMods(const RackInfo& rack, double deltaTime);
 
+    // Moves the ID counters past the IDs used in a chain element tree
+    void reserveChainIds(const std::vector<ChainElement>& elements);
+
     juce::String generateTrackName() const;
 };
 
@@ -36,4 +36,8 @@ constexpr AutomationClipId INVALID_AUTOMATION_CLIP_ID = -1;
 using AutomationPointId = int;
 constexpr AutomationPointId INVALID_AUTOMATION_POINT_ID = -1;
 
+// MIDI note identifiers (unique within a clip)
+using MidiNoteId = int;
+constexpr MidiNoteId INVALID_MIDI_NOTE_ID = -1;
+
 }  // namespace magda
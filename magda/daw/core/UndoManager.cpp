@@ -2,6 +2,8 @@
 
 #include <iostream>
 
+#include "ModelTransaction.hpp"
+
 namespace magda {
 
 // ============================================================================
@@ -23,8 +25,11 @@ void UndoManager::executeCommand(std::unique_ptr<UndoableCommand> command) {
 
     std::cout << "📝 UNDO: Executing command: " << command->getDescription() << std::endl;
 
-    // Execute the command
-    command->execute();
+    // Execute the command; listeners hear about everything it changed at once
+    {
+        ModelTransactionScope transaction;
+        command->execute();
+    }
 
     // If in compound operation, collect commands instead of pushing to stack
     if (compoundDepth_ > 0) {
@@ -32,19 +37,38 @@ void UndoManager::executeCommand(std::unique_ptr<UndoableCommand> command) {
         return;
     }
 
-    // Check if we can merge with the previous command
-    if (!undoStack_.empty() && undoStack_.back()->canMergeWith(command.get())) {
-        undoStack_.back()->mergeWith(command.get());
-    } else {
-        // Add to undo stack
-        undoStack_.push_back(std::move(command));
+    auto description = command->getDescription();
+
+    // Coalesce into the previous step. The shape of the history does not change, so
+    // undo-state listeners are not told (the redo stack is already empty).
+    bool foldIntoGesture = isTopCommandFromCurrentGesture();
+    bool mergeWithinWindow = !foldIntoGesture && canMergeWithinWindow(*command);
+    lastCommandTime_ = juce::Time::getMillisecondCounter();
+
+    if (foldIntoGesture) {
+        foldIntoTopCommand(std::move(command));
+        reportPerformed(description);
+        return;
+    }
+    if (mergeWithinWindow) {
+        undoStack_.back().command->mergeWith(command.get());
+        remeasure(undoStack_.back());
         trimUndoStack();
+        reportPerformed(description);
+        return;
     }
 
     // Clear redo stack (new action invalidates redo history)
-    redoStack_.clear();
+    clearRedo();
+
+    // Add to undo stack
+    pushUndo(std::move(command));
+    trimUndoStack();
+    mergeOpen_ = true;
+    lastCommandGesture_ = gestureDepth_ > 0 ? currentGesture_ : 0;
 
     notifyListeners();
+    reportPerformed(description);
 
     std::cout << "📝 UNDO: Executed command, stack size: " << undoStack_.size() << std::endl;
 }
@@ -55,18 +79,24 @@ bool UndoManager::undo() {
     }
 
     // Pop from undo stack
-    auto command = std::move(undoStack_.back());
-    undoStack_.pop_back();
+    auto command = popUndo();
+    closeMerging();
 
     std::cout << "📝 UNDO: Undoing '" << command->getDescription() << "'" << std::endl;
 
     // Undo the command
-    command->undo();
+    {
+        ModelTransactionScope transaction;
+        command->undo();
+    }
+
+    auto description = "Undo " + command->getDescription();
 
     // Push to redo stack
-    redoStack_.push_back(std::move(command));
+    pushRedo(std::move(command));
 
     notifyListeners();
+    notifyCommandPerformed(description);
 
     return true;
 }
@@ -77,18 +107,25 @@ bool UndoManager::redo() {
     }
 
     // Pop from redo stack
-    auto command = std::move(redoStack_.back());
-    redoStack_.pop_back();
+    auto command = popRedo();
+    closeMerging();
 
     std::cout << "📝 UNDO: Redoing '" << command->getDescription() << "'" << std::endl;
 
     // Re-execute the command
-    command->execute();
+    {
+        ModelTransactionScope transaction;
+        command->execute();
+    }
+
+    auto description = "Redo " + command->getDescription();
 
     // Push to undo stack
-    undoStack_.push_back(std::move(command));
+    pushUndo(std::move(command));
+    trimUndoStack();
 
     notifyListeners();
+    notifyCommandPerformed(description);
 
     return true;
 }
@@ -97,21 +134,34 @@ juce::String UndoManager::getUndoDescription() const {
     if (undoStack_.empty()) {
         return {};
     }
-    return undoStack_.back()->getDescription();
+    return undoStack_.back().command->getDescription();
 }
 
 juce::String UndoManager::getRedoDescription() const {
     if (redoStack_.empty()) {
         return {};
     }
-    return redoStack_.back()->getDescription();
+    return redoStack_.back().command->getDescription();
+}
+
+size_t UndoManager::getUndoMemoryUsage() const {
+    // Commands of an open compound operation are not on a stack yet
+    size_t total = historyBytes_;
+    for (const auto& command : compoundCommands_) {
+        total += command->getSizeInBytes();
+    }
+    return total;
 }
 
 void UndoManager::clearHistory() {
     undoStack_.clear();
     redoStack_.clear();
+    historyBytes_ = 0;
     compoundCommands_.clear();
-    compoundDepth_ = 0;
+    for (; compoundDepth_ > 0; --compoundDepth_) {
+        ModelTransactionManager::getInstance().commitTransaction();
+    }
+    closeMerging();
     notifyListeners();
 }
 
@@ -121,6 +171,9 @@ void UndoManager::beginCompoundOperation(const juce::String& description) {
         compoundCommands_.clear();
     }
     compoundDepth_++;
+
+    // The whole group reaches model listeners as one change set
+    ModelTransactionManager::getInstance().beginTransaction();
 }
 
 void UndoManager::endCompoundOperation() {
@@ -129,25 +182,109 @@ void UndoManager::endCompoundOperation() {
     }
 
     compoundDepth_--;
+    ModelTransactionManager::getInstance().commitTransaction();
 
     if (compoundDepth_ == 0 && !compoundCommands_.empty()) {
         // Create compound command and add to undo stack
         auto compound =
             std::make_unique<CompoundCommand>(compoundDescription_, std::move(compoundCommands_));
-        undoStack_.push_back(std::move(compound));
-        trimUndoStack();
+        compoundCommands_.clear();
+
+        if (isTopCommandFromCurrentGesture()) {
+            foldIntoTopCommand(std::move(compound));
+            reportPerformed(compoundDescription_);
+            return;
+        }
 
         // Clear redo stack
-        redoStack_.clear();
+        clearRedo();
+
+        pushUndo(std::move(compound));
+        trimUndoStack();
+
+        // Only a gesture may extend a finished compound operation
+        mergeOpen_ = gestureDepth_ > 0;
+        lastCommandGesture_ = gestureDepth_ > 0 ? currentGesture_ : 0;
 
-        compoundCommands_.clear();
         notifyListeners();
+        reportPerformed(compoundDescription_);
 
         std::cout << "📝 UNDO: Completed compound operation '" << compoundDescription_ << "'"
                   << std::endl;
     }
 }
 
+void UndoManager::beginGesture() {
+    if (gestureDepth_++ == 0) {
+        ++currentGesture_;
+        gestureDescription_.clear();
+    }
+}
+
+void UndoManager::endGesture() {
+    if (gestureDepth_ <= 0) {
+        return;
+    }
+
+    if (--gestureDepth_ == 0) {
+        closeMerging();
+
+        // One report for the whole interaction
+        if (gestureDescription_.isNotEmpty()) {
+            auto description = std::move(gestureDescription_);
+            gestureDescription_.clear();
+            notifyCommandPerformed(description);
+        }
+    }
+}
+
+bool UndoManager::isTopCommandFromCurrentGesture() const {
+    return gestureDepth_ > 0 && mergeOpen_ && !undoStack_.empty() &&
+           lastCommandGesture_ == currentGesture_;
+}
+
+bool UndoManager::canMergeWithinWindow(const UndoableCommand& command) const {
+    if (gestureDepth_ > 0 || !mergeOpen_ || undoStack_.empty() || lastCommandGesture_ != 0 ||
+        mergeWindowMs_ <= 0) {
+        return false;
+    }
+
+    auto elapsed = juce::Time::getMillisecondCounter() - lastCommandTime_;
+    if (elapsed >= static_cast<juce::uint32>(mergeWindowMs_)) {
+        return false;
+    }
+    return undoStack_.back().command->canMergeWith(&command);
+}
+
+void UndoManager::foldIntoTopCommand(std::unique_ptr<UndoableCommand> command) {
+    auto& entry = undoStack_.back();
+    auto& top = entry.command;
+    if (top->canMergeWith(command.get())) {
+        top->mergeWith(command.get());
+        remeasure(entry);
+        trimUndoStack();
+        return;
+    }
+
+    // A different kind of edit in the same interaction: group them into one step
+    auto* group = dynamic_cast<CompoundCommand*>(top.get());
+    if (!group) {
+        auto description = top->getDescription();
+        std::vector<std::unique_ptr<UndoableCommand>> commands;
+        commands.push_back(std::move(top));
+        auto compound = std::make_unique<CompoundCommand>(description, std::move(commands));
+        group = compound.get();
+        top = std::move(compound);
+    }
+    group->append(std::move(command));
+    remeasure(entry);
+    trimUndoStack();
+}
+
+void UndoManager::closeMerging() {
+    mergeOpen_ = false;
+}
+
 void UndoManager::addListener(UndoManagerListener* listener) {
     if (listener && std::find(listeners_.begin(), listeners_.end(), listener) == listeners_.end()) {
         listeners_.push_back(listener);
@@ -164,10 +301,79 @@ void UndoManager::notifyListeners() {
     }
 }
 
+void UndoManager::notifyCommandPerformed(const juce::String& description) {
+    for (auto* listener : listeners_) {
+        listener->commandPerformed(description);
+    }
+}
+
+void UndoManager::reportPerformed(const juce::String& description) {
+    // Deferred to the end of an open gesture
+    if (gestureDepth_ > 0) {
+        gestureDescription_ = description;
+    } else {
+        notifyCommandPerformed(description);
+    }
+}
+
 void UndoManager::trimUndoStack() {
     while (undoStack_.size() > maxUndoSteps_) {
-        undoStack_.pop_front();
+        dropOldestUndo();
     }
+
+    while (historyBytes_ > maxUndoBytes_ && undoStack_.size() > 1) {
+        dropOldestUndo();
+    }
+}
+
+void UndoManager::pushUndo(std::unique_ptr<UndoableCommand> command) {
+    // The new step's edit is what detaches payloads the previous step still shared
+    // with the model, so that is the one step whose size may have grown
+    if (!undoStack_.empty()) {
+        remeasure(undoStack_.back());
+    }
+
+    auto bytes = command->getSizeInBytes();
+    historyBytes_ += bytes;
+    undoStack_.push_back({std::move(command), bytes});
+}
+
+std::unique_ptr<UndoableCommand> UndoManager::popUndo() {
+    auto command = std::move(undoStack_.back().command);
+    historyBytes_ -= undoStack_.back().bytes;
+    undoStack_.pop_back();
+    return command;
+}
+
+void UndoManager::dropOldestUndo() {
+    historyBytes_ -= undoStack_.front().bytes;
+    undoStack_.pop_front();
+}
+
+void UndoManager::pushRedo(std::unique_ptr<UndoableCommand> command) {
+    auto bytes = command->getSizeInBytes();
+    historyBytes_ += bytes;
+    redoStack_.push_back({std::move(command), bytes});
+}
+
+std::unique_ptr<UndoableCommand> UndoManager::popRedo() {
+    auto command = std::move(redoStack_.back().command);
+    historyBytes_ -= redoStack_.back().bytes;
+    redoStack_.pop_back();
+    return command;
+}
+
+void UndoManager::clearRedo() {
+    for (const auto& entry : redoStack_) {
+        historyBytes_ -= entry.bytes;
+    }
+    redoStack_.clear();
+}
+
+void UndoManager::remeasure(HistoryEntry& entry) {
+    historyBytes_ -= entry.bytes;
+    entry.bytes = entry.command->getSizeInBytes();
+    historyBytes_ += entry.bytes;
 }
 
 // ============================================================================
@@ -192,6 +398,38 @@ void CompoundCommand::undo() {
     }
 }
 
+void CompoundCommand::append(std::unique_ptr<UndoableCommand> command) {
+    commands_.push_back(std::move(command));
+}
+
+bool CompoundCommand::canMergeWith(const UndoableCommand* other) const {
+    return !commands_.empty() && commands_.back()->canMergeWith(other);
+}
+
+void CompoundCommand::mergeWith(const UndoableCommand* other) {
+    commands_.back()->mergeWith(other);
+}
+
+size_t CompoundCommand::getSizeInBytes() const {
+    size_t total = UndoableCommand::getSizeInBytes();
+    for (const auto& cmd : commands_) {
+        total += cmd->getSizeInBytes();
+    }
+    return total;
+}
+
+// ============================================================================
+// GestureScope Implementation
+// ============================================================================
+
+GestureScope::GestureScope() {
+    UndoManager::getInstance().beginGesture();
+}
+
+GestureScope::~GestureScope() {
+    UndoManager::getInstance().endGesture();
+}
+
 // ============================================================================
 // CompoundOperationScope Implementation
 // ============================================================================
@@ -39,7 +39,9 @@ class UndoableCommand {
     /**
      * Check if this command can be merged with another command.
      * Used for coalescing rapid repeated operations (e.g., multiple small moves).
-     * Default: no merging.
+     * Only consulted for the newest undo step while a gesture or the merge window
+     * is open (see UndoManager::beginGesture), so implementations just compare
+     * command type and target entity. Default: no merging.
      */
     virtual bool canMergeWith(const UndoableCommand* /*other*/) const {
         return false;
@@ -50,6 +52,15 @@ class UndoableCommand {
      * Only called if canMergeWith returned true.
      */
     virtual void mergeWith(const UndoableCommand* /*other*/) {}
+
+    /**
+     * Approximate heap memory held by this command, for the undo memory budget.
+     * Payloads shared with the live model (copy-on-write arrays) are not counted
+     * while they are shared. Default: the size of a small fixed-state command.
+     */
+    virtual size_t getSizeInBytes() const {
+        return 64;
+    }
 };
 
 /**
@@ -64,6 +75,15 @@ class UndoManagerListener {
      * UI can use this to update menu items, buttons, etc.
      */
     virtual void undoStateChanged() = 0;
+
+    /**
+     * Called after a command (or a finished compound operation) was executed,
+     * undone or redone. Undo/redo descriptions are prefixed with "Undo "/"Redo ".
+     * Not called for the individual commands inside a compound operation.
+     */
+    virtual void commandPerformed(const juce::String& description) {
+        juce::ignoreUnused(description);
+    }
 };
 
 /**
@@ -75,6 +95,21 @@ class UndoManagerListener {
  *   UndoManager::getInstance().executeCommand(std::move(cmd));
  *
  * The command is executed immediately and added to the undo stack.
+ *
+ * Interactive edits coalesce: while a gesture is open (a drag or knob sweep, see
+ * GestureScope), everything it executes becomes one undo step. A command that
+ * canMergeWith() that step is merged into it in place, anything else is grouped with
+ * it, and commandPerformed() is reported once when the gesture ends. Outside a
+ * gesture, a command still merges into the newest step if canMergeWith() agrees and
+ * it arrives within getMergeWindowMs() (e.g. repeated nudges). Merging never reaches
+ * across an undo, redo, finished compound operation or another gesture.
+ *
+ * History is bounded by memory rather than by step count: once the commands on both
+ * stacks hold more than getMaxUndoBytes(), the oldest undo steps are dropped (the most
+ * recent one is always kept). The total is kept as a running sum of each step's size
+ * when it was last measured, so an edit never re-measures the whole history. A step
+ * is re-measured when it is pushed, merged into, or becomes the step below a new one,
+ * which is when a payload it shared with the model detaches.
  */
 class UndoManager {
   public:
@@ -133,7 +168,8 @@ class UndoManager {
 
     /**
      * Begin a compound operation (groups multiple commands as one undo step).
-     * All commands executed until endCompoundOperation() are grouped.
+     * All commands executed until endCompoundOperation() are grouped, and the model
+     * changes they make are delivered to listeners as one change set when it ends.
      */
     void beginCompoundOperation(const juce::String& description);
 
@@ -149,6 +185,31 @@ class UndoManager {
         return compoundDepth_ > 0;
     }
 
+    /**
+     * Begin an interactive gesture; gestures nest, only the outermost one counts.
+     */
+    void beginGesture();
+
+    /**
+     * End an interactive gesture.
+     */
+    void endGesture();
+
+    bool isInGesture() const {
+        return gestureDepth_ > 0;
+    }
+
+    /**
+     * Set how close together commands outside a gesture must be to merge (0 disables).
+     */
+    void setMergeWindowMs(int milliseconds) {
+        mergeWindowMs_ = milliseconds;
+    }
+
+    int getMergeWindowMs() const {
+        return mergeWindowMs_;
+    }
+
     /**
      * Set maximum number of undo steps to keep.
      */
@@ -164,6 +225,23 @@ class UndoManager {
         return maxUndoSteps_;
     }
 
+    /**
+     * Set the memory budget for undo/redo history.
+     */
+    void setMaxUndoBytes(size_t maxBytes) {
+        maxUndoBytes_ = maxBytes;
+        trimUndoStack();
+    }
+
+    size_t getMaxUndoBytes() const {
+        return maxUndoBytes_;
+    }
+
+    /**
+     * Memory currently held by the undo/redo history (see UndoableCommand::getSizeInBytes).
+     */
+    size_t getUndoMemoryUsage() const;
+
     // Listener management
     void addListener(UndoManagerListener* listener);
     void removeListener(UndoManagerListener* listener);
@@ -173,17 +251,48 @@ class UndoManager {
     ~UndoManager() = default;
 
     void notifyListeners();
+    void notifyCommandPerformed(const juce::String& description);
+    void reportPerformed(const juce::String& description);
     void trimUndoStack();
 
-    std::deque<std::unique_ptr<UndoableCommand>> undoStack_;
-    std::deque<std::unique_ptr<UndoableCommand>> redoStack_;
+    // A history step and its size when last measured (summed into historyBytes_)
+    struct HistoryEntry {
+        std::unique_ptr<UndoableCommand> command;
+        size_t bytes = 0;
+    };
+
+    void pushUndo(std::unique_ptr<UndoableCommand> command);
+    std::unique_ptr<UndoableCommand> popUndo();
+    void dropOldestUndo();
+    void pushRedo(std::unique_ptr<UndoableCommand> command);
+    std::unique_ptr<UndoableCommand> popRedo();
+    void clearRedo();
+    void remeasure(HistoryEntry& entry);
+    bool isTopCommandFromCurrentGesture() const;
+    bool canMergeWithinWindow(const UndoableCommand& command) const;
+    void foldIntoTopCommand(std::unique_ptr<UndoableCommand> command);
+    void closeMerging();
+
+    std::deque<HistoryEntry> undoStack_;
+    std::deque<HistoryEntry> redoStack_;
+    size_t historyBytes_ = 0;  // Recorded sizes of every entry on both stacks
 
     // Compound operation support
     int compoundDepth_ = 0;
     juce::String compoundDescription_;
     std::vector<std::unique_ptr<UndoableCommand>> compoundCommands_;
 
-    size_t maxUndoSteps_ = 100;
+    // Coalescing: which gesture (0 = none) last pushed or merged into the top command
+    int gestureDepth_ = 0;
+    int currentGesture_ = 0;
+    int lastCommandGesture_ = 0;
+    bool mergeOpen_ = false;
+    juce::String gestureDescription_;  // Last command performed in the open gesture
+    juce::uint32 lastCommandTime_ = 0;
+    int mergeWindowMs_ = 500;
+
+    size_t maxUndoSteps_ = 10000;
+    size_t maxUndoBytes_ = 256 * 1024 * 1024;
 
     std::vector<UndoManagerListener*> listeners_;
 };
@@ -201,12 +310,38 @@ class CompoundCommand : public UndoableCommand {
     juce::String getDescription() const override {
         return description_;
     }
+    size_t getSizeInBytes() const override;
+
+    /**
+     * Add an already executed command (used when a gesture folds edits into one step).
+     */
+    void append(std::unique_ptr<UndoableCommand> command);
+
+    // Later edits may merge into the last grouped command
+    bool canMergeWith(const UndoableCommand* other) const override;
+    void mergeWith(const UndoableCommand* other) override;
 
   private:
     juce::String description_;
     std::vector<std::unique_ptr<UndoableCommand>> commands_;
 };
 
+/**
+ * @brief RAII helper for interactive gestures
+ *
+ * Components hold one for the duration of a drag so the commands it produces
+ * collapse into a single undo step.
+ */
+class GestureScope {
+  public:
+    GestureScope();
+    ~GestureScope();
+
+    // Prevent copying/moving
+    GestureScope(const GestureScope&) = delete;
+    GestureScope& operator=(const GestureScope&) = delete;
+};
+
 /**
  * @brief RAII helper for compound operations
  *
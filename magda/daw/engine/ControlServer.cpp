@@ -0,0 +1,488 @@
+#include "ControlServer.hpp"
+
+#include <juce_events/juce_events.h>
+
+#include <iostream>
+#include <vector>
+
+#if !JUCE_WINDOWS
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#endif
+
+namespace magda {
+
+namespace {
+
+#if !JUCE_WINDOWS
+
+#ifdef MSG_NOSIGNAL
+constexpr int kSendFlags = MSG_NOSIGNAL;
+#else
+constexpr int kSendFlags = 0;  // SO_NOSIGPIPE is set on each socket instead
+#endif
+
+void setNonBlocking(int fd) {
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL, 0) | O_NONBLOCK);
+    fcntl(fd, F_SETFD, FD_CLOEXEC);
+#ifdef SO_NOSIGPIPE
+    int on = 1;
+    setsockopt(fd, SOL_SOCKET, SO_NOSIGPIPE, &on, sizeof(on));
+#endif
+}
+
+bool makeAddress(const juce::File& file, sockaddr_un& address) {
+    auto path = file.getFullPathName().toStdString();
+    if (path.size() >= sizeof(address.sun_path)) {
+        return false;
+    }
+
+    std::memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    std::memcpy(address.sun_path, path.c_str(), path.size() + 1);
+    return true;
+}
+
+bool isAnswering(const sockaddr_un& address) {
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) {
+        return false;
+    }
+    bool answering =
+        connect(fd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) == 0;
+    close(fd);
+    return answering;
+}
+
+#endif
+
+}  // namespace
+
+ControlServer::ControlServer(RequestHandler handler, Executor executor)
+    : juce::Thread("Control Server"), handler_(std::move(handler)), executor_(std::move(executor)) {
+    if (!executor_) {
+        executor_ = [](std::function<void()> task) {
+            juce::MessageManager::callAsync(std::move(task));
+        };
+    }
+}
+
+ControlServer::~ControlServer() {
+    stop();
+}
+
+bool ControlServer::start(const juce::File& socketFile) {
+    stop();
+
+#if JUCE_WINDOWS
+    juce::ignoreUnused(socketFile);
+    return false;
+#else
+    sockaddr_un address;
+    if (!makeAddress(socketFile, address)) {
+        std::cerr << "ControlServer: socket path too long: " << socketFile.getFullPathName()
+                  << std::endl;
+        return false;
+    }
+
+    if (socketFile.exists()) {
+        if (isAnswering(address)) {
+            std::cerr << "ControlServer: another instance is listening on "
+                      << socketFile.getFullPathName() << std::endl;
+            return false;
+        }
+        socketFile.deleteFile();
+    }
+
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) {
+        return false;
+    }
+    if (pipe(wakePipe_) != 0) {
+        std::cerr << "ControlServer: cannot create wake pipe: " << std::strerror(errno)
+                  << std::endl;
+        close(fd);
+        wakePipe_[0] = wakePipe_[1] = -1;
+        return false;
+    }
+    setNonBlocking(fd);
+
+    // Only the current user may connect. Nobody can connect before listen(), so narrowing
+    // the file's mode between bind() and listen() leaves no window open to others.
+    bool bound = bind(fd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) == 0;
+    if (!bound || chmod(address.sun_path, S_IRUSR | S_IWUSR) != 0 || listen(fd, 16) != 0) {
+        std::cerr << "ControlServer: cannot listen on " << socketFile.getFullPathName() << ": "
+                  << std::strerror(errno) << std::endl;
+        close(fd);
+        close(wakePipe_[0]);
+        close(wakePipe_[1]);
+        wakePipe_[0] = wakePipe_[1] = -1;
+        if (bound) {
+            unlink(address.sun_path);
+        }
+        return false;
+    }
+    setNonBlocking(wakePipe_[0]);
+    setNonBlocking(wakePipe_[1]);
+
+    listenFd_ = fd;
+    socketFile_ = socketFile;
+    validFlag_ = std::make_shared<std::atomic<bool>>(true);
+    startThread();
+    return true;
+#endif
+}
+
+void ControlServer::stop() {
+#if !JUCE_WINDOWS
+    if (listenFd_ < 0) {
+        return;
+    }
+
+    validFlag_->store(false);
+    signalThreadShouldExit();
+    wake();
+    stopThread(2000);
+
+    {
+        const juce::ScopedLock sl(clientsLock_);
+        for (auto& [id, client] : clients_) {
+            close(client->fd);
+        }
+        clients_.clear();
+        numSubscribers_.store(0);
+    }
+
+    close(listenFd_);
+    close(wakePipe_[0]);
+    close(wakePipe_[1]);
+    listenFd_ = -1;
+    wakePipe_[0] = wakePipe_[1] = -1;
+
+    socketFile_.deleteFile();
+#endif
+}
+
+int ControlServer::getNumClients() const {
+    const juce::ScopedLock sl(clientsLock_);
+    return static_cast<int>(clients_.size());
+}
+
+void ControlServer::setSubscribed(ClientId client, bool subscribed) {
+    const juce::ScopedLock sl(clientsLock_);
+    auto it = clients_.find(client);
+    if (it != clients_.end() && it->second->subscribed != subscribed) {
+        it->second->subscribed = subscribed;
+        numSubscribers_.fetch_add(subscribed ? 1 : -1);
+    }
+}
+
+void ControlServer::send(ClientId client, const std::string& payload) {
+    auto frame = encodeFrame(payload);
+
+    const juce::ScopedLock sl(clientsLock_);
+    auto it = clients_.find(client);
+    if (it != clients_.end()) {
+        queueFrame(*it->second, frame);
+    }
+}
+
+void ControlServer::broadcastEvent(const std::string& payload) {
+    if (!hasSubscribers()) {
+        return;
+    }
+
+    auto frame = encodeFrame(payload);
+
+    const juce::ScopedLock sl(clientsLock_);
+    for (auto& [id, client] : clients_) {
+        if (client->subscribed) {
+            queueFrame(*client, frame);
+        }
+    }
+}
+
+juce::File ControlServer::getDefaultSocketFile() {
+    auto override = juce::SystemStats::getEnvironmentVariable("MAGDA_CONTROL_SOCKET", {});
+    if (override.isNotEmpty()) {
+        return juce::File(override);
+    }
+
+    // Not the user temp directory: on macOS its path is too long for a socket address
+#if JUCE_WINDOWS
+    return juce::File::getSpecialLocation(juce::File::tempDirectory).getChildFile("magda.sock");
+#else
+    return juce::File("/tmp").getChildFile("magda-" + juce::String(static_cast<int>(getuid())) +
+                                           ".sock");
+#endif
+}
+
+// =============================================================================
+// Framing
+// =============================================================================
+
+std::string ControlServer::encodeFrame(const std::string& payload) {
+    auto size = static_cast<juce::uint32>(payload.size());
+    std::string frame;
+    frame.reserve(4 + payload.size());
+    frame.push_back(static_cast<char>((size >> 24) & 0xff));
+    frame.push_back(static_cast<char>((size >> 16) & 0xff));
+    frame.push_back(static_cast<char>((size >> 8) & 0xff));
+    frame.push_back(static_cast<char>(size & 0xff));
+    frame.append(payload);
+    return frame;
+}
+
+ControlServer::FrameStatus ControlServer::readFrame(const std::string& buffer, size_t& offset,
+                                                    std::string& payload) {
+    if (buffer.size() < offset + 4) {
+        return FrameStatus::Incomplete;
+    }
+
+    juce::uint32 size = 0;
+    for (size_t i = 0; i < 4; ++i) {
+        size = (size << 8) | static_cast<unsigned char>(buffer[offset + i]);
+    }
+    if (size > kMaxFrameBytes) {
+        return FrameStatus::TooLarge;
+    }
+    if (buffer.size() < offset + 4 + size) {
+        return FrameStatus::Incomplete;
+    }
+
+    payload.assign(buffer, offset + 4, size);
+    offset += 4 + size;
+    return FrameStatus::Complete;
+}
+
+// =============================================================================
+// I/O thread
+// =============================================================================
+
+void ControlServer::run() {
+#if !JUCE_WINDOWS
+    std::vector<pollfd> fds;
+    std::vector<ClientId> polledClients;
+
+    while (!threadShouldExit()) {
+        fds.clear();
+        polledClients.clear();
+        fds.push_back({wakePipe_[0], POLLIN, 0});
+        fds.push_back({listenFd_, POLLIN, 0});
+
+        {
+            const juce::ScopedLock sl(clientsLock_);
+            for (auto it = clients_.begin(); it != clients_.end();) {
+                auto& client = *it->second;
+                if (client.closing) {
+                    closeClient(it++);
+                    continue;
+                }
+                short events = POLLIN;
+                if (!client.output.empty()) {
+                    events |= POLLOUT;
+                }
+                fds.push_back({client.fd, events, 0});
+                polledClients.push_back(it->first);
+                ++it;
+            }
+        }
+
+        if (poll(fds.data(), static_cast<nfds_t>(fds.size()), -1) < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            std::cerr << "ControlServer: poll failed: " << std::strerror(errno) << std::endl;
+            return;
+        }
+
+        if ((fds[0].revents & POLLIN) != 0) {
+            char drain[64];
+            while (read(wakePipe_[0], drain, sizeof(drain)) > 0) {
+            }
+        }
+        if ((fds[1].revents & POLLIN) != 0) {
+            acceptClients();
+        }
+
+        std::vector<Request> requests;
+        for (size_t i = 0; i < polledClients.size(); ++i) {
+            auto revents = fds[i + 2].revents;
+            if (revents == 0) {
+                continue;
+            }
+
+            const juce::ScopedLock sl(clientsLock_);
+            auto it = clients_.find(polledClients[i]);
+            if (it == clients_.end()) {
+                continue;
+            }
+
+            bool open = true;
+            if ((revents & (POLLIN | POLLHUP | POLLERR)) != 0) {
+                open = readFromClient(it->first, *it->second, requests);
+            }
+            if (open && (revents & POLLOUT) != 0) {
+                open = flush(*it->second);
+            }
+            if (!open) {
+                closeClient(it);
+            }
+        }
+
+        if (!requests.empty()) {
+            dispatch(std::move(requests));
+        }
+    }
+#endif
+}
+
+void ControlServer::wake() {
+#if !JUCE_WINDOWS
+    if (wakePipe_[1] >= 0) {
+        char byte = 0;
+        juce::ignoreUnused(write(wakePipe_[1], &byte, 1));
+    }
+#endif
+}
+
+void ControlServer::acceptClients() {
+#if !JUCE_WINDOWS
+    for (;;) {
+        int fd = accept(listenFd_, nullptr, nullptr);
+        if (fd < 0) {
+            return;
+        }
+        setNonBlocking(fd);
+
+        auto client = std::make_unique<Client>();
+        client->fd = fd;
+
+        const juce::ScopedLock sl(clientsLock_);
+        clients_[nextClientId_++] = std::move(client);
+    }
+#endif
+}
+
+bool ControlServer::readFromClient(ClientId id, Client& client, std::vector<Request>& requests) {
+#if JUCE_WINDOWS
+    juce::ignoreUnused(id, client, requests);
+    return false;
+#else
+    char buffer[16384];
+    bool hungUp = false;
+    for (;;) {
+        auto bytes = recv(client.fd, buffer, sizeof(buffer), 0);
+        if (bytes > 0) {
+            client.input.append(buffer, static_cast<size_t>(bytes));
+            if (bytes < static_cast<ssize_t>(sizeof(buffer))) {
+                break;
+            }
+        } else if (bytes == 0) {
+            hungUp = true;  // Still run what it sent; the responses have nowhere to go
+            break;
+        } else if (errno == EAGAIN || errno == EWOULDBLOCK) {
+            break;
+        } else if (errno != EINTR) {
+            return false;
+        }
+    }
+
+    size_t offset = 0;
+    std::string payload;
+    for (;;) {
+        auto status = readFrame(client.input, offset, payload);
+        if (status == FrameStatus::TooLarge) {
+            return false;
+        }
+        if (status == FrameStatus::Incomplete) {
+            break;
+        }
+        requests.push_back({id, std::move(payload)});
+    }
+    client.input.erase(0, offset);
+    return !hungUp;
+#endif
+}
+
+void ControlServer::dispatch(std::vector<Request> requests) {
+    auto validFlag = validFlag_;
+    executor_([this, validFlag, requests = std::move(requests)]() {
+        for (const auto& request : requests) {
+            if (!validFlag->load()) {
+                return;
+            }
+            auto response = handler_(request.client, request.payload);
+            if (!response.empty()) {
+                send(request.client, response);
+            }
+        }
+    });
+}
+
+void ControlServer::queueFrame(Client& client, const std::string& frame) {
+    if (client.closing) {
+        return;
+    }
+
+    bool wasIdle = client.output.empty();
+    if (client.output.size() + frame.size() > kMaxPendingBytes) {
+        client.closing = true;
+        wake();
+        return;
+    }
+    client.output.append(frame);
+
+    // Nothing was waiting: try to write now rather than waiting a round trip through poll()
+    if (wasIdle) {
+        if (!flush(client)) {
+            client.closing = true;
+        }
+        if (client.closing || !client.output.empty()) {
+            wake();
+        }
+    }
+}
+
+bool ControlServer::flush(Client& client) {
+#if JUCE_WINDOWS
+    juce::ignoreUnused(client);
+    return false;
+#else
+    size_t written = 0;
+    while (written < client.output.size()) {
+        auto bytes = ::send(client.fd, client.output.data() + written,
+                            client.output.size() - written, kSendFlags);
+        if (bytes > 0) {
+            written += static_cast<size_t>(bytes);
+        } else if (bytes < 0 && errno == EINTR) {
+            continue;
+        } else if (bytes < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            break;
+        } else {
+            return false;
+        }
+    }
+    client.output.erase(0, written);
+    return true;
+#endif
+}
+
+void ControlServer::closeClient(std::map<ClientId, std::unique_ptr<Client>>::iterator it) {
+#if !JUCE_WINDOWS
+    close(it->second->fd);
+#endif
+    if (it->second->subscribed) {
+        numSubscribers_.fetch_sub(1);
+    }
+    clients_.erase(it);
+}
+
+}  // namespace magda
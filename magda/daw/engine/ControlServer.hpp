@@ -0,0 +1,157 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+
+#include <atomic>
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+
+namespace magda {
+
+/**
+ * @brief Local Unix-domain-socket server for external control of the DAW
+ *
+ * Clients connect to a socket file that only the current user can open and exchange
+ * length-prefixed frames: a 4-byte big-endian payload size followed by the payload.
+ * Payloads are opaque here; RemoteControl puts JSON commands and responses in them.
+ *
+ * One I/O thread accepts clients and reads and writes all sockets. Requests are handed
+ * to the executor (the message thread by default) in arrival order, every frame read in
+ * one pass together, without waiting for earlier requests to be answered, so a client
+ * can keep many requests in flight. Responses are written straight from the thread
+ * that produced them when the socket has room, and queued for the I/O thread otherwise.
+ *
+ * Clients that subscribe also receive every broadcastEvent() payload. A client whose
+ * unsent output grows past kMaxPendingBytes is disconnected rather than buffered for.
+ *
+ * Not available on Windows (start() returns false).
+ */
+class ControlServer : private juce::Thread {
+  public:
+    using ClientId = int;
+
+    /**
+     * @brief Handles one request frame, returning the response frame (empty for none)
+     */
+    using RequestHandler = std::function<std::string(ClientId client, const std::string& request)>;
+
+    /**
+     * @brief Runs a task on the thread requests should be handled on
+     */
+    using Executor = std::function<void(std::function<void()> task)>;
+
+    static constexpr juce::uint32 kMaxFrameBytes = 16 * 1024 * 1024;
+    static constexpr size_t kMaxPendingBytes = 32 * 1024 * 1024;
+
+    /**
+     * @param handler Called for every request frame
+     * @param executor Where to call it (defaults to juce::MessageManager::callAsync)
+     */
+    explicit ControlServer(RequestHandler handler, Executor executor = {});
+    ~ControlServer() override;
+
+    /**
+     * @brief Listen on a socket file
+     *
+     * A stale socket left by a crashed instance is replaced; one that another running
+     * instance still answers on is left alone and start() fails.
+     */
+    bool start(const juce::File& socketFile);
+
+    /**
+     * @brief Disconnect all clients and remove the socket file
+     */
+    void stop();
+
+    bool isListening() const {
+        return listenFd_ >= 0;
+    }
+
+    const juce::File& getSocketFile() const {
+        return socketFile_;
+    }
+
+    int getNumClients() const;
+
+    /**
+     * @brief Whether a client receives broadcast events (thread-safe)
+     */
+    void setSubscribed(ClientId client, bool subscribed);
+    bool hasSubscribers() const {
+        return numSubscribers_.load() > 0;
+    }
+
+    /**
+     * @brief Send a frame to one client (any thread)
+     */
+    void send(ClientId client, const std::string& payload);
+
+    /**
+     * @brief Send a frame to every subscribed client (any thread)
+     */
+    void broadcastEvent(const std::string& payload);
+
+    /**
+     * @brief $MAGDA_CONTROL_SOCKET if set, otherwise a per-user file in /tmp
+     */
+    static juce::File getDefaultSocketFile();
+
+    // =========================================================================
+    // Framing
+    // =========================================================================
+
+    static std::string encodeFrame(const std::string& payload);
+
+    enum class FrameStatus { Incomplete, Complete, TooLarge };
+
+    /**
+     * @brief Read the frame starting at offset, advancing offset past it if complete
+     */
+    static FrameStatus readFrame(const std::string& buffer, size_t& offset, std::string& payload);
+
+  private:
+    struct Client {
+        int fd = -1;
+        std::string input;   // I/O thread only
+        std::string output;  // Unsent bytes, guarded by clientsLock_
+        bool subscribed = false;
+        bool closing = false;  // Dropped for a protocol error or slow reading
+    };
+
+    struct Request {
+        ClientId client;
+        std::string payload;
+    };
+
+    void run() override;
+    void wake();
+    void acceptClients();
+    bool readFromClient(ClientId id, Client& client, std::vector<Request>& requests);
+    void dispatch(std::vector<Request> requests);
+
+    // Appends to a client's output, writing what the socket takes. Call with clientsLock_.
+    void queueFrame(Client& client, const std::string& frame);
+    bool flush(Client& client);
+    void closeClient(std::map<ClientId, std::unique_ptr<Client>>::iterator it);
+
+    RequestHandler handler_;
+    Executor executor_;
+
+    juce::File socketFile_;
+    int listenFd_ = -1;
+    int wakePipe_[2] = {-1, -1};
+
+    juce::CriticalSection clientsLock_;
+    std::map<ClientId, std::unique_ptr<Client>> clients_;
+    ClientId nextClientId_ = 1;
+    std::atomic<int> numSubscribers_{0};
+
+    // Cleared on stop() so queued requests are dropped instead of answered
+    std::shared_ptr<std::atomic<bool>> validFlag_ = std::make_shared<std::atomic<bool>>(false);
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ControlServer)
+};
+
+}  // namespace magda
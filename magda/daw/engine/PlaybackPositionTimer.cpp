@@ -1,6 +1,9 @@
 #include "PlaybackPositionTimer.hpp"
 
+#include <cmath>
+
 #include "AudioEngine.hpp"
+#include "audio/AudioBridge.hpp"
 #include "ui/state/TimelineController.hpp"
 #include "ui/state/TimelineEvents.hpp"
 
@@ -19,6 +22,7 @@ void PlaybackPositionTimer::start() {
 
 void PlaybackPositionTimer::stop() {
     stopTimer();
+    stopAnimating();
 }
 
 bool PlaybackPositionTimer::isRunning() const {
@@ -29,11 +33,40 @@ void PlaybackPositionTimer::timerCallback() {
     // Update trigger state for transport-synced devices (tone generator, etc.)
     engine_.updateTriggerState();
 
+    // Follow the playhead every frame only while it moves
+    bool playing = engine_.isPlaying();
+    if (playing && !isAnimating()) {
+        startAnimating(PLAYHEAD_FPS);
+        frameTick();
+    } else if (!playing && isAnimating()) {
+        stopAnimating();
+    }
+}
+
+void PlaybackPositionTimer::frameTick() {
     if (engine_.isPlaying()) {
-        double position = engine_.getCurrentPosition();
         // Only update playback position (the moving cursor), not edit position
-        timeline_.dispatch(SetPlaybackPositionEvent{position});
+        timeline_.dispatch(SetPlaybackPositionEvent{getPlaybackPosition()});
+    }
+}
+
+double PlaybackPositionTimer::getPlaybackPosition() const {
+    const auto* bridge = engine_.getAudioBridge();
+    PlayheadClock::Snapshot snapshot;
+    if (bridge == nullptr || !bridge->getPlayheadClock().read(snapshot) || !snapshot.playing) {
+        // No audio clock yet (device not running, or the first block hasn't played)
+        return engine_.getCurrentPosition();
+    }
+
+    double position =
+        snapshot.getPositionAt(juce::Time::getHighResolutionTicks(), MAX_EXTRAPOLATION);
+
+    // Extrapolation doesn't know about the loop; wrap until the transport's jump arrives
+    const auto& loop = timeline_.getState().loop;
+    if (loop.enabled && loop.isValid() && position >= loop.endTime) {
+        position = loop.startTime + std::fmod(position - loop.startTime, loop.getDuration());
     }
+    return position;
 }
 
 }  // namespace magda
@@ -2,19 +2,23 @@
 
 #include <juce_events/juce_events.h>
 
+#include "ui/utils/FrameScheduler.hpp"
+
 namespace magda {
 
 class AudioEngine;
 class TimelineController;
 
 /**
- * @brief Timer that polls the audio engine for playhead position updates
+ * @brief Drives the playhead from the audio clock
  *
- * This class periodically polls the AudioEngine for the current
- * playback position and dispatches SetPlaybackPositionEvent to the
- * TimelineController, which then notifies all listeners.
+ * A slow timer polls the engine's transport state (start, stop, loop detection for
+ * transport-synced devices). While playing, the playhead is updated once per display
+ * frame: the latest position the audio thread published (see PlayheadClock) is
+ * extrapolated to the moment of the frame and dispatched as a SetPlaybackPositionEvent,
+ * so the cursor moves smoothly at display rate rather than stepping with each poll.
  */
-class PlaybackPositionTimer : private juce::Timer {
+class PlaybackPositionTimer : private juce::Timer, private FrameClient {
   public:
     PlaybackPositionTimer(AudioEngine& engine, TimelineController& timeline);
     ~PlaybackPositionTimer() override;
@@ -25,11 +29,17 @@ class PlaybackPositionTimer : private juce::Timer {
 
   private:
     void timerCallback() override;
+    void frameTick() override;
+
+    // Audible position now: extrapolated audio clock, or the transport when there is none
+    double getPlaybackPosition() const;
 
     AudioEngine& engine_;
     TimelineController& timeline_;
 
-    static constexpr int UPDATE_INTERVAL_MS = 30;  // ~33fps for smooth playhead
+    static constexpr int UPDATE_INTERVAL_MS = 30;     // Transport state polling
+    static constexpr int PLAYHEAD_FPS = 60;           // Playhead updates while playing
+    static constexpr double MAX_EXTRAPOLATION = 0.1;  // Seconds past the last audio block
 };
 
 }  // namespace magda
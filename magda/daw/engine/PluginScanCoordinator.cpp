@@ -1,11 +1,134 @@
 #include "PluginScanCoordinator.hpp"
 
 #include <iostream>
+#include <thread>
+
+#include "../profiling/PerformanceProfiler.hpp"
 
 namespace magda {
 
+// =============================================================================
+// WorkerConnection - one magda_plugin_scanner child process
+// =============================================================================
+
+class PluginScanCoordinator::WorkerConnection : public juce::ChildProcessCoordinator {
+  public:
+    WorkerConnection(PluginScanCoordinator& owner, int index) : owner_(owner), index_(index) {}
+
+    ~WorkerConnection() override {
+        // Drop any events still queued for this worker
+        generation_.fetch_add(1);
+        joinLaunch();
+    }
+
+    int getIndex() const {
+        return index_;
+    }
+
+    /**
+     * @brief Start the scanner process on a background thread
+     *
+     * launchWorkerProcess() blocks until the child connects (up to its timeout), so the
+     * pool's processes are started side by side instead of one after another, and a
+     * scan never waits for them on the message thread. onLaunched receives the result
+     * on the launch thread.
+     */
+    void launchAsync(const juce::File& scannerExe, std::function<void(bool)> onLaunched) {
+        joinLaunch();
+        generation_.fetch_add(1);
+
+        launchThread_ = std::thread([this, scannerExe, onLaunched = std::move(onLaunched)]() {
+            // The ChildProcessCoordinator::launchWorkerProcess takes:
+            // - File: the executable to launch
+            // - String: a unique ID for this type of worker
+            // - int: timeout in milliseconds (0 = no timeout)
+            // - int: pipe timeout in milliseconds
+            onLaunched(launchWorkerProcess(scannerExe, "magda-plugin-scanner", 10000, 5000));
+        });
+    }
+
+    void kill() {
+        // A process still being launched must finish starting before it can be killed
+        joinLaunch();
+
+        // Bump generation first so the connection-lost event from the kill is ignored
+        generation_.fetch_add(1);
+        killWorkerProcess();
+        isRunning = false;
+    }
+
+    void send(const juce::MemoryBlock& message) {
+        sendMessageToWorker(message);
+    }
+
+    // Scan state (message thread only)
+    bool isRunning = false;
+    bool hasFile = false;
+    bool launchPending = false;  // Waiting to relaunch, or launching
+    bool lostWhileLaunching = false;
+    bool retired = false;
+    int consecutiveFailures = 0;
+    PendingFile currentFile;
+    juce::Array<juce::PluginDescription> currentResults;
+    bool currentFailed = false;
+    bool currentErrored = false;  // The scanner reported an error unrelated to the file
+    juce::int64 lastActivityTime = 0;
+    double scanStartMs = 0.0;
+
+  private:
+    void joinLaunch() {
+        if (launchThread_.joinable()) {
+            launchThread_.join();
+        }
+    }
+
+    // IPC callbacks arrive on the connection thread - forward them to the message thread
+    void handleMessageFromWorker(const juce::MemoryBlock& message) override {
+        postToOwner([message](PluginScanCoordinator& owner, WorkerConnection& worker) {
+            owner.handleWorkerMessage(worker, message);
+        });
+    }
+
+    void handleConnectionLost() override {
+        postToOwner([](PluginScanCoordinator& owner, WorkerConnection& worker) {
+            owner.handleWorkerLost(worker);
+        });
+    }
+
+    template <typename Handler> void postToOwner(Handler handler) {
+        auto validFlag = owner_.validFlag_;
+        auto scanSequence = owner_.scanSequence_;
+        const int sequence = scanSequence->load();
+        const int generation = generation_.load();
+        auto* owner = &owner_;
+        auto* self = this;
+
+        juce::MessageManager::callAsync([=]() {
+            // Workers are only destroyed after the sequence changes, so a matching
+            // sequence means self is still alive
+            if (!validFlag->load() || scanSequence->load() != sequence) {
+                return;
+            }
+            if (self->generation_.load() != generation) {
+                return;  // Event from a process that has since been killed/relaunched
+            }
+            handler(*owner, *self);
+        });
+    }
+
+    PluginScanCoordinator& owner_;
+    int index_;
+    std::atomic<int> generation_{0};
+    std::thread launchThread_;
+};
+
+// =============================================================================
+// PluginScanCoordinator
+// =============================================================================
+
 PluginScanCoordinator::PluginScanCoordinator() {
     loadBlacklist();
+    scanDatabase_.loadFromFile(PluginScanDatabase::getDefaultFile());
 }
 
 PluginScanCoordinator::~PluginScanCoordinator() {
@@ -14,15 +137,13 @@ PluginScanCoordinator::~PluginScanCoordinator() {
 
     // Ensure we don't process any callbacks during destruction
     isScanning_ = false;
-    isRecovering_ = false;
-    recoverySequence_++;
+    scanSequence_->fetch_add(1);
 
     // Stop timer first
     stopTimer();
 
-    // Give the worker process a moment to terminate gracefully
-    // Don't call killWorkerProcess() if we already finished - it may cause thread issues
-    // The ChildProcessCoordinator base class destructor will handle cleanup
+    // Workers still running are cleaned up by the ChildProcessCoordinator destructors
+    workers_.clear();
 }
 
 juce::File PluginScanCoordinator::getScannerExecutable() const {
@@ -58,31 +179,17 @@ juce::File PluginScanCoordinator::getScannerExecutable() const {
     return {};
 }
 
-bool PluginScanCoordinator::launchScannerProcess() {
-    auto scannerExe = getScannerExecutable();
-
-    if (!scannerExe.existsAsFile()) {
-        std::cerr << "[ScanCoordinator] Plugin scanner executable not found" << std::endl;
-        return false;
-    }
-
-    std::cout << "[ScanCoordinator] Launching scanner: " << scannerExe.getFullPathName()
-              << std::endl;
+void PluginScanCoordinator::setNumWorkers(int numWorkers) {
+    numWorkers_ = juce::jmax(0, numWorkers);
+}
 
-    // Launch the scanner process
-    // The ChildProcessCoordinator::launchWorkerProcess takes:
-    // - File: the executable to launch
-    // - String: a unique ID for this type of worker
-    // - int: timeout in milliseconds (0 = no timeout)
-    // - int: pipe timeout in milliseconds
-    // Use 10 second timeout to avoid blocking the message thread indefinitely
-    if (!launchWorkerProcess(scannerExe, "magda-plugin-scanner", 10000, 5000)) {
-        std::cerr << "[ScanCoordinator] Failed to launch scanner process" << std::endl;
-        return false;
-    }
+int PluginScanCoordinator::getNumWorkers() const {
+    return numWorkers_ > 0 ? numWorkers_ : juce::jmax(1, juce::SystemStats::getNumCpus());
+}
 
-    std::cout << "[ScanCoordinator] Scanner process launched successfully" << std::endl;
-    return true;
+void PluginScanCoordinator::clearScanCache() {
+    scanDatabase_.clear();
+    (void)scanDatabase_.saveToFile(PluginScanDatabase::getDefaultFile());
 }
 
 void PluginScanCoordinator::startScan(juce::AudioPluginFormatManager& formatManager,
@@ -93,149 +200,196 @@ void PluginScanCoordinator::startScan(juce::AudioPluginFormatManager& formatMana
         return;
     }
 
+    scanSequence_->fetch_add(1);  // Invalidate any stale callbacks from a previous scan
+    workers_.clear();
+
     formatManager_ = &formatManager;
     progressCallback_ = progressCallback;
     completionCallback_ = completionCallback;
     foundPlugins_.clear();
     failedPlugins_.clear();
-    currentFormatIndex_ = 0;
-    formatsToScan_.clear();
-    isRecovering_ = false;
-    consecutiveFailures_ = 0;
-    recoverySequence_++;  // Invalidate any stale recovery callbacks
-    currentPluginBeingScanned_.clear();
-
-    // Collect formats to scan
-    for (int i = 0; i < formatManager.getNumFormats(); ++i) {
-        auto* format = formatManager.getFormat(i);
-        if (format) {
-            juce::String formatName = format->getName();
-            // Only scan VST3 and AudioUnit
-            if (formatName.containsIgnoreCase("VST3") ||
-                formatName.containsIgnoreCase("AudioUnit")) {
-                formatsToScan_.add(formatName);
-            }
-        }
-    }
+    pendingFiles_.clear();
+    totalFilesToScan_ = 0;
+    filesCompleted_ = 0;
+    isScanning_ = true;
 
-    if (formatsToScan_.isEmpty()) {
-        std::cout << "[ScanCoordinator] No scannable formats found" << std::endl;
-        if (completionCallback) {
-            completionCallback(true, foundPlugins_, failedPlugins_);
-        }
-        return;
-    }
+    collectFilesToScan();
 
-    std::cout << "[ScanCoordinator] Starting scan for formats: "
-              << formatsToScan_.joinIntoString(", ") << std::endl;
+    std::cout << "[ScanCoordinator] " << foundPlugins_.size()
+              << " plugins unchanged since last scan, " << pendingFiles_.size()
+              << " files to scan" << std::endl;
 
-    isScanning_ = true;
+    if (pendingFiles_.empty()) {
+        finishScan(true);
+        return;
+    }
 
-    // Launch the scanner process
-    if (!launchScannerProcess()) {
-        std::cerr << "[ScanCoordinator] Failed to launch scanner" << std::endl;
+    scannerExecutable_ = getScannerExecutable();
+    if (!scannerExecutable_.existsAsFile()) {
+        std::cerr << "[ScanCoordinator] Plugin scanner executable not found" << std::endl;
         finishScan(false);
         return;
     }
 
-    // Start scanning the first format
-    scanNextFormat();
+    // No point launching more processes than there are files
+    const int numWorkers = juce::jmin(getNumWorkers(), static_cast<int>(pendingFiles_.size()));
+    std::cout << "[ScanCoordinator] Launching " << numWorkers << " scanner processes"
+              << std::endl;
+
+    for (int i = 0; i < numWorkers; ++i) {
+        workers_.push_back(std::make_unique<WorkerConnection>(*this, i));
+    }
+
+    // Workers start scanning as soon as their own process is up
+    for (auto& worker : workers_) {
+        launchWorker(*worker);
+    }
 
     // Start timeout timer
-    lastProgressTime_ = juce::Time::currentTimeMillis();
     startTimer(1000);  // Check every second
 }
 
-void PluginScanCoordinator::scanNextFormat() {
-    if (currentFormatIndex_ >= formatsToScan_.size()) {
-        std::cout << "[ScanCoordinator] All formats scanned" << std::endl;
-        finishScan(true);
-        return;
-    }
+void PluginScanCoordinator::collectFilesToScan() {
+    juce::StringArray allFiles;
 
-    // Clear current plugin state (but NOT consecutiveFailures - that tracks across retries)
-    currentPluginBeingScanned_.clear();
+    for (int i = 0; i < formatManager_->getNumFormats(); ++i) {
+        auto* format = formatManager_->getFormat(i);
+        if (!format) {
+            continue;
+        }
 
-    juce::String formatName = formatsToScan_[currentFormatIndex_];
-    std::cout << "[ScanCoordinator] Scanning format: " << formatName << std::endl;
+        // Only scan VST3 and AudioUnit
+        juce::String formatName = format->getName();
+        if (!formatName.containsIgnoreCase("VST3") && !formatName.containsIgnoreCase("AudioUnit")) {
+            continue;
+        }
 
-    // Find the format
-    juce::AudioPluginFormat* format = nullptr;
-    for (int i = 0; i < formatManager_->getNumFormats(); ++i) {
-        if (formatManager_->getFormat(i)->getName() == formatName) {
-            format = formatManager_->getFormat(i);
-            break;
+        auto files =
+            format->searchPathsForPlugins(format->getDefaultLocationsToSearch(), true, false);
+        std::cout << "[ScanCoordinator] " << formatName << ": " << files.size()
+                  << " plugin files found" << std::endl;
+
+        for (const auto& file : files) {
+            allFiles.add(file);
+
+            if (blacklistedPlugins_.contains(file)) {
+                continue;
+            }
+
+            auto stamp = PluginScanDatabase::stampFor(file);
+            if (auto* cached = scanDatabase_.findUpToDate(file, stamp)) {
+                foundPlugins_.addArray(*cached);
+                continue;
+            }
+
+            pendingFiles_.push_back({formatName, file, stamp});
         }
     }
 
-    if (!format) {
-        std::cerr << "[ScanCoordinator] Format not found: " << formatName << std::endl;
-        currentFormatIndex_++;
-        scanNextFormat();
+    // Forget plugins that have been uninstalled
+    scanDatabase_.retainOnly(allFiles);
+    totalFilesToScan_ = static_cast<int>(pendingFiles_.size());
+}
+
+void PluginScanCoordinator::launchWorker(WorkerConnection& worker) {
+    std::cout << "[ScanCoordinator] Launching scanner " << worker.getIndex() << ": "
+              << scannerExecutable_.getFullPathName() << std::endl;
+
+    worker.launchPending = true;
+    worker.lostWhileLaunching = false;
+
+    // Workers are only destroyed after the sequence changes, and join their launch
+    // thread first, so a matching sequence means the worker is still alive
+    auto validFlag = validFlag_;
+    auto scanSequence = scanSequence_;
+    const int sequence = scanSequence->load();
+    auto* workerPtr = &worker;
+
+    worker.launchAsync(scannerExecutable_, [this, validFlag, scanSequence, sequence,
+                                            workerPtr](bool launched) {
+        juce::MessageManager::callAsync([this, validFlag, scanSequence, sequence, workerPtr,
+                                         launched]() {
+            if (!validFlag->load() || scanSequence->load() != sequence) {
+                return;
+            }
+            handleWorkerLaunched(*workerPtr, launched);
+        });
+    });
+}
+
+void PluginScanCoordinator::handleWorkerLaunched(WorkerConnection& worker, bool launched) {
+    worker.launchPending = false;
+    worker.isRunning = launched;
+
+    if (!launched) {
+        std::cerr << "[ScanCoordinator] Failed to launch scanner " << worker.getIndex()
+                  << std::endl;
+        worker.retired = true;
+        if (allWorkersIdle()) {
+            finishScan(pendingFiles_.empty());
+        }
         return;
     }
 
-    // Get search paths
-    auto searchPath = format->getDefaultLocationsToSearch();
-    juce::String searchPathStr;
-    for (int i = 0; i < searchPath.getNumPaths(); ++i) {
-        if (i > 0)
-            searchPathStr += ";";
-        searchPathStr += searchPath[i].getFullPathName();
+    // The connection-lost event of a process that died straight away can overtake
+    // this one; handle it now that the launch is over
+    if (worker.lostWhileLaunching) {
+        worker.lostWhileLaunching = false;
+        handleWorkerLost(worker);
+        return;
     }
 
-    // Send scan command to worker
-    sendScanCommand(formatName, searchPathStr, blacklistedPlugins_);
+    worker.lastActivityTime = juce::Time::currentTimeMillis();
+    dispatchNextFile(worker);
 }
 
-void PluginScanCoordinator::sendScanCommand(const juce::String& formatName,
-                                            const juce::String& searchPath,
-                                            const juce::StringArray& blacklist) {
-    // Clear current plugin state before sending new command
-    currentPluginBeingScanned_.clear();
-
-    juce::MemoryBlock msg;
-    juce::MemoryOutputStream stream(msg, false);
+void PluginScanCoordinator::dispatchNextFile(WorkerConnection& worker) {
+    if (!isScanning_) {
+        return;
+    }
 
-    stream.writeString(ScannerIPC::MSG_SCAN_FORMAT);
-    stream.writeString(formatName);
-    stream.writeString(searchPath);
-    stream.writeInt(blacklist.size());
-    for (const auto& plugin : blacklist) {
-        stream.writeString(plugin);
+    if (pendingFiles_.empty()) {
+        worker.hasFile = false;
+        if (allWorkersIdle()) {
+            std::cout << "[ScanCoordinator] All files scanned" << std::endl;
+            finishScan(true);
+        }
+        return;
     }
 
-    std::cout << "[ScanCoordinator] Sending scan command for format: " << formatName << " with "
-              << blacklist.size() << " blacklisted plugins" << std::endl;
+    worker.currentFile = pendingFiles_.front();
+    pendingFiles_.pop_front();
+    worker.hasFile = true;
+    worker.currentFailed = false;
+    worker.currentErrored = false;
+    worker.currentResults.clear();
+    worker.lastActivityTime = juce::Time::currentTimeMillis();
+    worker.scanStartMs = juce::Time::getMillisecondCounterHiRes();
 
-    sendMessageToWorker(msg);
-    lastProgressTime_ = juce::Time::currentTimeMillis();
+    juce::MemoryBlock msg;
+    juce::MemoryOutputStream stream(msg, false);
+    stream.writeString(ScannerIPC::MSG_SCAN_FILE);
+    stream.writeString(worker.currentFile.formatName);
+    stream.writeString(worker.currentFile.fileOrIdentifier);
+    worker.send(msg);
+
+    reportProgress(worker.currentFile.fileOrIdentifier);
 }
 
-void PluginScanCoordinator::handleMessageFromWorker(const juce::MemoryBlock& message) {
+void PluginScanCoordinator::handleWorkerMessage(WorkerConnection& worker,
+                                                const juce::MemoryBlock& message) {
+    if (!isScanning_) {
+        return;
+    }
+
     juce::MemoryInputStream stream(message, false);
     juce::String msgType = stream.readString();
 
-    if (msgType == ScannerIPC::MSG_PROGRESS) {
-        float progress = stream.readFloat();
-        lastProgressTime_ = juce::Time::currentTimeMillis();
-        consecutiveFailures_ = 0;  // Scanner is making progress
+    worker.lastActivityTime = juce::Time::currentTimeMillis();
 
-        if (progressCallback_) {
-            // Calculate overall progress including format index
-            float overallProgress = (currentFormatIndex_ + progress) / formatsToScan_.size();
-            progressCallback_(overallProgress, currentPluginBeingScanned_);
-        }
-    } else if (msgType == ScannerIPC::MSG_CURRENT_FILE) {
-        currentPluginBeingScanned_ = stream.readString();
-        lastProgressTime_ = juce::Time::currentTimeMillis();
-        consecutiveFailures_ = 0;  // Scanner is making progress
-        std::cout << "[ScanCoordinator] Scanning: " << currentPluginBeingScanned_ << std::endl;
-
-        if (progressCallback_) {
-            float overallProgress = static_cast<float>(currentFormatIndex_) / formatsToScan_.size();
-            progressCallback_(overallProgress, currentPluginBeingScanned_);
-        }
+    if (msgType == ScannerIPC::MSG_CURRENT_FILE) {
+        std::cout << "[ScanCoordinator] Worker " << worker.getIndex()
+                  << " scanning: " << stream.readString() << std::endl;
     } else if (msgType == ScannerIPC::MSG_PLUGIN_FOUND) {
         juce::PluginDescription desc;
         desc.name = stream.readString();
@@ -247,8 +401,7 @@ void PluginScanCoordinator::handleMessageFromWorker(const juce::MemoryBlock& mes
         desc.isInstrument = stream.readBool();
         desc.category = stream.readString();
 
-        foundPlugins_.add(desc);
-        consecutiveFailures_ = 0;  // Successfully found a plugin, reset failure count
+        worker.currentResults.add(desc);
         std::cout << "[ScanCoordinator] Found: " << desc.name << " (" << desc.pluginFormatName
                   << ")" << std::endl;
     } else if (msgType == ScannerIPC::MSG_ERROR) {
@@ -256,162 +409,144 @@ void PluginScanCoordinator::handleMessageFromWorker(const juce::MemoryBlock& mes
         juce::String error = stream.readString();
 
         if (plugin.isNotEmpty()) {
-            failedPlugins_.add(plugin);
-            blacklistPlugin(plugin);
+            worker.currentFailed = true;
             std::cout << "[ScanCoordinator] Failed: " << plugin << " - " << error << std::endl;
         } else {
+            worker.currentErrored = true;
             std::cerr << "[ScanCoordinator] Error: " << error << std::endl;
         }
     } else if (msgType == ScannerIPC::MSG_SCAN_COMPLETE) {
-        std::cout << "[ScanCoordinator] Format scan complete" << std::endl;
-        currentFormatIndex_++;
-        scanNextFormat();
+        completeCurrentFile(worker, worker.currentFailed);
+        dispatchNextFile(worker);
     }
 }
 
-void PluginScanCoordinator::handleConnectionLost() {
-    std::cout << "[ScanCoordinator] Connection to scanner lost" << std::endl;
-
-    if (!isScanning_) {
-        std::cout << "[ScanCoordinator] Not scanning, ignoring connection lost" << std::endl;
+void PluginScanCoordinator::completeCurrentFile(WorkerConnection& worker, bool failed) {
+    if (!worker.hasFile) {
         return;
     }
 
-    // Prevent multiple simultaneous recovery attempts
-    if (isRecovering_) {
-        std::cout << "[ScanCoordinator] Already recovering, ignoring duplicate connection lost"
-                  << std::endl;
-        return;
+    const auto& file = worker.currentFile.fileOrIdentifier;
+
+    if (failed) {
+        failedPlugins_.add(file);
+        blacklistPlugin(file);
+        scanDatabase_.remove(file);
+    } else if (worker.currentErrored) {
+        // The scanner never got to the file (e.g. it lacks the format), so there is no
+        // result to cache: leave it to be scanned again next time
+        scanDatabase_.remove(file);
+    } else {
+        foundPlugins_.addArray(worker.currentResults);
+        scanDatabase_.update(file, worker.currentFile.stamp, worker.currentResults);
+        worker.consecutiveFailures = 0;
     }
 
-    isRecovering_ = true;
-
-    // Try to read the dead man's pedal file to identify the crashing plugin
-    // JUCE's PluginDirectoryScanner writes the current plugin path to this file
-    if (currentPluginBeingScanned_.isEmpty() && currentFormatIndex_ < formatsToScan_.size()) {
-        juce::String formatName = formatsToScan_[currentFormatIndex_];
-        juce::File deadMansPedal =
-            juce::File::getSpecialLocation(juce::File::tempDirectory)
-                .getChildFile("magda_scanner_current_" + formatName + ".txt");
-
-        if (deadMansPedal.existsAsFile()) {
-            // The file may be written in wide char format (UTF-16), try to read it
-            juce::String content = deadMansPedal.loadFileAsString();
-            if (content.isEmpty()) {
-                // Try reading as raw data and converting from UTF-16
-                juce::MemoryBlock data;
-                if (deadMansPedal.loadFileAsData(data) && data.getSize() > 0) {
-                    // Check for UTF-16 BOM or null bytes indicating wide chars
-                    const char* rawData = static_cast<const char*>(data.getData());
-                    bool isWideChar = false;
-                    for (size_t i = 1; i < data.getSize() && i < 20; i += 2) {
-                        if (rawData[i] == 0) {
-                            isWideChar = true;
-                            break;
-                        }
-                    }
-
-                    if (isWideChar) {
-                        // Convert from UTF-16LE
-                        content = juce::String(juce::CharPointer_UTF16(
-                            reinterpret_cast<const juce::CharPointer_UTF16::CharType*>(rawData)));
-                    }
-                }
-            }
+    PerformanceMonitor::getInstance().addSample(
+        "PluginScan", juce::Time::getMillisecondCounterHiRes() - worker.scanStartMs);
 
-            content = content.trim();
-            if (content.isNotEmpty()) {
-                std::cout << "[ScanCoordinator] Dead man's pedal indicates crashing plugin: "
-                          << content << std::endl;
-                currentPluginBeingScanned_ = content;
+    worker.hasFile = false;
+    worker.currentResults.clear();
+    ++filesCompleted_;
+}
 
-                // Clear the dead man's pedal file to prevent re-reading stale data
-                deadMansPedal.deleteFile();
-            }
-        }
+void PluginScanCoordinator::handleWorkerLost(WorkerConnection& worker) {
+    std::cout << "[ScanCoordinator] Connection to scanner " << worker.getIndex() << " lost"
+              << std::endl;
+
+    worker.isRunning = false;
+
+    if (!isScanning_) {
+        std::cout << "[ScanCoordinator] Not scanning, ignoring connection lost" << std::endl;
+        return;
     }
 
-    // The scanner crashed - blacklist the current plugin ONLY if we have a valid one
-    // (i.e., we were in the middle of scanning a specific plugin)
-    if (currentPluginBeingScanned_.isNotEmpty()) {
-        std::cout << "[ScanCoordinator] Blacklisting crashed plugin: " << currentPluginBeingScanned_
-                  << std::endl;
-        blacklistPlugin(currentPluginBeingScanned_);
-        failedPlugins_.add(currentPluginBeingScanned_);
-        currentPluginBeingScanned_.clear();
-        consecutiveFailures_ = 0;  // Reset if we actually found a crashing plugin
-    } else {
-        // No plugin was being scanned - the scanner crashed during initialization
-        // or between plugins. Increment failure counter.
-        consecutiveFailures_++;
-        std::cout << "[ScanCoordinator] Scanner crashed without identifying plugin (failure "
-                  << consecutiveFailures_ << "/" << MAX_CONSECUTIVE_FAILURES << ")" << std::endl;
+    if (worker.launchPending) {
+        worker.lostWhileLaunching = true;  // Handled once the launch result arrives
+        return;
     }
 
-    // Check if we've had too many consecutive failures without identifying a plugin
-    if (consecutiveFailures_ >= MAX_CONSECUTIVE_FAILURES) {
-        std::cout << "[ScanCoordinator] Too many consecutive failures, moving to next format"
+    // Each worker scans exactly one file at a time, so a crash identifies the plugin
+    if (worker.hasFile) {
+        std::cout << "[ScanCoordinator] Blacklisting crashed plugin: "
+                  << worker.currentFile.fileOrIdentifier << std::endl;
+        completeCurrentFile(worker, true);
+        worker.consecutiveFailures = 0;
+    } else {
+        // Crashed during startup or between files
+        worker.consecutiveFailures++;
+        std::cout << "[ScanCoordinator] Scanner " << worker.getIndex()
+                  << " crashed without identifying plugin (failure "
+                  << worker.consecutiveFailures << "/" << MAX_CONSECUTIVE_FAILURES << ")"
                   << std::endl;
-        consecutiveFailures_ = 0;
-        currentFormatIndex_++;
+    }
 
-        if (currentFormatIndex_ >= formatsToScan_.size()) {
-            std::cout << "[ScanCoordinator] No more formats to scan, finishing" << std::endl;
-            isRecovering_ = false;
-            finishScan(foundPlugins_.size() > 0);
-            return;
+    if (worker.consecutiveFailures >= MAX_CONSECUTIVE_FAILURES) {
+        std::cout << "[ScanCoordinator] Retiring scanner " << worker.getIndex() << std::endl;
+        worker.retired = true;
+        if (allWorkersIdle()) {
+            finishScan(pendingFiles_.empty());
         }
+        return;
     }
 
-    // Report the crash to the progress callback
-    if (progressCallback_) {
-        progressCallback_(static_cast<float>(currentFormatIndex_) / formatsToScan_.size(),
-                          "Scanner crashed, restarting...");
-    }
+    scheduleRelaunch(worker);
+}
+
+void PluginScanCoordinator::scheduleRelaunch(WorkerConnection& worker) {
+    worker.launchPending = true;
 
-    // Capture current sequence to detect if scan was aborted/restarted during delay
-    int currentSequence = recoverySequence_;
+    reportProgress("Scanner crashed, restarting...");
 
-    // Capture validity flag to safely check if object still exists
+    const int index = worker.getIndex();
+    const int sequence = scanSequence_->load();
     auto validFlag = validFlag_;
 
     // Use a delayed callback to give the crashed process time to fully terminate
-    juce::Timer::callAfterDelay(RECOVERY_DELAY_MS, [this, currentSequence, validFlag]() {
+    juce::Timer::callAfterDelay(RECOVERY_DELAY_MS, [this, index, sequence, validFlag]() {
         // Check if this object was destroyed
         if (!validFlag->load()) {
             return;
         }
 
         // Check if this callback is stale (scan was aborted or restarted)
-        if (currentSequence != recoverySequence_) {
+        if (sequence != scanSequence_->load() || !isScanning_) {
             std::cout << "[ScanCoordinator] Stale recovery callback ignored" << std::endl;
             return;
         }
 
-        isRecovering_ = false;
+        std::cout << "[ScanCoordinator] Relaunching scanner " << index << std::endl;
+        launchWorker(*workers_[static_cast<size_t>(index)]);
+    });
+}
 
-        if (!isScanning_) {
-            std::cout << "[ScanCoordinator] Scan was aborted, not relaunching" << std::endl;
-            return;
-        }
+bool PluginScanCoordinator::allWorkersIdle() const {
+    bool allRetired = true;
 
-        if (launchScannerProcess()) {
-            std::cout << "[ScanCoordinator] Relaunched scanner, continuing scan" << std::endl;
-            lastProgressTime_ = juce::Time::currentTimeMillis();
-            scanNextFormat();
-        } else {
-            std::cout << "[ScanCoordinator] Failed to relaunch scanner, trying next format"
-                      << std::endl;
-            currentFormatIndex_++;
-            if (currentFormatIndex_ < formatsToScan_.size() && launchScannerProcess()) {
-                lastProgressTime_ = juce::Time::currentTimeMillis();
-                scanNextFormat();
-            } else {
-                std::cout << "[ScanCoordinator] Cannot continue, finishing scan" << std::endl;
-                finishScan(foundPlugins_.size() > 0);
-            }
+    for (const auto& worker : workers_) {
+        if (worker->retired) {
+            continue;
         }
-    });
+        allRetired = false;
+        if (worker->hasFile || worker->launchPending) {
+            return false;
+        }
+    }
+
+    // Remaining files are only stranded if every worker has been retired
+    return allRetired || pendingFiles_.empty();
+}
+
+void PluginScanCoordinator::reportProgress(const juce::String& currentPlugin) {
+    if (!progressCallback_) {
+        return;
+    }
+
+    float progress = 1.0f;
+    if (totalFilesToScan_ > 0) {
+        progress = static_cast<float>(filesCompleted_) / static_cast<float>(totalFilesToScan_);
+    }
+    progressCallback_(progress, currentPlugin);
 }
 
 void PluginScanCoordinator::timerCallback() {
@@ -420,64 +555,58 @@ void PluginScanCoordinator::timerCallback() {
         return;
     }
 
-    // Check for timeout
-    juce::int64 elapsed = juce::Time::currentTimeMillis() - lastProgressTime_;
-    if (elapsed > PLUGIN_TIMEOUT_MS) {
-        std::cout << "[ScanCoordinator] Plugin scan timeout on: " << currentPluginBeingScanned_
-                  << std::endl;
-
-        // Blacklist the stuck plugin
-        if (currentPluginBeingScanned_.isNotEmpty()) {
-            blacklistPlugin(currentPluginBeingScanned_);
-            failedPlugins_.add(currentPluginBeingScanned_);
+    // Check each worker for a timeout on its current plugin
+    const auto now = juce::Time::currentTimeMillis();
+    for (auto& worker : workers_) {
+        if (!worker->hasFile || !worker->isRunning) {
+            continue;
         }
 
-        // Kill the scanner - this will trigger handleConnectionLost which will restart
-        killWorkerProcess();
-        currentPluginBeingScanned_.clear();
+        if (now - worker->lastActivityTime > PLUGIN_TIMEOUT_MS) {
+            std::cout << "[ScanCoordinator] Plugin scan timeout on: "
+                      << worker->currentFile.fileOrIdentifier << std::endl;
 
-        // handleConnectionLost will be called and will handle the restart
+            // Blacklist the stuck plugin, then kill and relaunch this worker only
+            completeCurrentFile(*worker, true);
+            worker->kill();
+            scheduleRelaunch(*worker);
+        }
     }
 }
 
 void PluginScanCoordinator::abortScan() {
-    // Set isScanning_ to false BEFORE killing the worker process
-    // to prevent handleConnectionLost from trying to recover
+    // Set isScanning_ to false BEFORE killing the worker processes
+    // to prevent connection-lost handling from trying to recover
     isScanning_ = false;
-    isRecovering_ = false;
-    recoverySequence_++;  // Invalidate any pending recovery callbacks
+    scanSequence_->fetch_add(1);  // Invalidate any pending callbacks
 
     stopTimer();
-    killWorkerProcess();
+    for (auto& worker : workers_) {
+        worker->kill();
+    }
+    workers_.clear();
 
-    consecutiveFailures_ = 0;
-    currentPluginBeingScanned_.clear();
+    pendingFiles_.clear();
 }
 
 void PluginScanCoordinator::finishScan(bool success) {
     std::cout << "[ScanCoordinator] finishScan called, success=" << success << std::endl;
 
     // IMPORTANT: Set isScanning_ to false BEFORE any cleanup
-    // This ensures handleConnectionLost() will be ignored
+    // This ensures connection-lost events will be ignored
     isScanning_ = false;
-    isRecovering_ = false;
 
     // Invalidate callbacks to prevent any pending ones from interfering
-    recoverySequence_++;
+    scanSequence_->fetch_add(1);
 
     // Stop timer
     stopTimer();
 
-    // Send QUIT message to scanner so it exits gracefully
-    // This is better than killWorkerProcess() which can cause thread cleanup issues
-    juce::MemoryBlock quitMsg;
-    juce::MemoryOutputStream quitStream(quitMsg, false);
-    quitStream.writeString(ScannerIPC::MSG_QUIT);
-    sendMessageToWorker(quitMsg);
+    shutdownWorkers();
+    pendingFiles_.clear();
 
-    // Clear remaining state
-    consecutiveFailures_ = 0;
-    currentPluginBeingScanned_.clear();
+    // Persist results so the next scan can skip unchanged files
+    (void)scanDatabase_.saveToFile(PluginScanDatabase::getDefaultFile());
 
     std::cout << "[ScanCoordinator] Scan finished. Found " << foundPlugins_.size() << " plugins, "
               << failedPlugins_.size() << " failed." << std::endl;
@@ -491,6 +620,21 @@ void PluginScanCoordinator::finishScan(bool success) {
     }
 }
 
+void PluginScanCoordinator::shutdownWorkers() {
+    // Send QUIT message to scanners so they exit gracefully
+    // This is better than killWorkerProcess() which can cause thread cleanup issues.
+    // The connections are kept until the next scan (or destruction) to let them exit.
+    juce::MemoryBlock quitMsg;
+    juce::MemoryOutputStream quitStream(quitMsg, false);
+    quitStream.writeString(ScannerIPC::MSG_QUIT);
+
+    for (auto& worker : workers_) {
+        if (worker->isRunning) {
+            worker->send(quitMsg);
+        }
+    }
+}
+
 // Blacklist management
 juce::File PluginScanCoordinator::getBlacklistFile() const {
     return juce::File::getSpecialLocation(juce::File::userApplicationDataDirectory)
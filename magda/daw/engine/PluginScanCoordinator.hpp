@@ -4,7 +4,13 @@
 #include <juce_core/juce_core.h>
 #include <juce_events/juce_events.h>
 
+#include <atomic>
+#include <deque>
 #include <functional>
+#include <memory>
+#include <vector>
+
+#include "PluginScanDatabase.hpp"
 
 namespace magda {
 
@@ -13,6 +19,7 @@ namespace magda {
  */
 namespace ScannerIPC {
 constexpr const char* MSG_SCAN_FORMAT = "SCAN";
+constexpr const char* MSG_SCAN_FILE = "SCNF";
 constexpr const char* MSG_PROGRESS = "PROG";
 constexpr const char* MSG_PLUGIN_FOUND = "PLUG";
 constexpr const char* MSG_SCAN_COMPLETE = "DONE";
@@ -24,11 +31,16 @@ constexpr const char* MSG_QUIT = "QUIT";
 /**
  * @brief Coordinates out-of-process plugin scanning
  *
- * Uses JUCE's ChildProcessCoordinator to launch the magda_plugin_scanner
- * executable and communicate with it via IPC. If the scanner crashes on
- * a problematic plugin, only the subprocess dies - the main app continues.
+ * Launches a pool of magda_plugin_scanner processes (one per CPU core by default)
+ * and hands them plugin files one at a time from a shared queue, so the file list
+ * is sharded dynamically across workers. If a scanner crashes or hangs on a
+ * problematic plugin, only that subprocess dies: the file it was scanning is
+ * blacklisted and the worker is relaunched.
+ *
+ * Results are kept in a PluginScanDatabase keyed by path + mtime + size, so files
+ * that have not changed since the last scan are skipped entirely.
  */
-class PluginScanCoordinator : private juce::ChildProcessCoordinator, private juce::Timer {
+class PluginScanCoordinator : private juce::Timer {
   public:
     PluginScanCoordinator();
     ~PluginScanCoordinator() override;
@@ -94,20 +106,47 @@ class PluginScanCoordinator : private juce::ChildProcessCoordinator, private juc
      */
     void blacklistPlugin(const juce::String& pluginPath);
 
+    /**
+     * @brief Set how many scanner processes run in parallel
+     * @param numWorkers Worker count (0 = one per CPU core)
+     */
+    void setNumWorkers(int numWorkers);
+
+    int getNumWorkers() const;
+
+    /**
+     * @brief Forget cached scan results so the next scan re-examines every plugin
+     */
+    void clearScanCache();
+
   private:
-    // ChildProcessCoordinator overrides
-    void handleMessageFromWorker(const juce::MemoryBlock& message) override;
-    void handleConnectionLost() override;
+    class WorkerConnection;  // One magda_plugin_scanner child process
+
+    // A plugin file (or format identifier) waiting to be scanned
+    struct PendingFile {
+        juce::String formatName;
+        juce::String fileOrIdentifier;
+        PluginScanDatabase::FileStamp stamp;
+    };
 
-    // Timer for timeout handling
+    // Worker events, always delivered on the message thread
+    void handleWorkerMessage(WorkerConnection& worker, const juce::MemoryBlock& message);
+    void handleWorkerLost(WorkerConnection& worker);
+
+    // Timer for per-worker timeout handling
     void timerCallback() override;
 
     // Internal scanning methods
-    bool launchScannerProcess();
-    void scanNextFormat();
-    void sendScanCommand(const juce::String& formatName, const juce::String& searchPath,
-                         const juce::StringArray& blacklist);
+    void collectFilesToScan();
+    void launchWorker(WorkerConnection& worker);
+    void handleWorkerLaunched(WorkerConnection& worker, bool launched);
+    void dispatchNextFile(WorkerConnection& worker);
+    void completeCurrentFile(WorkerConnection& worker, bool failed);
+    void scheduleRelaunch(WorkerConnection& worker);
+    void reportProgress(const juce::String& currentPlugin);
+    bool allWorkersIdle() const;
     void finishScan(bool success);
+    void shutdownWorkers();
 
     // Find the scanner executable
     juce::File getScannerExecutable() const;
@@ -123,29 +162,34 @@ class PluginScanCoordinator : private juce::ChildProcessCoordinator, private juc
     ProgressCallback progressCallback_;
     CompletionCallback completionCallback_;
 
-    // Scanning state
-    int currentFormatIndex_ = 0;
-    juce::String currentPluginBeingScanned_;
-    juce::StringArray formatsToScan_;
+    // Worker pool and shared work queue
+    int numWorkers_ = 0;  // 0 = one per CPU core
+    std::vector<std::unique_ptr<WorkerConnection>> workers_;
+    std::deque<PendingFile> pendingFiles_;
+    int totalFilesToScan_ = 0;
+    int filesCompleted_ = 0;
+    juce::File scannerExecutable_;
 
     // Results
     juce::Array<juce::PluginDescription> foundPlugins_;
     juce::StringArray failedPlugins_;
     juce::StringArray blacklistedPlugins_;
 
+    // Incremental scan cache (path + mtime + size -> plugins)
+    PluginScanDatabase scanDatabase_;
+
     // Timeout tracking
     static constexpr int PLUGIN_TIMEOUT_MS = 30000;  // 30 seconds per plugin
-    juce::int64 lastProgressTime_ = 0;
 
-    // Recovery state to prevent multiple simultaneous recovery attempts
-    bool isRecovering_ = false;
-    int consecutiveFailures_ = 0;
-    int recoverySequence_ = 0;  // Incremented each scan, used to invalidate stale callbacks
+    // Failure handling
     static constexpr int MAX_CONSECUTIVE_FAILURES =
-        3;  // Reduced - fail faster to avoid system strain
+        3;  // Per worker - retire a worker that keeps dying without scanning anything
     static constexpr int RECOVERY_DELAY_MS =
         1000;  // Delay before relaunching after crash (reduced from 2000)
 
+    // Incremented each scan/abort, used to invalidate stale async callbacks
+    std::shared_ptr<std::atomic<int>> scanSequence_ = std::make_shared<std::atomic<int>>(0);
+
     // Validity flag for async callbacks - set to false in destructor
     std::shared_ptr<std::atomic<bool>> validFlag_ = std::make_shared<std::atomic<bool>>(true);
 
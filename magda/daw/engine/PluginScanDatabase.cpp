@@ -0,0 +1,149 @@
+#include "PluginScanDatabase.hpp"
+
+namespace magda {
+
+namespace {
+
+// Installers replace the files inside a bundle without touching the bundle directory
+// itself, so a bundle is stamped from its Info.plist and the binaries in its
+// Contents/<platform> folders (MacOS, x86_64-linux, x86_64-win, ...).
+juce::Array<juce::File> findBundleFiles(const juce::File& bundle) {
+    juce::Array<juce::File> files;
+    auto contents = bundle.getChildFile("Contents");
+
+    auto infoPlist = contents.getChildFile("Info.plist");
+    if (infoPlist.existsAsFile()) {
+        files.add(infoPlist);
+    }
+
+    for (const auto& dir : contents.findChildFiles(juce::File::findDirectories, false)) {
+        if (dir.getFileName() == "Resources") {
+            continue;
+        }
+        files.addArray(dir.findChildFiles(juce::File::findFiles, false));
+    }
+
+    return files;
+}
+
+}  // namespace
+
+PluginScanDatabase::FileStamp PluginScanDatabase::stampFor(const juce::String& fileOrIdentifier) {
+    FileStamp stamp;
+
+    if (!juce::File::isAbsolutePath(fileOrIdentifier)) {
+        return stamp;
+    }
+
+    juce::File file(fileOrIdentifier);
+    if (!file.exists()) {
+        return stamp;
+    }
+
+    if (!file.isDirectory()) {
+        stamp.modificationTime = file.getLastModificationTime().toMilliseconds();
+        stamp.size = file.getSize();
+        return stamp;
+    }
+
+    auto bundleFiles = findBundleFiles(file);
+    if (bundleFiles.isEmpty()) {
+        stamp.modificationTime = file.getLastModificationTime().toMilliseconds();
+        return stamp;
+    }
+
+    for (const auto& bundleFile : bundleFiles) {
+        stamp.modificationTime = juce::jmax(
+            stamp.modificationTime, bundleFile.getLastModificationTime().toMilliseconds());
+        stamp.size += bundleFile.getSize();
+    }
+    return stamp;
+}
+
+const juce::Array<juce::PluginDescription>* PluginScanDatabase::findUpToDate(
+    const juce::String& fileOrIdentifier, const FileStamp& currentStamp) const {
+    auto it = entries_.find(fileOrIdentifier);
+    if (it == entries_.end() || it->second.stamp != currentStamp) {
+        return nullptr;
+    }
+    return &it->second.plugins;
+}
+
+void PluginScanDatabase::update(const juce::String& fileOrIdentifier, const FileStamp& stamp,
+                                const juce::Array<juce::PluginDescription>& plugins) {
+    auto& entry = entries_[fileOrIdentifier];
+    entry.stamp = stamp;
+    entry.plugins = plugins;
+}
+
+void PluginScanDatabase::remove(const juce::String& fileOrIdentifier) {
+    entries_.erase(fileOrIdentifier);
+}
+
+void PluginScanDatabase::retainOnly(const juce::StringArray& fileOrIdentifiers) {
+    for (auto it = entries_.begin(); it != entries_.end();) {
+        if (fileOrIdentifiers.contains(it->first)) {
+            ++it;
+        } else {
+            it = entries_.erase(it);
+        }
+    }
+}
+
+bool PluginScanDatabase::loadFromFile(const juce::File& file) {
+    entries_.clear();
+
+    if (!file.existsAsFile()) {
+        return false;
+    }
+
+    auto xml = juce::XmlDocument::parse(file);
+    if (!xml || !xml->hasTagName("PLUGIN_SCAN_CACHE") ||
+        xml->getIntAttribute("version") != FORMAT_VERSION) {
+        return false;
+    }
+
+    for (auto* fileXml : xml->getChildWithTagNameIterator("FILE")) {
+        Entry entry;
+        entry.stamp.modificationTime = fileXml->getStringAttribute("mtime").getLargeIntValue();
+        entry.stamp.size = fileXml->getStringAttribute("size").getLargeIntValue();
+
+        for (auto* pluginXml : fileXml->getChildWithTagNameIterator("PLUGIN")) {
+            juce::PluginDescription desc;
+            if (desc.loadFromXml(*pluginXml)) {
+                entry.plugins.add(desc);
+            }
+        }
+
+        entries_[fileXml->getStringAttribute("id")] = std::move(entry);
+    }
+
+    return true;
+}
+
+bool PluginScanDatabase::saveToFile(const juce::File& file) const {
+    juce::XmlElement root("PLUGIN_SCAN_CACHE");
+    root.setAttribute("version", FORMAT_VERSION);
+
+    for (const auto& [id, entry] : entries_) {
+        auto* fileXml = root.createNewChildElement("FILE");
+        fileXml->setAttribute("id", id);
+        fileXml->setAttribute("mtime", juce::String(entry.stamp.modificationTime));
+        fileXml->setAttribute("size", juce::String(entry.stamp.size));
+
+        for (const auto& desc : entry.plugins) {
+            fileXml->addChildElement(desc.createXml().release());
+        }
+    }
+
+    (void)file.getParentDirectory().createDirectory();
+    return root.writeTo(file);
+}
+
+juce::File PluginScanDatabase::getDefaultFile() {
+    return juce::File::getSpecialLocation(juce::File::userApplicationDataDirectory)
+        .getChildFile("MAGDA")
+        .getChildFile("PluginScanCache.xml");
+}
+
+}  // namespace magda
@@ -0,0 +1,94 @@
+#pragma once
+
+#include <juce_audio_processors/juce_audio_processors.h>
+#include <juce_core/juce_core.h>
+
+#include <unordered_map>
+
+namespace magda {
+
+/**
+ * @brief Persistent cache of plugin scan results keyed by file
+ *
+ * Each scanned plugin file (or format identifier) is stored with the modification
+ * time and size it had when scanned, plus the plugin descriptions it produced.
+ * On the next scan, files whose stamp is unchanged are served from the cache
+ * instead of being handed to a scanner process, so incremental rescans only
+ * touch new or modified plugins.
+ *
+ * Bundles are stamped from their Info.plist and binaries rather than the bundle
+ * directory, whose own mtime an update inside it does not change. Identifiers that
+ * are not files on disk (e.g. AudioUnit component IDs) are stamped with zeros and
+ * stay cached until clear() is called.
+ */
+class PluginScanDatabase {
+  public:
+    /**
+     * @brief Modification time + size of a plugin file when it was scanned
+     */
+    struct FileStamp {
+        juce::int64 modificationTime = 0;  // milliseconds since epoch
+        juce::int64 size = 0;              // bytes (bundles: Info.plist + binaries)
+
+        bool operator==(const FileStamp& other) const {
+            return modificationTime == other.modificationTime && size == other.size;
+        }
+        bool operator!=(const FileStamp& other) const {
+            return !(*this == other);
+        }
+    };
+
+    /**
+     * @brief Read the current stamp of a plugin file or identifier from disk
+     */
+    static FileStamp stampFor(const juce::String& fileOrIdentifier);
+
+    /**
+     * @brief Get cached plugins for a file whose stamp is unchanged
+     * @return The cached descriptions, or nullptr if the file must be (re)scanned
+     */
+    const juce::Array<juce::PluginDescription>* findUpToDate(
+        const juce::String& fileOrIdentifier, const FileStamp& currentStamp) const;
+
+    /**
+     * @brief Record the result of scanning a file
+     */
+    void update(const juce::String& fileOrIdentifier, const FileStamp& stamp,
+                const juce::Array<juce::PluginDescription>& plugins);
+
+    /**
+     * @brief Forget a file (e.g. it crashed the scanner or was blacklisted)
+     */
+    void remove(const juce::String& fileOrIdentifier);
+
+    /**
+     * @brief Drop entries for files that no longer exist in the search paths
+     */
+    void retainOnly(const juce::StringArray& fileOrIdentifiers);
+
+    void clear() {
+        entries_.clear();
+    }
+
+    int size() const {
+        return static_cast<int>(entries_.size());
+    }
+
+    // Persistence (XML, alongside PluginList.xml)
+    bool loadFromFile(const juce::File& file);
+    bool saveToFile(const juce::File& file) const;
+
+    static juce::File getDefaultFile();
+
+  private:
+    struct Entry {
+        FileStamp stamp;
+        juce::Array<juce::PluginDescription> plugins;
+    };
+
+    std::unordered_map<juce::String, Entry> entries_;
+
+    static constexpr int FORMAT_VERSION = 2;
+};
+
+}  // namespace magda
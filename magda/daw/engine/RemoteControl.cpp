@@ -0,0 +1,157 @@
+#include "RemoteControl.hpp"
+
+#include <iostream>
+
+#include "TracktionEngineWrapper.hpp"
+
+namespace magda {
+
+namespace {
+
+template <typename Id>
+juce::var toIdArray(const std::set<Id>& ids) {
+    juce::Array<juce::var> array;
+    for (auto id : ids) {
+        array.add(static_cast<int>(id));
+    }
+    return array;
+}
+
+}  // namespace
+
+RemoteControl::RemoteControl(TracktionEngineWrapper& engine)
+    : engine_(engine),
+      server_([this](ControlServer::ClientId client, const std::string& request) {
+          return handleRequest(client, request);
+      }) {
+    TrackManager::getInstance().addListener(this);
+    ClipManager::getInstance().addListener(this);
+}
+
+RemoteControl::~RemoteControl() {
+    stop();
+    TrackManager::getInstance().removeListener(this);
+    ClipManager::getInstance().removeListener(this);
+}
+
+bool RemoteControl::start(const juce::File& socketFile) {
+    if (!server_.start(socketFile)) {
+        return false;
+    }
+    std::cout << "✓ Control socket listening on " << socketFile.getFullPathName() << std::endl;
+    return true;
+}
+
+void RemoteControl::stop() {
+    server_.stop();
+}
+
+// =============================================================================
+// Requests
+// =============================================================================
+
+std::string RemoteControl::handleRequest(ControlServer::ClientId client,
+                                         const std::string& request) {
+    juce::var json;
+    auto result = juce::JSON::parse(juce::String(request), json);
+
+    auto response = result.wasOk() && json.getDynamicObject() != nullptr
+                        ? runRequest(client, json)
+                        : CommandResponse(CommandResponse::Status::Error,
+                                          "Request must be a JSON object");
+
+    auto reply = response.toJson();
+    if (auto* obj = reply.getDynamicObject()) {
+        obj->setProperty("id", json.getProperty("id", {}));
+    }
+    return juce::JSON::toString(reply, true).toStdString();
+}
+
+CommandResponse RemoteControl::runRequest(ControlServer::ClientId client,
+                                          const juce::var& request) {
+    auto type = request["command"].toString();
+
+    if (type == "subscribe" || type == "unsubscribe") {
+        server_.setSubscribed(client, type == "subscribe");
+        return CommandResponse(CommandResponse::Status::Success,
+                               type == "subscribe" ? "Subscribed" : "Unsubscribed");
+    }
+
+    if (type == "batch") {
+        return engine_.processCommandBatch(request["commands"]);
+    }
+
+    if (type == "listCommands") {
+        juce::Array<juce::var> types;
+        for (const auto& commandType : engine_.getCommandTable().getCommandTypes()) {
+            types.add(juce::String(commandType));
+        }
+        CommandResponse response(CommandResponse::Status::Success);
+        response.setData(types);
+        return response;
+    }
+
+    // The id is for correlating the response, not a command parameter
+    request.getDynamicObject()->removeProperty("id");
+
+    try {
+        return engine_.processCommand(Command(request));
+    } catch (const std::exception& e) {
+        return CommandResponse(CommandResponse::Status::Error, e.what());
+    }
+}
+
+// =============================================================================
+// Events
+// =============================================================================
+
+template <typename Id>
+void RemoteControl::sendChangeEvent(const char* type, bool listChanged,
+                                    const IdChanges<Id>& changes) {
+    if (!server_.hasSubscribers()) {
+        return;
+    }
+
+    juce::DynamicObject::Ptr event = new juce::DynamicObject();
+    event->setProperty("event", type);
+    event->setProperty("listChanged", listChanged);
+    event->setProperty("added", toIdArray(changes.added));
+    event->setProperty("removed", toIdArray(changes.removed));
+    event->setProperty("modified", toIdArray(changes.modified));
+
+    server_.broadcastEvent(juce::JSON::toString(juce::var(event.get()), true).toStdString());
+}
+
+void RemoteControl::tracksChanged() {
+    sendChangeEvent("tracks", true, IdChanges<TrackId>{});
+}
+
+void RemoteControl::trackPropertyChanged(int trackId) {
+    IdChanges<TrackId> changes;
+    changes.modify(trackId);
+    sendChangeEvent("tracks", false, changes);
+}
+
+void RemoteControl::trackChangesCommitted(const ModelChangeSet& changes) {
+    if (changes.trackListChanged || !changes.tracks.empty()) {
+        sendChangeEvent("tracks", changes.trackListChanged, changes.tracks);
+    }
+}
+
+void RemoteControl::clipsChanged() {
+    sendChangeEvent("clips", true, IdChanges<ClipId>{});
+}
+
+void RemoteControl::clipPropertyChanged(ClipId clipId) {
+    IdChanges<ClipId> changes;
+    changes.modify(clipId);
+    sendChangeEvent("clips", false, changes);
+}
+
+void RemoteControl::clipChangesCommitted(const ModelChangeSet& changes) {
+    if (changes.clipListChanged || !changes.clips.empty()) {
+        sendChangeEvent("clips", changes.clipListChanged, changes.clips);
+    }
+}
+
+}  // namespace magda
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+
+#include "../core/ClipManager.hpp"
+#include "../core/TrackManager.hpp"
+#include "ControlServer.hpp"
+
+namespace magda {
+
+class TracktionEngineWrapper;
+
+/**
+ * @brief JSON command protocol over the local control socket
+ *
+ * Each request frame is one JSON command object, as accepted by Command, plus an "id"
+ * chosen by the client:
+ *   {"id": 7, "command": "setTempo", "bpm": 128}
+ * and is answered with the CommandResponse JSON carrying the same id:
+ *   {"id": 7, "status": "success", "message": "Tempo set"}
+ * Requests run on the message thread in the order they arrive; a client may send any
+ * number before reading the responses.
+ *
+ * Besides the engine's own commands:
+ * - "batch" runs its "commands" array through processCommandBatch()
+ * - "listCommands" returns the command types the engine accepts
+ * - "subscribe" / "unsubscribe" turn model change events on or off for the client
+ *
+ * Events are sent as {"event": "tracks" | "clips", "listChanged": bool,
+ * "added": [ids], "removed": [ids], "modified": [ids]}, one per model change
+ * (or per transaction, when edits are grouped).
+ *
+ * Commands and events share one id space: the track and clip commands take the integer
+ * model ids that events report (see registerModelCommands()), and the trackId/clipId a
+ * create command returns is the id later events will carry.
+ */
+class RemoteControl : private TrackManagerListener, private ClipManagerListener {
+  public:
+    explicit RemoteControl(TracktionEngineWrapper& engine);
+    ~RemoteControl() override;
+
+    bool start(const juce::File& socketFile = ControlServer::getDefaultSocketFile());
+    void stop();
+
+    const ControlServer& getServer() const {
+        return server_;
+    }
+
+  private:
+    std::string handleRequest(ControlServer::ClientId client, const std::string& request);
+    CommandResponse runRequest(ControlServer::ClientId client, const juce::var& request);
+
+    // TrackManagerListener
+    void tracksChanged() override;
+    void trackPropertyChanged(int trackId) override;
+    void trackChangesCommitted(const ModelChangeSet& changes) override;
+
+    // ClipManagerListener
+    void clipsChanged() override;
+    void clipPropertyChanged(ClipId clipId) override;
+    void clipChangesCommitted(const ModelChangeSet& changes) override;
+
+    template <typename Id>
+    void sendChangeEvent(const char* type, bool listChanged, const IdChanges<Id>& changes);
+
+    TracktionEngineWrapper& engine_;
+    ControlServer server_;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(RemoteControl)
+};
+
+}  // namespace magda
@@ -1,19 +1,24 @@
 #include "TracktionEngineWrapper.hpp"
 
 #include <iostream>
+#include <optional>
 
 #include "../audio/AudioBridge.hpp"
 #include "../audio/MidiBridge.hpp"
 #include "../core/Config.hpp"
 #include "../core/DeviceInfo.hpp"
+#include "../core/ModelTransaction.hpp"
 #include "../core/TrackManager.hpp"
+#include "../model_commands.hpp"
 #include "MagdaUIBehaviour.hpp"
 #include "PluginScanCoordinator.hpp"
 #include "PluginWindowManager.hpp"
 
 namespace magda {
 
-TracktionEngineWrapper::TracktionEngineWrapper() = default;
+TracktionEngineWrapper::TracktionEngineWrapper() {
+    registerCommands();
+}
 
 TracktionEngineWrapper::~TracktionEngineWrapper() {
     shutdown();
@@ -465,33 +470,170 @@ void TracktionEngineWrapper::changeListenerCallback(juce::ChangeBroadcaster* sou
 }
 
 CommandResponse TracktionEngineWrapper::processCommand(const Command& command) {
-    const auto& type = command.getType();
+    return commandTable_.execute(command);
+}
 
-    try {
-        if (type == "play") {
-            play();
-            return CommandResponse(CommandResponse::Status::Success, "Playback started");
-        } else if (type == "stop") {
-            stop();
-            return CommandResponse(CommandResponse::Status::Success, "Playback stopped");
-        } else if (type == "createTrack") {
-            // Simple parameter parsing - in a real implementation you'd parse JSON
-            auto trackId = createMidiTrack("New Track");
-
-            juce::DynamicObject::Ptr obj = new juce::DynamicObject();
-            obj->setProperty("trackId", juce::String(trackId));
-            juce::var responseData(obj.get());
-
-            auto response = CommandResponse(CommandResponse::Status::Success, "Track created");
-            response.setData(responseData);
-            return response;
-        } else {
-            return CommandResponse(CommandResponse::Status::Error, "Unknown command");
+CommandResponse TracktionEngineWrapper::processCommandBatch(const juce::var& commands) {
+    std::vector<CommandTable::Prepared> batch;
+    std::string error;
+    if (!commandTable_.prepareBatch(commands, batch, error)) {
+        return CommandResponse(CommandResponse::Status::Error, error);
+    }
+
+    // Listeners get one change set and the edit restarts playback once, after the last command
+    ModelTransactionScope transaction;
+    std::optional<tracktion::TransportControl::ScopedPlaybackRestartBlocker> restartBlocker;
+    if (currentEdit_) {
+        restartBlocker.emplace(currentEdit_->getTransport());
+    }
+
+    return CommandTable::runBatch(batch);
+}
+
+// =============================================================================
+// Command Table
+// =============================================================================
+
+namespace {
+
+using command_params::readBool;
+using command_params::readNumber;
+
+CommandResponse success(const std::string& message) {
+    return CommandResponse(CommandResponse::Status::Success, message);
+}
+
+CommandResponse noEdit() {
+    return CommandResponse(CommandResponse::Status::Error, "No edit is open");
+}
+
+struct NoParams {
+    bool parse(const Command&, std::string&) {
+        return true;
+    }
+};
+
+struct LocateParams {
+    double position = 0.0;
+    bool parse(const Command& c, std::string& error) {
+        if (!readNumber(c, "position", position, error)) {
+            return false;
         }
-    } catch (const std::exception& e) {
-        return CommandResponse(CommandResponse::Status::Error,
-                               "Command execution failed: " + std::string(e.what()));
+        if (position < 0.0) {
+            error = "position must be >= 0";
+            return false;
+        }
+        return true;
     }
+};
+
+struct TempoParams {
+    double bpm = 120.0;
+    bool parse(const Command& c, std::string& error) {
+        if (!readNumber(c, "bpm", bpm, error)) {
+            return false;
+        }
+        if (bpm <= 0.0) {
+            error = "bpm must be positive";
+            return false;
+        }
+        return true;
+    }
+};
+
+struct EnabledParams {
+    bool enabled = true;
+    bool parse(const Command& c, std::string& error) {
+        return readBool(c, "enabled", enabled, error);
+    }
+};
+
+struct LoopRegionParams {
+    double start = 0.0;
+    double end = 0.0;
+    bool parse(const Command& c, std::string& error) {
+        if (!readNumber(c, "start", start, error) || !readNumber(c, "end", end, error)) {
+            return false;
+        }
+        if (end <= start) {
+            error = "loop end must be after start";
+            return false;
+        }
+        return true;
+    }
+};
+
+}  // namespace
+
+void TracktionEngineWrapper::registerCommands() {
+    auto& table = commandTable_;
+
+    // Transport
+    table.add<NoParams>("play", [this](const NoParams&) {
+        if (!currentEdit_) {
+            return noEdit();
+        }
+        if (devicesLoading_) {
+            return CommandResponse(CommandResponse::Status::Error, "Devices are still loading");
+        }
+        play();
+        return success("Playback started");
+    });
+    table.add<NoParams>("stop", [this](const NoParams&) {
+        if (!currentEdit_) {
+            return noEdit();
+        }
+        stop();
+        return success("Playback stopped");
+    });
+    table.add<NoParams>("record", [this](const NoParams&) {
+        if (!currentEdit_) {
+            return noEdit();
+        }
+        if (devicesLoading_) {
+            return CommandResponse(CommandResponse::Status::Error, "Devices are still loading");
+        }
+        record();
+        return success("Recording started");
+    });
+    table.add<LocateParams>("locate", [this](const LocateParams& p) {
+        if (!currentEdit_) {
+            return noEdit();
+        }
+        locate(p.position);
+        return success("Located");
+    });
+    table.add<TempoParams>("setTempo", [this](const TempoParams& p) {
+        if (!currentEdit_) {
+            return noEdit();
+        }
+        setTempo(p.bpm);
+        return success("Tempo set");
+    });
+    table.add<EnabledParams>("setLooping", [this](const EnabledParams& p) {
+        if (!currentEdit_) {
+            return noEdit();
+        }
+        setLooping(p.enabled);
+        return success(p.enabled ? "Looping enabled" : "Looping disabled");
+    });
+    table.add<LoopRegionParams>("setLoopRegion", [this](const LoopRegionParams& p) {
+        if (!currentEdit_) {
+            return noEdit();
+        }
+        setLoopRegion(p.start, p.end);
+        return success("Loop region set");
+    });
+    table.add<EnabledParams>("setMetronome", [this](const EnabledParams& p) {
+        if (!currentEdit_) {
+            return noEdit();
+        }
+        setMetronomeEnabled(p.enabled);
+        return success(p.enabled ? "Metronome enabled" : "Metronome disabled");
+    });
+
+    // Tracks, mixer and clips edit the model; the bridge carries them into the edit
+    registerModelCommands(table);
 }
 
 // TransportInterface implementation
@@ -560,6 +702,9 @@ void TracktionEngineWrapper::locate(double position_seconds) {
     if (currentEdit_) {
         currentEdit_->getTransport().setPosition(
             tracktion::TimePosition::fromSeconds(position_seconds));
+        if (audioBridge_) {
+            audioBridge_->syncTransportPosition(position_seconds);
+        }
     }
 }
 
@@ -571,6 +716,9 @@ void TracktionEngineWrapper::locateMusical(int bar, int beat, int tick) {
             tracktion::BeatPosition::fromBeats(bar * 4.0 + beat - 1.0 + tick / 1000.0);
         auto timePosition = tempoSequence.beatsToTime(beatPosition);
         currentEdit_->getTransport().setPosition(timePosition);
+        if (audioBridge_) {
+            audioBridge_->syncTransportPosition(timePosition.inSeconds());
+        }
     }
 }
 
@@ -5,6 +5,7 @@
 #include <functional>
 
 #include "../command.hpp"
+#include "../command_table.hpp"
 #include "../interfaces/clip_interface.hpp"
 #include "../interfaces/mixer_interface.hpp"
 #include "../interfaces/track_interface.hpp"
@@ -46,6 +47,19 @@ class TracktionEngineWrapper : public AudioEngine,
     // Process commands from MCP agents
     CommandResponse processCommand(const Command& command);
 
+    /**
+     * @brief Run a JSON array of commands as one edit
+     *
+     * The whole batch is validated first; nothing runs if any command is unknown or
+     * malformed. Model listeners hear about the batch once and the playback graph is
+     * rebuilt once, at the end. The response reports each command's result and time.
+     */
+    CommandResponse processCommandBatch(const juce::var& commands);
+
+    const CommandTable& getCommandTable() const {
+        return commandTable_;
+    }
+
     // TransportInterface implementation
     void play() override;
     void stop() override;
@@ -345,6 +359,10 @@ class TracktionEngineWrapper : public AudioEngine,
     // Device change tracking
     int lastKnownDeviceCount_ = 0;
 
+    // Command dispatch (see registerCommands())
+    CommandTable commandTable_;
+    void registerCommands();
+
     // Helper methods
     tracktion::Track* findTrackById(const std::string& track_id) const;
     tracktion::Clip* findClipById(const std::string& clip_id) const;
@@ -33,6 +33,7 @@ static void log(const std::string& msg) {
 
 namespace ScannerIPC {
 constexpr const char* MSG_SCAN_FORMAT = "SCAN";
+constexpr const char* MSG_SCAN_FILE = "SCNF";
 constexpr const char* MSG_PROGRESS = "PROG";
 constexpr const char* MSG_PLUGIN_FOUND = "PLUG";
 constexpr const char* MSG_SCAN_COMPLETE = "DONE";
@@ -90,6 +91,11 @@ class PluginScannerWorker : public juce::ChildProcessWorker {
                 scanFormat(formatName, searchPathStr, blacklist);
 
                 log("[Scanner] scanFormat returned, waiting for next message...");
+            } else if (msgType == ScannerIPC::MSG_SCAN_FILE) {
+                juce::String formatName = stream.readString();
+                juce::String fileOrIdentifier = stream.readString();
+
+                scanFile(formatName, fileOrIdentifier);
             }
         } catch (const std::exception& e) {
             log(std::string("[Scanner] EXCEPTION: ") + e.what());
@@ -227,6 +233,57 @@ class PluginScannerWorker : public juce::ChildProcessWorker {
         }
     }
 
+    juce::AudioPluginFormat* findFormat(const juce::String& formatName) {
+        for (int i = 0; i < formatManager_.getNumFormats(); ++i) {
+            auto* fmt = formatManager_.getFormat(i);
+            if (fmt && fmt->getName() == formatName) {
+                return fmt;
+            }
+        }
+        return nullptr;
+    }
+
+    // Scan a single file handed out by the coordinator's work queue. The coordinator
+    // already knows which file this worker is on, so a crash here identifies the plugin.
+    void scanFile(const juce::String& formatName, const juce::String& fileOrIdentifier) {
+        try {
+            auto* format = findFormat(formatName);
+            if (!format) {
+                // Not the plugin's fault: an error without a file tells the coordinator
+                // the file was never scanned, so it neither blacklists nor caches it
+                log("[Scanner] Format not found: " + formatName.toStdString());
+                sendError("", "Format not found: " + formatName);
+                sendComplete();
+                return;
+            }
+
+            sendCurrentFile(fileOrIdentifier);
+            log("[Scanner] Scanning: " + fileOrIdentifier.toStdString());
+
+            juce::OwnedArray<juce::PluginDescription> types;
+            format->findAllTypesForFile(types, fileOrIdentifier);
+
+            for (auto* desc : types) {
+                sendPluginFound(*desc);
+            }
+
+            if (types.isEmpty()) {
+                log("[Scanner] Failed: " + fileOrIdentifier.toStdString());
+                sendError(fileOrIdentifier, "Failed to scan");
+            }
+
+            sendComplete();
+        } catch (const std::exception& e) {
+            log(std::string("[Scanner] scanFile EXCEPTION: ") + e.what());
+            sendError(fileOrIdentifier, juce::String("Exception: ") + e.what());
+            sendComplete();
+        } catch (...) {
+            log("[Scanner] scanFile UNKNOWN EXCEPTION");
+            sendError(fileOrIdentifier, "Unknown exception");
+            sendComplete();
+        }
+    }
+
     void sendProgress(float progress) {
         juce::MemoryBlock msg;
         juce::MemoryOutputStream stream(msg, false);
@@ -7,12 +7,15 @@
 #include <memory>
 
 #include "audio/AudioThumbnailManager.hpp"
+#include "audio/WaveformTileCache.hpp"
 #include "core/ClipManager.hpp"
 #include "core/ModulatorEngine.hpp"
 #include "core/TrackManager.hpp"
+#include "engine/RemoteControl.hpp"
 #include "engine/TracktionEngineWrapper.hpp"
 #include "ui/themes/DarkTheme.hpp"
 #include "ui/themes/FontManager.hpp"
+#include "ui/utils/FrameScheduler.hpp"
 #include "ui/windows/MainWindow.hpp"
 
 using namespace juce;
@@ -20,6 +23,7 @@ using namespace juce;
 class MagdaDAWApplication : public JUCEApplication {
   private:
     std::unique_ptr<magda::TracktionEngineWrapper> daw_engine_;
+    std::unique_ptr<magda::RemoteControl> remoteControl_;
     std::unique_ptr<magda::MainWindow> mainWindow_;
     std::unique_ptr<juce::LookAndFeel> lookAndFeel_;
 
@@ -61,6 +65,10 @@ class MagdaDAWApplication : public JUCEApplication {
         // 4. Create main window with full UI (pass the audio engine)
         mainWindow_ = std::make_unique<magda::MainWindow>(daw_engine_.get());
 
+        // 5. Accept commands from external tools on the local control socket
+        remoteControl_ = std::make_unique<magda::RemoteControl>(*daw_engine_);
+        remoteControl_->start();
+
         std::cout << "🎵 MAGDA is ready!" << std::endl;
     }
 
@@ -68,6 +76,11 @@ class MagdaDAWApplication : public JUCEApplication {
         std::cout << "=== SHUTDOWN START ===" << std::endl;
         std::cout.flush();
 
+        // Stop taking external commands before anything they could touch goes away
+        std::cout << "[0] Stopping control socket..." << std::endl;
+        std::cout.flush();
+        remoteControl_.reset();
+
         // Shutdown all singletons BEFORE JUCE cleanup to prevent static cleanup issues
         // This clears all JUCE objects (Strings, Colours, etc.) while JUCE is still alive
         std::cout << "[1] ModulatorEngine shutdown..." << std::endl;
@@ -84,6 +97,7 @@ class MagdaDAWApplication : public JUCEApplication {
 
         std::cout << "[3b] AudioThumbnailManager shutdown..." << std::endl;
         std::cout.flush();
+        magda::WaveformTileCache::getInstance().shutdown();  // Stop tile renders first
         magda::AudioThumbnailManager::getInstance().shutdown();  // Clear thumbnails
 
         // Clear default LookAndFeel BEFORE destroying windows
@@ -97,6 +111,11 @@ class MagdaDAWApplication : public JUCEApplication {
         std::cout.flush();
         mainWindow_.reset();
 
+        // Components are gone; drop the frame driver before JUCE cleanup
+        std::cout << "[5d] FrameScheduler shutdown..." << std::endl;
+        std::cout.flush();
+        magda::FrameScheduler::getInstance().shutdown();
+
         // Now destroy engine
         std::cout << "[6] Destroying DAW engine..." << std::endl;
         std::cout.flush();
@@ -0,0 +1,258 @@
+#include "model_commands.hpp"
+
+#include "core/ClipManager.hpp"
+#include "core/TrackManager.hpp"
+
+namespace magda {
+
+namespace {
+
+using command_params::readBool;
+using command_params::readInt;
+using command_params::readNumber;
+using command_params::readString;
+
+CommandResponse success(const std::string& message) {
+    return CommandResponse(CommandResponse::Status::Success, message);
+}
+
+CommandResponse failure(const std::string& message) {
+    return CommandResponse(CommandResponse::Status::Error, message);
+}
+
+CommandResponse successWithId(const std::string& message, const char* key, int id) {
+    juce::DynamicObject::Ptr obj = new juce::DynamicObject();
+    obj->setProperty(key, id);
+
+    auto response = success(message);
+    response.setData(juce::var(obj.get()));
+    return response;
+}
+
+bool inRange(double value, double min, double max, const char* message, std::string& error) {
+    if (value < min || value > max) {
+        error = message;
+        return false;
+    }
+    return true;
+}
+
+struct CreateTrackParams {
+    std::string name;
+    TrackType type = TrackType::Instrument;
+    bool parse(const Command& c, std::string& error) {
+        std::string typeName = "midi";
+        if (!readString(c, "name", name, error, false) ||
+            !readString(c, "type", typeName, error, false)) {
+            return false;
+        }
+        if (typeName == "midi") {
+            type = TrackType::Instrument;
+        } else if (typeName == "audio") {
+            type = TrackType::Audio;
+        } else {
+            error = "track type must be 'midi' or 'audio'";
+            return false;
+        }
+        return true;
+    }
+};
+
+struct TrackParams {
+    TrackId trackId = INVALID_TRACK_ID;
+    bool parse(const Command& c, std::string& error) {
+        return readInt(c, "trackId", trackId, error);
+    }
+};
+
+struct TrackNameParams {
+    TrackId trackId = INVALID_TRACK_ID;
+    std::string name;
+    bool parse(const Command& c, std::string& error) {
+        return readInt(c, "trackId", trackId, error) && readString(c, "name", name, error);
+    }
+};
+
+struct TrackFlagParams {
+    TrackId trackId = INVALID_TRACK_ID;
+    bool enabled = false;
+    bool parse(const Command& c, std::string& error) {
+        return readInt(c, "trackId", trackId, error) && readBool(c, "enabled", enabled, error);
+    }
+};
+
+struct TrackVolumeParams {
+    TrackId trackId = INVALID_TRACK_ID;
+    double value = 1.0;
+    bool parse(const Command& c, std::string& error) {
+        // Linear gain, up to the +6 dB the mixer allows
+        return readInt(c, "trackId", trackId, error) && readNumber(c, "value", value, error) &&
+               inRange(value, 0.0, 2.0, "volume must be between 0 and 2", error);
+    }
+};
+
+struct TrackPanParams {
+    TrackId trackId = INVALID_TRACK_ID;
+    double value = 0.0;
+    bool parse(const Command& c, std::string& error) {
+        return readInt(c, "trackId", trackId, error) && readNumber(c, "value", value, error) &&
+               inRange(value, -1.0, 1.0, "pan must be between -1 and 1", error);
+    }
+};
+
+struct AddMidiClipParams {
+    TrackId trackId = INVALID_TRACK_ID;
+    double start = 0.0;
+    double length = 0.0;
+    bool parse(const Command& c, std::string& error) {
+        if (!readInt(c, "trackId", trackId, error) || !readNumber(c, "start", start, error) ||
+            !readNumber(c, "length", length, error)) {
+            return false;
+        }
+        if (start < 0.0 || length <= 0.0) {
+            error = "clip needs a start >= 0 and a positive length";
+            return false;
+        }
+        return true;
+    }
+};
+
+struct ClipParams {
+    ClipId clipId = INVALID_CLIP_ID;
+    bool parse(const Command& c, std::string& error) {
+        return readInt(c, "clipId", clipId, error);
+    }
+};
+
+struct MoveClipParams {
+    ClipId clipId = INVALID_CLIP_ID;
+    double start = 0.0;
+    bool parse(const Command& c, std::string& error) {
+        if (!readInt(c, "clipId", clipId, error) || !readNumber(c, "value", start, error)) {
+            return false;
+        }
+        if (start < 0.0) {
+            error = "clip start must be >= 0";
+            return false;
+        }
+        return true;
+    }
+};
+
+struct ResizeClipParams {
+    ClipId clipId = INVALID_CLIP_ID;
+    double length = 0.0;
+    bool parse(const Command& c, std::string& error) {
+        if (!readInt(c, "clipId", clipId, error) || !readNumber(c, "value", length, error)) {
+            return false;
+        }
+        if (length <= 0.0) {
+            error = "clip length must be positive";
+            return false;
+        }
+        return true;
+    }
+};
+
+CommandResponse noTrack(TrackId trackId) {
+    return failure("No track " + std::to_string(trackId));
+}
+
+CommandResponse noClip(ClipId clipId) {
+    return failure("No clip " + std::to_string(clipId));
+}
+
+}  // namespace
+
+void registerModelCommands(CommandTable& table) {
+    // Tracks
+    table.add<CreateTrackParams>("createTrack", [](const CreateTrackParams& p) {
+        auto trackId = TrackManager::getInstance().createTrack(p.name, p.type);
+        return successWithId("Track created", "trackId", trackId);
+    });
+    table.add<TrackParams>("deleteTrack", [](const TrackParams& p) {
+        auto& tm = TrackManager::getInstance();
+        if (!tm.getTrack(p.trackId)) {
+            return noTrack(p.trackId);
+        }
+        tm.deleteTrack(p.trackId);
+        return success("Track deleted");
+    });
+    table.add<TrackNameParams>("setTrackName", [](const TrackNameParams& p) {
+        auto& tm = TrackManager::getInstance();
+        if (!tm.getTrack(p.trackId)) {
+            return noTrack(p.trackId);
+        }
+        tm.setTrackName(p.trackId, p.name);
+        return success("Track renamed");
+    });
+
+    // Mixer
+    table.add<TrackFlagParams>("setTrackMute", [](const TrackFlagParams& p) {
+        auto& tm = TrackManager::getInstance();
+        if (!tm.getTrack(p.trackId)) {
+            return noTrack(p.trackId);
+        }
+        tm.setTrackMuted(p.trackId, p.enabled);
+        return success(p.enabled ? "Track muted" : "Track unmuted");
+    });
+    table.add<TrackFlagParams>("setTrackSolo", [](const TrackFlagParams& p) {
+        auto& tm = TrackManager::getInstance();
+        if (!tm.getTrack(p.trackId)) {
+            return noTrack(p.trackId);
+        }
+        tm.setTrackSoloed(p.trackId, p.enabled);
+        return success(p.enabled ? "Track soloed" : "Track unsoloed");
+    });
+    table.add<TrackVolumeParams>("setTrackVolume", [](const TrackVolumeParams& p) {
+        auto& tm = TrackManager::getInstance();
+        if (!tm.getTrack(p.trackId)) {
+            return noTrack(p.trackId);
+        }
+        tm.setTrackVolume(p.trackId, static_cast<float>(p.value));
+        return success("Track volume set");
+    });
+    table.add<TrackPanParams>("setTrackPan", [](const TrackPanParams& p) {
+        auto& tm = TrackManager::getInstance();
+        if (!tm.getTrack(p.trackId)) {
+            return noTrack(p.trackId);
+        }
+        tm.setTrackPan(p.trackId, static_cast<float>(p.value));
+        return success("Track pan set");
+    });
+
+    // Clips
+    table.add<AddMidiClipParams>("addMidiClip", [](const AddMidiClipParams& p) {
+        if (!TrackManager::getInstance().getTrack(p.trackId)) {
+            return noTrack(p.trackId);
+        }
+        auto clipId = ClipManager::getInstance().createMidiClip(p.trackId, p.start, p.length);
+        return successWithId("Clip created", "clipId", clipId);
+    });
+    table.add<ClipParams>("deleteClip", [](const ClipParams& p) {
+        auto& cm = ClipManager::getInstance();
+        if (!cm.getClip(p.clipId)) {
+            return noClip(p.clipId);
+        }
+        cm.deleteClip(p.clipId);
+        return success("Clip deleted");
+    });
+    table.add<MoveClipParams>("moveClip", [](const MoveClipParams& p) {
+        auto& cm = ClipManager::getInstance();
+        if (!cm.getClip(p.clipId)) {
+            return noClip(p.clipId);
+        }
+        cm.moveClip(p.clipId, p.start);
+        return success("Clip moved");
+    });
+    table.add<ResizeClipParams>("resizeClip", [](const ResizeClipParams& p) {
+        auto& cm = ClipManager::getInstance();
+        if (!cm.getClip(p.clipId)) {
+            return noClip(p.clipId);
+        }
+        cm.resizeClip(p.clipId, p.length);
+        return success("Clip resized");
+    });
+}
+
+}  // namespace magda
@@ -0,0 +1,20 @@
+#pragma once
+
+#include "command_table.hpp"
+
+namespace magda {
+
+/**
+ * @brief Register the track, mixer and clip commands on a command table
+ *
+ * These commands edit the model through TrackManager and ClipManager and address tracks
+ * and clips by their model ids (integers), the same ids model change events report, so
+ * a client can act on whatever it was told about. The audio engine follows the model as
+ * it does for edits made in the UI.
+ *
+ * Every handler fails for an id the model doesn't hold, and out-of-range values are
+ * rejected while parsing, so a batch containing one is refused before anything runs.
+ */
+void registerModelCommands(CommandTable& table);
+
+}  // namespace magda
@@ -156,6 +156,26 @@ class PerformanceMonitor {
         stats_[category].addSample(milliseconds);
     }
 
+    /**
+     * @brief Record the current value of a non-timing quantity (e.g. memory in bytes)
+     */
+    void setGauge(const juce::String& name, double value) {
+        if (!enabled_)
+            return;
+
+        const juce::ScopedLock lock(statsLock_);
+        gauges_[name] = value;
+    }
+
+    /**
+     * @brief Last value recorded for a gauge (0 if never set)
+     */
+    double getGauge(const juce::String& name) const {
+        const juce::ScopedLock lock(statsLock_);
+        auto it = gauges_.find(name);
+        return it != gauges_.end() ? it->second : 0.0;
+    }
+
     /**
      * @brief Get statistics for a category
      */
@@ -187,6 +207,7 @@ class PerformanceMonitor {
     void resetAll() {
         const juce::ScopedLock lock(statsLock_);
         stats_.clear();
+        gauges_.clear();
     }
 
     /**
@@ -196,6 +217,7 @@ class PerformanceMonitor {
     void shutdown() {
         const juce::ScopedLock lock(statsLock_);
         stats_.clear();
+        gauges_.clear();
         enabled_ = false;
     }
 
@@ -211,6 +233,10 @@ class PerformanceMonitor {
             report << category << ": " << stats.toString() << "\n";
         }
 
+        for (const auto& [name, value] : gauges_) {
+            report << name << ": " << juce::String(value, 1) << "\n";
+        }
+
         return report;
     }
 
@@ -219,6 +245,7 @@ class PerformanceMonitor {
 
     mutable juce::CriticalSection statsLock_;
     std::unordered_map<juce::String, PerformanceStats> stats_;
+    std::unordered_map<juce::String, double> gauges_;
     bool enabled_ = false;  // Profiling disabled by default, enable with setEnabled(true)
 };
 
@@ -148,12 +148,12 @@ void AutomationCurveEditor::updatePointsCache() const {
     if (clipId_ != INVALID_AUTOMATION_CLIP_ID) {
         const auto* clip = AutomationManager::getInstance().getClip(clipId_);
         if (clip) {
-            sourcePoints = &clip->points;
+            sourcePoints = &clip->points.items();
         }
     } else {
         const auto* lane = AutomationManager::getInstance().getLane(laneId_);
         if (lane && lane->isAbsolute()) {
-            sourcePoints = &lane->absolutePoints;
+            sourcePoints = &lane->absolutePoints.items();
         }
     }
 
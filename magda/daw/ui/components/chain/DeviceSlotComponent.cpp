@@ -556,6 +556,11 @@ void DeviceSlotComponent::paintContent(juce::Graphics& g, juce::Rectangle<int> c
     g.setColour(textColour);
     g.setFont(FontManager::getInstance().getUIFont(9.0f));
     juce::String headerText = device_.manufacturer + " / " + device_.name;
+    if (device_.loadState == DeviceLoadState::Loading) {
+        headerText += " (loading...)";
+    } else if (device_.loadState == DeviceLoadState::Failed) {
+        headerText += " (failed to load)";
+    }
     g.drawText(headerText, headerArea.reduced(2, 0), juce::Justification::centredLeft);
 }
 
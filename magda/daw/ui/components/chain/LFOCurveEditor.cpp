@@ -13,11 +13,10 @@ LFOCurveEditor::LFOCurveEditor() {
     setPadding(4);
 
     rebuildPointComponents();
-    startTimer(33);  // 30 FPS animation for phase indicator
 }
 
 LFOCurveEditor::~LFOCurveEditor() {
-    stopTimer();
+    stopAnimating();
 }
 
 void LFOCurveEditor::syncFromModInfo() {
@@ -100,6 +99,7 @@ void LFOCurveEditor::setModInfo(ModInfo* mod) {
     }
 
     rebuildPointComponents();
+    updateAnimation();
     repaint();
 }
 
@@ -272,6 +272,7 @@ void LFOCurveEditor::onPointDragPreview(uint32_t pointId, double newX, double ne
         if (points_[i].id == pointId) {
             modInfo_->curvePoints[i].phase = static_cast<float>(newX);
             modInfo_->curvePoints[i].value = static_cast<float>(newY);
+            modInfo_->markCurveChanged();
             found = true;
             break;
         }
@@ -292,6 +293,7 @@ void LFOCurveEditor::onTensionDragPreview(uint32_t pointId, double tension) {
     for (size_t i = 0; i < points_.size(); ++i) {
         if (points_[i].id == pointId && i < modInfo_->curvePoints.size()) {
             modInfo_->curvePoints[i].tension = static_cast<float>(tension);
+            modInfo_->markCurveChanged();
             break;
         }
     }
@@ -310,7 +312,17 @@ bool LFOCurveEditor::keyPressed(const juce::KeyPress& key) {
     return CurveEditorBase::keyPressed(key);
 }
 
-void LFOCurveEditor::timerCallback() {
+void LFOCurveEditor::visibilityChanged() {
+    updateAnimation();
+}
+
+void LFOCurveEditor::updateAnimation() {
+    // The phase indicator moves only while the mod runs and the editor is on screen
+    setAnimating(modInfo_ != nullptr && modInfo_->isRunning() && isShowing());
+}
+
+void LFOCurveEditor::frameTick() {
+    updateAnimation();
     if (!modInfo_)
         return;
 
@@ -340,6 +352,9 @@ juce::Rectangle<int> LFOCurveEditor::getIndicatorBounds() const {
 }
 
 void LFOCurveEditor::paint(juce::Graphics& g) {
+    // Shown again after an ancestor was hidden: resume the phase indicator
+    updateAnimation();
+
     // Let base class paint background, grid, curve
     CurveEditorBase::paint(g);
 
@@ -463,6 +478,7 @@ void LFOCurveEditor::notifyWaveformChanged() {
             cpd.tension = static_cast<float>(p.tension);
             modInfo_->curvePoints.push_back(cpd);
         }
+        modInfo_->markCurveChanged();
     }
 
     if (onWaveformChanged) {
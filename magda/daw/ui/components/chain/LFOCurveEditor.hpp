@@ -8,6 +8,7 @@
 
 #include "core/ModInfo.hpp"
 #include "ui/components/common/curve/CurveEditorBase.hpp"
+#include "ui/utils/FrameScheduler.hpp"
 
 namespace magda {
 
@@ -22,7 +23,7 @@ namespace magda {
  *
  * Used in the modulator editor panel for custom LFO shapes.
  */
-class LFOCurveEditor : public CurveEditorBase, private juce::Timer {
+class LFOCurveEditor : public CurveEditorBase, private FrameClient {
   public:
     LFOCurveEditor();
     ~LFOCurveEditor() override;
@@ -126,12 +127,14 @@ class LFOCurveEditor : public CurveEditorBase, private juce::Timer {
 
     void paintGrid(juce::Graphics& g) override;
     void paint(juce::Graphics& g) override;
+    void visibilityChanged() override;
 
     // Handle C key for crosshair toggle
     bool keyPressed(const juce::KeyPress& key) override;
 
   private:
-    void timerCallback() override;
+    void frameTick() override;
+    void updateAnimation();
     void paintPhaseIndicator(juce::Graphics& g);
     juce::Rectangle<int> getIndicatorBounds() const;
 
@@ -7,15 +7,24 @@ namespace magda {
 LFOPhaseOverlay::LFOPhaseOverlay() {
     setInterceptsMouseClicks(false, false);  // Click-through to editor components
     setOpaque(true);                         // Opaque to prevent flickering
-    startTimer(33);                          // 30 FPS animation
 }
 
 LFOPhaseOverlay::~LFOPhaseOverlay() {
-    stopTimer();
+    stopAnimating();
 }
 
-void LFOPhaseOverlay::timerCallback() {
-    repaint();
+void LFOPhaseOverlay::frameTick() {
+    FrameScheduler::getInstance().requestRepaint(*this);
+    updateAnimation();
+}
+
+void LFOPhaseOverlay::visibilityChanged() {
+    updateAnimation();
+}
+
+void LFOPhaseOverlay::updateAnimation() {
+    // 30 FPS while the indicator moves; a stopped mod needs no frames
+    setAnimating(modInfo_ != nullptr && modInfo_->isRunning() && isShowing());
 }
 
 bool LFOPhaseOverlay::hitTest(int /*x*/, int /*y*/) {
@@ -23,6 +32,9 @@ bool LFOPhaseOverlay::hitTest(int /*x*/, int /*y*/) {
 }
 
 void LFOPhaseOverlay::paint(juce::Graphics& g) {
+    // A repaint after being hidden with an ancestor restarts the indicator
+    updateAnimation();
+
     // Background (opaque)
     g.fillAll(juce::Colour(0xFF1A1A1A));
 
@@ -3,6 +3,7 @@
 #include <juce_gui_basics/juce_gui_basics.h>
 
 #include "core/ModInfo.hpp"
+#include "ui/utils/FrameScheduler.hpp"
 
 namespace magda {
 
@@ -17,13 +18,14 @@ namespace magda {
  * Being opaque prevents flickering from transparent overlay repaints.
  * Click-through allows interaction with editor components on top.
  */
-class LFOPhaseOverlay : public juce::Component, private juce::Timer {
+class LFOPhaseOverlay : public juce::Component, private FrameClient {
   public:
     LFOPhaseOverlay();
     ~LFOPhaseOverlay() override;
 
     void setModInfo(const ModInfo* mod) {
         modInfo_ = mod;
+        updateAnimation();
     }
 
     void setCurveColour(juce::Colour colour) {
@@ -39,9 +41,11 @@ class LFOPhaseOverlay : public juce::Component, private juce::Timer {
 
     void paint(juce::Graphics& g) override;
     bool hitTest(int x, int y) override;
+    void visibilityChanged() override;
 
   private:
-    void timerCallback() override;
+    void frameTick() override;
+    void updateAnimation();
 
     void paintGrid(juce::Graphics& g);
     void paintCurve(juce::Graphics& g);
@@ -10,30 +10,34 @@
 #include "core/SelectionManager.hpp"
 #include "ui/components/common/SvgButton.hpp"
 #include "ui/components/common/TextSlider.hpp"
+#include "ui/utils/FrameScheduler.hpp"
 
 namespace magda::daw::ui {
 
 /**
  * @brief Mini waveform display for mod knob
  */
-class MiniWaveformDisplay : public juce::Component, private juce::Timer {
+class MiniWaveformDisplay : public juce::Component, private magda::FrameClient {
   public:
-    MiniWaveformDisplay() {
-        startTimer(33);  // 30 FPS animation
-    }
-
-    ~MiniWaveformDisplay() {
-        stopTimer();
+    ~MiniWaveformDisplay() override {
+        stopAnimating();
     }
 
     void setModInfo(const magda::ModInfo* mod) {
         mod_ = mod;
         DBG("MiniWaveformDisplay::setModInfo - mod_ ptr: " +
             juce::String::toHexString((juce::int64)mod_));
+        updateAnimation();
         repaint();
     }
 
+    void visibilityChanged() override {
+        updateAnimation();
+    }
+
     void paint(juce::Graphics& g) override {
+        // Painting again after an ancestor was hidden is the cue to pick the dot back up
+        updateAnimation();
         if (!mod_) {
             return;
         }
@@ -52,10 +56,12 @@ class MiniWaveformDisplay : public juce::Component, private juce::Timer {
         // Draw waveform path
         juce::Path waveformPath;
         const int numPoints = 50;  // Fewer points for mini display
+        const auto& waveTable = magda::ModulatorEngine::getWaveTable(*mod_);
 
         for (int i = 0; i < numPoints; ++i) {
             float phase = static_cast<float>(i) / static_cast<float>(numPoints - 1);
-            float value = magda::ModulatorEngine::generateWaveformForMod(*mod_, phase);
+            // Inclusive: the last point is the end of the cycle, not a wrap back to its start
+            float value = waveTable.lookupInclusive(phase);
 
             // Invert value so high values are at top
             float y = centerY + (0.5f - value) * (height - 2.0f);
@@ -82,8 +88,15 @@ class MiniWaveformDisplay : public juce::Component, private juce::Timer {
     }
 
   private:
-    void timerCallback() override {
-        repaint();
+    void frameTick() override {
+        // One last repaint after the mod stops leaves the dot where it settled
+        magda::FrameScheduler::getInstance().requestRepaint(*this);
+        updateAnimation();
+    }
+
+    // The phase dot only moves while the mod runs, and only matters while on screen
+    void updateAnimation() {
+        setAnimating(mod_ != nullptr && mod_->isRunning() && isShowing());
     }
 
     const magda::ModInfo* mod_ = nullptr;
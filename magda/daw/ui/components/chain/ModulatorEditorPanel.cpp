@@ -12,8 +12,6 @@ ModulatorEditorPanel::ModulatorEditorPanel() {
     // Intercept mouse clicks to prevent propagation to parent
     setInterceptsMouseClicks(true, true);
 
-    startTimer(33);  // 30 FPS for waveform animation
-
     // Name label at top
     nameLabel_.setFont(FontManager::getInstance().getUIFontBold(10.0f));
     nameLabel_.setColour(juce::Label::textColourId, DarkTheme::getTextColour());
@@ -296,7 +294,7 @@ ModulatorEditorPanel::ModulatorEditorPanel() {
 }
 
 ModulatorEditorPanel::~ModulatorEditorPanel() {
-    stopTimer();
+    stopAnimating();
 }
 
 void ModulatorEditorPanel::setModInfo(const magda::ModInfo& mod, const magda::ModInfo* liveMod) {
@@ -305,6 +303,7 @@ void ModulatorEditorPanel::setModInfo(const magda::ModInfo& mod, const magda::Mo
     // Use live mod pointer if available (for animation), otherwise use local copy
     waveformDisplay_.setModInfo(liveMod ? liveMod : &currentMod_);
     updateFromMod();
+    updateAnimation();
 }
 
 void ModulatorEditorPanel::setSelectedModIndex(int index) {
@@ -420,6 +419,9 @@ void ModulatorEditorPanel::paint(juce::Graphics& g) {
 
     // Use live mod pointer for real-time trigger state
     const magda::ModInfo* mod = liveModPtr_ ? liveModPtr_ : &currentMod_;
+    triggerDotArea_ = dotBounds.getSmallestIntegerContainer().expanded(1);
+    paintedTriggered_ = mod->triggered;
+    updateAnimation();
     if (mod->triggered) {
         g.setColour(DarkTheme::getColour(DarkTheme::ACCENT_ORANGE));
         g.fillEllipse(dotBounds);
@@ -506,9 +508,21 @@ void ModulatorEditorPanel::mouseUp(const juce::MouseEvent& /*e*/) {
     // Consume mouse events to prevent propagation to parent
 }
 
-void ModulatorEditorPanel::timerCallback() {
-    // Repaint for trigger indicator animation
-    repaint();
+void ModulatorEditorPanel::visibilityChanged() {
+    updateAnimation();
+}
+
+void ModulatorEditorPanel::frameTick() {
+    // Repaint just the trigger dot, and only when it changes
+    if (liveModPtr_ != nullptr && liveModPtr_->triggered != paintedTriggered_) {
+        repaint(triggerDotArea_);
+    }
+    updateAnimation();
+}
+
+void ModulatorEditorPanel::updateAnimation() {
+    // Only the live mod can trigger; a copy never changes
+    setAnimating(liveModPtr_ != nullptr && liveModPtr_->isRunning() && isShowing());
 }
 
 }  // namespace magda::daw::ui
@@ -11,28 +11,32 @@
 #include "ui/components/chain/LFOCurveEditorWindow.hpp"
 #include "ui/components/common/SvgButton.hpp"
 #include "ui/components/common/TextSlider.hpp"
+#include "ui/utils/FrameScheduler.hpp"
 
 namespace magda::daw::ui {
 
 /**
  * @brief Animated waveform display component
  */
-class WaveformDisplay : public juce::Component, private juce::Timer {
+class WaveformDisplay : public juce::Component, private magda::FrameClient {
   public:
-    WaveformDisplay() {
-        startTimer(33);  // 30 FPS animation
-    }
-
     ~WaveformDisplay() override {
-        stopTimer();
+        stopAnimating();
     }
 
     void setModInfo(const magda::ModInfo* mod) {
         mod_ = mod;
+        updateAnimation();
         repaint();
     }
 
+    void visibilityChanged() override {
+        updateAnimation();
+    }
+
     void paint(juce::Graphics& g) override {
+        // Also restarts the animation when the panel is shown again
+        updateAnimation();
         if (!mod_) {
             return;
         }
@@ -105,8 +109,13 @@ class WaveformDisplay : public juce::Component, private juce::Timer {
     }
 
   private:
-    void timerCallback() override {
-        repaint();
+    void frameTick() override {
+        magda::FrameScheduler::getInstance().requestRepaint(*this);
+        updateAnimation();
+    }
+
+    void updateAnimation() {
+        setAnimating(mod_ != nullptr && mod_->isRunning() && isShowing());
     }
 
     const magda::ModInfo* mod_ = nullptr;
@@ -130,7 +139,7 @@ class WaveformDisplay : public juce::Component, private juce::Timer {
  * |   Param Name     |
  * +------------------+
  */
-class ModulatorEditorPanel : public juce::Component, private juce::Timer {
+class ModulatorEditorPanel : public juce::Component, private magda::FrameClient {
   public:
     ModulatorEditorPanel();
     ~ModulatorEditorPanel() override;
@@ -154,6 +163,7 @@ class ModulatorEditorPanel : public juce::Component, private juce::Timer {
 
     void paint(juce::Graphics& g) override;
     void resized() override;
+    void visibilityChanged() override;
     void mouseDown(const juce::MouseEvent& e) override;
     void mouseUp(const juce::MouseEvent& e) override;
 
@@ -181,8 +191,13 @@ class ModulatorEditorPanel : public juce::Component, private juce::Timer {
     juce::ComboBox triggerModeCombo_;
     std::unique_ptr<magda::SvgButton> advancedButton_;
 
+    // Trigger monitor dot: the only part of the panel that animates
+    juce::Rectangle<int> triggerDotArea_;
+    bool paintedTriggered_ = false;
+
     void updateFromMod();
-    void timerCallback() override;
+    void frameTick() override;
+    void updateAnimation();
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ModulatorEditorPanel)
 };
@@ -135,8 +135,8 @@ ParamSlotComponent::ParamSlotComponent(int paramIndex) : paramIndex_(paramIndex)
 }
 
 ParamSlotComponent::~ParamSlotComponent() {
-    // Stop modulation animation timer
-    stopTimer();
+    // Stop modulation animation
+    stopAnimating();
 
     // Clean up tooltip if it's on desktop
     if (amountLabel_.isOnDesktop()) {
@@ -1427,9 +1427,9 @@ bool ParamSlotComponent::isInScopeOf(const magda::ChainNodePath& parentPath) con
     return false;
 }
 
-void ParamSlotComponent::timerCallback() {
+void ParamSlotComponent::frameTick() {
     // Repaint to update animated LFO modulation bars
-    repaint();
+    magda::FrameScheduler::getInstance().requestRepaint(*this);
 }
 
 bool ParamSlotComponent::hasActiveModLinks() const {
@@ -1481,13 +1481,13 @@ bool ParamSlotComponent::hasActiveModLinks() const {
 
 void ParamSlotComponent::updateModTimerState() {
     if (hasActiveModLinks()) {
-        // Start timer at 30 FPS to animate modulation bars
-        if (!isTimerRunning()) {
-            startTimer(33);  // ~30 FPS
+        // Animate modulation bars at 30 FPS
+        if (!isAnimating()) {
+            startAnimating(30);
         }
     } else {
-        // No active links, stop the timer to save CPU
-        stopTimer();
+        // No active links, stop animating to save CPU
+        stopAnimating();
     }
 }
 
@@ -9,6 +9,7 @@
 #include "core/SelectionManager.hpp"
 #include "core/TypeIds.hpp"
 #include "ui/components/common/TextSlider.hpp"
+#include "ui/utils/FrameScheduler.hpp"
 
 namespace magda::daw::ui {
 
@@ -24,7 +25,7 @@ namespace magda::daw::ui {
 class ParamSlotComponent : public juce::Component,
                            public juce::DragAndDropTarget,
                            public magda::LinkModeManagerListener,
-                           private juce::Timer {
+                           private magda::FrameClient {
   public:
     ParamSlotComponent(int paramIndex);
     ~ParamSlotComponent() override;
@@ -128,13 +129,13 @@ class ParamSlotComponent : public juce::Component,
     void modLinkModeChanged(bool active, const magda::ModSelection& selection) override;
     void macroLinkModeChanged(bool active, const magda::MacroSelection& selection) override;
 
-    // Timer callback for animating LFO modulation bars
-    void timerCallback() override;
+    // Frame callback for animating LFO modulation bars
+    void frameTick() override;
 
     // Check if this param has any active mod links
     bool hasActiveModLinks() const;
 
-    // Update timer state based on whether there are active mod links
+    // Start/stop animating based on whether there are active mod links
     void updateModTimerState();
 
     int paramIndex_;
@@ -3,7 +3,7 @@
 #include "../../themes/DarkTheme.hpp"
 #include "../../themes/FontManager.hpp"
 #include "../tracks/TrackContentPanel.hpp"
-#include "audio/AudioThumbnailManager.hpp"
+#include "audio/WaveformTileCache.hpp"
 #include "core/SelectionManager.hpp"
 
 namespace magda {
@@ -14,6 +14,7 @@ ClipComponent::ClipComponent(ClipId clipId, TrackContentPanel* parent)
 
     // Register as ClipManager listener
     ClipManager::getInstance().addListener(this);
+    WaveformTileCache::getInstance().addChangeListener(this);
 
     // Check if this clip is currently selected
     isSelected_ = ClipManager::getInstance().getSelectedClip() == clipId_;
@@ -21,6 +22,7 @@ ClipComponent::ClipComponent(ClipId clipId, TrackContentPanel* parent)
 
 ClipComponent::~ClipComponent() {
     ClipManager::getInstance().removeListener(this);
+    WaveformTileCache::getInstance().removeChangeListener(this);
 }
 
 void ClipComponent::paint(juce::Graphics& g) {
@@ -71,7 +73,7 @@ void ClipComponent::paintAudioClip(juce::Graphics& g, const ClipInfo& clip,
 
     if (!clip.audioSources.empty() && clip.audioSources[0].filePath.isNotEmpty()) {
         const auto& source = clip.audioSources[0];
-        auto& thumbnailManager = AudioThumbnailManager::getInstance();
+        auto& tileCache = WaveformTileCache::getInstance();
 
         // Calculate visible region and file times directly in time domain
         // to avoid integer rounding errors from pixel→time→pixel conversions.
@@ -119,8 +121,8 @@ void ClipComponent::paintAudioClip(juce::Graphics& g, const ClipInfo& clip,
                 double fileEnd =
                     source.offset + (visibleEnd - adjustedSourcePosition) / source.stretchFactor;
 
-                thumbnailManager.drawWaveform(g, drawRect, source.filePath, fileStart, fileEnd,
-                                              clip.colour.brighter(0.2f));
+                tileCache.drawWaveform(g, drawRect, source.filePath, fileStart, fileEnd,
+                                       clip.colour.brighter(0.2f));
             }
         }
     } else {
@@ -395,6 +397,10 @@ void ClipComponent::mouseDrag(const juce::MouseEvent& e) {
         return;
     }
 
+    if (!gesture_) {
+        gesture_ = std::make_unique<GestureScope>();
+    }
+
     // Check if this is a multi-clip drag
     auto& selectionManager = SelectionManager::getInstance();
     bool isMultiDrag = dragMode_ == DragMode::Move && selectionManager.getSelectedClipCount() > 1 &&
@@ -630,6 +636,9 @@ void ClipComponent::mouseDrag(const juce::MouseEvent& e) {
 }
 
 void ClipComponent::mouseUp(const juce::MouseEvent& e) {
+    // Ends the gesture once everything below has been committed
+    auto gesture = std::move(gesture_);
+
     // Check if we were doing a multi-clip drag
     auto& selectionManager = SelectionManager::getInstance();
     if (isDragging_ && parentPanel_ && selectionManager.getSelectedClipCount() > 1 &&
@@ -887,6 +896,14 @@ void ClipComponent::clipSelectionChanged(ClipId clipId) {
     }
 }
 
+void ClipComponent::changeListenerCallback(juce::ChangeBroadcaster* /*source*/) {
+    // Waveform tiles or peaks became ready; only audio clips draw them
+    const auto* clip = getClipInfo();
+    if (clip && clip->type == ClipType::Audio) {
+        repaint();
+    }
+}
+
 // ============================================================================
 // Selection
 // ============================================================================
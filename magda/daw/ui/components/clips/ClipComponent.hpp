@@ -5,6 +5,7 @@
 #include "core/ClipInfo.hpp"
 #include "core/ClipManager.hpp"
 #include "core/ClipTypes.hpp"
+#include "core/UndoManager.hpp"
 #include "utils/DragThrottle.hpp"
 
 namespace magda {
@@ -21,7 +22,9 @@ class TrackContentPanel;
  * - Resize handles (left/right edges)
  * - Selection
  */
-class ClipComponent : public juce::Component, public ClipManagerListener {
+class ClipComponent : public juce::Component,
+                      public ClipManagerListener,
+                      public juce::ChangeListener {
   public:
     explicit ClipComponent(ClipId clipId, TrackContentPanel* parent);
     ~ClipComponent() override;
@@ -48,6 +51,9 @@ class ClipComponent : public juce::Component, public ClipManagerListener {
     void clipPropertyChanged(ClipId clipId) override;
     void clipSelectionChanged(ClipId clipId) override;
 
+    // ChangeListener (waveform tiles became ready)
+    void changeListenerCallback(juce::ChangeBroadcaster* source) override;
+
     // Selection state
     bool isSelected() const {
         return isSelected_;
@@ -104,6 +110,9 @@ class ClipComponent : public juce::Component, public ClipManagerListener {
     bool isDragging_ = false;
     bool isCommitting_ = false;  // True during mouseUp commit phase
 
+    // What the drag commits on mouseUp becomes one undo step
+    std::unique_ptr<GestureScope> gesture_;
+
     // Stretch state
     double dragStartStretchFactor_ = 1.0;
     DragThrottle stretchThrottle_{50};
@@ -4,6 +4,7 @@
 
 #include "../../themes/DarkTheme.hpp"
 #include "../../themes/FontManager.hpp"
+#include "core/UndoManager.hpp"
 
 namespace magda {
 
@@ -254,6 +255,7 @@ void DraggableValueLabel::mouseDown(const juce::MouseEvent& e) {
     isDragging_ = true;
     dragStartValue_ = value_;
     dragStartY_ = e.y;
+    gesture_ = std::make_unique<GestureScope>();
     repaint();
 }
 
@@ -277,6 +279,7 @@ void DraggableValueLabel::mouseDrag(const juce::MouseEvent& e) {
 
 void DraggableValueLabel::mouseUp(const juce::MouseEvent& /*e*/) {
     isDragging_ = false;
+    gesture_.reset();
     repaint();
 }
 
@@ -3,9 +3,12 @@
 #include <juce_gui_basics/juce_gui_basics.h>
 
 #include <functional>
+#include <memory>
 
 namespace magda {
 
+class GestureScope;
+
 /**
  * A compact label that displays a value and allows:
  * - Mouse drag to adjust the value
@@ -91,6 +94,7 @@ class DraggableValueLabel : public juce::Component {
     bool isDragging_ = false;
     double dragStartValue_ = 0.0;
     int dragStartY_ = 0;
+    std::unique_ptr<GestureScope> gesture_;  // One undo step per drag
 
     // Edit mode
     bool isEditing_ = false;
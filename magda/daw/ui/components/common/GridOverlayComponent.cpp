@@ -90,6 +90,10 @@ void GridOverlayComponent::zoomStateChanged(const TimelineState& state) {
     repaint();
 }
 
+void GridOverlayComponent::playheadStateChanged(const TimelineState& /*state*/) {
+    // Grid lines don't move with the playhead
+}
+
 // ===== Paint =====
 
 void GridOverlayComponent::paint(juce::Graphics& g) {
@@ -63,6 +63,7 @@ class GridOverlayComponent : public juce::Component, public TimelineStateListene
     // TimelineStateListener implementation
     void timelineStateChanged(const TimelineState& state) override;
     void zoomStateChanged(const TimelineState& state) override;
+    void playheadStateChanged(const TimelineState& state) override;
 
   private:
     // Controller reference (not owned)
@@ -1,5 +1,7 @@
 #include "PianoRollGridComponent.hpp"
 
+#include <cmath>
+
 #include "../../state/TimelineController.hpp"
 #include "../../themes/DarkTheme.hpp"
 #include "core/ClipManager.hpp"
@@ -11,9 +13,7 @@ PianoRollGridComponent::PianoRollGridComponent() {
     setWantsKeyboardFocus(true);
 }
 
-PianoRollGridComponent::~PianoRollGridComponent() {
-    clearNoteComponents();
-}
+PianoRollGridComponent::~PianoRollGridComponent() = default;
 
 void PianoRollGridComponent::paint(juce::Graphics& g) {
     auto bounds = getLocalBounds();
@@ -43,26 +43,127 @@ void PianoRollGridComponent::paint(juce::Graphics& g) {
         }
     }
 
+    const auto* clip = static_cast<const ClipManager&>(ClipManager::getInstance()).getClip(clipId_);
+    if (clip && clip->type == ClipType::MIDI) {
+        paintNotes(g, *clip);
+    }
+
     // Draw playhead line if playing
-    if (playheadPosition_ >= 0.0) {
-        // Convert seconds to beats
-        // Get tempo from TimelineController
-        double tempo = 120.0;  // Default
-        if (auto* controller = TimelineController::getCurrent()) {
-            tempo = controller->getState().tempo.bpm;
+    int playheadX = getPlayheadX();
+    if (playheadX >= 0 && playheadX <= bounds.getRight()) {
+        // Draw playhead line (red)
+        g.setColour(juce::Colour(0xFFFF4444));
+        g.fillRect(playheadX - 1, 0, 2, bounds.getHeight());
+    }
+}
+
+int PianoRollGridComponent::getPlayheadX() const {
+    if (playheadPosition_ < 0.0) {
+        return -1;
+    }
+
+    // Convert seconds to beats
+    // Get tempo from TimelineController
+    double tempo = 120.0;  // Default
+    if (auto* controller = TimelineController::getCurrent()) {
+        tempo = controller->getState().tempo.bpm;
+    }
+    double secondsPerBeat = 60.0 / tempo;
+    double playheadBeats = playheadPosition_ / secondsPerBeat;
+
+    // In absolute mode, playhead is at absolute position
+    // In relative mode, need to offset by clip start
+    double displayBeat = relativeMode_ ? (playheadBeats - clipStartBeats_) : playheadBeats;
+    return beatToPixel(displayBeat);
+}
+
+void PianoRollGridComponent::paintNotes(juce::Graphics& g, const ClipInfo& clip) {
+    const auto& notes = clip.midiNotes.items();
+
+    // Only notes intersecting the repainted area are looked up
+    auto visible = g.getClipBounds();
+    double offset = displayOffsetBeats();
+    double minLengthBeats = MIN_NOTE_WIDTH / pixelsPerBeat_;
+    clip.midiNotes.query(pixelToBeat(visible.getX()) - offset,
+                         pixelToBeat(visible.getRight()) - offset,
+                         yToNoteNumber(visible.getBottom()), yToNoteNumber(visible.getY()),
+                         visibleNotes_, minLengthBeats);
+
+    // Unselected notes are batched into a few fills; selected ones are drawn on top
+    juce::Path bodies;
+    juce::Path borders;
+    juce::RectangleList<float> velocityBars;
+    for (auto index : visibleNotes_) {
+        if (index >= notes.size() || isNoteSelected(index) ||
+            (isDragging_ && static_cast<int>(index) == dragNoteIndex_)) {
+            continue;
         }
-        double secondsPerBeat = 60.0 / tempo;
-        double playheadBeats = playheadPosition_ / secondsPerBeat;
-
-        // In absolute mode, playhead is at absolute position
-        // In relative mode, need to offset by clip start
-        double displayBeat = relativeMode_ ? (playheadBeats - clipStartBeats_) : playheadBeats;
-
-        int playheadX = beatToPixel(displayBeat);
-        if (playheadX >= 0 && playheadX <= bounds.getRight()) {
-            // Draw playhead line (red)
-            g.setColour(juce::Colour(0xFFFF4444));
-            g.fillRect(playheadX - 1, 0, 2, bounds.getHeight());
+
+        const auto& note = notes[index];
+        auto bounds = getNoteBounds(note.startBeat, note.noteNumber, note.lengthBeats).toFloat();
+        bodies.addRoundedRectangle(bounds, CORNER_RADIUS);
+        borders.addRoundedRectangle(bounds.reduced(0.5f), CORNER_RADIUS);
+
+        float velocityBarHeight = std::floor((bounds.getHeight() - 4) * (note.velocity / 127.0f));
+        if (velocityBarHeight > 0) {
+            velocityBars.addWithoutMerging({bounds.getX() + 2,
+                                            bounds.getBottom() - velocityBarHeight - 2, 3.0f,
+                                            velocityBarHeight});
+        }
+    }
+
+    g.setColour(clip.colour);
+    g.fillPath(bodies);
+    g.setColour(clip.colour.brighter(0.5f));
+    g.fillRectList(velocityBars);
+    g.setColour(clip.colour.brighter(0.4f));
+    g.strokePath(borders, juce::PathStrokeType(1.0f));
+
+    for (auto index : visibleNotes_) {
+        if (index < notes.size() && isNoteSelected(index) &&
+            !(isDragging_ && static_cast<int>(index) == dragNoteIndex_)) {
+            const auto& note = notes[index];
+            auto hoverEdge = static_cast<int>(index) == hoverNoteIndex_ ? hoverEdge_
+                                                                        : DragMode::None;
+            paintNote(g, getNoteBounds(note.startBeat, note.noteNumber, note.lengthBeats),
+                      note.velocity, clip.colour, true, hoverEdge);
+        }
+    }
+
+    // The dragged note follows the preview wherever it is
+    if (isDragging_ && dragNoteIndex_ >= 0 && static_cast<size_t>(dragNoteIndex_) < notes.size()) {
+        paintNote(g, getNoteBounds(previewStartBeat_, previewNoteNumber_, previewLengthBeats_),
+                  notes[static_cast<size_t>(dragNoteIndex_)].velocity, clip.colour,
+                  isNoteSelected(static_cast<size_t>(dragNoteIndex_)), DragMode::None);
+    }
+}
+
+void PianoRollGridComponent::paintNote(juce::Graphics& g, juce::Rectangle<int> bounds,
+                                       int velocity, juce::Colour colour, bool selected,
+                                       DragMode hoverEdge) const {
+    auto area = bounds.toFloat();
+
+    // Background fill
+    g.setColour(selected ? colour.brighter(0.3f) : colour);
+    g.fillRoundedRectangle(area, CORNER_RADIUS);
+
+    // Velocity indicator on the left side
+    int velocityBarHeight = static_cast<int>((area.getHeight() - 4) * (velocity / 127.0f));
+    g.setColour(colour.brighter(0.5f));
+    g.fillRect(bounds.getX() + 2, bounds.getBottom() - velocityBarHeight - 2, 3,
+               velocityBarHeight);
+
+    // Border
+    g.setColour(selected ? juce::Colours::white : colour.brighter(0.4f));
+    g.drawRoundedRectangle(area.reduced(0.5f), CORNER_RADIUS, selected ? 2.0f : 1.0f);
+
+    // Resize handle highlights
+    if (selected && hoverEdge != DragMode::None) {
+        g.setColour(juce::Colours::white.withAlpha(0.4f));
+        if (hoverEdge == DragMode::ResizeLeft) {
+            g.fillRect(bounds.withWidth(RESIZE_HANDLE_WIDTH));
+        } else if (hoverEdge == DragMode::ResizeRight) {
+            g.fillRect(bounds.withTrimmedLeft(bounds.getWidth() - RESIZE_HANDLE_WIDTH));
         }
     }
 }
@@ -117,8 +218,17 @@ void PianoRollGridComponent::paintGrid(juce::Graphics& g, juce::Rectangle<int> a
 void PianoRollGridComponent::paintBeatLines(juce::Graphics& g, juce::Rectangle<int> area,
                                             double lengthBeats) {
     double gridResolution = getGridResolutionBeats();
+    if (gridResolution <= 0.0) {
+        gridResolution = 1.0;  // Snap off still shows beats
+    }
 
-    for (double beat = 0; beat <= lengthBeats; beat += gridResolution) {
+    // Start at the first line inside the repainted area
+    auto visible = g.getClipBounds().getIntersection(area);
+    double firstBeat =
+        juce::jmax(0.0, std::floor(pixelToBeat(visible.getX()) / gridResolution) * gridResolution);
+    lengthBeats = juce::jmin(lengthBeats, pixelToBeat(visible.getRight()) + gridResolution);
+
+    for (double beat = firstBeat; beat <= lengthBeats; beat += gridResolution) {
         int x = beatToPixel(beat);
         if (x < area.getX() || x > area.getRight()) {
             continue;
@@ -144,21 +254,211 @@ void PianoRollGridComponent::paintBeatLines(juce::Graphics& g, juce::Rectangle<i
     }
 }
 
-void PianoRollGridComponent::resized() {
-    updateNoteComponentBounds();
-}
+// ============================================================================
+// Mouse handling
+// ============================================================================
 
 void PianoRollGridComponent::mouseDown(const juce::MouseEvent& e) {
-    // Click on empty space - deselect all notes
-    if (!e.mods.isCommandDown() && !e.mods.isShiftDown()) {
-        for (auto& noteComp : noteComponents_) {
-            noteComp->setSelected(false);
+    dragMode_ = DragMode::None;
+    dragNoteIndex_ = -1;
+    isDragging_ = false;
+
+    int index = getNoteIndexAt(e.getPosition());
+    if (index < 0) {
+        // Click on empty space - deselect all notes
+        if (!e.mods.isCommandDown() && !e.mods.isShiftDown()) {
+            selectOnly(-1);
+        }
+        return;
+    }
+
+    // Handle Cmd+click for toggle selection
+    if (e.mods.isCommandDown()) {
+        selectOnly(isNoteSelected(static_cast<size_t>(index)) ? -1 : index);
+        selectedNoteIndex_ = index;
+        if (onNoteSelected && clipId_ != INVALID_CLIP_ID) {
+            onNoteSelected(clipId_, getNoteId(index));
+        }
+        return;
+    }
+
+    // Single click - select this note
+    selectOnly(index);
+    if (onNoteSelected && clipId_ != INVALID_CLIP_ID) {
+        onNoteSelected(clipId_, getNoteId(index));
+    }
+
+    // Store drag start info
+    const auto* clip = static_cast<const ClipManager&>(ClipManager::getInstance()).getClip(clipId_);
+    const auto& note = clip->midiNotes[static_cast<size_t>(index)];
+    dragNoteIndex_ = index;
+    dragStartPos_ = e.getPosition();
+    dragStartBeat_ = note.startBeat;
+    dragStartLength_ = note.lengthBeats;
+    dragStartNoteNumber_ = note.noteNumber;
+
+    // Initialize preview state
+    previewStartBeat_ = note.startBeat;
+    previewLengthBeats_ = note.lengthBeats;
+    previewNoteNumber_ = note.noteNumber;
+
+    // Determine drag mode based on click position
+    dragMode_ = getEdgeAt(index, e.getPosition());
+    grabKeyboardFocus();
+}
+
+void PianoRollGridComponent::mouseDrag(const juce::MouseEvent& e) {
+    if (dragMode_ == DragMode::None || dragNoteIndex_ < 0) {
+        return;
+    }
+
+    if (!isDragging_) {
+        isDragging_ = true;
+        repaintNote(dragNoteIndex_);  // Now drawn at the preview instead
+    }
+    if (!gesture_) {
+        gesture_ = std::make_unique<GestureScope>();
+    }
+
+    if (pixelsPerBeat_ <= 0 || noteHeight_ <= 0) {
+        return;
+    }
+
+    int deltaX = e.x - dragStartPos_.x;
+    int deltaY = e.y - dragStartPos_.y;
+
+    double deltaBeat = deltaX / pixelsPerBeat_;
+    int deltaNote = -deltaY / noteHeight_;  // Negative because Y increases downward
+    double minLength = 1.0 / 16.0;          // 1/16th note minimum
+
+    auto previous = getNoteBounds(previewStartBeat_, previewNoteNumber_, previewLengthBeats_);
+
+    switch (dragMode_) {
+        case DragMode::Move: {
+            double rawStartBeat = juce::jmax(0.0, dragStartBeat_ + deltaBeat);
+            previewStartBeat_ = snapBeatToGrid(rawStartBeat);
+            previewNoteNumber_ = juce::jlimit(0, 127, dragStartNoteNumber_ + deltaNote);
+            previewLengthBeats_ = dragStartLength_;
+
+            // Notify listeners of drag preview
+            if (onNoteDragging && clipId_ != INVALID_CLIP_ID) {
+                onNoteDragging(clipId_, getNoteId(dragNoteIndex_), previewStartBeat_, true);
+            }
+            break;
         }
-        selectedNoteIndex_ = -1;
+
+        case DragMode::ResizeLeft: {
+            double endBeat = dragStartBeat_ + dragStartLength_;
+            double rawStartBeat = snapBeatToGrid(juce::jmax(0.0, dragStartBeat_ + deltaBeat));
+
+            // Ensure minimum length
+            previewStartBeat_ = juce::jmin(rawStartBeat, endBeat - minLength);
+            previewLengthBeats_ = endBeat - previewStartBeat_;
+            break;
+        }
+
+        case DragMode::ResizeRight: {
+            // Apply grid snap to end beat
+            double rawEndBeat = snapBeatToGrid(dragStartBeat_ + dragStartLength_ + deltaBeat);
+            previewLengthBeats_ = juce::jmax(minLength, rawEndBeat - dragStartBeat_);
+            break;
+        }
+
+        default:
+            break;
     }
+
+    repaint(previous.expanded(2));
+    repaint(getNoteBounds(previewStartBeat_, previewNoteNumber_, previewLengthBeats_).expanded(2));
+}
+
+void PianoRollGridComponent::mouseUp(const juce::MouseEvent& /*e*/) {
+    // Ends the gesture once the commit below is done
+    auto gesture = std::move(gesture_);
+
+    // Commits refresh the notes and may re-sort them, so finish with the drag state first
+    // and hold on to the note by id
+    auto mode = dragMode_;
+    auto noteId = getNoteId(dragNoteIndex_);
+    bool committed = isDragging_ && dragMode_ != DragMode::None;
+    dragMode_ = DragMode::None;
+    dragNoteIndex_ = -1;
+    isDragging_ = false;
+
+    if (noteId == INVALID_MIDI_NOTE_ID || clipId_ == INVALID_CLIP_ID) {
+        return;
+    }
+
+    if (committed) {
+        switch (mode) {
+            case DragMode::Move:
+                if (onNoteMoved) {
+                    onNoteMoved(clipId_, noteId, previewStartBeat_, previewNoteNumber_);
+                }
+                break;
+
+            case DragMode::ResizeLeft:
+                // Resizing from left changes both start and length
+                if (onNoteMoved) {
+                    onNoteMoved(clipId_, noteId, previewStartBeat_, dragStartNoteNumber_);
+                }
+                if (onNoteResized) {
+                    onNoteResized(clipId_, noteId, previewLengthBeats_);
+                }
+                break;
+
+            case DragMode::ResizeRight:
+                if (onNoteResized) {
+                    onNoteResized(clipId_, noteId, previewLengthBeats_);
+                }
+                break;
+
+            default:
+                break;
+        }
+    }
+
+    // Notify that drag has ended
+    if (onNoteDragging) {
+        onNoteDragging(clipId_, noteId, previewStartBeat_, false);
+    }
+    repaint();
+}
+
+void PianoRollGridComponent::mouseMove(const juce::MouseEvent& e) {
+    int index = getNoteIndexAt(e.getPosition());
+    auto edge = index >= 0 ? getEdgeAt(index, e.getPosition()) : DragMode::None;
+    if (edge == DragMode::Move) {
+        edge = DragMode::None;
+    }
+
+    if (index != hoverNoteIndex_ || edge != hoverEdge_) {
+        repaintNote(hoverNoteIndex_);
+        hoverNoteIndex_ = index;
+        hoverEdge_ = edge;
+        repaintNote(hoverNoteIndex_);
+        updateCursor();
+    }
+}
+
+void PianoRollGridComponent::mouseExit(const juce::MouseEvent& /*e*/) {
+    repaintNote(hoverNoteIndex_);
+    hoverNoteIndex_ = -1;
+    hoverEdge_ = DragMode::None;
+    updateCursor();
 }
 
 void PianoRollGridComponent::mouseDoubleClick(const juce::MouseEvent& e) {
+    // Double-click on a note to delete it
+    int index = getNoteIndexAt(e.getPosition());
+    if (index >= 0) {
+        if (onNoteDeleted && clipId_ != INVALID_CLIP_ID) {
+            onNoteDeleted(clipId_, getNoteId(index));
+            selectedNoteIndex_ = -1;
+        }
+        return;
+    }
+
     // Double-click to add a new note
     double beat = pixelToBeat(e.x);
     int noteNumber = yToNoteNumber(e.y);
@@ -187,7 +487,7 @@ bool PianoRollGridComponent::keyPressed(const juce::KeyPress& key) {
     // Delete key removes selected note
     if (key == juce::KeyPress::deleteKey || key == juce::KeyPress::backspaceKey) {
         if (selectedNoteIndex_ >= 0 && onNoteDeleted && clipId_ != INVALID_CLIP_ID) {
-            onNoteDeleted(clipId_, static_cast<size_t>(selectedNoteIndex_));
+            onNoteDeleted(clipId_, getNoteId(selectedNoteIndex_));
             selectedNoteIndex_ = -1;
             return true;
         }
@@ -206,7 +506,6 @@ void PianoRollGridComponent::setClip(ClipId clipId) {
 void PianoRollGridComponent::setPixelsPerBeat(double ppb) {
     if (pixelsPerBeat_ != ppb) {
         pixelsPerBeat_ = ppb;
-        updateNoteComponentBounds();
         repaint();
     }
 }
@@ -214,7 +513,6 @@ void PianoRollGridComponent::setPixelsPerBeat(double ppb) {
 void PianoRollGridComponent::setNoteHeight(int height) {
     if (noteHeight_ != height) {
         noteHeight_ = height;
-        updateNoteComponentBounds();
         repaint();
     }
 }
@@ -235,7 +533,6 @@ double PianoRollGridComponent::pixelToBeat(int x) const {
 void PianoRollGridComponent::setLeftPadding(int padding) {
     if (leftPadding_ != padding) {
         leftPadding_ = padding;
-        updateNoteComponentBounds();
         repaint();
     }
 }
@@ -243,7 +540,6 @@ void PianoRollGridComponent::setLeftPadding(int padding) {
 void PianoRollGridComponent::setClipStartBeats(double startBeats) {
     if (clipStartBeats_ != startBeats) {
         clipStartBeats_ = startBeats;
-        updateNoteComponentBounds();
         repaint();
     }
 }
@@ -258,7 +554,6 @@ void PianoRollGridComponent::setClipLengthBeats(double lengthBeats) {
 void PianoRollGridComponent::setRelativeMode(bool relative) {
     if (relativeMode_ != relative) {
         relativeMode_ = relative;
-        updateNoteComponentBounds();
         repaint();
     }
 }
@@ -279,32 +574,59 @@ int PianoRollGridComponent::yToNoteNumber(int y) const {
     return juce::jlimit(MIN_NOTE, MAX_NOTE, note);
 }
 
-void PianoRollGridComponent::updateNotePosition(NoteComponent* note, double beat, int noteNumber,
-                                                double length) {
-    if (!note)
-        return;
-
+juce::Rectangle<int> PianoRollGridComponent::getNoteBounds(double beat, int noteNumber,
+                                                           double length) const {
     // In ABS mode, offset by clip start position for display
-    double displayBeat = relativeMode_ ? beat : (clipStartBeats_ + beat);
-
-    int x = beatToPixel(displayBeat);
+    int x = beatToPixel(displayOffsetBeats() + beat);
     int y = noteNumberToY(noteNumber);
-    int width = juce::jmax(8, static_cast<int>(length * pixelsPerBeat_));
+    int width = juce::jmax(MIN_NOTE_WIDTH, static_cast<int>(length * pixelsPerBeat_));
     int height = noteHeight_ - 2;  // Small gap between notes
 
-    note->setBounds(x, y + 1, width, height);
+    return {x, y + 1, width, height};
 }
 
-void PianoRollGridComponent::refreshNotes() {
-    clearNoteComponents();
+int PianoRollGridComponent::getNoteIndexAt(juce::Point<int> position) const {
+    const auto* clip = static_cast<const ClipManager&>(ClipManager::getInstance()).getClip(clipId_);
+    if (!clip || clip->type != ClipType::MIDI || pixelsPerBeat_ <= 0) {
+        return -1;
+    }
 
-    if (clipId_ == INVALID_CLIP_ID) {
-        repaint();
-        return;
+    double beat = pixelToBeat(position.x) - displayOffsetBeats();
+    int noteNumber = MAX_NOTE - position.y / noteHeight_;
+    std::vector<size_t> candidates;
+    clip->midiNotes.query(beat, beat + 1.0 / pixelsPerBeat_, noteNumber, noteNumber, candidates,
+                          MIN_NOTE_WIDTH / pixelsPerBeat_);
+
+    // Later notes are drawn on top
+    const auto& notes = clip->midiNotes.items();
+    for (auto it = candidates.rbegin(); it != candidates.rend(); ++it) {
+        if (*it < notes.size()) {
+            const auto& note = notes[*it];
+            if (getNoteBounds(note.startBeat, note.noteNumber, note.lengthBeats)
+                    .contains(position)) {
+                return static_cast<int>(*it);
+            }
+        }
     }
+    return -1;
+}
+
+void PianoRollGridComponent::refreshNotes() {
+    // Notes may have moved or gone; any drag in progress is abandoned
+    gesture_.reset();
+    dragMode_ = DragMode::None;
+    dragNoteIndex_ = -1;
+    isDragging_ = false;
+    hoverNoteIndex_ = -1;
+    hoverEdge_ = DragMode::None;
+    selectedNoteIndex_ = -1;
+    selectedNotes_.clear();
 
-    createNoteComponents();
-    updateNoteComponentBounds();
+    // The clip's note list keeps its own query index up to date
+    const auto* clip = static_cast<const ClipManager&>(ClipManager::getInstance()).getClip(clipId_);
+    if (clip && clip->type == ClipType::MIDI) {
+        selectedNotes_.assign(clip->midiNotes.size(), false);
+    }
     repaint();
 }
 
@@ -334,92 +656,71 @@ double PianoRollGridComponent::getGridResolutionBeats() const {
     return 0.25;  // Default to 1/16
 }
 
-void PianoRollGridComponent::createNoteComponents() {
-    const auto* clip = ClipManager::getInstance().getClip(clipId_);
-    if (!clip || clip->type != ClipType::MIDI) {
-        return;
-    }
-
-    juce::Colour noteColour = clip->colour;
-
-    for (size_t i = 0; i < clip->midiNotes.size(); i++) {
-        auto noteComp = std::make_unique<NoteComponent>(i, this);
-
-        // Set up callbacks
-        noteComp->onNoteSelected = [this](size_t index) {
-            // Deselect other notes
-            for (auto& nc : noteComponents_) {
-                if (nc->getNoteIndex() != index) {
-                    nc->setSelected(false);
-                }
-            }
-            selectedNoteIndex_ = static_cast<int>(index);
-
-            if (onNoteSelected && clipId_ != INVALID_CLIP_ID) {
-                onNoteSelected(clipId_, index);
-            }
-        };
-
-        noteComp->onNoteMoved = [this](size_t index, double newBeat, int newNoteNumber) {
-            if (onNoteMoved && clipId_ != INVALID_CLIP_ID) {
-                onNoteMoved(clipId_, index, newBeat, newNoteNumber);
-            }
-        };
-
-        noteComp->onNoteResized = [this](size_t index, double newLength, bool fromStart) {
-            (void)fromStart;  // Length change is already computed
-            if (onNoteResized && clipId_ != INVALID_CLIP_ID) {
-                onNoteResized(clipId_, index, newLength);
-            }
-        };
-
-        noteComp->onNoteDeleted = [this](size_t index) {
-            if (onNoteDeleted && clipId_ != INVALID_CLIP_ID) {
-                onNoteDeleted(clipId_, index);
-                selectedNoteIndex_ = -1;
-            }
-        };
-
-        noteComp->onNoteDragging = [this](size_t index, double previewBeat, bool isDragging) {
-            if (onNoteDragging && clipId_ != INVALID_CLIP_ID) {
-                onNoteDragging(clipId_, index, previewBeat, isDragging);
-            }
-        };
-
-        noteComp->snapBeatToGrid = [this](double beat) { return snapBeatToGrid(beat); };
-
-        noteComp->updateFromNote(clip->midiNotes[i], noteColour);
-        addAndMakeVisible(noteComp.get());
-        noteComponents_.push_back(std::move(noteComp));
+MidiNoteId PianoRollGridComponent::getNoteId(int index) const {
+    const auto* clip = static_cast<const ClipManager&>(ClipManager::getInstance()).getClip(clipId_);
+    if (!clip || index < 0 || static_cast<size_t>(index) >= clip->midiNotes.size()) {
+        return INVALID_MIDI_NOTE_ID;
     }
+    return clip->midiNotes[static_cast<size_t>(index)].id;
 }
 
-void PianoRollGridComponent::clearNoteComponents() {
-    for (auto& noteComp : noteComponents_) {
-        removeChildComponent(noteComp.get());
+void PianoRollGridComponent::selectOnly(int index) {
+    for (size_t i = 0; i < selectedNotes_.size(); ++i) {
+        if (selectedNotes_[i] && static_cast<int>(i) != index) {
+            selectedNotes_[i] = false;
+            repaintNote(static_cast<int>(i));
+        }
     }
-    noteComponents_.clear();
-    selectedNoteIndex_ = -1;
+    if (index >= 0 && static_cast<size_t>(index) < selectedNotes_.size() &&
+        !selectedNotes_[static_cast<size_t>(index)]) {
+        selectedNotes_[static_cast<size_t>(index)] = true;
+        repaintNote(index);
+    }
+    selectedNoteIndex_ = index;
+    updateCursor();
 }
 
-void PianoRollGridComponent::updateNoteComponentBounds() {
-    const auto* clip = ClipManager::getInstance().getClip(clipId_);
-    if (!clip || clip->type != ClipType::MIDI) {
+void PianoRollGridComponent::repaintNote(int index) {
+    const auto* clip = static_cast<const ClipManager&>(ClipManager::getInstance()).getClip(clipId_);
+    if (!clip || index < 0 || static_cast<size_t>(index) >= clip->midiNotes.size()) {
         return;
     }
+    const auto& note = clip->midiNotes[static_cast<size_t>(index)];
+    repaint(getNoteBounds(note.startBeat, note.noteNumber, note.lengthBeats).expanded(2));
+}
 
-    for (size_t i = 0; i < noteComponents_.size() && i < clip->midiNotes.size(); i++) {
-        const auto& note = clip->midiNotes[i];
+PianoRollGridComponent::DragMode PianoRollGridComponent::getEdgeAt(
+    int index, juce::Point<int> position) const {
+    const auto* clip = static_cast<const ClipManager&>(ClipManager::getInstance()).getClip(clipId_);
+    if (!clip || index < 0 || static_cast<size_t>(index) >= clip->midiNotes.size()) {
+        return DragMode::None;
+    }
 
-        // In absolute mode, offset notes by clip start position
-        double displayBeat = relativeMode_ ? note.startBeat : (clipStartBeats_ + note.startBeat);
-        int x = beatToPixel(displayBeat);
-        int y = noteNumberToY(note.noteNumber);
-        int width = juce::jmax(8, static_cast<int>(note.lengthBeats * pixelsPerBeat_));
-        int height = noteHeight_ - 2;
+    // Resize handles only exist on selected notes
+    if (!isNoteSelected(static_cast<size_t>(index))) {
+        return DragMode::Move;
+    }
 
-        noteComponents_[i]->setBounds(x, y + 1, width, height);
-        noteComponents_[i]->updateFromNote(note, clip->colour);
+    const auto& note = clip->midiNotes[static_cast<size_t>(index)];
+    auto bounds = getNoteBounds(note.startBeat, note.noteNumber, note.lengthBeats);
+    if (position.x < bounds.getX() + RESIZE_HANDLE_WIDTH) {
+        return DragMode::ResizeLeft;
+    }
+    if (position.x > bounds.getRight() - RESIZE_HANDLE_WIDTH) {
+        return DragMode::ResizeRight;
+    }
+    return DragMode::Move;
+}
+
+void PianoRollGridComponent::updateCursor() {
+    bool hoverSelected =
+        hoverNoteIndex_ >= 0 && isNoteSelected(static_cast<size_t>(hoverNoteIndex_));
+    if (hoverSelected && hoverEdge_ != DragMode::None) {
+        setMouseCursor(juce::MouseCursor::LeftRightResizeCursor);
+    } else if (hoverSelected) {
+        setMouseCursor(juce::MouseCursor::DraggingHandCursor);
+    } else {
+        setMouseCursor(juce::MouseCursor::NormalCursor);
     }
 }
 
@@ -435,8 +736,16 @@ juce::Colour PianoRollGridComponent::getClipColour() const {
 
 void PianoRollGridComponent::setPlayheadPosition(double positionSeconds) {
     if (playheadPosition_ != positionSeconds) {
+        // Only the strips under the old and new line need repainting
+        int oldX = getPlayheadX();
         playheadPosition_ = positionSeconds;
-        repaint();
+        int newX = getPlayheadX();
+        if (oldX >= 0) {
+            repaint(oldX - 2, 0, 4, getHeight());
+        }
+        if (newX >= 0) {
+            repaint(newX - 2, 0, 4, getHeight());
+        }
     }
 }
 
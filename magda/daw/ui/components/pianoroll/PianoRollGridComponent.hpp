@@ -5,9 +5,9 @@
 #include <memory>
 #include <vector>
 
-#include "NoteComponent.hpp"
 #include "core/ClipInfo.hpp"
 #include "core/ClipTypes.hpp"
+#include "core/UndoManager.hpp"
 
 namespace magda {
 
@@ -16,10 +16,15 @@ namespace magda {
  *
  * Handles:
  * - Grid background rendering (beat lines, note rows)
- * - Note component management (create, update, delete)
- * - Double-click to add notes
+ * - Note rendering in one batched pass over the visible notes only
+ * - Note hit-testing, selection, drag to move and edge resize via the clip's MidiNoteList
+ * - Double-click to add notes (or delete the note under the pointer)
  * - Grid snap settings
  * - Coordinate conversion (beat <-> pixel, noteNumber <-> y)
+ *
+ * Notes are not child components: zooming and scrolling only change how the next paint
+ * maps beats to pixels. Internally notes are addressed by their index in the clip's
+ * sorted note list, which refreshNotes() invalidates; callbacks pass stable note ids.
  */
 class PianoRollGridComponent : public juce::Component {
   public:
@@ -28,10 +33,13 @@ class PianoRollGridComponent : public juce::Component {
 
     // Component overrides
     void paint(juce::Graphics& g) override;
-    void resized() override;
 
     // Mouse handling
     void mouseDown(const juce::MouseEvent& e) override;
+    void mouseDrag(const juce::MouseEvent& e) override;
+    void mouseUp(const juce::MouseEvent& e) override;
+    void mouseMove(const juce::MouseEvent& e) override;
+    void mouseExit(const juce::MouseEvent& e) override;
     void mouseDoubleClick(const juce::MouseEvent& e) override;
 
     // Keyboard handling
@@ -111,24 +119,31 @@ class PianoRollGridComponent : public juce::Component {
     int noteNumberToY(int noteNumber) const;
     int yToNoteNumber(int y) const;
 
-    // Called by NoteComponent to update visual position during drag
-    void updateNotePosition(NoteComponent* note, double beat, int noteNumber, double length);
+    // Bounds of a note drawn at the given (clip-relative) position
+    juce::Rectangle<int> getNoteBounds(double beat, int noteNumber, double length) const;
+
+    // Index of the topmost note under a point, or -1
+    int getNoteIndexAt(juce::Point<int> position) const;
+
+    bool isNoteSelected(size_t index) const {
+        return index < selectedNotes_.size() && selectedNotes_[index];
+    }
 
-    // Refresh note components from clip data
+    // Pick up changed clip data (clears the selection)
     void refreshNotes();
 
     // Callbacks for parent to handle undo/redo
     std::function<void(ClipId, double, int, int)>
         onNoteAdded;  // clipId, beat, noteNumber, velocity
-    std::function<void(ClipId, size_t, double, int)>
-        onNoteMoved;  // clipId, index, newBeat, newNoteNumber
-    std::function<void(ClipId, size_t, double)> onNoteResized;  // clipId, index, newLength
-    std::function<void(ClipId, size_t)> onNoteDeleted;          // clipId, index
-    std::function<void(ClipId, size_t)> onNoteSelected;         // clipId, index
+    std::function<void(ClipId, MidiNoteId, double, int)>
+        onNoteMoved;  // clipId, noteId, newBeat, newNoteNumber
+    std::function<void(ClipId, MidiNoteId, double)> onNoteResized;  // clipId, noteId, newLength
+    std::function<void(ClipId, MidiNoteId)> onNoteDeleted;          // clipId, noteId
+    std::function<void(ClipId, MidiNoteId)> onNoteSelected;         // clipId, noteId
 
     // Callback for drag preview (for syncing velocity lane position)
-    std::function<void(ClipId, size_t, double, bool)>
-        onNoteDragging;  // clipId, index, previewBeat, isDragging
+    std::function<void(ClipId, MidiNoteId, double, bool)>
+        onNoteDragging;  // clipId, noteId, previewBeat, isDragging
 
   private:
     ClipId clipId_ = INVALID_CLIP_ID;
@@ -157,15 +172,46 @@ class PianoRollGridComponent : public juce::Component {
     // Playhead position (in seconds)
     double playheadPosition_ = -1.0;  // -1 = not playing, hide playhead
 
-    // Note components
-    std::vector<std::unique_ptr<NoteComponent>> noteComponents_;
+    // Selection flags by note index (reset on refreshNotes)
+    std::vector<bool> selectedNotes_;
 
     // Currently selected note index (or -1 for none)
     int selectedNoteIndex_ = -1;
 
+    // Note interaction
+    enum class DragMode { None, Move, ResizeLeft, ResizeRight };
+    DragMode dragMode_ = DragMode::None;
+    int dragNoteIndex_ = -1;
+    juce::Point<int> dragStartPos_;
+    double dragStartBeat_ = 0.0;
+    double dragStartLength_ = 0.0;
+    int dragStartNoteNumber_ = 60;
+    double previewStartBeat_ = 0.0;
+    double previewLengthBeats_ = 0.0;
+    int previewNoteNumber_ = 60;
+    bool isDragging_ = false;
+
+    // What the drag commits on mouseUp becomes one undo step
+    std::unique_ptr<GestureScope> gesture_;
+
+    // Hovered note and resize edge
+    int hoverNoteIndex_ = -1;
+    DragMode hoverEdge_ = DragMode::None;
+
+    // Reused between paints
+    std::vector<size_t> visibleNotes_;
+
+    static constexpr int RESIZE_HANDLE_WIDTH = 6;
+    static constexpr float CORNER_RADIUS = 2.0f;
+    static constexpr int MIN_NOTE_WIDTH = 8;
+
     // Painting helpers
     void paintGrid(juce::Graphics& g, juce::Rectangle<int> area);
     void paintBeatLines(juce::Graphics& g, juce::Rectangle<int> area, double lengthBeats);
+    void paintNotes(juce::Graphics& g, const ClipInfo& clip);
+    void paintNote(juce::Graphics& g, juce::Rectangle<int> bounds, int velocity,
+                   juce::Colour colour, bool selected, DragMode hoverEdge) const;
+    int getPlayheadX() const;
 
     // Grid snap helper
     double snapBeatToGrid(double beat) const;
@@ -173,10 +219,15 @@ class PianoRollGridComponent : public juce::Component {
     // Get note resolution in beats
     double getGridResolutionBeats() const;
 
-    // Note management
-    void createNoteComponents();
-    void clearNoteComponents();
-    void updateNoteComponentBounds();
+    // Note interaction helpers
+    MidiNoteId getNoteId(int index) const;
+    void selectOnly(int index);
+    void repaintNote(int index);
+    DragMode getEdgeAt(int index, juce::Point<int> position) const;
+    void updateCursor();
+    double displayOffsetBeats() const {
+        return relativeMode_ ? 0.0 : clipStartBeats_;
+    }
 
     // Helpers
     bool isBlackKey(int noteNumber) const;
@@ -1,5 +1,7 @@
 #include "VelocityLaneComponent.hpp"
 
+#include <cmath>
+
 #include "../../themes/DarkTheme.hpp"
 #include "core/ClipInfo.hpp"
 #include "core/ClipManager.hpp"
@@ -57,12 +59,12 @@ void VelocityLaneComponent::refreshNotes() {
     repaint();
 }
 
-void VelocityLaneComponent::setNotePreviewPosition(size_t noteIndex, double previewBeat,
+void VelocityLaneComponent::setNotePreviewPosition(MidiNoteId noteId, double previewBeat,
                                                    bool isDragging) {
     if (isDragging) {
-        notePreviewPositions_[noteIndex] = previewBeat;
+        notePreviewPositions_[noteId] = previewBeat;
     } else {
-        notePreviewPositions_.erase(noteIndex);
+        notePreviewPositions_.erase(noteId);
     }
     repaint();
 }
@@ -93,28 +95,19 @@ int VelocityLaneComponent::yToVelocity(int y) const {
     return juce::jlimit(0, 127, velocity);
 }
 
-size_t VelocityLaneComponent::findNoteAtX(int x) const {
+MidiNoteId VelocityLaneComponent::findNoteAtX(int x) const {
     const auto* clip = ClipManager::getInstance().getClip(clipId_);
     if (!clip || clip->type != ClipType::MIDI) {
-        return SIZE_MAX;
+        return INVALID_MIDI_NOTE_ID;
     }
 
-    double clickBeat = pixelToBeat(x);
-
-    // Search for a note that contains this beat
-    for (size_t i = 0; i < clip->midiNotes.size(); ++i) {
-        const auto& note = clip->midiNotes[i];
+    // In absolute mode, notes are offset by clip start
+    double clickBeat = pixelToBeat(x) - (relativeMode_ ? 0.0 : clipStartBeats_);
 
-        // In absolute mode, offset by clip start
-        double noteStart = relativeMode_ ? note.startBeat : (clipStartBeats_ + note.startBeat);
-        double noteEnd = noteStart + note.lengthBeats;
-
-        if (clickBeat >= noteStart && clickBeat < noteEnd) {
-            return i;
-        }
-    }
-
-    return SIZE_MAX;
+    // The earliest-starting note that contains this beat
+    std::vector<size_t> hits;
+    clip->midiNotes.queryTimeRange(clickBeat, std::nextafter(clickBeat, clickBeat + 1.0), hits);
+    return hits.empty() ? INVALID_MIDI_NOTE_ID : clip->midiNotes[hits.front()].id;
 }
 
 juce::Colour VelocityLaneComponent::getClipColour() const {
@@ -149,12 +142,10 @@ void VelocityLaneComponent::paint(juce::Graphics& g) {
     int minBarWidth = 4;
 
     // Draw velocity bars for each note
-    for (size_t i = 0; i < clip->midiNotes.size(); ++i) {
-        const auto& note = clip->midiNotes[i];
-
+    for (const auto& note : clip->midiNotes) {
         // Calculate x position - use preview position if available
         double noteStart = note.startBeat;
-        auto previewIt = notePreviewPositions_.find(i);
+        auto previewIt = notePreviewPositions_.find(note.id);
         if (previewIt != notePreviewPositions_.end()) {
             noteStart = previewIt->second;
         }
@@ -171,7 +162,7 @@ void VelocityLaneComponent::paint(juce::Graphics& g) {
 
         // Use drag velocity if this is the note being dragged
         int velocity = note.velocity;
-        if (isDragging_ && i == draggingNoteIndex_) {
+        if (isDragging_ && note.id == draggingNoteId_) {
             velocity = currentDragVelocity_;
         }
 
@@ -191,7 +182,7 @@ void VelocityLaneComponent::paint(juce::Graphics& g) {
         g.drawRect(barBounds, 1);
 
         // Highlight if being dragged
-        if (isDragging_ && i == draggingNoteIndex_) {
+        if (isDragging_ && note.id == draggingNoteId_) {
             g.setColour(juce::Colours::white.withAlpha(0.3f));
             g.fillRect(barBounds);
         }
@@ -203,13 +194,13 @@ void VelocityLaneComponent::paint(juce::Graphics& g) {
 }
 
 void VelocityLaneComponent::mouseDown(const juce::MouseEvent& e) {
-    size_t noteIndex = findNoteAtX(e.x);
+    MidiNoteId noteId = findNoteAtX(e.x);
 
-    if (noteIndex != SIZE_MAX) {
+    if (noteId != INVALID_MIDI_NOTE_ID) {
         const auto* clip = ClipManager::getInstance().getClip(clipId_);
-        if (clip && noteIndex < clip->midiNotes.size()) {
-            draggingNoteIndex_ = noteIndex;
-            dragStartVelocity_ = clip->midiNotes[noteIndex].velocity;
+        if (const auto* note = clip ? clip->midiNotes.find(noteId) : nullptr) {
+            draggingNoteId_ = noteId;
+            dragStartVelocity_ = note->velocity;
             currentDragVelocity_ = yToVelocity(e.y);
             isDragging_ = true;
             repaint();
@@ -218,7 +209,7 @@ void VelocityLaneComponent::mouseDown(const juce::MouseEvent& e) {
 }
 
 void VelocityLaneComponent::mouseDrag(const juce::MouseEvent& e) {
-    if (isDragging_ && draggingNoteIndex_ != SIZE_MAX) {
+    if (isDragging_ && draggingNoteId_ != INVALID_MIDI_NOTE_ID) {
         int newVelocity = yToVelocity(e.y);
         if (newVelocity != currentDragVelocity_) {
             currentDragVelocity_ = newVelocity;
@@ -228,15 +219,15 @@ void VelocityLaneComponent::mouseDrag(const juce::MouseEvent& e) {
 }
 
 void VelocityLaneComponent::mouseUp(const juce::MouseEvent& e) {
-    if (isDragging_ && draggingNoteIndex_ != SIZE_MAX) {
+    if (isDragging_ && draggingNoteId_ != INVALID_MIDI_NOTE_ID) {
         int finalVelocity = yToVelocity(e.y);
 
         // Only commit if velocity actually changed
         if (finalVelocity != dragStartVelocity_ && onVelocityChanged) {
-            onVelocityChanged(clipId_, draggingNoteIndex_, finalVelocity);
+            onVelocityChanged(clipId_, draggingNoteId_, finalVelocity);
         }
 
-        draggingNoteIndex_ = SIZE_MAX;
+        draggingNoteId_ = INVALID_MIDI_NOTE_ID;
         isDragging_ = false;
         repaint();
     }
@@ -4,6 +4,7 @@
 
 #include "DarkTheme.hpp"
 #include "LayoutConfig.hpp"
+#include "../../utils/FrameScheduler.hpp"
 
 namespace magda {
 
@@ -12,7 +13,9 @@ TimeRuler::TimeRuler() {
 }
 
 TimeRuler::~TimeRuler() {
-    stopTimer();
+    if (linkedViewport) {
+        linkedViewport->getHorizontalScrollBar().removeListener(this);
+    }
 }
 
 void TimeRuler::paint(juce::Graphics& g) {
@@ -88,8 +91,17 @@ void TimeRuler::setClipLength(double lengthSeconds) {
 
 void TimeRuler::setPlayheadPosition(double positionSeconds) {
     if (playheadPosition != positionSeconds) {
+        // Only the strips under the old and new line need repainting
+        repaintPlayheadStrip();
         playheadPosition = positionSeconds;
-        repaint();
+        repaintPlayheadStrip();
+    }
+}
+
+void TimeRuler::repaintPlayheadStrip() {
+    if (playheadPosition >= 0.0) {
+        double displayTime = relativeMode ? (playheadPosition - timeOffset) : playheadPosition;
+        repaint(timeToPixel(displayTime) - 2, 0, 4, getHeight());
     }
 }
 
@@ -99,24 +111,20 @@ void TimeRuler::setLeftPadding(int padding) {
 }
 
 void TimeRuler::setLinkedViewport(juce::Viewport* viewport) {
+    if (linkedViewport) {
+        linkedViewport->getHorizontalScrollBar().removeListener(this);
+    }
     linkedViewport = viewport;
     if (linkedViewport) {
-        // Start timer for real-time scroll sync (60fps)
-        startTimerHz(60);
-        lastViewportX = linkedViewport->getViewPositionX();
-    } else {
-        stopTimer();
+        // Repaint when the viewport scrolls rather than watching it every frame
+        linkedViewport->getHorizontalScrollBar().addListener(this);
     }
+    repaint();
 }
 
-void TimeRuler::timerCallback() {
-    if (linkedViewport) {
-        int currentX = linkedViewport->getViewPositionX();
-        if (currentX != lastViewportX) {
-            lastViewportX = currentX;
-            repaint();
-        }
-    }
+void TimeRuler::scrollBarMoved(juce::ScrollBar* scrollBar, double newRangeStart) {
+    juce::ignoreUnused(scrollBar, newRangeStart);
+    FrameScheduler::getInstance().requestRepaint(*this);
 }
 
 int TimeRuler::getPreferredHeight() const {
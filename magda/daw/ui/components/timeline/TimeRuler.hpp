@@ -10,7 +10,7 @@ namespace magda {
  * Time ruler component displaying time markers and labels.
  * Supports both time-based (seconds) and musical (bars/beats) display modes.
  */
-class TimeRuler : public juce::Component, private juce::Timer {
+class TimeRuler : public juce::Component, private juce::ScrollBar::Listener {
   public:
     enum class DisplayMode { Seconds, BarsBeats };
 
@@ -102,7 +102,7 @@ class TimeRuler : public juce::Component, private juce::Timer {
 
     // Layout
     int leftPadding = 18;  // Configurable padding (default 18 for main timeline)
-    juce::Viewport* linkedViewport = nullptr;  // For real-time scroll sync
+    juce::Component::SafePointer<juce::Viewport> linkedViewport;  // For real-time scroll sync
     static constexpr int TICK_HEIGHT_MAJOR = 12;
     static constexpr int TICK_HEIGHT_MINOR = 6;
     static constexpr int LABEL_MARGIN = 4;
@@ -118,9 +118,10 @@ class TimeRuler : public juce::Component, private juce::Timer {
     double pixelToTime(int pixel) const;
     int timeToPixel(double time) const;
 
-    // Timer callback for real-time scroll sync
-    void timerCallback() override;
-    int lastViewportX = 0;  // Track last position to detect changes
+    void repaintPlayheadStrip();
+
+    // Scroll sync: the linked viewport's horizontal scroll bar reports every move
+    void scrollBarMoved(juce::ScrollBar* scrollBar, double newRangeStart) override;
 
     // Drag state (zoom or scroll)
     enum class DragMode { None, Zooming, Scrolling };
@@ -93,6 +93,11 @@ void TimelineComponent::zoomStateChanged(const TimelineState& state) {
     repaint();
 }
 
+void TimelineComponent::playheadStateChanged(const TimelineState& state) {
+    // Cached for click handling only; MainView's overlay draws the playhead
+    playheadPosition = state.playhead.getPosition();
+}
+
 void TimelineComponent::loopStateChanged(const TimelineState& state) {
     if (state.loop.isValid()) {
         loopStartTime = state.loop.startTime;
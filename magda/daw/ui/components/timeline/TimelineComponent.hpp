@@ -26,6 +26,7 @@ class TimelineComponent : public juce::Component, public TimelineStateListener {
     // TimelineStateListener implementation
     void timelineStateChanged(const TimelineState& state) override;
     void zoomStateChanged(const TimelineState& state) override;
+    void playheadStateChanged(const TimelineState& state) override;
     void loopStateChanged(const TimelineState& state) override;
     void selectionStateChanged(const TimelineState& state) override;
 
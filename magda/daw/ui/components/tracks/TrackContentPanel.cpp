@@ -172,6 +172,10 @@ void TrackContentPanel::zoomStateChanged(const TimelineState& state) {
     repaint();
 }
 
+void TrackContentPanel::playheadStateChanged(const TimelineState& /*state*/) {
+    // The playhead is drawn by MainView's overlay; nothing here depends on it
+}
+
 void TrackContentPanel::paint(juce::Graphics& g) {
     g.fillAll(DarkTheme::getColour(DarkTheme::TRACK_BACKGROUND));
 
@@ -1422,29 +1426,22 @@ void TrackContentPanel::captureClipsInTimeSelection() {
         return;
     }
 
-    // Get all clips and check if they overlap with the time selection
-    const auto& clips = ClipManager::getInstance().getClips();
-
-    for (const auto& clip : clips) {
-        // Check if clip's track is in the selection
-        auto it = std::find(visibleTrackIds_.begin(), visibleTrackIds_.end(), clip.trackId);
-        if (it == visibleTrackIds_.end()) {
-            continue;  // Track not visible
-        }
-
-        int trackIndex = static_cast<int>(std::distance(visibleTrackIds_.begin(), it));
-        if (!selection.includesTrack(trackIndex)) {
+    // Capture clips on selected visible tracks that overlap the selection time range
+    auto& clipManager = ClipManager::getInstance();
+    for (size_t trackIndex = 0; trackIndex < visibleTrackIds_.size(); ++trackIndex) {
+        if (!selection.includesTrack(static_cast<int>(trackIndex))) {
             continue;  // Track not in selection
         }
 
-        // Check if clip overlaps with selection time range
-        double clipEnd = clip.startTime + clip.length;
-        if (clip.startTime < selection.endTime && clipEnd > selection.startTime) {
-            // Clip overlaps with selection - capture it
-            TimeSelectionClipInfo info;
-            info.clipId = clip.id;
-            info.originalStartTime = clip.startTime;
-            clipsInTimeSelection_.push_back(info);
+        auto clipIds = clipManager.getClipsInRange(visibleTrackIds_[trackIndex],
+                                                   selection.startTime, selection.endTime);
+        for (auto clipId : clipIds) {
+            if (const auto* clip = clipManager.getClip(clipId)) {
+                TimeSelectionClipInfo info;
+                info.clipId = clipId;
+                info.originalStartTime = clip->startTime;
+                clipsInTimeSelection_.push_back(info);
+            }
         }
     }
 }
@@ -46,6 +46,7 @@ class TrackContentPanel : public juce::Component,
     // TimelineStateListener implementation
     void timelineStateChanged(const TimelineState& state) override;
     void zoomStateChanged(const TimelineState& state) override;
+    void playheadStateChanged(const TimelineState& state) override;
 
     // TrackManagerListener implementation
     void tracksChanged() override;
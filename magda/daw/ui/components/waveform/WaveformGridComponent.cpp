@@ -3,12 +3,24 @@
 #include "../../themes/DarkTheme.hpp"
 #include "../../themes/FontManager.hpp"
 #include "audio/AudioThumbnailManager.hpp"
+#include "audio/WaveformTileCache.hpp"
 #include "core/ClipOperations.hpp"
 
 namespace magda::daw::ui {
 
 WaveformGridComponent::WaveformGridComponent() {
     setName("WaveformGrid");
+    magda::WaveformTileCache::getInstance().addChangeListener(this);
+}
+
+WaveformGridComponent::~WaveformGridComponent() {
+    magda::WaveformTileCache::getInstance().removeChangeListener(this);
+}
+
+void WaveformGridComponent::changeListenerCallback(juce::ChangeBroadcaster* /*source*/) {
+    if (editingClipId_ != magda::INVALID_CLIP_ID) {
+        repaint();
+    }
 }
 
 void WaveformGridComponent::paint(juce::Graphics& g) {
@@ -101,9 +113,9 @@ void WaveformGridComponent::paintWaveform(juce::Graphics& g, const magda::ClipIn
     waveformRect =
         juce::Rectangle<int>(positionPixels, bounds.getY(), widthPixels, bounds.getHeight());
 
-    // Draw real waveform from audio thumbnail (scaled by vertical zoom)
+    // Draw real waveform from the file's peaks (scaled by vertical zoom)
     if (source.filePath.isNotEmpty()) {
-        auto& thumbnailManager = magda::AudioThumbnailManager::getInstance();
+        auto& tileCache = magda::WaveformTileCache::getInstance();
         double fileWindow = source.length / source.stretchFactor;
         double displayStart = source.offset;
         double displayEnd = source.offset + fileWindow;
@@ -113,9 +125,9 @@ void WaveformGridComponent::paintWaveform(juce::Graphics& g, const magda::ClipIn
         if (waveDrawRect.getWidth() > 0 && waveDrawRect.getHeight() > 0) {
             g.saveState();
             if (g.reduceClipRegion(waveformRect)) {
-                thumbnailManager.drawWaveform(g, waveDrawRect, source.filePath, displayStart,
-                                              displayEnd, clip.colour.brighter(0.2f),
-                                              static_cast<float>(verticalZoom_));
+                tileCache.drawWaveform(g, waveDrawRect, source.filePath, displayStart,
+                                       displayEnd, clip.colour.brighter(0.2f),
+                                       static_cast<float>(verticalZoom_));
             }
             g.restoreState();
         }
@@ -326,10 +338,8 @@ void WaveformGridComponent::mouseDown(const juce::MouseEvent& event) {
 
     // Cache file duration for trim clamping
     dragStartFileDuration_ = 0.0;
-    auto* thumbnail = magda::AudioThumbnailManager::getInstance().getThumbnail(source.filePath);
-    if (thumbnail) {
-        dragStartFileDuration_ = thumbnail->getTotalLength();
-    }
+    dragStartFileDuration_ =
+        magda::AudioThumbnailManager::getInstance().getFileDuration(source.filePath);
 }
 
 void WaveformGridComponent::mouseDrag(const juce::MouseEvent& event) {
@@ -14,10 +14,10 @@ namespace magda::daw::ui {
  * Designed to be placed inside a Viewport for scrolling.
  * Similar to PianoRollGridComponent architecture.
  */
-class WaveformGridComponent : public juce::Component {
+class WaveformGridComponent : public juce::Component, public juce::ChangeListener {
   public:
     WaveformGridComponent();
-    ~WaveformGridComponent() override = default;
+    ~WaveformGridComponent() override;
 
     // Component overrides
     void paint(juce::Graphics& g) override;
@@ -29,6 +29,9 @@ class WaveformGridComponent : public juce::Component {
     void mouseUp(const juce::MouseEvent& event) override;
     void mouseMove(const juce::MouseEvent& event) override;
 
+    // ChangeListener (waveform tiles became ready)
+    void changeListenerCallback(juce::ChangeBroadcaster* source) override;
+
     // ========================================================================
     // Configuration
     // ========================================================================
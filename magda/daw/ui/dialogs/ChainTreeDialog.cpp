@@ -332,16 +332,28 @@ class ChainTreeDialog::ContentComponent : public juce::Component,
         // Create root item for track
         auto root = std::make_unique<TrackTreeItem>(track->name, trackId_);
 
-        // Add all chain elements (devices and racks in order)
-        for (const auto& element : track->chainElements) {
-            if (magda::isDevice(element)) {
-                const auto& device = magda::getDevice(element);
-                auto path = ChainNodePath::topLevelDevice(trackId_, device.id);
-                root->addSubItem(new DeviceTreeItem(device, path));
-            } else if (magda::isRack(element)) {
-                const auto& rack = magda::getRack(element);
-                auto rackPath = ChainNodePath::rack(trackId_, rack.id);
-                root->addSubItem(buildRackItem(rack, rackPath));
+        // The chain graph is depth-first, so every parent item exists before its children
+        // and appending in node order keeps the chain order
+        if (const auto* graph = TrackManager::getInstance().getChainGraph(trackId_)) {
+            std::vector<juce::TreeViewItem*> items(graph->nodes.size());
+            for (uint32_t i = 0; i < graph->nodes.size(); ++i) {
+                const auto& node = graph->nodes[i];
+                auto path = graph->getPath(i);
+
+                switch (node.type) {
+                    case ChainStepType::Device:
+                        items[i] = new DeviceTreeItem(*node.device, path);
+                        break;
+                    case ChainStepType::Rack:
+                        items[i] = new RackTreeItem(node.rack->name, path);
+                        break;
+                    case ChainStepType::Chain:
+                        items[i] = new ChainTreeItem(node.chain->name, path);
+                        break;
+                }
+
+                auto* parent = node.parent == ChainGraph::npos ? root.get() : items[node.parent];
+                parent->addSubItem(items[i]);
             }
         }
 
@@ -353,32 +365,6 @@ class ChainTreeDialog::ContentComponent : public juce::Component,
         expandAllItems(rootItem_.get());
     }
 
-    juce::TreeViewItem* buildRackItem(const RackInfo& rack, const ChainNodePath& rackPath) {
-        auto* rackItem = new RackTreeItem(rack.name, rackPath);
-
-        for (const auto& chain : rack.chains) {
-            auto chainPath = rackPath.withChain(chain.id);
-            auto* chainItem = new ChainTreeItem(chain.name, chainPath);
-
-            for (const auto& element : chain.elements) {
-                if (isDevice(element)) {
-                    const auto& device = getDevice(element);
-                    auto devicePath = chainPath.withDevice(device.id);
-                    chainItem->addSubItem(new DeviceTreeItem(device, devicePath));
-                } else if (isRack(element)) {
-                    // Recursive: nested rack
-                    const auto& nestedRack = getRack(element);
-                    auto nestedRackPath = chainPath.withRack(nestedRack.id);
-                    chainItem->addSubItem(buildRackItem(nestedRack, nestedRackPath));
-                }
-            }
-
-            rackItem->addSubItem(chainItem);
-        }
-
-        return rackItem;
-    }
-
     void expandAllItems(juce::TreeViewItem* item) {
         if (!item)
             return;
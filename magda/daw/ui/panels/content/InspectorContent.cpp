@@ -307,11 +307,11 @@ InspectorContent::InspectorContent() {
     notePitchValue_->onValueChange = [this]() {
         if (noteSelection_.isValid() && noteSelection_.isSingleNote()) {
             const auto* clip = magda::ClipManager::getInstance().getClip(noteSelection_.clipId);
-            if (clip && noteSelection_.noteIndices[0] < clip->midiNotes.size()) {
-                const auto& note = clip->midiNotes[noteSelection_.noteIndices[0]];
+            auto noteId = noteSelection_.noteIds[0];
+            if (const auto* note = clip ? clip->midiNotes.find(noteId) : nullptr) {
                 int newPitch = static_cast<int>(notePitchValue_->getValue());
                 auto cmd = std::make_unique<magda::MoveMidiNoteCommand>(
-                    noteSelection_.clipId, noteSelection_.noteIndices[0], note.startBeat, newPitch);
+                    noteSelection_.clipId, noteId, note->startBeat, newPitch);
                 magda::UndoManager::getInstance().executeCommand(std::move(cmd));
             }
         }
@@ -331,7 +331,7 @@ InspectorContent::InspectorContent() {
         if (noteSelection_.isValid() && noteSelection_.isSingleNote()) {
             int newVelocity = static_cast<int>(noteVelocityValue_->getValue());
             auto cmd = std::make_unique<magda::SetMidiNoteVelocityCommand>(
-                noteSelection_.clipId, noteSelection_.noteIndices[0], newVelocity);
+                noteSelection_.clipId, noteSelection_.noteIds[0], newVelocity);
             magda::UndoManager::getInstance().executeCommand(std::move(cmd));
         }
     };
@@ -360,7 +360,7 @@ InspectorContent::InspectorContent() {
         if (noteSelection_.isValid() && noteSelection_.isSingleNote()) {
             double newLength = noteLengthValue_->getValue();
             auto cmd = std::make_unique<magda::ResizeMidiNoteCommand>(
-                noteSelection_.clipId, noteSelection_.noteIndices[0], newLength);
+                noteSelection_.clipId, noteSelection_.noteIds[0], newLength);
             magda::UndoManager::getInstance().executeCommand(std::move(cmd));
         }
     };
@@ -655,7 +655,8 @@ void InspectorContent::deviceParameterChanged(magda::DeviceId deviceId, int para
                 const auto* device = magda::TrackManager::getInstance().getDevice(
                     selectedChainNode_.trackId, deviceId);
                 if (device && paramIndex < static_cast<int>(device->parameters.size())) {
-                    const auto& param = device->parameters[paramIndex];
+                    const auto& param =
+                        device->parameters.getDescriptor(static_cast<size_t>(paramIndex));
                     juce::String valueText = juce::String(newValue, 2);
                     if (param.unit.isNotEmpty()) {
                         valueText += " " + param.unit;
@@ -1131,7 +1132,7 @@ void InspectorContent::updateFromSelectedChainNode() {
                 break;
         }
 
-        nodeName = resolved.displayPath;
+        nodeName = magda::TrackManager::getInstance().getDisplayPath(selectedChainNode_);
     }
 
     DBG("  -> typeName=" + typeName + " nodeName=" + nodeName);
@@ -1219,18 +1220,15 @@ void InspectorContent::updateFromSelectedNotes() {
 
     if (noteSelection_.isSingleNote()) {
         // Single note - show editable properties
-        size_t noteIndex = noteSelection_.noteIndices[0];
-        if (noteIndex < clip->midiNotes.size()) {
-            const auto& note = clip->midiNotes[noteIndex];
-
-            notePitchValue_->setValue(note.noteNumber, juce::dontSendNotification);
-            noteVelocityValue_->setValue(note.velocity, juce::dontSendNotification);
+        if (const auto* note = clip->midiNotes.find(noteSelection_.noteIds[0])) {
+            notePitchValue_->setValue(note->noteNumber, juce::dontSendNotification);
+            noteVelocityValue_->setValue(note->velocity, juce::dontSendNotification);
 
             // Format start as beats
-            juce::String startStr = juce::String(note.startBeat, 2) + " beats";
+            juce::String startStr = juce::String(note->startBeat, 2) + " beats";
             noteStartValue_.setText(startStr, juce::dontSendNotification);
 
-            noteLengthValue_->setValue(note.lengthBeats, juce::dontSendNotification);
+            noteLengthValue_->setValue(note->lengthBeats, juce::dontSendNotification);
         }
     } else {
         // Multiple notes - show count and common properties
@@ -1238,14 +1236,12 @@ void InspectorContent::updateFromSelectedNotes() {
         noteCountLabel_.setText(countStr, juce::dontSendNotification);
 
         // For multiple notes, show the first note's values (or could show average/common)
-        if (!noteSelection_.noteIndices.empty()) {
-            size_t firstIndex = noteSelection_.noteIndices[0];
-            if (firstIndex < clip->midiNotes.size()) {
-                const auto& note = clip->midiNotes[firstIndex];
-                notePitchValue_->setValue(note.noteNumber, juce::dontSendNotification);
-                noteVelocityValue_->setValue(note.velocity, juce::dontSendNotification);
+        if (!noteSelection_.noteIds.empty()) {
+            if (const auto* note = clip->midiNotes.find(noteSelection_.noteIds[0])) {
+                notePitchValue_->setValue(note->noteNumber, juce::dontSendNotification);
+                noteVelocityValue_->setValue(note->velocity, juce::dontSendNotification);
                 noteStartValue_.setText("--", juce::dontSendNotification);
-                noteLengthValue_->setValue(note.lengthBeats, juce::dontSendNotification);
+                noteLengthValue_->setValue(note->lengthBeats, juce::dontSendNotification);
             }
         }
     }
@@ -1722,7 +1718,10 @@ void InspectorContent::createDeviceParamControls(const magda::DeviceInfo& device
 
     int y = padding;
     for (size_t i = 0; i < device.parameters.size(); ++i) {
-        const auto& param = device.parameters[i];
+        // Metadata and value are read separately so listing a plugin's parameters doesn't
+        // build every page of them
+        const auto& param = device.parameters.getDescriptor(i);
+        const float currentValue = device.parameters.getCurrentValue(i);
 
         auto control = std::make_unique<DeviceParamControl>();
         control->paramIndex = static_cast<int>(i);
@@ -1735,7 +1734,7 @@ void InspectorContent::createDeviceParamControls(const magda::DeviceInfo& device
         deviceParamsContainer_.addAndMakeVisible(control->nameLabel);
 
         // Value label (shows current value + unit)
-        juce::String valueText = juce::String(param.currentValue, 2);
+        juce::String valueText = juce::String(currentValue, 2);
         if (param.unit.isNotEmpty()) {
             valueText += " " + param.unit;
         }
@@ -1760,7 +1759,7 @@ void InspectorContent::createDeviceParamControls(const magda::DeviceInfo& device
             control->slider.setSkewFactorFromMidPoint(std::sqrt(param.minValue * param.maxValue));
         }
         control->slider.setRange(param.minValue, param.maxValue, 0.0);
-        control->slider.setValue(param.currentValue, juce::dontSendNotification);
+        control->slider.setValue(currentValue, juce::dontSendNotification);
 
         // Wire up callback to update parameter via TrackManager
         int paramIndex = static_cast<int>(i);
@@ -1774,7 +1773,8 @@ void InspectorContent::createDeviceParamControls(const magda::DeviceInfo& device
                 // Update value label
                 const auto* dev = magda::TrackManager::getInstance().getDevice(trackId, deviceId);
                 if (dev && paramIndex < static_cast<int>(dev->parameters.size())) {
-                    const auto& param = dev->parameters[paramIndex];
+                    const auto& param =
+                        dev->parameters.getDescriptor(static_cast<size_t>(paramIndex));
                     juce::String valueText = juce::String(newValue, 2);
                     if (param.unit.isNotEmpty()) {
                         valueText += " " + param.unit;
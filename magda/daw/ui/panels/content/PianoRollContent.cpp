@@ -118,10 +118,9 @@ PianoRollContent::PianoRollContent() {
     // Create velocity lane component
     velocityLane_ = std::make_unique<magda::VelocityLaneComponent>();
     velocityLane_->setLeftPadding(GRID_LEFT_PADDING);
-    velocityLane_->onVelocityChanged = [this](magda::ClipId clipId, size_t noteIndex,
+    velocityLane_->onVelocityChanged = [this](magda::ClipId clipId, magda::MidiNoteId noteId,
                                               int newVelocity) {
-        auto cmd =
-            std::make_unique<magda::SetMidiNoteVelocityCommand>(clipId, noteIndex, newVelocity);
+        auto cmd = std::make_unique<magda::SetMidiNoteVelocityCommand>(clipId, noteId, newVelocity);
         magda::UndoManager::getInstance().executeCommand(std::move(cmd));
         velocityLane_->refreshNotes();
         gridComponent_->refreshNotes();
@@ -291,38 +290,39 @@ void PianoRollContent::setupGridCallbacks() {
     };
 
     // Handle note movement
-    gridComponent_->onNoteMoved = [](magda::ClipId clipId, size_t noteIndex, double newBeat,
+    gridComponent_->onNoteMoved = [](magda::ClipId clipId, magda::MidiNoteId noteId, double newBeat,
                                      int newNoteNumber) {
         auto cmd =
-            std::make_unique<magda::MoveMidiNoteCommand>(clipId, noteIndex, newBeat, newNoteNumber);
+            std::make_unique<magda::MoveMidiNoteCommand>(clipId, noteId, newBeat, newNoteNumber);
         magda::UndoManager::getInstance().executeCommand(std::move(cmd));
         // Note: UI refresh handled via ClipManagerListener::clipPropertyChanged()
     };
 
     // Handle note resizing
-    gridComponent_->onNoteResized = [](magda::ClipId clipId, size_t noteIndex, double newLength) {
-        auto cmd = std::make_unique<magda::ResizeMidiNoteCommand>(clipId, noteIndex, newLength);
+    gridComponent_->onNoteResized = [](magda::ClipId clipId, magda::MidiNoteId noteId,
+                                       double newLength) {
+        auto cmd = std::make_unique<magda::ResizeMidiNoteCommand>(clipId, noteId, newLength);
         magda::UndoManager::getInstance().executeCommand(std::move(cmd));
         // Note: UI refresh handled via ClipManagerListener::clipPropertyChanged()
     };
 
     // Handle note deletion
-    gridComponent_->onNoteDeleted = [](magda::ClipId clipId, size_t noteIndex) {
-        auto cmd = std::make_unique<magda::DeleteMidiNoteCommand>(clipId, noteIndex);
+    gridComponent_->onNoteDeleted = [](magda::ClipId clipId, magda::MidiNoteId noteId) {
+        auto cmd = std::make_unique<magda::DeleteMidiNoteCommand>(clipId, noteId);
         magda::UndoManager::getInstance().executeCommand(std::move(cmd));
         // Note: UI refresh handled via ClipManagerListener::clipPropertyChanged()
     };
 
     // Handle note selection - update SelectionManager
-    gridComponent_->onNoteSelected = [](magda::ClipId clipId, size_t noteIndex) {
-        magda::SelectionManager::getInstance().selectNote(clipId, noteIndex);
+    gridComponent_->onNoteSelected = [](magda::ClipId clipId, magda::MidiNoteId noteId) {
+        magda::SelectionManager::getInstance().selectNote(clipId, noteId);
     };
 
     // Forward note drag preview to velocity lane for position sync
-    gridComponent_->onNoteDragging = [this](magda::ClipId /*clipId*/, size_t noteIndex,
+    gridComponent_->onNoteDragging = [this](magda::ClipId /*clipId*/, magda::MidiNoteId noteId,
                                             double previewBeat, bool isDragging) {
         if (velocityLane_) {
-            velocityLane_->setNotePreviewPosition(noteIndex, previewBeat, isDragging);
+            velocityLane_->setNotePreviewPosition(noteId, previewBeat, isDragging);
         }
     };
 }
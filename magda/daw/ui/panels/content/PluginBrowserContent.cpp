@@ -1,5 +1,7 @@
 #include "PluginBrowserContent.hpp"
 
+#include <map>
+
 #include "../../dialogs/ParameterConfigDialog.hpp"
 #include "../../themes/DarkTheme.hpp"
 #include "../../themes/FontManager.hpp"
@@ -116,6 +118,8 @@ class PluginBrowserContent::PluginTreeItem : public juce::TreeViewItem {
 
     // Enable drag-and-drop from plugin browser
     juce::var getDragSourceDescription() override {
+        owner_.markRecentlyUsed(plugin_);
+
         // Encode plugin info as a DynamicObject for drop targets
         auto* obj = new juce::DynamicObject();
         obj->setProperty("type", "plugin");
@@ -288,9 +292,15 @@ PluginBrowserContent::PluginBrowserContent() {
 
     // Build internal plugins and tree (external plugins are loaded when engine is set)
     buildInternalPluginList();
+    rebuildSearchIndex();
     rebuildTree();
 }
 
+PluginBrowserContent::~PluginBrowserContent() {
+    // Search jobs read searchGeneration_; make sure none outlive us
+    searchPool_.removeAllJobs(true, 1000);
+}
+
 void PluginBrowserContent::paint(juce::Graphics& g) {
     g.fillAll(DarkTheme::getPanelBackgroundColour());
 }
@@ -369,7 +379,43 @@ void PluginBrowserContent::refreshPluginList() {
     plugins_.clear();
     buildInternalPluginList();
     loadExternalPlugins();
-    rebuildTree();
+    rebuildSearchIndex();
+
+    if (searchBox_.getText().trim().isNotEmpty()) {
+        filterBySearch(searchBox_.getText());
+    } else {
+        rebuildTree();
+    }
+}
+
+void PluginBrowserContent::rebuildSearchIndex() {
+    std::vector<magda::PluginSearchIndex::Entry> entries;
+    entries.reserve(plugins_.size());
+    for (const auto& plugin : plugins_) {
+        entries.push_back({plugin.name, plugin.manufacturer, plugin.category, plugin.subcategory,
+                           plugin.format, getSearchKey(plugin)});
+    }
+
+    // Results of searches still in flight index the old list
+    searchGeneration_++;
+    searchIndex_ = std::make_shared<const magda::PluginSearchIndex>(entries);
+
+    // Result rows are keyed by index into the old list; the next results start a fresh tree
+    showingSearchResults_ = false;
+    shownResults_.clear();
+}
+
+juce::String PluginBrowserContent::getSearchKey(const PluginBrowserInfo& plugin) {
+    return plugin.uniqueId.isNotEmpty() ? plugin.uniqueId : plugin.name + "_" + plugin.format;
+}
+
+void PluginBrowserContent::markRecentlyUsed(const PluginBrowserInfo& plugin) {
+    auto key = getSearchKey(plugin);
+    recentPlugins_.removeString(key);
+    recentPlugins_.insert(0, key);
+    while (recentPlugins_.size() > MAX_RECENT_PLUGINS) {
+        recentPlugins_.remove(recentPlugins_.size() - 1);
+    }
 }
 
 void PluginBrowserContent::startPluginScan() {
@@ -453,6 +499,8 @@ void PluginBrowserContent::showFailedPluginsDialog(const juce::StringArray& fail
 void PluginBrowserContent::rebuildTree() {
     pluginTree_.setRootItem(nullptr);
     rootItem_.reset();
+    showingSearchResults_ = false;
+    shownResults_.clear();
 
     // Create root based on view mode
     auto root = std::make_unique<CategoryTreeItem>("Plugins");
@@ -526,29 +574,78 @@ void PluginBrowserContent::rebuildTree() {
 }
 
 void PluginBrowserContent::filterBySearch(const juce::String& searchText) {
-    // For now just rebuild - a real implementation would filter the tree
-    if (searchText.isEmpty()) {
+    int generation = ++searchGeneration_;
+
+    if (searchText.trim().isEmpty()) {
         rebuildTree();
         return;
     }
 
-    pluginTree_.setRootItem(nullptr);
-    rootItem_.reset();
+    // Rank on the pool so typing never waits on the search; the index is immutable and
+    // shared, so a rebuild after a scan doesn't disturb a search already running
+    auto index = searchIndex_;
+    auto recent = recentPlugins_;
+    juce::Component::SafePointer<PluginBrowserContent> safeThis(this);
 
-    auto root = std::make_unique<CategoryTreeItem>("Search Results");
+    searchPool_.addJob([this, index, searchText, recent, generation, safeThis]() {
+        // Superseded by a later keystroke before it started
+        if (searchGeneration_.load() != generation) {
+            return;
+        }
 
-    for (const auto& plugin : plugins_) {
-        if (plugin.name.containsIgnoreCase(searchText) ||
-            plugin.manufacturer.containsIgnoreCase(searchText) ||
-            plugin.subcategory.containsIgnoreCase(searchText)) {
-            root->addSubItem(new PluginTreeItem(plugin, *this));
+        auto matches = index->search(searchText, recent);
+
+        juce::MessageManager::callAsync([safeThis, generation, matches = std::move(matches)]() {
+            if (safeThis && safeThis->searchGeneration_.load() == generation) {
+                safeThis->showSearchResults(matches);
+            }
+        });
+    });
+}
+
+void PluginBrowserContent::showSearchResults(
+    const std::vector<magda::PluginSearchIndex::Match>& matches) {
+    std::vector<uint32_t> results;
+    for (const auto& match : matches) {
+        if (static_cast<int>(results.size()) >= MAX_SEARCH_RESULTS) {
+            break;
         }
+        results.push_back(match.entry);
     }
 
-    rootItem_ = std::move(root);
-    pluginTree_.setRootItem(rootItem_.get());
-    pluginTree_.setRootItemVisible(false);
-    rootItem_->setOpen(true);
+    if (showingSearchResults_ && results == shownResults_) {
+        return;
+    }
+
+    if (!showingSearchResults_) {
+        pluginTree_.setRootItem(nullptr);
+        rootItem_ = std::make_unique<CategoryTreeItem>("Search Results");
+        pluginTree_.setRootItem(rootItem_.get());
+        pluginTree_.setRootItemVisible(false);
+        rootItem_->setOpen(true);
+        showingSearchResults_ = true;
+        shownResults_.clear();
+    }
+
+    // Filter the existing rows rather than rebuilding: detach them, then re-add in the new
+    // order, creating items only for plugins that weren't shown before
+    std::map<uint32_t, std::unique_ptr<juce::TreeViewItem>> previousItems;
+    for (int i = rootItem_->getNumSubItems(); --i >= 0;) {
+        auto* item = rootItem_->getSubItem(i);
+        rootItem_->removeSubItem(i, false);
+        previousItems[shownResults_[static_cast<size_t>(i)]].reset(item);
+    }
+
+    for (auto index : results) {
+        auto it = previousItems.find(index);
+        if (it != previousItems.end()) {
+            rootItem_->addSubItem(it->second.release());
+        } else {
+            rootItem_->addSubItem(new PluginTreeItem(plugins_[index], *this));
+        }
+    }
+
+    shownResults_ = std::move(results);
 }
 
 void PluginBrowserContent::showPluginContextMenu(const PluginBrowserInfo& plugin,
@@ -615,6 +712,7 @@ void PluginBrowserContent::showPluginContextMenu(const PluginBrowserInfo& plugin
                     // - Option to add to first chain if racks exist
                     auto selectedTrack = tm.getSelectedTrack();
                     if (selectedTrack != magda::INVALID_TRACK_ID) {
+                        markRecentlyUsed(plugin);
                         tm.addDeviceToTrack(selectedTrack, createDevice());
                         DBG("Added device: " + plugin.name + " to track " +
                             juce::String(selectedTrack));
@@ -624,6 +722,7 @@ void PluginBrowserContent::showPluginContextMenu(const PluginBrowserInfo& plugin
                 case 2: {
                     // Add to selected chain
                     if (tm.hasSelectedChain()) {
+                        markRecentlyUsed(plugin);
                         tm.addDeviceToChain(tm.getSelectedChainTrackId(),
                                             tm.getSelectedChainRackId(), tm.getSelectedChainId(),
                                             createDevice());
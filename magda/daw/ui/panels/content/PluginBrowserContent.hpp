@@ -3,7 +3,12 @@
 #include <juce_audio_processors/juce_audio_processors.h>
 #include <juce_gui_basics/juce_gui_basics.h>
 
+#include <atomic>
+#include <memory>
+#include <vector>
+
 #include "PanelContent.hpp"
+#include "core/PluginSearchIndex.hpp"
 
 namespace magda {
 class TracktionEngineWrapper;
@@ -45,7 +50,7 @@ struct PluginBrowserInfo {
 class PluginBrowserContent : public PanelContent, public juce::TreeViewItem {
   public:
     PluginBrowserContent();
-    ~PluginBrowserContent() override = default;
+    ~PluginBrowserContent() override;
 
     PanelContentType getContentType() const override {
         return PanelContentType::PluginBrowser;
@@ -102,11 +107,27 @@ class PluginBrowserContent : public PanelContent, public juce::TreeViewItem {
     float scanProgress_ = 0.0f;
     bool isScanningPlugins_ = false;
 
+    // Search: the index is rebuilt when the plugin list changes and queried on
+    // searchPool_; results are applied to the tree on the message thread
+    static constexpr int MAX_SEARCH_RESULTS = 200;
+    static constexpr int MAX_RECENT_PLUGINS = 20;
+
+    std::shared_ptr<const magda::PluginSearchIndex> searchIndex_;
+    juce::ThreadPool searchPool_{1};
+    std::atomic<int> searchGeneration_{0};  // Bumped per query; stale results are dropped
+    juce::StringArray recentPlugins_;       // Search keys, most recently used first
+    bool showingSearchResults_ = false;
+    std::vector<uint32_t> shownResults_;  // plugins_ indices currently in the results tree
+
     // Tree building
     void buildInternalPluginList();
     void loadExternalPlugins();
     void rebuildTree();
+    void rebuildSearchIndex();
     void filterBySearch(const juce::String& searchText);
+    void showSearchResults(const std::vector<magda::PluginSearchIndex::Match>& matches);
+    void markRecentlyUsed(const PluginBrowserInfo& plugin);
+    static juce::String getSearchKey(const PluginBrowserInfo& plugin);
 
     // Plugin scanning
     void startPluginScan();
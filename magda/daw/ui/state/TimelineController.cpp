@@ -708,6 +708,10 @@ TimelineController::ChangeFlags TimelineController::handleEvent(const SetTimelin
 // ===== Notification Helpers =====
 
 void TimelineController::notifyListeners(ChangeFlags changes) {
+    // The playhead moves every frame during playback; listeners that don't handle it
+    // specifically still see it as a general change through playheadStateChanged()
+    bool playheadOnly = changes == ChangeFlags::Playhead;
+
     for (auto* listener : listeners) {
         // Call specific handlers first
         if (hasFlag(changes, ChangeFlags::Zoom) || hasFlag(changes, ChangeFlags::Scroll)) {
@@ -729,8 +733,9 @@ void TimelineController::notifyListeners(ChangeFlags changes) {
             listener->displayConfigChanged(state);
         }
 
-        // Always call the general handler
-        listener->timelineStateChanged(state);
+        if (!playheadOnly) {
+            listener->timelineStateChanged(state);
+        }
     }
 }
 
@@ -24,7 +24,8 @@ class TimelineStateListener {
 
     /**
      * Called when any part of the timeline state changes.
-     * This is always called after more specific notifications.
+     * This is called after more specific notifications, except when only the playhead
+     * moved: that goes to playheadStateChanged() alone, whose default forwards here.
      */
     virtual void timelineStateChanged(const TimelineState& state) = 0;
 
@@ -39,7 +40,7 @@ class TimelineStateListener {
 
     /**
      * Called specifically when playhead position changes.
-     * Override for optimized handling of frequent updates.
+     * Runs every display frame during playback; override to repaint only the playhead.
      */
     virtual void playheadStateChanged(const TimelineState& state) {
         // Default: fall through to general handler
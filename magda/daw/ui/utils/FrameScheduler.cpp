@@ -0,0 +1,195 @@
+#include "FrameScheduler.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace magda {
+
+// ============================================================================
+// FrameClient Implementation
+// ============================================================================
+
+FrameClient::~FrameClient() {
+    FrameScheduler::getInstance().unsubscribe(this);
+}
+
+void FrameClient::startAnimating(int framesPerSecond) {
+    FrameScheduler::getInstance().subscribe(this, framesPerSecond);
+}
+
+void FrameClient::stopAnimating() {
+    FrameScheduler::getInstance().unsubscribe(this);
+}
+
+bool FrameClient::isAnimating() const {
+    return FrameScheduler::getInstance().isSubscribed(this);
+}
+
+void FrameClient::setAnimating(bool shouldAnimate, int framesPerSecond) {
+    if (shouldAnimate && !isAnimating()) {
+        startAnimating(framesPerSecond);
+    } else if (!shouldAnimate && isAnimating()) {
+        stopAnimating();
+    }
+}
+
+// ============================================================================
+// FrameScheduler Implementation
+// ============================================================================
+
+FrameScheduler& FrameScheduler::getInstance() {
+    static FrameScheduler instance;
+    return instance;
+}
+
+FrameScheduler::FrameScheduler() : timer_(*this) {}
+
+FrameScheduler::~FrameScheduler() {
+    stopDriver();
+}
+
+void FrameScheduler::requestRepaint(juce::Component& component) {
+    auto alreadyDirty = std::any_of(dirty_.begin(), dirty_.end(), [&component](const auto& c) {
+        return c.getComponent() == &component;
+    });
+    if (!alreadyDirty) {
+        dirty_.emplace_back(&component);
+    }
+    startDriver();
+}
+
+void FrameScheduler::setDisplayComponent(juce::Component* component) {
+    displayComponent_ = component;
+
+    // Re-create the driver so frames follow the new display (or fall back to the timer)
+    if (isRunning()) {
+        stopDriver();
+        startDriver();
+    }
+}
+
+bool FrameScheduler::isRunning() const {
+    return vblank_ != nullptr || timer_.isTimerRunning();
+}
+
+void FrameScheduler::shutdown() {
+    stopDriver();
+    clients_.clear();
+    dirty_.clear();
+    displayComponent_ = nullptr;
+}
+
+void FrameScheduler::subscribe(FrameClient* client, int framesPerSecond) {
+    framesPerSecond = std::max(1, framesPerSecond);
+
+    auto it = std::find_if(clients_.begin(), clients_.end(),
+                           [client](const Subscription& s) { return s.client == client; });
+    if (it != clients_.end()) {
+        it->framesPerSecond = framesPerSecond;
+    } else {
+        clients_.push_back({client, framesPerSecond, -1});
+    }
+    startDriver();
+}
+
+void FrameScheduler::unsubscribe(FrameClient* client) {
+    for (auto& s : clients_) {
+        if (s.client == client) {
+            s.client = nullptr;
+        }
+    }
+
+    // Mid-frame the list is being iterated, so leave the empty slot for runFrame to sweep
+    if (!inFrame_) {
+        clients_.erase(std::remove_if(clients_.begin(), clients_.end(),
+                                      [](const Subscription& s) { return s.client == nullptr; }),
+                       clients_.end());
+        if (isIdle()) {
+            stopDriver();
+        }
+    }
+}
+
+bool FrameScheduler::isSubscribed(const FrameClient* client) const {
+    return std::any_of(clients_.begin(), clients_.end(),
+                       [client](const Subscription& s) { return s.client == client; });
+}
+
+void FrameScheduler::onFrame() {
+    runFrame(juce::Time::getMillisecondCounterHiRes() * 0.001);
+
+    if (!isIdle()) {
+        return;
+    }
+    timer_.stopTimer();
+
+    // The attachment can't be destroyed from inside its own callback; drop it afterwards
+    // unless something has started animating again in the meantime
+    if (vblank_ != nullptr) {
+        juce::MessageManager::callAsync([this]() {
+            if (isIdle()) {
+                stopDriver();
+            }
+        });
+    }
+}
+
+void FrameScheduler::runFrame(double timeSeconds) {
+    inFrame_ = true;
+
+    // A client is due when its frame slot changes, so clients at the same rate stay in step
+    // however the display rate and theirs divide. Index loop: ticks may subscribe others.
+    for (size_t i = 0; i < clients_.size(); ++i) {
+        auto* client = clients_[i].client;
+        if (client == nullptr) {
+            continue;
+        }
+
+        auto fps = clients_[i].framesPerSecond;
+        auto slot = static_cast<juce::int64>(std::floor(timeSeconds * fps));
+        if (slot == clients_[i].lastSlot) {
+            continue;
+        }
+        clients_[i].lastSlot = slot;
+        client->frameTick();
+    }
+
+    clients_.erase(std::remove_if(clients_.begin(), clients_.end(),
+                                  [](const Subscription& s) { return s.client == nullptr; }),
+                   clients_.end());
+
+    // One repaint per dirty component; anything marked dirty while repainting waits a frame
+    auto dirty = std::move(dirty_);
+    dirty_.clear();
+    for (auto& component : dirty) {
+        if (component != nullptr) {
+            component->repaint();
+        }
+    }
+
+    inFrame_ = false;
+}
+
+void FrameScheduler::startDriver() {
+    if (isRunning()) {
+        return;
+    }
+
+    if (displayComponent_ != nullptr && displayComponent_->getPeer() != nullptr) {
+        vblank_ = std::make_unique<juce::VBlankAttachment>(displayComponent_.getComponent(),
+                                                           [this]() { onFrame(); });
+    } else {
+        timer_.startTimerHz(60);
+    }
+}
+
+void FrameScheduler::stopDriver() {
+    vblank_.reset();
+    timer_.stopTimer();
+}
+
+bool FrameScheduler::isIdle() const {
+    return clients_.empty() && dirty_.empty();
+}
+
+}  // namespace magda
@@ -0,0 +1,141 @@
+#pragma once
+
+#include <juce_gui_basics/juce_gui_basics.h>
+
+#include <memory>
+#include <vector>
+
+namespace magda {
+
+class FrameScheduler;
+
+/**
+ * @brief Something that animates: receives frameTick() from the FrameScheduler
+ *
+ * Drop-in replacement for a private juce::Timer used to drive animation:
+ * startAnimating()/stopAnimating() instead of startTimer()/stopTimer(), frameTick()
+ * instead of timerCallback(). Ticks are aligned to the display's frames, so every
+ * client running at the same rate ticks on the same frame.
+ *
+ * Animate only while something on screen is changing and stop once it settles: the
+ * scheduler shuts its driver down when no client is subscribed.
+ */
+class FrameClient {
+  public:
+    virtual ~FrameClient();
+
+    /**
+     * @brief Called once per frame (at most framesPerSecond times a second) while animating
+     *
+     * Update state here and call FrameScheduler::requestRepaint() for anything that needs
+     * redrawing; the repaints are issued together once every client has ticked.
+     */
+    virtual void frameTick() = 0;
+
+  protected:
+    void startAnimating(int framesPerSecond = 30);
+    void stopAnimating();
+    bool isAnimating() const;
+
+    /**
+     * @brief Start or stop animating to match shouldAnimate; does nothing if it already does
+     */
+    void setAnimating(bool shouldAnimate, int framesPerSecond = 30);
+};
+
+/**
+ * @brief Single display-synchronised driver for all UI animation
+ *
+ * Replaces per-component timers: each frame it ticks the FrameClients that are due,
+ * then repaints every component marked dirty since the last frame in one pass. Frames
+ * come from the display's vertical blank once a window is attached
+ * (setDisplayComponent), and from a 60 Hz timer before that.
+ *
+ * When no client is animating and nothing is dirty the driver is torn down, so an idle
+ * UI costs nothing. Message thread only.
+ */
+class FrameScheduler {
+  public:
+    static FrameScheduler& getInstance();
+
+    ~FrameScheduler();
+
+    // Prevent copying
+    FrameScheduler(const FrameScheduler&) = delete;
+    FrameScheduler& operator=(const FrameScheduler&) = delete;
+
+    /**
+     * @brief Repaint a component on the next frame (several requests become one repaint)
+     */
+    void requestRepaint(juce::Component& component);
+
+    /**
+     * @brief Component whose display's vertical blank paces the frames (nullptr detaches)
+     */
+    void setDisplayComponent(juce::Component* component);
+
+    int getNumAnimatingClients() const {
+        return static_cast<int>(clients_.size());
+    }
+
+    bool isRunning() const;
+
+    /**
+     * @brief True when no client is animating and no repaint is pending
+     */
+    bool isIdle() const;
+
+    /**
+     * @brief Tick the clients due at the given time, then flush pending repaints
+     *
+     * The driver calls this once per frame; tests call it to step frames by hand.
+     */
+    void runFrame(double timeSeconds);
+
+    /**
+     * @brief Drop the driver and all subscriptions
+     * Call this during app shutdown, before JUCE cleanup begins
+     */
+    void shutdown();
+
+  private:
+    friend class FrameClient;
+
+    FrameScheduler();
+
+    struct Subscription {
+        FrameClient* client = nullptr;
+        int framesPerSecond = 30;
+        juce::int64 lastSlot = -1;
+    };
+
+    class FallbackTimer : public juce::Timer {
+      public:
+        explicit FallbackTimer(FrameScheduler& scheduler) : scheduler_(scheduler) {}
+
+        void timerCallback() override {
+            scheduler_.onFrame();
+        }
+
+      private:
+        FrameScheduler& scheduler_;
+    };
+
+    std::vector<Subscription> clients_;
+    std::vector<juce::Component::SafePointer<juce::Component>> dirty_;
+    bool inFrame_ = false;
+
+    juce::Component::SafePointer<juce::Component> displayComponent_;
+    std::unique_ptr<juce::VBlankAttachment> vblank_;
+    FallbackTimer timer_;
+
+    void subscribe(FrameClient* client, int framesPerSecond);
+    void unsubscribe(FrameClient* client);
+    bool isSubscribed(const FrameClient* client) const;
+
+    void onFrame();
+    void startDriver();
+    void stopDriver();
+};
+
+}  // namespace magda
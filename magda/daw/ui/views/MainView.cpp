@@ -354,8 +354,7 @@ void MainView::zoomStateChanged(const TimelineState& state) {
 
 void MainView::playheadStateChanged(const TimelineState& state) {
     playheadPosition = state.playhead.getPosition();
-    playheadComponent->setPlayheadPosition(playheadPosition);
-    playheadComponent->repaint();
+    playheadComponent->updateCursors();
 
     // Notify external listeners about playhead position change
     if (onPlayheadPositionChanged) {
@@ -990,26 +989,12 @@ MainView::PlayheadComponent::PlayheadComponent(MainView& owner) : owner(owner) {
 MainView::PlayheadComponent::~PlayheadComponent() = default;
 
 void MainView::PlayheadComponent::paint(juce::Graphics& g) {
-    const auto& state = owner.timelineController->getState();
-    int scrollOffset = owner.trackContentViewport->getViewPositionX();
-
-    // Get positions from state
-    double editPos = state.playhead.editPosition;
-    double playbackPos = state.playhead.playbackPosition;
-    bool isPlaying = state.playhead.isPlaying;
-
-    // Calculate edit cursor position in pixels (triangle position)
-    int editX =
-        static_cast<int>(editPos * owner.horizontalZoom) + LayoutConfig::TIMELINE_LEFT_PADDING;
-    editX -= scrollOffset;
-
-    // Calculate play cursor position in pixels (vertical line position)
-    int playX =
-        static_cast<int>(playbackPos * owner.horizontalZoom) + LayoutConfig::TIMELINE_LEFT_PADDING;
-    playX -= scrollOffset;
+    int editX = -1;
+    int playX = -1;
+    getCursorPositions(editX, playX);
 
     // Draw edit cursor (triangle) - always visible
-    if (editPos >= 0 && editPos <= owner.timelineLength && editX >= 0 && editX < getWidth()) {
+    if (editX >= 0) {
         g.setColour(DarkTheme::getColour(DarkTheme::ACCENT_BLUE));
         juce::Path triangle;
         triangle.addTriangle(editX - 6, 8, editX + 6, 8, editX, 20);
@@ -1017,13 +1002,15 @@ void MainView::PlayheadComponent::paint(juce::Graphics& g) {
     }
 
     // Draw play cursor (vertical line) - only during playback when position differs from edit
-    if (isPlaying && playbackPos >= 0 && playbackPos <= owner.timelineLength && playX >= 0 &&
-        playX < getWidth()) {
+    if (playX >= 0) {
         // Draw thin vertical line extending full height of track area
         g.setColour(DarkTheme::getColour(DarkTheme::ACCENT_BLUE));
         g.drawLine(static_cast<float>(playX), 20.0f, static_cast<float>(playX),
                    static_cast<float>(getHeight()), 1.5f);
     }
+
+    paintedEditX_ = editX;
+    paintedPlayX_ = playX;
 }
 
 void MainView::PlayheadComponent::setPlayheadPosition(double position) {
@@ -1031,6 +1018,60 @@ void MainView::PlayheadComponent::setPlayheadPosition(double position) {
     repaint();
 }
 
+void MainView::PlayheadComponent::updateCursors() {
+    int editX = -1;
+    int playX = -1;
+    getCursorPositions(editX, playX);
+
+    // Only the strips under the cursors that moved need repainting
+    if (editX != paintedEditX_) {
+        repaintEditCursor(paintedEditX_);
+        repaintEditCursor(editX);
+    }
+    if (playX != paintedPlayX_) {
+        repaintPlayCursor(paintedPlayX_);
+        repaintPlayCursor(playX);
+    }
+}
+
+void MainView::PlayheadComponent::getCursorPositions(int& editX, int& playX) const {
+    const auto& state = owner.timelineController->getState();
+    int scrollOffset = owner.trackContentViewport->getViewPositionX();
+
+    // Get positions from state
+    double editPos = state.playhead.editPosition;
+    double playbackPos = state.playhead.playbackPosition;
+    bool isPlaying = state.playhead.isPlaying;
+
+    // Calculate edit cursor position in pixels (triangle position)
+    editX = static_cast<int>(editPos * owner.horizontalZoom) + LayoutConfig::TIMELINE_LEFT_PADDING;
+    editX -= scrollOffset;
+    if (editPos < 0 || editPos > owner.timelineLength || editX < 0 || editX >= getWidth()) {
+        editX = -1;
+    }
+
+    // Calculate play cursor position in pixels (vertical line position)
+    playX =
+        static_cast<int>(playbackPos * owner.horizontalZoom) + LayoutConfig::TIMELINE_LEFT_PADDING;
+    playX -= scrollOffset;
+    if (!isPlaying || playbackPos < 0 || playbackPos > owner.timelineLength || playX < 0 ||
+        playX >= getWidth()) {
+        playX = -1;
+    }
+}
+
+void MainView::PlayheadComponent::repaintEditCursor(int x) {
+    if (x >= 0) {
+        repaint(x - 7, 0, 14, 21);
+    }
+}
+
+void MainView::PlayheadComponent::repaintPlayCursor(int x) {
+    if (x >= 0) {
+        repaint(x - 2, 20, 4, getHeight() - 20);
+    }
+}
+
 bool MainView::PlayheadComponent::hitTest([[maybe_unused]] int x, [[maybe_unused]] int y) {
     // Don't intercept mouse events - playhead is display-only (just a triangle)
     // Clicks pass through to timeline/tracks for time selection
@@ -243,6 +243,9 @@ class MainView::PlayheadComponent : public juce::Component {
     void paint(juce::Graphics& g) override;
     void setPlayheadPosition(double position);
 
+    // Repaint just the cursors that moved since they were last painted
+    void updateCursors();
+
     // Hit testing to only intercept clicks near the playhead
     bool hitTest(int x, int y) override;
 
@@ -259,6 +262,15 @@ class MainView::PlayheadComponent : public juce::Component {
     int dragStartX = 0;
     double dragStartPosition = 0.0;
 
+    // Cursor x positions as last painted (-1 = not drawn)
+    int paintedEditX_ = -1;
+    int paintedPlayX_ = -1;
+
+    // Pixel positions of the edit and play cursors (-1 when not shown)
+    void getCursorPositions(int& editX, int& playX) const;
+    void repaintEditCursor(int x);
+    void repaintPlayCursor(int x);
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(PlayheadComponent)
 };
 
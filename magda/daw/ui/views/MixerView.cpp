@@ -698,12 +698,13 @@ MixerView::MixerView(AudioEngine* audioEngine) : audioEngine_(audioEngine) {
     // debugPanel_->onMetricsChanged = [this]() { rebuildChannelStrips(); };
     // addAndMakeVisible(*debugPanel_);
 
-    // Start timer for meter animation (30fps)
-    startTimer(33);
+    // Meters animate at 30fps from the first sound, see changeListenerCallback()
+    setAudioEngine(audioEngine);
 }
 
 MixerView::~MixerView() {
-    stopTimer();
+    setAudioEngine(nullptr);
+    stopAnimating();
     TrackManager::getInstance().removeListener(this);
     ViewModeController::getInstance().removeListener(this);
 
@@ -821,20 +822,39 @@ void MixerView::resized() {
     }
 }
 
-void MixerView::timerCallback() {
-    // Read metering data from AudioBridge
-    if (!audioEngine_)
-        return;
+void MixerView::setAudioEngine(AudioEngine* audioEngine) {
+    if (meteredBridge_ != nullptr) {
+        meteredBridge_->getMeterActivity().removeChangeListener(this);
+    }
+    audioEngine_ = audioEngine;
+    meteredBridge_ = getAudioBridge();
+    if (meteredBridge_ != nullptr) {
+        meteredBridge_->getMeterActivity().addChangeListener(this);
+    }
+}
 
+AudioBridge* MixerView::getAudioBridge() const {
     auto* teWrapper = dynamic_cast<TracktionEngineWrapper*>(audioEngine_);
-    if (!teWrapper)
-        return;
+    return teWrapper != nullptr ? teWrapper->getAudioBridge() : nullptr;
+}
 
-    auto* bridge = teWrapper->getAudioBridge();
-    if (!bridge)
+void MixerView::changeListenerCallback(juce::ChangeBroadcaster* /*source*/) {
+    // Something is sounding: follow the meters until they fall silent again
+    if (isShowing()) {
+        setAnimating(true, 30);
+    }
+}
+
+void MixerView::frameTick() {
+    // Read metering data from AudioBridge
+    auto* bridge = getAudioBridge();
+    if (!bridge) {
+        stopAnimating();
         return;
+    }
 
     auto& meteringBuffer = bridge->getMeteringBuffer();
+    bool active = false;
 
     // Update channel strip meters
     for (auto& strip : channelStrips) {
@@ -843,6 +863,7 @@ void MixerView::timerCallback() {
         if (meteringBuffer.popLevels(trackId, data)) {
             // Use stereo peak levels
             strip->setMeterLevels(data.peakL, data.peakR);
+            active = active || data.peakL > 0.0f || data.peakR > 0.0f;
         }
     }
 
@@ -851,6 +872,12 @@ void MixerView::timerCallback() {
         float masterPeakL = bridge->getMasterPeakL();
         float masterPeakR = bridge->getMasterPeakR();
         masterStrip->setPeakLevels(masterPeakL, masterPeakR);
+        active = active || masterPeakL > 0.0f || masterPeakR > 0.0f;
+    }
+
+    // Silence has been drawn; the next meter activity message starts the meters again
+    if (!active || !isShowing()) {
+        stopAnimating();
     }
 }
 
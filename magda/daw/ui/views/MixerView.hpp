@@ -11,12 +11,14 @@
 #include "../components/mixer/RoutingSelector.hpp"
 #include "../themes/MixerLookAndFeel.hpp"
 #include "../themes/MixerMetrics.hpp"
+#include "../utils/FrameScheduler.hpp"
 #include "core/TrackManager.hpp"
 #include "core/ViewModeController.hpp"
 
 namespace magda {
 
 // Forward declarations
+class AudioBridge;
 class AudioEngine;
 
 /**
@@ -28,16 +30,15 @@ class AudioEngine;
  * - Master channel on the right
  */
 class MixerView : public juce::Component,
-                  public juce::Timer,
+                  public FrameClient,
                   public TrackManagerListener,
-                  public ViewModeListener {
+                  public ViewModeListener,
+                  private juce::ChangeListener {
   public:
     explicit MixerView(AudioEngine* audioEngine = nullptr);
     ~MixerView() override;
 
-    void setAudioEngine(AudioEngine* audioEngine) {
-        audioEngine_ = audioEngine;
-    }
+    void setAudioEngine(AudioEngine* audioEngine);
 
     void paint(juce::Graphics& g) override;
     void resized() override;
@@ -47,8 +48,8 @@ class MixerView : public juce::Component,
     void mouseDrag(const juce::MouseEvent& event) override;
     void mouseUp(const juce::MouseEvent& event) override;
 
-    // Timer callback for meter animation
-    void timerCallback() override;
+    // Frame callback for meter animation (runs only while some meter is above silence)
+    void frameTick() override;
 
     // TrackManagerListener
     void tracksChanged() override;
@@ -206,6 +207,10 @@ class MixerView : public juce::Component,
 
     // Audio engine for metering
     AudioEngine* audioEngine_ = nullptr;
+    AudioBridge* meteredBridge_ = nullptr;  // Whose meter activity wakes the meters
+
+    AudioBridge* getAudioBridge() const;
+    void changeListenerCallback(juce::ChangeBroadcaster* source) override;
 
     bool isInChannelResizeZone(const juce::Point<int>& pos) const;
 
@@ -399,7 +399,7 @@ void SessionView::onClipSlotClicked(int trackIndex, int sceneIndex) {
     if (clipId != INVALID_CLIP_ID) {
         // Toggle playback
         const auto* clip = ClipManager::getInstance().getClip(clipId);
-        if (clip && clip->isPlaying) {
+        if (clip && (clip->isPlaying || clip->isQueued)) {
             ClipManager::getInstance().stopClip(clipId);
         } else {
             ClipManager::getInstance().triggerClip(clipId);
@@ -537,7 +537,13 @@ void SessionView::updateClipSlotAppearance(int trackIndex, int sceneIndex) {
             slot->setButtonText(clip->name);
 
             // Set color based on clip state
-            if (clip->isPlaying) {
+            if (clip->isQueued) {
+                // Waiting for its launch boundary: orange
+                slot->setColour(juce::TextButton::buttonColourId,
+                                DarkTheme::getColour(DarkTheme::STATUS_WARNING));
+                slot->setColour(juce::TextButton::textColourOffId,
+                                DarkTheme::getColour(DarkTheme::BACKGROUND));
+            } else if (clip->isPlaying) {
                 // Playing: bright green
                 slot->setColour(juce::TextButton::buttonColourId,
                                 DarkTheme::getColour(DarkTheme::STATUS_SUCCESS));
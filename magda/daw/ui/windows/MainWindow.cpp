@@ -16,13 +16,16 @@
 #include "../state/TimelineController.hpp"
 #include "../state/TimelineEvents.hpp"
 #include "../themes/DarkTheme.hpp"
+#include "../utils/FrameScheduler.hpp"
 #include "../views/MainView.hpp"
 #include "../views/MixerView.hpp"
 #include "../views/SessionView.hpp"
 #include "audio/AudioBridge.hpp"
+#include "audio/AudioThumbnailManager.hpp"
 #include "core/Config.hpp"
 #include "core/LinkModeManager.hpp"
 #include "core/ModulatorEngine.hpp"
+#include "core/ProjectFile.hpp"
 #include "core/TrackCommands.hpp"
 #include "core/TrackManager.hpp"
 #include "core/UndoManager.hpp"
@@ -181,14 +184,26 @@ MainWindow::MainWindow(AudioEngine* audioEngine)
     centreWithSize(getWidth(), getHeight());
     setVisible(true);
 
+    // Pace UI animation by this window's display refresh
+    magda::FrameScheduler::getInstance().setDisplayComponent(this);
+
     // Start modulation engine at 60 FPS (updates LFO values in background)
     magda::ModulatorEngine::getInstance().startTimer(16);
+
+    // Offer to restore an untitled session that did not shut down cleanly
+    recoverOrStartJournal(projectFile_);
 }
 
 MainWindow::~MainWindow() {
     std::cout << "  [5a] MainWindow::~MainWindow start" << std::endl;
     std::cout.flush();
 
+    magda::FrameScheduler::getInstance().setDisplayComponent(nullptr);
+
+    // Clean shutdown: nothing to recover next time
+    journal_.reset();
+    ProjectJournal::discardRecoveryData(projectFile_);
+
 #if JUCE_DEBUG
     // Print profiling report if enabled, then shutdown to clear JUCE objects
     auto& monitor = magda::PerformanceMonitor::getInstance();
@@ -837,24 +852,16 @@ void MainWindow::setupMenuCallbacks() {
                                                "New project functionality not yet implemented.");
     };
 
-    callbacks.onOpenProject = [this]() {
-        // TODO: Implement open project
-        juce::AlertWindow::showMessageBoxAsync(juce::AlertWindow::InfoIcon, "Open Project",
-                                               "Open project functionality not yet implemented.");
-    };
+    callbacks.onOpenProject = [this]() { chooseProjectFile(false); };
 
     callbacks.onSaveProject = [this]() {
-        // TODO: Implement save project
-        juce::AlertWindow::showMessageBoxAsync(juce::AlertWindow::InfoIcon, "Save Project",
-                                               "Save project functionality not yet implemented.");
+        if (projectFile_ == juce::File())
+            chooseProjectFile(true);
+        else
+            saveProject(projectFile_);
     };
 
-    callbacks.onSaveProjectAs = [this]() {
-        // TODO: Implement save project as
-        juce::AlertWindow::showMessageBoxAsync(
-            juce::AlertWindow::InfoIcon, "Save Project As",
-            "Save project as functionality not yet implemented.");
-    };
+    callbacks.onSaveProjectAs = [this]() { chooseProjectFile(true); };
 
     callbacks.onImportAudio = [this]() {
         if (!mainComponent)
@@ -1276,4 +1283,166 @@ void MainWindow::setupMenuCallbacks() {
     MenuManager::getInstance().initialize(callbacks);
 }
 
+// ============================================================================
+// Project persistence
+// ============================================================================
+
+void MainWindow::chooseProjectFile(bool forSaving) {
+    // Prevent re-entry while a file chooser is already open
+    if (fileChooser_ != nullptr)
+        return;
+
+    auto startLocation = projectFile_ != juce::File()
+                             ? projectFile_
+                             : juce::File::getSpecialLocation(juce::File::userDocumentsDirectory);
+    fileChooser_ = std::make_unique<juce::FileChooser>(
+        forSaving ? "Save Project" : "Open Project", startLocation,
+        juce::String("*") + ProjectFile::FILE_EXTENSION, true, false);
+
+    auto flags = forSaving ? juce::FileBrowserComponent::saveMode |
+                                 juce::FileBrowserComponent::warnAboutOverwriting
+                           : juce::FileBrowserComponent::openMode |
+                                 juce::FileBrowserComponent::canSelectFiles;
+
+    fileChooser_->launchAsync(flags, [this, forSaving](const juce::FileChooser& chooser) {
+        auto file = chooser.getResult();
+        fileChooser_.reset();
+        if (file == juce::File())
+            return;  // User cancelled
+
+        if (forSaving)
+            saveProject(file.withFileExtension(ProjectFile::FILE_EXTENSION));
+        else
+            openProject(file);
+    });
+}
+
+void MainWindow::saveProject(const juce::File& file) {
+    HighResTimer timer;
+
+    auto data = ProjectFile::capture();
+    data.pluginStates = capturePluginStates();
+
+    if (!ProjectFile::write(file, data)) {
+        juce::AlertWindow::showMessageBoxAsync(juce::AlertWindow::WarningIcon, "Save Project",
+                                               "Could not write " + file.getFullPathName());
+        return;
+    }
+
+    auto previousFile = projectFile_;
+    projectFile_ = file;
+    AudioThumbnailManager::getInstance().setPeakDirectory(
+        AudioThumbnailManager::getProjectPeakDirectory(file));
+
+    // The saved file is the new recovery base
+    if (journal_ && previousFile == file) {
+        journal_->markSaved();
+    } else {
+        journal_.reset();
+        ProjectJournal::discardRecoveryData(previousFile);
+        startJournal(ProjectJournal::Base::ProjectFile);
+    }
+
+    PerformanceMonitor::getInstance().addSample("ProjectSave", timer.elapsedMilliseconds());
+    std::cout << "Project saved to: " << file.getFullPathName() << std::endl;
+}
+
+void MainWindow::openProject(const juce::File& file) {
+    HighResTimer timer;
+
+    auto project = ProjectFile::open(file);
+    ProjectData data;
+    if (!project || !project->read(data)) {
+        juce::AlertWindow::showMessageBoxAsync(juce::AlertWindow::WarningIcon, "Open Project",
+                                               file.getFileName() +
+                                                   " is not a valid MAGDA project.");
+        return;
+    }
+
+    for (auto deviceId : project->getPluginStateDevices())
+        data.pluginStates[deviceId] = project->getPluginState(deviceId);
+
+    // Leave the previous session's journal behind before switching files
+    journal_.reset();
+    ProjectJournal::discardRecoveryData(projectFile_);
+
+    // Peaks stored with the project are found before any clip paints
+    AudioThumbnailManager::getInstance().setPeakDirectory(
+        AudioThumbnailManager::getProjectPeakDirectory(file));
+    loadProjectData(std::move(data));
+    projectFile_ = file;
+    PerformanceMonitor::getInstance().addSample("ProjectLoad", timer.elapsedMilliseconds());
+    std::cout << "Project loaded from: " << file.getFullPathName() << std::endl;
+
+    recoverOrStartJournal(file);
+}
+
+void MainWindow::loadProjectData(ProjectData data) {
+    // The loaded IDs start from 1 again, so the previous session's engine tracks and
+    // plugins go first. Plugin states are applied by the bridge as each plugin finishes
+    // loading
+    if (mainComponent) {
+        if (auto* engine = dynamic_cast<TracktionEngineWrapper*>(mainComponent->getAudioEngine())) {
+            if (auto* bridge = engine->getAudioBridge()) {
+                bridge->clearEngineState();
+                for (auto& [deviceId, state] : data.pluginStates)
+                    bridge->setPendingPluginState(deviceId, std::move(state));
+            }
+        }
+    }
+
+    UndoManager::getInstance().clearHistory();
+    ProjectFile::apply(std::move(data));
+}
+
+std::map<DeviceId, juce::MemoryBlock> MainWindow::capturePluginStates() {
+    if (mainComponent) {
+        if (auto* engine = dynamic_cast<TracktionEngineWrapper*>(mainComponent->getAudioEngine())) {
+            if (auto* bridge = engine->getAudioBridge())
+                return bridge->getPluginStates();
+        }
+    }
+    return {};
+}
+
+// ============================================================================
+// Autosave journal
+// ============================================================================
+
+void MainWindow::startJournal(ProjectJournal::Base base) {
+    journal_ = std::make_unique<ProjectJournal>(projectFile_, base,
+                                                [this]() { return capturePluginStates(); });
+}
+
+void MainWindow::recoverOrStartJournal(const juce::File& file) {
+    if (!ProjectJournal::hasRecoveryData(file)) {
+        startJournal(ProjectJournal::Base::ProjectFile);
+        return;
+    }
+
+    auto name = file == juce::File() ? juce::String("the untitled session") : file.getFileName();
+    auto options = juce::MessageBoxOptions()
+                       .withTitle("Recover Session")
+                       .withMessage("MAGDA did not shut down cleanly while editing " + name +
+                                    ".\n\nRecover the unsaved changes?")
+                       .withButton("Recover")
+                       .withButton("Discard")
+                       .withIconType(juce::MessageBoxIconType::QuestionIcon);
+
+    juce::AlertWindow::showAsync(options, [this, file](int result) {
+        if (file != projectFile_)
+            return;  // Another project was opened meanwhile
+
+        ProjectData data;
+        if (result == 1 && ProjectJournal::recover(file, data)) {
+            loadProjectData(std::move(data));
+            startJournal(ProjectJournal::Base::Snapshot);
+            return;
+        }
+
+        ProjectJournal::discardRecoveryData(file);
+        startJournal(ProjectJournal::Base::ProjectFile);
+    });
+}
+
 }  // namespace magda
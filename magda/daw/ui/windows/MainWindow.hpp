@@ -2,10 +2,12 @@
 
 #include <juce_gui_basics/juce_gui_basics.h>
 
+#include <map>
 #include <memory>
 
 #include "../layout/LayoutConfig.hpp"
 #include "MenuManager.hpp"
+#include "core/ProjectJournal.hpp"
 #include "core/ViewModeController.hpp"
 #include "core/ViewModeState.hpp"
 
@@ -41,9 +43,26 @@ class MainWindow : public juce::DocumentWindow {
     // File chooser for async file import
     std::unique_ptr<juce::FileChooser> fileChooser_;
 
+    // Current project file (empty until saved or opened)
+    juce::File projectFile_;
+
+    // Crash-recovery journal for the current session
+    std::unique_ptr<ProjectJournal> journal_;
+
     void setupMenuBar();
     void setupMenuCallbacks();
 
+    // Project persistence
+    void openProject(const juce::File& file);
+    void saveProject(const juce::File& file);
+    void chooseProjectFile(bool forSaving);
+    void loadProjectData(ProjectData data);
+    std::map<DeviceId, juce::MemoryBlock> capturePluginStates();
+
+    // Autosave journal
+    void startJournal(ProjectJournal::Base base);
+    void recoverOrStartJournal(const juce::File& file);
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(MainWindow)
 };
 
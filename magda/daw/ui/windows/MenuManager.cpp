@@ -1,5 +1,6 @@
 #include "MenuManager.hpp"
 
+#include "../../profiling/PerformanceProfiler.hpp"
 #include "Config.hpp"
 #include "core/UndoManager.hpp"
 
@@ -19,6 +20,17 @@ MenuManager::~MenuManager() {
     UndoManager::getInstance().removeListener(this);
 }
 
+void MenuManager::undoStateChanged() {
+    // Force menu to rebuild when undo state changes
+    menuItemsChanged();
+
+    auto& monitor = PerformanceMonitor::getInstance();
+    if (monitor.isEnabled()) {
+        monitor.setGauge("UndoMemoryBytes",
+                         static_cast<double>(UndoManager::getInstance().getUndoMemoryUsage()));
+    }
+}
+
 void MenuManager::initialize(const MenuCallbacks& callbacks) {
     callbacks_ = callbacks;
 }
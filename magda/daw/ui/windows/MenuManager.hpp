@@ -92,10 +92,7 @@ class MenuManager : public juce::MenuBarModel, public UndoManagerListener {
     }
 
     // UndoManagerListener
-    void undoStateChanged() override {
-        // Force menu to rebuild when undo state changes
-        menuItemsChanged();
-    }
+    void undoStateChanged() override;
 
   private:
     MenuManager();
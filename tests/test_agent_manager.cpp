@@ -0,0 +1,263 @@
+#include <juce_core/juce_core.h>
+
+#include <catch2/catch_test_macros.hpp>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "../magda/agents/agent_mailbox.hpp"
+#include "../magda/agents/agent_manager.hpp"
+
+namespace {
+
+using namespace std::chrono_literals;
+
+/**
+ * Agent that echoes messages, holding each one until the test opens its gate
+ */
+class GatedAgent : public AgentInterface {
+  public:
+    explicit GatedAgent(std::string id, bool open = true) : id_(std::move(id)), open_(open) {}
+
+    std::string getId() const override {
+        return id_;
+    }
+    std::string getName() const override {
+        return id_;
+    }
+    std::string getType() const override {
+        return "test";
+    }
+    std::map<std::string, std::string> getCapabilities() const override {
+        return {};
+    }
+
+    bool start() override {
+        running_ = true;
+        return true;
+    }
+    void stop() override {
+        running_ = false;
+    }
+    bool isRunning() const override {
+        return running_;
+    }
+
+    std::string processMessage(const std::string& message) override {
+        std::unique_lock<std::mutex> lock(mutex_);
+        ++entered_;
+        changed_.notify_all();
+        changed_.wait(lock, [this] { return open_; });
+        received_.push_back(message);
+        return id_ + ":" + message;
+    }
+    void setMessageCallback(
+        std::function<void(const std::string&, const std::string&)>) override {}
+
+    void open() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        open_ = true;
+        changed_.notify_all();
+    }
+
+    // Wait until processMessage() has been entered the given number of times
+    bool waitForEntered(int count) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        return changed_.wait_for(lock, 5s, [this, count] { return entered_ >= count; });
+    }
+
+    std::vector<std::string> getReceived() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return received_;
+    }
+
+  private:
+    std::string id_;
+    std::atomic<bool> running_{false};
+    std::mutex mutex_;
+    std::condition_variable changed_;
+    bool open_;
+    int entered_ = 0;
+    std::vector<std::string> received_;
+};
+
+bool isReady(std::future<std::string>& future) {
+    return future.wait_for(5s) == std::future_status::ready;
+}
+
+}  // namespace
+
+TEST_CASE("AgentMailbox - Bounded FIFO", "[agents]") {
+    AgentMailbox<int> mailbox(3);
+    REQUIRE(mailbox.capacity() == 4);
+    REQUIRE(mailbox.isEmpty());
+
+    for (int i = 0; i < 4; ++i) {
+        REQUIRE(mailbox.push(i));
+    }
+    int extra = 99;
+    REQUIRE_FALSE(mailbox.push(extra));
+    REQUIRE(mailbox.size() == 4);
+
+    int value = -1;
+    for (int i = 0; i < 4; ++i) {
+        REQUIRE(mailbox.pop(value));
+        REQUIRE(value == i);
+    }
+    REQUIRE_FALSE(mailbox.pop(value));
+    REQUIRE(mailbox.isEmpty());
+}
+
+TEST_CASE("AgentMailbox - Concurrent senders", "[agents]") {
+    constexpr int kSenders = 4;
+    constexpr int kPerSender = 10000;
+    AgentMailbox<int> mailbox(64);
+
+    std::vector<std::thread> senders;
+    for (int s = 0; s < kSenders; ++s) {
+        senders.emplace_back([&mailbox, s] {
+            for (int i = 0; i < kPerSender; ++i) {
+                int value = s * kPerSender + i;
+                while (!mailbox.push(value)) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    // Each sender's messages arrive in the order it sent them
+    std::vector<int> next(kSenders, 0);
+    int received = 0;
+    while (received < kSenders * kPerSender) {
+        int value = 0;
+        if (!mailbox.pop(value)) {
+            std::this_thread::yield();
+            continue;
+        }
+        int sender = value / kPerSender;
+        REQUIRE(value % kPerSender == next[static_cast<size_t>(sender)]++);
+        ++received;
+    }
+
+    for (auto& sender : senders) {
+        sender.join();
+    }
+    REQUIRE(mailbox.isEmpty());
+}
+
+TEST_CASE("AgentManager - Posting", "[agents]") {
+    AgentManager manager(2, 4);
+    auto agent = std::make_shared<GatedAgent>("echo");
+    REQUIRE(manager.registerAgent(agent));
+
+    SECTION("Replies arrive through the future") {
+        auto request = manager.postToAgent("echo", "hello");
+        REQUIRE(request.isAccepted());
+        REQUIRE(isReady(request.reply));
+        REQUIRE(request.reply.get() == "echo:hello");
+        REQUIRE(manager.sendToAgent("echo", "again") == "echo:again");
+    }
+
+    SECTION("Messages are processed in order") {
+        std::vector<AgentRequest> requests;
+        for (int i = 0; i < 4; ++i) {
+            requests.push_back(manager.postToAgent("echo", std::to_string(i)));
+        }
+        for (auto& request : requests) {
+            REQUIRE(isReady(request.reply));
+        }
+        REQUIRE(agent->getReceived() == std::vector<std::string>{"0", "1", "2", "3"});
+    }
+
+    SECTION("Unknown and stopped agents refuse messages") {
+        REQUIRE(manager.postToAgent("missing", "x").status ==
+                AgentRequest::Status::UnknownAgent);
+        REQUIRE(manager.sendToAgent("missing", "x").empty());
+
+        agent->stop();
+        REQUIRE(manager.postToAgent("echo", "x").status == AgentRequest::Status::NotRunning);
+        REQUIRE(manager.broadcastMessage("x") == 0);
+    }
+}
+
+TEST_CASE("AgentManager - A busy agent doesn't hold up others", "[agents]") {
+    AgentManager manager(2, 2);
+    auto slow = std::make_shared<GatedAgent>("slow", false);
+    auto fast = std::make_shared<GatedAgent>("fast");
+    REQUIRE(manager.registerAgent(slow));
+    REQUIRE(manager.registerAgent(fast));
+
+    auto blocked = manager.postToAgent("slow", "first");
+    REQUIRE(slow->waitForEntered(1));
+
+    SECTION("Other agents keep replying") {
+        auto request = manager.postToAgent("fast", "ping");
+        REQUIRE(isReady(request.reply));
+        REQUIRE(request.reply.get() == "fast:ping");
+        REQUIRE(blocked.reply.wait_for(0s) == std::future_status::timeout);
+    }
+
+    SECTION("A full mailbox pushes back on the sender") {
+        auto second = manager.postToAgent("slow", "second");
+        auto third = manager.postToAgent("slow", "third");
+        REQUIRE(second.isAccepted());
+        REQUIRE(third.isAccepted());
+
+        auto refused = manager.postToAgent("slow", "fourth");
+        REQUIRE(refused.status == AgentRequest::Status::MailboxFull);
+        REQUIRE(manager.broadcastMessage("all") == 1);
+
+        auto metrics = manager.getAgentMetrics("slow");
+        REQUIRE(metrics.queueDepth == 2);
+        REQUIRE(metrics.mailboxCapacity == 2);
+        REQUIRE(metrics.rejected == 2);
+
+        slow->open();
+        REQUIRE(isReady(third.reply));
+    }
+
+    SECTION("Cancelled messages are dropped unprocessed") {
+        auto cancelled = manager.postToAgent("slow", "cancel me");
+        auto kept = manager.postToAgent("slow", "keep me");
+        cancelled.cancel();
+
+        slow->open();
+        REQUIRE(isReady(cancelled.reply));
+        REQUIRE(cancelled.reply.get().empty());
+        REQUIRE(isReady(kept.reply));
+        REQUIRE(slow->getReceived() == std::vector<std::string>{"first", "keep me"});
+        REQUIRE(manager.getAgentMetrics("slow").cancelled == 1);
+    }
+
+    SECTION("Unregistering cancels waiting messages") {
+        auto waiting = manager.postToAgent("slow", "waiting");
+        REQUIRE(manager.unregisterAgent("slow"));
+
+        slow->open();
+        REQUIRE(isReady(waiting.reply));
+        REQUIRE(waiting.reply.get().empty());
+        REQUIRE(slow->getReceived() == std::vector<std::string>{"first"});
+    }
+
+    slow->open();
+    REQUIRE(isReady(blocked.reply));
+}
+
+TEST_CASE("AgentManager - Metrics", "[agents]") {
+    AgentManager manager(1, 8);
+    REQUIRE(manager.registerAgent(std::make_shared<GatedAgent>("echo")));
+
+    for (int i = 0; i < 3; ++i) {
+        REQUIRE(manager.sendToAgent("echo", "x") == "echo:x");
+    }
+
+    auto metrics = manager.getAgentMetrics("echo");
+    REQUIRE(metrics.processed == 3);
+    REQUIRE(metrics.queueDepth == 0);
+    REQUIRE(metrics.averageWaitMs >= 0.0);
+    REQUIRE(metrics.maxProcessMs >= metrics.averageProcessMs);
+
+    REQUIRE(manager.getAgentMetrics("missing").processed == 0);
+}
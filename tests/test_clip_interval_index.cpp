@@ -0,0 +1,155 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <random>
+
+#include "../magda/daw/core/ClipIntervalIndex.hpp"
+#include "../magda/daw/core/ClipManager.hpp"
+
+using namespace magda;
+
+namespace {
+
+// Reference answer: every entry, checked one by one, in start order
+std::vector<ClipId> linearQuery(std::vector<ClipIntervalIndex::Entry> entries, double startTime,
+                                double endTime) {
+    std::sort(entries.begin(), entries.end(), [](const auto& a, const auto& b) {
+        return a.startTime != b.startTime ? a.startTime < b.startTime : a.clipId < b.clipId;
+    });
+    std::vector<ClipId> results;
+    for (const auto& entry : entries) {
+        if (entry.startTime < endTime && entry.endTime > startTime) {
+            results.push_back(entry.clipId);
+        }
+    }
+    return results;
+}
+
+}  // namespace
+
+TEST_CASE("ClipIntervalIndex - Overlap queries", "[clips][index]") {
+    ClipIntervalIndex index;
+    index.insert({4.0, 6.0, 3});
+    index.insert({0.0, 2.0, 1});
+    index.insert({0.0, 64.0, 2});  // long clip under everything
+    index.insert({8.0, 9.0, 4});
+
+    std::vector<ClipId> results;
+
+    SECTION("Entries stay ordered by start time") {
+        std::vector<ClipId> order;
+        for (const auto& entry : index.getEntries()) {
+            order.push_back(entry.clipId);
+        }
+        REQUIRE(order == std::vector<ClipId>({1, 2, 3, 4}));
+    }
+
+    SECTION("Ranges are half-open") {
+        index.getOverlapping(2.0, 4.0, results);
+        REQUIRE(results == std::vector<ClipId>({2}));
+
+        index.getOverlapping(1.0, 5.0, results);
+        REQUIRE(results == std::vector<ClipId>({1, 2, 3}));
+    }
+
+    SECTION("Point queries include the start and exclude the end") {
+        index.getAt(4.0, results);
+        REQUIRE(results == std::vector<ClipId>({2, 3}));
+
+        index.getAt(6.0, results);
+        REQUIRE(results == std::vector<ClipId>({2}));
+    }
+
+    SECTION("Removed clips are no longer found") {
+        REQUIRE(index.remove(2, 0.0));
+        REQUIRE_FALSE(index.remove(2, 0.0));
+        index.getOverlapping(40.0, 41.0, results);
+        REQUIRE(results.empty());
+        REQUIRE(index.size() == 3);
+    }
+}
+
+TEST_CASE("ClipIntervalIndex - Matches a linear scan under edits", "[clips][index]") {
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<double> start(0.0, 10000.0);
+    std::uniform_real_distribution<double> length(0.5, 32.0);
+
+    std::vector<ClipIntervalIndex::Entry> entries;
+    for (ClipId id = 1; id <= 20000; ++id) {
+        double clipStart = start(rng);
+        double clipLength = id % 500 == 0 ? 2000.0 : length(rng);
+        entries.push_back({clipStart, clipStart + clipLength, id});
+    }
+
+    ClipIntervalIndex index;
+    index.build(entries);
+
+    // Move some clips, as a drag would
+    for (size_t i = 0; i < entries.size(); i += 97) {
+        auto& entry = entries[i];
+        REQUIRE(index.remove(entry.clipId, entry.startTime));
+        double clipLength = entry.endTime - entry.startTime;
+        entry.startTime = start(rng);
+        entry.endTime = entry.startTime + clipLength;
+        index.insert(entry);
+    }
+
+    std::vector<ClipId> results;
+    for (int i = 0; i < 50; ++i) {
+        double queryStart = start(rng);
+        double queryEnd = queryStart + 64.0;
+        index.getOverlapping(queryStart, queryEnd, results);
+        REQUIRE(results == linearQuery(entries, queryStart, queryEnd));
+    }
+}
+
+TEST_CASE("ClipManager - Track queries follow clip edits", "[clips][index]") {
+    auto& clipManager = ClipManager::getInstance();
+    clipManager.clearAllClips();
+
+    ClipId a = clipManager.createMidiClip(1, 4.0, 4.0);
+    ClipId b = clipManager.createMidiClip(1, 0.0, 2.0);
+    ClipId c = clipManager.createMidiClip(2, 0.0, 8.0);
+
+    REQUIRE(clipManager.getClipsOnTrack(1) == std::vector<ClipId>({b, a}));
+    REQUIRE(clipManager.getClipAtPosition(1, 5.0) == a);
+    REQUIRE(clipManager.getClipAtPosition(1, 3.0) == INVALID_CLIP_ID);
+
+    SECTION("Move within a track") {
+        clipManager.moveClip(a, 1.0);
+        REQUIRE(clipManager.getClipsOnTrack(1) == std::vector<ClipId>({b, a}));
+        REQUIRE(clipManager.getClipAtPosition(1, 3.0) == a);
+        REQUIRE(clipManager.getClipAtPosition(1, 5.5) == INVALID_CLIP_ID);
+    }
+
+    SECTION("Move to another track") {
+        clipManager.moveClipToTrack(a, 2);
+        REQUIRE(clipManager.getClipsOnTrack(1) == std::vector<ClipId>({b}));
+        REQUIRE(clipManager.getClipsInRange(2, 4.0, 5.0) == std::vector<ClipId>({c, a}));
+    }
+
+    SECTION("Resize and split") {
+        clipManager.resizeClip(b, 6.0);
+        REQUIRE(clipManager.getClipsInRange(1, 5.0, 5.5) == std::vector<ClipId>({b, a}));
+
+        ClipId right = clipManager.splitClip(a, 6.0);
+        REQUIRE(clipManager.getClipAtPosition(1, 7.0) == right);
+        REQUIRE(clipManager.getClipsOnTrack(1) == std::vector<ClipId>({b, a, right}));
+    }
+
+    SECTION("Delete") {
+        clipManager.deleteClip(b);
+        REQUIRE(clipManager.getClip(b) == nullptr);
+        REQUIRE(clipManager.getClip(c) != nullptr);
+        REQUIRE(clipManager.getClipsOnTrack(1) == std::vector<ClipId>({a}));
+    }
+
+    SECTION("Direct edits are picked up on notification") {
+        clipManager.getClip(c)->startTime = 20.0;
+        clipManager.forceNotifyClipPropertyChanged(c);
+        REQUIRE(clipManager.getClipAtPosition(2, 1.0) == INVALID_CLIP_ID);
+        REQUIRE(clipManager.getClipAtPosition(2, 21.0) == c);
+    }
+
+    clipManager.clearAllClips();
+}
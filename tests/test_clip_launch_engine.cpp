@@ -0,0 +1,270 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <vector>
+
+#include "../magda/daw/audio/ClipLaunchEngine.hpp"
+
+using namespace magda;
+
+namespace {
+
+using Event = ClipLaunchEngine::Event;
+
+// 120 BPM at 48 kHz: 24000 samples per beat, 96000 per 4/4 bar
+constexpr double kSampleRate = 48000.0;
+constexpr juce::int64 kSamplesPerBeat = 24000;
+constexpr juce::int64 kSamplesPerBar = 96000;
+
+std::unique_ptr<ClipLaunchEngine::TempoMap> makeTempoMap(
+    std::vector<ClipLaunchEngine::TempoSegment> segments = {}) {
+    return std::make_unique<ClipLaunchEngine::TempoMap>(kSampleRate, std::move(segments));
+}
+
+void run(ClipLaunchEngine& engine, juce::int64 numSamples, int blockSize) {
+    for (juce::int64 done = 0; done < numSamples; done += blockSize) {
+        engine.process(blockSize, true);
+    }
+}
+
+// Process whole blocks for as long as they end at or before the given sample
+void runUntil(ClipLaunchEngine& engine, juce::int64 sample, int blockSize) {
+    while (engine.getPosition() + blockSize <= sample) {
+        engine.process(blockSize, true);
+    }
+}
+
+std::vector<Event> takeEvents(ClipLaunchEngine& engine) {
+    std::vector<Event> events;
+    engine.dispatchEvents([&events](const Event& event) { events.push_back(event); });
+    return events;
+}
+
+}  // namespace
+
+TEST_CASE("ClipLaunchEngine - Tempo map boundaries", "[audio][launch]") {
+    SECTION("Constant tempo") {
+        auto map = makeTempoMap();
+        REQUIRE(map->sampleAtBeat(4.0) == kSamplesPerBar);
+        REQUIRE(map->beatAtSample(kSamplesPerBeat) == 1.0);
+
+        REQUIRE(map->getNextBoundary(0.0, LaunchQuantization::Bar) == 0.0);
+        REQUIRE(map->getNextBoundary(0.1, LaunchQuantization::Bar) == 4.0);
+        REQUIRE(map->getNextBoundary(4.0, LaunchQuantization::Bar) == 4.0);
+        REQUIRE(map->getNextBoundary(5.5, LaunchQuantization::Beat) == 6.0);
+        REQUIRE(map->getNextBoundary(5.5, LaunchQuantization::None) == 5.5);
+    }
+
+    SECTION("Tempo and meter changes") {
+        // 120 BPM 4/4 for one bar, then 60 BPM 3/4 (given out of order)
+        auto map = makeTempoMap({{4.0, 60.0, 3}, {0.0, 120.0, 4}});
+
+        REQUIRE(map->sampleAtBeat(4.0) == kSamplesPerBar);
+        REQUIRE(map->sampleAtBeat(5.0) == kSamplesPerBar + 48000);
+        REQUIRE(map->beatAtSample(kSamplesPerBar + 48000) == 5.0);
+
+        REQUIRE(map->getNextBoundary(2.0, LaunchQuantization::Bar) == 4.0);
+        REQUIRE(map->getNextBoundary(4.5, LaunchQuantization::Bar) == 7.0);
+    }
+
+    SECTION("Equality") {
+        REQUIRE(*makeTempoMap() == *makeTempoMap({{0.0, 120.0, 4}}));
+        REQUIRE_FALSE(*makeTempoMap() == *makeTempoMap({{0.0, 121.0, 4}}));
+    }
+}
+
+TEST_CASE("ClipLaunchEngine - Launches land on the boundary sample", "[audio][launch]") {
+    for (int blockSize : {64, 100, 512, 1000, 4096}) {
+        ClipLaunchEngine engine;
+        engine.setTempoMap(makeTempoMap());
+        run(engine, 3000, blockSize);
+
+        engine.launch(1, 10, LaunchQuantization::Bar);
+        runUntil(engine, kSamplesPerBar, blockSize);
+        REQUIRE(engine.getPlayingClip(10) == INVALID_CLIP_ID);
+
+        engine.process(blockSize, true);
+        auto events = takeEvents(engine);
+        REQUIRE(events.size() == 1);
+        REQUIRE(events[0].type == Event::Type::Started);
+        REQUIRE(events[0].clipId == 1);
+        REQUIRE(events[0].trackId == 10);
+        REQUIRE(events[0].sample == kSamplesPerBar);
+        REQUIRE(events[0].beat == 4.0);
+
+        juce::int64 startSample = 0;
+        REQUIRE(engine.getPlayingClip(10, &startSample) == 1);
+        REQUIRE(startSample == kSamplesPerBar);
+    }
+}
+
+TEST_CASE("ClipLaunchEngine - Launch replaces the playing clip", "[audio][launch]") {
+    ClipLaunchEngine engine;
+    engine.setTempoMap(makeTempoMap());
+    engine.launch(1, 10, LaunchQuantization::None);
+    run(engine, 1000, 100);
+    takeEvents(engine);
+
+    engine.launch(2, 10, LaunchQuantization::Beat);
+    run(engine, kSamplesPerBeat, 100);
+
+    auto events = takeEvents(engine);
+    REQUIRE(events.size() == 2);
+    REQUIRE(events[0].type == Event::Type::Stopped);
+    REQUIRE(events[0].clipId == 1);
+    REQUIRE(events[1].type == Event::Type::Started);
+    REQUIRE(events[1].clipId == 2);
+    REQUIRE(events[0].sample == kSamplesPerBeat);
+    REQUIRE(events[1].sample == kSamplesPerBeat);
+}
+
+TEST_CASE("ClipLaunchEngine - Stop and cancel", "[audio][launch]") {
+    ClipLaunchEngine engine;
+    engine.setTempoMap(makeTempoMap());
+
+    SECTION("Queued stop fires on the next bar") {
+        engine.launch(1, 10, LaunchQuantization::None);
+        engine.process(100, true);
+        takeEvents(engine);
+
+        engine.stop(1, 10, LaunchQuantization::Bar);
+        run(engine, kSamplesPerBar, 100);
+
+        auto events = takeEvents(engine);
+        REQUIRE(events.size() == 1);
+        REQUIRE(events[0].type == Event::Type::Stopped);
+        REQUIRE(events[0].sample == kSamplesPerBar);
+        REQUIRE(engine.getPlayingClip(10) == INVALID_CLIP_ID);
+    }
+
+    SECTION("A second launch on the track cancels the first") {
+        engine.process(100, true);
+        engine.launch(1, 10, LaunchQuantization::Bar);
+        engine.launch(2, 10, LaunchQuantization::Bar);
+        run(engine, kSamplesPerBar, 100);
+
+        auto events = takeEvents(engine);
+        REQUIRE(events.size() == 2);
+        REQUIRE(events[0].type == Event::Type::Cancelled);
+        REQUIRE(events[0].clipId == 1);
+        REQUIRE(events[1].type == Event::Type::Started);
+        REQUIRE(events[1].clipId == 2);
+    }
+
+    SECTION("Stopping a queued clip cancels its launch") {
+        engine.process(100, true);
+        engine.launch(1, 10, LaunchQuantization::Bar);
+        engine.stop(1, 10, LaunchQuantization::Bar);
+        run(engine, 2 * kSamplesPerBar, 100);
+
+        auto events = takeEvents(engine);
+        REQUIRE(events.size() == 1);
+        REQUIRE(events[0].type == Event::Type::Cancelled);
+        REQUIRE(engine.getPlayingClip(10) == INVALID_CLIP_ID);
+    }
+
+    SECTION("Stop all stops every track") {
+        engine.launch(1, 10, LaunchQuantization::None);
+        engine.launch(2, 11, LaunchQuantization::None);
+        engine.process(100, true);
+        takeEvents(engine);
+
+        engine.stopAll(LaunchQuantization::None);
+        engine.process(100, true);
+
+        auto events = takeEvents(engine);
+        REQUIRE(events.size() == 2);
+        REQUIRE(events[0].type == Event::Type::Stopped);
+        REQUIRE(events[1].type == Event::Type::Stopped);
+    }
+}
+
+TEST_CASE("ClipLaunchEngine - Transport", "[audio][launch]") {
+    ClipLaunchEngine engine;
+    engine.setTempoMap(makeTempoMap());
+
+    SECTION("Launches made while stopped take effect at once") {
+        engine.process(100, true);
+        engine.launch(1, 10, LaunchQuantization::Bar);
+        engine.process(100, false);
+
+        auto events = takeEvents(engine);
+        REQUIRE(events.size() == 1);
+        REQUIRE(events[0].type == Event::Type::Started);
+        REQUIRE(events[0].sample == 100);
+        REQUIRE(engine.getPosition() == 100);
+        REQUIRE(engine.getPlayingClip(10) == 1);
+    }
+
+    SECTION("Locate reschedules waiting launches from the new position") {
+        engine.process(100, true);
+        engine.launch(1, 10, LaunchQuantization::Bar);
+        engine.process(100, true);
+
+        engine.locate(kSamplesPerBar + 10);
+        run(engine, kSamplesPerBar, 100);
+
+        auto events = takeEvents(engine);
+        REQUIRE(events.size() == 1);
+        REQUIRE(events[0].sample == 2 * kSamplesPerBar);
+    }
+
+    SECTION("A tempo change reschedules waiting launches") {
+        engine.process(100, true);
+        engine.launch(1, 10, LaunchQuantization::Bar);
+        engine.process(100, true);
+
+        engine.setTempoMap(makeTempoMap({{0.0, 60.0, 4}}));
+        run(engine, 4 * kSamplesPerBar, 100);
+
+        auto events = takeEvents(engine);
+        REQUIRE(events.size() == 1);
+        REQUIRE(events[0].sample == 2 * kSamplesPerBar);
+    }
+}
+
+TEST_CASE("ClipLaunchEngine - Track slots", "[audio][launch]") {
+    ClipLaunchEngine engine;
+
+    for (TrackId trackId = 1; trackId <= ClipLaunchEngine::kMaxTracks; ++trackId) {
+        engine.launch(trackId, trackId, LaunchQuantization::None);
+    }
+    engine.process(100, true);
+    takeEvents(engine);
+
+    SECTION("A launch with every slot taken is cancelled") {
+        engine.launch(1000, 1000, LaunchQuantization::None);
+        engine.process(100, true);
+
+        auto events = takeEvents(engine);
+        REQUIRE(events.size() == 1);
+        REQUIRE(events[0].type == Event::Type::Cancelled);
+    }
+
+    SECTION("Releasing a track frees its slot") {
+        engine.releaseTrack(1);
+        engine.process(100, true);
+
+        auto events = takeEvents(engine);
+        REQUIRE(events.size() == 1);
+        REQUIRE(events[0].type == Event::Type::Stopped);
+        REQUIRE(engine.getPlayingClip(1) == INVALID_CLIP_ID);
+
+        engine.launch(1000, 1000, LaunchQuantization::None);
+        engine.process(100, true);
+        REQUIRE(engine.getPlayingClip(1000) == 1000);
+    }
+}
+
+TEST_CASE("ClipLaunchEngine - Dropped reports are owned up to", "[audio][launch]") {
+    ClipLaunchEngine engine;
+
+    // Each relaunch reports a stop and a start; never drained, they overflow the queue
+    for (ClipId clipId = 1; clipId <= 400; ++clipId) {
+        engine.launch(clipId, 10, LaunchQuantization::None);
+        engine.process(1, true);
+    }
+
+    bool complete = engine.dispatchEvents([](const Event&) {});
+    REQUIRE_FALSE(complete);
+    REQUIRE(engine.dispatchEvents([](const Event&) {}));
+}
@@ -0,0 +1,275 @@
+#include <juce_core/juce_core.h>
+
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <vector>
+
+#include "../magda/daw/command_table.hpp"
+#include "../magda/daw/core/ClipManager.hpp"
+#include "../magda/daw/core/TrackManager.hpp"
+#include "../magda/daw/model_commands.hpp"
+
+namespace {
+
+struct VolumeParams {
+    std::string trackId;
+    double volume = 1.0;
+    bool parse(const Command& c, std::string& error) {
+        return command_params::readString(c, "trackId", trackId, error) &&
+               command_params::readNumber(c, "volume", volume, error, false);
+    }
+};
+
+struct NoParams {
+    bool parse(const Command&, std::string&) {
+        return true;
+    }
+};
+
+juce::var makeCommand(const juce::String& type) {
+    juce::DynamicObject::Ptr obj = new juce::DynamicObject();
+    obj->setProperty("command", type);
+    return juce::var(obj.get());
+}
+
+juce::var makeVolumeCommand(const juce::var& trackId, const juce::var& volume) {
+    auto command = makeCommand("setVolume");
+    command.getDynamicObject()->setProperty("trackId", trackId);
+    command.getDynamicObject()->setProperty("volume", volume);
+    return command;
+}
+
+// Table that records the calls its handlers receive
+struct RecordingTable {
+    CommandTable table;
+    std::vector<std::string> calls;
+
+    RecordingTable() {
+        table.add<VolumeParams>("setVolume", [this](const VolumeParams& p) {
+            calls.push_back(p.trackId + "=" + std::to_string(p.volume));
+            return CommandResponse(CommandResponse::Status::Success, "ok");
+        });
+        table.add<NoParams>("fail", [this](const NoParams&) {
+            calls.push_back("fail");
+            return CommandResponse(CommandResponse::Status::Error, "failed");
+        });
+        table.add<NoParams>("throw", [](const NoParams&) -> CommandResponse {
+            throw std::runtime_error("boom");
+        });
+    }
+};
+
+}  // namespace
+
+TEST_CASE("CommandTable - Dispatch", "[command][table]") {
+    RecordingTable t;
+
+    SECTION("Registered types") {
+        REQUIRE(t.table.contains("setVolume"));
+        REQUIRE_FALSE(t.table.contains("play"));
+        REQUIRE(t.table.getCommandTypes() == std::vector<std::string>{"fail", "setVolume", "throw"});
+    }
+
+    SECTION("Parsed parameters reach the handler") {
+        Command cmd(std::string("setVolume"));
+        cmd.setParameter("trackId", std::string("t1"));
+        cmd.setParameter("volume", 0.5);
+
+        auto response = t.table.execute(cmd);
+        REQUIRE(response.getStatus() == CommandResponse::Status::Success);
+        REQUIRE(t.calls == std::vector<std::string>{"t1=" + std::to_string(0.5)});
+    }
+
+    SECTION("Optional parameters keep their defaults") {
+        Command cmd(std::string("setVolume"));
+        cmd.setParameter("trackId", std::string("t1"));
+
+        REQUIRE(t.table.execute(cmd).getStatus() == CommandResponse::Status::Success);
+        REQUIRE(t.calls == std::vector<std::string>{"t1=" + std::to_string(1.0)});
+    }
+
+    SECTION("Integers are accepted as numbers") {
+        Command cmd(std::string("setVolume"));
+        cmd.setParameter("trackId", std::string("t1"));
+        cmd.setParameter("volume", 2);
+
+        REQUIRE(t.table.execute(cmd).getStatus() == CommandResponse::Status::Success);
+        REQUIRE(t.calls == std::vector<std::string>{"t1=" + std::to_string(2.0)});
+    }
+
+    SECTION("Unknown type") {
+        auto response = t.table.execute(Command(std::string("play")));
+        REQUIRE(response.getStatus() == CommandResponse::Status::Error);
+        REQUIRE(response.getMessage() == "Unknown command: play");
+    }
+
+    SECTION("Missing or mistyped parameters never reach the handler") {
+        Command missing(std::string("setVolume"));
+        auto response = t.table.execute(missing);
+        REQUIRE(response.getStatus() == CommandResponse::Status::Error);
+        REQUIRE(response.getMessage() == "setVolume: missing parameter 'trackId'");
+
+        Command mistyped(std::string("setVolume"));
+        mistyped.setParameter("trackId", 3);
+        response = t.table.execute(mistyped);
+        REQUIRE(response.getStatus() == CommandResponse::Status::Error);
+        REQUIRE(response.getMessage() == "setVolume: parameter 'trackId' must be a string");
+
+        REQUIRE(t.calls.empty());
+    }
+
+    SECTION("Handler exceptions become errors") {
+        auto response = t.table.execute(Command(std::string("throw")));
+        REQUIRE(response.getStatus() == CommandResponse::Status::Error);
+        REQUIRE(response.getMessage() == "Command execution failed: boom");
+    }
+}
+
+TEST_CASE("CommandTable - Batches", "[command][table]") {
+    RecordingTable t;
+    std::vector<CommandTable::Prepared> batch;
+    std::string error;
+
+    SECTION("Preparation is all or nothing") {
+        juce::Array<juce::var> commands;
+        commands.add(makeVolumeCommand("t1", 0.5));
+        commands.add(makeVolumeCommand(7, 0.5));
+
+        REQUIRE_FALSE(t.table.prepareBatch(commands, batch, error));
+        REQUIRE(error == "Command 1: setVolume: parameter 'trackId' must be a string");
+        REQUIRE(batch.empty());
+        REQUIRE(t.calls.empty());
+    }
+
+    SECTION("Entries must be command objects") {
+        juce::Array<juce::var> commands;
+        commands.add(juce::var(3));
+        REQUIRE_FALSE(t.table.prepareBatch(commands, batch, error));
+        REQUIRE(error.rfind("Command 0: ", 0) == 0);
+
+        REQUIRE_FALSE(t.table.prepareBatch(juce::var("play"), batch, error));
+    }
+
+    SECTION("Results are reported per command with timings") {
+        juce::Array<juce::var> commands;
+        commands.add(makeVolumeCommand("t1", 0.5));
+        commands.add(makeVolumeCommand("t2", 1));
+        REQUIRE(t.table.prepareBatch(commands, batch, error));
+        REQUIRE(batch.size() == 2);
+        REQUIRE(t.calls.empty());
+
+        auto response = CommandTable::runBatch(batch);
+        REQUIRE(response.getStatus() == CommandResponse::Status::Success);
+        REQUIRE(t.calls.size() == 2);
+
+        auto results = response.getData()["results"];
+        REQUIRE(results.size() == 2);
+        REQUIRE(results[0]["command"].toString() == "setVolume");
+        REQUIRE(results[0]["status"].toString() == "success");
+        REQUIRE(static_cast<double>(results[1]["timeMs"]) >= 0.0);
+        REQUIRE(static_cast<double>(response.getData()["totalMs"]) >= 0.0);
+    }
+
+    SECTION("Execution stops at the first failure") {
+        juce::Array<juce::var> commands;
+        commands.add(makeVolumeCommand("t1", 0.5));
+        commands.add(makeCommand("fail"));
+        commands.add(makeVolumeCommand("t2", 0.5));
+        REQUIRE(t.table.prepareBatch(commands, batch, error));
+
+        auto response = CommandTable::runBatch(batch);
+        REQUIRE(response.getStatus() == CommandResponse::Status::Error);
+        REQUIRE(response.getMessage() == "Batch stopped after command 1");
+        REQUIRE(t.calls.size() == 2);
+        REQUIRE(response.getData()["results"].size() == 2);
+    }
+}
+
+TEST_CASE("Model commands - Edit tracks and clips by model id", "[command][table]") {
+    using namespace magda;
+
+    auto& tm = TrackManager::getInstance();
+    auto& cm = ClipManager::getInstance();
+    tm.clearAllTracks();
+    cm.clearAllClips();
+
+    CommandTable table;
+    registerModelCommands(table);
+
+    auto run = [&](const std::string& type, const Command::Parameters& params) {
+        Command cmd(type);
+        for (const auto& [key, value] : params) {
+            cmd.setParameter(key, value);
+        }
+        return table.execute(cmd);
+    };
+
+    auto created = run("createTrack", {{"name", std::string("Keys")}});
+    REQUIRE(created.getStatus() == CommandResponse::Status::Success);
+    int trackId = created.getData()["trackId"];
+    REQUIRE(tm.getTrack(trackId) != nullptr);
+    REQUIRE(tm.getTrack(trackId)->name == "Keys");
+
+    SECTION("Mixer commands reach the model track") {
+        REQUIRE(run("setTrackVolume", {{"trackId", trackId}, {"value", 0.5}}).getStatus() ==
+                CommandResponse::Status::Success);
+        REQUIRE(run("setTrackMute", {{"trackId", trackId}, {"enabled", true}}).getStatus() ==
+                CommandResponse::Status::Success);
+        REQUIRE(tm.getTrack(trackId)->volume == Catch::Approx(0.5f));
+        REQUIRE(tm.getTrack(trackId)->muted);
+    }
+
+    SECTION("Clip commands reach the model clip") {
+        auto added = run("addMidiClip", {{"trackId", trackId}, {"start", 1.0}, {"length", 2.0}});
+        REQUIRE(added.getStatus() == CommandResponse::Status::Success);
+        int clipId = added.getData()["clipId"];
+
+        REQUIRE(run("moveClip", {{"clipId", clipId}, {"value", 4.0}}).getStatus() ==
+                CommandResponse::Status::Success);
+        REQUIRE(run("resizeClip", {{"clipId", clipId}, {"value", 3.0}}).getStatus() ==
+                CommandResponse::Status::Success);
+        REQUIRE(cm.getClip(clipId)->startTime == Catch::Approx(4.0));
+        REQUIRE(cm.getClip(clipId)->length == Catch::Approx(3.0));
+
+        REQUIRE(run("deleteClip", {{"clipId", clipId}}).getStatus() ==
+                CommandResponse::Status::Success);
+        REQUIRE(cm.getClip(clipId) == nullptr);
+    }
+
+    SECTION("Unknown ids fail") {
+        int missing = trackId + 100;
+        auto response = run("setTrackName", {{"trackId", missing}, {"name", std::string("x")}});
+        REQUIRE(response.getStatus() == CommandResponse::Status::Error);
+        REQUIRE(response.getMessage() == "No track " + std::to_string(missing));
+
+        REQUIRE(run("setTrackSolo", {{"trackId", missing}, {"enabled", true}}).getStatus() ==
+                CommandResponse::Status::Error);
+        REQUIRE(run("addMidiClip", {{"trackId", missing}, {"start", 0.0}, {"length", 1.0}})
+                    .getStatus() == CommandResponse::Status::Error);
+        REQUIRE(run("moveClip", {{"clipId", 12345}, {"value", 1.0}}).getStatus() ==
+                CommandResponse::Status::Error);
+        REQUIRE(run("resizeClip", {{"clipId", 12345}, {"value", 1.0}}).getStatus() ==
+                CommandResponse::Status::Error);
+    }
+
+    SECTION("Out-of-range values are rejected before the handler runs") {
+        auto added = run("addMidiClip", {{"trackId", trackId}, {"start", 1.0}, {"length", 2.0}});
+        int clipId = added.getData()["clipId"];
+
+        REQUIRE(run("moveClip", {{"clipId", clipId}, {"value", -1.0}}).getStatus() ==
+                CommandResponse::Status::Error);
+        REQUIRE(run("resizeClip", {{"clipId", clipId}, {"value", 0.0}}).getStatus() ==
+                CommandResponse::Status::Error);
+        REQUIRE(run("setTrackPan", {{"trackId", trackId}, {"value", 2.0}}).getStatus() ==
+                CommandResponse::Status::Error);
+        REQUIRE(cm.getClip(clipId)->startTime == Catch::Approx(1.0));
+        REQUIRE(cm.getClip(clipId)->length == Catch::Approx(2.0));
+    }
+
+    SECTION("Time signature is not offered") {
+        REQUIRE_FALSE(table.contains("setTimeSignature"));
+    }
+
+    cm.clearAllClips();
+    tm.clearAllTracks();
+}
@@ -0,0 +1,211 @@
+#include <juce_core/juce_core.h>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "../magda/daw/engine/ControlServer.hpp"
+
+#if !JUCE_WINDOWS
+
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <cstring>
+
+using namespace magda;
+
+namespace {
+
+juce::File getTestSocketFile() {
+    return juce::File("/tmp").getChildFile("magda-test-" + juce::String(static_cast<int>(getpid())) +
+                                           ".sock");
+}
+
+// Runs requests inline on the server's I/O thread instead of the message thread
+void runInline(std::function<void()> task) {
+    task();
+}
+
+/**
+ * Blocking client speaking the server's framing
+ */
+class TestClient {
+  public:
+    explicit TestClient(const juce::File& socketFile) {
+        fd_ = socket(AF_UNIX, SOCK_STREAM, 0);
+        sockaddr_un address{};
+        address.sun_family = AF_UNIX;
+        auto path = socketFile.getFullPathName().toStdString();
+        std::strncpy(address.sun_path, path.c_str(), sizeof(address.sun_path) - 1);
+        connected_ = connect(fd_, reinterpret_cast<sockaddr*>(&address), sizeof(address)) == 0;
+
+        // Don't let a missing response hang the test run
+        timeval timeout{5, 0};
+        setsockopt(fd_, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    }
+
+    ~TestClient() {
+        close(fd_);
+    }
+
+    bool isConnected() const {
+        return connected_;
+    }
+
+    void send(const std::string& payload) {
+        sendRaw(ControlServer::encodeFrame(payload));
+    }
+
+    void sendRaw(const std::string& bytes) {
+        juce::ignoreUnused(::send(fd_, bytes.data(), bytes.size(), 0));
+    }
+
+    std::string receive() {
+        std::string payload;
+        for (;;) {
+            size_t offset = 0;
+            if (ControlServer::readFrame(buffer_, offset, payload) ==
+                ControlServer::FrameStatus::Complete) {
+                buffer_.erase(0, offset);
+                return payload;
+            }
+            char chunk[4096];
+            auto bytes = recv(fd_, chunk, sizeof(chunk), 0);
+            if (bytes <= 0) {
+                return "<closed>";
+            }
+            buffer_.append(chunk, static_cast<size_t>(bytes));
+        }
+    }
+
+  private:
+    int fd_ = -1;
+    bool connected_ = false;
+    std::string buffer_;
+};
+
+}  // namespace
+
+TEST_CASE("ControlServer - Framing", "[control]") {
+    auto frame = ControlServer::encodeFrame("hello");
+    REQUIRE(frame.size() == 9);
+    REQUIRE(frame.substr(0, 4) == std::string("\0\0\0\5", 4));
+
+    std::string payload;
+    size_t offset = 0;
+    std::string partial = frame.substr(0, 6);
+    REQUIRE(ControlServer::readFrame(partial, offset, payload) ==
+            ControlServer::FrameStatus::Incomplete);
+    REQUIRE(offset == 0);
+
+    std::string two = frame + ControlServer::encodeFrame("");
+    REQUIRE(ControlServer::readFrame(two, offset, payload) == ControlServer::FrameStatus::Complete);
+    REQUIRE(payload == "hello");
+    REQUIRE(ControlServer::readFrame(two, offset, payload) == ControlServer::FrameStatus::Complete);
+    REQUIRE(payload.empty());
+    REQUIRE(offset == two.size());
+
+    std::string huge("\x7f\0\0\0", 4);
+    offset = 0;
+    REQUIRE(ControlServer::readFrame(huge, offset, payload) ==
+            ControlServer::FrameStatus::TooLarge);
+}
+
+TEST_CASE("ControlServer - Requests and responses", "[control]") {
+    auto socketFile = getTestSocketFile();
+    std::atomic<int> lastClient{0};
+    ControlServer server(
+        [&lastClient](ControlServer::ClientId client, const std::string& request) {
+            lastClient = client;
+            return request == "quiet" ? std::string() : "re:" + request;
+        },
+        runInline);
+    REQUIRE(server.start(socketFile));
+    REQUIRE(socketFile.exists());
+
+    SECTION("Pipelined requests are answered in order") {
+        TestClient client(socketFile);
+        REQUIRE(client.isConnected());
+
+        for (int i = 0; i < 200; ++i) {
+            client.send(std::to_string(i));
+        }
+        for (int i = 0; i < 200; ++i) {
+            REQUIRE(client.receive() == "re:" + std::to_string(i));
+        }
+    }
+
+    SECTION("Empty responses are not sent") {
+        TestClient client(socketFile);
+        client.send("quiet");
+        client.send("loud");
+        REQUIRE(client.receive() == "re:loud");
+    }
+
+    SECTION("Events go to subscribed clients only") {
+        TestClient subscriber(socketFile);
+        TestClient other(socketFile);
+
+        subscriber.send("hello");
+        REQUIRE(subscriber.receive() == "re:hello");
+        server.setSubscribed(lastClient, true);
+        REQUIRE(server.hasSubscribers());
+
+        server.broadcastEvent("event");
+        other.send("ping");
+        REQUIRE(subscriber.receive() == "event");
+        REQUIRE(other.receive() == "re:ping");
+    }
+
+    SECTION("Oversized frames disconnect the client") {
+        TestClient client(socketFile);
+        client.sendRaw(std::string("\x7f\0\0\0", 4));
+        REQUIRE(client.receive() == "<closed>");
+    }
+
+    server.stop();
+    REQUIRE_FALSE(socketFile.exists());
+}
+
+TEST_CASE("ControlServer - Socket file ownership", "[control]") {
+    auto socketFile = getTestSocketFile();
+    auto echo = [](ControlServer::ClientId, const std::string& request) { return request; };
+
+    ControlServer first(echo, runInline);
+    REQUIRE(first.start(socketFile));
+
+    SECTION("Only the current user can open the socket file") {
+        struct stat info {};
+        REQUIRE(stat(socketFile.getFullPathName().toRawUTF8(), &info) == 0);
+        REQUIRE((info.st_mode & 0777) == (S_IRUSR | S_IWUSR));
+    }
+
+    SECTION("A live server's socket is not taken over") {
+        ControlServer second(echo, runInline);
+        REQUIRE_FALSE(second.start(socketFile));
+        REQUIRE(socketFile.exists());
+    }
+
+    SECTION("A stale socket file is replaced") {
+        // Simulate a crash: the file stays behind while nothing listens on it
+        first.stop();
+        int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+        sockaddr_un address{};
+        address.sun_family = AF_UNIX;
+        std::strncpy(address.sun_path, socketFile.getFullPathName().toStdString().c_str(),
+                     sizeof(address.sun_path) - 1);
+        REQUIRE(bind(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) == 0);
+        close(fd);
+        REQUIRE(socketFile.exists());
+
+        ControlServer second(echo, runInline);
+        REQUIRE(second.start(socketFile));
+
+        TestClient client(socketFile);
+        client.send("ok");
+        REQUIRE(client.receive() == "ok");
+    }
+}
+
+#endif
@@ -1,5 +1,6 @@
 #include <catch2/catch_test_macros.hpp>
 
+#include "../magda/daw/audio/ParameterDescriptorCache.hpp"
 #include "../magda/daw/core/DeviceInfo.hpp"
 #include "../magda/daw/core/ParameterInfo.hpp"
 
@@ -316,3 +317,113 @@ TEST_CASE("Parameter page fix - regression test", "[device][pagination][regressi
         REQUIRE(lastParamOnPage == 127);
     }
 }
+
+// ============================================================================
+// Lazy ParameterList Tests
+// ============================================================================
+
+namespace {
+
+std::shared_ptr<const ParameterList::DescriptorTable> makeDescriptors(size_t count) {
+    ParameterList::DescriptorTable table;
+    for (size_t i = 0; i < count; ++i) {
+        ParameterInfo param;
+        param.paramIndex = static_cast<int>(i);
+        param.name = "Param " + juce::String(static_cast<int>(i));
+        param.unit = "Hz";
+        param.maxValue = 100.0f;
+        table.push_back(param);
+    }
+    return std::make_shared<const ParameterList::DescriptorTable>(std::move(table));
+}
+
+}  // namespace
+
+TEST_CASE("ParameterList - Pages materialise on demand", "[device][pagination][lazy]") {
+    // A large synth: 2000 parameters, 63 pages
+    std::vector<float> values(2000);
+    for (size_t i = 0; i < values.size(); ++i)
+        values[i] = static_cast<float>(i) * 0.01f;
+
+    DeviceInfo device;
+    device.parameters = ParameterList(makeDescriptors(2000), values);
+
+    REQUIRE(device.parameters.size() == 2000);
+    REQUIRE(device.parameters.getNumMaterialisedPages() == 0);
+
+    SECTION("Accessing a page builds only that page") {
+        const auto& param = device.parameters[70];
+        REQUIRE(param.paramIndex == 70);
+        REQUIRE(param.name == "Param 70");
+        REQUIRE(param.currentValue == values[70]);
+        REQUIRE(device.parameters.getNumMaterialisedPages() == 1);
+
+        // Same page
+        REQUIRE(device.parameters[64].name == "Param 64");
+        REQUIRE(device.parameters.getNumMaterialisedPages() == 1);
+    }
+
+    SECTION("Reading values does not materialise") {
+        REQUIRE(device.parameters.getCurrentValue(1999) == values[1999]);
+        REQUIRE(device.parameters.getNumMaterialisedPages() == 0);
+    }
+
+    SECTION("Reading metadata does not materialise") {
+        REQUIRE(device.parameters.getDescriptor(1999).name == "Param 1999");
+        REQUIRE(device.parameters.getDescriptor(1999).unit == "Hz");
+        REQUIRE(device.parameters.getNumMaterialisedPages() == 0);
+
+        // A materialised page is what later reads see
+        device.parameters[40].name = "Cutoff";
+        REQUIRE(device.parameters.getDescriptor(40).name == "Cutoff");
+    }
+
+    SECTION("Edits through either interface are visible to both") {
+        device.parameters[5].currentValue = 0.25f;
+        REQUIRE(device.parameters.getCurrentValue(5) == 0.25f);
+
+        device.parameters.setCurrentValue(1500, 0.75f);
+        REQUIRE(device.parameters[1500].currentValue == 0.75f);
+    }
+
+    SECTION("Copies share descriptors and keep their own values") {
+        auto copy = device.parameters;
+        copy.setCurrentValue(3, 9.0f);
+        REQUIRE(device.parameters.getCurrentValue(3) == values[3]);
+        REQUIRE(copy[3].name == device.parameters[3].name);
+    }
+}
+
+TEST_CASE("ParameterDescriptorCache - Round trip and staleness", "[device][pagination][cache]") {
+    auto& cache = ParameterDescriptorCache::getInstance();
+    auto previousDirectory = cache.getDirectory();
+    auto directory = juce::File::getSpecialLocation(juce::File::tempDirectory)
+                         .getChildFile("magda_param_cache_test");
+    cache.setDirectory(directory);
+
+    const juce::String key = "VST3-BigSynth-1234:1.0.0";
+    auto descriptors = makeDescriptors(40);
+    cache.store(key, *descriptors);
+
+    SECTION("Served from memory for the matching parameter count") {
+        auto found = cache.find(key, 40);
+        REQUIRE(found != nullptr);
+        REQUIRE((*found)[39].name == "Param 39");
+        REQUIRE(cache.find(key, 41) == nullptr);
+    }
+
+    SECTION("Reloaded from disk in a later session") {
+        cache.setDirectory(directory);  // Drops the in-memory tables
+        auto found = cache.find(key, 40);
+        REQUIRE(found != nullptr);
+        REQUIRE((*found)[12].unit == "Hz");
+        REQUIRE((*found)[12].maxValue == 100.0f);
+    }
+
+    SECTION("Other plugin versions miss") {
+        REQUIRE(cache.find("VST3-BigSynth-1234:2.0.0", 40) == nullptr);
+    }
+
+    cache.clear();
+    cache.setDirectory(previousDirectory);
+}
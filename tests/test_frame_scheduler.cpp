@@ -0,0 +1,142 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <functional>
+
+#include "../magda/daw/ui/utils/FrameScheduler.hpp"
+
+using namespace magda;
+
+namespace {
+
+class TestClient : public FrameClient {
+  public:
+    ~TestClient() override = default;
+
+    void frameTick() override {
+        ++ticks;
+        if (onTick) {
+            onTick();
+        }
+    }
+
+    using FrameClient::isAnimating;
+    using FrameClient::setAnimating;
+    using FrameClient::startAnimating;
+    using FrameClient::stopAnimating;
+
+    int ticks = 0;
+    std::function<void()> onTick;
+};
+
+class PlainComponent : public juce::Component {
+  public:
+    void paint(juce::Graphics&) override {}
+};
+
+}  // namespace
+
+TEST_CASE("FrameScheduler - Subscribe and tick", "[ui][frames]") {
+    juce::ScopedJuceInitialiser_GUI juceInit;
+    auto& scheduler = FrameScheduler::getInstance();
+    scheduler.shutdown();
+    REQUIRE(scheduler.isIdle());
+    REQUIRE_FALSE(scheduler.isRunning());
+
+    TestClient client;
+    client.startAnimating(30);
+    REQUIRE(client.isAnimating());
+    REQUIRE(scheduler.getNumAnimatingClients() == 1);
+    REQUIRE(scheduler.isRunning());
+
+    SECTION("A client ticks once per frame slot at its own rate") {
+        scheduler.runFrame(1.0);
+        scheduler.runFrame(1.0 + 0.5 / 30.0);  // Same 30 FPS slot
+        REQUIRE(client.ticks == 1);
+
+        scheduler.runFrame(1.0 + 1.5 / 30.0);
+        REQUIRE(client.ticks == 2);
+    }
+
+    SECTION("Subscribing twice changes the rate, not the count") {
+        client.startAnimating(10);
+        REQUIRE(scheduler.getNumAnimatingClients() == 1);
+
+        scheduler.runFrame(1.0);
+        scheduler.runFrame(1.0 + 1.0 / 30.0);  // Due at 30 FPS, not at 10
+        REQUIRE(client.ticks == 1);
+    }
+
+    scheduler.shutdown();
+}
+
+TEST_CASE("FrameScheduler - Stopping returns to idle", "[ui][frames]") {
+    juce::ScopedJuceInitialiser_GUI juceInit;
+    auto& scheduler = FrameScheduler::getInstance();
+    scheduler.shutdown();
+
+    SECTION("The driver stops with the last client") {
+        TestClient a;
+        TestClient b;
+        a.startAnimating();
+        b.startAnimating();
+
+        a.stopAnimating();
+        REQUIRE(scheduler.isRunning());
+        b.stopAnimating();
+        REQUIRE(scheduler.isIdle());
+        REQUIRE_FALSE(scheduler.isRunning());
+    }
+
+    SECTION("A destroyed client unsubscribes") {
+        {
+            TestClient client;
+            client.startAnimating();
+        }
+        REQUIRE(scheduler.getNumAnimatingClients() == 0);
+        REQUIRE_FALSE(scheduler.isRunning());
+    }
+
+    SECTION("A client can stop itself from its tick") {
+        TestClient client;
+        client.onTick = [&client]() { client.setAnimating(false); };
+        client.setAnimating(true);
+
+        scheduler.runFrame(1.0);
+        REQUIRE(client.ticks == 1);
+        REQUIRE_FALSE(client.isAnimating());
+        REQUIRE(scheduler.isIdle());
+
+        scheduler.runFrame(2.0);
+        REQUIRE(client.ticks == 1);
+    }
+
+    SECTION("setAnimating leaves a client that is already there alone") {
+        TestClient client;
+        client.setAnimating(false);
+        REQUIRE_FALSE(scheduler.isRunning());
+
+        client.setAnimating(true);
+        client.setAnimating(true);
+        REQUIRE(scheduler.getNumAnimatingClients() == 1);
+    }
+
+    scheduler.shutdown();
+}
+
+TEST_CASE("FrameScheduler - Repaint requests", "[ui][frames]") {
+    juce::ScopedJuceInitialiser_GUI juceInit;
+    auto& scheduler = FrameScheduler::getInstance();
+    scheduler.shutdown();
+
+    PlainComponent component;
+    scheduler.requestRepaint(component);
+    scheduler.requestRepaint(component);
+    REQUIRE_FALSE(scheduler.isIdle());
+    REQUIRE(scheduler.isRunning());
+
+    // One frame flushes every pending repaint; with no clients nothing is left to do
+    scheduler.runFrame(1.0);
+    REQUIRE(scheduler.isIdle());
+
+    scheduler.shutdown();
+}
@@ -0,0 +1,155 @@
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <random>
+
+#include "../magda/daw/core/AutomationManager.hpp"
+#include "../magda/daw/core/ClipManager.hpp"
+#include "../magda/daw/core/IdIndex.hpp"
+#include "../magda/daw/core/TrackManager.hpp"
+
+using namespace magda;
+
+namespace {
+
+struct Item {
+    int id = 0;
+};
+
+std::vector<Item> makeItems(std::initializer_list<int> ids) {
+    std::vector<Item> items;
+    for (int id : ids) {
+        items.push_back({id});
+    }
+    return items;
+}
+
+}  // namespace
+
+TEST_CASE("IdIndex - Lookup follows the vector", "[core][ids]") {
+    auto items = makeItems({10, 20, 30, 40});
+    IdIndex<int> index;
+    index.rebuild(items);
+
+    REQUIRE(index.find(30) == 2);
+    REQUIRE(index.lookup(items, 40) == &items[3]);
+    REQUIRE(index.lookup(items, 99) == nullptr);
+
+    SECTION("Erase keeps order and renumbers later items") {
+        REQUIRE(index.erase(items, 20));
+        REQUIRE_FALSE(index.erase(items, 20));
+        REQUIRE(items.size() == 3);
+        REQUIRE(index.find(20) == IdIndex<int>::npos);
+        REQUIRE(index.find(30) == 1);
+        REQUIRE(index.lookup(items, 40)->id == 40);
+    }
+
+    SECTION("Add records appended items") {
+        index.add(50, items.size());
+        items.push_back({50});
+        REQUIRE(index.lookup(items, 50) == &items.back());
+        REQUIRE(index.size() == 5);
+    }
+}
+
+TEST_CASE("TrackManager - Lookup after reorder and delete", "[core][ids]") {
+    auto& trackManager = TrackManager::getInstance();
+    trackManager.clearAllTracks();
+
+    TrackId a = trackManager.createTrack("A");
+    TrackId b = trackManager.createTrack("B");
+    TrackId c = trackManager.createTrack("C");
+
+    trackManager.moveTrack(c, 0);
+    REQUIRE(trackManager.getTrackIndex(c) == 0);
+    REQUIRE(trackManager.getTrackIndex(a) == 1);
+    REQUIRE(trackManager.getTrack(b)->name == "B");
+
+    trackManager.duplicateTrack(c);
+    REQUIRE(trackManager.getTrackIndex(a) == 2);
+
+    trackManager.deleteTrack(a);
+    REQUIRE(trackManager.getTrack(a) == nullptr);
+    REQUIRE(trackManager.getTrackIndex(b) == 2);
+    REQUIRE(trackManager.getTrack(b)->name == "B");
+
+    trackManager.clearAllTracks();
+}
+
+// ============================================================================
+// Lookup benchmark (hidden; run with: magda_tests "[.benchmark]")
+// ============================================================================
+
+TEST_CASE("ID lookup benchmark", "[.benchmark][core][ids]") {
+    constexpr int kLookups = 1000;
+
+    for (int count : {10000, 100000}) {
+        std::mt19937 rng(1);
+        std::uniform_int_distribution<int> pick(1, count);
+        std::vector<int> ids(kLookups);
+        for (auto& id : ids) {
+            id = pick(rng);
+        }
+
+        std::vector<TrackInfo> tracks(static_cast<size_t>(count));
+        std::vector<ClipInfo> clips(static_cast<size_t>(count));
+        std::vector<AutomationClipInfo> automationClips(static_cast<size_t>(count));
+        for (int i = 0; i < count; ++i) {
+            tracks[static_cast<size_t>(i)].id = i + 1;
+            clips[static_cast<size_t>(i)].id = i + 1;
+            clips[static_cast<size_t>(i)].trackId = i % 64 + 1;
+            clips[static_cast<size_t>(i)].startTime = i;
+            clips[static_cast<size_t>(i)].length = 1.0;
+            automationClips[static_cast<size_t>(i)].id = i + 1;
+        }
+
+        auto& trackManager = TrackManager::getInstance();
+        auto& clipManager = ClipManager::getInstance();
+        auto& automationManager = AutomationManager::getInstance();
+        trackManager.loadTracks(tracks, MasterChannelState{});
+        clipManager.loadClips(clips);
+        automationManager.loadAutomation({}, automationClips, 1);
+
+        auto label = std::to_string(count) + " entities, " + std::to_string(kLookups) + " lookups";
+
+        BENCHMARK("getTrack, " + label) {
+            int found = 0;
+            for (int id : ids) {
+                found += trackManager.getTrack(id) != nullptr;
+            }
+            return found;
+        };
+
+        BENCHMARK("ClipManager::getClip, " + label) {
+            int found = 0;
+            for (int id : ids) {
+                found += clipManager.getClip(id) != nullptr;
+            }
+            return found;
+        };
+
+        BENCHMARK("AutomationManager::getClip, " + label) {
+            int found = 0;
+            for (int id : ids) {
+                found += automationManager.getClip(id) != nullptr;
+            }
+            return found;
+        };
+
+        // What the lookups cost before: a linear scan per ID
+        BENCHMARK("linear scan, " + label) {
+            int found = 0;
+            for (int id : ids) {
+                found += std::find_if(tracks.begin(), tracks.end(), [id](const TrackInfo& t) {
+                             return t.id == id;
+                         }) != tracks.end();
+            }
+            return found;
+        };
+    }
+
+    TrackManager::getInstance().clearAllTracks();
+    ClipManager::getInstance().clearAllClips();
+    AutomationManager::getInstance().clearAll();
+}
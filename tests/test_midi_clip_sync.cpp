@@ -31,7 +31,7 @@ TEST_CASE("MidiNote - Clip-relative storage", "[midi][clip][storage]") {
         note.noteNumber = 60;
         note.velocity = 100;
 
-        clip.midiNotes.push_back(note);
+        clip.midiNotes.add(note);
 
         // Note position is clip-relative, NOT absolute
         REQUIRE(clip.midiNotes[0].startBeat == 0.0);
@@ -55,7 +55,7 @@ TEST_CASE("MidiNote - Clip-relative storage", "[midi][clip][storage]") {
             note.lengthBeats = 1.0;
             note.noteNumber = 60;
             note.velocity = 100;
-            clip.midiNotes.push_back(note);
+            clip.midiNotes.add(note);
         }
 
         REQUIRE(clip.midiNotes.size() == 4);
@@ -80,7 +80,7 @@ TEST_CASE("MidiClip - Position changes don't affect notes", "[midi][clip][positi
         note.lengthBeats = 1.0;
         note.noteNumber = 60;
         note.velocity = 100;
-        clip.midiNotes.push_back(note);
+        clip.midiNotes.add(note);
 
         double originalNoteBeat = clip.midiNotes[0].startBeat;
 
@@ -103,7 +103,7 @@ TEST_CASE("MidiClip - Position changes don't affect notes", "[midi][clip][positi
         note.lengthBeats = 0.5;
         note.noteNumber = 64;
         note.velocity = 80;
-        clip.midiNotes.push_back(note);
+        clip.midiNotes.add(note);
 
         // Move clip multiple times
         clip.startTime = 2.0;
@@ -133,7 +133,7 @@ TEST_CASE("MidiClip - Length changes preserve note positions", "[midi][clip][len
             note.lengthBeats = 1.0;
             note.noteNumber = 60;
             note.velocity = 100;
-            clip.midiNotes.push_back(note);
+            clip.midiNotes.add(note);
         }
 
         // Shorten clip to 2 bars (4 seconds = 8 beats at 120 BPM)
@@ -163,7 +163,7 @@ TEST_CASE("MidiClip - Length changes preserve note positions", "[midi][clip][len
         note.lengthBeats = 0.25;
         note.noteNumber = 72;
         note.velocity = 90;
-        clip.midiNotes.push_back(note);
+        clip.midiNotes.add(note);
 
         double originalBeat = clip.midiNotes[0].startBeat;
 
@@ -190,19 +190,19 @@ TEST_CASE("MidiClip - Notes beyond clip boundary", "[midi][clip][boundary]") {
         note1.startBeat = 0.0;  // Within boundary
         note1.lengthBeats = 1.0;
         note1.noteNumber = 60;
-        clip.midiNotes.push_back(note1);
+        clip.midiNotes.add(note1);
 
         MidiNote note2;
         note2.startBeat = 3.0;  // Within boundary
         note2.lengthBeats = 0.5;
         note2.noteNumber = 64;
-        clip.midiNotes.push_back(note2);
+        clip.midiNotes.add(note2);
 
         MidiNote note3;
         note3.startBeat = 7.0;  // Within boundary (7 < 8 beats)
         note3.lengthBeats = 1.0;
         note3.noteNumber = 67;
-        clip.midiNotes.push_back(note3);
+        clip.midiNotes.add(note3);
 
         double clipLengthInBeats = 8.0;  // 4 seconds = 8 beats at 120 BPM
 
@@ -222,13 +222,13 @@ TEST_CASE("MidiClip - Notes beyond clip boundary", "[midi][clip][boundary]") {
         noteAtStart.startBeat = 0.0;  // Exactly at start
         noteAtStart.lengthBeats = 1.0;
         noteAtStart.noteNumber = 60;
-        clip.midiNotes.push_back(noteAtStart);
+        clip.midiNotes.add(noteAtStart);
 
         MidiNote noteAtEnd;
         noteAtEnd.startBeat = 3.9;  // Just before end
         noteAtEnd.lengthBeats = 0.1;
         noteAtEnd.noteNumber = 64;
-        clip.midiNotes.push_back(noteAtEnd);
+        clip.midiNotes.add(noteAtEnd);
 
         double clipLengthInBeats = 4.0;
 
@@ -291,7 +291,7 @@ TEST_CASE("MidiClip - Real-world scenario", "[midi][clip][integration]") {
             note.lengthBeats = 1.0;
             note.noteNumber = 60;
             note.velocity = 100;
-            clip.midiNotes.push_back(note);
+            clip.midiNotes.add(note);
         }
 
         // Verify initial state
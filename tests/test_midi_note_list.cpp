@@ -0,0 +1,248 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <random>
+
+#include "../magda/daw/core/ClipManager.hpp"
+#include "../magda/daw/core/MidiNoteCommands.hpp"
+#include "../magda/daw/core/MidiNoteList.hpp"
+
+using namespace magda;
+
+namespace {
+
+MidiNote makeNote(int noteNumber, double startBeat, double lengthBeats) {
+    MidiNote note;
+    note.noteNumber = noteNumber;
+    note.startBeat = startBeat;
+    note.lengthBeats = lengthBeats;
+    return note;
+}
+
+bool isSorted(const MidiNoteList& notes) {
+    return std::is_sorted(notes.begin(), notes.end(), [](const MidiNote& a, const MidiNote& b) {
+        return a.startBeat < b.startBeat ||
+               (a.startBeat == b.startBeat && a.noteNumber < b.noteNumber);
+    });
+}
+
+std::vector<MidiNoteId> idsOf(const MidiNoteList& notes) {
+    std::vector<MidiNoteId> ids;
+    for (const auto& note : notes) {
+        ids.push_back(note.id);
+    }
+    return ids;
+}
+
+}  // namespace
+
+TEST_CASE("MidiNoteList - Notes stay sorted with stable ids", "[midi][notes]") {
+    MidiNoteList notes;
+    auto late = notes.add(makeNote(60, 4.0, 1.0));
+    auto early = notes.add(makeNote(64, 0.0, 1.0));
+    auto middle = notes.add(makeNote(62, 2.0, 1.0));
+
+    REQUIRE(late != early);
+    REQUIRE(isSorted(notes));
+    REQUIRE(idsOf(notes) == std::vector<MidiNoteId>({early, middle, late}));
+
+    SECTION("Moving a note re-sorts it and keeps its id") {
+        auto moved = *notes.find(late);
+        moved.startBeat = 1.0;
+        REQUIRE(notes.update(moved));
+        REQUIRE(idsOf(notes) == std::vector<MidiNoteId>({early, late, middle}));
+        REQUIRE(notes.find(late)->startBeat == 1.0);
+
+        moved.startBeat = 8.0;
+        REQUIRE(notes.update(moved));
+        REQUIRE(idsOf(notes) == std::vector<MidiNoteId>({early, middle, late}));
+    }
+
+    SECTION("Removed ids are not handed out again") {
+        auto removed = *notes.find(middle);
+        REQUIRE(notes.remove(middle));
+        REQUIRE_FALSE(notes.remove(middle));
+        REQUIRE(notes.find(middle) == nullptr);
+        REQUIRE(notes.indexOf(middle) == -1);
+
+        auto added = notes.add(makeNote(70, 2.0, 1.0));
+        REQUIRE(added != middle);
+
+        // Undoing a delete brings the note back under its own id
+        REQUIRE(notes.add(removed) == middle);
+        REQUIRE(notes.indexOf(middle) == 1);
+    }
+
+    SECTION("An id already in use is replaced") {
+        auto clash = makeNote(50, 3.0, 1.0);
+        clash.id = early;
+        auto id = notes.add(clash);
+        REQUIRE(id != early);
+        REQUIRE(notes.find(early)->noteNumber == 64);
+    }
+
+    SECTION("Unknown ids are rejected") {
+        auto stranger = makeNote(60, 0.0, 1.0);
+        stranger.id = 999;
+        REQUIRE_FALSE(notes.update(stranger));
+        REQUIRE(notes.find(INVALID_MIDI_NOTE_ID) == nullptr);
+    }
+}
+
+TEST_CASE("MidiNoteList - Built from unsorted notes", "[midi][notes]") {
+    MidiNoteList notes({makeNote(60, 3.0, 1.0), makeNote(60, 1.0, 1.0), makeNote(59, 1.0, 1.0)});
+
+    REQUIRE(isSorted(notes));
+    REQUIRE(notes[0].noteNumber == 59);
+
+    auto ids = idsOf(notes);
+    std::sort(ids.begin(), ids.end());
+    REQUIRE(std::adjacent_find(ids.begin(), ids.end()) == ids.end());
+    REQUIRE(ids.front() != INVALID_MIDI_NOTE_ID);
+
+    // Copies share notes and ids until one of them is edited
+    auto copy = notes;
+    REQUIRE(copy.sharesBufferWith(notes));
+    copy.remove(copy[0].id);
+    REQUIRE(notes.size() == 3);
+    REQUIRE(copy.size() == 2);
+}
+
+TEST_CASE("MidiNoteList - Deferred notes get ids when decoded", "[midi][notes]") {
+    int loads = 0;
+    auto notes = MidiNoteList::deferred(2, [&loads]() {
+        ++loads;
+        return std::vector<MidiNote>{makeNote(62, 2.0, 1.0), makeNote(60, 0.0, 1.0)};
+    });
+
+    REQUIRE(notes.size() == 2);
+    REQUIRE_FALSE(notes.isMaterialised());
+    REQUIRE(loads == 0);
+
+    REQUIRE(notes[0].noteNumber == 60);
+    REQUIRE(loads == 1);
+    REQUIRE(notes.find(notes[1].id)->noteNumber == 62);
+
+    auto added = notes.add(makeNote(64, 1.0, 1.0));
+    REQUIRE(added != notes[0].id);
+    REQUIRE(added != notes[2].id);
+}
+
+TEST_CASE("MidiNoteList - Range queries", "[midi][notes]") {
+    MidiNoteList notes;
+    notes.add(makeNote(60, 0.0, 1.0));
+    notes.add(makeNote(62, 1.0, 1.0));
+    notes.add(makeNote(60, 4.0, 0.5));
+    notes.add(makeNote(64, 0.0, 64.0));  // Long held note
+    notes.add(makeNote(60, 8.0, 1.0));
+
+    // Sorted: 0 = 60@0, 1 = 64@0 (long), 2 = 62@1, 3 = 60@4, 4 = 60@8
+    std::vector<size_t> results;
+
+    SECTION("Time range") {
+        notes.queryTimeRange(0.5, 4.0, results);
+        REQUIRE(results == std::vector<size_t>({0, 1, 2}));
+
+        notes.queryTimeRange(40.0, 41.0, results);
+        REQUIRE(results == std::vector<size_t>({1}));
+    }
+
+    SECTION("Pitch range") {
+        notes.queryPitchRange(60, 60, results);
+        REQUIRE(results == std::vector<size_t>({0, 3, 4}));
+
+        notes.queryPitchRange(61, 64, results);
+        REQUIRE(results == std::vector<size_t>({1, 2}));
+    }
+
+    SECTION("Time and pitch") {
+        notes.query(3.0, 10.0, 60, 60, results);
+        REQUIRE(results == std::vector<size_t>({3, 4}));
+    }
+
+    SECTION("Edits are seen by the next query") {
+        notes.queryTimeRange(8.0, 9.0, results);
+        REQUIRE(results.size() == 2);
+
+        auto moved = notes[4];
+        moved.startBeat = 20.0;
+        notes.update(moved);
+        notes.queryTimeRange(8.0, 9.0, results);
+        REQUIRE(results == std::vector<size_t>({1}));
+        notes.query(20.0, 21.0, 60, 60, results);
+        REQUIRE(results == std::vector<size_t>({4}));
+    }
+}
+
+TEST_CASE("MidiNoteList - Queries match a linear scan on large clips", "[midi][notes]") {
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<int> pitch(0, 127);
+    std::uniform_real_distribution<double> start(0.0, 4096.0);
+    std::uniform_real_distribution<double> length(0.05, 4.0);
+
+    std::vector<MidiNote> input;
+    for (int i = 0; i < 50000; ++i) {
+        double noteLength = i % 1000 == 0 ? 200.0 : length(rng);
+        input.push_back(makeNote(pitch(rng), start(rng), noteLength));
+    }
+    MidiNoteList notes(input);
+
+    std::vector<size_t> results;
+    for (int i = 0; i < 50; ++i) {
+        double queryStart = start(rng);
+        double queryEnd = queryStart + 16.0;
+
+        std::vector<size_t> expected;
+        for (size_t n = 0; n < notes.size(); ++n) {
+            if (notes[n].startBeat < queryEnd &&
+                notes[n].startBeat + notes[n].lengthBeats > queryStart) {
+                expected.push_back(n);
+            }
+        }
+
+        notes.queryTimeRange(queryStart, queryEnd, results);
+        REQUIRE(results == expected);
+    }
+}
+
+TEST_CASE("MidiNoteCommands - Address notes by id", "[midi][commands]") {
+    ClipManager::getInstance().shutdown();
+    ClipId clipId = ClipManager::getInstance().createMidiClip(1, 0.0, 8.0);
+    const auto* clip = ClipManager::getInstance().getClip(clipId);
+    REQUIRE(clip != nullptr);
+
+    auto& undoManager = UndoManager::getInstance();
+    auto addFirst = std::make_unique<AddMidiNoteCommand>(clipId, 2.0, 60, 1.0, 100);
+    auto* first = addFirst.get();
+    undoManager.executeCommand(std::move(addFirst));
+    auto firstId = first->getNoteId();
+    undoManager.executeCommand(std::make_unique<AddMidiNoteCommand>(clipId, 4.0, 64, 1.0, 100));
+
+    SECTION("A move past another note still edits the same note") {
+        undoManager.executeCommand(std::make_unique<MoveMidiNoteCommand>(clipId, firstId, 6.0, 60));
+        REQUIRE(clip->midiNotes[1].id == firstId);
+
+        undoManager.executeCommand(
+            std::make_unique<SetMidiNoteVelocityCommand>(clipId, firstId, 40));
+        REQUIRE(clip->midiNotes.find(firstId)->velocity == 40);
+
+        undoManager.undo();
+        undoManager.undo();
+        REQUIRE(clip->midiNotes[0].id == firstId);
+        REQUIRE(clip->midiNotes[0].startBeat == 2.0);
+        REQUIRE(clip->midiNotes[0].velocity == 100);
+    }
+
+    SECTION("Undoing a delete restores the note's id") {
+        undoManager.executeCommand(std::make_unique<DeleteMidiNoteCommand>(clipId, firstId));
+        REQUIRE(clip->midiNotes.size() == 1);
+        REQUIRE(clip->midiNotes.find(firstId) == nullptr);
+
+        undoManager.undo();
+        REQUIRE(clip->midiNotes.size() == 2);
+        REQUIRE(clip->midiNotes.find(firstId)->startBeat == 2.0);
+    }
+
+    undoManager.clearHistory();
+    ClipManager::getInstance().shutdown();
+}
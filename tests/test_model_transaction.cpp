@@ -0,0 +1,172 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <vector>
+
+#include "../magda/daw/core/ClipCommands.hpp"
+#include "../magda/daw/core/ClipManager.hpp"
+#include "../magda/daw/core/ModelTransaction.hpp"
+#include "../magda/daw/core/TrackManager.hpp"
+#include "../magda/daw/core/UndoManager.hpp"
+
+using namespace magda;
+
+namespace {
+
+// Counts the individual callbacks and keeps every committed change set
+class RecordingListener : public TrackManagerListener, public ClipManagerListener {
+  public:
+    RecordingListener() {
+        TrackManager::getInstance().addListener(this);
+        ClipManager::getInstance().addListener(this);
+    }
+
+    ~RecordingListener() override {
+        TrackManager::getInstance().removeListener(this);
+        ClipManager::getInstance().removeListener(this);
+    }
+
+    void tracksChanged() override {
+        tracksChangedCount++;
+    }
+
+    void trackPropertyChanged(int trackId) override {
+        trackProperties.push_back(trackId);
+    }
+
+    void clipsChanged() override {
+        clipsChangedCount++;
+    }
+
+    void clipPropertyChanged(ClipId clipId) override {
+        clipProperties.push_back(clipId);
+    }
+
+    void trackChangesCommitted(const ModelChangeSet& changes) override {
+        trackCommits.push_back(changes);
+        TrackManagerListener::trackChangesCommitted(changes);
+    }
+
+    void clipChangesCommitted(const ModelChangeSet& changes) override {
+        clipCommits.push_back(changes);
+        ClipManagerListener::clipChangesCommitted(changes);
+    }
+
+    int tracksChangedCount = 0;
+    int clipsChangedCount = 0;
+    std::vector<TrackId> trackProperties;
+    std::vector<ClipId> clipProperties;
+    std::vector<ModelChangeSet> trackCommits;
+    std::vector<ModelChangeSet> clipCommits;
+};
+
+}  // namespace
+
+TEST_CASE("IdChanges - Net effect of a transaction", "[core][transaction]") {
+    IdChanges<int> changes;
+    changes.modify(1);
+    changes.add(2);
+    changes.modify(2);
+    changes.add(3);
+    changes.remove(3);
+    changes.remove(1);
+
+    REQUIRE(changes.added == std::set<int>({2}));
+    REQUIRE(changes.removed == std::set<int>({1}));
+    REQUIRE(changes.modified.empty());
+}
+
+TEST_CASE("ModelTransaction - Notifications are deferred and coalesced", "[core][transaction]") {
+    auto& trackManager = TrackManager::getInstance();
+    auto& clipManager = ClipManager::getInstance();
+    trackManager.clearAllTracks();
+    clipManager.clearAllClips();
+    TrackId existing = trackManager.createTrack("Existing");
+
+    RecordingListener listener;
+
+    SECTION("Outside a transaction every edit notifies directly") {
+        trackManager.setTrackName(existing, "A");
+        trackManager.setTrackName(existing, "B");
+        REQUIRE(listener.trackProperties.size() == 2);
+        REQUIRE(listener.trackCommits.empty());
+    }
+
+    SECTION("One change set for a batch") {
+        TrackId added = INVALID_TRACK_ID;
+        ClipId kept = INVALID_CLIP_ID;
+        {
+            ModelTransactionScope transaction;
+            added = trackManager.createTrack("Added");
+            TrackId discarded = trackManager.createTrack("Discarded");
+            trackManager.deleteTrack(discarded);
+            trackManager.setTrackName(existing, "Renamed");
+            trackManager.setTrackName(existing, "Renamed Again");
+
+            kept = clipManager.createMidiClip(existing, 0.0, 4.0);
+            ClipId removed = clipManager.createMidiClip(existing, 4.0, 4.0);
+            clipManager.deleteClip(removed);
+
+            // The model itself is up to date straight away
+            REQUIRE(trackManager.getTrack(existing)->name == "Renamed Again");
+            REQUIRE(clipManager.getClipAtPosition(existing, 1.0) == kept);
+
+            REQUIRE(listener.tracksChangedCount == 0);
+            REQUIRE(listener.clipsChangedCount == 0);
+        }
+
+        REQUIRE(listener.trackCommits.size() == 1);
+        const auto& tracks = listener.trackCommits[0];
+        REQUIRE(tracks.trackListChanged);
+        REQUIRE(tracks.tracks.added == std::set<TrackId>({added}));
+        REQUIRE(tracks.tracks.removed.empty());
+        REQUIRE(tracks.tracks.modified == std::set<TrackId>({existing}));
+
+        REQUIRE(listener.clipCommits.size() == 1);
+        REQUIRE(listener.clipCommits[0].clips.added == std::set<ClipId>({kept}));
+        REQUIRE(listener.clipCommits[0].clips.removed.empty());
+
+        // The default replay delivers each callback once
+        REQUIRE(listener.tracksChangedCount == 1);
+        REQUIRE(listener.trackProperties == std::vector<TrackId>({existing}));
+        REQUIRE(listener.clipsChangedCount == 1);
+    }
+
+    SECTION("Nested transactions deliver at the outermost commit") {
+        {
+            ModelTransactionScope outer;
+            {
+                ModelTransactionScope inner;
+                trackManager.setTrackName(existing, "Inner");
+            }
+            REQUIRE(listener.trackCommits.empty());
+            trackManager.setTrackMuted(existing, true);
+        }
+        REQUIRE(listener.trackCommits.size() == 1);
+        REQUIRE(listener.trackProperties == std::vector<TrackId>({existing}));
+    }
+
+    SECTION("Compound operations notify once") {
+        ClipId a = clipManager.createMidiClip(existing, 0.0, 1.0);
+        ClipId b = clipManager.createMidiClip(existing, 2.0, 1.0);
+        listener.clipProperties.clear();
+
+        {
+            CompoundOperationScope scope("Move Clips");
+            UndoManager::getInstance().executeCommand(std::make_unique<MoveClipCommand>(a, 8.0));
+            UndoManager::getInstance().executeCommand(std::make_unique<MoveClipCommand>(b, 9.0));
+            REQUIRE(listener.clipProperties.empty());
+        }
+
+        REQUIRE(listener.clipCommits.size() == 1);
+        REQUIRE(listener.clipCommits[0].clips.modified == std::set<ClipId>({a, b}));
+        REQUIRE(listener.clipProperties.size() == 2);
+
+        UndoManager::getInstance().undo();
+        REQUIRE(listener.clipCommits.size() == 2);
+        REQUIRE(clipManager.getClip(a)->startTime == 0.0);
+        UndoManager::getInstance().clearHistory();
+    }
+
+    trackManager.clearAllTracks();
+    clipManager.clearAllClips();
+}
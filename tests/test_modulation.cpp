@@ -1,8 +1,11 @@
+#include <algorithm>
 #include <catch2/catch_approx.hpp>
 #include <catch2/catch_test_macros.hpp>
+#include <cmath>
 
 #include "../magda/daw/core/MacroInfo.hpp"
 #include "../magda/daw/core/ModInfo.hpp"
+#include "../magda/daw/core/ModulatorEngine.hpp"
 #include "../magda/daw/core/TrackManager.hpp"
 
 using namespace magda;
@@ -178,6 +181,106 @@ TEST_CASE("ModInfo - Link management", "[modulation][mod]") {
     }
 }
 
+TEST_CASE("ModWaveTable - Lookup matches direct evaluation", "[modulation][mod][wavetable]") {
+    auto maxErrorFor = [](const ModInfo& mod) {
+        float maxError = 0.0f;
+        for (int i = 0; i < 997; ++i) {
+            float phase = static_cast<float>(i) / 997.0f;
+            float expected = ModulatorEngine::evaluateWaveformForMod(mod, phase);
+            float actual = ModulatorEngine::generateWaveformForMod(mod, phase);
+            maxError = std::max(maxError, std::abs(expected - actual));
+        }
+        return maxError;
+    };
+
+    SECTION("Built-in smooth waveforms") {
+        ModInfo mod(0);
+        for (auto waveform : {LFOWaveform::Sine, LFOWaveform::Triangle, LFOWaveform::Saw,
+                              LFOWaveform::ReverseSaw}) {
+            mod.waveform = waveform;
+            REQUIRE(maxErrorFor(mod) < 0.001f);
+        }
+    }
+
+    SECTION("Custom preset without points") {
+        ModInfo mod(0);
+        mod.waveform = LFOWaveform::Custom;
+        for (auto preset : {CurvePreset::Sine, CurvePreset::SCurve, CurvePreset::Exponential,
+                            CurvePreset::Logarithmic}) {
+            mod.curvePreset = preset;
+            REQUIRE(maxErrorFor(mod) < 0.001f);
+        }
+    }
+
+    SECTION("Custom curve points with tension") {
+        ModInfo mod(0);
+        mod.waveform = LFOWaveform::Custom;
+        mod.curvePoints = {{0.0f, 0.0f, 1.2f}, {0.3f, 1.0f, -0.8f}, {1.0f, 0.2f, 0.0f}};
+        mod.markCurveChanged();
+        REQUIRE(maxErrorFor(mod) < 0.005f);
+    }
+}
+
+TEST_CASE("ModWaveTable - Inclusive lookup reaches the end of the cycle",
+          "[modulation][mod][wavetable]") {
+    ModInfo mod(0);
+    mod.waveform = LFOWaveform::Saw;
+    const auto& table = ModulatorEngine::getWaveTable(mod);
+
+    // Playback wraps phase 1.0 to the start of the next cycle
+    REQUIRE(table.lookup(1.0f) == Catch::Approx(0.0f).margin(0.001));
+
+    // Drawing one cycle keeps its right edge
+    REQUIRE(table.lookupInclusive(1.0f) == Catch::Approx(1.0f).margin(0.001));
+    REQUIRE(table.lookupInclusive(0.0f) == Catch::Approx(0.0f).margin(0.001));
+
+    SECTION("Custom curves end on their last point") {
+        mod.waveform = LFOWaveform::Custom;
+        mod.curvePoints = {{0.0f, 0.0f, 0.0f}, {1.0f, 0.2f, 0.0f}};
+        mod.markCurveChanged();
+        REQUIRE(ModulatorEngine::getWaveTable(mod).lookupInclusive(1.0f) ==
+                Catch::Approx(0.2f).margin(0.001));
+    }
+}
+
+TEST_CASE("ModWaveTable - Rebuilt only when the shape changes", "[modulation][mod][wavetable]") {
+    ModInfo mod(0);
+    mod.waveform = LFOWaveform::Custom;
+    mod.curvePoints = {{0.0f, 0.0f, 0.0f}, {1.0f, 1.0f, 0.0f}};
+    mod.markCurveChanged();
+
+    const auto* table = &ModulatorEngine::getWaveTable(mod);
+    REQUIRE(ModulatorEngine::generateWaveformForMod(mod, 0.5f) ==
+            Catch::Approx(0.5f).margin(0.001));
+
+    SECTION("Unchanged shape reuses the table") {
+        mod.phase = 0.7f;
+        mod.rate = 3.0f;
+        REQUIRE(&ModulatorEngine::getWaveTable(mod) == table);
+    }
+
+    SECTION("Editing points in place requires markCurveChanged") {
+        mod.curvePoints[1].value = 0.0f;
+        mod.curvePoints[0].value = 1.0f;
+        mod.markCurveChanged();
+        REQUIRE(ModulatorEngine::generateWaveformForMod(mod, 0.5f) ==
+                Catch::Approx(0.5f).margin(0.001));
+        REQUIRE(ModulatorEngine::generateWaveformForMod(mod, 0.25f) ==
+                Catch::Approx(0.75f).margin(0.001));
+    }
+
+    SECTION("Waveform change rebuilds") {
+        mod.waveform = LFOWaveform::Square;
+        REQUIRE(ModulatorEngine::generateWaveformForMod(mod, 0.25f) == Catch::Approx(1.0f));
+        REQUIRE(ModulatorEngine::generateWaveformForMod(mod, 0.75f) == Catch::Approx(0.0f));
+    }
+
+    SECTION("Copies share the compiled table") {
+        ModInfo copy = mod;
+        REQUIRE(&ModulatorEngine::getWaveTable(copy) == table);
+    }
+}
+
 // ============================================================================
 // MacroTarget and ModTarget Tests
 // ============================================================================
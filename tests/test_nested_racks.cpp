@@ -860,12 +860,187 @@ TEST_CASE("TrackManager: resolvePath", "[trackmanager][path][resolution]") {
         auto deviceId = fixture.tm().addDeviceToChainByPath(chainPath, device);
 
         auto path = chainPath.withDevice(deviceId);
-        auto resolved = fixture.tm().resolvePath(path);
+        auto displayPath = fixture.tm().getDisplayPath(path);
 
-        REQUIRE(resolved.valid);
-        REQUIRE(resolved.displayPath.contains("My Rack"));
-        REQUIRE(resolved.displayPath.contains("Chain 1"));
-        REQUIRE(resolved.displayPath.contains("Compressor"));
+        REQUIRE(displayPath == "My Rack > Chain 1 > Compressor");
+        REQUIRE(fixture.tm().getDisplayPath(ChainNodePath::rack(trackId, 9999)).isEmpty());
+    }
+
+    SECTION("Path must match the tree, not just the last ID") {
+        auto trackId = fixture.tm().createTrack("Test Track");
+        auto rackId = fixture.tm().addRackToTrack(trackId, "Test Rack");
+        auto chainId = fixture.tm().getRack(trackId, rackId)->chains[0].id;
+
+        DeviceInfo device;
+        device.name = "Test Device";
+        auto deviceId = fixture.tm().addDeviceToChainByPath(
+            ChainNodePath::chain(trackId, rackId, chainId), device);
+
+        auto& tm = fixture.tm();
+        auto devicePath = ChainNodePath::chainDevice(trackId, rackId, chainId, deviceId);
+        REQUIRE(tm.resolvePath(devicePath).valid);
+        REQUIRE_FALSE(tm.resolvePath(ChainNodePath::topLevelDevice(trackId, deviceId)).valid);
+        REQUIRE_FALSE(
+            tm.resolvePath(ChainNodePath::chainDevice(trackId, rackId, 9999, deviceId)).valid);
+    }
+}
+
+TEST_CASE("TrackManager: Device lookup by ID", "[trackmanager][device][path]") {
+    TrackManagerTestFixture fixture;
+
+    auto trackId = fixture.tm().createTrack("Test Track");
+    DeviceInfo device;
+    device.name = "Top Device";
+    auto topDeviceId = fixture.tm().addDeviceToTrack(trackId, device);
+
+    auto rackId = fixture.tm().addRackToTrack(trackId, "Rack");
+    auto chainId = fixture.tm().getRack(trackId, rackId)->chains[0].id;
+    auto chainPath = ChainNodePath::chain(trackId, rackId, chainId);
+    auto nestedRackId = fixture.tm().addRackToChainByPath(chainPath, "Nested");
+    auto nestedChainId =
+        fixture.tm().getRackByPath(chainPath.withRack(nestedRackId))->chains[0].id;
+    auto nestedChainPath = chainPath.withRack(nestedRackId).withChain(nestedChainId);
+    device.name = "Deep Device";
+    auto deepDeviceId = fixture.tm().addDeviceToChainByPath(nestedChainPath, device);
+
+    SECTION("Devices are found at any depth") {
+        REQUIRE(fixture.tm().getDeviceById(topDeviceId)->name == "Top Device");
+        REQUIRE(fixture.tm().getDeviceById(deepDeviceId)->name == "Deep Device");
+        REQUIRE(fixture.tm().getDevicePath(topDeviceId) ==
+                ChainNodePath::topLevelDevice(trackId, topDeviceId));
+        REQUIRE(fixture.tm().getDevicePath(deepDeviceId) ==
+                nestedChainPath.withDevice(deepDeviceId));
+    }
+
+    SECTION("Lookups follow moves and removals") {
+        fixture.tm().moveNode(trackId, 0, 1);
+        REQUIRE(fixture.tm().getDeviceById(topDeviceId)->name == "Top Device");
+
+        auto otherTrackId = fixture.tm().createTrack("Other Track");
+        fixture.tm().moveTrack(otherTrackId, 0);
+        REQUIRE(fixture.tm().getDeviceById(deepDeviceId)->name == "Deep Device");
+
+        fixture.tm().removeRackFromTrack(trackId, rackId);
+        REQUIRE(fixture.tm().getDeviceById(deepDeviceId) == nullptr);
+        REQUIRE_FALSE(fixture.tm().getDevicePath(deepDeviceId).isValid());
+        REQUIRE(fixture.tm().getDeviceById(topDeviceId) != nullptr);
+    }
+}
+
+TEST_CASE("TrackManager: Lookups never write into a shared chain",
+          "[trackmanager][device][path]") {
+    TrackManagerTestFixture fixture;
+
+    auto trackId = fixture.tm().createTrack("Test Track");
+    DeviceInfo device;
+    device.name = "Top Device";
+    auto topDeviceId = fixture.tm().addDeviceToTrack(trackId, device);
+    auto rackId = fixture.tm().addRackToTrack(trackId, "Rack");
+    auto chainId = fixture.tm().getRack(trackId, rackId)->chains[0].id;
+    auto chainPath = ChainNodePath::chain(trackId, rackId, chainId);
+    device.name = "Nested Device";
+    auto nestedDeviceId = fixture.tm().addDeviceToChainByPath(chainPath, device);
+
+    // Index the chain, then share it the way undo commands and project captures do
+    REQUIRE(fixture.tm().getDeviceById(topDeviceId) != nullptr);
+    auto snapshot = *fixture.tm().getTrack(trackId);
+    REQUIRE(snapshot.chainElements.sharesBufferWith(fixture.tm().getTrack(trackId)->chainElements));
+
+    SECTION("Writes detach the live chain first") {
+        fixture.tm().setDeviceBypassed(trackId, topDeviceId, true);
+        fixture.tm().setDeviceInChainBypassedByPath(chainPath.withDevice(nestedDeviceId), true);
+        fixture.tm().setRackBypassed(trackId, rackId, true);
+
+        REQUIRE(fixture.tm().getDeviceById(topDeviceId)->bypassed);
+        REQUIRE(fixture.tm().getRack(trackId, rackId)->bypassed);
+        REQUIRE_FALSE(getDevice(snapshot.chainElements[0]).bypassed);
+        REQUIRE_FALSE(getRack(snapshot.chainElements[1]).bypassed);
+        REQUIRE_FALSE(getDevice(getRack(snapshot.chainElements[1]).chains[0].elements[0]).bypassed);
+    }
+
+    SECTION("Removing something that isn't there leaves the index usable") {
+        fixture.tm().removeDeviceFromTrack(trackId, 9999);
+        fixture.tm().removeRackFromTrack(trackId, 9999);
+        fixture.tm().removeDeviceFromChainByPath(chainPath.withDevice(9999));
+
+        fixture.tm().getDeviceById(nestedDeviceId)->name = "Renamed";
+        const auto& live = fixture.tm().getChainElements(trackId);
+        REQUIRE(getDevice(getRack(live[1]).chains[0].elements[0]).name == "Renamed");
+        REQUIRE(getDevice(getRack(snapshot.chainElements[1]).chains[0].elements[0]).name ==
+                "Nested Device");
+    }
+}
+
+TEST_CASE("TrackManager: Chain graph", "[trackmanager][chain][graph]") {
+    TrackManagerTestFixture fixture;
+
+    auto trackId = fixture.tm().createTrack("Test Track");
+    DeviceInfo device;
+    device.name = "Top Device";
+    auto topDeviceId = fixture.tm().addDeviceToTrack(trackId, device);
+
+    auto rackId = fixture.tm().addRackToTrack(trackId, "Rack");
+    auto chainId = fixture.tm().getRack(trackId, rackId)->chains[0].id;
+    auto chainPath = ChainNodePath::chain(trackId, rackId, chainId);
+    auto nestedRackId = fixture.tm().addRackToChainByPath(chainPath, "Nested");
+    auto nestedChainId =
+        fixture.tm().getRackByPath(chainPath.withRack(nestedRackId))->chains[0].id;
+    auto nestedChainPath = chainPath.withRack(nestedRackId).withChain(nestedChainId);
+    device.name = "Deep Device";
+    auto deepDeviceId = fixture.tm().addDeviceToChainByPath(nestedChainPath, device);
+
+    const auto* graph = fixture.tm().getChainGraph(trackId);
+    REQUIRE(graph != nullptr);
+
+    SECTION("Nodes are laid out depth-first with subtree ranges") {
+        REQUIRE(graph->nodes.size() == 6);
+        const auto& nodes = graph->nodes;
+
+        REQUIRE(nodes[0].id == topDeviceId);
+        REQUIRE(nodes[0].parent == ChainGraph::npos);
+        REQUIRE(nodes[0].end == 1);
+
+        REQUIRE(nodes[1].type == ChainStepType::Rack);
+        REQUIRE(nodes[1].end == 6);
+        REQUIRE(nodes[3].id == nestedRackId);
+        REQUIRE(nodes[3].parent == 2);
+        REQUIRE(nodes[3].end == 6);
+
+        REQUIRE(nodes[5].id == deepDeviceId);
+        REQUIRE(nodes[5].depth == 4);
+        REQUIRE(nodes[5].chain == fixture.tm().getRackByPath(chainPath.withRack(nestedRackId))
+                                      ->chains.data());
+        REQUIRE(graph->getPath(5) == nestedChainPath.withDevice(deepDeviceId));
+        REQUIRE(graph->getPath(0) == ChainNodePath::topLevelDevice(trackId, topDeviceId));
+    }
+
+    SECTION("Mods and macros are gathered per node") {
+        const auto& top = graph->nodes[0];
+        REQUIRE(top.modsEnd - top.modsBegin == NUM_MODS);
+        REQUIRE(graph->mods[top.modsBegin] == &fixture.tm().getDeviceById(topDeviceId)->mods[0]);
+
+        const auto& chain = graph->nodes[2];
+        REQUIRE(chain.modsBegin == chain.modsEnd);
+        REQUIRE(chain.macrosBegin == chain.macrosEnd);
+
+        REQUIRE(graph->mods.size() == 4 * NUM_MODS);
+        REQUIRE(graph->macros.size() == 4 * NUM_MACROS);
+    }
+
+    SECTION("Adding a mod rebuilds the graph") {
+        fixture.tm().addDeviceMod(nestedChainPath.withDevice(deepDeviceId), 0, ModType::LFO,
+                                  LFOWaveform::Sine);
+        graph = fixture.tm().getChainGraph(trackId);
+        REQUIRE(graph->mods.size() == 4 * NUM_MODS + 1);
+
+        const auto& deep = graph->nodes[5];
+        REQUIRE(graph->mods[deep.modsBegin] ==
+                &fixture.tm().getDeviceById(deepDeviceId)->mods[0]);
+    }
+
+    SECTION("Removed tracks have no graph") {
+        fixture.tm().deleteTrack(trackId);
+        REQUIRE(fixture.tm().getChainGraph(trackId) == nullptr);
     }
 }
 
@@ -0,0 +1,110 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <random>
+
+#include "../magda/daw/core/NoteSpatialIndex.hpp"
+
+using namespace magda;
+
+namespace {
+
+MidiNote makeNote(int noteNumber, double startBeat, double lengthBeats) {
+    MidiNote note;
+    note.noteNumber = noteNumber;
+    note.startBeat = startBeat;
+    note.lengthBeats = lengthBeats;
+    return note;
+}
+
+// Reference answer: every note, checked one by one
+std::vector<size_t> linearQuery(const std::vector<MidiNote>& notes, double startBeat,
+                                double endBeat, int lowNote, int highNote) {
+    std::vector<size_t> results;
+    for (size_t i = 0; i < notes.size(); ++i) {
+        const auto& note = notes[i];
+        if (note.noteNumber >= lowNote && note.noteNumber <= highNote &&
+            note.startBeat < endBeat && note.startBeat + note.lengthBeats > startBeat) {
+            results.push_back(i);
+        }
+    }
+    return results;
+}
+
+}  // namespace
+
+TEST_CASE("NoteSpatialIndex - Rectangle queries", "[pianoroll][notes]") {
+    std::vector<MidiNote> notes;
+    notes.push_back(makeNote(60, 0.0, 1.0));   // 0
+    notes.push_back(makeNote(62, 1.0, 1.0));   // 1
+    notes.push_back(makeNote(60, 4.0, 0.5));   // 2
+    notes.push_back(makeNote(64, 0.0, 64.0));  // 3: long held note
+    notes.push_back(makeNote(60, 8.0, 1.0));   // 4
+
+    NoteSpatialIndex index;
+    index.rebuild(notes);
+    REQUIRE(index.size() == notes.size());
+
+    std::vector<size_t> results;
+
+    SECTION("Pitch and time both restrict the result") {
+        index.query(0.0, 2.0, 60, 62, results);
+        REQUIRE(results == std::vector<size_t>({0, 1}));
+
+        index.query(3.0, 10.0, 60, 60, results);
+        REQUIRE(results == std::vector<size_t>({2, 4}));
+    }
+
+    SECTION("Query edges are half-open in time") {
+        index.query(1.0, 4.0, 60, 60, results);
+        REQUIRE(results.empty());
+    }
+
+    SECTION("Long notes are found far from their start") {
+        index.query(40.0, 41.0, 0, 127, results);
+        REQUIRE(results == std::vector<size_t>({3}));
+    }
+
+    SECTION("Short notes count as at least the minimum length") {
+        index.query(4.6, 4.7, 60, 60, results);
+        REQUIRE(results.empty());
+
+        index.query(4.6, 4.7, 60, 60, results, 1.0);
+        REQUIRE(results == std::vector<size_t>({2}));
+    }
+
+    SECTION("Clear empties the index") {
+        index.clear();
+        REQUIRE(index.size() == 0);
+        index.query(0.0, 100.0, 0, 127, results);
+        REQUIRE(results.empty());
+    }
+}
+
+TEST_CASE("NoteSpatialIndex - Matches a linear scan on large clips", "[pianoroll][notes]") {
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int> pitch(0, 127);
+    std::uniform_real_distribution<double> start(0.0, 4096.0);
+    std::uniform_real_distribution<double> length(0.05, 4.0);
+
+    std::vector<MidiNote> notes;
+    for (int i = 0; i < 100000; ++i) {
+        // An occasional very long note exercises the long-note list
+        double noteLength = i % 1000 == 0 ? 200.0 : length(rng);
+        notes.push_back(makeNote(pitch(rng), start(rng), noteLength));
+    }
+
+    NoteSpatialIndex index;
+    index.rebuild(notes);
+
+    std::vector<size_t> results;
+    for (int i = 0; i < 50; ++i) {
+        double queryStart = start(rng);
+        double queryEnd = queryStart + 16.0;
+        int low = pitch(rng);
+        int high = std::min(127, low + 24);
+
+        index.query(queryStart, queryEnd, low, high, results);
+        REQUIRE(results == linearQuery(notes, queryStart, queryEnd, low, high));
+    }
+}
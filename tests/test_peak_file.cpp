@@ -0,0 +1,146 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include <cstring>
+
+#include "../magda/daw/audio/AudioThumbnailManager.hpp"
+#include "../magda/daw/audio/PeakFile.hpp"
+#include "../magda/daw/audio/WaveformTileCache.hpp"
+
+using namespace magda;
+using Catch::Matchers::WithinAbs;
+
+namespace {
+
+constexpr int NUM_SAMPLES = 48000;
+
+// Left: 0.5 for the first half, -0.25 after. Right: silence with one spike.
+juce::File writeTestWav(const juce::File& file) {
+    juce::AudioBuffer<float> buffer(2, NUM_SAMPLES);
+    buffer.clear();
+    for (int i = 0; i < NUM_SAMPLES; ++i)
+        buffer.setSample(0, i, i < NUM_SAMPLES / 2 ? 0.5f : -0.25f);
+    buffer.setSample(1, 1000, 0.9f);
+
+    file.deleteFile();
+    juce::WavAudioFormat wav;
+    std::unique_ptr<juce::AudioFormatWriter> writer(
+        wav.createWriterFor(new juce::FileOutputStream(file), 48000.0, 2, 16, {}, 0));
+    REQUIRE(writer != nullptr);
+    REQUIRE(writer->writeFromAudioSampleBuffer(buffer, 0, NUM_SAMPLES));
+    return file;
+}
+
+std::unique_ptr<juce::AudioFormatReader> openWav(const juce::File& file) {
+    juce::WavAudioFormat wav;
+    return std::unique_ptr<juce::AudioFormatReader>(
+        wav.createReaderFor(new juce::FileInputStream(file), true));
+}
+
+}  // namespace
+
+TEST_CASE("PeakFile - Build and read a pyramid", "[audio][peaks]") {
+    auto dir = juce::File::createTempFile("peaks");
+    REQUIRE(dir.createDirectory());
+    auto wavFile = writeTestWav(dir.getChildFile("test.wav"));
+    auto peakFile = dir.getChildFile("test.peaks");
+
+    auto reader = openWav(wavFile);
+    REQUIRE(reader != nullptr);
+    std::atomic<bool> cancelled{false};
+    REQUIRE(PeakFile::build(*reader, peakFile, cancelled));
+
+    auto peaks = PeakFile::open(peakFile);
+    REQUIRE(peaks != nullptr);
+    REQUIRE(peaks->getNumChannels() == 2);
+    REQUIRE(peaks->getLengthInSamples() == NUM_SAMPLES);
+    REQUIRE_THAT(peaks->getLengthInSeconds(), WithinAbs(1.0, 1e-9));
+    REQUIRE(peaks->getNumLevels() > 1);
+    REQUIRE(peaks->getSamplesPerPeak(0) == PeakFile::BASE_SAMPLES_PER_PEAK);
+    REQUIRE(peaks->getSamplesPerPeak(1) == PeakFile::BASE_SAMPLES_PER_PEAK * 4);
+    REQUIRE(peaks->getNumPeaks(0) == NUM_SAMPLES / PeakFile::BASE_SAMPLES_PER_PEAK);
+
+    SECTION("Every level summarises the same audio") {
+        for (int level = 0; level < peaks->getNumLevels(); ++level) {
+            auto left = peaks->getPeak(level, 0, 0, peaks->getNumPeaks(level));
+            REQUIRE_THAT(left.max, WithinAbs(0.5, 1e-3));
+            REQUIRE_THAT(left.min, WithinAbs(-0.25, 1e-3));
+
+            auto right = peaks->getPeak(level, 1, 0, peaks->getNumPeaks(level));
+            REQUIRE_THAT(right.max, WithinAbs(0.9, 1e-3));
+        }
+    }
+
+    SECTION("RMS of a constant run is its level") {
+        auto firstHalf = peaks->getPeak(0, 0, 0, 100);
+        REQUIRE_THAT(firstHalf.rms, WithinAbs(0.5, 1e-3));
+    }
+
+    SECTION("Level choice follows samples per pixel") {
+        REQUIRE(peaks->chooseLevel(10.0) == -1);
+        REQUIRE(peaks->chooseLevel(64.0) == 0);
+        REQUIRE(peaks->chooseLevel(300.0) == 1);
+        REQUIRE(peaks->chooseLevel(1.0e9) == peaks->getNumLevels() - 1);
+    }
+
+    SECTION("The header can't be mistaken for a project file") {
+        juce::MemoryBlock bytes;
+        REQUIRE(peakFile.loadFileAsData(bytes));
+        REQUIRE(bytes.getSize() >= 4);
+        REQUIRE(std::memcmp(bytes.getData(), "MGPK", 4) == 0);
+    }
+
+    SECTION("Truncated files are rejected") {
+        peaks.reset();
+        juce::MemoryBlock bytes;
+        REQUIRE(peakFile.loadFileAsData(bytes));
+        bytes.setSize(bytes.getSize() - 10);
+        REQUIRE(peakFile.replaceWithData(bytes.getData(), bytes.getSize()));
+        REQUIRE(PeakFile::open(peakFile) == nullptr);
+    }
+
+    SECTION("A cancelled build leaves nothing behind") {
+        auto other = dir.getChildFile("cancelled.peaks");
+        cancelled.store(true);
+        REQUIRE_FALSE(PeakFile::build(*reader, other, cancelled));
+        REQUIRE_FALSE(other.exists());
+        REQUIRE_FALSE(other.getSiblingFile("cancelled.peaks.tmp").exists());
+    }
+
+    peaks.reset();
+    reader.reset();
+    dir.deleteRecursively();
+}
+
+TEST_CASE("AudioThumbnailManager - Peak file names", "[audio][peaks]") {
+    auto dir = juce::File::createTempFile("peaknames");
+    REQUIRE(dir.createDirectory());
+    auto wavFile = writeTestWav(dir.getChildFile("Kick.wav"));
+
+    auto name = AudioThumbnailManager::getPeakFileName(wavFile);
+    REQUIRE(name.startsWith("Kick_"));
+    REQUIRE(name.endsWith(".peaks"));
+    REQUIRE(AudioThumbnailManager::getPeakFileName(wavFile) == name);
+
+    // Rewriting the audio changes the key, so stale peaks are never reused
+    REQUIRE(wavFile.setLastModificationTime(juce::Time(2000, 0, 1, 0, 0)));
+    REQUIRE(AudioThumbnailManager::getPeakFileName(wavFile) != name);
+
+    auto project = dir.getChildFile("Song.magda");
+    REQUIRE(AudioThumbnailManager::getProjectPeakDirectory(project) == dir.getChildFile("Peaks"));
+
+    dir.deleteRecursively();
+}
+
+TEST_CASE("WaveformTileCache - Zoom buckets", "[audio][peaks]") {
+    // Powers of two land exactly on a bucket
+    REQUIRE(WaveformTileCache::getZoomBucket(256.0) == 8 * WaveformTileCache::BUCKETS_PER_OCTAVE);
+    REQUIRE_THAT(WaveformTileCache::getBucketSamplesPerPixel(32), WithinAbs(256.0, 1e-9));
+
+    // Any zoom is within half a bucket of its tile resolution
+    for (double samplesPerPixel : {70.0, 123.4, 999.0, 44100.0}) {
+        auto bucket = WaveformTileCache::getZoomBucket(samplesPerPixel);
+        auto ratio = WaveformTileCache::getBucketSamplesPerPixel(bucket) / samplesPerPixel;
+        REQUIRE(ratio > 0.91);
+        REQUIRE(ratio < 1.1);
+    }
+}
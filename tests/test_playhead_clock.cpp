@@ -0,0 +1,96 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <thread>
+
+#include "../magda/daw/audio/PlayheadClock.hpp"
+
+using namespace magda;
+
+namespace {
+
+PlayheadClock::Snapshot makeSnapshot(juce::int64 sample, juce::int64 ticks, bool playing) {
+    PlayheadClock::Snapshot snapshot;
+    snapshot.sample = sample;
+    snapshot.ticks = ticks;
+    snapshot.sampleRate = 48000.0;
+    snapshot.playing = playing;
+    return snapshot;
+}
+
+}  // namespace
+
+TEST_CASE("PlayheadClock - Publish and read", "[audio][playhead]") {
+    PlayheadClock clock;
+    PlayheadClock::Snapshot snapshot;
+
+    SECTION("Nothing to read before the first publish") {
+        REQUIRE_FALSE(clock.read(snapshot));
+    }
+
+    SECTION("Reads the latest snapshot") {
+        clock.publish(makeSnapshot(1000, 5, true));
+        clock.publish(makeSnapshot(2000, 6, false));
+
+        REQUIRE(clock.read(snapshot));
+        REQUIRE(snapshot.sample == 2000);
+        REQUIRE(snapshot.ticks == 6);
+        REQUIRE(snapshot.sampleRate == 48000.0);
+        REQUIRE_FALSE(snapshot.playing);
+    }
+}
+
+TEST_CASE("PlayheadClock - Extrapolation", "[audio][playhead]") {
+    auto ticksPerSecond = juce::Time::getHighResolutionTicksPerSecond();
+
+    SECTION("A playing snapshot advances with time") {
+        auto snapshot = makeSnapshot(48000, 0, true);
+        REQUIRE(snapshot.getPositionAt(0, 1.0) == 1.0);
+        REQUIRE(snapshot.getPositionAt(ticksPerSecond / 2, 1.0) == 1.5);
+    }
+
+    SECTION("Extrapolation is capped") {
+        auto snapshot = makeSnapshot(48000, 0, true);
+        REQUIRE(snapshot.getPositionAt(ticksPerSecond * 10, 0.1) == 1.1);
+    }
+
+    SECTION("Never runs backwards from the snapshot") {
+        auto snapshot = makeSnapshot(48000, ticksPerSecond, true);
+        REQUIRE(snapshot.getPositionAt(0, 0.1) == 1.0);
+    }
+
+    SECTION("A stopped snapshot holds its position") {
+        auto snapshot = makeSnapshot(48000, 0, false);
+        REQUIRE(snapshot.getPositionAt(ticksPerSecond, 0.1) == 1.0);
+    }
+
+    SECTION("Latency compensation before the start clamps to zero") {
+        auto snapshot = makeSnapshot(-480, 0, true);
+        REQUIRE(snapshot.getPositionAt(0, 0.1) == 0.0);
+    }
+}
+
+TEST_CASE("PlayheadClock - Concurrent readers see whole snapshots", "[audio][playhead]") {
+    PlayheadClock clock;
+    std::atomic<bool> done{false};
+
+    // Every published snapshot has ticks == sample, so a torn read would show a mismatch
+    std::thread writer([&clock, &done] {
+        for (juce::int64 i = 1; i <= 100000; ++i) {
+            clock.publish(makeSnapshot(i, i, true));
+        }
+        done.store(true);
+    });
+
+    bool consistent = true;
+    PlayheadClock::Snapshot snapshot;
+    while (!done.load()) {
+        if (clock.read(snapshot) && snapshot.sample != snapshot.ticks) {
+            consistent = false;
+        }
+    }
+    writer.join();
+
+    REQUIRE(consistent);
+    REQUIRE(clock.read(snapshot));
+    REQUIRE(snapshot.sample == 100000);
+}
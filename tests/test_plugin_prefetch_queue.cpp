@@ -0,0 +1,98 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "../magda/daw/audio/PluginPrefetchQueue.hpp"
+
+using namespace magda;
+
+namespace {
+
+juce::PluginDescription makeDescription(const juce::String& fileOrIdentifier) {
+    juce::PluginDescription desc;
+    desc.name = "Test Plugin";
+    desc.pluginFormatName = "VST3";
+    desc.fileOrIdentifier = fileOrIdentifier;
+    return desc;
+}
+
+}  // namespace
+
+TEST_CASE("PluginPrefetchQueue - Finds module binaries to prefetch", "[plugin][load]") {
+    auto root = juce::File::getSpecialLocation(juce::File::tempDirectory)
+                    .getChildFile("magda_load_queue_test");
+    root.deleteRecursively();
+
+    SECTION("Bundle returns platform binaries only") {
+        auto bundle = root.getChildFile("Synth.vst3");
+        REQUIRE(bundle.getChildFile("Contents/MacOS/Synth").create().wasOk());
+        REQUIRE(bundle.getChildFile("Contents/x86_64-linux/Synth.so").create().wasOk());
+        REQUIRE(bundle.getChildFile("Contents/Resources/preset.xml").create().wasOk());
+
+        auto files =
+            PluginPrefetchQueue::findModuleFiles(makeDescription(bundle.getFullPathName()));
+        REQUIRE(files.size() == 2);
+        for (const auto& file : files)
+            REQUIRE(file.getParentDirectory().getFileName() != "Resources");
+    }
+
+    SECTION("Single file module is returned as-is") {
+        auto module = root.getChildFile("Effect.vst3");
+        REQUIRE(module.create().wasOk());
+
+        auto files =
+            PluginPrefetchQueue::findModuleFiles(makeDescription(module.getFullPathName()));
+        REQUIRE(files.size() == 1);
+        REQUIRE(files[0] == module);
+    }
+
+    SECTION("Non-file identifiers have nothing to prefetch") {
+        auto files = PluginPrefetchQueue::findModuleFiles(makeDescription("AudioUnit:Synths/aumu"));
+        REQUIRE(files.isEmpty());
+    }
+
+    root.deleteRecursively();
+}
+
+TEST_CASE("PluginPrefetchQueue - Prefetch reads files and honours cancellation", "[plugin][load]") {
+    auto file = juce::File::createTempFile(".bin");
+    juce::MemoryBlock data(3 * 1024 * 1024, true);
+    REQUIRE(file.replaceWithData(data.getData(), data.getSize()));
+
+    std::atomic<bool> cancelled{false};
+    REQUIRE(PluginPrefetchQueue::prefetchFiles({file}, cancelled) ==
+            static_cast<juce::int64>(data.getSize()));
+
+    cancelled = true;
+    REQUIRE(PluginPrefetchQueue::prefetchFiles({file}, cancelled) == 0);
+
+    file.deleteFile();
+}
+
+TEST_CASE("PluginPrefetchQueue - Pending requests can be cancelled", "[plugin][load]") {
+    PluginPrefetchQueue queue([](const PluginPrefetchQueue::Request&) {});
+
+    queue.enqueue({1, 10, makeDescription("/does/not/exist.vst3")});
+    queue.enqueue({2, 10, makeDescription("/does/not/exist.vst3")});
+    queue.enqueue({3, 20, makeDescription("/does/not/exist.vst3")});
+    REQUIRE(queue.getNumPending() == 3);
+    REQUIRE(queue.isPending(2));
+
+    SECTION("Cancel a single device") {
+        queue.cancel(2);
+        REQUIRE_FALSE(queue.isPending(2));
+        REQUIRE(queue.getNumPending() == 2);
+    }
+
+    SECTION("Cancel a whole track") {
+        queue.cancelTrack(10);
+        REQUIRE(queue.getPendingDevices(10).empty());
+        REQUIRE(queue.getPendingDevices(20) == std::vector<DeviceId>{3});
+    }
+
+    SECTION("Re-queueing a device replaces its request") {
+        queue.enqueue({1, 10, makeDescription("/other.vst3")});
+        REQUIRE(queue.getNumPending() == 3);
+    }
+
+    queue.cancelAll();
+    REQUIRE(queue.getNumPending() == 0);
+}
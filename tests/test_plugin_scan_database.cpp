@@ -0,0 +1,113 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "../magda/daw/engine/PluginScanDatabase.hpp"
+
+using namespace magda;
+
+namespace {
+
+juce::PluginDescription makePlugin(const juce::String& name, const juce::String& file) {
+    juce::PluginDescription desc;
+    desc.name = name;
+    desc.pluginFormatName = "VST3";
+    desc.manufacturerName = "Test";
+    desc.fileOrIdentifier = file;
+    desc.uniqueId = 1234;
+    return desc;
+}
+
+}  // namespace
+
+TEST_CASE("PluginScanDatabase - Stamp decides whether a file is rescanned", "[plugin][scan]") {
+    PluginScanDatabase db;
+    PluginScanDatabase::FileStamp stamp{1000, 2048};
+    db.update("/plugins/Synth.vst3", stamp, {makePlugin("Synth", "/plugins/Synth.vst3")});
+
+    SECTION("Unchanged file is served from the cache") {
+        auto* cached = db.findUpToDate("/plugins/Synth.vst3", stamp);
+        REQUIRE(cached != nullptr);
+        REQUIRE(cached->size() == 1);
+        REQUIRE(cached->getReference(0).name == "Synth");
+    }
+
+    SECTION("Modified or unknown files must be scanned") {
+        REQUIRE(db.findUpToDate("/plugins/Synth.vst3", {1001, 2048}) == nullptr);
+        REQUIRE(db.findUpToDate("/plugins/Synth.vst3", {1000, 4096}) == nullptr);
+        REQUIRE(db.findUpToDate("/plugins/Other.vst3", stamp) == nullptr);
+    }
+
+    SECTION("Removed and uninstalled files are forgotten") {
+        db.update("/plugins/Gone.vst3", stamp, {});
+        db.retainOnly({"/plugins/Synth.vst3"});
+        REQUIRE(db.size() == 1);
+
+        db.remove("/plugins/Synth.vst3");
+        REQUIRE(db.size() == 0);
+    }
+}
+
+TEST_CASE("PluginScanDatabase - Save and load round trip", "[plugin][scan]") {
+    auto file = juce::File::createTempFile(".xml");
+
+    PluginScanDatabase::FileStamp stamp{1234567890123, 42};
+    {
+        PluginScanDatabase db;
+        db.update("/plugins/A.vst3", stamp,
+                  {makePlugin("A1", "/plugins/A.vst3"), makePlugin("A2", "/plugins/A.vst3")});
+        db.update("/plugins/Empty.vst3", stamp, {});
+        REQUIRE(db.saveToFile(file));
+    }
+
+    PluginScanDatabase loaded;
+    REQUIRE(loaded.loadFromFile(file));
+    REQUIRE(loaded.size() == 2);
+
+    auto* cached = loaded.findUpToDate("/plugins/A.vst3", stamp);
+    REQUIRE(cached != nullptr);
+    REQUIRE(cached->size() == 2);
+    REQUIRE(cached->getReference(1).name == "A2");
+
+    // Files that produced no plugins stay cached as empty so they are not rescanned
+    auto* empty = loaded.findUpToDate("/plugins/Empty.vst3", stamp);
+    REQUIRE(empty != nullptr);
+    REQUIRE(empty->isEmpty());
+
+    file.deleteFile();
+}
+
+TEST_CASE("PluginScanDatabase - Stamps of missing files are zero", "[plugin][scan]") {
+    auto stamp = PluginScanDatabase::stampFor("/does/not/exist.vst3");
+    REQUIRE(stamp == PluginScanDatabase::FileStamp{});
+
+    // AudioUnit-style identifiers are not paths
+    REQUIRE(PluginScanDatabase::stampFor("AudioUnit:Synths/aumu,abcd,efgh") ==
+            PluginScanDatabase::FileStamp{});
+}
+
+TEST_CASE("PluginScanDatabase - Bundles are stamped from their contents", "[plugin][scan]") {
+    auto bundle = juce::File::createTempFile(".vst3");
+    auto binary = bundle.getChildFile("Contents/x86_64-linux/Synth.so");
+    REQUIRE(binary.create().wasOk());
+    REQUIRE(binary.replaceWithText("version 1"));
+
+    const juce::Time bundleTime(2020, 0, 1, 0, 0);
+    REQUIRE(bundle.setLastModificationTime(bundleTime));
+    auto before = PluginScanDatabase::stampFor(bundle.getFullPathName());
+    REQUIRE(before.size == binary.getSize());
+
+    SECTION("Replacing the binary changes the stamp") {
+        REQUIRE(binary.replaceWithText("version 2 is longer"));
+        REQUIRE(bundle.setLastModificationTime(bundleTime));
+        REQUIRE(PluginScanDatabase::stampFor(bundle.getFullPathName()) != before);
+    }
+
+    SECTION("Resources are ignored") {
+        auto resource = bundle.getChildFile("Contents/Resources/preset.xml");
+        REQUIRE(resource.create().wasOk());
+        REQUIRE(resource.replaceWithText("<preset/>"));
+        REQUIRE(resource.setLastModificationTime(juce::Time::getCurrentTime()));
+        REQUIRE(PluginScanDatabase::stampFor(bundle.getFullPathName()) == before);
+    }
+
+    bundle.deleteRecursively();
+}
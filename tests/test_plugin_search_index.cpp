@@ -0,0 +1,87 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <vector>
+
+#include "../magda/daw/core/PluginSearchIndex.hpp"
+
+using namespace magda;
+
+namespace {
+
+std::vector<PluginSearchIndex::Entry> makeEntries() {
+    return {
+        {"Pro-Q 3", "FabFilter", "Effect", "EQ", "VST3", "proq"},
+        {"Pro-C 2", "FabFilter", "Effect", "Dynamics", "VST3", "proc"},
+        {"Serum", "Xfer Records", "Instrument", "Synth", "VST3", "serum"},
+        {"4OSC Synth", "MAGDA", "Instrument", "Synth", "Internal", "4osc"},
+        {"Equator", "Acme", "Effect", "EQ", "AU", "equator"},
+    };
+}
+
+juce::StringArray names(const std::vector<PluginSearchIndex::Entry>& entries,
+                        const std::vector<PluginSearchIndex::Match>& matches) {
+    juce::StringArray result;
+    for (const auto& match : matches) {
+        result.add(entries[match.entry].name);
+    }
+    return result;
+}
+
+}  // namespace
+
+TEST_CASE("PluginSearchIndex - Matching", "[plugins][search]") {
+    auto entries = makeEntries();
+    PluginSearchIndex index(entries);
+    REQUIRE(index.size() == entries.size());
+
+    SECTION("Empty query matches nothing") {
+        REQUIRE(index.search("").empty());
+        REQUIRE(index.search("   ").empty());
+    }
+
+    SECTION("Case-insensitive across fields") {
+        REQUIRE(names(entries, index.search("SERUM")) == juce::StringArray("Serum"));
+        REQUIRE(names(entries, index.search("xfer")) == juce::StringArray("Serum"));
+        REQUIRE(index.search("vst3").size() == 3);
+    }
+
+    SECTION("Every word must match") {
+        REQUIRE(names(entries, index.search("fabfilter eq")) == juce::StringArray("Pro-Q 3"));
+        REQUIRE(index.search("fabfilter synth").empty());
+    }
+
+    SECTION("Tolerates typos") {
+        auto matches = names(entries, index.search("fabfiltre"));
+        REQUIRE(matches.size() == 2);
+        REQUIRE(matches.contains("Pro-Q 3"));
+        REQUIRE(matches.contains("Pro-C 2"));
+    }
+
+    SECTION("Short words match as subsequences") {
+        REQUIRE(names(entries, index.search("pq")) == juce::StringArray("Pro-Q 3"));
+    }
+
+    SECTION("No match") {
+        REQUIRE(index.search("zzzz").empty());
+    }
+}
+
+TEST_CASE("PluginSearchIndex - Ranking", "[plugins][search]") {
+    auto entries = makeEntries();
+    PluginSearchIndex index(entries);
+
+    SECTION("Name prefix beats a match in another field") {
+        // "Equator" starts with "eq"; Pro-Q 3 only has it as its subcategory
+        auto matches = names(entries, index.search("eq"));
+        REQUIRE(matches.size() == 2);
+        REQUIRE(matches[0] == "Equator");
+    }
+
+    SECTION("Recently used plugins are boosted") {
+        auto matches = names(entries, index.search("synth"));
+        REQUIRE(matches[0] == "4OSC Synth");
+
+        matches = names(entries, index.search("synth", juce::StringArray("serum")));
+        REQUIRE(matches[0] == "Serum");
+    }
+}
@@ -0,0 +1,291 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+#include "../magda/daw/core/AutomationManager.hpp"
+#include "../magda/daw/core/ClipManager.hpp"
+#include "../magda/daw/core/ProjectFile.hpp"
+
+using namespace magda;
+using Catch::Matchers::WithinAbs;
+
+namespace {
+
+ProjectData makeProject() {
+    ProjectData data;
+    data.master.volume = 0.8f;
+    data.master.muted = true;
+
+    TrackInfo track;
+    track.id = 3;
+    track.type = TrackType::Instrument;
+    track.name = "Lead";
+    track.colour = juce::Colour(0xFF112233);
+    track.volume = 0.5f;
+    track.pan = -0.25f;
+    track.audioOutputDevice = "master";
+    track.viewSettings.setHeight(ViewMode::Arrange, 120);
+
+    DeviceInfo synth;
+    synth.id = 10;
+    synth.name = "Synth";
+    synth.format = PluginFormat::Internal;
+    synth.parameters.push_back(ParameterInfo());
+    synth.parameters.setCurrentValue(0, 0.75f);
+    synth.mods[0].links.push_back({{10, 0}, 0.3f});
+    track.chainElements.push_back(makeDeviceElement(synth));
+
+    RackInfo rack;
+    rack.id = 20;
+    rack.name = "FX Rack";
+    ChainInfo chain;
+    chain.id = 30;
+    chain.name = "Chain 1";
+    DeviceInfo delay;
+    delay.id = 11;
+    delay.name = "Delay";
+    delay.bypassed = true;
+    chain.elements.push_back(makeDeviceElement(delay));
+    rack.chains.push_back(std::move(chain));
+    track.chainElements.push_back(makeRackElement(std::move(rack)));
+    data.tracks.push_back(std::move(track));
+
+    ClipInfo clip;
+    clip.id = 5;
+    clip.trackId = 3;
+    clip.name = "Riff";
+    clip.startTime = 2.0;
+    clip.length = 8.0;
+    for (int i = 0; i < 100; ++i) {
+        clip.midiNotes.add({60 + i % 12, 100, i * 0.25, 0.25});
+    }
+    data.clips.push_back(clip);
+
+    ClipInfo audio;
+    audio.id = 6;
+    audio.trackId = 3;
+    audio.type = ClipType::Audio;
+    audio.audioSources.push_back({"/audio/loop.wav", 0.0, 0.5, 4.0, 1.0});
+    data.clips.push_back(audio);
+
+    AutomationLaneInfo lane;
+    lane.id = 1;
+    lane.target.type = AutomationTargetType::TrackVolume;
+    lane.target.trackId = 3;
+    AutomationPoint point;
+    point.id = 7;
+    point.time = 1.5;
+    point.value = 0.25;
+    point.curveType = AutomationCurveType::Bezier;
+    point.outHandle.time = 0.1;
+    lane.absolutePoints.push_back(point);
+    data.automationLanes.push_back(lane);
+    data.nextAutomationPointId = 8;
+
+    juce::MemoryBlock state("plugin-state", 12);
+    data.pluginStates[10] = state;
+    return data;
+}
+
+}  // namespace
+
+TEST_CASE("ProjectFile - Round trip", "[project]") {
+    juce::TemporaryFile temp(ProjectFile::FILE_EXTENSION);
+    REQUIRE(ProjectFile::write(temp.getFile(), makeProject()));
+
+    auto project = ProjectFile::open(temp.getFile());
+    REQUIRE(project != nullptr);
+    REQUIRE(project->getVersion() == ProjectFile::FORMAT_VERSION);
+
+    ProjectData data;
+    REQUIRE(project->read(data));
+
+    SECTION("Master channel and tracks") {
+        REQUIRE_THAT(data.master.volume, WithinAbs(0.8, 1e-6));
+        REQUIRE(data.master.muted);
+
+        REQUIRE(data.tracks.size() == 1);
+        const auto& track = data.tracks[0];
+        REQUIRE(track.id == 3);
+        REQUIRE(track.type == TrackType::Instrument);
+        REQUIRE(track.name == "Lead");
+        REQUIRE(track.colour == juce::Colour(0xFF112233));
+        REQUIRE_THAT(track.pan, WithinAbs(-0.25, 1e-6));
+        REQUIRE(track.audioOutputDevice == "master");
+        REQUIRE(track.viewSettings.getHeight(ViewMode::Arrange) == 120);
+    }
+
+    SECTION("Chain tree") {
+        const auto& elements = data.tracks[0].chainElements;
+        REQUIRE(elements.size() == 2);
+        REQUIRE(isDevice(elements[0]));
+        const auto& synth = getDevice(elements[0]);
+        REQUIRE(synth.id == 10);
+        REQUIRE(synth.parameters.size() == 1);
+        REQUIRE_THAT(synth.parameters.getCurrentValue(0), WithinAbs(0.75, 1e-6));
+        REQUIRE(synth.mods[0].links.size() == 1);
+        REQUIRE_THAT(synth.mods[0].links[0].amount, WithinAbs(0.3, 1e-6));
+
+        REQUIRE(isRack(elements[1]));
+        const auto& rack = getRack(elements[1]);
+        REQUIRE(rack.id == 20);
+        REQUIRE(rack.chains.size() == 1);
+        REQUIRE(rack.chains[0].id == 30);
+        REQUIRE(rack.chains[0].elements.size() == 1);
+        REQUIRE(getDevice(rack.chains[0].elements[0]).bypassed);
+    }
+
+    SECTION("Clips and notes") {
+        REQUIRE(data.clips.size() == 2);
+        const auto& clip = data.clips[0];
+        REQUIRE(clip.name == "Riff");
+        REQUIRE(clip.midiNotes.size() == 100);
+        REQUIRE(clip.midiNotes[99].noteNumber == 60 + 99 % 12);
+        REQUIRE_THAT(clip.midiNotes[99].startBeat, WithinAbs(99 * 0.25, 1e-9));
+
+        const auto& audio = data.clips[1];
+        REQUIRE(audio.type == ClipType::Audio);
+        REQUIRE(audio.audioSources.size() == 1);
+        REQUIRE(audio.audioSources[0].filePath == "/audio/loop.wav");
+        REQUIRE(audio.midiNotes.empty());
+    }
+
+    SECTION("Automation") {
+        REQUIRE(data.nextAutomationPointId == 8);
+        REQUIRE(data.automationLanes.size() == 1);
+        const auto& lane = data.automationLanes[0];
+        REQUIRE(lane.target.type == AutomationTargetType::TrackVolume);
+        REQUIRE(lane.absolutePoints.size() == 1);
+        REQUIRE(lane.absolutePoints[0].id == 7);
+        REQUIRE(lane.absolutePoints[0].curveType == AutomationCurveType::Bezier);
+        REQUIRE_THAT(lane.absolutePoints[0].outHandle.time, WithinAbs(0.1, 1e-9));
+    }
+
+    SECTION("Plugin states") {
+        REQUIRE(project->getPluginStateDevices() == std::vector<DeviceId>{10});
+        REQUIRE(project->getPluginState(10) == juce::MemoryBlock("plugin-state", 12));
+        REQUIRE(project->getPluginState(99).isEmpty());
+    }
+}
+
+TEST_CASE("ProjectFile - Notes and points decode on first access", "[project]") {
+    juce::TemporaryFile temp(ProjectFile::FILE_EXTENSION);
+    REQUIRE(ProjectFile::write(temp.getFile(), makeProject()));
+
+    ProjectData data;
+    {
+        auto project = ProjectFile::open(temp.getFile());
+        REQUIRE(project != nullptr);
+        REQUIRE(project->read(data));
+    }  // Deferred arrays keep the mapping alive on their own
+
+    auto& notes = data.clips[0].midiNotes;
+    REQUIRE_FALSE(notes.isMaterialised());
+    REQUIRE(notes.size() == 100);  // Size is known without decoding
+    REQUIRE_FALSE(notes.isMaterialised());
+
+    REQUIRE(notes[0].noteNumber == 60);
+    REQUIRE(notes.isMaterialised());
+
+    auto& points = data.automationLanes[0].absolutePoints;
+    REQUIRE_FALSE(points.isMaterialised());
+    auto copy = points;  // Copies share the deferred loader
+    REQUIRE(copy.items().size() == 1);
+    REQUIRE_FALSE(points.isMaterialised());
+}
+
+TEST_CASE("ProjectFile - Saving over the open file keeps deferred data", "[project]") {
+    juce::TemporaryFile temp(ProjectFile::FILE_EXTENSION);
+    REQUIRE(ProjectFile::write(temp.getFile(), makeProject()));
+
+    ProjectData data;
+    auto project = ProjectFile::open(temp.getFile());
+    REQUIRE(project != nullptr);
+    REQUIRE(project->read(data));
+    REQUIRE_FALSE(data.clips[0].midiNotes.isMaterialised());
+
+    // Save something else over it while notes, points and plugin states are still mapped
+    REQUIRE(ProjectFile::write(temp.getFile(), ProjectData()));
+
+    REQUIRE(data.clips[0].midiNotes.size() == 100);
+    REQUIRE(data.clips[0].midiNotes[99].noteNumber == 60 + 99 % 12);
+    REQUIRE(data.automationLanes[0].absolutePoints[0].id == 7);
+    REQUIRE(project->getPluginState(10) == juce::MemoryBlock("plugin-state", 12));
+
+    ProjectData saved;
+    auto reopened = ProjectFile::open(temp.getFile());
+    REQUIRE(reopened != nullptr);
+    REQUIRE(reopened->read(saved));
+    REQUIRE(saved.clips.empty());
+}
+
+TEST_CASE("ProjectFile - Rejects invalid files", "[project]") {
+    juce::TemporaryFile temp(ProjectFile::FILE_EXTENSION);
+
+    SECTION("Not a project file") {
+        REQUIRE(temp.getFile().replaceWithText("hello world, this is not a project"));
+        REQUIRE(ProjectFile::open(temp.getFile()) == nullptr);
+    }
+
+    SECTION("Truncated file") {
+        REQUIRE(ProjectFile::write(temp.getFile(), makeProject()));
+        juce::MemoryBlock bytes;
+        REQUIRE(temp.getFile().loadFileAsData(bytes));
+        bytes.setSize(bytes.getSize() / 2);
+        REQUIRE(temp.getFile().replaceWithData(bytes.getData(), bytes.getSize()));
+        REQUIRE(ProjectFile::open(temp.getFile()) == nullptr);
+    }
+
+    SECTION("Newer format version") {
+        REQUIRE(ProjectFile::write(temp.getFile(), makeProject()));
+        juce::MemoryBlock bytes;
+        REQUIRE(temp.getFile().loadFileAsData(bytes));
+        bytes[4] = static_cast<char>(ProjectFile::FORMAT_VERSION + 1);
+        REQUIRE(temp.getFile().replaceWithData(bytes.getData(), bytes.getSize()));
+        REQUIRE(ProjectFile::open(temp.getFile()) == nullptr);
+    }
+}
+
+TEST_CASE("ProjectFile - Opening a second project replaces the first", "[project]") {
+    juce::TemporaryFile first(ProjectFile::FILE_EXTENSION);
+    juce::TemporaryFile second(ProjectFile::FILE_EXTENSION);
+    REQUIRE(ProjectFile::write(first.getFile(), makeProject()));
+
+    // Same IDs as the first project, different contents
+    auto other = makeProject();
+    other.tracks[0].name = "Bass";
+    getDevice(other.tracks[0].chainElements[0]).name = "Other Synth";
+    other.clips.pop_back();
+    other.pluginStates[10] = juce::MemoryBlock("other-state", 11);
+    REQUIRE(ProjectFile::write(second.getFile(), other));
+
+    auto open = [](const juce::File& file) {
+        ProjectData data;
+        auto project = ProjectFile::open(file);
+        REQUIRE(project != nullptr);
+        REQUIRE(project->read(data));
+        for (auto deviceId : project->getPluginStateDevices()) {
+            data.pluginStates[deviceId] = project->getPluginState(deviceId);
+        }
+        return data;
+    };
+
+    ProjectFile::apply(open(first.getFile()));
+    auto data = open(second.getFile());
+    REQUIRE(data.pluginStates[10] == juce::MemoryBlock("other-state", 11));
+    ProjectFile::apply(std::move(data));
+
+    auto& trackManager = TrackManager::getInstance();
+    REQUIRE(trackManager.getTracks().size() == 1);
+    REQUIRE(trackManager.getTrack(3)->name == "Bass");
+    REQUIRE(trackManager.getDeviceById(10)->name == "Other Synth");
+    REQUIRE(ClipManager::getInstance().getClips().size() == 1);
+
+    // New IDs continue past the loaded ones rather than reusing them
+    REQUIRE(trackManager.createTrack("New") > 3);
+    DeviceInfo device;
+    REQUIRE(trackManager.addDeviceToTrack(3, device) > 11);
+
+    TrackManager::getInstance().clearAllTracks();
+    ClipManager::getInstance().clearAllClips();
+    AutomationManager::getInstance().clearAll();
+}
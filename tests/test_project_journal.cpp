@@ -0,0 +1,276 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+#include <cstring>
+#include <set>
+
+#include "../magda/daw/core/ProjectJournal.hpp"
+
+using namespace magda;
+using Catch::Matchers::WithinAbs;
+
+namespace {
+
+ProjectData makeBase() {
+    ProjectData data;
+
+    for (TrackId id : {1, 2}) {
+        TrackInfo track;
+        track.id = id;
+        track.name = "Track " + juce::String(id);
+        data.tracks.push_back(std::move(track));
+    }
+
+    ClipInfo clip;
+    clip.id = 10;
+    clip.trackId = 1;
+    clip.startTime = 0.0;
+    clip.length = 4.0;
+    clip.midiNotes.add({60, 100, 0.0, 1.0});
+    data.clips.push_back(clip);
+
+    AutomationLaneInfo lane;
+    lane.id = 5;
+    data.automationLanes.push_back(lane);
+    AutomationClipInfo automationClip;
+    automationClip.id = 50;
+    automationClip.laneId = 5;
+    data.automationClips.push_back(automationClip);
+    return data;
+}
+
+ProjectChangeSet makeChanges() {
+    ProjectChangeSet changes;
+    changes.description = "Move Clip";
+
+    TrackInfo renamed;
+    renamed.id = 2;
+    renamed.name = "Bass";
+    changes.tracks.push_back(renamed);
+    changes.trackOrder = std::vector<TrackId>{2, 1};
+
+    DeviceInfo device;
+    device.id = 7;
+    device.name = "EQ";
+    std::vector<ChainElement> chain;
+    chain.push_back(makeDeviceElement(device));
+    changes.chains.emplace_back(1, std::move(chain));
+
+    MasterChannelState master;
+    master.volume = 0.5f;
+    changes.master = master;
+
+    ClipInfo moved;
+    moved.id = 10;
+    moved.trackId = 2;
+    moved.startTime = 8.0;
+    moved.length = 4.0;
+    moved.midiNotes.add({62, 90, 1.0, 0.5});
+    moved.midiNotes.add({64, 80, 2.0, 0.5});
+    changes.clips.push_back(moved);
+
+    AutomationLaneInfo lane;
+    lane.id = 5;
+    lane.name = "Volume";
+    AutomationPoint point;
+    point.id = 3;
+    point.value = 0.75;
+    lane.absolutePoints.push_back(point);
+    changes.lanes.push_back(lane);
+    changes.nextAutomationPointId = 4;
+    return changes;
+}
+
+juce::MemoryBlock payload(const char* text) {
+    return juce::MemoryBlock(text, std::strlen(text));
+}
+
+}  // namespace
+
+TEST_CASE("ProjectChangeSet - Encode and decode", "[project][journal]") {
+    auto encoded = makeChanges().encode();
+
+    ProjectChangeSet decoded;
+    REQUIRE(ProjectChangeSet::decode(encoded.getData(), encoded.getSize(), decoded));
+    REQUIRE(decoded.description == "Move Clip");
+    const std::vector<TrackId> expectedOrder{2, 1};
+    REQUIRE(decoded.trackOrder == expectedOrder);
+    REQUIRE(decoded.tracks.size() == 1);
+    REQUIRE(decoded.tracks[0].name == "Bass");
+    REQUIRE(decoded.chains.size() == 1);
+    REQUIRE(getDevice(decoded.chains[0].second[0]).name == "EQ");
+    REQUIRE(decoded.master.has_value());
+    REQUIRE(decoded.clips.size() == 1);
+    REQUIRE(decoded.clips[0].midiNotes.size() == 2);
+    REQUIRE(decoded.clips[0].midiNotes[1].noteNumber == 64);
+    REQUIRE(decoded.lanes.size() == 1);
+    REQUIRE(decoded.lanes[0].absolutePoints.size() == 1);
+    REQUIRE(decoded.nextAutomationPointId == 4);
+
+    SECTION("Truncated payload is rejected") {
+        ProjectChangeSet truncated;
+        auto size = encoded.getSize() - 3;
+        REQUIRE_FALSE(ProjectChangeSet::decode(encoded.getData(), size, truncated));
+    }
+}
+
+TEST_CASE("ProjectChangeSet - Apply", "[project][journal]") {
+    auto data = makeBase();
+    auto changes = makeChanges();
+    changes.applyTo(data);
+
+    SECTION("Entities are replaced in full") {
+        REQUIRE(data.tracks.size() == 2);
+        REQUIRE(data.tracks[0].id == 2);  // Reordered
+        REQUIRE(data.tracks[0].name == "Bass");
+        REQUIRE(data.tracks[1].chainElements.size() == 1);
+        REQUIRE_THAT(data.master.volume, WithinAbs(0.5, 1e-6));
+
+        REQUIRE(data.clips.size() == 1);
+        REQUIRE(data.clips[0].trackId == 2);
+        REQUIRE_THAT(data.clips[0].startTime, WithinAbs(8.0, 1e-9));
+        REQUIRE(data.clips[0].midiNotes.size() == 2);
+
+        // An upserted lane brings all of its clips; it listed none here
+        REQUIRE(data.automationLanes[0].name == "Volume");
+        REQUIRE(data.automationClips.empty());
+        REQUIRE(data.nextAutomationPointId == 4);
+    }
+
+    SECTION("Replaying is idempotent") {
+        changes.applyTo(data);
+        REQUIRE(data.tracks.size() == 2);
+        REQUIRE(data.tracks[0].id == 2);
+        REQUIRE(data.clips.size() == 1);
+        REQUIRE(data.clips[0].midiNotes.size() == 2);
+    }
+
+    SECTION("Deletes") {
+        ProjectChangeSet deletes;
+        deletes.deletedTracks.push_back(1);
+        deletes.deletedClips.push_back(10);
+        deletes.deletedLanes.push_back(5);
+        REQUIRE_FALSE(deletes.isEmpty());
+        deletes.applyTo(data);
+        REQUIRE(data.tracks.size() == 1);
+        REQUIRE(data.clips.empty());
+        REQUIRE(data.automationLanes.empty());
+    }
+}
+
+TEST_CASE("JournalWriter - Records and snapshots", "[project][journal]") {
+    auto dir = juce::File::createTempFile("journal");
+    REQUIRE(dir.createDirectory());
+    auto journalFile = dir.getChildFile("Song.magda.journal");
+    auto snapshotFile = dir.getChildFile("Song.magda.autosave");
+
+    {
+        JournalWriter writer(journalFile, snapshotFile);
+        writer.append(payload("first"));
+        writer.append(payload("second"));
+        writer.append(payload("third"));
+        REQUIRE(writer.waitUntilIdle(5000));
+    }
+
+    auto records = JournalWriter::readRecords(journalFile);
+    REQUIRE(records.size() == 3);
+    REQUIRE(records[1] == payload("second"));
+
+    SECTION("A torn tail is ignored") {
+        juce::MemoryBlock bytes;
+        REQUIRE(journalFile.loadFileAsData(bytes));
+        bytes.setSize(bytes.getSize() - 2);
+        REQUIRE(journalFile.replaceWithData(bytes.getData(), bytes.getSize()));
+        REQUIRE(JournalWriter::readRecords(journalFile).size() == 2);
+    }
+
+    SECTION("Appending continues an existing journal") {
+        JournalWriter writer(journalFile, snapshotFile);
+        writer.append(payload("fourth"));
+        REQUIRE(writer.waitUntilIdle(5000));
+        REQUIRE(JournalWriter::readRecords(journalFile).size() == 4);
+    }
+
+    SECTION("A snapshot supersedes the journal") {
+        JournalWriter writer(journalFile, snapshotFile);
+        writer.writeSnapshot(makeBase());
+        writer.append(payload("after"));
+        REQUIRE(writer.waitUntilIdle(5000));
+
+        REQUIRE(snapshotFile.existsAsFile());
+        auto remaining = JournalWriter::readRecords(journalFile);
+        REQUIRE(remaining.size() == 1);
+        REQUIRE(remaining[0] == payload("after"));
+
+        writer.reset();
+        REQUIRE(writer.waitUntilIdle(5000));
+        REQUIRE_FALSE(snapshotFile.existsAsFile());
+        REQUIRE(JournalWriter::readRecords(journalFile).empty());
+    }
+
+    dir.deleteRecursively();
+}
+
+TEST_CASE("ProjectJournal - Records only the tracks that changed", "[project][journal]") {
+    auto& trackManager = TrackManager::getInstance();
+    trackManager.clearAllTracks();
+    auto keys = trackManager.createTrack("Keys");
+    auto bass = trackManager.createTrack("Bass");
+    auto group = trackManager.createGroupTrack("Group");
+    trackManager.createTrack("Drums");
+
+    auto dir = juce::File::createTempFile("journal");
+    REQUIRE(dir.createDirectory());
+    auto projectFile = dir.getChildFile("Song.magda");
+    REQUIRE(projectFile.replaceWithText("project"));
+
+    auto lastRecord = [&projectFile] {
+        auto records = JournalWriter::readRecords(ProjectJournal::getJournalFile(projectFile));
+        REQUIRE_FALSE(records.empty());
+        ProjectChangeSet changes;
+        REQUIRE(ProjectChangeSet::decode(records.back().getData(), records.back().getSize(),
+                                         changes));
+        return changes;
+    };
+
+    {
+        ProjectJournal journal(projectFile, ProjectJournal::Base::ProjectFile);
+
+        SECTION("A property edit encodes that track alone") {
+            trackManager.setTrackName(bass, "Sub");
+            REQUIRE(journal.flush(5000));
+
+            auto changes = lastRecord();
+            REQUIRE(changes.tracks.size() == 1);
+            REQUIRE(changes.tracks[0].id == bass);
+            REQUIRE(changes.tracks[0].name == "Sub");
+            REQUIRE_FALSE(changes.trackOrder.has_value());
+        }
+
+        SECTION("Grouping records both tracks it touches") {
+            trackManager.addTrackToGroup(keys, group);
+            REQUIRE(journal.flush(5000));
+
+            auto changes = lastRecord();
+            std::set<TrackId> ids;
+            for (const auto& track : changes.tracks) {
+                ids.insert(track.id);
+            }
+            REQUIRE(ids == std::set<TrackId>{keys, group});
+        }
+
+        SECTION("A deletion is recorded without re-encoding the rest") {
+            trackManager.deleteTrack(bass);
+            REQUIRE(journal.flush(5000));
+
+            auto changes = lastRecord();
+            REQUIRE(changes.deletedTracks == std::vector<TrackId>{bass});
+            REQUIRE(changes.tracks.empty());
+            REQUIRE(changes.trackOrder.has_value());
+        }
+    }
+
+    ProjectJournal::discardRecoveryData(projectFile);
+    dir.deleteRecursively();
+    trackManager.clearAllTracks();
+}
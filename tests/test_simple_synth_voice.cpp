@@ -0,0 +1,186 @@
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <cmath>
+
+#include "../magda/daw/audio/SimpleSynthVoice.hpp"
+
+using namespace magda::daw::audio;
+
+namespace {
+
+constexpr double kSampleRate = 48000.0;
+constexpr int kBlockSize = 256;
+
+void setupSynth(juce::Synthesiser& synth, int numVoices, SimpleSynthVoice::Waveform waveform) {
+    synth.addSound(new SimpleSynthSound());
+    for (int i = 0; i < numVoices; ++i) {
+        auto* voice = new SimpleSynthVoice();
+        voice->prepare(kBlockSize);
+        voice->setWaveform(waveform);
+        voice->setADSR(0.001f, 0.05f, 0.8f, 0.01f);
+        synth.addVoice(voice);
+    }
+    synth.setCurrentPlaybackSampleRate(kSampleRate);
+}
+
+juce::MidiBuffer makeChord(int numNotes) {
+    juce::MidiBuffer midi;
+    for (int i = 0; i < numNotes; ++i)
+        midi.addEvent(juce::MidiMessage::noteOn(1 + i / 72, 36 + i % 72, 0.8f), 0);
+    return midi;
+}
+
+float peakOf(const juce::AudioBuffer<float>& buffer) {
+    return buffer.getMagnitude(0, buffer.getNumSamples());
+}
+
+}  // namespace
+
+// ============================================================================
+// BlockEnvelope Tests
+// ============================================================================
+
+TEST_CASE("BlockEnvelope - Segment shape", "[synth][envelope]") {
+    BlockEnvelope env;
+    env.setSampleRate(1000.0);
+    env.setParameters({0.01f, 0.01f, 0.5f, 0.02f});  // 10 / 10 / 20 samples
+
+    std::vector<float> gains(64, -1.0f);
+
+    SECTION("Idle renders silence") {
+        env.render(gains.data(), 16);
+        REQUIRE_FALSE(env.isActive());
+        REQUIRE(gains[0] == 0.0f);
+        REQUIRE(gains[15] == 0.0f);
+    }
+
+    SECTION("Attack, decay and sustain across block boundaries") {
+        env.noteOn();
+        env.render(gains.data(), 5);
+        env.render(gains.data() + 5, 59);
+
+        REQUIRE(gains[4] == Catch::Approx(0.5f));
+        REQUIRE(gains[9] == Catch::Approx(1.0f));
+        REQUIRE(gains[14] == Catch::Approx(0.75f));
+        REQUIRE(gains[19] == Catch::Approx(0.5f));
+        REQUIRE(gains[63] == Catch::Approx(0.5f));
+        REQUIRE(env.isActive());
+    }
+
+    SECTION("Release ramps to idle from the current level") {
+        env.noteOn();
+        env.render(gains.data(), 30);
+        env.noteOff();
+        env.render(gains.data(), 30);
+
+        REQUIRE(gains[9] == Catch::Approx(0.25f));
+        REQUIRE(gains[19] == Catch::Approx(0.0f));
+        REQUIRE(gains[29] == 0.0f);
+        REQUIRE_FALSE(env.isActive());
+    }
+}
+
+// ============================================================================
+// SimpleSynthVoice Tests
+// ============================================================================
+
+TEST_CASE("SimpleSynthVoice - Renders every waveform", "[synth]") {
+    for (auto waveform : {SimpleSynthVoice::Waveform::Sine, SimpleSynthVoice::Waveform::Noise,
+                          SimpleSynthVoice::Waveform::Saw, SimpleSynthVoice::Waveform::Square}) {
+        juce::Synthesiser synth;
+        setupSynth(synth, 1, waveform);
+
+        juce::AudioBuffer<float> buffer(2, kBlockSize);
+        buffer.clear();
+        auto midi = makeChord(1);
+        synth.renderNextBlock(buffer, midi, 0, kBlockSize);
+
+        float peak = peakOf(buffer);
+        REQUIRE(peak > 0.0f);
+        REQUIRE(peak < 0.25f);  // velocity * 0.15 plus polyBLEP overshoot headroom
+        REQUIRE(buffer.getSample(0, 100) == buffer.getSample(1, 100));
+    }
+}
+
+TEST_CASE("SimpleSynthVoice - Sine pitch follows the MIDI note", "[synth]") {
+    juce::Synthesiser synth;
+    setupSynth(synth, 1, SimpleSynthVoice::Waveform::Sine);
+
+    // A4 = 440 Hz: count rising zero crossings over one second
+    const int numSamples = static_cast<int>(kSampleRate);
+    juce::AudioBuffer<float> buffer(1, numSamples);
+    buffer.clear();
+    juce::MidiBuffer midi;
+    midi.addEvent(juce::MidiMessage::noteOn(1, 69, 1.0f), 0);
+    synth.renderNextBlock(buffer, midi, 0, numSamples);
+
+    int crossings = 0;
+    const float* data = buffer.getReadPointer(0);
+    for (int i = 1; i < numSamples; ++i) {
+        if (data[i - 1] < 0.0f && data[i] >= 0.0f)
+            ++crossings;
+    }
+    REQUIRE(crossings >= 439);
+    REQUIRE(crossings <= 441);
+}
+
+TEST_CASE("SimpleSynthVoice - Voice frees itself after release", "[synth]") {
+    juce::Synthesiser synth;
+    setupSynth(synth, 4, SimpleSynthVoice::Waveform::Saw);
+
+    juce::AudioBuffer<float> buffer(2, kBlockSize);
+    auto midi = makeChord(4);
+    synth.renderNextBlock(buffer, midi, 0, kBlockSize);
+
+    juce::MidiBuffer noteOffs;
+    for (int i = 0; i < 4; ++i)
+        noteOffs.addEvent(juce::MidiMessage::noteOff(1, 36 + i), 0);
+
+    // 10 ms release at 48 kHz fits in a few blocks
+    buffer.clear();
+    synth.renderNextBlock(buffer, noteOffs, 0, kBlockSize);
+    for (int block = 0; block < 4; ++block) {
+        buffer.clear();
+        juce::MidiBuffer empty;
+        synth.renderNextBlock(buffer, empty, 0, kBlockSize);
+    }
+
+    REQUIRE(peakOf(buffer) == 0.0f);
+    for (int i = 0; i < synth.getNumVoices(); ++i)
+        REQUIRE_FALSE(synth.getVoice(i)->isVoiceActive());
+}
+
+TEST_CASE("SimpleSynthVoice - Blocks larger than prepared size", "[synth]") {
+    juce::Synthesiser synth;
+    setupSynth(synth, 1, SimpleSynthVoice::Waveform::Square);
+
+    juce::AudioBuffer<float> buffer(2, kBlockSize * 3 + 17);
+    buffer.clear();
+    auto midi = makeChord(1);
+    synth.renderNextBlock(buffer, midi, 0, buffer.getNumSamples());
+
+    REQUIRE(buffer.getMagnitude(0, kBlockSize * 3, 17) > 0.0f);
+}
+
+// ============================================================================
+// Voice-count benchmark (hidden; run with: magda_tests "[.benchmark]")
+// ============================================================================
+
+TEST_CASE("SimpleSynthVoice - Voice count benchmark", "[.benchmark][synth]") {
+    for (int numVoices : {1, 8, 32, 64, 128}) {
+        juce::Synthesiser synth;
+        setupSynth(synth, numVoices, SimpleSynthVoice::Waveform::Saw);
+
+        juce::AudioBuffer<float> buffer(2, kBlockSize);
+        auto midi = makeChord(numVoices);
+        synth.renderNextBlock(buffer, midi, 0, kBlockSize);
+
+        juce::MidiBuffer empty;
+        BENCHMARK(juce::String(numVoices).toStdString() + " voices, 256-sample block") {
+            buffer.clear();
+            synth.renderNextBlock(buffer, empty, 0, kBlockSize);
+            return buffer.getSample(0, 0);
+        };
+    }
+}
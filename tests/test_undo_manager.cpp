@@ -0,0 +1,309 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <vector>
+
+#include "../magda/daw/core/ClipInfo.hpp"
+#include "../magda/daw/core/TrackInfo.hpp"
+#include "../magda/daw/core/TrackManager.hpp"
+#include "../magda/daw/core/UndoManager.hpp"
+
+using namespace magda;
+
+namespace {
+
+class SizedCommand : public UndoableCommand {
+  public:
+    explicit SizedCommand(size_t bytes) : bytes_(bytes) {}
+
+    void execute() override {}
+    void undo() override {}
+    juce::String getDescription() const override {
+        return "Sized";
+    }
+    size_t getSizeInBytes() const override {
+        return bytes_;
+    }
+
+  private:
+    size_t bytes_;
+};
+
+// Reports whatever size the test sets, like a snapshot that detaches from the model later
+class GrowingCommand : public UndoableCommand {
+  public:
+    explicit GrowingCommand(const size_t& bytes) : bytes_(bytes) {}
+
+    void execute() override {}
+    void undo() override {}
+    juce::String getDescription() const override {
+        return "Growing";
+    }
+    size_t getSizeInBytes() const override {
+        return bytes_;
+    }
+
+  private:
+    const size_t& bytes_;
+};
+
+// Sets one of a few integers; merges with later sets of the same one
+class SetValueCommand : public UndoableCommand {
+  public:
+    SetValueCommand(std::vector<int>& values, size_t index, int newValue)
+        : values_(values), index_(index), oldValue_(values[index]), newValue_(newValue) {}
+
+    void execute() override {
+        values_[index_] = newValue_;
+    }
+    void undo() override {
+        values_[index_] = oldValue_;
+    }
+    juce::String getDescription() const override {
+        return "Set Value";
+    }
+
+    bool canMergeWith(const UndoableCommand* other) const override {
+        auto* otherSet = dynamic_cast<const SetValueCommand*>(other);
+        return otherSet && otherSet->index_ == index_;
+    }
+    void mergeWith(const UndoableCommand* other) override {
+        newValue_ = static_cast<const SetValueCommand*>(other)->newValue_;
+    }
+
+  private:
+    std::vector<int>& values_;
+    size_t index_;
+    int oldValue_;
+    int newValue_;
+};
+
+class PerformedCounter : public UndoManagerListener {
+  public:
+    void undoStateChanged() override {
+        ++stateChanges;
+    }
+    void commandPerformed(const juce::String& /*description*/) override {
+        ++performed;
+    }
+
+    int stateChanges = 0;
+    int performed = 0;
+};
+
+}  // namespace
+
+TEST_CASE("LazyArray - Copies share until written", "[undo][lazyarray]") {
+    ClipInfo clip;
+    clip.midiNotes.add({60, 100, 0.0, 1.0});
+    clip.midiNotes.add({64, 100, 1.0, 1.0});
+
+    ClipInfo snapshot = clip;
+    REQUIRE(snapshot.midiNotes.sharesBufferWith(clip.midiNotes));
+    REQUIRE(clip.midiNotes.isShared());
+
+    SECTION("Const access keeps sharing") {
+        const auto& constClip = clip;
+        REQUIRE(constClip.midiNotes[1].noteNumber == 64);
+        REQUIRE(snapshot.midiNotes.sharesBufferWith(clip.midiNotes));
+    }
+
+    SECTION("Writing detaches the writer only") {
+        auto note = clip.midiNotes[0];
+        note.noteNumber = 72;
+        REQUIRE(clip.midiNotes.update(note));
+        REQUIRE_FALSE(snapshot.midiNotes.sharesBufferWith(clip.midiNotes));
+        REQUIRE(snapshot.midiNotes[0].noteNumber == 60);
+        REQUIRE_FALSE(clip.midiNotes.isShared());
+    }
+
+    SECTION("Positions taken before a detach stay valid") {
+        LazyArray<MidiNote> notes{{60, 100, 0.0, 1.0}, {64, 100, 1.0, 1.0}};
+        auto copy = notes;
+        const auto& shared = static_cast<const LazyArray<MidiNote>&>(notes);
+        notes.erase(shared.begin());
+        REQUIRE(notes.size() == 1);
+        REQUIRE(notes[0].noteNumber == 64);
+        REQUIRE(copy.size() == 2);
+    }
+}
+
+TEST_CASE("LazyArray - Track chains detach through a deep copy", "[undo][lazyarray]") {
+    TrackInfo track;
+    RackInfo rack;
+    rack.id = 1;
+    ChainInfo chain;
+    DeviceInfo device;
+    device.id = 2;
+    device.name = "Delay";
+    chain.elements.push_back(makeDeviceElement(device));
+    rack.chains.push_back(std::move(chain));
+    track.chainElements.push_back(makeRackElement(std::move(rack)));
+
+    TrackInfo copy = track;
+    REQUIRE(copy.chainElements.sharesBufferWith(track.chainElements));
+
+    getDevice(getRack(track.chainElements[0]).chains[0].elements[0]).name = "Reverb";
+    REQUIRE_FALSE(copy.chainElements.sharesBufferWith(track.chainElements));
+
+    const auto& copiedRack = getRack(static_cast<const TrackInfo&>(copy).chainElements[0]);
+    REQUIRE(getDevice(copiedRack.chains[0].elements[0]).name == "Delay");
+}
+
+TEST_CASE("TrackManager - Duplicated tracks get a chain of their own", "[undo][lazyarray]") {
+    auto& trackManager = TrackManager::getInstance();
+    trackManager.clearAllTracks();
+
+    TrackId original = trackManager.createTrack("Original");
+    DeviceInfo device;
+    device.name = "Delay";
+    DeviceId deviceId = trackManager.addDeviceToTrack(original, device);
+
+    trackManager.duplicateTrack(original);
+    REQUIRE(trackManager.getTracks().size() == 2);
+    TrackId duplicate = trackManager.getTracks()[1].id;
+
+    const auto& originalChain = trackManager.getTrack(original)->chainElements;
+    const auto& duplicateChain = trackManager.getTrack(duplicate)->chainElements;
+    REQUIRE_FALSE(duplicateChain.sharesBufferWith(originalChain));
+
+    trackManager.getDevice(duplicate, deviceId)->name = "Reverb";
+    REQUIRE(trackManager.getDevice(original, deviceId)->name == "Delay");
+
+    trackManager.clearAllTracks();
+}
+
+TEST_CASE("UndoManager - Memory budget", "[undo]") {
+    auto& undoManager = UndoManager::getInstance();
+    undoManager.clearHistory();
+    auto previousBudget = undoManager.getMaxUndoBytes();
+    undoManager.setMaxUndoBytes(1000);
+
+    for (int i = 0; i < 5; ++i) {
+        undoManager.executeCommand(std::make_unique<SizedCommand>(300));
+    }
+    REQUIRE(undoManager.getUndoMemoryUsage() == 900);
+
+    SECTION("Undone commands still count") {
+        REQUIRE(undoManager.undo());
+        REQUIRE(undoManager.getUndoMemoryUsage() == 900);
+        REQUIRE(undoManager.undo());
+        REQUIRE(undoManager.undo());
+        REQUIRE_FALSE(undoManager.undo());
+    }
+
+    SECTION("The latest step survives an oversized command") {
+        undoManager.executeCommand(std::make_unique<SizedCommand>(5000));
+        REQUIRE(undoManager.canUndo());
+        REQUIRE(undoManager.getUndoMemoryUsage() == 5000);
+        REQUIRE(undoManager.undo());
+        REQUIRE_FALSE(undoManager.canUndo());
+    }
+
+    undoManager.setMaxUndoBytes(previousBudget);
+    undoManager.clearHistory();
+}
+
+TEST_CASE("UndoManager - Memory usage is a running total", "[undo]") {
+    auto& undoManager = UndoManager::getInstance();
+    undoManager.clearHistory();
+
+    size_t snapshotBytes = 100;
+    undoManager.executeCommand(std::make_unique<GrowingCommand>(snapshotBytes));
+    REQUIRE(undoManager.getUndoMemoryUsage() == 100);
+
+    // The next edit detaches the previous step's snapshot; it is re-measured then
+    snapshotBytes = 400;
+    undoManager.executeCommand(std::make_unique<SizedCommand>(50));
+    REQUIRE(undoManager.getUndoMemoryUsage() == 450);
+
+    SECTION("Undo and redo keep the total") {
+        REQUIRE(undoManager.undo());
+        REQUIRE(undoManager.undo());
+        REQUIRE(undoManager.getUndoMemoryUsage() == 450);
+        REQUIRE(undoManager.redo());
+        REQUIRE(undoManager.getUndoMemoryUsage() == 450);
+    }
+
+    SECTION("A new edit drops the redo steps from the total") {
+        REQUIRE(undoManager.undo());
+        undoManager.executeCommand(std::make_unique<SizedCommand>(10));
+        REQUIRE(undoManager.getUndoMemoryUsage() == 410);
+    }
+
+    undoManager.clearHistory();
+    REQUIRE(undoManager.getUndoMemoryUsage() == 0);
+}
+
+TEST_CASE("UndoManager - Gestures coalesce into one step", "[undo]") {
+    auto& undoManager = UndoManager::getInstance();
+    undoManager.clearHistory();
+    undoManager.setMergeWindowMs(0);
+
+    std::vector<int> values{0, 0};
+    auto set = [&values, &undoManager](size_t index, int value) {
+        undoManager.executeCommand(std::make_unique<SetValueCommand>(values, index, value));
+    };
+
+    PerformedCounter counter;
+    undoManager.addListener(&counter);
+
+    SECTION("A sweep is one step, reported once") {
+        {
+            GestureScope gesture;
+            for (int value = 1; value <= 50; ++value) {
+                set(0, value);
+            }
+            REQUIRE(counter.performed == 0);
+        }
+        REQUIRE(counter.performed == 1);
+        REQUIRE(counter.stateChanges == 1);
+        REQUIRE(values[0] == 50);
+
+        REQUIRE(undoManager.undo());
+        REQUIRE(values[0] == 0);
+        REQUIRE_FALSE(undoManager.canUndo());
+        REQUIRE(undoManager.redo());
+        REQUIRE(values[0] == 50);
+    }
+
+    SECTION("Different edits in one gesture are grouped") {
+        {
+            GestureScope gesture;
+            set(0, 1);
+            set(1, 2);
+            set(1, 3);
+        }
+        REQUIRE(undoManager.getUndoDescription() == "Set Value");
+        REQUIRE(undoManager.undo());
+        REQUIRE(values[0] == 0);
+        REQUIRE(values[1] == 0);
+        REQUIRE_FALSE(undoManager.canUndo());
+    }
+
+    SECTION("Separate gestures stay separate") {
+        for (int value : {1, 2}) {
+            GestureScope gesture;
+            set(0, value);
+        }
+        REQUIRE(undoManager.undo());
+        REQUIRE(values[0] == 1);
+        REQUIRE(undoManager.canUndo());
+    }
+
+    SECTION("Outside a gesture only the merge window coalesces") {
+        set(0, 1);
+        set(0, 2);
+        REQUIRE(undoManager.undo());
+        REQUIRE(values[0] == 1);
+
+        undoManager.setMergeWindowMs(60000);
+        set(0, 3);
+        set(0, 4);
+        REQUIRE(undoManager.undo());
+        REQUIRE(values[0] == 1);
+    }
+
+    undoManager.removeListener(&counter);
+    undoManager.setMergeWindowMs(500);
+    undoManager.clearHistory();
+}